@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CCDBBlobCache.h
+/// \brief Node-local on-disk cache of CCDB objects, shared by all processes of the node
+
+#ifndef O2_CCDB_BLOBCACHE_H_
+#define O2_CCDB_BLOBCACHE_H_
+
+#include "MemoryResources/MemoryResources.h"
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace o2::ccdb
+{
+
+/**
+ * Content-addressed store of the CCDB object blobs, indexed by the validity intervals of every path.
+ *
+ * Layout of the cache directory:
+ *  - blobs/<2 first characters of the key>/<key> : the object as received from the server
+ *  - blobs/<2 first characters of the key>/<key>.hdr : its response headers, one "name<TAB>value" per line
+ *  - index/<path>.idx : one "validFrom validUntil created key" line per cached object of the path
+ *
+ * The key is the ETag of the object (or its Content-MD5 if there is no ETag), so the same object requested
+ * by different processes or for different timestamps is stored once. The blobs and headers are written to a
+ * temporary file and renamed, hence they are visible either complete or not at all. The index files are
+ * accessed under flock: shared for lookups, exclusive for appending.
+ */
+class CCDBBlobCache
+{
+ public:
+  struct Entry {
+    long validFrom = 0;
+    long validUntil = 0;
+    long created = 0;
+    std::string key;
+  };
+
+  explicit CCDBBlobCache(std::string const& directory);
+
+  const std::string& getDirectory() const { return mDirectory; }
+
+  /**
+   * Key of the object described by the response headers, empty if the object is not identifiable.
+   */
+  static std::string getKey(std::map<std::string, std::string> const& headers);
+
+  /**
+   * Most recently created cached object of the path valid for the timestamp.
+   */
+  std::optional<Entry> find(std::string const& path, long timestamp) const;
+
+  /**
+   * Reads the blob of the entry to dest, returns false if it cannot be read.
+   */
+  bool loadBlob(Entry const& entry, o2::pmr::vector<char>& dest) const;
+
+  /**
+   * Reads the stored response headers of the entry, returns false if they cannot be read.
+   */
+  bool loadHeaders(Entry const& entry, std::map<std::string, std::string>& headers) const;
+
+  /**
+   * Adds the object received for the path to the cache, returns false if it was not stored.
+   */
+  bool store(std::string const& path, std::map<std::string, std::string> const& headers, const char* data, size_t size) const;
+
+  std::string getBlobFile(std::string const& key) const;
+  std::string getHeadersFile(std::string const& key) const { return getBlobFile(key) + ".hdr"; }
+  std::string getIndexFile(std::string const& path) const;
+
+ private:
+  bool writeAtomically(std::string const& fileName, const char* data, size_t size) const;
+
+  std::string mDirectory;
+};
+
+} // namespace o2::ccdb
+
+#endif
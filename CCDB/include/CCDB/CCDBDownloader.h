@@ -26,6 +26,7 @@
 #include <condition_variable>
 #include <unordered_map>
 #include <map>
+#include <memory>
 #include <functional>
 
 typedef struct uv_loop_s uv_loop_t;
@@ -38,6 +39,8 @@ typedef struct uv_handle_s uv_handle_t;
 namespace o2::ccdb
 {
 
+class CCDBBlobCache;
+
 #if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
 struct HeaderObjectPair_t {
   std::multimap<std::string, std::string> header;
@@ -53,6 +56,9 @@ typedef struct DownloaderRequestData {
   std::map<std::string, std::string>* headers;
   std::string userAgent;
   curl_slist* optionsList;
+  std::string etag;          // ETag of the object already possessed by the requester
+  bool useBlobCache = false; // the answer does not depend on metadata or creation time constraints
+  std::string blobCacheKey;  // key of the cached object sent for revalidation
 
   std::function<bool(std::string)> localContentCallback;
 } DownloaderRequestData;
@@ -207,6 +213,15 @@ class CCDBDownloader
    */
   void setOnlineTimeoutSettings();
 
+  /**
+   * Enables the node-local blob cache in the given directory: the downloaded objects are stored in it and the
+   * cached ones are revalidated with the server instead of being downloaded again.
+   * In the warm-start mode the cached objects are served without contacting the server at all.
+   */
+  void setBlobCache(std::string const& directory, bool warmStart = false);
+
+  CCDBBlobCache* getBlobCache() const { return mBlobCache.get(); }
+
   /**
    * Run the uvLoop once.
    *
@@ -239,6 +254,16 @@ class CCDBDownloader
   std::vector<std::string> getLocations(std::multimap<std::string, std::string>* headerMap) const;
 
   std::string mUserAgentId = "CCDBDownloader";
+
+  /**
+   * Node-local cache of the downloaded objects, owned by the downloader.
+   */
+  std::unique_ptr<CCDBBlobCache> mBlobCache;
+
+  /**
+   * Serve the objects found in mBlobCache without contacting the server.
+   */
+  bool mBlobCacheWarmStart = false;
   /**
    * Sets up internal UV loop.
    */
@@ -405,6 +430,22 @@ class CCDBDownloader
    * Set openSocketCallback and closeSocketCallback with appropriate arguments. Stores data inside the CURL handle.
    */
   void setHandleOptions(CURL* handle, PerformData* data);
+
+  /**
+   * Fills the object and headers of the request from the blob cache entry. The object is left empty if the requester already has it.
+   */
+  bool loadFromBlobCache(DownloaderRequestData* requestData, std::string const& key);
+
+  /**
+   * Stores the object retrieved for the request in the blob cache.
+   */
+  void storeToBlobCache(DownloaderRequestData* requestData);
+
+  /**
+   * Completes an asynchronous request, downloaded or served from the blob cache: sets the headers reporting its outcome,
+   * stores a downloaded object in the blob cache, decrements the counter of pending requests and frees the request data.
+   */
+  void completeAsynchRequest(DownloaderRequestData* requestData, size_t* requestsLeft, bool contentRetrieved, bool downloaded);
 #endif
 
   /**
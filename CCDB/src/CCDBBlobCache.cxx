@@ -0,0 +1,252 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CCDBBlobCache.cxx
+/// \brief Node-local on-disk cache of CCDB objects, shared by all processes of the node
+
+#include "CCDB/CCDBBlobCache.h"
+#include <fairlogger/Logger.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2::ccdb
+{
+
+namespace
+{
+// reads the whole content of the open file descriptor
+bool readAll(int fd, std::string& content)
+{
+  char buffer[4096];
+  ssize_t nread;
+  while ((nread = ::read(fd, buffer, sizeof(buffer))) > 0) {
+    content.append(buffer, nread);
+  }
+  return nread == 0;
+}
+
+bool writeAll(int fd, const char* data, size_t size)
+{
+  while (size > 0) {
+    ssize_t nwritten = ::write(fd, data, size);
+    if (nwritten < 0) {
+      return false;
+    }
+    data += nwritten;
+    size -= nwritten;
+  }
+  return true;
+}
+
+long getLongHeader(std::map<std::string, std::string> const& headers, std::string const& name, long defaultValue)
+{
+  auto it = headers.find(name);
+  if (it == headers.end() || it->second.empty()) {
+    return defaultValue;
+  }
+  try {
+    return std::stol(it->second);
+  } catch (...) {
+    return defaultValue;
+  }
+}
+} // namespace
+
+CCDBBlobCache::CCDBBlobCache(std::string const& directory) : mDirectory(directory)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(mDirectory + "/blobs", ec);
+  std::filesystem::create_directories(mDirectory + "/index", ec);
+  if (ec) {
+    LOGP(error, "Failed to create the CCDB blob cache in {}: {}", mDirectory, ec.message());
+  }
+}
+
+std::string CCDBBlobCache::getKey(std::map<std::string, std::string> const& headers)
+{
+  std::string id;
+  for (const auto* name : {"ETag", "Content-MD5"}) {
+    auto it = headers.find(name);
+    if (it != headers.end() && !it->second.empty()) {
+      id = it->second;
+      break;
+    }
+  }
+  // the ETag comes quoted, keep only the characters which are safe in a file name
+  std::string key;
+  for (auto c : id) {
+    if (std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_') {
+      key += c;
+    }
+  }
+  return key.size() > 2 ? key : std::string{};
+}
+
+std::string CCDBBlobCache::getBlobFile(std::string const& key) const
+{
+  return fmt::format("{}/blobs/{}/{}", mDirectory, key.substr(0, 2), key);
+}
+
+std::string CCDBBlobCache::getIndexFile(std::string const& path) const
+{
+  auto start = path.find_first_not_of('/');
+  return fmt::format("{}/index/{}.idx", mDirectory, start == std::string::npos ? std::string{} : path.substr(start));
+}
+
+std::optional<CCDBBlobCache::Entry> CCDBBlobCache::find(std::string const& path, long timestamp) const
+{
+  int fd = ::open(getIndexFile(path).c_str(), O_RDONLY);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  std::string content;
+  bool ok = flock(fd, LOCK_SH) == 0 && readAll(fd, content);
+  ::close(fd); // releases the lock
+  if (!ok) {
+    return std::nullopt;
+  }
+  // as the server, prefer the most recently created object among the overlapping ones
+  std::optional<Entry> found;
+  std::istringstream lines(content);
+  Entry entry;
+  while (lines >> entry.validFrom >> entry.validUntil >> entry.created >> entry.key) {
+    if (entry.validFrom <= timestamp && timestamp < entry.validUntil && (!found || entry.created >= found->created)) {
+      found = entry;
+    }
+  }
+  if (found && !std::filesystem::exists(getBlobFile(found->key))) { // blob was cleaned up behind our back
+    return std::nullopt;
+  }
+  return found;
+}
+
+bool CCDBBlobCache::loadBlob(Entry const& entry, o2::pmr::vector<char>& dest) const
+{
+  int fd = ::open(getBlobFile(entry.key).c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  bool ok = fstat(fd, &st) == 0;
+  if (ok) {
+    dest.resize(st.st_size);
+    size_t done = 0;
+    ssize_t nread = 0;
+    while (done < dest.size() && (nread = ::read(fd, dest.data() + done, dest.size() - done)) > 0) {
+      done += nread;
+    }
+    ok = done == dest.size();
+  }
+  ::close(fd);
+  if (!ok) {
+    dest.clear();
+  }
+  return ok;
+}
+
+bool CCDBBlobCache::loadHeaders(Entry const& entry, std::map<std::string, std::string>& headers) const
+{
+  int fd = ::open(getHeadersFile(entry.key).c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  std::string content;
+  bool ok = readAll(fd, content);
+  ::close(fd);
+  std::istringstream lines(content);
+  std::string line;
+  while (ok && std::getline(lines, line)) {
+    auto sep = line.find('\t');
+    if (sep != std::string::npos) {
+      headers[line.substr(0, sep)] = line.substr(sep + 1);
+    }
+  }
+  return ok;
+}
+
+bool CCDBBlobCache::store(std::string const& path, std::map<std::string, std::string> const& headers, const char* data, size_t size) const
+{
+  auto key = getKey(headers);
+  long validFrom = getLongHeader(headers, "Valid-From", -1), validUntil = getLongHeader(headers, "Valid-Until", -1);
+  long created = getLongHeader(headers, "Created", 0);
+  if (key.empty() || validFrom < 0 || validUntil <= validFrom) {
+    return false;
+  }
+  // the server guarantees the same answer only up to Cache-Valid-Until, if it provides one
+  long cacheValidUntil = getLongHeader(headers, "Cache-Valid-Until", validUntil);
+  if (cacheValidUntil > validFrom) {
+    validUntil = std::min(validUntil, cacheValidUntil);
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(getBlobFile(key)).parent_path(), ec);
+  if (!std::filesystem::exists(getHeadersFile(key))) {
+    std::string flatHeaders;
+    for (const auto& [name, value] : headers) {
+      if (name.find_first_of("\t\n") == std::string::npos && value.find('\n') == std::string::npos) {
+        flatHeaders += fmt::format("{}\t{}\n", name, value);
+      }
+    }
+    if (!writeAtomically(getHeadersFile(key), flatHeaders.data(), flatHeaders.size())) {
+      return false;
+    }
+  }
+  // the blob is made visible after its headers, so that every blob found has its headers
+  if (!std::filesystem::exists(getBlobFile(key)) && !writeAtomically(getBlobFile(key), data, size)) {
+    return false;
+  }
+
+  auto indexFile = getIndexFile(path);
+  std::filesystem::create_directories(std::filesystem::path(indexFile).parent_path(), ec);
+  int fd = ::open(indexFile.c_str(), O_RDWR | O_CREAT, 0664);
+  if (fd < 0) {
+    LOGP(error, "Failed to open the CCDB blob cache index {}", indexFile);
+    return false;
+  }
+  bool ok = flock(fd, LOCK_EX) == 0;
+  std::string content, line = fmt::format("{} {} {} {}\n", validFrom, validUntil, created, key);
+  if (ok && readAll(fd, content) && ("\n" + content).find("\n" + line) == std::string::npos) { // another process might have added it meanwhile
+    ok = lseek(fd, 0, SEEK_END) >= 0 && writeAll(fd, line.data(), line.size());
+  }
+  ::close(fd); // releases the lock
+  if (!ok) {
+    LOGP(error, "Failed to update the CCDB blob cache index {}", indexFile);
+  }
+  return ok;
+}
+
+bool CCDBBlobCache::writeAtomically(std::string const& fileName, const char* data, size_t size) const
+{
+  std::string tmpName = fileName + ".XXXXXX";
+  int fd = mkstemp(tmpName.data());
+  if (fd < 0) {
+    LOGP(error, "Failed to create a temporary file for {}", fileName);
+    return false;
+  }
+  bool ok = fchmod(fd, 0664) == 0 && writeAll(fd, data, size);
+  ok = (::close(fd) == 0) && ok;
+  if (!ok || std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    LOGP(error, "Failed to write {}", fileName);
+    std::remove(tmpName.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace o2::ccdb
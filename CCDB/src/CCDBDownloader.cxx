@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include <CCDB/CCDBDownloader.h>
+#include "CCDB/CCDBBlobCache.h"
 #include "CommonUtils/StringUtils.h"
 #include "CCDB/CCDBTimeStampUtils.h"
 #include "Framework/Signpost.h"
@@ -330,6 +331,69 @@ void CCDBDownloader::setOnlineTimeoutSettings()
   setHappyEyeballsHeadstartTime(500);
 }
 
+void CCDBDownloader::setBlobCache(std::string const& directory, bool warmStart)
+{
+  mBlobCache = std::make_unique<CCDBBlobCache>(directory);
+  mBlobCacheWarmStart = warmStart;
+}
+
+bool CCDBDownloader::loadFromBlobCache(DownloaderRequestData* requestData, std::string const& key)
+{
+  CCDBBlobCache::Entry entry;
+  entry.key = key;
+  std::map<std::string, std::string> cachedHeaders;
+  if (!mBlobCache->loadHeaders(entry, cachedHeaders)) {
+    return false;
+  }
+  // the requester may already have this object, then it is signaled as unchanged like for the http code 304
+  bool possessed = !requestData->etag.empty() && requestData->etag == cachedHeaders["ETag"];
+  if (!possessed && !(requestData->hoPair.object && mBlobCache->loadBlob(entry, *requestData->hoPair.object))) {
+    return false;
+  }
+  if (requestData->headers) {
+    for (auto& [name, value] : cachedHeaders) {
+      requestData->headers->emplace(name, value); // does not override what the server has just sent
+    }
+  }
+  return true;
+}
+
+void CCDBDownloader::storeToBlobCache(DownloaderRequestData* requestData)
+{
+  if (!requestData->hoPair.object || requestData->hoPair.object->empty()) {
+    return;
+  }
+  std::map<std::string, std::string> headers;
+  for (auto& p : requestData->hoPair.header) {
+    headers[p.first] = p.second;
+  }
+  if (!mBlobCache->store(requestData->path, headers, requestData->hoPair.object->data(), requestData->hoPair.object->size())) {
+    LOG(debug) << "Object " << requestData->path << " was not added to the blob cache";
+  }
+}
+
+void CCDBDownloader::completeAsynchRequest(DownloaderRequestData* requestData, size_t* requestsLeft, bool contentRetrieved, bool downloaded)
+{
+  if (!contentRetrieved) {
+    if (requestData->hoPair.object) {
+      requestData->hoPair.object->clear();
+    }
+    if (requestData->headers) {
+      (*requestData->headers)["Error"] = "An error occurred during retrieval";
+    }
+  } else {
+    if (downloaded && mBlobCache && requestData->useBlobCache) {
+      storeToBlobCache(requestData);
+    }
+    if (requestData->headers && requestData->headers->find("fileSize") == requestData->headers->end()) {
+      (*requestData->headers)["fileSize"] = fmt::format("{}", requestData->hoPair.object ? requestData->hoPair.object->size() : 0);
+    }
+  }
+  --(*requestsLeft);
+  curl_slist_free_all(requestData->optionsList);
+  delete requestData;
+}
+
 CCDBDownloader::curl_context_t* CCDBDownloader::createCurlContext(curl_socket_t sockfd)
 {
   curl_context_t* context;
@@ -514,7 +578,10 @@ void CCDBDownloader::transferFinished(CURL* easy_handle, CURLcode curlCode)
       // React to received http code
       if (200 <= httpCode && httpCode < 400) {
         LOG(debug) << loggingMessage;
-        if (304 == httpCode) {
+        if (304 == httpCode && !requestData->blobCacheKey.empty()) {
+          LOGP(debug, "Object is unchanged, serving it from the blob cache");
+          contentRetrieved = loadFromBlobCache(requestData, requestData->blobCacheKey);
+        } else if (304 == httpCode) {
           LOGP(debug, "Object exists but I am not serving it since it's already in your possession");
           contentRetrieved = true;
         } else if (300 <= httpCode && httpCode < 400 && performData->locInd < locations.size()) {
@@ -545,21 +612,9 @@ void CCDBDownloader::transferFinished(CURL* easy_handle, CURLcode curlCode)
       if (!rescheduled) {
         // No more transfers will be done for this request, do cleanup specific for ASYNCHRONOUS calls
         if (!contentRetrieved) {
-          if (requestData->hoPair.object) {
-            requestData->hoPair.object->clear();
-          }
-          if (requestData->headers) {
-            (*requestData->headers)["Error"] = "An error occurred during retrieval";
-          }
           LOGP(alarm, "Curl request to {}, response code: {}", url, httpCode);
-        } else {
-          if (requestData->headers && requestData->headers->find("fileSize") == requestData->headers->end()) {
-            (*requestData->headers)["fileSize"] = fmt::format("{}", requestData->hoPair.object ? requestData->hoPair.object->size() : 0);
-          }
         }
-        --(*performData->requestsLeft);
-        curl_slist_free_all(*performData->options);
-        delete requestData;
+        completeAsynchRequest(requestData, performData->requestsLeft, contentRetrieved, httpCode == 200);
         delete performData->codeDestination;
         curl_easy_cleanup(easy_handle);
       }
@@ -695,15 +750,34 @@ std::vector<CURLcode> CCDBDownloader::batchBlockingPerform(std::vector<CURL*> co
 
 void CCDBDownloader::asynchSchedule(CURL* handle, size_t* requestCounter)
 {
-  (*requestCounter)++;
-
-  CURLcode* codeVector = new CURLcode();
-
   // Get data about request
   DownloaderRequestData* requestData;
   std::multimap<std::string, std::string>* headerMap;
   std::vector<std::string>* hostsPool;
   curl_easy_getinfo(handle, CURLINFO_PRIVATE, &requestData);
+
+  (*requestCounter)++;
+
+  if (mBlobCache && requestData->useBlobCache) {
+    if (auto entry = mBlobCache->find(requestData->path, requestData->timestamp)) {
+      if (mBlobCacheWarmStart && loadFromBlobCache(requestData, entry->key)) {
+        // Served locally, no transfer is needed: the request is completed as if it had been downloaded
+        LOG(debug) << "Serving " << requestData->path << " for timestamp " << requestData->timestamp << " from the blob cache";
+        completeAsynchRequest(requestData, requestCounter, true, false);
+        curl_easy_cleanup(handle);
+        return;
+      }
+      std::map<std::string, std::string> cachedHeaders;
+      if (requestData->etag.empty() && mBlobCache->loadHeaders(*entry, cachedHeaders) && !cachedHeaders["ETag"].empty()) {
+        // Ask the server only whether the cached object is still the right one
+        requestData->optionsList = curl_slist_append(requestData->optionsList, ("If-None-Match: " + cachedHeaders["ETag"]).c_str());
+        curl_easy_setopt(handle, CURLOPT_HTTPHEADER, requestData->optionsList);
+        requestData->blobCacheKey = entry->key;
+      }
+    }
+  }
+
+  CURLcode* codeVector = new CURLcode();
   headerMap = &(requestData->hoPair.header);
   hostsPool = &(requestData->hosts);
   auto* options = &(requestData->optionsList);
@@ -16,6 +16,7 @@
 
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CCDBQuery.h"
+#include "CCDB/CCDBBlobCache.h"
 
 #include "CommonUtils/StringUtils.h"
 #include "CommonUtils/FileSystemUtils.h"
@@ -210,6 +211,15 @@ void CcdbApi::init(std::string const& host)
     }
     snapshotReport += ", prefer if available";
   }
+  // The environment option ALICEO2_CCDB_BLOBCACHE enables the node-local cache of the downloaded objects, shared by all
+  // processes using the same directory. The cached objects are revalidated with the server (which then does not send them again),
+  // unless ALICEO2_CCDB_BLOBCACHE_WARMSTART is set, in which case they are served without any query.
+  const char* blobcachedir = getenv("ALICEO2_CCDB_BLOBCACHE");
+  if (blobcachedir && blobcachedir[0] != 0 && mDownloader) {
+    bool warmStart = getenv("ALICEO2_CCDB_BLOBCACHE_WARMSTART") != nullptr;
+    mDownloader->setBlobCache(fs::weakly_canonical(fs::absolute(blobcachedir)), warmStart);
+    snapshotReport += fmt::format("{}blob cache dir={}{}", snapshotReport.empty() ? "(" : ", ", mDownloader->getBlobCache()->getDirectory(), warmStart ? ", warm start" : "");
+  }
   if (!snapshotReport.empty()) {
     snapshotReport += ')';
   }
@@ -1723,6 +1733,8 @@ void CcdbApi::scheduleDownload(RequestContext& requestContext, size_t* requestCo
   data->localContentCallback = localContentCallback;
   data->userAgent = mUniqueAgentID;
   data->optionsList = options_list;
+  data->etag = requestContext.etag;
+  data->useBlobCache = requestContext.metadata.empty() && requestContext.createdNotAfter.empty() && requestContext.createdNotBefore.empty();
 
   curl_easy_setopt(curl_handle, CURLOPT_URL, fullUrl.c_str());
   initCurlOptionsForRetrieve(curl_handle, (void*)(&data->hoPair), writeCallback, false);
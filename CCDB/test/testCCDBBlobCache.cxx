@@ -0,0 +1,307 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE CCDB
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "CCDB/CCDBBlobCache.h"
+#include "CCDB/CCDBDownloader.h"
+#include <boost/test/unit_test.hpp>
+#include <curl/curl.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace o2::ccdb;
+
+namespace
+{
+std::map<std::string, std::string> makeHeaders(std::string const& etag, long from, long until, long created)
+{
+  return {{"ETag", "\"" + etag + "\""}, {"Valid-From", std::to_string(from)}, {"Valid-Until", std::to_string(until)}, {"Created", std::to_string(created)}};
+}
+
+struct CacheDir {
+  std::string path = std::filesystem::temp_directory_path().string() + "/ccdbblobcache_" + std::to_string(getpid());
+  ~CacheDir() { std::filesystem::remove_all(path); }
+};
+
+/// Minimal CCDB server on the loopback interface, serving a single object for any path.
+/// It answers 304 to the requests revalidating the current ETag of the object, and records all the requests.
+class LocalServer
+{
+ public:
+  LocalServer()
+  {
+    mSocket = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    BOOST_REQUIRE(mSocket >= 0 && bind(mSocket, (sockaddr*)&addr, len) == 0 && listen(mSocket, 8) == 0);
+    BOOST_REQUIRE(getsockname(mSocket, (sockaddr*)&addr, &len) == 0);
+    mUrl = fmt::format("http://127.0.0.1:{}", ntohs(addr.sin_port));
+    mThread = std::thread([this]() { serve(); });
+  }
+  ~LocalServer()
+  {
+    shutdown(mSocket, SHUT_RDWR); // unblocks the accept
+    mThread.join();
+    close(mSocket);
+  }
+
+  const std::string& getUrl() const { return mUrl; }
+
+  void setObject(std::string const& etag, std::string const& body, long from, long until, long created)
+  {
+    std::lock_guard lock(mMutex);
+    mHeaders = fmt::format("ETag: \"{}\"\r\nValid-From: {}\r\nValid-Until: {}\r\nCreated: {}\r\n", etag, from, until, created);
+    mETag = etag;
+    mBody = body;
+  }
+
+  std::vector<std::string> getRequests()
+  {
+    std::lock_guard lock(mMutex);
+    return mRequests;
+  }
+
+ private:
+  void serve()
+  {
+    int connection;
+    while ((connection = accept(mSocket, nullptr, nullptr)) >= 0) {
+      std::string request;
+      char buffer[4096];
+      ssize_t n;
+      while (request.find("\r\n\r\n") == std::string::npos && (n = read(connection, buffer, sizeof(buffer))) > 0) {
+        request.append(buffer, n);
+      }
+      std::string response;
+      {
+        std::lock_guard lock(mMutex);
+        mRequests.push_back(request);
+        if (request.find(fmt::format("If-None-Match: \"{}\"", mETag)) != std::string::npos) {
+          response = "HTTP/1.1 304 Not Modified\r\n" + mHeaders + "Content-Length: 0\r\nConnection: close\r\n\r\n";
+        } else {
+          response = "HTTP/1.1 200 OK\r\n" + mHeaders + fmt::format("Content-Length: {}\r\nConnection: close\r\n\r\n", mBody.size()) + mBody;
+        }
+      }
+      for (size_t sent = 0; sent < response.size() && (n = write(connection, response.data() + sent, response.size() - sent)) > 0;) {
+        sent += n;
+      }
+      close(connection);
+    }
+  }
+
+  int mSocket = -1;
+  std::string mUrl;
+  std::thread mThread;
+  std::mutex mMutex;
+  std::string mETag, mBody, mHeaders;
+  std::vector<std::string> mRequests;
+};
+
+size_t writeToVector(char* contents, size_t size, size_t nmemb, void* userdata)
+{
+  auto* ho = static_cast<o2::ccdb::HeaderObjectPair_t*>(userdata);
+  ho->object->insert(ho->object->end(), contents, contents + size * nmemb);
+  return size * nmemb;
+}
+
+size_t writeToHeaderMap(char* buffer, size_t size, size_t nitems, void* userdata)
+{
+  std::string line(buffer, size * nitems);
+  auto colon = line.find(':');
+  if (colon != std::string::npos) {
+    auto value = line.substr(colon + 1);
+    value.erase(0, value.find_first_not_of(' '));
+    value.erase(value.find_last_not_of("\r\n") + 1);
+    static_cast<std::multimap<std::string, std::string>*>(userdata)->emplace(line.substr(0, colon), value);
+  }
+  return size * nitems;
+}
+
+/// Retrieves the object of the path for the timestamp via an asynchronous request of the downloader, as CcdbApi does
+void retrieve(CCDBDownloader& downloader, std::string const& host, std::string const& path, long timestamp,
+              o2::pmr::vector<char>& dest, std::map<std::string, std::string>& headers)
+{
+  auto* handle = curl_easy_init();
+  auto* data = new DownloaderRequestData();
+  data->hosts.emplace_back(host);
+  data->path = path;
+  data->timestamp = timestamp;
+  data->hoPair.object = &dest;
+  data->headers = &headers;
+  data->optionsList = nullptr;
+  data->useBlobCache = true;
+  data->localContentCallback = nullptr;
+  curl_easy_setopt(handle, CURLOPT_URL, fmt::format("{}/{}/{}", host, path, timestamp).c_str());
+  curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, writeToVector);
+  curl_easy_setopt(handle, CURLOPT_WRITEDATA, (void*)&data->hoPair);
+  curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, writeToHeaderMap);
+  curl_easy_setopt(handle, CURLOPT_HEADERDATA, (void*)&data->hoPair.header);
+  curl_easy_setopt(handle, CURLOPT_PRIVATE, (void*)data);
+  size_t requestsLeft = 0;
+  downloader.asynchSchedule(handle, &requestsLeft);
+  while (requestsLeft > 0) {
+    downloader.runLoop(false);
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(blobcache_store_and_find)
+{
+  CacheDir dir;
+  CCDBBlobCache cache(dir.path);
+  std::string obj1 = "first object", obj2 = "second object";
+
+  BOOST_CHECK(cache.store("TST/Calib/Test", makeHeaders("aaaa-1111", 100, 200, 10), obj1.data(), obj1.size()));
+  BOOST_CHECK(cache.store("TST/Calib/Test", makeHeaders("bbbb-2222", 150, 300, 20), obj2.data(), obj2.size()));
+  // same object again: neither the blob nor the index are duplicated
+  BOOST_CHECK(cache.store("TST/Calib/Test", makeHeaders("aaaa-1111", 100, 200, 10), obj1.data(), obj1.size()));
+  // not identifiable or without validity
+  BOOST_CHECK(!cache.store("TST/Calib/Test", {{"Valid-From", "0"}, {"Valid-Until", "10"}}, obj1.data(), obj1.size()));
+  BOOST_CHECK(!cache.store("TST/Calib/Test", {{"ETag", "\"cccc-3333\""}}, obj1.data(), obj1.size()));
+
+  BOOST_CHECK(!cache.find("TST/Calib/Test", 50));
+  BOOST_CHECK(!cache.find("TST/Calib/Other", 120));
+  auto entry = cache.find("TST/Calib/Test", 120);
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK_EQUAL(entry->key, "aaaa-1111");
+  // the most recently created object wins in the overlap
+  entry = cache.find("/TST/Calib/Test", 170);
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK_EQUAL(entry->key, "bbbb-2222");
+
+  o2::pmr::vector<char> dest;
+  BOOST_CHECK(cache.loadBlob(*entry, dest));
+  BOOST_CHECK_EQUAL(std::string(dest.begin(), dest.end()), obj2);
+  std::map<std::string, std::string> headers;
+  BOOST_CHECK(cache.loadHeaders(*entry, headers));
+  BOOST_CHECK_EQUAL(headers["ETag"], "\"bbbb-2222\"");
+  BOOST_CHECK_EQUAL(headers["Valid-Until"], "300");
+}
+
+BOOST_AUTO_TEST_CASE(blobcache_concurrent_store)
+{
+  CacheDir dir;
+  const int nThreads = 8, nObjects = 50;
+  std::vector<std::thread> threads;
+  for (int it = 0; it < nThreads; it++) {
+    threads.emplace_back([&dir]() {
+      CCDBBlobCache cache(dir.path); // as a separate process would do
+      for (int i = 0; i < nObjects; i++) {
+        std::string obj(1000 + i, char('a' + i % 26));
+        cache.store("TST/Calib/Concurrent", makeHeaders("obj-" + std::to_string(i), i * 10, (i + 1) * 10, i), obj.data(), obj.size());
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  CCDBBlobCache cache(dir.path);
+  for (int i = 0; i < nObjects; i++) {
+    auto entry = cache.find("TST/Calib/Concurrent", i * 10 + 5);
+    BOOST_REQUIRE(entry);
+    BOOST_CHECK_EQUAL(entry->key, "obj-" + std::to_string(i));
+    o2::pmr::vector<char> dest;
+    BOOST_CHECK(cache.loadBlob(*entry, dest));
+    BOOST_CHECK_EQUAL(dest.size(), 1000 + i);
+  }
+  std::ifstream index(cache.getIndexFile("TST/Calib/Concurrent"));
+  BOOST_CHECK_EQUAL(std::count(std::istreambuf_iterator<char>(index), std::istreambuf_iterator<char>(), '\n'), nObjects);
+}
+
+BOOST_AUTO_TEST_CASE(blobcache_warm_start)
+{
+  CacheDir dir;
+  LocalServer server;
+  server.setObject("dddd-4444", "object of the server", 300, 400, 30);
+  const std::string cached = "object of the previous run";
+  {
+    // pre-populated by a previous run
+    CCDBBlobCache cache(dir.path);
+    BOOST_REQUIRE(cache.store("TST/Calib/Test", makeHeaders("aaaa-1111", 100, 200, 10), cached.data(), cached.size()));
+  }
+  CCDBDownloader downloader;
+  downloader.setRequestTimeoutTime(10000);
+  downloader.setBlobCache(dir.path, true);
+
+  // served from the disc without any query to the server
+  o2::pmr::vector<char> dest;
+  std::map<std::string, std::string> headers;
+  retrieve(downloader, server.getUrl(), "TST/Calib/Test", 150, dest, headers);
+  BOOST_CHECK_EQUAL(std::string(dest.begin(), dest.end()), cached);
+  BOOST_CHECK_EQUAL(headers["ETag"], "\"aaaa-1111\"");
+  BOOST_CHECK_EQUAL(headers["fileSize"], std::to_string(cached.size()));
+  BOOST_CHECK(server.getRequests().empty());
+
+  // not in the cache: downloaded, then stored
+  dest.clear();
+  headers.clear();
+  retrieve(downloader, server.getUrl(), "TST/Calib/Test", 350, dest, headers);
+  BOOST_CHECK_EQUAL(std::string(dest.begin(), dest.end()), "object of the server");
+  BOOST_CHECK_EQUAL(server.getRequests().size(), 1);
+  auto entry = downloader.getBlobCache()->find("TST/Calib/Test", 350);
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK_EQUAL(entry->key, "dddd-4444");
+}
+
+BOOST_AUTO_TEST_CASE(blobcache_etag_revalidation)
+{
+  CacheDir dir;
+  LocalServer server;
+  const std::string cached = "object of the previous run";
+  {
+    CCDBBlobCache cache(dir.path);
+    BOOST_REQUIRE(cache.store("TST/Calib/Test", makeHeaders("aaaa-1111", 100, 200, 10), cached.data(), cached.size()));
+  }
+  CCDBDownloader downloader;
+  downloader.setRequestTimeoutTime(10000);
+  downloader.setBlobCache(dir.path);
+
+  // the server still has the cached object: it only confirms it, which is then read from the disc
+  server.setObject("aaaa-1111", "must not be sent", 100, 200, 10);
+  o2::pmr::vector<char> dest;
+  std::map<std::string, std::string> headers;
+  retrieve(downloader, server.getUrl(), "TST/Calib/Test", 150, dest, headers);
+  auto requests = server.getRequests();
+  BOOST_REQUIRE_EQUAL(requests.size(), 1);
+  BOOST_CHECK(requests[0].find("If-None-Match: \"aaaa-1111\"") != std::string::npos);
+  BOOST_CHECK_EQUAL(std::string(dest.begin(), dest.end()), cached);
+  BOOST_CHECK_EQUAL(headers["ETag"], "\"aaaa-1111\"");
+  BOOST_CHECK(headers.find("Error") == headers.end());
+
+  // a newer object replaced it on the server: it is downloaded and stored
+  server.setObject("bbbb-2222", "newer object", 100, 200, 20);
+  dest.clear();
+  headers.clear();
+  retrieve(downloader, server.getUrl(), "TST/Calib/Test", 150, dest, headers);
+  requests = server.getRequests();
+  BOOST_REQUIRE_EQUAL(requests.size(), 2);
+  BOOST_CHECK(requests[1].find("If-None-Match: \"aaaa-1111\"") != std::string::npos);
+  BOOST_CHECK_EQUAL(std::string(dest.begin(), dest.end()), "newer object");
+  BOOST_CHECK_EQUAL(headers["ETag"], "\"bbbb-2222\"");
+  auto entry = downloader.getBlobCache()->find("TST/Calib/Test", 150);
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK_EQUAL(entry->key, "bbbb-2222");
+}
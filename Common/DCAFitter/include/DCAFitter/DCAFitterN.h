@@ -92,6 +92,9 @@ struct LogLogThrottler {
   GPUdi() void clear() { evCount = evCountPrev = logCount = 0; }
 };
 
+template <typename Fitter, int W>
+class DCAFitterNBatch;
+
 template <int N, typename... Args>
 class DCAFitterN
 {
@@ -241,6 +244,8 @@ class DCAFitterN
   GPUdi() float getMaxSnp() const { return mMaxSnp; }
   GPUdi() float getMasStep() const { return mMaxStep; }
   GPUdi() float getMinXSeed() const { return mMinXSeed; }
+  GPUdi() float getMinRelChi2Change() const { return mMinRelChi2Change; }
+  GPUdi() bool getCollinear() const { return mIsCollinear; }
 
   template <class... Tr>
   GPUd() int process(const Tr&... args);
@@ -251,6 +256,11 @@ class DCAFitterN
   GPUdi() size_t getCallID() const { return mCallID; }
 
  protected:
+  template <class... Tr>
+  GPUd() bool initSeeds(const Tr&... args);
+  GPUd() bool initHypothesis(int ic);
+  GPUd() void storeHypothesis();
+  GPUd() int orderHypotheses();
   GPUd() bool calcPCACoefs();
   GPUd() bool calcInverseWeight();
   GPUd() void calcResidDerivatives();
@@ -265,6 +275,8 @@ class DCAFitterN
   GPUd() double calcChi2() const;
   GPUd() double calcChi2NoErr() const;
   GPUd() bool correctTracks(const VecND& corrX);
+  GPUd() bool prepareMinimizeChi2();
+  GPUd() bool prepareMinimizeChi2NoErr();
   GPUd() bool minimizeChi2();
   GPUd() bool minimizeChi2NoErr();
   GPUd() bool roughDZCut() const;
@@ -383,6 +395,10 @@ class DCAFitterN
   float mMaxStep = 2.0;                                                                           // Max step for propagation with Propagator
   int mFitterID = 0;                                                                              // locat fitter ID (mostly for debugging)
   size_t mCallID = 0;
+
+  template <typename Fitter, int W>
+  friend class DCAFitterNBatch;
+
   ClassDefNV(DCAFitterN, 2);
 };
 
@@ -392,15 +408,36 @@ template <class... Tr>
 GPUd() int DCAFitterN<N, Args...>::process(const Tr&... args)
 {
   // This is a main entry point: fit PCA of N tracks
-  mCallID++;
   static_assert(sizeof...(args) == N, "incorrect number of input tracks");
+  if (!initSeeds(args...)) {
+    return 0; // no crossing
+  }
+  // check all crossings
+  for (int ic = 0; ic < mCrossings.nDCA; ic++) {
+    if (!initHypothesis(ic)) {
+      continue;
+    }
+    if (mUseAbsDCA ? minimizeChi2NoErr() : minimizeChi2()) {
+      storeHypothesis();
+    }
+  }
+  return orderHypotheses();
+}
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+template <class... Tr>
+GPUd() bool DCAFitterN<N, Args...>::initSeeds(const Tr&... args)
+{
+  // assign the tracks and find the XY crossings of their circles to be used as PCA seeds
+  mCallID++;
   assign(0, args...);
   clear();
   for (int i = 0; i < N; i++) {
     mTrAux[i].set(*mOrigTrPtr[i], mBz);
   }
   if (!mCrossings.set(mTrAux[0], *mOrigTrPtr[0], mTrAux[1], *mOrigTrPtr[1], mMaxDXYIni, mIsCollinear)) { // even for N>2 it should be enough to test just 1 loop
-    return 0;                                                                                            // no crossing
+    return false;                                                                                        // no crossing
   }
   for (int ih = 0; ih < MAXHYP; ih++) {
     mPropFailed[ih] = false;
@@ -417,29 +454,44 @@ GPUd() int DCAFitterN<N, Args...>::process(const Tr&... args)
       mCrossings.yDCA[0] = 0.5 * (mCrossings.yDCA[0] + mCrossings.yDCA[1]);
     }
   }
-  // check all crossings
-  for (int ic = 0; ic < mCrossings.nDCA; ic++) {
-    // check if radius is acceptable
-    if (mCrossings.xDCA[ic] * mCrossings.xDCA[ic] + mCrossings.yDCA[ic] * mCrossings.yDCA[ic] > mMaxR2) {
-      continue;
-    }
-    mCrossIDCur = ic;
-    mCrossIDAlt = (mCrossings.nDCA == 2 && mAllowAltPreference) ? 1 - ic : -1; // works for max 2 crossings
-    mNIters[mCurHyp] = 0;
-    mTrPropDone[mCurHyp] = false;
-    mChi2[mCurHyp] = -1.;
-    mPCA[mCurHyp][0] = mCrossings.xDCA[ic];
-    mPCA[mCurHyp][1] = mCrossings.yDCA[ic];
+  return true;
+}
 
-    if (mUseAbsDCA ? minimizeChi2NoErr() : minimizeChi2()) {
-      mOrder[mCurHyp] = mCurHyp;
-      if (mPropagateToPCA && !propagateTracksToVertex(mCurHyp)) {
-        continue; // discard candidate if failed to propagate to it
-      }
-      mCurHyp++;
-    }
+//__________________________________________________________________________
+template <int N, typename... Args>
+GPUd() bool DCAFitterN<N, Args...>::initHypothesis(int ic)
+{
+  // prepare the minimization for the crossing ic as a seed, return false if the seed is not acceptable
+  if (mCrossings.xDCA[ic] * mCrossings.xDCA[ic] + mCrossings.yDCA[ic] * mCrossings.yDCA[ic] > mMaxR2) { // check if radius is acceptable
+    return false;
   }
+  mCrossIDCur = ic;
+  mCrossIDAlt = (mCrossings.nDCA == 2 && mAllowAltPreference) ? 1 - ic : -1; // works for max 2 crossings
+  mNIters[mCurHyp] = 0;
+  mTrPropDone[mCurHyp] = false;
+  mChi2[mCurHyp] = -1.;
+  mPCA[mCurHyp][0] = mCrossings.xDCA[ic];
+  mPCA[mCurHyp][1] = mCrossings.yDCA[ic];
+  return true;
+}
 
+//__________________________________________________________________________
+template <int N, typename... Args>
+GPUd() void DCAFitterN<N, Args...>::storeHypothesis()
+{
+  // validate the current hypothesis after successful minimization
+  mOrder[mCurHyp] = mCurHyp;
+  if (mPropagateToPCA && !propagateTracksToVertex(mCurHyp)) {
+    return; // discard candidate if failed to propagate to it
+  }
+  mCurHyp++;
+}
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+GPUd() int DCAFitterN<N, Args...>::orderHypotheses()
+{
+  // order validated hypotheses in quality, return their number
   for (int i = mCurHyp; i--;) { // order in quality
     for (int j = i; j--;) {
       if (mChi2[mOrder[i]] < mChi2[mOrder[j]]) {
@@ -922,9 +974,9 @@ GPUdi() double DCAFitterN<N, Args...>::getAbsMax(const VecND& v)
 
 //___________________________________________________________________
 template <int N, typename... Args>
-GPUd() bool DCAFitterN<N, Args...>::minimizeChi2()
+GPUd() bool DCAFitterN<N, Args...>::prepareMinimizeChi2()
 {
-  // find best chi2 (weighted DCA) of N tracks in the vicinity of the seed PCA
+  // propagate the tracks to the seed PCA and calculate the starting PCA and residuals of the weighted DCA minimization
   for (int i = N; i--;) {
     mCandTr[mCurHyp][i] = *mOrigTrPtr[i];
     auto x = mTrAux[i].c * mPCA[mCurHyp][0] + mTrAux[i].s * mPCA[mCurHyp][1]; // X of PCA in the track frame
@@ -960,6 +1012,17 @@ GPUd() bool DCAFitterN<N, Args...>::minimizeChi2()
   }
   calcPCA();            // current PCA
   calcTrackResiduals(); // current track residuals
+  return true;
+}
+
+//___________________________________________________________________
+template <int N, typename... Args>
+GPUd() bool DCAFitterN<N, Args...>::minimizeChi2()
+{
+  // find best chi2 (weighted DCA) of N tracks in the vicinity of the seed PCA
+  if (!prepareMinimizeChi2()) {
+    return false;
+  }
   float chi2Upd, chi2 = calcChi2();
   do {
     calcTrackDerivatives(); // current track derivatives (1st and 2nd)
@@ -998,10 +1061,9 @@ GPUd() bool DCAFitterN<N, Args...>::minimizeChi2()
 
 //___________________________________________________________________
 template <int N, typename... Args>
-GPUd() bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
+GPUd() bool DCAFitterN<N, Args...>::prepareMinimizeChi2NoErr()
 {
-  // find best chi2 (absolute DCA) of N tracks in the vicinity of the PCA seed
-
+  // propagate the tracks to the seed PCA and calculate the starting PCA and residuals of the absolute DCA minimization
   for (int i = N; i--;) {
     mCandTr[mCurHyp][i] = *mOrigTrPtr[i];
     auto x = mTrAux[i].c * mPCA[mCurHyp][0] + mTrAux[i].s * mPCA[mCurHyp][1]; // X of PCA in the track frame
@@ -1016,6 +1078,17 @@ GPUd() bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
 
   calcPCANoErr();       // current PCA
   calcTrackResiduals(); // current track residuals
+  return true;
+}
+
+//___________________________________________________________________
+template <int N, typename... Args>
+GPUd() bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
+{
+  // find best chi2 (absolute DCA) of N tracks in the vicinity of the PCA seed
+  if (!prepareMinimizeChi2NoErr()) {
+    return false;
+  }
   float chi2Upd, chi2 = calcChi2NoErr();
   do {
     calcTrackDerivatives();      // current track derivatives (1st and 2nd)
@@ -0,0 +1,518 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DCAFitterNBatch.h
+/// \brief Batched CPU processing of many DCAFitterN candidates, with the Newton iterations run in lockstep
+
+#ifndef _ALICEO2_DCA_FITTERN_BATCH_
+#define _ALICEO2_DCA_FITTERN_BATCH_
+
+#include "DCAFitter/DCAFitterN.h"
+#include <array>
+#include <limits>
+#include <vector>
+#include <stdexcept>
+
+namespace o2
+{
+namespace vertexing
+{
+
+/// Fits the candidates of a bulk with one DCAFitterN per candidate, as device::processBulk does on the GPU.
+/// The seeding, the track propagations and the final ordering are done by each fitter exactly as in DCAFitterN::process,
+/// while the Newton-Raphson minimization of W seeds at a time is done in lockstep on structure-of-arrays copies of
+/// their state: every arithmetic loop runs over the W lanes, so that the compiler can vectorize it, and the lanes
+/// which have converged (or failed) are masked by zeroing their parameter corrections.
+/// After processing, the fitter of every candidate gives the same results as after its own process call
+/// (up to the rounding of the lockstep arithmetic) and provides the usual getters.
+template <typename Fitter, int W = 8>
+class DCAFitterNBatch
+{
+  static constexpr int N = Fitter::getNProngs();
+  static constexpr int NSym = N * (N + 1) / 2;
+
+ public:
+  static constexpr int getWidth() { return W; }
+
+  /// fit the candidate {args[0][i], ..., args[N-1][i]} with fitters[i], storing the number of found PCAs to results[i]
+  template <class... Tr>
+  void process(std::vector<Fitter>& fitters, std::vector<int>& results, const std::vector<Tr>&... args);
+
+ private:
+  enum LaneStatus : int { Active,
+                          Converged,
+                          Failed,
+                          Alternative };
+
+  /// state of W seeds minimized in lockstep, [...][W] arrays are indexed by the lane in the last dimension
+  struct Lanes {
+    std::array<Fitter*, W> fitter{};
+    int size = 0;
+    alignas(64) double pos[N][3][W];     // track positions in their frames
+    alignas(64) double res[N][3][W];     // track residuals wrt PCA in their frames
+    alignas(64) double pca[3][W];        // PCA in the global frame
+    alignas(64) double coef[N][3][3][W]; // weighted mode: PCA = sum_i coef_i * pos_i
+    alignas(64) double c[N][W], s[N][W]; // cos and sin of tracks alpha
+    alignas(64) double covI[N][4][W];    // weighted mode: inverse cov. matrices {sxx, syy, syz, szz}
+    alignas(64) double dydx[N][W], dzdx[N][W], d2ydx2[N][W], d2zdx2[N][W];
+    alignas(64) double gradA[N][N][3][W]; // dChi2/dx_i = sum_j res_j * gradA_ij
+    alignas(64) double hessB[N][N][3][W]; // d2Chi2/dx_i/dx_j = hess0_ij + res_m * hessB_ij, with m = j (weighted) or i (abs.)
+    alignas(64) double hess0[NSym][W];
+    alignas(64) double xCur[W], yCur[W], xAlt[W], yAlt[W];
+    alignas(64) float chi2[W], minParamChange[W], minRelChi2Change[W];
+    alignas(64) int nIter[W], maxIter[W], status[W];
+    alignas(64) bool checkAlt[W];
+  };
+
+  static constexpr int symID(int i, int j) { return i * (i + 1) / 2 + j; } // j <= i
+
+  template <bool AbsDCA>
+  void addLane(Lanes& lanes, Fitter& ft);
+  template <bool AbsDCA>
+  void copyLane(Lanes& lanes, int from, int to);
+  template <bool AbsDCA>
+  void minimize(Lanes& lanes);
+  template <bool AbsDCA>
+  void calcPCA(Lanes& lanes);
+  template <bool AbsDCA>
+  void calcChi2(const Lanes& lanes, float* chi2) const;
+  template <bool AbsDCA>
+  void solve(const Lanes& lanes, double (&dx)[N][W]) const;
+  void calcResiduals(Lanes& lanes);
+  void flush(Lanes& lanes, bool absDCA);
+
+  Lanes mLanesW; // weighted DCA minimization
+  Lanes mLanesA; // abs. DCA minimization
+};
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+template <class... Tr>
+void DCAFitterNBatch<Fitter, W>::process(std::vector<Fitter>& fitters, std::vector<int>& results, const std::vector<Tr>&... args)
+{
+  static_assert(sizeof...(args) == N, "incorrect number of input track vectors");
+  const size_t nCand = fitters.size();
+  if (((args.size() != nCand) || ...)) {
+    throw std::runtime_error("number of tracks of every prong must be equal to the number of fitters");
+  }
+  results.resize(nCand);
+  std::vector<bool> seeded(nCand);
+  for (size_t ic = 0; ic < nCand; ic++) {
+    seeded[ic] = fitters[ic].initSeeds(args[ic]...);
+  }
+  // the 2nd seed of a candidate may depend on the result of the 1st one, hence the seeds are processed in 2 passes
+  for (int ihyp = 0; ihyp < Fitter::MAXHYP; ihyp++) {
+    for (size_t ic = 0; ic < nCand; ic++) {
+      auto& ft = fitters[ic];
+      if (!seeded[ic] || ihyp >= ft.mCrossings.nDCA || !ft.initHypothesis(ihyp)) {
+        continue;
+      }
+      if (ft.mUseAbsDCA) {
+        if (ft.prepareMinimizeChi2NoErr()) {
+          addLane<true>(mLanesA, ft);
+        }
+      } else if (ft.prepareMinimizeChi2()) {
+        addLane<false>(mLanesW, ft);
+      }
+    }
+    flush(mLanesA, true);
+    flush(mLanesW, false);
+  }
+  for (size_t ic = 0; ic < nCand; ic++) {
+    results[ic] = seeded[ic] ? fitters[ic].orderHypotheses() : 0;
+  }
+}
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+template <bool AbsDCA>
+void DCAFitterNBatch<Fitter, W>::addLane(Lanes& lanes, Fitter& ft)
+{
+  // load the state of the fitter prepared for the minimization of its current hypothesis to the next lane
+  const int l = lanes.size, hyp = ft.mCurHyp;
+  ft.calcTrackDerivatives(); // track derivatives and hence the residuals derivatives do not change during the minimization
+  if constexpr (AbsDCA) {
+    ft.calcResidDerivativesNoErr();
+  } else {
+    ft.calcResidDerivatives();
+  }
+  lanes.fitter[l] = &ft;
+  for (int i = 0; i < N; i++) {
+    const auto& der = ft.mTrDer[hyp][i];
+    lanes.c[i][l] = ft.mTrAux[i].c;
+    lanes.s[i][l] = ft.mTrAux[i].s;
+    lanes.dydx[i][l] = der.dydx;
+    lanes.dzdx[i][l] = der.dzdx;
+    lanes.d2ydx2[i][l] = der.d2ydx2;
+    lanes.d2zdx2[i][l] = der.d2zdx2;
+    for (int k = 0; k < 3; k++) {
+      lanes.pos[i][k][l] = ft.mTrPos[hyp][i][k];
+      lanes.res[i][k][l] = ft.mTrRes[hyp][i][k];
+    }
+    if constexpr (!AbsDCA) {
+      const auto& cov = ft.mTrcEInv[hyp][i];
+      lanes.covI[i][0][l] = cov.sxx;
+      lanes.covI[i][1][l] = cov.syy;
+      lanes.covI[i][2][l] = cov.syz;
+      lanes.covI[i][3][l] = cov.szz;
+      for (int k = 0; k < 3; k++) {
+        for (int m = 0; m < 3; m++) {
+          lanes.coef[i][k][m][l] = ft.mTrCFVT[hyp][i][k][m];
+        }
+      }
+    }
+  }
+  // split the chi2 derivatives in the parts constant during the minimization and the coefficients of the residuals
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      const auto& dr1 = ft.mDResidDx[j][i]; // j-th residuals derivative over X param of track i
+      if constexpr (AbsDCA) {
+        for (int k = 0; k < 3; k++) {
+          lanes.gradA[i][j][k][l] = dr1[k];
+        }
+      } else {
+        const auto& cov = ft.mTrcEInv[hyp][j];
+        lanes.gradA[i][j][0][l] = cov.sxx * dr1[0];
+        lanes.gradA[i][j][1][l] = cov.syy * dr1[1] + cov.syz * dr1[2];
+        lanes.gradA[i][j][2][l] = cov.syz * dr1[1] + cov.szz * dr1[2];
+      }
+    }
+  }
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      double h0 = 0;
+      for (int k = 0; k < N; k++) {
+        for (int m = 0; m < 3; m++) {
+          h0 += AbsDCA ? ft.mDResidDx[k][i][m] * ft.mDResidDx[k][j][m] : ft.mDResidDx[k][j][m] * lanes.gradA[i][k][m][l];
+        }
+      }
+      lanes.hess0[symID(i, j)][l] = h0;
+      if constexpr (AbsDCA) {
+        for (int k = 0; k < 3; k++) {
+          lanes.hessB[i][j][k][l] = ft.mD2ResidDx2[i][j][k];
+        }
+      } else {
+        const auto& cov = ft.mTrcEInv[hyp][j];
+        const auto& dr2 = ft.mD2ResidDx2[j][j];
+        lanes.hessB[i][j][0][l] = cov.sxx * dr2[0];
+        lanes.hessB[i][j][1][l] = cov.syy * dr2[1] + cov.syz * dr2[2];
+        lanes.hessB[i][j][2][l] = cov.syz * dr2[1] + cov.szz * dr2[2];
+      }
+    }
+  }
+  for (int k = 0; k < 3; k++) {
+    lanes.pca[k][l] = ft.mPCA[hyp][k];
+  }
+  lanes.xCur[l] = ft.mCrossings.xDCA[ft.mCrossIDCur];
+  lanes.yCur[l] = ft.mCrossings.yDCA[ft.mCrossIDCur];
+  lanes.checkAlt[l] = ft.mCrossIDAlt >= 0;
+  lanes.xAlt[l] = lanes.checkAlt[l] ? ft.mCrossings.xDCA[ft.mCrossIDAlt] : 0.;
+  lanes.yAlt[l] = lanes.checkAlt[l] ? ft.mCrossings.yDCA[ft.mCrossIDAlt] : 0.;
+  lanes.chi2[l] = AbsDCA ? ft.calcChi2NoErr() : ft.calcChi2();
+  lanes.minParamChange[l] = ft.mMinParamChange;
+  lanes.minRelChi2Change[l] = ft.mMinRelChi2Change;
+  lanes.maxIter[l] = ft.mMaxIter;
+  lanes.nIter[l] = 0;
+  lanes.status[l] = Active;
+  if (++lanes.size == W) {
+    flush(lanes, AbsDCA);
+  }
+}
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+template <bool AbsDCA>
+void DCAFitterNBatch<Fitter, W>::copyLane(Lanes& lanes, int from, int to)
+{
+  // fill unused lane by a copy of the valid one, to keep the lockstep arithmetic of the idle lanes finite
+  auto cp = [from, to](auto& arr) { arr[to] = arr[from]; };
+  for (int i = 0; i < N; i++) {
+    cp(lanes.c[i]);
+    cp(lanes.s[i]);
+    cp(lanes.dydx[i]);
+    cp(lanes.dzdx[i]);
+    cp(lanes.d2ydx2[i]);
+    cp(lanes.d2zdx2[i]);
+    for (int k = 0; k < 3; k++) {
+      cp(lanes.pos[i][k]);
+      cp(lanes.res[i][k]);
+      if constexpr (!AbsDCA) {
+        for (int m = 0; m < 3; m++) {
+          cp(lanes.coef[i][k][m]);
+        }
+      }
+    }
+    if constexpr (!AbsDCA) {
+      for (int k = 0; k < 4; k++) {
+        cp(lanes.covI[i][k]);
+      }
+    }
+    for (int j = 0; j < N; j++) {
+      for (int k = 0; k < 3; k++) {
+        cp(lanes.gradA[i][j][k]);
+        cp(lanes.hessB[i][j][k]);
+      }
+    }
+  }
+  for (int i = 0; i < NSym; i++) {
+    cp(lanes.hess0[i]);
+  }
+  for (int k = 0; k < 3; k++) {
+    cp(lanes.pca[k]);
+  }
+  cp(lanes.xCur);
+  cp(lanes.yCur);
+  cp(lanes.xAlt);
+  cp(lanes.yAlt);
+  cp(lanes.checkAlt);
+  cp(lanes.chi2);
+  cp(lanes.minParamChange);
+  cp(lanes.minRelChi2Change);
+  cp(lanes.maxIter);
+  lanes.nIter[to] = 0;
+  lanes.status[to] = Converged;
+  lanes.fitter[to] = nullptr;
+}
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+void DCAFitterNBatch<Fitter, W>::flush(Lanes& lanes, bool absDCA)
+{
+  // minimize all filled lanes and store the results to their fitters
+  if (!lanes.size) {
+    return;
+  }
+  for (int l = lanes.size; l < W; l++) {
+    absDCA ? copyLane<true>(lanes, 0, l) : copyLane<false>(lanes, 0, l);
+  }
+  absDCA ? minimize<true>(lanes) : minimize<false>(lanes);
+  for (int l = 0; l < lanes.size; l++) {
+    auto& ft = *lanes.fitter[l];
+    const int hyp = ft.mCurHyp;
+    for (int i = 0; i < N; i++) {
+      for (int k = 0; k < 3; k++) {
+        ft.mTrPos[hyp][i][k] = lanes.pos[i][k][l];
+        ft.mTrRes[hyp][i][k] = lanes.res[i][k][l];
+      }
+    }
+    for (int k = 0; k < 3; k++) {
+      ft.mPCA[hyp][k] = lanes.pca[k][l];
+    }
+    ft.mNIters[hyp] = lanes.nIter[l];
+    if (lanes.status[l] == Alternative) {
+      ft.mAllowAltPreference = false;
+      continue;
+    }
+    if (lanes.status[l] == Failed) {
+      if (ft.mLoggerBadInv.needToLog()) {
+        printf("fitter %d: error (%ld muted): Inversion failed\n", ft.mFitterID, ft.mLoggerBadCov.getNMuted());
+        ft.mLoggerBadInv.evCountPrev = ft.mLoggerBadInv.evCount;
+      }
+      continue;
+    }
+    ft.mChi2[hyp] = lanes.chi2[l] * Fitter::NInv;
+    if (ft.mChi2[hyp] < ft.mMaxChi2) {
+      ft.storeHypothesis();
+    }
+  }
+  lanes.size = 0;
+}
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+template <bool AbsDCA>
+void DCAFitterNBatch<Fitter, W>::minimize(Lanes& lanes)
+{
+  // Newton-Raphson iterations of all lanes in lockstep, corrections = - dchi2/d{x0..xN} * [ d^2chi2/d{x0..xN}^2 ]^-1
+  alignas(64) double dx[N][W];
+  alignas(64) float chi2Upd[W];
+  bool anyActive = true;
+  while (anyActive) {
+    solve<AbsDCA>(lanes, dx);
+    for (int l = 0; l < W; l++) { // lanes which are not active any more or failed are not corrected
+      bool valid = true;
+      for (int i = 0; i < N; i++) {
+        valid = valid && dx[i][l] == dx[i][l]; // singular hessian gives NaN corrections
+      }
+      if (lanes.status[l] == Active && !valid) {
+        lanes.status[l] = Failed;
+      }
+      const bool upd = lanes.status[l] == Active;
+      for (int i = 0; i < N; i++) {
+        dx[i][l] = upd ? dx[i][l] : 0.;
+      }
+    }
+    for (int i = 0; i < N; i++) { // propagate tracks to updated X
+      for (int l = 0; l < W; l++) {
+        const double dxi = dx[i][l], dx2h = 0.5 * dxi * dxi;
+        lanes.pos[i][0][l] -= dxi;
+        lanes.pos[i][1][l] -= lanes.dydx[i][l] * dxi - dx2h * lanes.d2ydx2[i][l];
+        lanes.pos[i][2][l] -= lanes.dzdx[i][l] * dxi - dx2h * lanes.d2zdx2[i][l];
+      }
+    }
+    calcPCA<AbsDCA>(lanes);
+    for (int l = 0; l < W; l++) { // abandon the seed if the PCA is closer to the alternative one
+      const double dxCur = lanes.pca[0][l] - lanes.xCur[l], dyCur = lanes.pca[1][l] - lanes.yCur[l];
+      const double dxAlt = lanes.pca[0][l] - lanes.xAlt[l], dyAlt = lanes.pca[1][l] - lanes.yAlt[l];
+      if (lanes.status[l] == Active && lanes.checkAlt[l] && dxCur * dxCur + dyCur * dyCur > dxAlt * dxAlt + dyAlt * dyAlt) {
+        lanes.status[l] = Alternative;
+      }
+    }
+    calcResiduals(lanes);
+    calcChi2<AbsDCA>(lanes, chi2Upd);
+    anyActive = false;
+    for (int l = 0; l < W; l++) {
+      if (lanes.status[l] != Active) {
+        continue;
+      }
+      double dxMax = -1;
+      for (int i = 0; i < N; i++) {
+        const double adx = dx[i][l] < 0 ? -dx[i][l] : dx[i][l];
+        dxMax = dxMax < adx ? adx : dxMax;
+      }
+      const bool converged = dxMax < lanes.minParamChange[l] || chi2Upd[l] > lanes.chi2[l] * lanes.minRelChi2Change[l];
+      lanes.chi2[l] = chi2Upd[l];
+      if (converged || ++lanes.nIter[l] >= lanes.maxIter[l]) {
+        lanes.status[l] = Converged;
+      } else {
+        anyActive = true;
+      }
+    }
+  }
+}
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+template <bool AbsDCA>
+void DCAFitterNBatch<Fitter, W>::solve(const Lanes& lanes, double (&dx)[N][W]) const
+{
+  // solve hessian * dx = gradient of the chi2 by Gaussian elimination in every lane, singular lanes get NaN corrections
+  alignas(64) double a[N][N][W];
+  for (int i = 0; i < N; i++) {
+    for (int l = 0; l < W; l++) { // 1st derivatives
+      double g = 0;
+      for (int j = 0; j < N; j++) {
+        g += lanes.res[j][0][l] * lanes.gradA[i][j][0][l] + lanes.res[j][1][l] * lanes.gradA[i][j][1][l] + lanes.res[j][2][l] * lanes.gradA[i][j][2][l];
+      }
+      dx[i][l] = g;
+    }
+    for (int j = 0; j <= i; j++) { // 2nd derivatives, symmetric matrix
+      const int m = AbsDCA ? i : j;
+      for (int l = 0; l < W; l++) {
+        a[i][j][l] = a[j][i][l] = lanes.hess0[symID(i, j)][l] + lanes.res[m][0][l] * lanes.hessB[i][j][0][l] +
+                                  lanes.res[m][1][l] * lanes.hessB[i][j][1][l] + lanes.res[m][2][l] * lanes.hessB[i][j][2][l];
+      }
+    }
+  }
+  for (int k = 0; k < N; k++) { // forward elimination
+    for (int i = k + 1; i < N; i++) {
+      for (int l = 0; l < W; l++) {
+        const double f = a[i][k][l] / a[k][k][l];
+        for (int j = k + 1; j < N; j++) {
+          a[i][j][l] -= f * a[k][j][l];
+        }
+        dx[i][l] -= f * dx[k][l];
+      }
+    }
+  }
+  for (int i = N; i--;) { // back substitution
+    for (int l = 0; l < W; l++) {
+      double v = dx[i][l];
+      for (int j = i + 1; j < N; j++) {
+        v -= a[i][j][l] * dx[j][l];
+      }
+      const double piv = a[i][i][l];
+      dx[i][l] = piv != 0. ? v / piv : std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+}
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+template <bool AbsDCA>
+void DCAFitterNBatch<Fitter, W>::calcPCA(Lanes& lanes)
+{
+  // calculate PCA of every lane as a weighted (or simple) average of track positions
+  for (int k = 0; k < 3; k++) {
+    for (int l = 0; l < W; l++) {
+      lanes.pca[k][l] = 0.;
+    }
+  }
+  for (int i = 0; i < N; i++) {
+    for (int l = 0; l < W; l++) {
+      const double x = lanes.pos[i][0][l], y = lanes.pos[i][1][l], z = lanes.pos[i][2][l];
+      if constexpr (AbsDCA) {
+        lanes.pca[0][l] += x * lanes.c[i][l] - y * lanes.s[i][l]; // loc->glo
+        lanes.pca[1][l] += x * lanes.s[i][l] + y * lanes.c[i][l];
+        lanes.pca[2][l] += z;
+      } else {
+        for (int k = 0; k < 3; k++) {
+          lanes.pca[k][l] += lanes.coef[i][k][0][l] * x + lanes.coef[i][k][1][l] * y + lanes.coef[i][k][2][l] * z;
+        }
+      }
+    }
+  }
+  if constexpr (AbsDCA) {
+    for (int k = 0; k < 3; k++) {
+      for (int l = 0; l < W; l++) {
+        lanes.pca[k][l] *= Fitter::NInv;
+      }
+    }
+  }
+}
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+void DCAFitterNBatch<Fitter, W>::calcResiduals(Lanes& lanes)
+{
+  // calculate track residuals wrt the PCA in the track frames
+  for (int i = 0; i < N; i++) {
+    for (int l = 0; l < W; l++) {
+      const double xg = lanes.pca[0][l], yg = lanes.pca[1][l];
+      lanes.res[i][0][l] = lanes.pos[i][0][l] - (xg * lanes.c[i][l] + yg * lanes.s[i][l]); // glo->loc
+      lanes.res[i][1][l] = lanes.pos[i][1][l] - (-xg * lanes.s[i][l] + yg * lanes.c[i][l]);
+      lanes.res[i][2][l] = lanes.pos[i][2][l] - lanes.pca[2][l];
+    }
+  }
+}
+
+///_________________________________________________________________________
+template <typename Fitter, int W>
+template <bool AbsDCA>
+void DCAFitterNBatch<Fitter, W>::calcChi2(const Lanes& lanes, float* chi2) const
+{
+  // calculate weighted or abs. DCA chi2 of every lane
+  for (int l = 0; l < W; l++) {
+    double sum = 0;
+    for (int i = 0; i < N; i++) {
+      const double r0 = lanes.res[i][0][l], r1 = lanes.res[i][1][l], r2 = lanes.res[i][2][l];
+      if constexpr (AbsDCA) {
+        sum += r0 * r0 + r1 * r1 + r2 * r2;
+      } else {
+        sum += r0 * r0 * lanes.covI[i][0][l] + r1 * r1 * lanes.covI[i][1][l] + r2 * r2 * lanes.covI[i][3][l] + 2. * r1 * r2 * lanes.covI[i][2][l];
+      }
+    }
+    chi2[l] = sum;
+  }
+}
+
+/// CPU counterpart of device::processBulk: fit the candidate {args[0][i], ..., args[N-1][i]} with fitters[i]
+template <class Fitter, class... Tr>
+void processBatched(std::vector<Fitter>& fitters, std::vector<int>& results, const std::vector<Tr>&... args)
+{
+  DCAFitterNBatch<Fitter> batch;
+  batch.process(fitters, results, args...);
+}
+
+} // namespace vertexing
+} // namespace o2
+
+#endif
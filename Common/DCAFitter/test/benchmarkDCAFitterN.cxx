@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmarkDCAFitterN.cxx
+/// \brief Benchmark of the scalar and batched processing of DCAFitterN candidates
+
+#include "benchmark/benchmark.h"
+#include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitterNBatch.h"
+#include "MathUtils/Utils.h"
+#include "CommonConstants/MathConstants.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float Bz = 5.;
+constexpr int NCandidates = 10000;
+
+// pairs of opposite charge tracks from a common vertex at R = 10 cm, with randomized parameters and reference X
+std::vector<std::vector<o2::track::TrackParCov>> generateV0s(int nCand)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> uni(0., 1.);
+  std::normal_distribution<float> gaus(0., 1.);
+  const float errYZ = 1e-2, errSlp = 1e-3, errQPT = 2e-2;
+  std::array<float, 15> covm = {errYZ * errYZ, 0., errYZ * errYZ, 0, 0., errSlp * errSlp, 0., 0., 0., errSlp * errSlp, 0., 0., 0., 0., errQPT * errQPT};
+  std::vector<std::vector<o2::track::TrackParCov>> tracks(2);
+  while (int(tracks[0].size()) < nCand) {
+    const float phiV = uni(gen) * o2::constants::math::TwoPI, rdec = 10.;
+    const float xv = rdec * std::cos(phiV), yv = rdec * std::sin(phiV), zv = (uni(gen) - 0.5) * 20.;
+    std::array<o2::track::TrackParCov, 2> cand;
+    bool ok = true;
+    for (int i = 0; i < 2; i++) {
+      const float phi = phiV + (uni(gen) - 0.5) * 0.6, pt = 0.2 + uni(gen) * 2.;
+      float s, c, x;
+      std::array<float, 5> params;
+      o2::math_utils::sincos(phi, s, c);
+      o2::math_utils::rotateZInv(xv, yv, x, params[0], s, c);
+      params[1] = zv + gaus(gen) * errYZ;
+      params[0] += gaus(gen) * errYZ;
+      params[2] = gaus(gen) * errSlp;
+      params[3] = (uni(gen) - 0.5) + gaus(gen) * errSlp;
+      params[4] = (i ? -1. : 1.) / pt;
+      covm[14] = errQPT * errQPT * params[4] * params[4];
+      cand[i] = o2::track::TrackParCov(x, phi, params, covm);
+      ok = ok && cand[i].propagateTo(cand[i].getX() + (uni(gen) - 0.5) * 10., Bz);
+    }
+    if (ok) {
+      tracks[0].push_back(cand[0]);
+      tracks[1].push_back(cand[1]);
+    }
+  }
+  return tracks;
+}
+
+const auto& getV0s()
+{
+  static auto tracks = generateV0s(NCandidates);
+  return tracks;
+}
+
+o2::vertexing::DCAFitter2 getFitter(bool absDCA)
+{
+  o2::vertexing::DCAFitter2 ft;
+  ft.setBz(Bz);
+  ft.setUseAbsDCA(absDCA);
+  ft.setPropagateToPCA(true);
+  return ft;
+}
+} // namespace
+
+static void BM_DCAFitter2Scalar(benchmark::State& state)
+{
+  const auto& tracks = getV0s();
+  auto ft = getFitter(state.range(0));
+  size_t nFound = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < NCandidates; i++) {
+      nFound += ft.process(tracks[0][i], tracks[1][i]);
+    }
+  }
+  benchmark::DoNotOptimize(nFound);
+  state.counters["candidates/s"] = benchmark::Counter(state.iterations() * NCandidates, benchmark::Counter::kIsRate);
+}
+
+template <int W>
+static void BM_DCAFitter2Batched(benchmark::State& state)
+{
+  const auto& tracks = getV0s();
+  const auto ft = getFitter(state.range(0));
+  std::vector<o2::vertexing::DCAFitter2> fitters(NCandidates, ft);
+  std::vector<int> results;
+  o2::vertexing::DCAFitterNBatch<o2::vertexing::DCAFitter2, W> batch;
+  for (auto _ : state) {
+    batch.process(fitters, results, tracks[0], tracks[1]);
+  }
+  benchmark::DoNotOptimize(results.data());
+  state.counters["candidates/s"] = benchmark::Counter(state.iterations() * NCandidates, benchmark::Counter::kIsRate);
+}
+
+// argument: use abs. DCA minimization
+BENCHMARK(BM_DCAFitter2Scalar)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batched, 4)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batched, 8)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batched, 16)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -15,6 +15,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitterNBatch.h"
 #include "CommonUtils/TreeStreamRedirector.h"
 #include <TRandom.h>
 #include <TGenPhaseSpace.h>
@@ -552,5 +553,101 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+template <int N>
+void compareBatched(const std::vector<std::vector<o2::track::TrackParCov>>& vctracks, o2::vertexing::DCAFitterN<N>& ft, const std::string& mode)
+{
+  // fit the same candidates with scalar and batched processing and compare the results
+  const int nTest = vctracks[0].size();
+  std::vector<o2::vertexing::DCAFitterN<N>> fitters(nTest, ft);
+  std::vector<int> results;
+  TStopwatch swS, swB;
+  swB.Start();
+  if constexpr (N == 2) {
+    processBatched(fitters, results, vctracks[0], vctracks[1]);
+  } else {
+    processBatched(fitters, results, vctracks[0], vctracks[1], vctracks[2]);
+  }
+  swB.Stop();
+  int nDiffCand = 0, nDiffPCA = 0, nFound = 0;
+  swS.Start();
+  for (int iev = 0; iev < nTest; iev++) {
+    int nc = 0;
+    if constexpr (N == 2) {
+      nc = ft.process(vctracks[0][iev], vctracks[1][iev]);
+    } else {
+      nc = ft.process(vctracks[0][iev], vctracks[1][iev], vctracks[2][iev]);
+    }
+    if (nc != results[iev]) {
+      nDiffCand++;
+      continue;
+    }
+    nFound += nc > 0;
+    for (int ic = 0; ic < nc; ic++) {
+      auto df = ft.getPCACandidate(ic);
+      df -= fitters[iev].getPCACandidate(ic);
+      if (std::sqrt(df[0] * df[0] + df[1] * df[1] + df[2] * df[2]) > 1e-3 ||
+          std::abs(ft.getChi2AtPCACandidate(ic) - fitters[iev].getChi2AtPCACandidate(ic)) > 1e-3 * (1. + ft.getChi2AtPCACandidate(ic))) {
+        nDiffPCA++;
+      }
+    }
+  }
+  swS.Stop();
+  LOG(info) << N << "-prongs " << mode << ": found " << nFound << " of " << nTest << ", different number of candidates in " << nDiffCand
+            << ", different PCA or chi2 in " << nDiffPCA << ", CPU time scalar: " << swS.CpuTime() * 1000 << " ms, batched: " << swB.CpuTime() * 1000 << " ms";
+  BOOST_CHECK(nFound > 0.99 * nTest);
+  BOOST_CHECK(nDiffCand <= 0.001 * nTest);
+  BOOST_CHECK(nDiffPCA <= 0.001 * nTest);
+}
+
+BOOST_AUTO_TEST_CASE(DCAFitterNBatched)
+{
+  constexpr int NTest = 10000;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  constexpr double kch = 0.49368;
+  constexpr double dch = 1.86965;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<double> dchdec = {pion, kch, pion};
+  std::vector<o2::track::TrackParCov> vc;
+  Vec3D vtxGen;
+  double bz = 5.0;
+
+  {
+    std::vector<std::vector<o2::track::TrackParCov>> vctracks(2);
+    for (int iev = 0; iev < NTest; iev++) {
+      generate(vtxGen, vc, bz, genPHS, k0, k0dec, {1, 1});
+      for (int i = 0; i < 2; i++) {
+        vctracks[i].push_back(vc[i]);
+      }
+    }
+    o2::vertexing::DCAFitterN<2> ft;
+    ft.setBz(bz);
+    ft.setUseAbsDCA(true);
+    compareBatched(vctracks, ft, "abs.dist");
+    ft.setWeightedFinalPCA(true);
+    compareBatched(vctracks, ft, "abs.dist but wghPCA");
+    ft.setUseAbsDCA(false);
+    ft.setWeightedFinalPCA(false);
+    compareBatched(vctracks, ft, "wgh.dist");
+  }
+
+  {
+    std::vector<std::vector<o2::track::TrackParCov>> vctracks(3);
+    for (int iev = 0; iev < NTest; iev++) {
+      generate(vtxGen, vc, bz, genPHS, dch, dchdec, {1, 1, 1});
+      for (int i = 0; i < 3; i++) {
+        vctracks[i].push_back(vc[i]);
+      }
+    }
+    o2::vertexing::DCAFitterN<3> ft;
+    ft.setBz(bz);
+    ft.setUseAbsDCA(true);
+    compareBatched(vctracks, ft, "abs.dist");
+    ft.setUseAbsDCA(false);
+    compareBatched(vctracks, ft, "wgh.dist");
+  }
+}
+
 } // namespace vertexing
 } // namespace o2
@@ -0,0 +1,139 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MagFieldGrid.h
+/// \brief Definition of the magnetic field lookup grid MagFieldGrid
+
+#ifndef ALICEO2_FIELD_MAGFIELDGRID_H_
+#define ALICEO2_FIELD_MAGFIELDGRID_H_
+
+#include "GPUCommonDef.h"
+#include "GPUCommonRtypes.h"
+#include "FlatObject.h"
+#include "MathUtils/Cartesian.h"
+
+namespace o2
+{
+namespace field
+{
+class MagneticField;
+
+/// Field map on a regular cartesian grid, the field between the nodes is obtained by trilinear interpolation.
+/// The grid is filled from the full (Chebyshev + machine field) parameterization of the MagneticField, the node
+/// spacing is halved until the deviation from the parameterization at the cell centres and at the edge midpoints
+/// of every cell is below the requested bound. The node values are kept in the flat buffer, hence the object can be
+/// stored, shared and copied to the GPU as the other FlatObject classes. Lookups outside of the grid return false,
+/// the caller should then fall back to the full parameterization.
+class MagFieldGrid : public o2::gpu::FlatObject
+{
+ public:
+  enum EDim { kX,
+              kY,
+              kZ,
+              kNDim };
+
+#ifndef GPUCA_GPUCODE
+  MagFieldGrid() CON_DEFAULT;
+  ~MagFieldGrid() CON_DEFAULT;
+  MagFieldGrid(const MagFieldGrid& src) { cloneFromObject(src, nullptr); }
+
+  /// fill the grid covering the box [min, max] from the parameterization of the field
+  /// \param field field to tabulate
+  /// \param min lower corner of the box (cm)
+  /// \param max upper corner of the box (cm)
+  /// \param maxError max. allowed deviation (kG) of any field component from the parameterization
+  /// \param step initial node spacing (cm), halved until maxError is reached
+  /// \param maxNodes max. number of nodes, the creation fails if more nodes are needed to reach maxError
+  /// \return returns false if the requested precision cannot be reached
+  bool create(const MagneticField& field, const float min[kNDim], const float max[kNDim], float maxError, float step = 20.f, size_t maxNodes = 20000000);
+
+  /// \return returns the max. deviation (kG) from the parameterization of the field at the cell centres and edge midpoints
+  float estimateMaxError(const MagneticField& field) const;
+
+  void print() const;
+
+  /// ========== FlatObject functionality, see FlatObject class for description  =================
+  void cloneFromObject(const MagFieldGrid& obj, char* newFlatBufferPtr);
+  void moveBufferTo(char* newBufferPtr);
+  using o2::gpu::FlatObject::adoptInternalBuffer;
+  using o2::gpu::FlatObject::releaseInternalBuffer;
+#endif
+  void destroy();
+  void setActualBufferAddress(char* actualFlatBufferPtr);
+  void setFutureBufferAddress(char* futureFlatBufferPtr);
+
+  GPUd() bool Field(const float xyz[3], float bxyz[3]) const { return interpolate(xyz[kX], xyz[kY], xyz[kZ], bxyz); }
+  GPUd() bool Field(const double xyz[3], double bxyz[3]) const { return interpolate(xyz[kX], xyz[kY], xyz[kZ], bxyz); }
+#ifndef GPUCA_GPUCODE_DEVICE
+  bool Field(const math_utils::Point3D<float> xyz, float bxyz[3]) const { return interpolate(xyz.X(), xyz.Y(), xyz.Z(), bxyz); }
+  bool Field(const math_utils::Point3D<double> xyz, double bxyz[3]) const { return interpolate(xyz.X(), xyz.Y(), xyz.Z(), bxyz); }
+#endif
+
+  GPUd() float getMin(int dim) const { return mMin[dim]; }
+  GPUd() float getMax(int dim) const { return mMin[dim] + (mNNodes[dim] - 1) * mStep[dim]; }
+  GPUd() float getStep(int dim) const { return mStep[dim]; }
+  GPUd() int getNNodes(int dim) const { return mNNodes[dim]; }
+  /// \return returns the max. deviation from the parameterization estimated when the grid was created
+  GPUd() float getMaxError() const { return mMaxError; }
+
+ private:
+  template <typename T>
+  GPUd() bool interpolate(T x, T y, T z, T* bxyz) const;
+
+#ifndef GPUCA_GPUCODE
+  /// book the buffer for the given grid and fill the nodes from the parameterization
+  void fill(const MagneticField& field, const float min[kNDim], const int nNodes[kNDim], const float step[kNDim]);
+#endif
+
+  float mMin[kNDim] = {};     ///< coordinates of the first node
+  float mStep[kNDim] = {};    ///< node spacing
+  float mInvStep[kNDim] = {}; ///< inverse node spacing
+  int mNNodes[kNDim] = {};    ///< number of nodes, at least 2 in each dimension
+  float mMaxError = 0.f;      ///< max. deviation from the parameterization found at the test points
+  float* mValues = nullptr;   //! Bx, By, Bz of the nodes, x running fastest (points to the flat buffer)
+
+  ClassDefNV(MagFieldGrid, 1);
+};
+
+template <typename T>
+GPUdi() bool MagFieldGrid::interpolate(T x, T y, T z, T* bxyz) const
+{
+  const float pos[kNDim] = {(float(x) - mMin[kX]) * mInvStep[kX], (float(y) - mMin[kY]) * mInvStep[kY], (float(z) - mMin[kZ]) * mInvStep[kZ]};
+  int idx[kNDim];
+  float frac[kNDim];
+  for (int i = 0; i < kNDim; i++) {
+    if (!(pos[i] >= 0.f && pos[i] <= float(mNNodes[i] - 1))) { // outside of the grid or not constructed
+      return false;
+    }
+    idx[i] = int(pos[i]);
+    if (idx[i] > mNNodes[i] - 2) {
+      idx[i] = mNNodes[i] - 2;
+    }
+    frac[i] = pos[i] - idx[i];
+  }
+  const int dy = kNDim * mNNodes[kX], dz = dy * mNNodes[kY];
+  const float* val = mValues + kNDim * idx[kX] + dy * idx[kY] + dz * idx[kZ];
+  for (int i = 0; i < kNDim; i++, val++) {
+    const float b00 = val[0] + frac[kX] * (val[kNDim] - val[0]);
+    const float b10 = val[dy] + frac[kX] * (val[dy + kNDim] - val[dy]);
+    const float b01 = val[dz] + frac[kX] * (val[dz + kNDim] - val[dz]);
+    const float b11 = val[dy + dz] + frac[kX] * (val[dy + dz + kNDim] - val[dy + dz]);
+    const float b0 = b00 + frac[kY] * (b10 - b00);
+    const float b1 = b01 + frac[kY] * (b11 - b01);
+    bxyz[i] = b0 + frac[kZ] * (b1 - b0);
+  }
+  return true;
+}
+
+} // namespace field
+} // namespace o2
+
+#endif
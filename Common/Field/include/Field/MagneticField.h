@@ -20,9 +20,11 @@
 #include "Field/MagFieldParam.h"
 #include "Field/MagneticWrapperChebyshev.h" // for MagneticWrapperChebyshev
 #include "Field/MagFieldFast.h"
+#include "Field/MagFieldGrid.h"
 #include "TSystem.h"
 #include "Rtypes.h" // for Double_t, Char_t, Int_t, Float_t, etc
 #include "TNamed.h" // for TNamed
+#include <array>
 #include <memory>   // for str::unique_ptr
 
 class FairParamList;
@@ -83,6 +85,12 @@ class MagneticField : public FairField
     return !(mMapType == MagFieldParam::k5kGUniform || mDipoleOnOffFlag == true);
   }
 
+  /// build the lookup grid of the field in the box [min, max] (cm) with a max. deviation maxError (kG) from the
+  /// parameterization, or drop it if maxError <= 0. The grid is kept if it was built with the same settings and field
+  /// scaling, otherwise it is rebuilt in place: a pointer obtained with getFieldGrid() stays valid unless it fails
+  bool createFieldGrid(const float min[3], const float max[3], float maxError);
+  const MagFieldGrid* getFieldGrid() const { return mFieldGrid.get(); }
+
   void rescaleField(float l3Cur, float diCur, bool uniform, int convention = 0);
 
   /// Virtual methods from FairField
@@ -114,6 +122,9 @@ class MagneticField : public FairField
   /// Main interface from TVirtualMagField used in simulation
   void Field(const Double_t* __restrict__ point, Double_t* __restrict__ bField) override;
 
+  /// field at point xyz from the measured map and the machine field, ignoring the fast parameterization
+  void parameterizedField(const Double_t* __restrict__ point, Double_t* __restrict__ bField) const;
+
   void field(const math_utils::Point3D<float> xyz, float bxyz[3])
   {
     double xyzd[3] = {xyz.X(), xyz.Y(), xyz.Z()}, bxyzd[3] = {0};
@@ -253,6 +264,8 @@ class MagneticField : public FairField
  private:
   std::unique_ptr<MagneticWrapperChebyshev> mMeasuredMap; //! Measured part of the field map
   std::unique_ptr<MagFieldFast> mFastField;               // ! optional fast parametrization
+  std::unique_ptr<MagFieldGrid> mFieldGrid;               //! optional lookup grid
+  std::array<float, 9> mFieldGridSettings{};              //! box, max. deviation and solenoid/dipole factors of the mFieldGrid
   MagFieldParam::BMap_t mMapType;                         ///< field map type
   Double_t mSolenoid;                                     ///< Solenoid field setting
   MagFieldParam::BeamType_t mBeamType;                    ///< Beam type: A-A (mBeamType=0) or p-p (mBeamType=1)
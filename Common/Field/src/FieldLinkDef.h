@@ -20,6 +20,7 @@
 #pragma link C++ class o2::field::MagFieldContFact + ;
 #pragma link C++ class o2::field::MagFieldFact + ;
 #pragma link C++ class o2::field::MagFieldFast + ;
+#pragma link C++ class o2::field::MagFieldGrid + ;
 #pragma link C++ class o2::field::ALICE3MagneticField + ;
 
 #endif
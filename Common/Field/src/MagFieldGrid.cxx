@@ -0,0 +1,166 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MagFieldGrid.cxx
+/// \brief Implementation of the magnetic field lookup grid MagFieldGrid
+
+#include "Field/MagFieldGrid.h"
+#include "Field/MagneticField.h"
+#include <fairlogger/Logger.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace o2::field;
+
+ClassImp(o2::field::MagFieldGrid);
+
+//_______________________________________________________________________
+bool MagFieldGrid::create(const MagneticField& field, const float min[kNDim], const float max[kNDim], float maxError, float step, size_t maxNodes)
+{
+  for (int i = 0; i < kNDim; i++) {
+    if (!(max[i] > min[i]) || !(step > 0.f)) {
+      LOGP(error, "Invalid field grid range [{}, {}] or step {} for dimension {}", min[i], max[i], step, i);
+      return false;
+    }
+  }
+  for (;; step *= 0.5f) {
+    int nNodes[kNDim];
+    float nodeStep[kNDim];
+    size_t nNodesTot = 1;
+    for (int i = 0; i < kNDim; i++) {
+      nNodes[i] = std::max(2, int(std::ceil((max[i] - min[i]) / step)) + 1);
+      nodeStep[i] = (max[i] - min[i]) / (nNodes[i] - 1);
+      nNodesTot *= nNodes[i];
+    }
+    if (nNodesTot > maxNodes) {
+      LOGP(error, "Field grid precision {} kG cannot be reached with at most {} nodes, step {} cm needs {} nodes", maxError, maxNodes, step, nNodesTot);
+      return false;
+    }
+    fill(field, min, nNodes, nodeStep);
+    mMaxError = estimateMaxError(field);
+    LOGP(info, "Field grid with step {} cm ({} nodes): max. deviation from the parameterization {} kG", step, nNodesTot, mMaxError);
+    if (mMaxError <= maxError) {
+      return true;
+    }
+  }
+}
+
+//_______________________________________________________________________
+void MagFieldGrid::fill(const MagneticField& field, const float min[kNDim], const int nNodes[kNDim], const float step[kNDim])
+{
+  FlatObject::startConstruction();
+  for (int i = 0; i < kNDim; i++) {
+    mMin[i] = min[i];
+    mStep[i] = step[i];
+    mInvStep[i] = 1.f / step[i];
+    mNNodes[i] = nNodes[i];
+  }
+  const size_t nValues = size_t(kNDim) * nNodes[kX] * nNodes[kY] * nNodes[kZ];
+  FlatObject::finishConstruction(nValues * sizeof(float));
+  mValues = reinterpret_cast<float*>(mFlatBufferPtr);
+
+  float* val = mValues;
+  double xyz[kNDim], b[kNDim];
+  for (int iz = 0; iz < nNodes[kZ]; iz++) {
+    xyz[kZ] = min[kZ] + iz * step[kZ];
+    for (int iy = 0; iy < nNodes[kY]; iy++) {
+      xyz[kY] = min[kY] + iy * step[kY];
+      for (int ix = 0; ix < nNodes[kX]; ix++) {
+        xyz[kX] = min[kX] + ix * step[kX];
+        field.parameterizedField(xyz, b);
+        for (int i = 0; i < kNDim; i++) {
+          *val++ = b[i];
+        }
+      }
+    }
+  }
+}
+
+//_______________________________________________________________________
+float MagFieldGrid::estimateMaxError(const MagneticField& field) const
+{
+  // the trilinear interpolation is exact at the nodes, test the cell centres and the midpoints of the cell edges
+  constexpr int NTestPoints = 4;
+  constexpr float Offsets[NTestPoints][kNDim] = {{0.5f, 0.5f, 0.5f}, {0.5f, 0.f, 0.f}, {0.f, 0.5f, 0.f}, {0.f, 0.f, 0.5f}};
+  float maxDiff = 0.f;
+  double xyz[kNDim], bRef[kNDim], b[kNDim];
+  for (int iz = 0; iz < mNNodes[kZ] - 1; iz++) {
+    for (int iy = 0; iy < mNNodes[kY] - 1; iy++) {
+      for (int ix = 0; ix < mNNodes[kX] - 1; ix++) {
+        for (int it = 0; it < NTestPoints; it++) {
+          xyz[kX] = mMin[kX] + (ix + Offsets[it][kX]) * mStep[kX];
+          xyz[kY] = mMin[kY] + (iy + Offsets[it][kY]) * mStep[kY];
+          xyz[kZ] = mMin[kZ] + (iz + Offsets[it][kZ]) * mStep[kZ];
+          field.parameterizedField(xyz, bRef);
+          Field(xyz, b);
+          for (int i = 0; i < kNDim; i++) {
+            maxDiff = std::max(maxDiff, float(std::abs(b[i] - bRef[i])));
+          }
+        }
+      }
+    }
+  }
+  return maxDiff;
+}
+
+//_______________________________________________________________________
+void MagFieldGrid::print() const
+{
+  LOGP(info, "Field grid X: [{}, {}] Y: [{}, {}] Z: [{}, {}] cm, {}x{}x{} nodes with step {}/{}/{} cm, {} MB, max. deviation {} kG",
+       getMin(kX), getMax(kX), getMin(kY), getMax(kY), getMin(kZ), getMax(kZ), mNNodes[kX], mNNodes[kY], mNNodes[kZ],
+       mStep[kX], mStep[kY], mStep[kZ], getFlatBufferSize() / (1024. * 1024.), mMaxError);
+}
+
+//_______________________________________________________________________
+void MagFieldGrid::cloneFromObject(const MagFieldGrid& obj, char* newFlatBufferPtr)
+{
+  const char* oldFlatBufferPtr = obj.mFlatBufferPtr;
+  FlatObject::cloneFromObject(obj, newFlatBufferPtr);
+  for (int i = 0; i < kNDim; i++) {
+    mMin[i] = obj.mMin[i];
+    mStep[i] = obj.mStep[i];
+    mInvStep[i] = obj.mInvStep[i];
+    mNNodes[i] = obj.mNNodes[i];
+  }
+  mMaxError = obj.mMaxError;
+  mValues = FlatObject::relocatePointer(oldFlatBufferPtr, mFlatBufferPtr, obj.mValues);
+}
+
+//_______________________________________________________________________
+void MagFieldGrid::moveBufferTo(char* newFlatBufferPtr)
+{
+  char* oldFlatBufferPtr = mFlatBufferPtr;
+  FlatObject::moveBufferTo(newFlatBufferPtr);
+  char* currFlatBufferPtr = mFlatBufferPtr;
+  mFlatBufferPtr = oldFlatBufferPtr;
+  setActualBufferAddress(currFlatBufferPtr);
+}
+
+//_______________________________________________________________________
+void MagFieldGrid::destroy()
+{
+  mValues = nullptr;
+  FlatObject::destroy();
+}
+
+//_______________________________________________________________________
+void MagFieldGrid::setActualBufferAddress(char* actualFlatBufferPtr)
+{
+  FlatObject::setActualBufferAddress(actualFlatBufferPtr);
+  mValues = reinterpret_cast<float*>(mFlatBufferPtr);
+}
+
+//_______________________________________________________________________
+void MagFieldGrid::setFutureBufferAddress(char* futureFlatBufferPtr)
+{
+  mValues = FlatObject::relocatePointer(mFlatBufferPtr, futureFlatBufferPtr, mValues);
+  FlatObject::setFutureBufferAddress(futureFlatBufferPtr);
+}
@@ -269,6 +269,14 @@ void MagneticField::Field(const Double_t* __restrict__ xyz, Double_t* __restrict
   if (mFastField && mFastField->Field(xyz, b)) {
     return;
   }
+  parameterizedField(xyz, b);
+}
+
+void MagneticField::parameterizedField(const Double_t* __restrict__ xyz, Double_t* __restrict__ b) const
+{
+  /*
+   * query field value at point from the measured map and the machine field, ignoring the fast parameterization
+   */
 
   if (mMeasuredMap && xyz[2] > mMeasuredMap->getMinZ() && xyz[2] < mMeasuredMap->getMaxZ()) {
     mMeasuredMap->Field(xyz, b);
@@ -329,6 +337,8 @@ MagneticField& MagneticField::operator=(const MagneticField& src)
     mDipoleOnOffFlag = src.mDipoleOnOffFlag;
     mParameterNames = src.mParameterNames;
     mFastField.reset(src.mFastField ? new MagFieldFast(*src.getFastField()) : nullptr);
+    mFieldGrid.reset(src.mFieldGrid ? new MagFieldGrid(*src.getFieldGrid()) : nullptr);
+    mFieldGridSettings = src.mFieldGridSettings;
   }
   return *this;
 }
@@ -716,6 +726,28 @@ void MagneticField::FillParContainer()
 }
 
 //_____________________________________________________________________________
+bool MagneticField::createFieldGrid(const float min[3], const float max[3], float maxError)
+{
+  if (maxError <= 0.f) {
+    mFieldGrid.reset();
+    return false;
+  }
+  const std::array<float, 9> settings = {min[0], min[1], min[2], max[0], max[1], max[2], maxError, float(getFactorSolenoid()), float(getFactorDipole())};
+  if (mFieldGrid && settings == mFieldGridSettings) {
+    return true;
+  }
+  if (!mFieldGrid) {
+    mFieldGrid = std::make_unique<MagFieldGrid>();
+  }
+  if (!mFieldGrid->create(*this, min, max, maxError)) {
+    mFieldGrid.reset();
+    return false;
+  }
+  mFieldGridSettings = settings;
+  mFieldGrid->print();
+  return true;
+}
+
 void MagneticField::AllowFastField(bool v)
 {
   if (v) {
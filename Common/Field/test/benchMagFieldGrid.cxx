@@ -0,0 +1,125 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  benchMagFieldGrid.cxx
+/// \brief benchmark of the field lookups per second of the parameterized, fast and grid fields, with the accuracy of the grid
+
+#include "benchmark/benchmark.h"
+#include "Field/MagneticField.h"
+#include "Field/MagFieldFast.h"
+#include "Field/MagFieldGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace o2::field;
+
+// barrel volume covered by the fast field and by the grid
+static constexpr float XYMax = 250.f;
+static constexpr float ZMax = 250.f;
+static constexpr int NPoints = 100000;
+
+static MagneticField& getField()
+{
+  static std::unique_ptr<MagneticField> field = []() {
+    auto fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., MagFieldParam::k5kG);
+    fld->AllowFastField(true);
+    return fld;
+  }();
+  return *field;
+}
+
+static const std::vector<double>& getPoints()
+{
+  static std::vector<double> points = []() {
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> xy(-XYMax, XYMax), z(-ZMax, ZMax);
+    std::vector<double> pts(3 * NPoints);
+    for (int i = 0; i < NPoints; i++) {
+      pts[3 * i] = xy(gen);
+      pts[3 * i + 1] = xy(gen);
+      pts[3 * i + 2] = z(gen);
+    }
+    return pts;
+  }();
+  return points;
+}
+
+static void benchParameterizedField(benchmark::State& state)
+{
+  const auto& field = getField();
+  const auto& points = getPoints();
+  double b[3];
+  for (auto _ : state) {
+    for (int i = 0; i < NPoints; i++) {
+      field.parameterizedField(&points[3 * i], b);
+      benchmark::DoNotOptimize(b);
+    }
+  }
+  state.counters["lookups"] = benchmark::Counter(NPoints, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void benchFastField(benchmark::State& state)
+{
+  const auto* fastField = getField().getFastField();
+  const auto& points = getPoints();
+  double b[3];
+  for (auto _ : state) {
+    for (int i = 0; i < NPoints; i++) {
+      benchmark::DoNotOptimize(fastField->Field(&points[3 * i], b));
+      benchmark::DoNotOptimize(b);
+    }
+  }
+  state.counters["lookups"] = benchmark::Counter(NPoints, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void benchGridField(benchmark::State& state)
+{
+  const float maxError = state.range(0) * 1.e-3f; // kG
+  const float min[3] = {-XYMax, -XYMax, -ZMax};
+  const float max[3] = {XYMax, XYMax, ZMax};
+  const auto& field = getField();
+  MagFieldGrid grid;
+  if (!grid.create(field, min, max, maxError)) {
+    state.SkipWithError("the requested precision cannot be reached");
+    return;
+  }
+  const auto& points = getPoints();
+  double b[3];
+  for (auto _ : state) {
+    for (int i = 0; i < NPoints; i++) {
+      benchmark::DoNotOptimize(grid.Field(&points[3 * i], b));
+      benchmark::DoNotOptimize(b);
+    }
+  }
+
+  // largest deviation from the parameterization at the random points
+  double bRef[3], maxDiff = 0.;
+  for (int i = 0; i < NPoints; i++) {
+    field.parameterizedField(&points[3 * i], bRef);
+    grid.Field(&points[3 * i], b);
+    for (int j = 0; j < 3; j++) {
+      maxDiff = std::max(maxDiff, std::abs(b[j] - bRef[j]));
+    }
+  }
+  state.counters["maxDiff"] = maxDiff;
+  state.counters["MB"] = grid.getFlatBufferSize() / (1024. * 1024.);
+  state.counters["lookups"] = benchmark::Counter(NPoints, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(benchParameterizedField)->Unit(benchmark::kMillisecond);
+BENCHMARK(benchFastField)->Unit(benchmark::kMillisecond);
+// max. deviation in units of 1e-3 kG
+BENCHMARK(benchGridField)->Arg(50)->Arg(20)->Arg(10)->Arg(5)->ArgNames({"maxError"})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -16,6 +16,9 @@
 #include <iostream>
 #include "Field/MagneticField.h"
 #include "Field/MagFieldFast.h"
+#include "Field/MagFieldGrid.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <fairlogger/Logger.h> // for FairLogger
 #include <TStopwatch.h>
@@ -98,3 +101,44 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagneticFieldGrid_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  const float maxError = 0.01; // kG
+  const float min[3] = {-250.f, -250.f, -300.f}, max[3] = {250.f, 250.f, 300.f};
+  BOOST_REQUIRE(fld->createFieldGrid(min, max, maxError));
+  const auto* grid = fld->getFieldGrid();
+  BOOST_REQUIRE(grid != nullptr);
+  BOOST_CHECK_LE(grid->getMaxError(), maxError);
+
+  // the grid is not rebuilt for the same settings
+  BOOST_CHECK(fld->createFieldGrid(min, max, maxError));
+  BOOST_CHECK_EQUAL(fld->getFieldGrid(), grid);
+
+  // compare to the parameterization at random points, the max. deviation is estimated at the test points of the cells only
+  const int ntst = 100000;
+  float rnd[3];
+  double xyz[3], bGrid[3], bParam[3], maxDiff = 0.;
+  for (int it = ntst; it--;) {
+    gRandom->RndmArray(3, rnd);
+    for (int i = 0; i < 3; i++) {
+      xyz[i] = min[i] + rnd[i] * (max[i] - min[i]);
+    }
+    BOOST_REQUIRE(grid->Field(xyz, bGrid));
+    fld->parameterizedField(xyz, bParam);
+    for (int i = 0; i < 3; i++) {
+      maxDiff = std::max(maxDiff, std::abs(bGrid[i] - bParam[i]));
+    }
+  }
+  LOG(info) << "Max. deviation of the field grid from the parameterization: " << maxDiff << " kG";
+  BOOST_CHECK_LT(maxDiff, 2 * maxError);
+
+  // outside of the grid the caller falls back to the parameterization
+  const double outside[3] = {0., 0., max[2] + 10.};
+  BOOST_CHECK(!grid->Field(outside, bGrid));
+
+  // no grid without a valid precision
+  BOOST_CHECK(!fld->createFieldGrid(min, max, 0.f));
+  BOOST_CHECK(fld->getFieldGrid() == nullptr);
+}
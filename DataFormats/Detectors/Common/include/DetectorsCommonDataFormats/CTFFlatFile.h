@@ -0,0 +1,131 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CTFFlatFile.h
+/// \brief Flat (non-ROOT) CTF file storing the EncodedBlocks images as they are, to be read via memory mapping
+
+#ifndef ALICEO2_CTF_FLATFILE_H
+#define ALICEO2_CTF_FLATFILE_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gsl/span>
+#include "DetectorsCommonDataFormats/DetID.h"
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+/// Layout of the file: CTFFlatFileHeader, then the flat EncodedBlocks images of every detector of every CTF,
+/// each starting at a multiple of CTFFlatFileAlignment, then the index of CTFFlatFileEntry records.
+/// Since the images are position-independent, a mapped image can be decoded without being copied.
+
+constexpr size_t CTFFlatFileAlignment = 64;
+
+struct CTFFlatFileHeader {
+  static constexpr std::array<char, 8> MagicWord{'O', '2', 'C', 'T', 'F', 'F', 'L', 'T'};
+  static constexpr uint32_t CurrentVersion = 1;
+
+  std::array<char, 8> magic = MagicWord;
+  uint32_t version = CurrentVersion;
+  uint32_t nEntries = 0;
+  uint64_t indexOffset = 0; // offset of the 1st CTFFlatFileEntry in bytes
+
+  bool isValid() const { return magic == MagicWord && version == CurrentVersion; }
+};
+
+struct CTFFlatFileEntry {
+  CTFHeader header;
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> offset{}; // offset of the image of each detector in bytes
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> size{};   // size of the image of each detector in bytes, 0 if absent
+};
+
+/// writer of the flat CTF file, the CTFs are added as: beginEntry, addDetector for every detector, endEntry
+class CTFFlatFileWriter
+{
+ public:
+  CTFFlatFileWriter() = default;
+  ~CTFFlatFileWriter() { close(); }
+
+  void open(const std::string& fileName);
+  void beginEntry(const CTFHeader& header);
+  void addDetector(o2::detectors::DetID det, gsl::span<const BufferType> image);
+  void endEntry();
+  void close();
+
+  bool isOpen() const { return mFile.is_open(); }
+  size_t getNEntries() const { return mIndex.size(); }
+
+ private:
+  void pad();
+
+  std::ofstream mFile;
+  std::string mFileName{};
+  std::vector<CTFFlatFileEntry> mIndex;
+  CTFFlatFileEntry mCurrent{};
+  uint64_t mOffset = 0;
+  bool mInEntry = false;
+};
+
+/// reader of the flat CTF file, the file is mapped to memory and the images are provided without copying
+class CTFFlatFileReader
+{
+ public:
+  CTFFlatFileReader() = default;
+  CTFFlatFileReader(const CTFFlatFileReader&) = delete;
+  CTFFlatFileReader& operator=(const CTFFlatFileReader&) = delete;
+  ~CTFFlatFileReader() { close(); }
+
+  /// check if the file starts with the flat CTF header
+  static bool isFlatFile(const std::string& fileName);
+
+  void open(const std::string& fileName);
+  void close();
+
+  bool isOpen() const { return mMapping != nullptr; }
+  const std::string& getFileName() const { return mFileName; }
+  size_t getNEntries() const { return mHeader.nEntries; }
+  const CTFHeader& getCTFHeader(size_t entry) const { return getEntry(entry).header; }
+
+  /// flat image of the detector CTF in the mapping, empty if the detector is absent
+  gsl::span<const BufferType> getDetectorData(size_t entry, o2::detectors::DetID det) const
+  {
+    const auto& ent = getEntry(entry);
+    return {mMapping + ent.offset[det], ent.size[det]};
+  }
+
+  /// detector CTF container pointing directly to the mapping, can be passed to the CTFCoder::decode
+  template <typename C>
+  auto getImage(size_t entry, o2::detectors::DetID det) const
+  {
+    return C::getImage(getDetectorData(entry, det).data());
+  }
+
+ private:
+  const CTFFlatFileEntry& getEntry(size_t entry) const;
+
+  std::string mFileName{};
+  CTFFlatFileHeader mHeader{};
+  const CTFFlatFileEntry* mIndex = nullptr;
+  const BufferType* mMapping = nullptr;
+  size_t mMappingSize = 0;
+};
+
+} // namespace ctf
+} // namespace o2
+
+#endif
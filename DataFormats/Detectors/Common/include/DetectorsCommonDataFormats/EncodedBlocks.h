@@ -503,6 +503,16 @@ class EncodedBlocks
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f);
 
+  /// encode vector src at provided slot of a standalone container created in the detached buffer, to be merged later with adoptDetached.
+  /// Only the headers of this container are accessed, hence the blocks of different slots can be encoded concurrently
+  template <typename input_IT, typename buffer_T>
+  o2::ctf::CTFIOSize encodeDetached(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T& detached, const std::any& encoderExt = {}, float memfc = 1.f) const;
+
+  /// copy the block at provided slot of the standalone container filled by encodeDetached to the same slot of the container in the buffer.
+  /// As for the encode, the slots must be filled in increasing order
+  template <typename buffer_T, typename detached_T>
+  static void adoptDetached(buffer_T& buffer, int slot, const detached_T& detached);
+
   /// decode block at provided slot to destination vector (will be resized as needed)
   template <class container_T, class container_IT = typename container_T::iterator>
   o2::ctf::CTFIOSize decode(container_T& dest, int slot, const std::any& decoderExt = {}) const;
@@ -1145,6 +1155,40 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
   }
 };
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename input_IT, typename buffer_T>
+o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encodeDetached(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt,
+                                                          buffer_T& detached, const std::any& encoderExt, float memfc) const
+{
+  // the detached container starts with the minimal size and is expanded on demand by the encode
+  detached.clear();
+  auto* dest = create(detached);
+  dest->mHeader = mHeader;
+  dest->mANSHeader = mANSHeader;
+  dest->mRegistry.nFilledBlocks = slot; // the preceding slots stay empty
+  return dest->encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, &detached, encoderExt, memfc);
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename buffer_T, typename detached_T>
+void EncodedBlocks<H, N, W>::adoptDetached(buffer_T& buffer, int slot, const detached_T& detached)
+{
+  const auto* src = get(detached.data());
+  const auto& srcBlock = src->mBlocks[slot];
+  auto* dest = get(buffer.data());
+  assert(slot == dest->mRegistry.nFilledBlocks);
+  dest->mRegistry.nFilledBlocks++;
+  if (!srcBlock.payload) { // NODATA or data described by the metadata only: the encode did not touch the block
+    dest->mMetadata[slot] = src->mMetadata[slot];
+    return;
+  }
+  auto [thisBlock, thisMetadata] = dest->expandStorage(slot, srcBlock.getNStored(), &buffer);
+  thisBlock->store(srcBlock.getNDict(), srcBlock.getNData(), srcBlock.getNLiterals(), srcBlock.getDict(), srcBlock.getData(), srcBlock.getLiterals());
+  *thisMetadata = src->mMetadata[slot];
+}
+
 template <typename H, int N, typename W>
 template <typename T>
 [[nodiscard]] auto EncodedBlocks<H, N, W>::expandStorage(size_t slot, size_t nElements, T* buffer) -> decltype(auto)
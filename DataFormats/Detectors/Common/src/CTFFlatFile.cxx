@@ -0,0 +1,176 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CTFFlatFile.cxx
+/// \brief Flat (non-ROOT) CTF file storing the EncodedBlocks images as they are, to be read via memory mapping
+
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
+#include "Framework/Logger.h"
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+static_assert(CTFFlatFileAlignment % Alignment == 0, "flat file alignment must be compatible with the EncodedBlocks one");
+
+///___________________________________________________________________________________
+void CTFFlatFileWriter::open(const std::string& fileName)
+{
+  close();
+  mFile.open(fileName, std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!mFile.is_open()) {
+    throw std::runtime_error(fmt::format("failed to open flat CTF file {} for writing", fileName));
+  }
+  mFileName = fileName;
+  mIndex.clear();
+  CTFFlatFileHeader header; // placeholder, rewritten at closing
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mOffset = sizeof(header);
+  pad();
+}
+
+///___________________________________________________________________________________
+void CTFFlatFileWriter::beginEntry(const CTFHeader& header)
+{
+  if (mInEntry) {
+    throw std::runtime_error(fmt::format("previous entry of flat CTF file {} was not closed", mFileName));
+  }
+  mCurrent = CTFFlatFileEntry{};
+  mCurrent.header = header;
+  mInEntry = true;
+}
+
+///___________________________________________________________________________________
+void CTFFlatFileWriter::addDetector(DetID det, gsl::span<const BufferType> image)
+{
+  if (!mInEntry) {
+    throw std::runtime_error(fmt::format("no entry was open in flat CTF file {}", mFileName));
+  }
+  mCurrent.offset[det] = mOffset;
+  mCurrent.size[det] = image.size();
+  mFile.write(reinterpret_cast<const char*>(image.data()), image.size());
+  mOffset += image.size();
+  pad();
+}
+
+///___________________________________________________________________________________
+void CTFFlatFileWriter::endEntry()
+{
+  if (!mInEntry) {
+    throw std::runtime_error(fmt::format("no entry was open in flat CTF file {}", mFileName));
+  }
+  mIndex.push_back(mCurrent);
+  mInEntry = false;
+}
+
+///___________________________________________________________________________________
+void CTFFlatFileWriter::close()
+{
+  if (!mFile.is_open()) {
+    return;
+  }
+  if (mInEntry) {
+    LOGP(warning, "discarding incomplete entry of flat CTF file {}", mFileName);
+    mInEntry = false;
+  }
+  CTFFlatFileHeader header;
+  header.nEntries = mIndex.size();
+  header.indexOffset = mOffset;
+  mFile.write(reinterpret_cast<const char*>(mIndex.data()), mIndex.size() * sizeof(CTFFlatFileEntry));
+  mFile.seekp(0);
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mFile.close();
+  if (mFile.fail()) {
+    throw std::runtime_error(fmt::format("failed to write flat CTF file {}", mFileName));
+  }
+  LOGP(info, "Wrote {} CTFs to flat file {}", mIndex.size(), mFileName);
+  mIndex.clear();
+}
+
+///___________________________________________________________________________________
+void CTFFlatFileWriter::pad()
+{
+  static const std::array<char, CTFFlatFileAlignment> zeros{};
+  auto res = mOffset % CTFFlatFileAlignment;
+  if (res) {
+    mFile.write(zeros.data(), CTFFlatFileAlignment - res);
+    mOffset += CTFFlatFileAlignment - res;
+  }
+}
+
+///___________________________________________________________________________________
+bool CTFFlatFileReader::isFlatFile(const std::string& fileName)
+{
+  CTFFlatFileHeader header;
+  std::ifstream inp(fileName, std::ios::binary);
+  return inp.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.isValid();
+}
+
+///___________________________________________________________________________________
+void CTFFlatFileReader::open(const std::string& fileName)
+{
+  close();
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(fmt::format("failed to open flat CTF file {}", fileName));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(CTFFlatFileHeader)) {
+    ::close(fd);
+    throw std::runtime_error(fmt::format("flat CTF file {} is too short", fileName));
+  }
+  void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping stays valid
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error(fmt::format("failed to map flat CTF file {}", fileName));
+  }
+  madvise(mapping, st.st_size, MADV_SEQUENTIAL); // CTFs are replayed in the order of writing
+  mMapping = reinterpret_cast<const BufferType*>(mapping);
+  mMappingSize = st.st_size;
+  mFileName = fileName;
+  mHeader = *reinterpret_cast<const CTFFlatFileHeader*>(mMapping);
+  if (!mHeader.isValid() || mHeader.indexOffset + mHeader.nEntries * sizeof(CTFFlatFileEntry) > mMappingSize) {
+    close();
+    throw std::runtime_error(fmt::format("{} is not a valid flat CTF file", fileName));
+  }
+  mIndex = reinterpret_cast<const CTFFlatFileEntry*>(mMapping + mHeader.indexOffset);
+}
+
+///___________________________________________________________________________________
+void CTFFlatFileReader::close()
+{
+  if (mMapping) {
+    munmap(const_cast<BufferType*>(mMapping), mMappingSize);
+  }
+  mMapping = nullptr;
+  mMappingSize = 0;
+  mIndex = nullptr;
+  mHeader = CTFFlatFileHeader{};
+}
+
+///___________________________________________________________________________________
+const CTFFlatFileEntry& CTFFlatFileReader::getEntry(size_t entry) const
+{
+  if (entry >= mHeader.nEntries) {
+    throw std::runtime_error(fmt::format("entry {} is out of range of flat CTF file {} with {} entries", entry, mFileName, mHeader.nEntries));
+  }
+  const auto& ent = mIndex[entry];
+  for (int id = DetID::First; id <= DetID::Last; id++) {
+    if (ent.offset[id] + ent.size[id] > mHeader.indexOffset) {
+      throw std::runtime_error(fmt::format("corrupted index of entry {} in flat CTF file {}", entry, mFileName));
+    }
+  }
+  return ent;
+}
@@ -0,0 +1,104 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   TrackParCovBatch.h
+/// @brief  Structure of arrays of TrackParametrizationWithError, with batched propagation, rotation and update kernels
+
+#ifndef INCLUDE_RECONSTRUCTIONDATAFORMATS_TRACKPARCOVBATCH_H_
+#define INCLUDE_RECONSTRUCTIONDATAFORMATS_TRACKPARCOVBATCH_H_
+
+#include "ReconstructionDataFormats/TrackParametrizationWithError.h"
+#include <gsl/span>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace o2
+{
+namespace track
+{
+
+/// Batch of tracks stored as a structure of arrays (one array per parameter and covariance element).
+/// The kernels process all valid tracks of the batch with SIMD instructions when std::experimental::simd is
+/// available (scalar loop over the TrackParametrizationWithError methods otherwise) and reproduce the results of the
+/// corresponding TrackParametrizationWithError methods applied to each track: bitwise if the latter are not contracted
+/// to FMA, within the rounding errors otherwise.
+/// A track for which the operation fails is left unchanged and flagged as invalid, the invalid tracks are
+/// ignored by the following operations until their status is reset.
+template <typename value_T = float>
+class TrackParCovBatch
+{
+ public:
+  using value_t = value_T;
+  using track_t = TrackParametrizationWithError<value_T>;
+
+  TrackParCovBatch() = default;
+  explicit TrackParCovBatch(gsl::span<const track_t> tracks) { load(tracks); }
+
+  /// replace the content of the batch by the tracks, all are flagged as valid
+  void load(gsl::span<const track_t> tracks);
+  /// copy the kinematics (X, alpha, parameters and covariance) of the tracks of the batch to the tracks
+  void store(gsl::span<track_t> tracks) const;
+
+  void clear();
+  void reserve(size_t n);
+  void push_back(const track_t& trk);
+  size_t size() const { return mX.size(); }
+
+  /// \return returns the i-th track
+  track_t getTrack(size_t i) const;
+  /// copy the kinematics of the i-th track to trk, leaving the other data members of trk untouched
+  void getTrack(size_t i, track_t& trk) const;
+  /// set the kinematics of the i-th track from trk
+  void setTrack(size_t i, const track_t& trk);
+
+  bool isValid(size_t i) const { return mValid[i]; }
+  void setValid(size_t i, bool v) { mValid[i] = v; }
+  void resetValid() { mValid.assign(mValid.size(), 1); }
+  size_t getNValid() const;
+
+  value_t getX(size_t i) const { return mX[i]; }
+  void setX(size_t i, value_t x) { mX[i] = x; }
+  value_t getAlpha(size_t i) const { return mAlpha[i]; }
+  value_t getParam(size_t i, int ip) const { return mP[ip][i]; }
+  value_t getCovarElem(size_t i, int ic) const { return mC[ic][i]; }
+  const value_t* getParams(int ip) const { return mP[ip].data(); }
+  const value_t* getCov(int ic) const { return mC[ic].data(); }
+
+  /// propagate the valid tracks to the plane X=xk (cm) in the field b (kG), as TrackParametrizationWithError::propagateTo
+  /// \return returns the number of tracks which are still valid
+  size_t propagateTo(value_t xk, value_t b);
+  /// propagate the i-th valid track to the plane X=xk[i] (cm) in the field b (kG)
+  size_t propagateTo(const value_t* xk, value_t b);
+
+  /// rotate the valid tracks to the frame alpha, as TrackParametrizationWithError::rotate
+  size_t rotate(value_t alpha);
+  /// rotate the i-th valid track to the frame alpha[i]
+  size_t rotate(const value_t* alpha);
+
+  /// update the i-th valid track with the space point (y[i], z[i]) having the covariance (sy2[i], syz[i], sz2[i]),
+  /// as TrackParametrizationWithError::update
+  size_t update(const value_t* y, const value_t* z, const value_t* sy2, const value_t* syz, const value_t* sz2);
+
+ private:
+  std::vector<value_t> mX;                          ///< X of the tracks
+  std::vector<value_t> mAlpha;                      ///< alpha of the tracks
+  std::array<std::vector<value_t>, kNParams> mP;    ///< parameters of the tracks
+  std::array<std::vector<value_t>, kCovMatSize> mC; ///< covariance matrix elements of the tracks
+  std::vector<char> mAbsCharge;                     ///< abs. charges of the tracks
+  std::vector<PID> mPID;                            ///< PID of the tracks
+  std::vector<uint8_t> mValid;                      ///< validity flags of the tracks
+};
+
+} // namespace track
+} // namespace o2
+
+#endif
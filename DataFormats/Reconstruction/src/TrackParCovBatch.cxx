@@ -0,0 +1,575 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   TrackParCovBatch.cxx
+/// @brief  Batched propagation, rotation and update kernels for TrackParCovBatch
+
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
+#include "CommonConstants/MathConstants.h"
+#include "MathUtils/Utils.h"
+#include <algorithm>
+
+#if __has_include(<experimental/simd>) && !defined(O2_TRACKBATCH_NO_SIMD)
+#define O2_TRACKBATCH_SIMD
+#include <experimental/simd>
+#endif
+
+using namespace o2::track;
+
+#ifdef O2_TRACKBATCH_SIMD
+namespace
+{
+namespace stdx = std::experimental;
+
+// The kernels below repeat the arithmetics of the TrackParametrizationWithError methods operation by operation,
+// including the float <-> double conversions, so that every lane gives bitwise the same result as the scalar code.
+// The transcendental functions are evaluated lane by lane with the same functions as the scalar code.
+template <typename value_T>
+struct SimdTypes {
+  static constexpr int N = stdx::native_simd<value_T>::size();
+  using V = stdx::fixed_size_simd<value_T, N>; // lanes in the track precision
+  using D = stdx::fixed_size_simd<double, N>;  // lanes in double precision, for the intermediates evaluated in double
+  using M = typename V::mask_type;
+};
+
+template <typename V>
+V loadLanes(const std::vector<typename V::value_type>& vec, size_t i)
+{
+  return V(vec.data() + i, stdx::element_aligned);
+}
+
+template <typename V>
+void storeLanes(std::vector<typename V::value_type>& vec, size_t i, const V& val, const typename V::mask_type& mask)
+{
+  V res(vec.data() + i, stdx::element_aligned);
+  where(mask, res) = val;
+  res.copy_to(vec.data() + i, stdx::element_aligned);
+}
+
+template <typename D, typename V>
+D toD(const V& v)
+{
+  return stdx::static_simd_cast<D>(v);
+}
+
+template <typename V, typename D>
+V toV(const D& d)
+{
+  return stdx::static_simd_cast<V>(d);
+}
+
+template <typename V, typename DM>
+typename V::mask_type toMask(const DM& dmask)
+{
+  typename V::mask_type mask;
+  for (size_t j = 0; j < V::size(); j++) {
+    mask[j] = dmask[j];
+  }
+  return mask;
+}
+
+/// as TrackParametrizationWithError::checkCovariance
+template <typename V>
+void checkCovariance(std::array<V, kCovMatSize>& c)
+{
+  using value_t = typename V::value_type;
+  auto limit = [&c](int diag, value_t cmax, std::array<int, 4> offDiag) {
+    c[diag] = stdx::abs(c[diag]);
+    auto mask = c[diag] > V(cmax);
+    if (stdx::any_of(mask)) {
+      V scl = stdx::sqrt(V(cmax) / c[diag]);
+      where(mask, c[diag]) = V(cmax);
+      for (auto od : offDiag) {
+        where(mask, c[od]) *= scl;
+      }
+    }
+  };
+  limit(kSigY2, kCY2max, {kSigZY, kSigSnpY, kSigTglY, kSigQ2PtY});
+  limit(kSigZ2, kCZ2max, {kSigZY, kSigSnpZ, kSigTglZ, kSigQ2PtZ});
+  limit(kSigSnp2, kCSnp2max, {kSigSnpY, kSigSnpZ, kSigTglSnp, kSigQ2PtSnp});
+  limit(kSigTgl2, kCTgl2max, {kSigTglY, kSigTglZ, kSigTglSnp, kSigQ2PtTgl});
+  limit(kSigQ2Pt2, kC1Pt2max, {kSigQ2PtY, kSigQ2PtZ, kSigQ2PtSnp, kSigQ2PtTgl});
+}
+
+/// as TrackParametrization::updateParams, adding 0 to the unchanged parameters as the scalar code does
+template <typename V>
+void updateParams(std::array<V, kNParams>& p, const std::array<V, kNParams>& delta)
+{
+  using value_t = typename V::value_type;
+  for (int i = kNParams; i--;) {
+    p[i] += delta[i];
+  }
+  where(p[kSnp] > V(value_t(o2::constants::math::Almost1)), p[kSnp]) = V(value_t(o2::constants::math::Almost1));
+  where(p[kSnp] < V(-value_t(o2::constants::math::Almost1)), p[kSnp]) = V(-value_t(o2::constants::math::Almost1));
+}
+
+} // namespace
+#endif
+
+//______________________________________________________________
+template <typename value_T>
+void TrackParCovBatch<value_T>::clear()
+{
+  mX.clear();
+  mAlpha.clear();
+  for (auto& p : mP) {
+    p.clear();
+  }
+  for (auto& c : mC) {
+    c.clear();
+  }
+  mAbsCharge.clear();
+  mPID.clear();
+  mValid.clear();
+}
+
+//______________________________________________________________
+template <typename value_T>
+void TrackParCovBatch<value_T>::reserve(size_t n)
+{
+  mX.reserve(n);
+  mAlpha.reserve(n);
+  for (auto& p : mP) {
+    p.reserve(n);
+  }
+  for (auto& c : mC) {
+    c.reserve(n);
+  }
+  mAbsCharge.reserve(n);
+  mPID.reserve(n);
+  mValid.reserve(n);
+}
+
+//______________________________________________________________
+template <typename value_T>
+void TrackParCovBatch<value_T>::push_back(const track_t& trk)
+{
+  mX.push_back(trk.getX());
+  mAlpha.push_back(trk.getAlpha());
+  for (int ip = 0; ip < kNParams; ip++) {
+    mP[ip].push_back(trk.getParam(ip));
+  }
+  for (int ic = 0; ic < kCovMatSize; ic++) {
+    mC[ic].push_back(trk.getCov()[ic]);
+  }
+  mAbsCharge.push_back(trk.getAbsCharge());
+  mPID.push_back(trk.getPID());
+  mValid.push_back(1);
+}
+
+//______________________________________________________________
+template <typename value_T>
+void TrackParCovBatch<value_T>::load(gsl::span<const track_t> tracks)
+{
+  clear();
+  reserve(tracks.size());
+  for (const auto& trk : tracks) {
+    push_back(trk);
+  }
+}
+
+//______________________________________________________________
+template <typename value_T>
+void TrackParCovBatch<value_T>::store(gsl::span<track_t> tracks) const
+{
+  for (size_t i = 0; i < tracks.size() && i < size(); i++) {
+    getTrack(i, tracks[i]);
+  }
+}
+
+//______________________________________________________________
+template <typename value_T>
+auto TrackParCovBatch<value_T>::getTrack(size_t i) const -> track_t
+{
+  track_t trk;
+  trk.setPID(mPID[i]);
+  trk.setAbsCharge(mAbsCharge[i]);
+  getTrack(i, trk);
+  return trk;
+}
+
+//______________________________________________________________
+template <typename value_T>
+void TrackParCovBatch<value_T>::getTrack(size_t i, track_t& trk) const
+{
+  trk.setX(mX[i]);
+  trk.setAlpha(mAlpha[i]);
+  for (int ip = 0; ip < kNParams; ip++) {
+    trk.setParam(mP[ip][i], ip);
+  }
+  for (int ic = 0; ic < kCovMatSize; ic++) {
+    trk.setCov(mC[ic][i], ic);
+  }
+}
+
+//______________________________________________________________
+template <typename value_T>
+void TrackParCovBatch<value_T>::setTrack(size_t i, const track_t& trk)
+{
+  mX[i] = trk.getX();
+  mAlpha[i] = trk.getAlpha();
+  for (int ip = 0; ip < kNParams; ip++) {
+    mP[ip][i] = trk.getParam(ip);
+  }
+  for (int ic = 0; ic < kCovMatSize; ic++) {
+    mC[ic][i] = trk.getCov()[ic];
+  }
+}
+
+//______________________________________________________________
+template <typename value_T>
+size_t TrackParCovBatch<value_T>::getNValid() const
+{
+  return std::count(mValid.begin(), mValid.end(), 1);
+}
+
+//______________________________________________________________
+template <typename value_T>
+size_t TrackParCovBatch<value_T>::propagateTo(value_t xk, value_t b)
+{
+  std::vector<value_t> xks(size(), xk);
+  return propagateTo(xks.data(), b);
+}
+
+//______________________________________________________________
+template <typename value_T>
+size_t TrackParCovBatch<value_T>::propagateTo(const value_t* xk, value_t b)
+{
+  size_t i = 0;
+#ifdef O2_TRACKBATCH_SIMD
+  using S = SimdTypes<value_t>;
+  using V = typename S::V;
+  using D = typename S::D;
+  using M = typename S::M;
+  namespace cm = o2::constants::math;
+  const V zero(0), one(1), almost0(value_t(cm::Almost0)), almost1(value_t(cm::Almost1));
+  for (; i + S::N <= size(); i += S::N) {
+    const M valid = V([this, i](auto j) { return value_t(mValid[i + j]); }) != zero;
+    const V absCharge([this, i](auto j) { return value_t(mAbsCharge[i + j]); });
+    const V xNew(xk + i, stdx::element_aligned);
+    const V dx = xNew - loadLanes<V>(mX, i);
+    const M active = valid && stdx::abs(dx) >= almost0;
+    if (stdx::none_of(active)) {
+      continue;
+    }
+    std::array<V, kNParams> p;
+    for (int ip = 0; ip < kNParams; ip++) {
+      p[ip] = loadLanes<V>(mP[ip], i);
+    }
+    V crv = p[kQ2Pt] * V(b) * V(value_t(cm::B2C));
+    where(absCharge == zero, crv) = zero;
+    const V x2r = crv * dx;
+    const V f1 = p[kSnp], f2 = f1 + x2r;
+    M fail = stdx::abs(f1) > almost1 || stdx::abs(f2) > almost1;
+    const V r1 = stdx::sqrt((one - f1) * (one + f1));
+    fail = fail || stdx::abs(r1) < almost0;
+    const V r2 = stdx::sqrt((one - f2) * (one + f2));
+    fail = fail || stdx::abs(r2) < almost0;
+    const D dy2dx = toD<D>((f1 + f2) / (r1 + r2));
+    const M arcz = stdx::abs(x2r) > V(value_t(0.05f));
+    std::array<V, kNParams> dP{zero, zero, zero, zero, zero};
+    dP[kZ] = toV<V>(toD<D>(dx) * (toD<D>(r2) + toD<D>(f2) * dy2dx) * toD<D>(p[kTgl]));
+    if (stdx::any_of(arcz)) {
+      const V arg = r1 * f2 - r2 * f1;
+      fail = fail || (arcz && stdx::abs(arg) > almost1);
+      V rot = zero;
+      for (int j = 0; j < S::N; j++) {
+        if (arcz[j] && active[j] && !fail[j]) {
+          rot[j] = o2::gpu::CAMath::ASin(value_t(arg[j]));
+        }
+      }
+      const M largeRot = f1 * f1 + f2 * f2 > one && f1 * f2 < zero;
+      where(largeRot && f2 > zero, rot) = V(value_t(cm::PI)) - rot;
+      where(largeRot && !(f2 > zero), rot) = V(-value_t(cm::PI)) - rot;
+      where(arcz, dP[kZ]) = p[kTgl] / crv * rot;
+    }
+    const M ok = active && !fail;
+    dP[kY] = toV<V>(toD<D>(dx) * dy2dx);
+    dP[kSnp] = x2r;
+    updateParams(p, dP);
+
+    std::array<V, kCovMatSize> c;
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      c[ic] = loadLanes<V>(mC[ic], i);
+    }
+    // evaluate matrix in double prec.
+    const D rinv = D(1.) / toD<D>(r1);
+    const D r3inv = rinv * rinv * rinv;
+    const D f24 = toD<D>(dx * V(b) * V(value_t(cm::B2C)));
+    const D f02 = toD<D>(dx) * r3inv;
+    const D f04 = D(0.5) * f24 * f02;
+    const D f12 = f02 * toD<D>(p[kTgl]) * toD<D>(f1);
+    const D f14 = D(0.5) * f24 * f12;
+    const D f13 = toD<D>(dx) * rinv;
+    const D c20 = toD<D>(c[kSigSnpY]), c21 = toD<D>(c[kSigSnpZ]), c22 = toD<D>(c[kSigSnp2]), c30 = toD<D>(c[kSigTglY]), c31 = toD<D>(c[kSigTglZ]),
+            c32 = toD<D>(c[kSigTglSnp]), c33 = toD<D>(c[kSigTgl2]), c40 = toD<D>(c[kSigQ2PtY]), c41 = toD<D>(c[kSigQ2PtZ]),
+            c42 = toD<D>(c[kSigQ2PtSnp]), c43 = toD<D>(c[kSigQ2PtTgl]), c44 = toD<D>(c[kSigQ2Pt2]);
+
+    // b = C*ft
+    const D b00 = f02 * c20 + f04 * c40, b01 = f12 * c20 + f14 * c40 + f13 * c30;
+    const D b02 = f24 * c40;
+    const D b10 = f02 * c21 + f04 * c41, b11 = f12 * c21 + f14 * c41 + f13 * c31;
+    const D b12 = f24 * c41;
+    const D b20 = f02 * c22 + f04 * c42, b21 = f12 * c22 + f14 * c42 + f13 * c32;
+    const D b22 = f24 * c42;
+    const D b40 = f02 * c42 + f04 * c44, b41 = f12 * c42 + f14 * c44 + f13 * c43;
+    const D b42 = f24 * c44;
+    const D b30 = f02 * c32 + f04 * c43, b31 = f12 * c32 + f14 * c43 + f13 * c33;
+    const D b32 = f24 * c43;
+
+    // a = f*b = f*C*ft
+    const D a00 = f02 * b20 + f04 * b40, a01 = f02 * b21 + f04 * b41, a02 = f02 * b22 + f04 * b42;
+    const D a11 = f12 * b21 + f14 * b41 + f13 * b31, a12 = f12 * b22 + f14 * b42 + f13 * b32;
+    const D a22 = f24 * b42;
+
+    // F*C*Ft = C + (b + bt + a)
+    auto add = [&c](int ic, const D& delta) { c[ic] = toV<V>(toD<D>(c[ic]) + delta); };
+    add(kSigY2, b00 + b00 + a00);
+    add(kSigZY, b10 + b01 + a01);
+    add(kSigSnpY, b20 + b02 + a02);
+    add(kSigTglY, b30);
+    add(kSigQ2PtY, b40);
+    add(kSigZ2, b11 + b11 + a11);
+    add(kSigSnpZ, b21 + b12 + a12);
+    add(kSigTglZ, b31);
+    add(kSigQ2PtZ, b41);
+    add(kSigSnp2, b22 + b22 + a22);
+    add(kSigTglSnp, b32);
+    add(kSigQ2PtSnp, b42);
+    checkCovariance(c);
+
+    storeLanes(mX, i, xNew, ok);
+    for (int ip = 0; ip < kNParams; ip++) {
+      storeLanes(mP[ip], i, p[ip], ok);
+    }
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      storeLanes(mC[ic], i, c[ic], ok);
+    }
+    for (int j = 0; j < S::N; j++) {
+      if (active[j] && fail[j]) {
+        mValid[i + j] = 0;
+      }
+    }
+  }
+#endif
+  for (; i < size(); i++) { // scalar fallback and tail
+    if (mValid[i]) {
+      auto trk = getTrack(i);
+      if (trk.propagateTo(xk[i], b)) {
+        setTrack(i, trk);
+      } else {
+        mValid[i] = 0;
+      }
+    }
+  }
+  return getNValid();
+}
+
+//______________________________________________________________
+template <typename value_T>
+size_t TrackParCovBatch<value_T>::rotate(value_t alpha)
+{
+  std::vector<value_t> alphas(size(), alpha);
+  return rotate(alphas.data());
+}
+
+//______________________________________________________________
+template <typename value_T>
+size_t TrackParCovBatch<value_T>::rotate(const value_t* alpha)
+{
+  size_t i = 0;
+#ifdef O2_TRACKBATCH_SIMD
+  using S = SimdTypes<value_t>;
+  using V = typename S::V;
+  using M = typename S::M;
+  namespace cm = o2::constants::math;
+  const V zero(0), one(1), almost0(value_t(cm::Almost0)), almost1(value_t(cm::Almost1));
+  for (; i + S::N <= size(); i += S::N) {
+    const M valid = V([this, i](auto j) { return value_t(mValid[i + j]); }) != zero;
+    if (stdx::none_of(valid)) {
+      continue;
+    }
+    const V snp = loadLanes<V>(mP[kSnp], i);
+    M fail = stdx::abs(snp) > almost1;
+    const V alphaOld = loadLanes<V>(mAlpha, i);
+    V alphaNew, sa, ca;
+    for (int j = 0; j < S::N; j++) {
+      value_t a = alpha[i + j], s = 0, c = 0;
+      o2::math_utils::detail::bringToPMPi<value_t>(a);
+      o2::math_utils::detail::sincos(value_t(a - alphaOld[j]), s, c);
+      alphaNew[j] = a;
+      sa[j] = s;
+      ca[j] = c;
+    }
+    V csp = stdx::sqrt((one - snp) * (one + snp));
+    fail = fail || (csp * ca + snp * sa) < zero;
+    const V updSnp = snp * ca - csp * sa;
+    fail = fail || stdx::abs(updSnp) > almost1;
+    const V xold = loadLanes<V>(mX, i), yold = loadLanes<V>(mP[kY], i);
+    const V xNew = xold * ca + yold * sa;
+    const V yNew = -xold * sa + yold * ca;
+    where(stdx::abs(csp) < almost0, csp) = almost0;
+    const V rr = ca + snp / csp * sa;
+
+    std::array<V, kCovMatSize> c;
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      c[ic] = loadLanes<V>(mC[ic], i);
+    }
+    c[kSigY2] *= (ca * ca);
+    c[kSigZY] *= ca;
+    c[kSigSnpY] *= ca * rr;
+    c[kSigSnpZ] *= rr;
+    c[kSigSnp2] *= rr * rr;
+    c[kSigTglY] *= ca;
+    c[kSigTglSnp] *= rr;
+    c[kSigQ2PtY] *= ca;
+    c[kSigQ2PtSnp] *= rr;
+    checkCovariance(c);
+
+    const M ok = valid && !fail;
+    storeLanes(mAlpha, i, alphaNew, ok);
+    storeLanes(mX, i, xNew, ok);
+    storeLanes(mP[kY], i, yNew, ok);
+    storeLanes(mP[kSnp], i, updSnp, ok);
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      storeLanes(mC[ic], i, c[ic], ok);
+    }
+    for (int j = 0; j < S::N; j++) {
+      if (valid[j] && fail[j]) {
+        mValid[i + j] = 0;
+      }
+    }
+  }
+#endif
+  for (; i < size(); i++) { // scalar fallback and tail
+    if (mValid[i]) {
+      auto trk = getTrack(i);
+      if (trk.rotate(alpha[i])) {
+        setTrack(i, trk);
+      } else {
+        mValid[i] = 0;
+      }
+    }
+  }
+  return getNValid();
+}
+
+//______________________________________________________________
+template <typename value_T>
+size_t TrackParCovBatch<value_T>::update(const value_t* y, const value_t* z, const value_t* sy2, const value_t* syz, const value_t* sz2)
+{
+  size_t i = 0;
+#ifdef O2_TRACKBATCH_SIMD
+  using S = SimdTypes<value_t>;
+  using V = typename S::V;
+  using D = typename S::D;
+  using M = typename S::M;
+  namespace cm = o2::constants::math;
+  const V zero(0), almost1(value_t(cm::Almost1));
+  for (; i + S::N <= size(); i += S::N) {
+    const M valid = V([this, i](auto j) { return value_t(mValid[i + j]); }) != zero;
+    if (stdx::none_of(valid)) {
+      continue;
+    }
+    std::array<V, kCovMatSize> c;
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      c[ic] = loadLanes<V>(mC[ic], i);
+    }
+    const D cm00 = toD<D>(c[kSigY2]), cm10 = toD<D>(c[kSigZY]), cm11 = toD<D>(c[kSigZ2]), cm20 = toD<D>(c[kSigSnpY]), cm21 = toD<D>(c[kSigSnpZ]),
+            cm30 = toD<D>(c[kSigTglY]), cm31 = toD<D>(c[kSigTglZ]), cm40 = toD<D>(c[kSigQ2PtY]), cm41 = toD<D>(c[kSigQ2PtZ]);
+
+    D r00 = toD<D>(V(sy2 + i, stdx::element_aligned)) + cm00;
+    D r01 = toD<D>(V(syz + i, stdx::element_aligned)) + cm10;
+    D r11 = toD<D>(V(sz2 + i, stdx::element_aligned)) + cm11;
+    const D det = r00 * r11 - r01 * r01;
+    M fail = toMask<V>(stdx::abs(det) < D(double(cm::Almost0)));
+    const D detI = D(1.) / det;
+    const D tmp = r00;
+    r00 = r11 * detI;
+    r11 = tmp * detI;
+    r01 = -r01 * detI;
+
+    const D k00 = cm00 * r00 + cm10 * r01, k01 = cm00 * r01 + cm10 * r11;
+    const D k10 = cm10 * r00 + cm11 * r01, k11 = cm10 * r01 + cm11 * r11;
+    const D k20 = cm20 * r00 + cm21 * r01, k21 = cm20 * r01 + cm21 * r11;
+    const D k30 = cm30 * r00 + cm31 * r01, k31 = cm30 * r01 + cm31 * r11;
+    const D k40 = cm40 * r00 + cm41 * r01, k41 = cm40 * r01 + cm41 * r11;
+
+    std::array<V, kNParams> p;
+    for (int ip = 0; ip < kNParams; ip++) {
+      p[ip] = loadLanes<V>(mP[ip], i);
+    }
+    const D dy = toD<D>(V(y + i, stdx::element_aligned) - p[kY]), dz = toD<D>(V(z + i, stdx::element_aligned) - p[kZ]);
+    const V dsnp = toV<V>(k20 * dy + k21 * dz);
+    fail = fail || stdx::abs(p[kSnp] + dsnp) > almost1;
+
+    const std::array<V, kNParams> dP{toV<V>(k00 * dy + k01 * dz), toV<V>(k10 * dy + k11 * dz), dsnp, toV<V>(k30 * dy + k31 * dz),
+                                     toV<V>(k40 * dy + k41 * dz)};
+    updateParams(p, dP);
+
+    const D c01 = cm10, c02 = cm20, c03 = cm30, c04 = cm40;
+    const D c12 = cm21, c13 = cm31, c14 = cm41;
+    auto sub = [&c](int ic, const D& delta) { c[ic] = toV<V>(toD<D>(c[ic]) - delta); };
+
+    sub(kSigY2, k00 * cm00 + k01 * cm10);
+    sub(kSigZY, k00 * c01 + k01 * cm11);
+    sub(kSigSnpY, k00 * c02 + k01 * c12);
+    sub(kSigTglY, k00 * c03 + k01 * c13);
+    sub(kSigQ2PtY, k00 * c04 + k01 * c14);
+
+    sub(kSigZ2, k10 * c01 + k11 * cm11);
+    sub(kSigSnpZ, k10 * c02 + k11 * c12);
+    sub(kSigTglZ, k10 * c03 + k11 * c13);
+    sub(kSigQ2PtZ, k10 * c04 + k11 * c14);
+
+    sub(kSigSnp2, k20 * c02 + k21 * c12);
+    sub(kSigTglSnp, k20 * c03 + k21 * c13);
+    sub(kSigQ2PtSnp, k20 * c04 + k21 * c14);
+
+    sub(kSigTgl2, k30 * c03 + k31 * c13);
+    sub(kSigQ2PtTgl, k30 * c04 + k31 * c14);
+
+    sub(kSigQ2Pt2, k40 * c04 + k41 * c14);
+    checkCovariance(c);
+
+    const M ok = valid && !fail;
+    for (int ip = 0; ip < kNParams; ip++) {
+      storeLanes(mP[ip], i, p[ip], ok);
+    }
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      storeLanes(mC[ic], i, c[ic], ok);
+    }
+    for (int j = 0; j < S::N; j++) {
+      if (valid[j] && fail[j]) {
+        mValid[i + j] = 0;
+      }
+    }
+  }
+#endif
+  for (; i < size(); i++) { // scalar fallback and tail
+    if (mValid[i]) {
+      auto trk = getTrack(i);
+      const value_t p[2] = {y[i], z[i]}, cov[3] = {sy2[i], syz[i], sz2[i]};
+      if (trk.update(p, cov)) {
+        setTrack(i, trk);
+      } else {
+        mValid[i] = 0;
+      }
+    }
+  }
+  return getNValid();
+}
+
+namespace o2::track
+{
+template class TrackParCovBatch<float>;
+template class TrackParCovBatch<double>;
+} // namespace o2::track
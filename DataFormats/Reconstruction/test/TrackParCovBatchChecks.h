@@ -0,0 +1,96 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TrackParCovBatchChecks.h
+/// \brief comparison of a TrackParCovBatch with the tracks processed one by one
+
+#ifndef O2_TRACKPARCOVBATCHCHECKS_H
+#define O2_TRACKPARCOVBATCHCHECKS_H
+
+#include <boost/test/unit_test.hpp>
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace o2::track::test
+{
+
+template <typename T>
+bool sameBits(T a, T b)
+{
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+#ifdef __FMA__
+// tolerance on the kinematics when the scalar methods, compiled with the default flags, are contracted to FMA
+template <typename T>
+constexpr T Tolerance = std::is_same_v<T, float> ? 1e-5 : 1e-11;
+
+// scale of the rounding errors of the covariance element ic: the geometric mean of the corresponding variances,
+// the update subtracting from the covariance matrix terms of the order of the variances
+template <typename T>
+T getCovScale(const TrackParametrizationWithError<T>& trk, int ic)
+{
+  int row = 0;
+  while ((row + 1) * (row + 2) / 2 <= ic) {
+    row++;
+  }
+  int col = ic - row * (row + 1) / 2;
+  return std::sqrt(std::abs(trk.getCov()[row * (row + 3) / 2] * trk.getCov()[col * (col + 3) / 2]));
+}
+#endif
+
+// check that the tracks of the batch have the status and the kinematics of the tracks processed one by one from the inputs,
+// bit to bit unless the scalar methods are contracted to FMA, which may change the last bits: in that case the differences
+// are compared to the magnitude of the inputs, outputs and errors, and the batch is reset to the scalar tracks after the check,
+// such that the differences do not build up along the steps
+template <typename T>
+void checkTracks(TrackParCovBatch<T>& batch, const std::vector<TrackParametrizationWithError<T>>& tracks,
+                 const std::vector<TrackParametrizationWithError<T>>& inputs, const std::vector<bool>& valid)
+{
+  int nDiff = 0;
+  for (size_t i = 0; i < tracks.size(); i++) {
+    if (batch.isValid(i) != valid[i]) {
+      nDiff++;
+      continue;
+    }
+#ifdef __FMA__
+    BOOST_CHECK_CLOSE(batch.getX(i), tracks[i].getX(), 100 * Tolerance<T>);
+    BOOST_CHECK_CLOSE(batch.getAlpha(i), tracks[i].getAlpha(), 100 * Tolerance<T>);
+    for (int ip = 0; ip < kNParams; ip++) {
+      auto scale = std::max({std::abs(tracks[i].getParam(ip)), std::abs(inputs[i].getParam(ip)), std::sqrt(std::abs(tracks[i].getCov()[ip * (ip + 3) / 2]))});
+      BOOST_CHECK_SMALL(batch.getParam(i, ip) - tracks[i].getParam(ip), Tolerance<T> * scale);
+    }
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      auto scale = std::max(getCovScale(tracks[i], ic), getCovScale(inputs[i], ic));
+      BOOST_CHECK_SMALL(batch.getCovarElem(i, ic) - tracks[i].getCov()[ic], Tolerance<T> * scale);
+    }
+    batch.setTrack(i, tracks[i]);
+#else
+    bool same = sameBits(batch.getX(i), tracks[i].getX()) && sameBits(batch.getAlpha(i), tracks[i].getAlpha());
+    for (int ip = 0; ip < kNParams; ip++) {
+      same &= sameBits(batch.getParam(i, ip), tracks[i].getParam(ip));
+    }
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      same &= sameBits(batch.getCovarElem(i, ic), tracks[i].getCov()[ic]);
+    }
+    nDiff += !same;
+#endif
+  }
+  BOOST_CHECK_EQUAL(nDiff, 0);
+}
+
+} // namespace o2::track::test
+
+#endif
@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TrackParCovBatch class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
+#include "TrackParCovBatchChecks.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace o2
+{
+using namespace o2::track;
+using namespace o2::track::test;
+
+template <typename T>
+void testBatch()
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> rnd(-1., 1.);
+  const int nTracks = 1003; // not a multiple of the SIMD width to test the tail processing
+  std::vector<TrackParametrizationWithError<T>> tracks(nTracks);
+  for (auto& trk : tracks) {
+    trk.setX(3. + 40. * std::abs(rnd(gen)));
+    trk.setAlpha(3.1 * rnd(gen));
+    trk.setParam(5. * rnd(gen), kY);
+    trk.setParam(20. * rnd(gen), kZ);
+    trk.setParam(0.95 * rnd(gen), kSnp);
+    trk.setParam(1.2 * rnd(gen), kTgl);
+    trk.setParam(10. * rnd(gen), kQ2Pt);
+    trk.setAbsCharge(rnd(gen) > 0.95 ? 0 : 1);
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      trk.setCov(0.01 * rnd(gen), ic);
+    }
+    // some of the errors above the limits to exercise the covariance check
+    trk.setCov(0.01 + std::abs(rnd(gen)) * (rnd(gen) > 0.8 ? 1e5 : 1.), kSigY2);
+    trk.setCov(0.01 + std::abs(rnd(gen)), kSigZ2);
+    trk.setCov(0.001 + 2. * std::abs(rnd(gen)), kSigSnp2);
+    trk.setCov(0.001 + std::abs(rnd(gen)), kSigTgl2);
+    trk.setCov(0.01 + std::abs(rnd(gen)), kSigQ2Pt2);
+  }
+  TrackParCovBatch<T> batch(tracks);
+  std::vector<bool> valid(nTracks, true);
+
+  for (int iter = 0; iter < 5; iter++) {
+    const T x = tracks[0].getX() + 2. + 5. * iter * (iter % 2 ? -1 : 1);
+    const T bz = 5.;
+    auto inputs = tracks;
+    for (int i = 0; i < nTracks; i++) {
+      valid[i] = valid[i] && tracks[i].propagateTo(x, bz);
+    }
+    batch.propagateTo(x, bz);
+    checkTracks(batch, tracks, inputs, valid);
+
+    std::vector<T> alpha(nTracks);
+    inputs = tracks;
+    for (int i = 0; i < nTracks; i++) {
+      alpha[i] = tracks[i].getAlpha() + 0.3 * rnd(gen);
+      valid[i] = valid[i] && tracks[i].rotate(alpha[i]);
+    }
+    batch.rotate(alpha.data());
+    checkTracks(batch, tracks, inputs, valid);
+
+    std::vector<T> y(nTracks), z(nTracks), sy2(nTracks), syz(nTracks), sz2(nTracks);
+    inputs = tracks;
+    for (int i = 0; i < nTracks; i++) {
+      y[i] = tracks[i].getY() + rnd(gen);
+      z[i] = tracks[i].getZ() + rnd(gen);
+      sy2[i] = 0.01 + 0.1 * std::abs(rnd(gen));
+      syz[i] = 0.001 * rnd(gen);
+      sz2[i] = 0.01 + 0.1 * std::abs(rnd(gen));
+      const T p[2] = {y[i], z[i]}, cov[3] = {sy2[i], syz[i], sz2[i]};
+      valid[i] = valid[i] && tracks[i].update(p, cov);
+    }
+    batch.update(y.data(), z.data(), sy2.data(), syz.data(), sz2.data());
+    checkTracks(batch, tracks, inputs, valid);
+  }
+  size_t nValid = std::count(valid.begin(), valid.end(), true);
+  BOOST_CHECK_EQUAL(batch.getNValid(), nValid);
+  BOOST_CHECK(nValid > nTracks / 2);
+}
+
+BOOST_AUTO_TEST_CASE(TrackParCovBatchFloat)
+{
+  testBatch<float>();
+}
+
+BOOST_AUTO_TEST_CASE(TrackParCovBatchDouble)
+{
+  testBatch<double>();
+}
+
+} // namespace o2
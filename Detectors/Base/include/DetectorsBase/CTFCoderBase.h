@@ -25,6 +25,7 @@
 #include "DetectorsCommonDataFormats/CTFDictHeader.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "DetectorsCommonDataFormats/CTFIOSize.h"
+#include "DetectorsCommonDataFormats/Metadata.h"
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "DetectorsCommonDataFormats/ANSHeader.h"
 #include "rANS/factory.h"
@@ -35,6 +36,10 @@
 #include "Framework/ConcreteDataMatcher.h"
 #include "Framework/ConfigParamRegistry.h"
 #include <any>
+#include <functional>
+#include <vector>
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
 
 namespace o2
 {
@@ -118,6 +123,9 @@ class CTFCoderBase
   void setMemMarginFactor(float v) { mMemMarginFactor = v > 1.f ? v : 1.f; }
   float getMemMarginFactor() const { return mMemMarginFactor; }
 
+  void setEncodeThreads(int n) { mEncodeThreads = n > 1 ? n : 1; }
+  int getEncodeThreads() const { return mEncodeThreads; }
+
   void setVerbosity(int v) { mVerbosity = v; }
   int getVerbosity() const { return mVerbosity; }
 
@@ -161,7 +169,92 @@ class CTFCoderBase
 
   const DetID getDet() const { return mDet; }
 
+  /// Collects the encodes of the blocks of a CTF container held in a buffer and runs them in the order of slots.
+  /// With more than 1 encode thread the blocks are encoded concurrently to detached buffers, which are then merged
+  /// in the order of slots, so that the encoded data does not depend on the number of threads
+  template <typename CTF, typename BUF>
+  class BlockEncoder
+  {
+   public:
+    BlockEncoder(CTFCoderBase& coder, BUF& buffer) : mCoder(coder), mBuffer(buffer) {}
+
+    /// queue the encode of [begin, end) to the slot, the source data must stay valid until run is called
+    template <typename IT>
+    void add(IT begin, IT end, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt)
+    {
+      mSlots.push_back(slot);
+      mTasks.emplace_back([this, begin, end, slot, symbolTablePrecision, opt](Detached* detached) {
+        const auto& coder = mCoder.mCoders[slot];
+        if (detached) {
+          return CTF::get(mBuffer.data())->encodeDetached(begin, end, slot, symbolTablePrecision, opt, *detached, coder, mCoder.getMemMarginFactor());
+        }
+        return CTF::get(mBuffer.data())->encode(begin, end, slot, symbolTablePrecision, opt, &mBuffer, coder, mCoder.getMemMarginFactor());
+      });
+    }
+
+    template <typename VE>
+    void add(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt)
+    {
+      add(std::begin(src), std::end(src), slot, symbolTablePrecision, opt);
+    }
+
+    /// queue the encode of a temporary vector, which is kept by the encoder until run is called
+    template <typename T>
+    void add(std::vector<T>&& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt)
+    {
+      auto kept = std::make_shared<std::vector<T>>(std::move(src));
+      mKept.push_back(kept);
+      add(kept->cbegin(), kept->cend(), slot, symbolTablePrecision, opt);
+    }
+
+    CTFIOSize run()
+    {
+      CTFIOSize iosize;
+      if (mCoder.getEncodeThreads() < 2 || mTasks.size() < 2) {
+        for (auto& task : mTasks) {
+          iosize += task(nullptr);
+        }
+      } else {
+        std::vector<Detached> detached(mTasks.size());
+        std::vector<CTFIOSize> sizes(mTasks.size());
+        mCoder.getEncodeArena().execute([&]() {
+          tbb::parallel_for(size_t(0), mTasks.size(), [&](size_t i) { sizes[i] = mTasks[i](&detached[i]); });
+        });
+        for (size_t i = 0; i < mTasks.size(); i++) {
+          CTF::base::adoptDetached(mBuffer, mSlots[i], detached[i]);
+          iosize += sizes[i];
+        }
+      }
+      mTasks.clear();
+      mSlots.clear();
+      mKept.clear();
+      return iosize;
+    }
+
+   private:
+    using Detached = std::vector<typename BUF::value_type>;
+    CTFCoderBase& mCoder;
+    BUF& mBuffer;
+    std::vector<std::function<CTFIOSize(Detached*)>> mTasks;
+    std::vector<int> mSlots;
+    std::vector<std::shared_ptr<void>> mKept; // temporary sources owned by the encoder
+  };
+
+  template <typename CTF, typename BUF>
+  BlockEncoder<CTF, BUF> makeBlockEncoder(BUF& buffer)
+  {
+    return BlockEncoder<CTF, BUF>(*this, buffer);
+  }
+
  protected:
+  tbb::task_arena& getEncodeArena()
+  {
+    if (!mEncodeArena) {
+      mEncodeArena = std::make_shared<tbb::task_arena>(mEncodeThreads);
+    }
+    return *mEncodeArena;
+  }
+
   void reportIRFrames();
   std::string getPrefix() const { return o2::utils::Str::concat_string(mDet.getName(), "_CTF: "); }
   void checkDictVersion(const CTFDictHeader& h) const;
@@ -194,6 +287,8 @@ class CTFCoderBase
   CTFDictHeader mExtHeader;                    // external dictionary header
   o2::utils::IRFrameSelector mIRFrameSelector; // optional IR frames selector
   float mMemMarginFactor = 1.0f;               // factor for memory allocation in EncodedBlocks
+  int mEncodeThreads = 1;                      // number of threads for the concurrent encode of the blocks
+  std::shared_ptr<tbb::task_arena> mEncodeArena; // arena limiting the block encodes to mEncodeThreads of the shared TBB pool
   bool mLoadDictFromCCDB{true};
   bool mSupportBCShifts{false};
   OpType mOpType;                                    // Encoder or Decoder
@@ -304,6 +399,9 @@ void CTFCoderBase::init(o2::framework::InitContext& ic)
   if (ic.options().hasOption("mem-factor")) {
     setMemMarginFactor(ic.options().get<float>("mem-factor"));
   }
+  if (ic.options().hasOption("encode-threads")) {
+    setEncodeThreads(ic.options().get<int>("encode-threads"));
+  }
   if (ic.options().hasOption("irframe-margin-bwd")) {
     mIRFrameSelMarginBwd = ic.options().get<uint32_t>("irframe-margin-bwd");
   }
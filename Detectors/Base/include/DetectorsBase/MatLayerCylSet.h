@@ -64,6 +64,7 @@ class MatLayerCylSet : public o2::gpu::FlatObject
   GPUd() const MatLayerCyl& getLayer(int i) const { return get()->mLayers[i]; }
 
   GPUd() bool getLayersRange(const Ray& ray, short& lmin, short& lmax) const;
+  GPUd() bool getLayersRange(float rmin2, float rmax2, short& lmin, short& lmax) const;
   GPUd() float getRMin() const { return get()->mRMin; }
   GPUd() float getRMax() const { return get()->mRMax; }
   GPUd() float getZMax() const { return get()->mZMax; }
@@ -101,6 +102,20 @@ class MatLayerCylSet : public o2::gpu::FlatObject
 #endif // !GPUCA_ALIGPUCODE
   GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const;
 
+  /// get material budgets of nSeg segments given in SoA layout, the i-th one going from (x0[i],y0[i],z0[i]) to (x1[i],y1[i],z1[i])
+  GPUd() void getMatBudget(int nSeg, const float* x0, const float* y0, const float* z0, const float* x1, const float* y1, const float* z1, MatBudget* budgets) const;
+
+  /// get material budgets of the nPoints-1 consecutive segments of the path going through the points (x[i],y[i],z[i])
+  GPUd() void getMatBudget(int nPoints, const float* x, const float* y, const float* z, MatBudget* budgets) const
+  {
+    if (nPoints > 1) {
+      getMatBudget(nPoints - 1, x, y, z, x + 1, y + 1, z + 1, budgets);
+    }
+  }
+
+  /// accumulate in rval the material traversed by the ray in the layers lmin:lmax and normalize it
+  GPUd() void accountMatBudget(Ray& ray, short lmin, short lmax, MatBudget& rval) const;
+
   GPUd() int searchSegment(float val, int low = -1, int high = -1) const;
 
   /// searches a layer based on r2 input, using a lookup table
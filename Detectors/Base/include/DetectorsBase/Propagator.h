@@ -44,6 +44,7 @@ class VertexBase;
 namespace field
 {
 class MagFieldFast;
+class MagFieldGrid;
 class MagneticField;
 } // namespace field
 
@@ -52,6 +53,12 @@ namespace gpu
 class GPUTPCGMPolynomialField;
 }
 
+namespace track
+{
+template <typename value_T>
+class TrackParCovBatch;
+}
+
 namespace base
 {
 
@@ -88,6 +95,13 @@ class PropagatorImpl
                            value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
                            track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const;
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+  /// propagate the valid tracks of the batch to X in the field bZ as propagateToX for a single track, the tracks failing are flagged as invalid
+  /// \return returns the number of valid tracks
+  size_t propagateToX(track::TrackParCovBatch<value_type>& tracks, value_type x, value_type bZ,
+                      value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT, int signCorr = 0) const;
+#endif
+
   template <typename track_T>
   GPUd() bool propagateTo(track_T& track, value_type x, bool bzOnly = false, value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP,
                           MatCorrType matCorr = MatCorrType::USEMatCorrLUT, track::TrackLTIntegral* tofInfo = nullptr, int signCorr = 0) const
@@ -135,6 +149,10 @@ class PropagatorImpl
   GPUd() const o2::gpu::GPUTPCGMPolynomialField* getGPUField() const { return mGPUField; }
   GPUd() void setNominalBz(value_type bz) { mNominalBz = bz; }
   GPUd() bool hasMagFieldSet() const { return mField != nullptr; }
+  /// use the grid field map (if set) for the field queries inside its volume, falling back to the other field maps outside;
+  /// updateField() sets the grid of the field if requested by the PropagatorParam
+  GPUd() void setFieldGrid(const o2::field::MagFieldGrid* grid) { mFieldGrid = grid; }
+  GPUd() const o2::field::MagFieldGrid* getFieldGrid() const { return mFieldGrid; }
 
   GPUd() value_type estimateLTFast(o2::track::TrackLTIntegral& lt, const o2::track::TrackParametrization<value_type>& trc) const;
   GPUd() float estimateLTIncrement(const o2::track::TrackParametrization<value_type>& trc, const o2::math_utils::Point3D<value_type>& postStart, const o2::math_utils::Point3D<value_type>& posEnd) const;
@@ -167,6 +185,7 @@ class PropagatorImpl
   GPUd() void getFieldXYZImpl(const math_utils::Point3D<T> xyz, T* bxyz) const;
 
   const o2::field::MagFieldFast* mFieldFast = nullptr; ///< External fast field map (barrel only for the moment)
+  const o2::field::MagFieldGrid* mFieldGrid = nullptr; ///< External field lookup grid, optional
   o2::field::MagneticField* mField = nullptr;          ///< External nominal field map
   value_type mNominalBz = 0;                           ///< nominal field
 
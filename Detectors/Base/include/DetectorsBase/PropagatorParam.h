@@ -0,0 +1,34 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef DETECTORS_BASE_INCLUDE_PROPAGATORPARAM_H_
+#define DETECTORS_BASE_INCLUDE_PROPAGATORPARAM_H_
+
+#include "CommonUtils/ConfigurableParam.h"
+#include "CommonUtils/ConfigurableParamHelper.h"
+
+namespace o2
+{
+namespace base
+{
+
+struct PropagatorParam : public o2::conf::ConfigurableParamHelper<PropagatorParam> {
+  float fieldGridMaxError = 0.f; // if > 0, the field is looked up in a grid with this max. deviation (kG) from the parameterization
+  float fieldGridXYMax = 420.f;  // half size in X and Y (cm) of the field grid
+  float fieldGridZMax = 550.f;   // half size in Z (cm) of the field grid
+
+  O2ParamDef(PropagatorParam, "PropagatorParam");
+};
+
+} // namespace base
+} // namespace o2
+
+#endif /* DETECTORS_BASE_INCLUDE_PROPAGATORPARAM_H_ */
@@ -21,6 +21,8 @@
 #pragma link C++ class o2::base::PropagatorD + ;
 #pragma link C++ class o2::base::PropagatorImpl < double> + ;
 #pragma link C++ class o2::base::PropagatorImpl < float> + ;
+#pragma link C++ class o2::base::PropagatorParam + ;
+#pragma link C++ class o2::conf::ConfigurableParamHelper < o2::base::PropagatorParam> + ;
 
 #pragma link C++ class o2::base::GeometryManager + ;
 #pragma link C++ class o2::base::GeometryManager::MatBudgetExt + ;
@@ -286,6 +286,51 @@ GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, floa
     rval.length = ray.getDist();
     return rval;
   }
+  accountMatBudget(ray, lmin, lmax, rval);
+  return rval;
+}
+
+//_________________________________________________________________________________________________
+GPUd() void MatLayerCylSet::getMatBudget(int nSeg, const float* x0, const float* y0, const float* z0, const float* x1, const float* y1, const float* z1, MatBudget* budgets) const
+{
+  // get material budgets of nSeg segments, processed in chunks: the length and radial span of all segments
+  // of the chunk are computed in a branch-free loop, the segments outside of the LUT or too short are
+  // discarded before building the ray and walking over the layers cells for the remaining ones
+  constexpr int NChunk = 64;
+  float dist[NChunk], rmin2[NChunk], rmax2[NChunk];
+  for (int start = 0; start < nSeg; start += NChunk) {
+    const int n = nSeg - start < NChunk ? nSeg - start : NChunk;
+    const float *cx0 = x0 + start, *cy0 = y0 + start, *cz0 = z0 + start, *cx1 = x1 + start, *cy1 = y1 + start, *cz1 = z1 + start;
+    for (int i = 0; i < n; i++) { // same arithmetics as in the Ray constructor and Ray::getMinMaxR2
+      const float dx = cx1[i] - cx0[i], dy = cy1[i] - cy0[i], dz = cz1[i] - cz0[i];
+      const float distXY2 = dx * dx + dy * dy;
+      const float distXY2i = distXY2 > Ray::Tiny ? 1.f / distXY2 : 0.f;
+      const float tClosest = -(cx0[i] * dx + cy0[i] * dy) * distXY2i;
+      const float r02 = cx0[i] * cx0[i] + cy0[i] * cy0[i], r12 = cx1[i] * cx1[i] + cy1[i] * cy1[i];
+      const float xMin = cx0[i] + tClosest * dx, yMin = cy0[i] + tClosest * dy;
+      const float rClosest2 = xMin * xMin + yMin * yMin;
+      dist[i] = o2::gpu::CAMath::Sqrt(distXY2 + dz * dz);
+      rmax2[i] = r02 > r12 ? r02 : r12;
+      rmin2[i] = (tClosest > 0.f && tClosest < 1.f) ? rClosest2 : (r02 > r12 ? r12 : r02);
+    }
+    for (int i = 0; i < n; i++) {
+      auto& rval = budgets[start + i];
+      rval = MatBudget();
+      short lmin, lmax;
+      if (dist[i] < Ray::MinDistToConsider || !getLayersRange(rmin2[i], rmax2[i], lmin, lmax)) {
+        rval.length = dist[i];
+        continue;
+      }
+      Ray ray(cx0[i], cy0[i], cz0[i], cx1[i], cy1[i], cz1[i]);
+      accountMatBudget(ray, lmin, lmax, rval);
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+GPUd() void MatLayerCylSet::accountMatBudget(Ray& ray, short lmin, short lmax, MatBudget& rval) const
+{
+  // accumulate the material budget traversed by the ray in the layers lmin:lmax
   short lrID = lmax;
   while (lrID >= lmin) { // go from outside to inside
     const auto& lr = getLayer(lrID);
@@ -399,7 +444,6 @@ GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, floa
 #ifdef _DBG_LOC_
   printf("<rho> = %e, x2X0 = %e  | step = %e\n", rval.meanRho, rval.meanX2X0, rval.length);
 #endif
-  return rval;
 }
 
 //_________________________________________________________________________________________________
@@ -407,10 +451,17 @@ GPUd() bool MatLayerCylSet::getLayersRange(const Ray& ray, short& lmin, short& l
 {
   // get range of layers corresponding to rmin/rmax
   //
-  lmin = lmax = -1;
   float rmin2, rmax2;
   ray.getMinMaxR2(rmin2, rmax2);
+  return getLayersRange(rmin2, rmax2, lmin, lmax);
+}
 
+//_________________________________________________________________________________________________
+GPUd() bool MatLayerCylSet::getLayersRange(float rmin2, float rmax2, short& lmin, short& lmax) const
+{
+  // get range of layers corresponding to the squared radii rmin2/rmax2
+  //
+  lmin = lmax = -1;
   if (rmin2 >= getRMax2() || rmax2 <= getRMin2()) {
     return false;
   }
@@ -22,6 +22,7 @@ using namespace o2::gpu;
 
 #if !defined(GPUCA_GPUCODE)
 #include "Field/MagFieldFast.h" // Don't use this on the GPU
+#include "Field/MagFieldGrid.h"
 #endif
 
 #if !defined(GPUCA_STANDALONE) && !defined(GPUCA_GPUCODE)
@@ -29,8 +30,11 @@ using namespace o2::gpu;
 #include "DataFormatsParameters/GRPObject.h"
 #include "DataFormatsParameters/GRPMagField.h"
 #include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/PropagatorParam.h"
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
 #include <FairRunAna.h> // eventually will get rid of it
 #include <TGeoGlobalMagField.h>
+#include <vector>
 
 template <typename value_T>
 PropagatorImpl<value_T>::PropagatorImpl(bool uninitialized)
@@ -60,6 +64,11 @@ void PropagatorImpl<value_T>::updateField()
       mFieldFast = mField->getFastField();
     }
   }
+  // the grid is (re)built by the field only if its settings or the field scaling changed
+  const auto& param = PropagatorParam::Instance();
+  const float gridMin[3] = {-param.fieldGridXYMax, -param.fieldGridXYMax, -param.fieldGridZMax};
+  const float gridMax[3] = {param.fieldGridXYMax, param.fieldGridXYMax, param.fieldGridZMax};
+  setFieldGrid(mField->createFieldGrid(gridMin, gridMax, param.fieldGridMaxError) ? mField->getFieldGrid() : nullptr);
   const value_type xyz[3] = {0.};
   if (mFieldFast) {
     mFieldFast->GetBz(xyz, mNominalBz);
@@ -351,6 +360,99 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackParCov_t& track, value_ty
   return true;
 }
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+//_______________________________________________________________________
+template <typename value_T>
+size_t PropagatorImpl<value_T>::propagateToX(track::TrackParCovBatch<value_type>& tracks, value_type xToGo, value_type bZ, value_type maxSnp, value_type maxStep,
+                                             PropagatorImpl<value_T>::MatCorrType matCorr, int signCorr) const
+{
+  //----------------------------------------------------------------
+  //
+  // Propagates the valid tracks of the batch to the plane X=xk (cm) in the field bZ
+  // and corrects for the crossed material, step by step as propagateToX for a single track.
+  // All tracks make their step at once with the batched kernel, the material budgets
+  // are queried at once from the LUT, the material corrections are applied track by track.
+  //
+  //----------------------------------------------------------------
+  const size_t n = tracks.size();
+  std::vector<int8_t> dir(n), stepping(n);
+  std::vector<value_type> xStep(n);
+  std::vector<math_utils::Point3D<value_type>> xyz0(n);
+  std::vector<float> x0(n), y0(n), z0(n), x1(n), y1(n), z1(n); // segments of the batched LUT query
+  std::vector<MatBudget> budgets(n);
+  for (size_t i = 0; i < n; i++) {
+    dir[i] = xToGo - tracks.getX(i) > 0.f ? 1 : -1;
+  }
+  const bool useLUTBatch = matCorr == MatCorrType::USEMatCorrLUT && mMatLUT;
+
+  while (true) {
+    size_t nStepping = 0;
+    for (size_t i = 0; i < n; i++) {
+      auto dx = xToGo - tracks.getX(i);
+      xStep[i] = tracks.getX(i); // no-op for the tracks which are not stepping
+      stepping[i] = tracks.isValid(i) && math_utils::detail::abs<value_type>(dx) > Epsilon;
+      if (!stepping[i]) {
+        continue;
+      }
+      nStepping++;
+      auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
+      xStep[i] += dir[i] < 0 ? -step : step;
+      if (matCorr != MatCorrType::USEMatCorrNONE) {
+        xyz0[i] = tracks.getTrack(i).getXYZGlo();
+      }
+    }
+    if (!nStepping) {
+      break;
+    }
+    tracks.propagateTo(xStep.data(), bZ);
+
+    if (matCorr != MatCorrType::USEMatCorrNONE) {
+      for (size_t i = 0; i < n; i++) {
+        stepping[i] = stepping[i] && tracks.isValid(i);
+        auto xyz1 = stepping[i] ? tracks.getTrack(i).getXYZGlo() : xyz0[i]; // empty segment for the tracks not stepping
+        if (useLUTBatch) {
+          x0[i] = xyz0[i].X();
+          y0[i] = xyz0[i].Y();
+          z0[i] = xyz0[i].Z();
+          x1[i] = xyz1.X();
+          y1[i] = xyz1.Y();
+          z1[i] = xyz1.Z();
+        } else if (stepping[i]) {
+          budgets[i] = getMatBudget(matCorr, xyz0[i], xyz1);
+        }
+      }
+      if (useLUTBatch) {
+        mMatLUT->getMatBudget(int(n), x0.data(), y0.data(), z0.data(), x1.data(), y1.data(), z1.data(), budgets.data());
+      }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      if (!stepping[i] || !tracks.isValid(i)) {
+        continue;
+      }
+      if (maxSnp > 0 && math_utils::detail::abs<value_type>(tracks.getParam(i, track::kSnp)) >= maxSnp) {
+        tracks.setValid(i, false);
+        continue;
+      }
+      if (matCorr != MatCorrType::USEMatCorrNONE) {
+        auto trc = tracks.getTrack(i);
+        if (!trc.correctForMaterial(budgets[i].meanX2X0, budgets[i].getXRho(signCorr ? signCorr : -dir[i]))) {
+          tracks.setValid(i, false);
+          continue;
+        }
+        tracks.setTrack(i, trc);
+      }
+    }
+  }
+  for (size_t i = 0; i < n; i++) {
+    if (tracks.isValid(i)) {
+      tracks.setX(i, xToGo);
+    }
+  }
+  return tracks.getNValid();
+}
+#endif
+
 //_______________________________________________________________________
 template <typename value_T>
 GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type xToGo, value_type bZ, value_type maxSnp, value_type maxStep,
@@ -759,6 +861,9 @@ GPUd() void PropagatorImpl<value_T>::getFieldXYZImpl(const math_utils::Point3D<T
     }
   } else {
 #ifndef GPUCA_GPUCODE
+    if (mFieldGrid && mFieldGrid->Field(xyz, bxyz)) {
+      return;
+    }
     if (mFieldFast) {
       mFieldFast->Field(xyz, bxyz); // Must not call the host-only function in GPU compilation
     } else {
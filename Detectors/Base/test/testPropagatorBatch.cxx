@@ -0,0 +1,214 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testPropagatorBatch.cxx
+/// \brief check that the propagation of a batch of tracks gives the tracks propagated one by one
+
+#define BOOST_TEST_MODULE Test Propagator batch
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "DetectorsBase/Propagator.h"
+#include "ReconstructionDataFormats/TrackParCovBatch.h"
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TGeoVolume.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+using namespace o2::base;
+using namespace o2::track;
+
+namespace
+{
+
+constexpr float LayerR[4] = {4.f, 12.f, 25.f, 40.f};
+constexpr float LayerDR = 0.3f;
+constexpr float LayerHalfZ = 50.f;
+
+/// geometry of a few silicon tubes around the beam line
+void buildGeometry()
+{
+  if (gGeoManager) {
+    return;
+  }
+  auto geom = new TGeoManager("propagatorBatch", "silicon tubes for the batched propagation test");
+  auto vacuum = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0, 0, 0));
+  auto silicon = new TGeoMedium("Silicon", 2, new TGeoMaterial("Silicon", 28.09, 14, 2.33));
+  auto world = geom->MakeBox("World", vacuum, 100., 100., 100.);
+  geom->SetTopVolume(world);
+  for (int i = 0; i < 4; i++) {
+    world->AddNode(geom->MakeTube(("Layer" + std::to_string(i)).c_str(), silicon, LayerR[i], LayerR[i] + LayerDR, LayerHalfZ), i);
+  }
+  geom->CloseGeometry();
+}
+
+/// material LUT of the geometry
+const MatLayerCylSet* getMatLUT()
+{
+  static MatLayerCylSet lut;
+  if (!lut.isConstructed()) {
+    buildGeometry();
+    for (auto r : LayerR) {
+      lut.addLayer(r - 0.5f, r + LayerDR + 0.5f, LayerHalfZ, 2.f, 2.f);
+    }
+    lut.populateFromTGeo(2);
+    lut.optimizePhiSlices();
+    lut.flatten();
+  }
+  return &lut;
+}
+
+template <typename T>
+bool sameBits(T a, T b)
+{
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+#ifdef __FMA__
+// tolerance on the kinematics when the scalar methods, compiled with the default flags, are contracted to FMA
+template <typename T>
+constexpr T Tolerance = std::is_same_v<T, float> ? 1e-5 : 1e-11;
+
+// scale of the rounding errors of the covariance element ic: the geometric mean of the corresponding variances
+template <typename T>
+T getCovScale(const TrackParametrizationWithError<T>& trk, int ic)
+{
+  int row = 0;
+  while ((row + 1) * (row + 2) / 2 <= ic) {
+    row++;
+  }
+  int col = ic - row * (row + 1) / 2;
+  return std::sqrt(std::abs(trk.getCov()[row * (row + 3) / 2] * trk.getCov()[col * (col + 3) / 2]));
+}
+#endif
+
+// check that the valid tracks of the batch are the tracks propagated one by one from the inputs, bit to bit unless the
+// scalar methods are contracted to FMA: then the differences are compared to the magnitude of the inputs, outputs and
+// errors, and the batch is reset to the scalar tracks. The failing tracks are only checked to be flagged as invalid,
+// they are left where the propagation stopped, which may differ from the scalar one
+template <typename T>
+void checkTracks(TrackParCovBatch<T>& batch, const std::vector<TrackParametrizationWithError<T>>& tracks,
+                 const std::vector<TrackParametrizationWithError<T>>& inputs, const std::vector<bool>& valid)
+{
+  int nDiff = 0;
+  for (size_t i = 0; i < tracks.size(); i++) {
+    if (batch.isValid(i) != valid[i]) {
+      nDiff++;
+      continue;
+    }
+    if (!valid[i]) {
+      continue;
+    }
+#ifdef __FMA__
+    BOOST_CHECK_CLOSE(batch.getX(i), tracks[i].getX(), 100 * Tolerance<T>);
+    BOOST_CHECK_CLOSE(batch.getAlpha(i), tracks[i].getAlpha(), 100 * Tolerance<T>);
+    for (int ip = 0; ip < kNParams; ip++) {
+      auto scale = std::max({std::abs(tracks[i].getParam(ip)), std::abs(inputs[i].getParam(ip)), std::sqrt(std::abs(tracks[i].getCov()[ip * (ip + 3) / 2]))});
+      BOOST_CHECK_SMALL(batch.getParam(i, ip) - tracks[i].getParam(ip), Tolerance<T> * scale);
+    }
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      auto scale = std::max(getCovScale(tracks[i], ic), getCovScale(inputs[i], ic));
+      BOOST_CHECK_SMALL(batch.getCovarElem(i, ic) - tracks[i].getCov()[ic], Tolerance<T> * scale);
+    }
+    batch.setTrack(i, tracks[i]);
+#else
+    bool same = sameBits(batch.getX(i), tracks[i].getX()) && sameBits(batch.getAlpha(i), tracks[i].getAlpha());
+    for (int ip = 0; ip < kNParams; ip++) {
+      same &= sameBits(batch.getParam(i, ip), tracks[i].getParam(ip));
+    }
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      same &= sameBits(batch.getCovarElem(i, ic), tracks[i].getCov()[ic]);
+    }
+    nDiff += !same;
+#endif
+  }
+  BOOST_CHECK_EQUAL(nDiff, 0);
+}
+
+template <typename T>
+void testPropagateToX(typename PropagatorImpl<T>::MatCorrType matCorr)
+{
+  auto propagator = PropagatorImpl<T>::Instance(true);
+  propagator->setMatLUT(getMatLUT());
+  propagator->setTGeoFallBackAllowed(false);
+
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> rnd(-1., 1.);
+  const int nTracks = 503; // not a multiple of the SIMD width to test the tail processing
+  std::vector<TrackParametrizationWithError<T>> tracks(nTracks);
+  for (auto& trk : tracks) {
+    trk.setX(2.);
+    trk.setAlpha(3.1 * rnd(gen));
+    trk.setParam(rnd(gen), kY);
+    trk.setParam(10. * rnd(gen), kZ);
+    trk.setParam(0.5 * rnd(gen), kSnp);
+    trk.setParam(rnd(gen), kTgl);
+    trk.setParam(10. * rnd(gen), kQ2Pt); // down to 100 MeV/c, such that some tracks curl beyond maxSnp
+    trk.setAbsCharge(1);
+    for (int ic = 0; ic < kCovMatSize; ic++) {
+      trk.setCov(1e-5 * rnd(gen), ic);
+    }
+    trk.setCov(0.01, kSigY2);
+    trk.setCov(0.01, kSigZ2);
+    trk.setCov(1e-4, kSigSnp2);
+    trk.setCov(1e-4, kSigTgl2);
+    trk.setCov(0.01, kSigQ2Pt2);
+  }
+  TrackParCovBatch<T> batch(tracks);
+  std::vector<bool> valid(nTracks, true);
+
+  const T bz = 5.;
+  const T maxSnp = 0.85;
+  const T maxStep = 2.;
+  for (T x : {45., 3.}) { // outward then inward, through the layers
+    auto inputs = tracks;
+    for (int i = 0; i < nTracks; i++) {
+      valid[i] = valid[i] && propagator->propagateToX(tracks[i], x, bz, maxSnp, maxStep, matCorr);
+    }
+    auto nValid = propagator->propagateToX(batch, x, bz, maxSnp, maxStep, matCorr);
+    BOOST_CHECK_EQUAL(nValid, size_t(std::count(valid.begin(), valid.end(), true)));
+    checkTracks(batch, tracks, inputs, valid);
+  }
+  BOOST_CHECK(batch.getNValid() > nTracks / 2);
+  BOOST_CHECK(batch.getNValid() < nTracks);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(PropagatorBatchNoMaterial)
+{
+  testPropagateToX<float>(PropagatorF::MatCorrType::USEMatCorrNONE);
+  testPropagateToX<double>(PropagatorD::MatCorrType::USEMatCorrNONE);
+}
+
+BOOST_AUTO_TEST_CASE(PropagatorBatchTGeo)
+{
+  testPropagateToX<float>(PropagatorF::MatCorrType::USEMatCorrTGeo);
+  testPropagateToX<double>(PropagatorD::MatCorrType::USEMatCorrTGeo);
+}
+
+BOOST_AUTO_TEST_CASE(PropagatorBatchLUT)
+{
+  testPropagateToX<float>(PropagatorF::MatCorrType::USEMatCorrLUT);
+  testPropagateToX<double>(PropagatorD::MatCorrType::USEMatCorrLUT);
+}
+
+} // namespace o2
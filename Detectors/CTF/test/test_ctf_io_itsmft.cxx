@@ -23,12 +23,15 @@
 #include "DataFormatsITSMFT/CTF.h"
 #include "DataFormatsITSMFT/ROFRecord.h"
 #include "CommonUtils/NameConf.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
 #include "ITSMFTReconstruction/CTFCoder.h"
 #include "ITSMFTReconstruction/LookUp.h"
 #include "Framework/Logger.h"
 #include <TFile.h>
 #include <TRandom.h>
 #include <TStopwatch.h>
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 
 using namespace o2::itsmft;
@@ -151,4 +154,130 @@ BOOST_DATA_TEST_CASE(CompressedClustersTest, boost_data::make(ANSVersions), ansV
   for (int i = 0; i < npatt; i += 100) {
     BOOST_CHECK(pattVecD[i] == pattVec[i]);
   }
+
+  // flat file round trip, decoding directly from the mapping
+  {
+    sw.Start();
+    o2::ctf::CTFFlatFileWriter writer;
+    writer.open("test_ctf_itsmft.flat");
+    o2::ctf::CTFHeader header{};
+    header.detectors.set(o2::detectors::DetID::ITS);
+    writer.beginEntry(header);
+    writer.addDetector(o2::detectors::DetID::ITS, vec);
+    writer.endEntry();
+    writer.close();
+    sw.Stop();
+    LOG(info) << "Wrote to flat file in " << sw.CpuTime() << " s";
+  }
+  BOOST_CHECK(o2::ctf::CTFFlatFileReader::isFlatFile("test_ctf_itsmft.flat"));
+  BOOST_CHECK(!o2::ctf::CTFFlatFileReader::isFlatFile("test_ctf_itsmft.root"));
+  std::vector<ROFRecord> rofRecVecF;
+  std::vector<CompClusterExt> cclusVecF;
+  std::vector<unsigned char> pattVecF;
+  {
+    sw.Start();
+    o2::ctf::CTFFlatFileReader reader;
+    reader.open("test_ctf_itsmft.flat");
+    BOOST_CHECK(reader.getNEntries() == 1);
+    BOOST_CHECK(reader.getCTFHeader(0).detectors[o2::detectors::DetID::ITS]);
+    BOOST_CHECK(reader.getDetectorData(0, o2::detectors::DetID::MFT).empty());
+    const auto flatImage = reader.getImage<o2::itsmft::CTF>(0, o2::detectors::DetID::ITS);
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder, o2::detectors::DetID::ITS);
+    coder.decode(flatImage, rofRecVecF, cclusVecF, pattVecF, nullptr, clPattLookup);
+    sw.Stop();
+    LOG(info) << "Decompressed from mapped flat file in " << sw.CpuTime() << " s";
+  }
+  BOOST_CHECK(rofRecVecF.size() == rofRecVecD.size());
+  BOOST_CHECK(cclusVecF.size() == cclusVecD.size());
+  BOOST_CHECK(pattVecF == pattVecD);
+  for (size_t i = 0; i < std::min(cclusVecF.size(), cclusVecD.size()); i++) {
+    BOOST_CHECK(cclusVecF[i].getChipID() == cclusVecD[i].getChipID());
+    BOOST_CHECK(cclusVecF[i].getRow() == cclusVecD[i].getRow());
+    BOOST_CHECK(cclusVecF[i].getCol() == cclusVecD[i].getCol());
+  }
+}
+
+/// check that 2 CTF buffers hold the same encoding: same header, layout of the blocks in the buffer, metadata and payloads
+void checkSameEncoding(const std::vector<o2::ctf::BufferType>& vecA, const std::vector<o2::ctf::BufferType>& vecB)
+{
+  const auto* ctfA = o2::itsmft::CTF::get(vecA.data());
+  const auto* ctfB = o2::itsmft::CTF::get(vecB.data());
+  BOOST_CHECK(std::memcmp(&ctfA->getHeader(), &ctfB->getHeader(), sizeof(o2::itsmft::CTFHeader)) == 0);
+  BOOST_CHECK(ctfA->getANSHeader() == ctfB->getANSHeader());
+  BOOST_CHECK_EQUAL(ctfA->getRegistry().nFilledBlocks, ctfB->getRegistry().nFilledBlocks);
+  BOOST_CHECK_EQUAL(ctfA->getRegistry().offsFreeStart, ctfB->getRegistry().offsFreeStart);
+  // offset of the payload in the buffer, -1 if the block has none
+  auto payloadOffset = [](const auto* ctf, int i) {
+    const auto* payload = ctf->getBlock(i).payload;
+    return payload ? reinterpret_cast<const char*>(payload) - ctf->getRegistry().head : std::ptrdiff_t(-1);
+  };
+  for (int i = 0; i < o2::itsmft::CTF::getNBlocks(); i++) {
+    const auto &mdA = ctfA->getMetadata(i), &mdB = ctfB->getMetadata(i);
+    BOOST_CHECK(mdA.opt == mdB.opt);
+    BOOST_CHECK(mdA.nStreams == mdB.nStreams && mdA.messageLength == mdB.messageLength && mdA.nLiterals == mdB.nLiterals);
+    BOOST_CHECK(mdA.messageWordSize == mdB.messageWordSize && mdA.coderType == mdB.coderType && mdA.streamSize == mdB.streamSize);
+    BOOST_CHECK(mdA.probabilityBits == mdB.probabilityBits && mdA.min == mdB.min && mdA.max == mdB.max);
+    BOOST_CHECK(mdA.literalsPackingOffset == mdB.literalsPackingOffset && mdA.literalsPackingWidth == mdB.literalsPackingWidth);
+    BOOST_CHECK(mdA.nDictWords == mdB.nDictWords && mdA.nDataWords == mdB.nDataWords && mdA.nLiteralWords == mdB.nLiteralWords);
+    const auto &blA = ctfA->getBlock(i), &blB = ctfB->getBlock(i);
+    BOOST_CHECK_EQUAL(blA.getNDict(), blB.getNDict());
+    BOOST_CHECK_EQUAL(blA.getNData(), blB.getNData());
+    BOOST_CHECK_EQUAL(blA.getNLiterals(), blB.getNLiterals());
+    BOOST_CHECK_EQUAL(payloadOffset(ctfA, i), payloadOffset(ctfB, i));
+    if (blA.getNStored() && blA.getNStored() == blB.getNStored()) {
+      BOOST_CHECK(std::memcmp(blA.payload, blB.payload, blA.getNStored() * sizeof(*blA.payload)) == 0);
+    }
+  }
+}
+
+BOOST_DATA_TEST_CASE(EncodeThreadsTest, boost_data::make(ANSVersions), ansVersion)
+{
+  // without explicit patterns the pattern block is empty (NODATA)
+  for (bool withPatterns : {true, false}) {
+    gRandom->SetSeed(withPatterns ? 123 : 456);
+    std::vector<ROFRecord> rofRecVec;
+    std::vector<CompClusterExt> cclusVec;
+    std::vector<unsigned char> pattVec;
+    LookUp pattIdConverter;
+    for (int irof = 0; irof < 20; irof++) {
+      auto& rofr = rofRecVec.emplace_back();
+      rofr.getBCData().orbit = irof / 10;
+      rofr.getBCData().bc = irof % 10;
+      rofr.setFirstEntry(cclusVec.size());
+      for (int chipID = irof; chipID < 1000; chipID += 1 + gRandom->Poisson(20)) {
+        for (int i = gRandom->Poisson(20); i--;) {
+          auto& cl = cclusVec.emplace_back(gRandom->Integer(512), gRandom->Integer(1024), gRandom->Integer(withPatterns ? 1000 : 900), chipID);
+          if (cl.getPatternID() > 900) {
+            for (int ib = 1 + gRandom->Poisson(3.); ib--;) {
+              pattVec.push_back(char(gRandom->Integer(256)));
+            }
+          }
+        }
+      }
+      rofr.setNEntries(int(cclusVec.size()) - rofr.getFirstEntry());
+    }
+
+    std::vector<o2::ctf::BufferType> vecSerial, vecParallel;
+    for (int nThreads : {1, 4}) {
+      CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder, o2::detectors::DetID::ITS);
+      coder.setANSVersion(ansVersion);
+      coder.setEncodeThreads(nThreads);
+      coder.encode(nThreads > 1 ? vecParallel : vecSerial, rofRecVec, cclusVec, pattVec, pattIdConverter, 0);
+    }
+    BOOST_CHECK_EQUAL(o2::itsmft::CTF::get(vecSerial.data())->getMetadata(o2::itsmft::CTF::BLCpattMap).opt == o2::ctf::Metadata::OptStore::NODATA, !withPatterns);
+    checkSameEncoding(vecParallel, vecSerial);
+
+    std::vector<ROFRecord> rofRecVecD;
+    std::vector<CompClusterExt> cclusVecD;
+    std::vector<unsigned char> pattVecD;
+    LookUp clPattLookup;
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder, o2::detectors::DetID::ITS);
+    coder.decode(o2::itsmft::CTF::getImage(vecParallel.data()), rofRecVecD, cclusVecD, pattVecD, nullptr, clPattLookup);
+    BOOST_CHECK_EQUAL(rofRecVecD.size(), rofRecVec.size());
+    BOOST_CHECK_EQUAL(cclusVecD.size(), cclusVec.size());
+    BOOST_CHECK(pattVecD == pattVec);
+    for (size_t i = 0; i < std::min(cclusVecD.size(), cclusVec.size()); i++) {
+      BOOST_CHECK(cclusVecD[i].getChipID() == cclusVec[i].getChipID() && cclusVecD[i].getRow() == cclusVec[i].getRow() && cclusVecD[i].getCol() == cclusVec[i].getCol());
+    }
+  }
 }
@@ -12,6 +12,7 @@
 /// @file   CTFReaderSpec.cxx
 
 #include <vector>
+#include <cstring>
 #include <TFile.h>
 #include <TTree.h>
 
@@ -29,6 +30,7 @@
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "CommonUtils/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
 #include "Headers/STFHeader.h"
 #include "DataFormatsITSMFT/CTF.h"
 #include "DataFormatsTPC/CTF.h"
@@ -89,6 +91,9 @@ class CTFReaderSpec : public o2::framework::Task
   void openCTFFile(const std::string& flname);
   bool processTF(ProcessingContext& pc);
   void checkTreeEntries();
+  bool isFileOpen() const { return mCTFTree || mCTFFlatFile; }
+  long getNEntries() const { return mCTFFlatFile ? long(mCTFFlatFile->getNEntries()) : mCTFTree->GetEntries(); }
+  std::string getFileName() const { return mCTFFlatFile ? mCTFFlatFile->getFileName() : mCTFFile->GetName(); }
   void stopReader();
   template <typename C>
   void processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const;
@@ -100,6 +105,7 @@ class CTFReaderSpec : public o2::framework::Task
   std::unique_ptr<o2::utils::FileFetcher> mFileFetcher;
   std::unique_ptr<TFile> mCTFFile;
   std::unique_ptr<TTree> mCTFTree;
+  std::unique_ptr<CTFFlatFileReader> mCTFFlatFile; // memory-mapped flat CTF file, used instead of the tree if provided
   bool mRunning = false;
   bool mUseLocalTFCounter = false;
   int mConvRunTimeRangesToOrbits = -1; // not defined yet
@@ -148,6 +154,7 @@ void CTFReaderSpec::stopReader()
     mCTFFile->Close();
   }
   mCTFFile.reset();
+  mCTFFlatFile.reset();
 }
 
 ///_______________________________________
@@ -285,6 +292,15 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
 {
   try {
     mFilesRead++;
+    if (CTFFlatFileReader::isFlatFile(flname)) {
+      mCTFFlatFile = std::make_unique<CTFFlatFileReader>();
+      mCTFFlatFile->open(flname);
+      if (mCTFFlatFile->getNEntries() < 1) {
+        throw std::runtime_error(fmt::format("flat CTF file {} has 0 entries, skipping", flname));
+      }
+      mCurrTreeEntry = 0;
+      return;
+    }
     mCTFFile.reset(TFile::Open(flname.c_str()));
     if (!mCTFFile || !mCTFFile->IsOpen() || mCTFFile->IsZombie()) {
       throw std::runtime_error(fmt::format("failed to open CTF file {}, skipping", flname));
@@ -300,6 +316,7 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
     LOG(error) << "Cannot process " << flname << ", reason: " << e.what();
     mCTFTree.reset();
     mCTFFile.reset();
+    mCTFFlatFile.reset();
     mNFailedFiles++;
     if (mFileFetcher) {
       mFileFetcher->popFromQueue(mInput.maxLoops < 1);
@@ -319,7 +336,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   long startWait = 0;
 
   while (mRunning) {
-    if (mCTFTree) { // there is a tree open with multiple CTF
+    if (isFileOpen()) { // there is a tree or a flat file open with multiple CTF
       if (mInput.ctfIDs.empty() || mInput.ctfIDs[mSelIDEntry] == mCTFCounter) { // no selection requested or matching CTF ID is found
         LOG(debug) << "TF " << mCTFCounter << " of " << mInput.maxTFs << " loop " << mFileFetcher->getNLoops();
         mSelIDEntry++;
@@ -328,7 +345,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
         }
       }
       // explict CTF ID selection list or IRFrame was provided and current entry is not selected
-      LOGP(info, "Skipping CTF#{} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+      LOGP(info, "Skipping CTF#{} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, getNEntries(), getFileName());
       checkTreeEntries();
       mCTFCounter++;
       continue;
@@ -362,7 +379,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   if (mCTFCounter >= mInput.maxTFs || (!mInput.ctfIDs.empty() && mSelIDEntry >= mInput.ctfIDs.size())) { // done
     LOGP(info, "All CTFs from selected range were injected, stopping");
     mRunning = false;
-  } else if (mRunning && !mCTFTree && mFileFetcher->getNextFileInQueue().empty() && !mFileFetcher->isRunning()) { // previous tree was done, can we read more?
+  } else if (mRunning && !isFileOpen() && mFileFetcher->getNextFileInQueue().empty() && !mFileFetcher->isRunning()) { // previous tree was done, can we read more?
     mRunning = false;
   }
 
@@ -392,7 +409,9 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
 
   static RateLimiter limiter;
   CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
+  if (mCTFFlatFile) {
+    ctfHeader = mCTFFlatFile->getCTFHeader(mCurrTreeEntry);
+  } else if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
     throw std::runtime_error("did not find CTFHeader");
   }
   if (mImposeRunStartMS > 0) {
@@ -471,7 +490,7 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
     stfDist.runNumber = uint32_t(ctfHeader.run);
   }
 
-  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, getNEntries(), getFileName());
   checkTreeEntries();
   mTimer.Stop();
 
@@ -497,10 +516,13 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
 void CTFReaderSpec::checkTreeEntries()
 {
   // check if the tree has entries left, if needed, close current tree/file
-  if (++mCurrTreeEntry >= mCTFTree->GetEntries() || (mInput.maxTFsPerFile > 0 && mCurrTreeEntry >= mInput.maxTFsPerFile)) { // this file is done, check if there are other files
+  if (++mCurrTreeEntry >= getNEntries() || (mInput.maxTFsPerFile > 0 && mCurrTreeEntry >= mInput.maxTFsPerFile)) { // this file is done, check if there are other files
     mCTFTree.reset();
-    mCTFFile->Close();
+    if (mCTFFile) {
+      mCTFFile->Close();
+    }
     mCTFFile.reset();
+    mCTFFlatFile.reset();
     if (mFileFetcher) {
       mFileFetcher->popFromQueue(mInput.maxLoops < 1);
     }
@@ -528,6 +550,13 @@ void CTFReaderSpec::processDetector(DetID det, const CTFHeader& ctfHeader, Proce
 {
   if (mInput.detMask[det]) {
     const auto lbl = det.getName();
+    if (mCTFFlatFile && ctfHeader.detectors[det]) {
+      // the mapped image is already flat, just copy it to the output message
+      const auto image = mCTFFlatFile->getDetectorData(mCurrTreeEntry, det);
+      auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, image.size());
+      std::memcpy(bufVec.data(), image.data(), image.size());
+      return;
+    }
     auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, ctfHeader.detectors[det] ? sizeof(C) : 0);
     if (ctfHeader.detectors[det]) {
       C::readFromTree(bufVec, *(mCTFTree.get()), lbl, mCurrTreeEntry);
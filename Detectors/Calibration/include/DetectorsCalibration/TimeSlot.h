@@ -13,6 +13,7 @@
 #define DETECTOR_CALIB_TIMESLOT_H_
 
 #include <memory>
+#include <vector>
 #include <Rtypes.h>
 #include "Framework/Logger.h"
 #include "CommonDataFormat/TFIDInfo.h"
@@ -38,7 +39,12 @@ class TimeSlot
   TimeSlot(const TimeSlot& src) : mTFStart(src.mTFStart), mTFEnd(src.mTFEnd), mEntries(src.mEntries), mRunStartOrbit(src.mRunStartOrbit), mTFStartMS(src.mTFStartMS)
   {
     mContainer = src.mContainer ? std::make_unique<Container>(*src.mContainer) : nullptr;
+    mEmptyContainer = src.mEmptyContainer ? std::make_unique<Container>(*src.mEmptyContainer) : nullptr;
+    for (const auto& shard : src.mShards) {
+      mShards.emplace_back(std::make_unique<Container>(*shard));
+    }
   }
+  TimeSlot(TimeSlot&& src) = default;
   TimeSlot& operator=(TimeSlot&& src) = default;
 
   ~TimeSlot() = default;
@@ -52,7 +58,38 @@ class TimeSlot
 
   const Container* getContainer() const { return mContainer.get(); }
   Container* getContainer() { return mContainer.get(); }
-  void setContainer(std::unique_ptr<Container> ptr) { mContainer = std::move(ptr); }
+  void setContainer(std::unique_ptr<Container> ptr)
+  {
+    mContainer = std::move(ptr);
+    mShards.clear(); // the shards are copies of the previous container
+    mEmptyContainer.reset();
+  }
+
+  // extra containers filled in parallel with the main one, must be created while the latter is still empty,
+  // i.e. right after setContainer and before any data (e.g. saved by the previous run) is added to it
+  void createShards(int n)
+  {
+    if (!mEmptyContainer) {
+      mEmptyContainer = std::make_unique<Container>(*mContainer);
+    }
+    mShards.resize(n);
+    for (auto& shard : mShards) {
+      if (!shard) {
+        shard = std::make_unique<Container>(*mEmptyContainer);
+      }
+    }
+  }
+  int getNShards() const { return mShards.size(); }
+  Container* getShard(int i) { return mShards[i].get(); }
+
+  // merge the data of the shards to the main container and reset the shards
+  void mergeShards()
+  {
+    for (auto& shard : mShards) {
+      mContainer->merge(shard.get());
+      shard = std::make_unique<Container>(*mEmptyContainer);
+    }
+  }
 
   void setTFStart(TFType v) { mTFStart = v; }
   void setTFEnd(TFType v) { mTFEnd = v; }
@@ -66,6 +103,8 @@ class TimeSlot
   // merge data of previous slot to this one and extend the mTFStart to cover prev
   void mergeToPrevious(TimeSlot& prev)
   {
+    mergeShards();
+    prev.mergeShards();
     mContainer->merge(prev.mContainer.get());
     mTFStart = prev.mTFStart;
     mTFStartMS = prev.mTFStartMS;
@@ -82,8 +121,10 @@ class TimeSlot
   TFType mTFEnd = 0;
   size_t mEntries = 0;
   long mRunStartOrbit = 0;
-  std::unique_ptr<Container> mContainer; // user object to accumulate the calibration data for this slot
-  long mTFStartMS = 0;                   // start time of the slot in ms that avoids to calculate it on the fly; needed when a slot covers more runs, otherwise the OrbitReset that is read is the one of the latest run, and the validity will be wrong
+  std::unique_ptr<Container> mContainer;           // user object to accumulate the calibration data for this slot
+  std::vector<std::unique_ptr<Container>> mShards; //! containers filled in parallel with the mContainer
+  std::unique_ptr<Container> mEmptyContainer;      //! empty copy of the mContainer to create the shards
+  long mTFStartMS = 0;                             // start time of the slot in ms that avoids to calculate it on the fly; needed when a slot covers more runs, otherwise the OrbitReset that is read is the one of the latest run, and the validity will be wrong
 
   ClassDefNV(TimeSlot, 2);
 };
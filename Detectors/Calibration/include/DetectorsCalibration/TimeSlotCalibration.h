@@ -20,11 +20,14 @@
 #include "DetectorsBase/GRPGeomHelper.h"
 #include "CommonDataFormat/TFIDInfo.h"
 #include <TFile.h>
+#include <chrono>
 #include <filesystem>
 #include <deque>
+#include <future>
 #include <gsl/gsl>
 #include <limits>
 #include <type_traits>
+#include <vector>
 #include <unistd.h>
 
 namespace o2
@@ -120,6 +123,32 @@ class TimeSlotCalibration
 
   void setUpdateAtTheEndOfRunOnly() { mUpdateAtTheEndOfRunOnly = kTRUE; }
 
+  // Filling of the slot container by several threads: a single gsl::span data is split in contiguous chunks filled to
+  // the copies of the (empty) slot container, which are merged to the slot container before checking or finalizing the slot.
+  // The Container must be copyable and its merge method must be equivalent to filling the merged data.
+  // To be set before the processing starts: the copies are made when the slot is created.
+  // N-1 threads are started for every TF, which costs O(10) us per thread, therefore this pays off only when filling
+  // a TF takes at least a few ms, e.g. for the per-track or per-cluster residuals, not for a few hundreds of entries.
+  int getNFillThreads() const { return mNFillThreads; }
+  void setNFillThreads(int n) { mNFillThreads = n > 0 ? n : 1; }
+
+  // Asynchronous finalization: the finalizeSlot of the closed slots is called on a background thread while the new data are processed.
+  // The finalizeSlot of the derived class must then access only the slot and its own output containers, and the latter may be read
+  // (and reset by initOutput) only when isFinalizationInProgress() is false. Since finalizeSlot uses the members of the derived class,
+  // waitForFinalization() must be called before the latter is destroyed, e.g. in its destructor or in the stop() of the device.
+  bool getAsyncFinalization() const { return mAsyncFinalization; }
+  void setAsyncFinalization(bool v) { mAsyncFinalization = v; }
+  bool isFinalizationInProgress() const { return mFinalizationFuture.valid() || !mSlotsToFinalize.empty(); }
+  // block until all closed slots are finalized
+  void waitForFinalization() { checkFinalization(true); }
+  // merge the data filled in parallel to the containers of all slots
+  void mergeShards()
+  {
+    for (auto& slot : mSlots) {
+      slot.mergeShards();
+    }
+  }
+
   int getNSlots() const { return mSlots.size(); }
   Slot& getSlotForTF(TFType tf);
   Slot& getSlot(int i) { return (Slot&)mSlots.at(i); }
@@ -134,6 +163,7 @@ class TimeSlotCalibration
 
   virtual void reset()
   { // reset to virgin state (need for start - stop - start)
+    waitForFinalization();
     mSlots.clear();
     mLastClosedTF = 0;
     mFirstTF = 0;
@@ -242,7 +272,16 @@ class TimeSlotCalibration
   }
 
   TFType tf2SlotMin(TFType tf) const;
+  template <typename... DATA>
+  void fillSlot(Slot& slot, const DATA&... data);
+  Slot& emplaceNewShardedSlot(bool front, TFType tstart, TFType tend);
+  void closeSlot(Slot& slot);
+  void checkFinalization(bool wait);
+
   std::deque<Slot> mSlots;
+  std::deque<Slot> mSlotsToFinalize;     //! closed slots waiting for the asynchronous finalization
+  std::deque<Slot> mSlotsInFinalization; //! slots being finalized on the background thread
+  std::future<void> mFinalizationFuture; //! asynchronous finalization of the mSlotsInFinalization
 
   o2::dataformats::TFIDInfo mCurrentTFInfo{};
   int mSlotLengthInSeconds = -1; // optionally provided slot length in seconds
@@ -267,6 +306,8 @@ class TimeSlotCalibration
   bool mWasCheckedInfiniteSlot = false;         // flag to know whether the statistics of the infinite slot was already checked
   bool mUpdateAtTheEndOfRunOnly = false;
   bool mFinalizeWhenReady = false; // if true: single bin is filled until ready, then closed and new one is added
+  bool mAsyncFinalization = false; // if true: finalizeSlot is called on a background thread
+  int mNFillThreads = 1;           // number of threads filling the slot container
 
   std::string mSaveDirectory = ""; // directory where the file is saved
   std::string mSaveFileName = "";  // filename for data saves in the end of the run
@@ -301,12 +342,7 @@ bool TimeSlotCalibration<Container>::process(const DATA&... data)
     }
   }
   auto& slotTF = getSlotForTF(tf);
-  using Cont_t = typename std::remove_pointer<decltype(slotTF.getContainer())>::type;
-  if constexpr (has_fill_method<Cont_t, void(const o2::dataformats::TFIDInfo&, const DATA&...)>::value) {
-    slotTF.getContainer()->fill(mCurrentTFInfo, data...);
-  } else {
-    slotTF.getContainer()->fill(data...);
-  }
+  fillSlot(slotTF, data...);
   if (tf > mMaxSeenTF) {
     mMaxSeenTF = tf; // keep track of the most recent TF processed
   }
@@ -318,6 +354,98 @@ bool TimeSlotCalibration<Container>::process(const DATA&... data)
   return true;
 }
 
+//_________________________________________________
+template <typename>
+struct is_gsl_span : std::false_type {
+};
+
+template <typename T, std::size_t Extent>
+struct is_gsl_span<gsl::span<T, Extent>> : std::true_type {
+};
+
+//_________________________________________________
+template <typename Container>
+template <typename... DATA>
+void TimeSlotCalibration<Container>::fillSlot(Slot& slot, const DATA&... data)
+{
+  using Cont_t = typename std::remove_pointer<decltype(slot.getContainer())>::type;
+  if constexpr (has_fill_method<Cont_t, void(const o2::dataformats::TFIDInfo&, const DATA&...)>::value) {
+    slot.getContainer()->fill(mCurrentTFInfo, data...);
+  } else {
+    if constexpr (sizeof...(DATA) == 1 && (is_gsl_span<DATA>::value && ...) && std::is_copy_constructible_v<Cont_t>) {
+      // the shards are created with the slot, a slot without them (e.g. created by the derived class) is filled serially
+      int nChunksMax = std::min(mNFillThreads, slot.getNShards() + 1);
+      const auto& span = std::get<0>(std::forward_as_tuple(data...));
+      size_t chunk = nChunksMax > 1 ? (span.size() + nChunksMax - 1) / nChunksMax : span.size();
+      int nChunks = chunk ? (span.size() + chunk - 1) / chunk : 0;
+      if (nChunks > 1) {
+        std::vector<std::future<void>> workers;
+        for (int ic = 1; ic < nChunks; ic++) {
+          workers.emplace_back(std::async(std::launch::async, [&slot, &span, chunk, ic]() {
+            slot.getShard(ic - 1)->fill(span.subspan(ic * chunk, std::min(chunk, span.size() - ic * chunk)));
+          }));
+        }
+        slot.getContainer()->fill(span.subspan(0, chunk));
+        for (auto& w : workers) {
+          w.get();
+        }
+        return;
+      }
+    }
+    slot.getContainer()->fill(data...);
+  }
+}
+
+//_________________________________________________
+template <typename Container>
+TimeSlot<Container>& TimeSlotCalibration<Container>::emplaceNewShardedSlot(bool front, TFType tstart, TFType tend)
+{
+  // create the slot and, for the multi-threaded filling, the copies of its container while the latter is still empty
+  auto& slot = emplaceNewSlot(front, tstart, tend);
+  if constexpr (std::is_copy_constructible_v<Container>) {
+    if (mNFillThreads > 1 && slot.getContainer()) {
+      slot.createShards(mNFillThreads - 1);
+    }
+  }
+  return slot;
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::closeSlot(Slot& slot)
+{
+  // finalize the slot or, in the asynchronous mode, queue it for the finalization on the background thread
+  if (mAsyncFinalization) {
+    mSlotsToFinalize.push_back(std::move(slot));
+  } else {
+    finalizeSlot(slot);
+  }
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::checkFinalization(bool wait)
+{
+  // collect the finished asynchronous finalization and launch the finalization of the queued slots
+  do {
+    if (mFinalizationFuture.valid()) {
+      if (!wait && mFinalizationFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+      }
+      mFinalizationFuture.get(); // will rethrow the exception of the finalizeSlot, if any
+      mSlotsInFinalization.clear();
+    }
+    if (!mSlotsToFinalize.empty()) {
+      mSlotsInFinalization.swap(mSlotsToFinalize);
+      mFinalizationFuture = std::async(std::launch::async, [this]() {
+        for (auto& slot : mSlotsInFinalization) {
+          finalizeSlot(slot);
+        }
+      });
+    }
+  } while (wait && mFinalizationFuture.valid());
+}
+
 //_________________________________________________
 template <typename Container>
 void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDelay)
@@ -339,18 +467,19 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
         LOG(info) << "Update interval passed (" << checkInterval << "), checking slot for " << mSlots[0].getTFStart() << " <= TF <= " << INFINITE_TF;
       }
       mLastCheckedTFInfiniteSlot = tf;
+      mSlots[0].mergeShards();
       if (hasEnoughData(mSlots[0])) {
         mWasCheckedInfiniteSlot = false;
         mSlots[0].setTFStart(mLastClosedTF);
         mSlots[0].setTFEnd(mMaxSeenTF);
         LOG(info) << "Finalizing slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
-        finalizeSlot(mSlots[0]);                  // will be removed after finalization
+        closeSlot(mSlots[0]);                     // will be removed after finalization
         mLastClosedTF = mSlots[0].getTFEnd() < INFINITE_TF ? (mSlots[0].getTFEnd() + 1) : mSlots[0].getTFEnd() < INFINITE_TF; // will not accept any TF below this
         mSlots.erase(mSlots.begin());
         // creating a new slot if we are not at the end of run
         if (tf != INFINITE_TF) {
           LOG(info) << "Creating new slot for " << mLastClosedTF << " <= TF <= " << INFINITE_TF;
-          auto& sl = emplaceNewSlot(true, mLastClosedTF, INFINITE_TF);
+          auto& sl = emplaceNewShardedSlot(true, mLastClosedTF, INFINITE_TF);
           sl.setRunStartOrbit(getRunStartOrbit());
         }
       } else {
@@ -366,9 +495,10 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
       uint64_t lim64 = uint64_t(maxDelay) + slot->getTFEnd();
       TFType tfLim = lim64 < INFINITE_TF ? TFType(lim64) : INFINITE_TF;
       if (tfLim < tf) {
+        slot->mergeShards();
         if (hasEnoughData(*slot)) {
           LOG(debug) << "Finalizing slot for " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
-          finalizeSlot(*slot); // will be removed after finalization
+          closeSlot(*slot); // will be removed after finalization
         } else if ((slot + 1) != mSlots.end()) {
           LOG(info) << "Merging underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd()
                     << " to slot " << (slot + 1)->getTFStart() << " <= TF <= " << (slot + 1)->getTFEnd();
@@ -385,6 +515,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
       }
     }
   }
+  checkFinalization(false);
 }
 
 //_________________________________________________
@@ -396,6 +527,8 @@ void TimeSlotCalibration<Container>::finalizeOldestSlot()
     LOG(warning) << "There are no slots defined";
     return;
   }
+  waitForFinalization(); // the slots must be finalized in order
+  mSlots.front().mergeShards();
   finalizeSlot(mSlots.front());
   mLastClosedTF = mSlots.front().getTFEnd() + 1; // do not accept any TF below this
   mSlots.erase(mSlots.begin());
@@ -432,7 +565,7 @@ TimeSlot<Container>& TimeSlotCalibration<Container>::getSlotForTF(TFType tf)
     if (!mSlots.empty() && mSlots.back().getTFEnd() < tf) {
       mSlots.back().setTFEnd(tf);
     } else if (mSlots.empty()) {
-      auto& sl = emplaceNewSlot(true, mFirstTF, tf);
+      auto& sl = emplaceNewShardedSlot(true, mFirstTF, tf);
       sl.setRunStartOrbit(getRunStartOrbit());
       sl.setStaticStartTimeMS(sl.getStartTimeMS());
     }
@@ -446,7 +579,7 @@ TimeSlot<Container>& TimeSlotCalibration<Container>::getSlotForTF(TFType tf)
       uint64_t tft = mSlots.front().getTFStart() - 1;
       TFType tfmx = tft < o2::calibration::INFINITE_TF ? TFType(tft) : o2::calibration::INFINITE_TF;
       LOG(info) << "Adding new slot for " << tfmn << " <= TF <= " << tfmx;
-      auto& sl = emplaceNewSlot(true, tfmn, tfmx);
+      auto& sl = emplaceNewShardedSlot(true, tfmn, tfmx);
       sl.setRunStartOrbit(getRunStartOrbit());
       sl.setStaticStartTimeMS(sl.getStartTimeMS());
       if (!tfmn) {
@@ -471,7 +604,7 @@ TimeSlot<Container>& TimeSlotCalibration<Container>::getSlotForTF(TFType tf)
     }
     TFType tfmx = tft < o2::calibration::INFINITE_TF ? TFType(tft) : o2::calibration::INFINITE_TF;
     LOG(info) << "Adding new slot for " << tfmn << " <= TF <= " << tfmx;
-    auto& sl = emplaceNewSlot(false, tfmn, tfmx);
+    auto& sl = emplaceNewShardedSlot(false, tfmn, tfmx);
     sl.setRunStartOrbit(getRunStartOrbit());
     sl.setStaticStartTimeMS(sl.getStartTimeMS());
     tfmn = tft < o2::calibration::INFINITE_TF ? mSlots.back().getTFEnd() + 1 : tft;
@@ -520,6 +653,7 @@ bool TimeSlotCalibration<Container>::saveLastSlot()
   if (!updateSaveMetaData()) {
     return false;
   }
+  mergeShards();
 
   if (!mSaveDirectory.empty() && !std::filesystem::exists(mSaveDirectory)) {
     std::filesystem::create_directories(mSaveDirectory);
@@ -0,0 +1,201 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  testTimeSlotCalibration.cxx
+/// \brief this task tests the multi-threaded filling and the asynchronous finalization of the TimeSlotCalibration
+
+#define BOOST_TEST_MODULE Test DetectorsCalibration TimeSlotCalibration
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DetectorsCalibration/TimeSlotCalibration.h"
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace o2
+{
+namespace calibration
+{
+
+static constexpr int NBINS = 64;          // number of bins of the test container
+static constexpr int NTFS = 95;           // number of TFs processed
+static constexpr int NVALUESPERTF = 5000; // number of values filled per TF
+static constexpr TFType SLOTLENGTH = 10;  // slot length in TFs
+
+// histogram of the values, merging is equivalent to filling the merged data
+struct HistoContainer {
+  std::vector<long> counts = std::vector<long>(NBINS);
+  long entries = 0;
+
+  void fill(const gsl::span<const int> data)
+  {
+    for (auto v : data) {
+      counts[v % NBINS]++;
+    }
+    entries += data.size();
+  }
+  void merge(const HistoContainer* other)
+  {
+    for (int i = 0; i < NBINS; i++) {
+      counts[i] += other->counts[i];
+    }
+    entries += other->entries;
+  }
+  void print() const { LOG(info) << "entries: " << entries; }
+};
+
+struct SlotOutput {
+  TFType tfStart;
+  TFType tfEnd;
+  HistoContainer histo;
+};
+
+class TestCalibrator final : public TimeSlotCalibration<HistoContainer>
+{
+ public:
+  explicit TestCalibrator(std::chrono::milliseconds finalizationTime) : mFinalizationTime(finalizationTime) {}
+  ~TestCalibrator() final { waitForFinalization(); }
+
+  void initOutput() final { mOutputs.clear(); }
+  bool hasEnoughData(const Slot& slot) const final { return slot.getContainer()->entries >= SLOTLENGTH * NVALUESPERTF; }
+  void finalizeSlot(Slot& slot) final
+  {
+    std::this_thread::sleep_for(mFinalizationTime); // emulates a slow fit
+    mOutputs.push_back({slot.getTFStart(), slot.getTFEnd(), *slot.getContainer()});
+  }
+  Slot& emplaceNewSlot(bool front, TFType tstart, TFType tend) final
+  {
+    auto& cont = getSlots();
+    auto& slot = front ? cont.emplace_front(tstart, tend) : cont.emplace_back(tstart, tend);
+    slot.setContainer(std::make_unique<HistoContainer>());
+    return slot;
+  }
+  const std::vector<SlotOutput>& getOutputs() const { return mOutputs; }
+
+ private:
+  std::chrono::milliseconds mFinalizationTime;
+  std::vector<SlotOutput> mOutputs;
+};
+
+std::vector<int> generateTF(std::mt19937& gen)
+{
+  std::vector<int> data(NVALUESPERTF);
+  std::uniform_int_distribution<int> dist(0, 100000);
+  for (auto& v : data) {
+    v = dist(gen);
+  }
+  return data;
+}
+
+std::vector<SlotOutput> runCalibration(int nThreads, bool async)
+{
+  TestCalibrator calibrator(std::chrono::milliseconds(async ? 20 : 0));
+  calibrator.setSlotLength(SLOTLENGTH);
+  calibrator.setMaxSlotsDelay(0);
+  calibrator.setNFillThreads(nThreads);
+  calibrator.setAsyncFinalization(async);
+  std::mt19937 gen(1234);
+  for (int tf = 0; tf < NTFS; tf++) {
+    auto data = generateTF(gen);
+    calibrator.getCurrentTFInfo().tfCounter = tf;
+    calibrator.getCurrentTFInfo().firstTForbit = 1000000 + tf * 128;
+    calibrator.process(gsl::span<const int>(data));
+  }
+  calibrator.checkSlotsToFinalize(INFINITE_TF);
+  calibrator.waitForFinalization();
+  BOOST_CHECK(!calibrator.isFinalizationInProgress());
+  return calibrator.getOutputs();
+}
+
+void compareOutputs(const std::vector<SlotOutput>& outputs, const std::vector<SlotOutput>& reference)
+{
+  BOOST_REQUIRE_EQUAL(outputs.size(), reference.size());
+  for (size_t i = 0; i < outputs.size(); i++) {
+    BOOST_CHECK_EQUAL(outputs[i].tfStart, reference[i].tfStart);
+    BOOST_CHECK_EQUAL(outputs[i].tfEnd, reference[i].tfEnd);
+    BOOST_CHECK_EQUAL(outputs[i].histo.entries, reference[i].histo.entries);
+    BOOST_CHECK(outputs[i].histo.counts == reference[i].histo.counts);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlot_ShardedFill)
+{
+  std::mt19937 gen(1);
+  auto data = generateTF(gen);
+  TimeSlot<HistoContainer> reference(0, SLOTLENGTH - 1), sharded(0, SLOTLENGTH - 1);
+  reference.setContainer(std::make_unique<HistoContainer>());
+  reference.getContainer()->fill(data);
+
+  // fill contiguous chunks to the container and its shards in parallel, as TimeSlotCalibration does
+  const int nShards = 3;
+  sharded.setContainer(std::make_unique<HistoContainer>());
+  sharded.createShards(nShards);
+  BOOST_CHECK_EQUAL(sharded.getNShards(), nShards);
+  gsl::span<const int> span(data);
+  size_t chunk = (span.size() + nShards) / (nShards + 1);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < nShards; i++) {
+    workers.emplace_back([&, i]() { sharded.getShard(i)->fill(span.subspan((i + 1) * chunk, std::min(chunk, span.size() - (i + 1) * chunk))); });
+  }
+  sharded.getContainer()->fill(span.subspan(0, chunk));
+  for (auto& w : workers) {
+    w.join();
+  }
+  sharded.mergeShards();
+
+  BOOST_CHECK_EQUAL(sharded.getContainer()->entries, reference.getContainer()->entries);
+  BOOST_CHECK(sharded.getContainer()->counts == reference.getContainer()->counts);
+  for (int i = 0; i < nShards; i++) { // the shards are reset after merging
+    BOOST_CHECK_EQUAL(sharded.getShard(i)->entries, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibration_ThreadedFillOfLoadedSlot)
+{
+  // the data saved by the previous run are added to the container of a new slot, as adoptSavedData does,
+  // they must not be copied to the shards and counted again at every merging
+  std::mt19937 gen(2);
+  auto saved = generateTF(gen), data = generateTF(gen);
+  TestCalibrator calibrator(std::chrono::milliseconds(0));
+  calibrator.setSlotLength(SLOTLENGTH);
+  calibrator.setNFillThreads(4);
+  auto& slot = calibrator.getSlotForTF(0);
+  BOOST_CHECK_EQUAL(slot.getNShards(), 3);
+  slot.getContainer()->fill(saved);
+  HistoContainer reference;
+  reference.fill(saved);
+  for (int tf = 0; tf < 3; tf++) {
+    calibrator.getCurrentTFInfo().tfCounter = tf;
+    calibrator.process(gsl::span<const int>(data));
+    reference.fill(data);
+    slot.mergeShards();
+  }
+  BOOST_CHECK_EQUAL(slot.getContainer()->entries, reference.entries);
+  BOOST_CHECK(slot.getContainer()->counts == reference.counts);
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibration_ThreadedFillAndAsyncFinalization)
+{
+  const auto reference = runCalibration(1, false);
+  BOOST_REQUIRE_EQUAL(reference.size(), NTFS / SLOTLENGTH); // the last, incomplete, slot is discarded
+  for (size_t i = 1; i < reference.size(); i++) {
+    BOOST_CHECK_GT(reference[i].tfStart, reference[i - 1].tfEnd);
+  }
+
+  compareOutputs(runCalibration(4, false), reference);
+  compareOutputs(runCalibration(1, true), reference);
+  compareOutputs(runCalibration(4, true), reference);
+}
+
+} // namespace calibration
+} // namespace o2
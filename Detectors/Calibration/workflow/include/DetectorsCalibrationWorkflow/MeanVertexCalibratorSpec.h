@@ -30,9 +30,11 @@ class MeanVertexCalibDevice : public Task
 {
  public:
   MeanVertexCalibDevice(std::shared_ptr<o2::base::GRPGeomRequest> req, uint32_t dcsMVsubspec) : mCCDBRequest(req), mDCSSubSpec(dcsMVsubspec) {}
+  ~MeanVertexCalibDevice() final;
   void init(o2::framework::InitContext& ic) final;
   void run(o2::framework::ProcessingContext& pc) final;
   void endOfStream(o2::framework::EndOfStreamContext& ec) final;
+  void stop() final;
   void finaliseCCDB(o2::framework::ConcreteDataMatcher& matcher, void* obj) final;
 
  private:
@@ -19,6 +19,7 @@
 #include "DetectorsCalibration/Utils.h"
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CcdbObjectInfo.h"
+#include "TROOT.h"
 
 using namespace o2::framework;
 
@@ -38,6 +39,12 @@ void MeanVertexCalibDevice::init(InitContext& ic)
   if (useVerboseMode) {
     mCalibrator->useVerboseMode(true);
   }
+  mCalibrator->setNFillThreads(ic.options().get<int>("nthreads-fill"));
+  mCalibrator->setAsyncFinalization(ic.options().get<bool>("async-finalization"));
+  if (mCalibrator->getNFillThreads() > 1 || mCalibrator->getAsyncFinalization()) {
+    ROOT::EnableThreadSafety();
+  }
+  LOGP(info, "Filling slots with {} threads, {} finalization", mCalibrator->getNFillThreads(), mCalibrator->getAsyncFinalization() ? "asynchronous" : "synchronous");
 }
 
 //_____________________________________________________________
@@ -55,6 +62,9 @@ void MeanVertexCalibDevice::run(o2::framework::ProcessingContext& pc)
   o2::base::TFIDInfoHelper::fillTFIDInfo(pc, mCalibrator->getCurrentTFInfo());
   LOG(debug) << "Processing TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices";
   mCalibrator->process(data);
+  if (mCalibrator->isFinalizationInProgress()) { // the output will be sent with one of the next TFs
+    return;
+  }
   sendOutput(pc.outputs());
   const auto& infoVec = mCalibrator->getMeanVertexObjectInfoVector();
   LOG(detail) << "Processed TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices, for which we created " << infoVec.size() << " objects for TF " << mCalibrator->getCurrentTFInfo().tfCounter;
@@ -73,11 +83,33 @@ void MeanVertexCalibDevice::endOfStream(o2::framework::EndOfStreamContext& ec)
 
   LOG(info) << "Finalizing calibration";
   mCalibrator->checkSlotsToFinalize(o2::calibration::INFINITE_TF);
+  mCalibrator->waitForFinalization();
   sendOutput(ec.outputs());
 }
 
 //_____________________________________________________________
 
+void MeanVertexCalibDevice::stop()
+{
+  // the asynchronous finalization modifies the calibrator, it must be completed before the latter is reset or destroyed
+  if (mCalibrator) {
+    mCalibrator->waitForFinalization();
+  }
+}
+
+//_____________________________________________________________
+
+MeanVertexCalibDevice::~MeanVertexCalibDevice()
+{
+  try {
+    stop();
+  } catch (const std::exception& e) {
+    LOG(error) << "Asynchronous finalization failed: " << e.what();
+  }
+}
+
+//_____________________________________________________________
+
 void MeanVertexCalibDevice::sendOutput(DataAllocator& output)
 {
 
@@ -153,7 +185,10 @@ DataProcessorSpec getMeanVertexCalibDeviceSpec(uint32_t dcsMVsubspec)
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<device>(ccdbRequest, dcsMVsubspec)},
-    Options{{"use-verbose-mode", VariantType::Bool, false, {"Use verbose mode"}}}};
+    Options{
+      {"use-verbose-mode", VariantType::Bool, false, {"Use verbose mode"}},
+      {"nthreads-fill", VariantType::Int, 1, {"Number of threads filling the slots"}},
+      {"async-finalization", VariantType::Bool, false, {"Finalize the slots on a background thread"}}}};
 }
 
 } // namespace framework
@@ -15,6 +15,9 @@
 #include <iosfwd>
 #include <array>
 #include <optional>
+#include <variant>
+#include <vector>
+#include <gsl/span>
 #include <Rtypes.h>
 #include "EMCALReconstruction/CaloFitResults.h"
 #include "DataFormatsEMCAL/Constants.h"
@@ -60,10 +63,69 @@ class CaloRawFitterGamma2 final : public CaloRawFitter
   /// \return Container with the fit results (amp, time, chi2, ...)
   CaloFitResults evaluate(const gsl::span<const Bunch> bunchvector) final;
 
+  /// \brief Result of the evaluation of a channel in the batched evaluation: fit results or fit error
+  using BatchResult = std::variant<CaloFitResults, RawFitterError_t>;
+
+  /// \brief Evaluation Amplitude and TOF of several channels
+  ///
+  /// Equivalent to evaluate for each channel (up to rounding), with the error thrown by
+  /// evaluate stored as result. The Gamma-2 fits of kNLanes channels are done together, with the samples
+  /// stored as structure of arrays and the iterations running over all channels of
+  /// the group until each one converged or failed.
+  ///
+  /// \param channels ALTRO bunches of each channel
+  /// \param results Fit results or fit error of each channel
+  void evaluate(const gsl::span<const gsl::span<const Bunch>> channels, std::vector<BatchResult>& results);
+
  private:
+  static constexpr int kNLanes = 8; ///< number of channels fitted together in the batched evaluation
+
+  /// \struct ChannelFit
+  /// \brief Fit parameters and estimates from the samples of a channel
+  struct ChannelFit {
+    float amp = 0;          ///< amplitude, initial guess before the fit
+    float time = 0;         ///< time, initial guess before the fit
+    float chi2 = 0;         ///< chi2 of the fit
+    float ampEstimate = 0;  ///< amplitude estimated from the samples
+    float pedEstimate = 0;  ///< pedestal estimate
+    short maxADC = 0;       ///< max. ADC value
+    short timeEstimate = 0; ///< time estimated from the samples
+    int nsamples = 0;       ///< number of samples used in the fit
+    int first = 0;          ///< first time bin of the peak region
+    int timebinOffset = 0;  ///< time bin offset of the selected bunch
+    bool doFit = false;     ///< the samples are suited for the Gamma-2 fit
+    bool fitDone = false;   ///< the Gamma-2 fit succeeded
+
+    /// \brief Fall back to the estimates in case of fit failure
+    void setFitFailed()
+    {
+      amp = ampEstimate;
+      time = timeEstimate;
+      chi2 = 1.e9;
+    }
+  };
+
   int mNiter = 0;           ///< number of iteraions
   int mNiterationsMax = 15; ///< max number of iteraions
 
+  /// \brief Select the samples of the channel to be fitted and evaluate the initial parameters
+  /// \param bunchvector ALTRO bunches for the current channel
+  /// \return Estimates and initial fit parameters, the selected samples are in mReversed
+  /// \throw RawFitterError_t in case the sample selection failed
+  ChannelFit prepareFit(const gsl::span<const Bunch> bunchvector);
+
+  /// \brief Validate the fit result against the estimates and build the fit results
+  /// \param fit Fit parameters and estimates
+  /// \return Container with the fit results (amp, time, chi2, ...)
+  /// \throw RawFitterError_t::FIT_ERROR in case the amplitude is below the threshold
+  CaloFitResults finalizeFit(const ChannelFit& fit) const;
+
+  /// \brief Fits the raw signal time distribution of up to kNLanes channels together
+  /// \param nChannels Number of channels
+  /// \param fits Fit parameters of the channels, set to the fit results or to the estimates if the fit failed
+  /// \param samples Selected samples of the channels
+  void doFit_1peak(int nChannels, ChannelFit* const* fits, const double* const* samples) const;
+
   /// \brief Fits the raw signal time distribution
   /// \param firstTimeBin First timebin in the ALTRO bunch
   /// \param nSamples Number of time samples of the ALTRO bunch
@@ -13,6 +13,7 @@
 /// \author Martin Poghosyan (Martin.Poghosyan@cern.ch)
 
 #include <fairlogger/Logger.h>
+#include <algorithm>
 #include <cfloat>
 #include <random>
 
@@ -34,46 +35,112 @@ CaloRawFitterGamma2::CaloRawFitterGamma2() : CaloRawFitter("Chi Square ( Gamma2
 
 CaloFitResults CaloRawFitterGamma2::evaluate(const gsl::span<const Bunch> bunchlist)
 {
-  float time = 0;
-  float amp = 0;
-  float chi2 = 0;
-  int ndf = 0;
-  bool fitDone = false;
+  auto fit = prepareFit(bunchlist);
+  if (fit.doFit) {
+    mNiter = 0;
+    try {
+      fit.chi2 = doFit_1peak(fit.first, fit.nsamples, fit.amp, fit.time);
+      fit.fitDone = true;
+    } catch (RawFitterError_t& e) {
+      // Fit has failed, set values to estimates
+      // TODO: Check whether we want to include cases in which the peak fit failed
+      fit.setFitFailed();
+    }
+  }
+  return finalizeFit(fit);
+}
+
+void CaloRawFitterGamma2::evaluate(const gsl::span<const gsl::span<const Bunch>> channels, std::vector<BatchResult>& results)
+{
+  results.clear();
+  results.reserve(channels.size());
+  std::vector<ChannelFit> fits(channels.size());
+  std::vector<int> fitChannels;                                      // channels to be fitted
+  std::vector<double> samples(channels.size() * constants::EMCAL_MAXTIMEBINS); // selected samples of the channels to be fitted
+  for (size_t ich = 0; ich < channels.size(); ich++) {
+    try {
+      fits[ich] = prepareFit(channels[ich]);
+    } catch (RawFitterError_t& e) {
+      fits[ich].doFit = false;
+      results.emplace_back(e);
+      continue;
+    }
+    if (fits[ich].doFit) {
+      std::copy(mReversed.begin(), mReversed.end(), samples.begin() + fitChannels.size() * constants::EMCAL_MAXTIMEBINS);
+      fitChannels.push_back(ich);
+    }
+    results.emplace_back(CaloFitResults());
+  }
 
+  std::array<ChannelFit*, kNLanes> laneFits;
+  std::array<const double*, kNLanes> laneSamples;
+  for (size_t ifit = 0; ifit < fitChannels.size(); ifit += kNLanes) {
+    int nLanes = std::min(fitChannels.size() - ifit, size_t(kNLanes));
+    for (int lane = 0; lane < nLanes; lane++) {
+      laneFits[lane] = &fits[fitChannels[ifit + lane]];
+      laneSamples[lane] = &samples[(ifit + lane) * constants::EMCAL_MAXTIMEBINS];
+    }
+    doFit_1peak(nLanes, laneFits.data(), laneSamples.data());
+  }
+
+  for (size_t ich = 0; ich < channels.size(); ich++) {
+    if (std::holds_alternative<RawFitterError_t>(results[ich])) {
+      continue;
+    }
+    try {
+      results[ich] = finalizeFit(fits[ich]);
+    } catch (RawFitterError_t& e) {
+      results[ich] = e;
+    }
+  }
+}
+
+CaloRawFitterGamma2::ChannelFit CaloRawFitterGamma2::prepareFit(const gsl::span<const Bunch> bunchlist)
+{
+  ChannelFit fit;
   auto [nsamples, bunchIndex, ampEstimate,
         maxADC, timeEstimate, pedEstimate, first, last] = preFitEvaluateSamples(bunchlist, mAmpCut);
+  fit.nsamples = nsamples;
+  fit.ampEstimate = ampEstimate;
+  fit.maxADC = maxADC;
+  fit.timeEstimate = timeEstimate;
+  fit.pedEstimate = pedEstimate;
+  fit.first = first;
 
   if (bunchIndex >= 0 && ampEstimate >= mAmpCut) {
-    time = timeEstimate;
-    int timebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
-    amp = ampEstimate;
+    fit.time = timeEstimate;
+    fit.timebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
+    fit.amp = ampEstimate;
 
     if (nsamples > 2 && maxADC < constants::OVERFLOWCUT) {
-      std::tie(amp, time) = doParabolaFit(timeEstimate - 1);
-      mNiter = 0;
-      try {
-        chi2 = doFit_1peak(first, nsamples, amp, time);
-        fitDone = true;
-      } catch (RawFitterError_t& e) {
-        // Fit has failed, set values to estimates
-        // TODO: Check whether we want to include cases in which the peak fit failed
-        amp = ampEstimate;
-        time = timeEstimate;
-        chi2 = 1.e9;
-      }
-
-      time += timebinOffset;
-      timeEstimate += timebinOffset;
-      ndf = nsamples - 2;
+      std::tie(fit.amp, fit.time) = doParabolaFit(timeEstimate - 1);
+      fit.doFit = true;
     }
   }
+  return fit;
+}
+
+CaloFitResults CaloRawFitterGamma2::finalizeFit(const ChannelFit& fit) const
+{
+  float time = fit.time;
+  float amp = fit.amp;
+  float chi2 = fit.chi2;
+  short timeEstimate = fit.timeEstimate;
+  int ndf = 0;
+  bool fitDone = fit.fitDone;
+
+  if (fit.doFit) {
+    time += fit.timebinOffset;
+    timeEstimate += fit.timebinOffset;
+    ndf = fit.nsamples - 2;
+  }
 
   if (fitDone) {
-    float ampAsymm = (amp - ampEstimate) / (amp + ampEstimate);
+    float ampAsymm = (amp - fit.ampEstimate) / (amp + fit.ampEstimate);
     float timeDiff = time - timeEstimate;
 
     if ((TMath::Abs(ampAsymm) > 0.1) || (TMath::Abs(timeDiff) > 2)) {
-      amp = ampEstimate;
+      amp = fit.ampEstimate;
       time = timeEstimate;
       fitDone = false;
     }
@@ -87,7 +154,7 @@ CaloFitResults CaloRawFitterGamma2::evaluate(const gsl::span<const Bunch> bunchl
     time = time * constants::EMCAL_TIMESAMPLE;
     time -= mL1Phase;
 
-    return CaloFitResults(maxADC, pedEstimate, 0, amp, time, (int)time, chi2, ndf);
+    return CaloFitResults(fit.maxADC, fit.pedEstimate, 0, amp, time, (int)time, chi2, ndf);
   }
   // Fit failed, rethrow error
   throw RawFitterError_t::FIT_ERROR;
@@ -157,6 +224,92 @@ float CaloRawFitterGamma2::doFit_1peak(int firstTimeBin, int nSamples, float& am
   return chi2;
 }
 
+void CaloRawFitterGamma2::doFit_1peak(int nChannels, ChannelFit* const* fits, const double* const* samples) const
+{
+  // same iterations as the single channel fit, the sums over the samples are done for all channels
+  // at once, the lanes of the channels which converged or failed, or beyond their number of samples, are masked
+  std::array<double, constants::EMCAL_MAXTIMEBINS * kNLanes> y{}; // sample i of the channel in lane l at i * kNLanes + l
+  std::array<int, kNLanes> nSamples{};
+  std::array<float, kNLanes> ampl{}, time{};
+  std::array<bool, kNLanes> active{};
+  int maxSamples = 0;
+  for (int lane = 0; lane < nChannels; lane++) {
+    nSamples[lane] = std::min(fits[lane]->nsamples, constants::EMCAL_MAXTIMEBINS);
+    ampl[lane] = fits[lane]->amp;
+    time[lane] = fits[lane]->time;
+    active[lane] = true;
+    maxSamples = std::max(maxSamples, nSamples[lane]);
+    for (int itbin = 0; itbin < nSamples[lane]; itbin++) {
+      y[itbin * kNLanes + lane] = samples[lane][itbin];
+    }
+  }
+
+  const double ExpStep = TMath::Exp(-2 / constants::TAU);
+  int nActive = nChannels;
+  for (int iter = 0; iter <= mNiterationsMax && nActive; iter++) {
+    std::array<double, kNLanes> c11{}, c12{}, c21{}, c22{}, d1{}, d2{};
+    std::array<float, kNLanes> chi2{};
+    // exp(-2 * ti) is obtained recursively from one exponential per lane, which keeps the loop over the lanes
+    // free of transcendental calls, the relative difference to the direct evaluation stays at the 1e-15 level
+    std::array<double, kNLanes> expTerm;
+    for (int lane = 0; lane < kNLanes; lane++) {
+      expTerm[lane] = TMath::Exp(2 * time[lane] / constants::TAU);
+    }
+    for (int itbin = 0; itbin < maxSamples; itbin++) {
+      const double* yi = &y[itbin * kNLanes];
+      for (int lane = 0; lane < kNLanes; lane++) {
+        double ti = (itbin - time[lane]) / constants::TAU;
+        bool use = active[lane] & (itbin < nSamples[lane]) & !((ti + 1) < 0); // no short-circuit to keep the loop branch-free
+        double g_1i = (ti + 1) * expTerm[lane];
+        double g_i = (ti + 1) * g_1i;
+        double gp_i = 2 * (g_i - g_1i);
+        double q1_i = (2 * ti + 1) * expTerm[lane];
+        double q2_i = g_1i * g_1i * (4 * ti + 1);
+        double delta = ampl[lane] * g_i - yi[lane];
+        c11[lane] += use ? (yi[lane] - ampl[lane] * 2 * g_i) * gp_i : 0.;
+        c12[lane] += use ? g_i * g_i : 0.;
+        c21[lane] += use ? yi[lane] * q1_i - ampl[lane] * q2_i : 0.;
+        c22[lane] += use ? g_i * g_1i : 0.;
+        d1[lane] += use ? delta * g_i : 0.;
+        d2[lane] += use ? delta * g_1i : 0.;
+        chi2[lane] = use ? chi2[lane] + delta * delta : chi2[lane];
+        expTerm[lane] *= ExpStep;
+      }
+    }
+
+    for (int lane = 0; lane < nChannels; lane++) {
+      if (!active[lane]) {
+        continue;
+      }
+      double D = c11[lane] * c22[lane] - c12[lane] * c21[lane];
+      if (TMath::Abs(D) < DBL_EPSILON) {
+        fits[lane]->setFitFailed();
+        active[lane] = false;
+        nActive--;
+        continue;
+      }
+      double dt = (d1[lane] * c22[lane] - d2[lane] * c12[lane]) / D * constants::TAU;
+      double dA = (d1[lane] * c21[lane] - d2[lane] * c11[lane]) / D;
+      time[lane] += dt;
+      ampl[lane] += dA;
+      if (!(TMath::Abs(dA) > 1 || TMath::Abs(dt) > 0.01)) {
+        fits[lane]->amp = ampl[lane];
+        fits[lane]->time = time[lane];
+        fits[lane]->chi2 = chi2[lane];
+        fits[lane]->fitDone = true;
+        active[lane] = false;
+        nActive--;
+      }
+    }
+  }
+  // not converged within the max. number of iterations
+  for (int lane = 0; lane < nChannels; lane++) {
+    if (active[lane]) {
+      fits[lane]->setFitFailed();
+    }
+  }
+}
+
 std::tuple<float, float> CaloRawFitterGamma2::doParabolaFit(int maxTimeBin) const
 {
   float amp(0.), time(0.);
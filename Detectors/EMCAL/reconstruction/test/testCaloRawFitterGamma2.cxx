@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EMCAL Reconstruction
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <variant>
+#include <vector>
+#include <gsl/span>
+#include <EMCALReconstruction/Bunch.h>
+#include <EMCALReconstruction/CaloRawFitterGamma2.h>
+
+namespace o2
+{
+namespace emcal
+{
+
+BOOST_AUTO_TEST_CASE(CaloRawFitterGamma2Batch_test)
+{
+  // random gamma-2 pulses on a pedestal, one bunch per channel, a fraction of them below threshold or in overflow
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::normal_distribution<double> noise(0., 1.5);
+  const int nChannels = 1001;
+  const int bunchLength = 15, startTime = 14;
+  std::vector<std::vector<Bunch>> channels(nChannels);
+  for (auto& bunches : channels) {
+    double amp = std::exp(7.5 * uniform(gen)), t0 = 2. + 6. * uniform(gen), ped = 40. + 20. * uniform(gen);
+    auto& bunch = bunches.emplace_back(bunchLength, startTime);
+    for (int isample = bunchLength - 1; isample >= 0; isample--) { // ADCs are stored in reverse time order
+      double ti = (isample - t0) / constants::TAU;
+      double adc = ped + noise(gen) + (ti + 1 > 0 ? amp * (ti + 1) * (ti + 1) * std::exp(-2 * ti) : 0.);
+      bunch.addADC(std::clamp(int(adc), 0, 1023));
+    }
+  }
+  std::vector<gsl::span<const Bunch>> channelSpans(channels.begin(), channels.end());
+
+  CaloRawFitterGamma2 fitter;
+  fitter.setIsZeroSuppressed(false);
+  std::vector<CaloRawFitterGamma2::BatchResult> batchResults;
+  fitter.evaluate(channelSpans, batchResults);
+  BOOST_REQUIRE_EQUAL(batchResults.size(), nChannels);
+
+  int nFitted = 0;
+  for (int ich = 0; ich < nChannels; ich++) {
+    try {
+      auto result = fitter.evaluate(channelSpans[ich]);
+      BOOST_REQUIRE(std::holds_alternative<CaloFitResults>(batchResults[ich]));
+      const auto& batchResult = std::get<CaloFitResults>(batchResults[ich]);
+      // same arithmetic in both fitters, identical up to the FP contraction done by the compiler
+      BOOST_CHECK_SMALL(batchResult.getAmp() - result.getAmp(), 1.e-4f * (1.f + std::abs(result.getAmp())));
+      BOOST_CHECK_SMALL(batchResult.getTime() - result.getTime(), 1.e-4 * (1. + std::abs(result.getTime())));
+      BOOST_CHECK_SMALL(batchResult.getChi2() - result.getChi2(), 1.e-4f * (1.f + std::abs(result.getChi2())));
+      BOOST_CHECK_EQUAL(batchResult.getNdf(), result.getNdf());
+      nFitted += result.getNdf() > 0;
+    } catch (CaloRawFitter::RawFitterError_t& error) {
+      BOOST_REQUIRE(std::holds_alternative<CaloRawFitter::RawFitterError_t>(batchResults[ich]));
+      BOOST_CHECK(std::get<CaloRawFitter::RawFitterError_t>(batchResults[ich]) == error);
+    }
+  }
+  BOOST_CHECK(nFitted > nChannels / 2);
+}
+
+} // namespace emcal
+} // namespace o2
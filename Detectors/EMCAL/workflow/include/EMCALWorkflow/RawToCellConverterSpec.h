@@ -27,6 +27,7 @@
 #include "EMCALBase/Mapper.h"
 #include "EMCALBase/TriggerMappingV2.h"
 #include "EMCALReconstruction/CaloRawFitter.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2.h"
 #include "EMCALReconstruction/RawReaderMemory.h"
 #include "EMCALReconstruction/RecoContainer.h"
 #include "EMCALReconstruction/ReconstructionErrors.h"
@@ -321,10 +322,11 @@ class RawToCellConverterSpec : public framework::Task
   /// \param timeCorrector Handler for correction of the time
   /// \param position Channel coordinates
   /// \param chantype Channel type (High Gain, Low Gain, LEDMON)
+  /// \param batchFitResult Result of the batched raw fit of the channel (optional)
   ///
-  /// Performing a raw fit of the bunches in the channel to extract energy and time, and
-  /// adding them to the container for FEE data of the given event.
-  void addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype);
+  /// Performing a raw fit of the bunches in the channel to extract energy and time, unless
+  /// already done in the batched raw fit, and adding them to the container for FEE data of the given event.
+  void addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype, const CaloRawFitterGamma2::BatchResult* batchFitResult = nullptr);
 
   /// \brief Add TRU channel to the event
   /// \param currentEvent Event to add the channel to
@@ -519,6 +521,9 @@ class RawToCellConverterSpec : public framework::Task
   std::unique_ptr<MappingHandler> mMapper = nullptr;                 ///!<! Mapper
   std::unique_ptr<TriggerMappingV2> mTriggerMapping;                 ///!<! Trigger mapping
   std::unique_ptr<CaloRawFitter> mRawFitter;                         ///!<! Raw fitter
+  CaloRawFitterGamma2* mBatchFitter = nullptr;                       ///!<! Raw fitter for the batched fit of the channels of a DDL (gamma2 only)
+  std::vector<gsl::span<const Bunch>> mBatchFitChannels;             ///!<! Bunches of the channels of the DDL for the batched fit
+  std::vector<CaloRawFitterGamma2::BatchResult> mBatchFitResults;    ///!<! Results of the batched fit of the channels of the DDL
   std::vector<Cell> mOutputCells;                                    ///< Container with output cells
   std::vector<TriggerRecord> mOutputTriggerRecords;                  ///< Container with output trigger records for cells
   std::vector<ErrorTypeFEE> mOutputDecoderErrors;                    ///< Container with decoder errors
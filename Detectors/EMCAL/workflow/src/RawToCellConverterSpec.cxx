@@ -88,6 +88,8 @@ void RawToCellConverterSpec::init(framework::InitContext& ctx)
   } else if (fitmethod == "gamma2") {
     LOG(info) << "Using gamma2 raw fitter";
     mRawFitter = std::unique_ptr<CaloRawFitter>(new o2::emcal::CaloRawFitterGamma2);
+    // the channels of each DDL are fitted together
+    mBatchFitter = static_cast<o2::emcal::CaloRawFitterGamma2*>(mRawFitter.get());
   } else {
     LOG(fatal) << "Unknown fit method" << fitmethod;
   }
@@ -278,9 +280,29 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
         const auto& map = mMapper->getMappingForDDL(feeID);
         uint16_t iSM = feeID / 2;
 
+        const auto& channels = decoder.getChannels();
+        if (mBatchFitter) {
+          // fit at once all FEE channels of the DDL, the other channels are left empty
+          mBatchFitChannels.clear();
+          for (const auto& chan : channels) {
+            bool isFEE = false;
+            try {
+              auto chantype = map.getChannelType(chan.getHardwareAddress());
+              isFEE = chantype == o2::emcal::ChannelType_t::HIGH_GAIN || chantype == o2::emcal::ChannelType_t::LOW_GAIN ||
+                      (chantype == o2::emcal::ChannelType_t::LEDMON && (triggerbits & o2::trigger::Cal));
+            } catch (Mapper::AddressNotFoundException& ex) {
+              // handled in the loop over the channels below
+            }
+            mBatchFitChannels.emplace_back(isFEE ? gsl::span<const Bunch>(chan.getBunches()) : gsl::span<const Bunch>());
+          }
+          mBatchFitter->evaluate(mBatchFitChannels, mBatchFitResults);
+        }
+
         // Loop over all the channels
         int nBunchesNotOK = 0;
-        for (auto& chan : decoder.getChannels()) {
+        for (size_t ichan = 0; ichan < channels.size(); ichan++) {
+          const auto& chan = channels[ichan];
+          const auto* batchFitResult = mBatchFitter ? &mBatchFitResults[ichan] : nullptr;
           try {
             auto iRow = map.getRow(chan.getHardwareAddress());
             auto iCol = map.getColumn(chan.getHardwareAddress());
@@ -289,12 +311,12 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
             switch (chantype) {
               case o2::emcal::ChannelType_t::HIGH_GAIN:
               case o2::emcal::ChannelType_t::LOW_GAIN:
-                addFEEChannelToEvent(currentEvent, chan, timeCorrector, channelPosition, chantype);
+                addFEEChannelToEvent(currentEvent, chan, timeCorrector, channelPosition, chantype, batchFitResult);
                 break;
               case o2::emcal::ChannelType_t::LEDMON:
                 // Drop LEDMON reconstruction in case of physics triggers
                 if (triggerbits & o2::trigger::Cal) {
-                  addFEEChannelToEvent(currentEvent, chan, timeCorrector, channelPosition, chantype);
+                  addFEEChannelToEvent(currentEvent, chan, timeCorrector, channelPosition, chantype, batchFitResult);
                 }
                 break;
               case o2::emcal::ChannelType_t::TRU:
@@ -448,7 +470,7 @@ bool RawToCellConverterSpec::isLostTimeframe(framework::ProcessingContext& ctx)
   return false;
 }
 
-void RawToCellConverterSpec::addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype)
+void RawToCellConverterSpec::addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype, const CaloRawFitterGamma2::BatchResult* batchFitResult)
 {
   int CellID = -1;
   bool isLowGain = false;
@@ -470,7 +492,14 @@ void RawToCellConverterSpec::addFEEChannelToEvent(o2::emcal::EventContainer& cur
   // define the conatiner for the fit results, and perform the raw fitting using the stadnard raw fitter
   CaloFitResults fitResults;
   try {
-    fitResults = mRawFitter->evaluate(currentchannel.getBunches());
+    if (batchFitResult) {
+      if (auto fiterror = std::get_if<CaloRawFitter::RawFitterError_t>(batchFitResult)) {
+        throw *fiterror;
+      }
+      fitResults = std::get<CaloFitResults>(*batchFitResult);
+    } else {
+      fitResults = mRawFitter->evaluate(currentchannel.getBunches());
+    }
     // Prevent negative entries - we should no longer get here as the raw fit usually will end in an error state
     if (fitResults.getAmp() < 0) {
       fitResults.setAmp(0.);
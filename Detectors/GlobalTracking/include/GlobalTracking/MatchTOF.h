@@ -195,6 +195,13 @@ class MatchTOF
   static void groupingMatch(const std::vector<o2::dataformats::MatchInfoTOFReco>& origin, std::vector<std::vector<o2::dataformats::MatchInfoTOFReco>>& grouped, std::vector<std::vector<int>>& firstEls, std::vector<std::vector<int>>& secondEls);
   static void printGrouping(const std::vector<o2::dataformats::MatchInfoTOFReco>& origin, const std::vector<std::vector<o2::dataformats::MatchInfoTOFReco>>& grouped);
 
+  ///< group by strip the time ordered TOF clusters of a sector, given by their indices sectorCache in clusters:
+  ///< the clusters of the strip i are at the positions stripIndex[stripOffset[i]] to stripIndex[stripOffset[i + 1] - 1] of sectorCache
+  static void buildStripIndex(const std::vector<Cluster>& clusters, const std::vector<int>& sectorCache, std::vector<int>& stripIndex, std::array<int, o2::tof::Geo::NSTRIPXSECTOR + 1>& stripOffset);
+  ///< add to candidates the positions in sectorCache of the TOF clusters of the strip with tMin <= time <= tMax, in time order
+  static void addStripCandidates(int strip, double tMin, double tMax, const std::vector<Cluster>& clusters, const std::vector<int>& sectorCache,
+                                 const std::vector<int>& stripIndex, const std::array<int, o2::tof::Geo::NSTRIPXSECTOR + 1>& stripOffset, std::vector<int>& candidates);
+
   void storeMatchable(bool val = true) { mStoreMatchable = val; }
 
   void setNlanes(int lanes) { mNlanes = lanes; }
@@ -317,6 +324,10 @@ class MatchTOF
 
   ///< per sector indices of TOF cluster entry in mTOFClusWork
   std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusSectIndexCache;
+  ///< per sector positions in mTOFClusSectIndexCache of the TOF clusters grouped by strip, ordered in time for each strip
+  std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusStripIndex;
+  ///< per sector offsets in mTOFClusStripIndex of the clusters of each strip
+  std::array<std::array<int, o2::tof::Geo::NSTRIPXSECTOR + 1>, o2::constants::math::NSectors> mTOFClusStripOffset;
 
   ///< array of track-TOFCluster pairs from the matching
   std::vector<o2::dataformats::MatchInfoTOFReco> mMatchedTracksPairsSec[o2::constants::math::NSectors];
@@ -10,6 +10,8 @@
 // or submit itself to any jurisdiction.
 #include <TTree.h>
 #include <cassert>
+#include <algorithm>
+#include <numeric>
 
 #include <fairlogger/Logger.h>
 #include "Field/MagneticField.h"
@@ -143,9 +145,7 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp, unsigned long f
   o2::tof::Geo::Init();
 
   if (mIsITSTPCused || mIsTPCTRDused || mIsITSTPCTRDused) {
-#ifdef WITH_OPENMP
-#pragma omp parallel for schedule(dynamic) num_threads(mNlanes)
-#endif
+    // the tracks of each sector are matched in parallel
     for (int sec = o2::constants::math::NSectors - 1; sec > -1; sec--) {
       doMatching(sec);
     }
@@ -154,9 +154,7 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp, unsigned long f
 
   mTimerMatchTPC.Start();
   if (mIsTPCused) {
-#ifdef WITH_OPENMP
-#pragma omp parallel for schedule(dynamic) num_threads(mNlanes)
-#endif
+    // the tracks of each sector are matched in parallel
     for (int sec = o2::constants::math::NSectors - 1; sec > -1; sec--) {
       doMatchingForTPC(sec);
     }
@@ -232,6 +230,9 @@ void MatchTOF::run(const o2::globaltracking::RecoContainer& inp, unsigned long f
     nMatchesStr += fmt::format("{} : {} ; ", sec, nMatches[sec]);
   }
   LOG(info) << nMatchesStr;
+  double matchingTime = mTimerMatchITSTPC.RealTime() + mTimerMatchTPC.RealTime();
+  size_t nMatchesTot = std::accumulate(nMatches.begin(), nMatches.end(), size_t(0));
+  LOGF(info, "Matching rate: %zu track-TOF cluster pairs in %.3e s, %.3e pairs/s", nMatchesTot, matchingTime, matchingTime > 0. ? nMatchesTot / matchingTime : 0.);
   // re-arrange outputs from constrained/unconstrained to the 4 cases (TPC, ITS-TPC, TPC-TRD, ITS-TPC-TRD) to be implemented as soon as TPC-TRD and ITS-TPC-TRD tracks available
 
   mIsTPCused = false;
@@ -800,6 +801,11 @@ bool MatchTOF::prepareTOFClusters()
     });
   } // loop over TOF clusters of single sector
 
+  // index the time ordered clusters of each sector by strip
+  for (int sec = o2::constants::math::NSectors - 1; sec > -1; sec--) {
+    buildStripIndex(mTOFClusWork, mTOFClusSectIndexCache[sec], mTOFClusStripIndex[sec], mTOFClusStripOffset[sec]);
+  }
+
   if (mMatchedClustersIndex) {
     delete[] mMatchedClustersIndex;
   }
@@ -809,6 +815,31 @@ bool MatchTOF::prepareTOFClusters()
   return true;
 }
 //______________________________________________
+void MatchTOF::buildStripIndex(const std::vector<Cluster>& clusters, const std::vector<int>& sectorCache, std::vector<int>& stripIndex, std::array<int, Geo::NSTRIPXSECTOR + 1>& stripOffset)
+{
+  // counting sort of the clusters by strip, which keeps the time ordering of the clusters within each strip
+  stripOffset.fill(0);
+  for (auto icl : sectorCache) {
+    stripOffset[clusters[icl].getPadInSector() / Geo::NPADS + 1]++;
+  }
+  std::partial_sum(stripOffset.begin(), stripOffset.end(), stripOffset.begin());
+  stripIndex.resize(sectorCache.size());
+  auto fillPos = stripOffset;
+  for (int itof = 0; itof < int(sectorCache.size()); itof++) {
+    stripIndex[fillPos[clusters[sectorCache[itof]].getPadInSector() / Geo::NPADS]++] = itof;
+  }
+}
+//______________________________________________
+void MatchTOF::addStripCandidates(int strip, double tMin, double tMax, const std::vector<Cluster>& clusters, const std::vector<int>& sectorCache,
+                                  const std::vector<int>& stripIndex, const std::array<int, Geo::NSTRIPXSECTOR + 1>& stripOffset, std::vector<int>& candidates)
+{
+  auto first = stripIndex.begin() + stripOffset[strip], last = stripIndex.begin() + stripOffset[strip + 1];
+  auto itCand = std::lower_bound(first, last, tMin, [&clusters, &sectorCache](int itof, double t) { return clusters[sectorCache[itof]].getTime() < t; });
+  for (; itCand != last && !(clusters[sectorCache[*itCand]].getTime() > tMax); itCand++) {
+    candidates.push_back(*itCand);
+  }
+}
+//______________________________________________
 void MatchTOF::doMatching(int sec)
 {
   trkType type = trkType::CONSTR;
@@ -821,541 +852,172 @@ void MatchTOF::doMatching(int sec)
   if (!nTracks || !nTOFCls) {
     return;
   }
-  int itof0 = 0;                          // starting index in TOF clusters for matching of the track
-  int detId[2][5];                        // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the TOF det index
-  float deltaPos[2][3];                   // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the residuals
-  o2::track::TrackLTIntegral trkLTInt[2]; // Here we store the integrated track length and time for the (max 2) matched strips
-  int nStepsInsideSameStrip[2] = {0, 0};  // number of propagation steps in the same strip (since we have maximum 2 strips, it has dimention = 2)
-  float deltaPosTemp[3];
-  std::array<float, 3> pos;
-  std::array<float, 3> posBeforeProp;
-  float posFloat[3];
-
-  // prematching for TPC only tracks (identify BC candidate to correct z for TPC track accordingly to v_drift)
-
-  LOG(debug) << "Trying to match %d tracks" << cacheTrk.size();
-  for (int itrk = 0; itrk < cacheTrk.size(); itrk++) {
-    for (int ii = 0; ii < 2; ii++) {
-      detId[ii][2] = -1; // before trying to match, we need to inizialize the detId corresponding to the strip number to -1; this is the array that we will use to save the det id of the maximum 2 strips matched
-      nStepsInsideSameStrip[ii] = 0;
-    }
-    int nStripsCrossedInPropagation = 0; // how many strips were hit during the propagation
-    auto& trackWork = mTracksWork[sec][type][cacheTrk[itrk]];
-    auto& trefTrk = trackWork.first;
-    float pt = trefTrk.getPt();
-    auto& intLT = mLTinfos[sec][type][cacheTrk[itrk]];
-    float timeShift = intLT.getL() * 33.35641; // integrated time for 0.75 beta particles in ps, to take into account the t.o.f. delay with respect the interaction BC
-                                               // using beta=0.75 to cover beta range [0.59 , 1.04] also for a 8 m track lenght with a 10 ns track resolution (TRD)
-
-    //    Printf("intLT (before doing anything): length = %f, time (Pion) = %f", intLT.getL(), intLT.getTOF(o2::track::PID::Pion));
-    float minTrkTime = (trackWork.second.getTimeStamp() - mSigmaTimeCut * trackWork.second.getTimeStampError()) * 1.E6 + timeShift;         // minimum time in ps
-    float maxTrkTime = (trackWork.second.getTimeStamp() + mSigmaTimeCut * trackWork.second.getTimeStampError()) * 1.E6 + timeShift + 100E3; // maximum time in ps + 100 ns for slow tracks (beta->0.2)
-    const float sqrt12inv = 1. / sqrt(12.);
-    float resT = (trackWork.second.getTimeStampError() + 100E-3) * sqrt12inv;
-    int istep = 1;                                                                                                                          // number of steps
-    float step = 1.0;                                                                                                                       // step size in cm
-
-    //uncomment for local debug
-    /*
-    //trefTrk.getXYZGlo(posBeforeProp);
-    //float posBeforeProp[3] = {trefTrk.getX(), trefTrk.getY(), trefTrk.getZ()}; // in local ref system
-    //printf("Global coordinates: posBeforeProp[0] = %f, posBeforeProp[1] = %f, posBeforeProp[2] = %f\n", posBeforeProp[0], posBeforeProp[1], posBeforeProp[2]);
-    //Printf("Radius xy = %f", TMath::Sqrt(posBeforeProp[0]*posBeforeProp[0] + posBeforeProp[1]*posBeforeProp[1]));
-    //Printf("Radius xyz = %f", TMath::Sqrt(posBeforeProp[0]*posBeforeProp[0] + posBeforeProp[1]*posBeforeProp[1] + posBeforeProp[2]*posBeforeProp[2]));
-    */
-
-    // initializing
-    for (int ii = 0; ii < 2; ii++) {
-      for (int iii = 0; iii < 5; iii++) {
-        detId[ii][iii] = -1;
-      }
-    }
-
-    int detIdTemp[5] = {-1, -1, -1, -1, -1}; // TOF detector id at the current propagation point
-
-    double reachedPoint = mXRef + istep * step;
-
-    while (propagateToRefX(trefTrk, reachedPoint, step, intLT) && nStripsCrossedInPropagation <= 2 && reachedPoint < Geo::RMAX) {
-      // while (o2::base::Propagator::Instance()->PropagateToXBxByBz(trefTrk,  mXRef + istep * step, MAXSNP, step, 1, &intLT) && nStripsCrossedInPropagation <= 2 && mXRef + istep * step < Geo::RMAX) {
-
-      trefTrk.getXYZGlo(pos);
-      for (int ii = 0; ii < 3; ii++) { // we need to change the type...
-        posFloat[ii] = pos[ii];
+  // the tracks are processed in chunks of consecutive tracks, each chunk with its own buffer of matches;
+  // the buffers are merged in the order of the chunks, so that the output does not depend on the number of threads
+  const int nChunks = std::min(nTracks, 8 * mNlanes);
+  std::vector<std::vector<o2::dataformats::MatchInfoTOFReco>> chunkMatches(nChunks);
+  LOG(debug) << "Trying to match " << nTracks << " tracks in " << nChunks << " chunks";
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNlanes)
+#endif
+  for (int ichunk = 0; ichunk < nChunks; ichunk++) {
+    int detId[2][5];                        // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the TOF det index
+    float deltaPos[2][3];                   // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the residuals
+    o2::track::TrackLTIntegral trkLTInt[2]; // Here we store the integrated track length and time for the (max 2) matched strips
+    int nStepsInsideSameStrip[2] = {0, 0};  // number of propagation steps in the same strip (since we have maximum 2 strips, it has dimention = 2)
+    float deltaPosTemp[3];
+    std::array<float, 3> pos;
+    std::array<float, 3> posBeforeProp;
+    float posFloat[3];
+    std::vector<int> candidates; // positions in cacheTOF of the TOF clusters compatible with the track in strip and time
+    auto& matches = chunkMatches[ichunk];
+    const int itrkMax = int((ichunk + 1) * int64_t(nTracks) / nChunks);
+    for (int itrk = int(ichunk * int64_t(nTracks) / nChunks); itrk < itrkMax; itrk++) {
+      for (int ii = 0; ii < 2; ii++) {
+        detId[ii][2] = -1; // before trying to match, we need to inizialize the detId corresponding to the strip number to -1; this is the array that we will use to save the det id of the maximum 2 strips matched
+        nStepsInsideSameStrip[ii] = 0;
       }
-
-      // uncomment below only for local debug; this will produce A LOT of output - one print per propagation step
+      int nStripsCrossedInPropagation = 0; // how many strips were hit during the propagation
+      auto& trackWork = mTracksWork[sec][type][cacheTrk[itrk]];
+      auto& trefTrk = trackWork.first;
+      float pt = trefTrk.getPt();
+      auto& intLT = mLTinfos[sec][type][cacheTrk[itrk]];
+      float timeShift = intLT.getL() * 33.35641; // integrated time for 0.75 beta particles in ps, to take into account the t.o.f. delay with respect the interaction BC
+                                                 // using beta=0.75 to cover beta range [0.59 , 1.04] also for a 8 m track lenght with a 10 ns track resolution (TRD)
+
+      //    Printf("intLT (before doing anything): length = %f, time (Pion) = %f", intLT.getL(), intLT.getTOF(o2::track::PID::Pion));
+      float minTrkTime = (trackWork.second.getTimeStamp() - mSigmaTimeCut * trackWork.second.getTimeStampError()) * 1.E6 + timeShift;         // minimum time in ps
+      float maxTrkTime = (trackWork.second.getTimeStamp() + mSigmaTimeCut * trackWork.second.getTimeStampError()) * 1.E6 + timeShift + 100E3; // maximum time in ps + 100 ns for slow tracks (beta->0.2)
+      const float sqrt12inv = 1. / sqrt(12.);
+      float resT = (trackWork.second.getTimeStampError() + 100E-3) * sqrt12inv;
+      int istep = 1;                                                                                                                          // number of steps
+      float step = 1.0;                                                                                                                       // step size in cm
+
+      //uncomment for local debug
       /*
-      Printf("posFloat[0] = %f, posFloat[1] = %f, posFloat[2] = %f", posFloat[0], posFloat[1], posFloat[2]);
-      Printf("radius xy = %f", TMath::Sqrt(posFloat[0]*posFloat[0] + posFloat[1]*posFloat[1]));
-      Printf("radius xyz = %f", TMath::Sqrt(posFloat[0]*posFloat[0] + posFloat[1]*posFloat[1] + posFloat[2]*posFloat[2]));
+      //trefTrk.getXYZGlo(posBeforeProp);
+      //float posBeforeProp[3] = {trefTrk.getX(), trefTrk.getY(), trefTrk.getZ()}; // in local ref system
+      //printf("Global coordinates: posBeforeProp[0] = %f, posBeforeProp[1] = %f, posBeforeProp[2] = %f\n", posBeforeProp[0], posBeforeProp[1], posBeforeProp[2]);
+      //Printf("Radius xy = %f", TMath::Sqrt(posBeforeProp[0]*posBeforeProp[0] + posBeforeProp[1]*posBeforeProp[1]));
+      //Printf("Radius xyz = %f", TMath::Sqrt(posBeforeProp[0]*posBeforeProp[0] + posBeforeProp[1]*posBeforeProp[1] + posBeforeProp[2]*posBeforeProp[2]));
       */
 
-      for (int idet = 0; idet < 5; idet++) {
-        detIdTemp[idet] = -1;
-      }
-
-      Geo::getPadDxDyDz(posFloat, detIdTemp, deltaPosTemp, sec);
-
-      reachedPoint += step;
-
-      if (detIdTemp[2] == -1) {
-        continue;
-      }
-
-      // uncomment below only for local debug; this will produce A LOT of output - one print per propagation step
-      //Printf("detIdTemp[0] = %d, detIdTemp[1] = %d, detIdTemp[2] = %d, detIdTemp[3] = %d, detIdTemp[4] = %d", detIdTemp[0], detIdTemp[1], detIdTemp[2], detIdTemp[3], detIdTemp[4]);
-      // if (nStripsCrossedInPropagation == 0) { // print in case you have a useful propagation
-      //   LOG(debug) << "*********** We have crossed a strip during propagation!*********";
-      //   LOG(debug) << "Global coordinates: pos[0] = " << pos[0] << ", pos[1] = " << pos[1] << ", pos[2] = " << pos[2];
-      //   LOG(debug) << "detIdTemp[0] = " << detIdTemp[0] << ", detIdTemp[1] = " << detIdTemp[1] << ", detIdTemp[2] = " << detIdTemp[2] << ", detIdTemp[3] = " << detIdTemp[3] << ", detIdTemp[4] = " << detIdTemp[4];
-      //   LOG(debug) << "deltaPosTemp[0] = " << deltaPosTemp[0] << ", deltaPosTemp[1] = " << deltaPosTemp[1] << " deltaPosTemp[2] = " << deltaPosTemp[2];
-      // } else {
-      //   LOG(debug) << "*********** We have NOT crossed a strip during propagation!*********";
-      //   LOG(debug) << "Global coordinates: pos[0] = " << pos[0] << ", pos[1] = " << pos[1] << ", pos[2] = " << pos[2];
-      //   LOG(debug) << "detIdTemp[0] = " << detIdTemp[0] << ", detIdTemp[1] = " << detIdTemp[1] << ", detIdTemp[2] = " << detIdTemp[2] << ", detIdTemp[3] = " << detIdTemp[3] << ", detIdTemp[4] = " << detIdTemp[4];
-      //   LOG(debug) << "deltaPosTemp[0] = " << deltaPosTemp[0] << ", deltaPosTemp[1] = " << deltaPosTemp[1] << " deltaPosTemp[2] = " << deltaPosTemp[2];
-      // }
-
-      // check if after the propagation we are in a TOF strip
-      // we ended in a TOF strip
-      // LOG(debug) << "nStripsCrossedInPropagation = " << nStripsCrossedInPropagation << ", detId[nStripsCrossedInPropagation][0] = " << detId[nStripsCrossedInPropagation][0] << ", detIdTemp[0] = " << detIdTemp[0] << ", detId[nStripsCrossedInPropagation][1] = " << detId[nStripsCrossedInPropagation][1] << ", detIdTemp[1] = " << detIdTemp[1] << ", detId[nStripsCrossedInPropagation][2] = " << detId[nStripsCrossedInPropagation][2] << ", detIdTemp[2] = " << detIdTemp[2];
-
-      if (nStripsCrossedInPropagation == 0 ||                                                                                                                                                                                            // we are crossing a strip for the first time...
-          (nStripsCrossedInPropagation >= 1 && (detId[nStripsCrossedInPropagation - 1][0] != detIdTemp[0] || detId[nStripsCrossedInPropagation - 1][1] != detIdTemp[1] || detId[nStripsCrossedInPropagation - 1][2] != detIdTemp[2]))) { // ...or we are crossing a new strip
-        if (nStripsCrossedInPropagation == 0) {
-          LOG(debug) << "We cross a strip for the first time";
-        }
-        if (nStripsCrossedInPropagation == 2) {
-          break; // we have already matched 2 strips, we cannot match more
-        }
-        nStripsCrossedInPropagation++;
-      }
-      //Printf("nStepsInsideSameStrip[nStripsCrossedInPropagation-1] = %d", nStepsInsideSameStrip[nStripsCrossedInPropagation - 1]);
-      if (nStepsInsideSameStrip[nStripsCrossedInPropagation - 1] == 0) {
-        detId[nStripsCrossedInPropagation - 1][0] = detIdTemp[0];
-        detId[nStripsCrossedInPropagation - 1][1] = detIdTemp[1];
-        detId[nStripsCrossedInPropagation - 1][2] = detIdTemp[2];
-        detId[nStripsCrossedInPropagation - 1][3] = detIdTemp[3];
-        detId[nStripsCrossedInPropagation - 1][4] = detIdTemp[4];
-        deltaPos[nStripsCrossedInPropagation - 1][0] = deltaPosTemp[0];
-        deltaPos[nStripsCrossedInPropagation - 1][1] = deltaPosTemp[1];
-        deltaPos[nStripsCrossedInPropagation - 1][2] = deltaPosTemp[2];
-        trkLTInt[nStripsCrossedInPropagation - 1] = intLT;
-        //          Printf("intLT (after matching to strip %d): length = %f, time (Pion) = %f", nStripsCrossedInPropagation - 1, trkLTInt[nStripsCrossedInPropagation - 1].getL(), trkLTInt[nStripsCrossedInPropagation - 1].getTOF(o2::track::PID::Pion));
-        nStepsInsideSameStrip[nStripsCrossedInPropagation - 1]++;
-      } else { // a further propagation step in the same strip -> update info (we sum up on all matching with strip - we will divide for the number of steps a bit below)
-        // N.B. the integrated length and time are taken (at least for now) from the first time we crossed the strip, so here we do nothing with those
-        deltaPos[nStripsCrossedInPropagation - 1][0] += deltaPosTemp[0] + (detIdTemp[4] - detId[nStripsCrossedInPropagation - 1][4]) * Geo::XPAD; // residual in x
-        deltaPos[nStripsCrossedInPropagation - 1][1] += deltaPosTemp[1];                                                                          // residual in y
-        deltaPos[nStripsCrossedInPropagation - 1][2] += deltaPosTemp[2] + (detIdTemp[3] - detId[nStripsCrossedInPropagation - 1][3]) * Geo::ZPAD; // residual in z
-        nStepsInsideSameStrip[nStripsCrossedInPropagation - 1]++;
-      }
-    }
-
-    for (Int_t imatch = 0; imatch < nStripsCrossedInPropagation; imatch++) {
-      // we take as residual the average of the residuals along the propagation in the same strip
-      deltaPos[imatch][0] /= nStepsInsideSameStrip[imatch];
-      deltaPos[imatch][1] /= nStepsInsideSameStrip[imatch];
-      deltaPos[imatch][2] /= nStepsInsideSameStrip[imatch];
-    }
-
-    if (nStripsCrossedInPropagation == 0) {
-      continue; // the track never hit a TOF strip during the propagation
-    }
-    bool foundCluster = false;
-    for (auto itof = itof0; itof < nTOFCls; itof++) {
-      //      printf("itof = %d\n", itof);
-      auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
-      // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
-      //Printf("trefTOF.getTime() = %f, maxTrkTime = %f, minTrkTime = %f", trefTOF.getTime(), maxTrkTime, minTrkTime);
-
-      if (trefTOF.getTime() < minTrkTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-        //Printf("In trefTOF.getTime() < minTrkTime");
-        itof0 = itof + 1; // but for the next track that we will check, we will ignore this cluster (the time is anyway too small)
-        continue;
-      }
-      if (trefTOF.getTime() > maxTrkTime) { // no more TOF clusters can be matched to this track
-        break;
-      }
-
-      int mainChannel = trefTOF.getMainContributingChannel();
-      int indices[5];
-      Geo::getVolumeIndices(mainChannel, indices);
-
-      // compute fine correction using cluster position instead of pad center
-      // this because in case of multiple-hit cluster position is averaged on all pads contributing to the cluster (then error position matrix can be used for Chi2 if nedeed)
-      int ndigits = 1;
-      float posCorr[3] = {0, 0, 0};
-
-      if (trefTOF.isBitSet(Cluster::kLeft)) {
-        posCorr[0] += Geo::XPAD, ndigits++;
-      }
-      if (trefTOF.isBitSet(Cluster::kUpLeft)) {
-        posCorr[0] += Geo::XPAD, posCorr[2] -= Geo::ZPAD, ndigits++;
-      }
-      if (trefTOF.isBitSet(Cluster::kDownLeft)) {
-        posCorr[0] += Geo::XPAD, posCorr[2] += Geo::ZPAD, ndigits++;
-      }
-      if (trefTOF.isBitSet(Cluster::kUp)) {
-        posCorr[2] -= Geo::ZPAD, ndigits++;
-      }
-      if (trefTOF.isBitSet(Cluster::kDown)) {
-        posCorr[2] += Geo::ZPAD, ndigits++;
-      }
-      if (trefTOF.isBitSet(Cluster::kRight)) {
-        posCorr[0] -= Geo::XPAD, ndigits++;
-      }
-      if (trefTOF.isBitSet(Cluster::kUpRight)) {
-        posCorr[0] -= Geo::XPAD, posCorr[2] -= Geo::ZPAD, ndigits++;
-      }
-      if (trefTOF.isBitSet(Cluster::kDownRight)) {
-        posCorr[0] -= Geo::XPAD, posCorr[2] += Geo::ZPAD, ndigits++;
-      }
-
-      float ndifInv = 1. / ndigits;
-      if (ndigits > 1) {
-        posCorr[0] *= ndifInv;
-        posCorr[1] *= ndifInv;
-        posCorr[2] *= ndifInv;
-      }
-
-      int trackIdTOF;
-      int eventIdTOF;
-      int sourceIdTOF;
-      for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation; iPropagation++) {
-        int bct0 = int((mTOFClusWork[cacheTOF[itof]].getTime() - trkLTInt[iPropagation].getTOF(0) + 5000) * Geo::BC_TIME_INPS_INV); // bc taken assuming speed of light (el) and 5 ns of margin
-        if (bct0 < 0) {                                                                                                             // if negative time (it can happen at the beginng of the TF int was truncated per excess... adjusting)
-          bct0--;
-        }
-        float tof = mTOFClusWork[cacheTOF[itof]].getTime() - bct0 * Geo::BC_TIME_INPS;
-        if (tof - trkLTInt[iPropagation].getTOF(6) > 2000) { // reject tracks slower than triton
-          continue;
-        }
-        float cosangle = TMath::Cos(Geo::getAngles(indices[1], indices[2]) * TMath::DegToRad());
-        const float errXinvMin = 1. / (mMatchParams->maxResX * mMatchParams->maxResX);
-        const float errZinvMin = 1. / (mMatchParams->maxResZ * mMatchParams->maxResZ);
-        float errXinv2 = 1. / (trefTrk.getSigmaY2());
-        float errZinv2 = 1. / (trefTrk.getSigmaZ2() * cosangle); // should be valid only at eta=0
-
-        if (errXinv2 < errXinvMin) {
-          errXinv2 = errXinvMin;
-        }
-        if (errZinv2 < errZinvMin) {
-          errZinv2 = errZinvMin;
-        }
-
-        LOG(debug) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
-        LOG(debug) << "Propagated Track [" << itrk << "]: detId[" << iPropagation << "]  = " << detId[iPropagation][0] << ", " << detId[iPropagation][1] << ", " << detId[iPropagation][2] << ", " << detId[iPropagation][3] << ", " << detId[iPropagation][4];
-        float resX = deltaPos[iPropagation][0] - (indices[4] - detId[iPropagation][4]) * Geo::XPAD + posCorr[0]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-        float resZ = deltaPos[iPropagation][2] - (indices[3] - detId[iPropagation][3]) * Geo::ZPAD + posCorr[2]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-        float resXor = resX;
-        float resZor = resZ;
-        float res = TMath::Sqrt(resX * resX + resZ * resZ);
-
-        if (resX < -1.25) { // distance from closest border
-          resX += 1.25;
-        } else if (resX > 1.25) {
-          resX -= 1.25;
-        } else {
-          resX = 1E-3 / (pt + 1E-3); // high-pt should be favoured
-        }
-
-        if (resZ < -1.75) { // distance from closest border
-          resZ += 1.75;
-        } else if (resZ > 1.75) {
-          resZ -= 1.75;
-        } else {
-          resZ = 1E-3 / (pt + 1E-3); // high-pt should be favoured
-        }
-
-        LOG(debug) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
-        if (indices[0] != detId[iPropagation][0]) {
-          continue;
-        }
-        if (indices[1] != detId[iPropagation][1]) {
-          continue;
-        }
-        if (indices[2] != detId[iPropagation][2]) {
-          continue;
-        }
-        float chi2 = 0.5 * (resX * resX * errXinv2 + resZ * resZ * errZinv2); // TODO: take into account also the time!
-
-        if (res < mSpaceTolerance && chi2 < mMatchParams->maxChi2) { // matching ok!
-          LOG(debug) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[type][sec][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
-          foundCluster = true;
-          // set event indexes (to be checked)
-          int eventIndexTOFCluster = mTOFClusSectIndexCache[indices[0]][itof];
-          mMatchedTracksPairsSec[sec].emplace_back(cacheTrk[itrk], eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[iPropagation], mTrackGid[sec][type][cacheTrk[itrk]], type, (trefTOF.getTime() - (minTrkTime + maxTrkTime - 100E3) * 0.5) * 1E-6, trefTOF.getZ(), resXor, resZor); // subracting 100 ns to max track which was artificially added
-          mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setPt(pt);
-          mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setResX(sqrt(1. / errXinv2));
-          mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setResZ(sqrt(1. / errZinv2));
-          mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setResT(resT);
-          mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setVz(0.0); // not needed for constrained tracks
-          mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setChannel(mainChannel);
+      // initializing
+      for (int ii = 0; ii < 2; ii++) {
+        for (int iii = 0; iii < 5; iii++) {
+          detId[ii][iii] = -1;
         }
       }
-    }
-  }
-  return;
-}
-//______________________________________________
-void MatchTOF::doMatchingForTPC(int sec)
-{
-  float vdriftInBC = Geo::BC_TIME_INPS * 1E-6 * mTPCVDrift;
-
-  int bc_grouping = 40;
-  int bc_grouping_tolerance = bc_grouping + mTimeTolerance / 25;
-  int bc_grouping_half = (bc_grouping + 1) / 2;
-  double BCgranularity = Geo::BC_TIME_INPS * bc_grouping;
-
-  ///< do the real matching per sector
-  auto& cacheTOF = mTOFClusSectIndexCache[sec];                 // array of cached TOF cluster indices for this sector; reminder: they are ordered in time!
-  auto& cacheTrk = mTracksSectIndexCache[trkType::UNCONS][sec]; // array of cached tracks indices for this sector; reminder: they are ordered in time!
-  int nTracks = cacheTrk.size(), nTOFCls = cacheTOF.size();
-  LOG(debug) << "Matching sector " << sec << ": number of tracks: " << nTracks << ", number of TOF clusters: " << nTOFCls;
-  if (!nTracks || !nTOFCls) {
-    return;
-  }
-  int itof0 = 0; // starting index in TOF clusters for matching of the track
-  float deltaPosTemp[3];
-  std::array<float, 3> pos;
-  std::array<float, 3> posBeforeProp;
-  float posFloat[3];
-
-  // prematching for TPC only tracks (identify BC candidate to correct z for TPC track accordingly to v_drift)
-
-  std::vector<unsigned long> BCcand;
-
-  std::vector<int> nStripsCrossedInPropagation;
-  std::vector<std::array<std::array<int, 5>, 2>> detId;
-  std::vector<std::array<o2::track::TrackLTIntegral, 2>> trkLTInt;
-  std::vector<std::array<std::array<float, 3>, 2>> deltaPos;
-  std::vector<std::array<int, 2>> nStepsInsideSameStrip;
-  std::vector<std::array<float, 2>> Zshift;
-
-  LOG(debug) << "Trying to match %d tracks" << cacheTrk.size();
-
-  for (int itrk = 0; itrk < cacheTrk.size(); itrk++) {
-    auto& trackWork = mTracksWork[sec][trkType::UNCONS][cacheTrk[itrk]];
-    auto& trefTrk = trackWork.first;
-    float pt = trefTrk.getPt();
-    auto& intLT = mLTinfos[sec][trkType::UNCONS][cacheTrk[itrk]];
-
-    float timeShift = intLT.getL() * 33.35641; // integrated time for 0.75 beta particles in ps, to take into account the t.o.f. delay with respect the interaction BC
-                                               // using beta=0.75 to cover beta range [0.59 , 1.04] also for a 8 m track lenght with a 10 ns track resolution (TRD)
-
-    BCcand.clear();
-    nStripsCrossedInPropagation.clear();
-
-    int side = mSideTPC[sec][cacheTrk[itrk]];
-    // look at BC candidates for the track
-    double tpctime = trackWork.second.getTimeStamp();                                                                // in mus
-    double minTrkTime = (tpctime - trackWork.second.getTimeStampError()) * 1.E6 + timeShift;                         // minimum time in ps
-    minTrkTime = int(minTrkTime / BCgranularity) * BCgranularity;                                                    // align min to a BC
-    double maxTrkTime = (tpctime + mExtraTPCFwdTime[sec][cacheTrk[itrk]]) * 1.E6 + timeShift;                        // maximum time in ps
-    const float sqrt12inv = 1. / sqrt(12.);
-    float resT = (maxTrkTime - minTrkTime) * sqrt12inv;
-
-    if (mIsCosmics) {
-      for (double tBC = minTrkTime; tBC < maxTrkTime; tBC += BCgranularity) {
-        unsigned long ibc = (unsigned long)(tBC * Geo::BC_TIME_INPS_INV);
-        BCcand.emplace_back(ibc);
-        nStripsCrossedInPropagation.emplace_back(0);
-      }
-    }
-
-    int itofMax = nTOFCls;
-
-    for (auto itof = itof0; itof < nTOFCls; itof++) {
-      auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
 
-      if (trefTOF.getTime() < minTrkTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-        itof0 = itof + 1;
-        continue;
-      }
+      int detIdTemp[5] = {-1, -1, -1, -1, -1}; // TOF detector id at the current propagation point
 
-      if (trefTOF.getTime() > maxTrkTime) { // this cluster has a time that is too large for the current track, close loop
-        itofMax = itof;
-        break;
-      }
-
-      if ((trefTOF.getZ() * side < 0) && ((side > 0) != (trackWork.first.getTgl() > 0))) {
-        continue;
-      }
+      double reachedPoint = mXRef + istep * step;
 
-      unsigned long bc = (unsigned long)(trefTOF.getTime() * Geo::BC_TIME_INPS_INV);
+      while (propagateToRefX(trefTrk, reachedPoint, step, intLT) && nStripsCrossedInPropagation <= 2 && reachedPoint < Geo::RMAX) {
+        // while (o2::base::Propagator::Instance()->PropagateToXBxByBz(trefTrk,  mXRef + istep * step, MAXSNP, step, 1, &intLT) && nStripsCrossedInPropagation <= 2 && mXRef + istep * step < Geo::RMAX) {
 
-      bc = (bc / bc_grouping_half) * bc_grouping_half;
-
-      bool isalreadyin = false;
-
-      for (int k = 0; k < BCcand.size(); k++) {
-        if (bc == BCcand[k]) {
-          isalreadyin = true;
+        trefTrk.getXYZGlo(pos);
+        for (int ii = 0; ii < 3; ii++) { // we need to change the type...
+          posFloat[ii] = pos[ii];
         }
-      }
-
-      if (!isalreadyin) {
-        BCcand.emplace_back(bc);
-        nStripsCrossedInPropagation.emplace_back(0);
-      }
-    }
 
-    detId.clear();
-    detId.reserve(BCcand.size());
-    trkLTInt.clear();
-    trkLTInt.reserve(BCcand.size());
-    Zshift.clear();
-    Zshift.reserve(BCcand.size());
-    deltaPos.clear();
-    deltaPos.reserve(BCcand.size());
-    nStepsInsideSameStrip.clear();
-    nStepsInsideSameStrip.reserve(BCcand.size());
-
-    //    Printf("intLT (before doing anything): length = %f, time (Pion) = %f", intLT.getL(), intLT.getTOF(o2::track::PID::Pion));
-    int istep = 1;    // number of steps
-    float step = 1.0; // step size in cm
-
-    //uncomment for local debug
-    /*
-    //trefTrk.getXYZGlo(posBeforeProp);
-    //float posBeforeProp[3] = {trefTrk.getX(), trefTrk.getY(), trefTrk.getZ()}; // in local ref system
-    //printf("Global coordinates: posBeforeProp[0] = %f, posBeforeProp[1] = %f, posBeforeProp[2] = %f\n", posBeforeProp[0], posBeforeProp[1], posBeforeProp[2]);
-    //Printf("Radius xy = %f", TMath::Sqrt(posBeforeProp[0]*posBeforeProp[0] + posBeforeProp[1]*posBeforeProp[1]));
-    //Printf("Radius xyz = %f", TMath::Sqrt(posBeforeProp[0]*posBeforeProp[0] + posBeforeProp[1]*posBeforeProp[1] + posBeforeProp[2]*posBeforeProp[2]));
-    */
-
-    int detIdTemp[5] = {-1, -1, -1, -1, -1}; // TOF detector id at the current propagation point
-
-    double reachedPoint = mXRef + istep * step;
-
-    // initializing
-    for (int ibc = 0; ibc < BCcand.size(); ibc++) {
-      for (int ii = 0; ii < 2; ii++) {
-        nStepsInsideSameStrip[ibc][ii] = 0;
-        for (int iii = 0; iii < 5; iii++) {
-          detId[ibc][ii][iii] = -1;
-        }
-      }
-    }
-    while (propagateToRefX(trefTrk, reachedPoint, step, intLT) && reachedPoint < Geo::RMAX) {
-      // while (o2::base::Propagator::Instance()->PropagateToXBxByBz(trefTrk,  mXRef + istep * step, MAXSNP, step, 1, &intLT) && nStripsCrossedInPropagation <= 2 && mXRef + istep * step < Geo::RMAX) {
-
-      trefTrk.getXYZGlo(pos);
-      for (int ii = 0; ii < 3; ii++) { // we need to change the type...
-        posFloat[ii] = pos[ii];
-      }
-
-      // uncomment below only for local debug; this will produce A LOT of output - one print per propagation step
-      /*
+        // uncomment below only for local debug; this will produce A LOT of output - one print per propagation step
+        /*
         Printf("posFloat[0] = %f, posFloat[1] = %f, posFloat[2] = %f", posFloat[0], posFloat[1], posFloat[2]);
         Printf("radius xy = %f", TMath::Sqrt(posFloat[0]*posFloat[0] + posFloat[1]*posFloat[1]));
         Printf("radius xyz = %f", TMath::Sqrt(posFloat[0]*posFloat[0] + posFloat[1]*posFloat[1] + posFloat[2]*posFloat[2]));
-      */
-
-      reachedPoint += step;
+        */
 
-      // check if you fall in a strip
-      for (int ibc = 0; ibc < BCcand.size(); ibc++) {
         for (int idet = 0; idet < 5; idet++) {
           detIdTemp[idet] = -1;
         }
 
-        if (side > 0) {
-          posFloat[2] = pos[2] - mTPCVDrift * (trackWork.second.getTimeStamp() - BCcand[ibc] * Geo::BC_TIME_INPS * 1E-6);
-        } else if (side < 0) {
-          posFloat[2] = pos[2] + mTPCVDrift * (trackWork.second.getTimeStamp() - BCcand[ibc] * Geo::BC_TIME_INPS * 1E-6);
-        } else {
-          posFloat[2] = pos[2];
-        }
-
-        float ZshiftCurrent = posFloat[2] - pos[2];
-
         Geo::getPadDxDyDz(posFloat, detIdTemp, deltaPosTemp, sec);
 
+        reachedPoint += step;
+
         if (detIdTemp[2] == -1) {
           continue;
         }
 
-        if (nStripsCrossedInPropagation[ibc] == 0 ||                                                                                                                                                                                                                          // we are crossing a strip for the first time...
-            (nStripsCrossedInPropagation[ibc] >= 1 && (detId[ibc][nStripsCrossedInPropagation[ibc] - 1][0] != detIdTemp[0] || detId[ibc][nStripsCrossedInPropagation[ibc] - 1][1] != detIdTemp[1] || detId[ibc][nStripsCrossedInPropagation[ibc] - 1][2] != detIdTemp[2]))) { // ...or we are crossing a new strip
-          if (nStripsCrossedInPropagation[ibc] == 0) {
+        // uncomment below only for local debug; this will produce A LOT of output - one print per propagation step
+        //Printf("detIdTemp[0] = %d, detIdTemp[1] = %d, detIdTemp[2] = %d, detIdTemp[3] = %d, detIdTemp[4] = %d", detIdTemp[0], detIdTemp[1], detIdTemp[2], detIdTemp[3], detIdTemp[4]);
+        // if (nStripsCrossedInPropagation == 0) { // print in case you have a useful propagation
+        //   LOG(debug) << "*********** We have crossed a strip during propagation!*********";
+        //   LOG(debug) << "Global coordinates: pos[0] = " << pos[0] << ", pos[1] = " << pos[1] << ", pos[2] = " << pos[2];
+        //   LOG(debug) << "detIdTemp[0] = " << detIdTemp[0] << ", detIdTemp[1] = " << detIdTemp[1] << ", detIdTemp[2] = " << detIdTemp[2] << ", detIdTemp[3] = " << detIdTemp[3] << ", detIdTemp[4] = " << detIdTemp[4];
+        //   LOG(debug) << "deltaPosTemp[0] = " << deltaPosTemp[0] << ", deltaPosTemp[1] = " << deltaPosTemp[1] << " deltaPosTemp[2] = " << deltaPosTemp[2];
+        // } else {
+        //   LOG(debug) << "*********** We have NOT crossed a strip during propagation!*********";
+        //   LOG(debug) << "Global coordinates: pos[0] = " << pos[0] << ", pos[1] = " << pos[1] << ", pos[2] = " << pos[2];
+        //   LOG(debug) << "detIdTemp[0] = " << detIdTemp[0] << ", detIdTemp[1] = " << detIdTemp[1] << ", detIdTemp[2] = " << detIdTemp[2] << ", detIdTemp[3] = " << detIdTemp[3] << ", detIdTemp[4] = " << detIdTemp[4];
+        //   LOG(debug) << "deltaPosTemp[0] = " << deltaPosTemp[0] << ", deltaPosTemp[1] = " << deltaPosTemp[1] << " deltaPosTemp[2] = " << deltaPosTemp[2];
+        // }
+
+        // check if after the propagation we are in a TOF strip
+        // we ended in a TOF strip
+        // LOG(debug) << "nStripsCrossedInPropagation = " << nStripsCrossedInPropagation << ", detId[nStripsCrossedInPropagation][0] = " << detId[nStripsCrossedInPropagation][0] << ", detIdTemp[0] = " << detIdTemp[0] << ", detId[nStripsCrossedInPropagation][1] = " << detId[nStripsCrossedInPropagation][1] << ", detIdTemp[1] = " << detIdTemp[1] << ", detId[nStripsCrossedInPropagation][2] = " << detId[nStripsCrossedInPropagation][2] << ", detIdTemp[2] = " << detIdTemp[2];
+
+        if (nStripsCrossedInPropagation == 0 ||                                                                                                                                                                                            // we are crossing a strip for the first time...
+            (nStripsCrossedInPropagation >= 1 && (detId[nStripsCrossedInPropagation - 1][0] != detIdTemp[0] || detId[nStripsCrossedInPropagation - 1][1] != detIdTemp[1] || detId[nStripsCrossedInPropagation - 1][2] != detIdTemp[2]))) { // ...or we are crossing a new strip
+          if (nStripsCrossedInPropagation == 0) {
             LOG(debug) << "We cross a strip for the first time";
           }
-          if (nStripsCrossedInPropagation[ibc] == 2) {
-            continue; // we have already matched 2 strips, we cannot match more
+          if (nStripsCrossedInPropagation == 2) {
+            break; // we have already matched 2 strips, we cannot match more
           }
-          nStripsCrossedInPropagation[ibc]++;
+          nStripsCrossedInPropagation++;
         }
-
         //Printf("nStepsInsideSameStrip[nStripsCrossedInPropagation-1] = %d", nStepsInsideSameStrip[nStripsCrossedInPropagation - 1]);
-        if (nStepsInsideSameStrip[ibc][nStripsCrossedInPropagation[ibc] - 1] == 0) {
-          detId[ibc][nStripsCrossedInPropagation[ibc] - 1][0] = detIdTemp[0];
-          detId[ibc][nStripsCrossedInPropagation[ibc] - 1][1] = detIdTemp[1];
-          detId[ibc][nStripsCrossedInPropagation[ibc] - 1][2] = detIdTemp[2];
-          detId[ibc][nStripsCrossedInPropagation[ibc] - 1][3] = detIdTemp[3];
-          detId[ibc][nStripsCrossedInPropagation[ibc] - 1][4] = detIdTemp[4];
-          deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][0] = deltaPosTemp[0];
-          deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][1] = deltaPosTemp[1];
-          deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][2] = deltaPosTemp[2];
-
-          trkLTInt[ibc][nStripsCrossedInPropagation[ibc] - 1] = intLT;
-          Zshift[ibc][nStripsCrossedInPropagation[ibc] - 1] = ZshiftCurrent;
+        if (nStepsInsideSameStrip[nStripsCrossedInPropagation - 1] == 0) {
+          detId[nStripsCrossedInPropagation - 1][0] = detIdTemp[0];
+          detId[nStripsCrossedInPropagation - 1][1] = detIdTemp[1];
+          detId[nStripsCrossedInPropagation - 1][2] = detIdTemp[2];
+          detId[nStripsCrossedInPropagation - 1][3] = detIdTemp[3];
+          detId[nStripsCrossedInPropagation - 1][4] = detIdTemp[4];
+          deltaPos[nStripsCrossedInPropagation - 1][0] = deltaPosTemp[0];
+          deltaPos[nStripsCrossedInPropagation - 1][1] = deltaPosTemp[1];
+          deltaPos[nStripsCrossedInPropagation - 1][2] = deltaPosTemp[2];
+          trkLTInt[nStripsCrossedInPropagation - 1] = intLT;
           //          Printf("intLT (after matching to strip %d): length = %f, time (Pion) = %f", nStripsCrossedInPropagation - 1, trkLTInt[nStripsCrossedInPropagation - 1].getL(), trkLTInt[nStripsCrossedInPropagation - 1].getTOF(o2::track::PID::Pion));
-          nStepsInsideSameStrip[ibc][nStripsCrossedInPropagation[ibc] - 1]++;
+          nStepsInsideSameStrip[nStripsCrossedInPropagation - 1]++;
         } else { // a further propagation step in the same strip -> update info (we sum up on all matching with strip - we will divide for the number of steps a bit below)
           // N.B. the integrated length and time are taken (at least for now) from the first time we crossed the strip, so here we do nothing with those
-          deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][0] += deltaPosTemp[0] + (detIdTemp[4] - detId[ibc][nStripsCrossedInPropagation[ibc] - 1][4]) * Geo::XPAD; // residual in x
-          deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][1] += deltaPosTemp[1];                                                                                    // residual in y
-          deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][2] += deltaPosTemp[2] + (detIdTemp[3] - detId[ibc][nStripsCrossedInPropagation[ibc] - 1][3]) * Geo::ZPAD; // residual in z
-          nStepsInsideSameStrip[ibc][nStripsCrossedInPropagation[ibc] - 1]++;
+          deltaPos[nStripsCrossedInPropagation - 1][0] += deltaPosTemp[0] + (detIdTemp[4] - detId[nStripsCrossedInPropagation - 1][4]) * Geo::XPAD; // residual in x
+          deltaPos[nStripsCrossedInPropagation - 1][1] += deltaPosTemp[1];                                                                          // residual in y
+          deltaPos[nStripsCrossedInPropagation - 1][2] += deltaPosTemp[2] + (detIdTemp[3] - detId[nStripsCrossedInPropagation - 1][3]) * Geo::ZPAD; // residual in z
+          nStepsInsideSameStrip[nStripsCrossedInPropagation - 1]++;
         }
       }
-    }
-    for (int ibc = 0; ibc < BCcand.size(); ibc++) {
-      float minTime = (BCcand[ibc] - bc_grouping_tolerance) * Geo::BC_TIME_INPS;
-      float maxTime = (BCcand[ibc] + bc_grouping_tolerance) * Geo::BC_TIME_INPS;
-      for (Int_t imatch = 0; imatch < nStripsCrossedInPropagation[ibc]; imatch++) {
+
+      for (Int_t imatch = 0; imatch < nStripsCrossedInPropagation; imatch++) {
         // we take as residual the average of the residuals along the propagation in the same strip
-        deltaPos[ibc][imatch][0] /= nStepsInsideSameStrip[ibc][imatch];
-        deltaPos[ibc][imatch][1] /= nStepsInsideSameStrip[ibc][imatch];
-        deltaPos[ibc][imatch][2] /= nStepsInsideSameStrip[ibc][imatch];
+        deltaPos[imatch][0] /= nStepsInsideSameStrip[imatch];
+        deltaPos[imatch][1] /= nStepsInsideSameStrip[imatch];
+        deltaPos[imatch][2] /= nStepsInsideSameStrip[imatch];
       }
 
-      if (nStripsCrossedInPropagation[ibc] == 0) {
+      if (nStripsCrossedInPropagation == 0) {
         continue; // the track never hit a TOF strip during the propagation
       }
-
-      bool foundCluster = false;
-      for (auto itof = itof0; itof < itofMax; itof++) {
-        //      printf("itof = %d\n", itof);
-        auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
-        // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
-
-        if (trefTOF.getTime() < minTime) { // this cluster has a time that is too small for the current track, we will get to the next one
+      // take from the strip index the TOF clusters of the crossed strips within the time window of the track
+      candidates.clear();
+      for (int iPropagation = 0; iPropagation < nStripsCrossedInPropagation; iPropagation++) {
+        int strip = Geo::getStripNumberPerSM(detId[iPropagation][1], detId[iPropagation][2]);
+        if (detId[iPropagation][0] != sec || strip < 0) {
           continue;
         }
-        if (trefTOF.getTime() > maxTime) { // no more TOF clusters can be matched to this track
-          break;
-        }
+        addStripCandidates(strip, minTrkTime, maxTrkTime, mTOFClusWork, cacheTOF, mTOFClusStripIndex[sec], mTOFClusStripOffset[sec], candidates);
+      }
+      std::sort(candidates.begin(), candidates.end()); // restore the time ordering of the clusters of the 2 strips
+      bool foundCluster = false;
+      for (auto itof : candidates) {
+        auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
 
         int mainChannel = trefTOF.getMainContributingChannel();
         int indices[5];
         Geo::getVolumeIndices(mainChannel, indices);
 
-        bool isInStrip = false;
-        for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation[ibc]; iPropagation++) {
-          if (detId[ibc][iPropagation][1] == indices[1] && detId[ibc][iPropagation][2] == indices[2]) {
-            isInStrip = true;
-          }
-        }
-
-        if (!isInStrip) {
-          continue;
-        }
-
-        unsigned long bcClus = trefTOF.getTime() * Geo::BC_TIME_INPS_INV;
-
         // compute fine correction using cluster position instead of pad center
         // this because in case of multiple-hit cluster position is averaged on all pads contributing to the cluster (then error position matrix can be used for Chi2 if nedeed)
         int ndigits = 1;
@@ -1396,29 +1058,15 @@ void MatchTOF::doMatchingForTPC(int sec)
         int trackIdTOF;
         int eventIdTOF;
         int sourceIdTOF;
-        for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation[ibc]; iPropagation++) {
-          if (detId[ibc][iPropagation][1] != indices[1] || detId[ibc][iPropagation][2] != indices[2]) {
-            continue;
-          }
-
-          int bct0 = int((mTOFClusWork[cacheTOF[itof]].getTime() - trkLTInt[ibc][iPropagation].getTOF(0) + 5000) * Geo::BC_TIME_INPS_INV); // bc taken assuming speed of light (el) and 5 ns of margin
-          if (bct0 < 0) {                                                                                                                  // if negative time (it can happen at the beginng of the TF int was truncated per excess... adjusting)
+        for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation; iPropagation++) {
+          int bct0 = int((mTOFClusWork[cacheTOF[itof]].getTime() - trkLTInt[iPropagation].getTOF(0) + 5000) * Geo::BC_TIME_INPS_INV); // bc taken assuming speed of light (el) and 5 ns of margin
+          if (bct0 < 0) {                                                                                                             // if negative time (it can happen at the beginng of the TF int was truncated per excess... adjusting)
             bct0--;
           }
           float tof = mTOFClusWork[cacheTOF[itof]].getTime() - bct0 * Geo::BC_TIME_INPS;
-          if (tof - trkLTInt[ibc][iPropagation].getTOF(6) > 2000) { // reject tracks slower than triton
+          if (tof - trkLTInt[iPropagation].getTOF(6) > 2000) { // reject tracks slower than triton
             continue;
           }
-
-          if (mMatchParams->applyPIDcutTPConly) {                                 // for TPC only tracks allowing possibility to apply a PID cut
-            if (std::abs(tof - trkLTInt[ibc][iPropagation].getTOF(2)) < 2000) {   // pion hypotesis
-            } else if (std::abs(tof - trkLTInt[ibc][iPropagation].getTOF(3)) < 2000) { // kaon hypoteis
-            } else if (std::abs(tof - trkLTInt[ibc][iPropagation].getTOF(4)) < 2000) { // proton hypotesis
-            } else {                                                                   // reject matching
-              continue;
-            }
-          }
-
           float cosangle = TMath::Cos(Geo::getAngles(indices[1], indices[2]) * TMath::DegToRad());
           const float errXinvMin = 1. / (mMatchParams->maxResX * mMatchParams->maxResX);
           const float errZinvMin = 1. / (mMatchParams->maxResZ * mMatchParams->maxResZ);
@@ -1433,14 +1081,9 @@ void MatchTOF::doMatchingForTPC(int sec)
           }
 
           LOG(debug) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
-          LOG(debug) << "Propagated Track [" << itrk << "]: detId[" << iPropagation << "]  = " << detId[ibc][iPropagation][0] << ", " << detId[ibc][iPropagation][1] << ", " << detId[ibc][iPropagation][2] << ", " << detId[ibc][iPropagation][3] << ", " << detId[ibc][iPropagation][4];
-          float resX = deltaPos[ibc][iPropagation][0] - (indices[4] - detId[ibc][iPropagation][4]) * Geo::XPAD + posCorr[0]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-          float resZ = deltaPos[ibc][iPropagation][2] - (indices[3] - detId[ibc][iPropagation][3]) * Geo::ZPAD + posCorr[2]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
-          if (BCcand[ibc] > bcClus) {
-            resZ += (BCcand[ibc] - bcClus) * vdriftInBC * side; // add bc correction
-          } else {
-            resZ -= (bcClus - BCcand[ibc]) * vdriftInBC * side;
-          }
+          LOG(debug) << "Propagated Track [" << itrk << "]: detId[" << iPropagation << "]  = " << detId[iPropagation][0] << ", " << detId[iPropagation][1] << ", " << detId[iPropagation][2] << ", " << detId[iPropagation][3] << ", " << detId[iPropagation][4];
+          float resX = deltaPos[iPropagation][0] - (indices[4] - detId[iPropagation][4]) * Geo::XPAD + posCorr[0]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+          float resZ = deltaPos[iPropagation][2] - (indices[3] - detId[iPropagation][3]) * Geo::ZPAD + posCorr[2]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
           float resXor = resX;
           float resZor = resZ;
           float res = TMath::Sqrt(resX * resX + resZ * resZ);
@@ -1461,37 +1104,430 @@ void MatchTOF::doMatchingForTPC(int sec)
             resZ = 1E-3 / (pt + 1E-3); // high-pt should be favoured
           }
 
-          if (indices[0] != detId[ibc][iPropagation][0]) {
+          LOG(debug) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
+          if (indices[0] != detId[iPropagation][0]) {
             continue;
           }
-          if (indices[1] != detId[ibc][iPropagation][1]) {
+          if (indices[1] != detId[iPropagation][1]) {
             continue;
           }
-          if (indices[2] != detId[ibc][iPropagation][2]) {
+          if (indices[2] != detId[iPropagation][2]) {
             continue;
           }
-
-          LOG(debug) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
-          float chi2 = mIsCosmics ? resX : 0.5 * (resX * resX * errXinv2 + resZ * resZ * errZinv2); // TODO: take into account also the time!
+          float chi2 = 0.5 * (resX * resX * errXinv2 + resZ * resZ * errZinv2); // TODO: take into account also the time!
 
           if (res < mSpaceTolerance && chi2 < mMatchParams->maxChi2) { // matching ok!
-            LOG(debug) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[trkType::UNCONS][sec][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
+            LOG(debug) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[type][sec][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
             foundCluster = true;
             // set event indexes (to be checked)
-
             int eventIndexTOFCluster = mTOFClusSectIndexCache[indices[0]][itof];
-            mMatchedTracksPairsSec[sec].emplace_back(cacheTrk[itrk], eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[ibc][iPropagation], mTrackGid[sec][trkType::UNCONS][cacheTrk[itrk]], trkType::UNCONS, trefTOF.getTime() * 1E-6 - tpctime, trefTOF.getZ(), resXor, resZor); // TODO: check if this is correct!
-            mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setPt(pt);
-            mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setResX(sqrt(1. / errXinv2));
-            mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setResZ(sqrt(1. / errZinv2));
-            mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setResT(resT);
-            mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setVz(mVZtpcOnly[sec][itrk] + Zshift[ibc][iPropagation]);
-            mMatchedTracksPairsSec[sec][mMatchedTracksPairsSec[sec].size() - 1].setChannel(mainChannel);
+            matches.emplace_back(cacheTrk[itrk], eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[iPropagation], mTrackGid[sec][type][cacheTrk[itrk]], type, (trefTOF.getTime() - (minTrkTime + maxTrkTime - 100E3) * 0.5) * 1E-6, trefTOF.getZ(), resXor, resZor); // subracting 100 ns to max track which was artificially added
+            matches.back().setPt(pt);
+            matches.back().setResX(sqrt(1. / errXinv2));
+            matches.back().setResZ(sqrt(1. / errZinv2));
+            matches.back().setResT(resT);
+            matches.back().setVz(0.0); // not needed for constrained tracks
+            matches.back().setChannel(mainChannel);
           }
         }
       }
     }
   }
+  for (auto& matches : chunkMatches) {
+    mMatchedTracksPairsSec[sec].insert(mMatchedTracksPairsSec[sec].end(), matches.begin(), matches.end());
+  }
+  return;
+}
+//______________________________________________
+void MatchTOF::doMatchingForTPC(int sec)
+{
+  float vdriftInBC = Geo::BC_TIME_INPS * 1E-6 * mTPCVDrift;
+
+  int bc_grouping = 40;
+  int bc_grouping_tolerance = bc_grouping + mTimeTolerance / 25;
+  int bc_grouping_half = (bc_grouping + 1) / 2;
+  double BCgranularity = Geo::BC_TIME_INPS * bc_grouping;
+
+  ///< do the real matching per sector
+  auto& cacheTOF = mTOFClusSectIndexCache[sec];                 // array of cached TOF cluster indices for this sector; reminder: they are ordered in time!
+  auto& cacheTrk = mTracksSectIndexCache[trkType::UNCONS][sec]; // array of cached tracks indices for this sector; reminder: they are ordered in time!
+  int nTracks = cacheTrk.size(), nTOFCls = cacheTOF.size();
+  LOG(debug) << "Matching sector " << sec << ": number of tracks: " << nTracks << ", number of TOF clusters: " << nTOFCls;
+  if (!nTracks || !nTOFCls) {
+    return;
+  }
+  // as in doMatching, the tracks are processed in chunks of consecutive tracks, each chunk with its own buffer of matches
+  const int nChunks = std::min(nTracks, 8 * mNlanes);
+  std::vector<std::vector<o2::dataformats::MatchInfoTOFReco>> chunkMatches(nChunks);
+  LOG(debug) << "Trying to match " << nTracks << " tracks in " << nChunks << " chunks";
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNlanes)
+#endif
+  for (int ichunk = 0; ichunk < nChunks; ichunk++) {
+    float deltaPosTemp[3];
+    std::array<float, 3> pos;
+    std::array<float, 3> posBeforeProp;
+    float posFloat[3];
+
+    // prematching for TPC only tracks (identify BC candidate to correct z for TPC track accordingly to v_drift)
+
+    std::vector<unsigned long> BCcand;
+
+    std::vector<int> nStripsCrossedInPropagation;
+    std::vector<std::array<std::array<int, 5>, 2>> detId;
+    std::vector<std::array<o2::track::TrackLTIntegral, 2>> trkLTInt;
+    std::vector<std::array<std::array<float, 3>, 2>> deltaPos;
+    std::vector<std::array<int, 2>> nStepsInsideSameStrip;
+    std::vector<std::array<float, 2>> Zshift;
+    std::vector<int> candidates; // positions in cacheTOF of the TOF clusters compatible with the track in strip and time
+    auto& matches = chunkMatches[ichunk];
+    const int itrkMax = int((ichunk + 1) * int64_t(nTracks) / nChunks);
+    for (int itrk = int(ichunk * int64_t(nTracks) / nChunks); itrk < itrkMax; itrk++) {
+      auto& trackWork = mTracksWork[sec][trkType::UNCONS][cacheTrk[itrk]];
+      auto& trefTrk = trackWork.first;
+      float pt = trefTrk.getPt();
+      auto& intLT = mLTinfos[sec][trkType::UNCONS][cacheTrk[itrk]];
+
+      float timeShift = intLT.getL() * 33.35641; // integrated time for 0.75 beta particles in ps, to take into account the t.o.f. delay with respect the interaction BC
+                                                 // using beta=0.75 to cover beta range [0.59 , 1.04] also for a 8 m track lenght with a 10 ns track resolution (TRD)
+
+      BCcand.clear();
+      nStripsCrossedInPropagation.clear();
+
+      int side = mSideTPC[sec][cacheTrk[itrk]];
+      // look at BC candidates for the track
+      double tpctime = trackWork.second.getTimeStamp();                                                                // in mus
+      double minTrkTime = (tpctime - trackWork.second.getTimeStampError()) * 1.E6 + timeShift;                         // minimum time in ps
+      minTrkTime = int(minTrkTime / BCgranularity) * BCgranularity;                                                    // align min to a BC
+      double maxTrkTime = (tpctime + mExtraTPCFwdTime[sec][cacheTrk[itrk]]) * 1.E6 + timeShift;                        // maximum time in ps
+      const float sqrt12inv = 1. / sqrt(12.);
+      float resT = (maxTrkTime - minTrkTime) * sqrt12inv;
+
+      if (mIsCosmics) {
+        for (double tBC = minTrkTime; tBC < maxTrkTime; tBC += BCgranularity) {
+          unsigned long ibc = (unsigned long)(tBC * Geo::BC_TIME_INPS_INV);
+          BCcand.emplace_back(ibc);
+          nStripsCrossedInPropagation.emplace_back(0);
+        }
+      }
+
+      // first TOF cluster which is not too early for the current track
+      int itof0 = std::lower_bound(cacheTOF.begin(), cacheTOF.end(), minTrkTime, [this](int icl, double t) { return mTOFClusWork[icl].getTime() < t; }) - cacheTOF.begin();
+
+      for (auto itof = itof0; itof < nTOFCls; itof++) {
+        auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
+
+        if (trefTOF.getTime() > maxTrkTime) { // this cluster has a time that is too large for the current track, close loop
+          break;
+        }
+
+        if ((trefTOF.getZ() * side < 0) && ((side > 0) != (trackWork.first.getTgl() > 0))) {
+          continue;
+        }
+
+        unsigned long bc = (unsigned long)(trefTOF.getTime() * Geo::BC_TIME_INPS_INV);
+
+        bc = (bc / bc_grouping_half) * bc_grouping_half;
+
+        bool isalreadyin = false;
+
+        for (int k = 0; k < BCcand.size(); k++) {
+          if (bc == BCcand[k]) {
+            isalreadyin = true;
+          }
+        }
+
+        if (!isalreadyin) {
+          BCcand.emplace_back(bc);
+          nStripsCrossedInPropagation.emplace_back(0);
+        }
+      }
+
+      detId.clear();
+      detId.resize(BCcand.size());
+      trkLTInt.clear();
+      trkLTInt.resize(BCcand.size());
+      Zshift.clear();
+      Zshift.resize(BCcand.size());
+      deltaPos.clear();
+      deltaPos.resize(BCcand.size());
+      nStepsInsideSameStrip.clear();
+      nStepsInsideSameStrip.resize(BCcand.size());
+
+      //    Printf("intLT (before doing anything): length = %f, time (Pion) = %f", intLT.getL(), intLT.getTOF(o2::track::PID::Pion));
+      int istep = 1;    // number of steps
+      float step = 1.0; // step size in cm
+
+      //uncomment for local debug
+      /*
+      //trefTrk.getXYZGlo(posBeforeProp);
+      //float posBeforeProp[3] = {trefTrk.getX(), trefTrk.getY(), trefTrk.getZ()}; // in local ref system
+      //printf("Global coordinates: posBeforeProp[0] = %f, posBeforeProp[1] = %f, posBeforeProp[2] = %f\n", posBeforeProp[0], posBeforeProp[1], posBeforeProp[2]);
+      //Printf("Radius xy = %f", TMath::Sqrt(posBeforeProp[0]*posBeforeProp[0] + posBeforeProp[1]*posBeforeProp[1]));
+      //Printf("Radius xyz = %f", TMath::Sqrt(posBeforeProp[0]*posBeforeProp[0] + posBeforeProp[1]*posBeforeProp[1] + posBeforeProp[2]*posBeforeProp[2]));
+      */
+
+      int detIdTemp[5] = {-1, -1, -1, -1, -1}; // TOF detector id at the current propagation point
+
+      double reachedPoint = mXRef + istep * step;
+
+      // initializing
+      for (int ibc = 0; ibc < BCcand.size(); ibc++) {
+        for (int ii = 0; ii < 2; ii++) {
+          nStepsInsideSameStrip[ibc][ii] = 0;
+          for (int iii = 0; iii < 5; iii++) {
+            detId[ibc][ii][iii] = -1;
+          }
+        }
+      }
+      while (propagateToRefX(trefTrk, reachedPoint, step, intLT) && reachedPoint < Geo::RMAX) {
+        // while (o2::base::Propagator::Instance()->PropagateToXBxByBz(trefTrk,  mXRef + istep * step, MAXSNP, step, 1, &intLT) && nStripsCrossedInPropagation <= 2 && mXRef + istep * step < Geo::RMAX) {
+
+        trefTrk.getXYZGlo(pos);
+        for (int ii = 0; ii < 3; ii++) { // we need to change the type...
+          posFloat[ii] = pos[ii];
+        }
+
+        // uncomment below only for local debug; this will produce A LOT of output - one print per propagation step
+        /*
+          Printf("posFloat[0] = %f, posFloat[1] = %f, posFloat[2] = %f", posFloat[0], posFloat[1], posFloat[2]);
+          Printf("radius xy = %f", TMath::Sqrt(posFloat[0]*posFloat[0] + posFloat[1]*posFloat[1]));
+          Printf("radius xyz = %f", TMath::Sqrt(posFloat[0]*posFloat[0] + posFloat[1]*posFloat[1] + posFloat[2]*posFloat[2]));
+        */
+
+        reachedPoint += step;
+
+        // check if you fall in a strip
+        for (int ibc = 0; ibc < BCcand.size(); ibc++) {
+          for (int idet = 0; idet < 5; idet++) {
+            detIdTemp[idet] = -1;
+          }
+
+          if (side > 0) {
+            posFloat[2] = pos[2] - mTPCVDrift * (trackWork.second.getTimeStamp() - BCcand[ibc] * Geo::BC_TIME_INPS * 1E-6);
+          } else if (side < 0) {
+            posFloat[2] = pos[2] + mTPCVDrift * (trackWork.second.getTimeStamp() - BCcand[ibc] * Geo::BC_TIME_INPS * 1E-6);
+          } else {
+            posFloat[2] = pos[2];
+          }
+
+          float ZshiftCurrent = posFloat[2] - pos[2];
+
+          Geo::getPadDxDyDz(posFloat, detIdTemp, deltaPosTemp, sec);
+
+          if (detIdTemp[2] == -1) {
+            continue;
+          }
+
+          if (nStripsCrossedInPropagation[ibc] == 0 ||                                                                                                                                                                                                                          // we are crossing a strip for the first time...
+              (nStripsCrossedInPropagation[ibc] >= 1 && (detId[ibc][nStripsCrossedInPropagation[ibc] - 1][0] != detIdTemp[0] || detId[ibc][nStripsCrossedInPropagation[ibc] - 1][1] != detIdTemp[1] || detId[ibc][nStripsCrossedInPropagation[ibc] - 1][2] != detIdTemp[2]))) { // ...or we are crossing a new strip
+            if (nStripsCrossedInPropagation[ibc] == 0) {
+              LOG(debug) << "We cross a strip for the first time";
+            }
+            if (nStripsCrossedInPropagation[ibc] == 2) {
+              continue; // we have already matched 2 strips, we cannot match more
+            }
+            nStripsCrossedInPropagation[ibc]++;
+          }
+
+          //Printf("nStepsInsideSameStrip[nStripsCrossedInPropagation-1] = %d", nStepsInsideSameStrip[nStripsCrossedInPropagation - 1]);
+          if (nStepsInsideSameStrip[ibc][nStripsCrossedInPropagation[ibc] - 1] == 0) {
+            detId[ibc][nStripsCrossedInPropagation[ibc] - 1][0] = detIdTemp[0];
+            detId[ibc][nStripsCrossedInPropagation[ibc] - 1][1] = detIdTemp[1];
+            detId[ibc][nStripsCrossedInPropagation[ibc] - 1][2] = detIdTemp[2];
+            detId[ibc][nStripsCrossedInPropagation[ibc] - 1][3] = detIdTemp[3];
+            detId[ibc][nStripsCrossedInPropagation[ibc] - 1][4] = detIdTemp[4];
+            deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][0] = deltaPosTemp[0];
+            deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][1] = deltaPosTemp[1];
+            deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][2] = deltaPosTemp[2];
+
+            trkLTInt[ibc][nStripsCrossedInPropagation[ibc] - 1] = intLT;
+            Zshift[ibc][nStripsCrossedInPropagation[ibc] - 1] = ZshiftCurrent;
+            //          Printf("intLT (after matching to strip %d): length = %f, time (Pion) = %f", nStripsCrossedInPropagation - 1, trkLTInt[nStripsCrossedInPropagation - 1].getL(), trkLTInt[nStripsCrossedInPropagation - 1].getTOF(o2::track::PID::Pion));
+            nStepsInsideSameStrip[ibc][nStripsCrossedInPropagation[ibc] - 1]++;
+          } else { // a further propagation step in the same strip -> update info (we sum up on all matching with strip - we will divide for the number of steps a bit below)
+            // N.B. the integrated length and time are taken (at least for now) from the first time we crossed the strip, so here we do nothing with those
+            deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][0] += deltaPosTemp[0] + (detIdTemp[4] - detId[ibc][nStripsCrossedInPropagation[ibc] - 1][4]) * Geo::XPAD; // residual in x
+            deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][1] += deltaPosTemp[1];                                                                                    // residual in y
+            deltaPos[ibc][nStripsCrossedInPropagation[ibc] - 1][2] += deltaPosTemp[2] + (detIdTemp[3] - detId[ibc][nStripsCrossedInPropagation[ibc] - 1][3]) * Geo::ZPAD; // residual in z
+            nStepsInsideSameStrip[ibc][nStripsCrossedInPropagation[ibc] - 1]++;
+          }
+        }
+      }
+      for (int ibc = 0; ibc < BCcand.size(); ibc++) {
+        float minTime = (BCcand[ibc] - bc_grouping_tolerance) * Geo::BC_TIME_INPS;
+        float maxTime = (BCcand[ibc] + bc_grouping_tolerance) * Geo::BC_TIME_INPS;
+        for (Int_t imatch = 0; imatch < nStripsCrossedInPropagation[ibc]; imatch++) {
+          // we take as residual the average of the residuals along the propagation in the same strip
+          deltaPos[ibc][imatch][0] /= nStepsInsideSameStrip[ibc][imatch];
+          deltaPos[ibc][imatch][1] /= nStepsInsideSameStrip[ibc][imatch];
+          deltaPos[ibc][imatch][2] /= nStepsInsideSameStrip[ibc][imatch];
+        }
+
+        if (nStripsCrossedInPropagation[ibc] == 0) {
+          continue; // the track never hit a TOF strip during the propagation
+        }
+
+        // take from the strip index the TOF clusters of the crossed strips within the time windows of the track and of the BC candidate
+        candidates.clear();
+        for (int iPropagation = 0; iPropagation < nStripsCrossedInPropagation[ibc]; iPropagation++) {
+          int strip = Geo::getStripNumberPerSM(detId[ibc][iPropagation][1], detId[ibc][iPropagation][2]);
+          if (detId[ibc][iPropagation][0] != sec || strip < 0) {
+            continue;
+          }
+          addStripCandidates(strip, std::max<double>(minTrkTime, minTime), std::min<double>(maxTrkTime, maxTime), mTOFClusWork, cacheTOF, mTOFClusStripIndex[sec], mTOFClusStripOffset[sec], candidates);
+        }
+        std::sort(candidates.begin(), candidates.end()); // restore the time ordering of the clusters of the 2 strips
+        bool foundCluster = false;
+        for (auto itof : candidates) {
+          auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
+
+          int mainChannel = trefTOF.getMainContributingChannel();
+          int indices[5];
+          Geo::getVolumeIndices(mainChannel, indices);
+
+          unsigned long bcClus = trefTOF.getTime() * Geo::BC_TIME_INPS_INV;
+
+          // compute fine correction using cluster position instead of pad center
+          // this because in case of multiple-hit cluster position is averaged on all pads contributing to the cluster (then error position matrix can be used for Chi2 if nedeed)
+          int ndigits = 1;
+          float posCorr[3] = {0, 0, 0};
+
+          if (trefTOF.isBitSet(Cluster::kLeft)) {
+            posCorr[0] += Geo::XPAD, ndigits++;
+          }
+          if (trefTOF.isBitSet(Cluster::kUpLeft)) {
+            posCorr[0] += Geo::XPAD, posCorr[2] -= Geo::ZPAD, ndigits++;
+          }
+          if (trefTOF.isBitSet(Cluster::kDownLeft)) {
+            posCorr[0] += Geo::XPAD, posCorr[2] += Geo::ZPAD, ndigits++;
+          }
+          if (trefTOF.isBitSet(Cluster::kUp)) {
+            posCorr[2] -= Geo::ZPAD, ndigits++;
+          }
+          if (trefTOF.isBitSet(Cluster::kDown)) {
+            posCorr[2] += Geo::ZPAD, ndigits++;
+          }
+          if (trefTOF.isBitSet(Cluster::kRight)) {
+            posCorr[0] -= Geo::XPAD, ndigits++;
+          }
+          if (trefTOF.isBitSet(Cluster::kUpRight)) {
+            posCorr[0] -= Geo::XPAD, posCorr[2] -= Geo::ZPAD, ndigits++;
+          }
+          if (trefTOF.isBitSet(Cluster::kDownRight)) {
+            posCorr[0] -= Geo::XPAD, posCorr[2] += Geo::ZPAD, ndigits++;
+          }
+
+          float ndifInv = 1. / ndigits;
+          if (ndigits > 1) {
+            posCorr[0] *= ndifInv;
+            posCorr[1] *= ndifInv;
+            posCorr[2] *= ndifInv;
+          }
+
+          int trackIdTOF;
+          int eventIdTOF;
+          int sourceIdTOF;
+          for (auto iPropagation = 0; iPropagation < nStripsCrossedInPropagation[ibc]; iPropagation++) {
+            if (detId[ibc][iPropagation][1] != indices[1] || detId[ibc][iPropagation][2] != indices[2]) {
+              continue;
+            }
+
+            int bct0 = int((mTOFClusWork[cacheTOF[itof]].getTime() - trkLTInt[ibc][iPropagation].getTOF(0) + 5000) * Geo::BC_TIME_INPS_INV); // bc taken assuming speed of light (el) and 5 ns of margin
+            if (bct0 < 0) {                                                                                                                  // if negative time (it can happen at the beginng of the TF int was truncated per excess... adjusting)
+              bct0--;
+            }
+            float tof = mTOFClusWork[cacheTOF[itof]].getTime() - bct0 * Geo::BC_TIME_INPS;
+            if (tof - trkLTInt[ibc][iPropagation].getTOF(6) > 2000) { // reject tracks slower than triton
+              continue;
+            }
+
+            if (mMatchParams->applyPIDcutTPConly) {                                 // for TPC only tracks allowing possibility to apply a PID cut
+              if (std::abs(tof - trkLTInt[ibc][iPropagation].getTOF(2)) < 2000) {   // pion hypotesis
+              } else if (std::abs(tof - trkLTInt[ibc][iPropagation].getTOF(3)) < 2000) { // kaon hypoteis
+              } else if (std::abs(tof - trkLTInt[ibc][iPropagation].getTOF(4)) < 2000) { // proton hypotesis
+              } else {                                                                   // reject matching
+                continue;
+              }
+            }
+
+            float cosangle = TMath::Cos(Geo::getAngles(indices[1], indices[2]) * TMath::DegToRad());
+            const float errXinvMin = 1. / (mMatchParams->maxResX * mMatchParams->maxResX);
+            const float errZinvMin = 1. / (mMatchParams->maxResZ * mMatchParams->maxResZ);
+            float errXinv2 = 1. / (trefTrk.getSigmaY2());
+            float errZinv2 = 1. / (trefTrk.getSigmaZ2() * cosangle); // should be valid only at eta=0
+
+            if (errXinv2 < errXinvMin) {
+              errXinv2 = errXinvMin;
+            }
+            if (errZinv2 < errZinvMin) {
+              errZinv2 = errZinvMin;
+            }
+
+            LOG(debug) << "TOF Cluster [" << itof << ", " << cacheTOF[itof] << "]:      indices   = " << indices[0] << ", " << indices[1] << ", " << indices[2] << ", " << indices[3] << ", " << indices[4];
+            LOG(debug) << "Propagated Track [" << itrk << "]: detId[" << iPropagation << "]  = " << detId[ibc][iPropagation][0] << ", " << detId[ibc][iPropagation][1] << ", " << detId[ibc][iPropagation][2] << ", " << detId[ibc][iPropagation][3] << ", " << detId[ibc][iPropagation][4];
+            float resX = deltaPos[ibc][iPropagation][0] - (indices[4] - detId[ibc][iPropagation][4]) * Geo::XPAD + posCorr[0]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+            float resZ = deltaPos[ibc][iPropagation][2] - (indices[3] - detId[ibc][iPropagation][3]) * Geo::ZPAD + posCorr[2]; // readjusting the residuals due to the fact that the propagation fell in a pad that was not exactly the one of the cluster
+            if (BCcand[ibc] > bcClus) {
+              resZ += (BCcand[ibc] - bcClus) * vdriftInBC * side; // add bc correction
+            } else {
+              resZ -= (bcClus - BCcand[ibc]) * vdriftInBC * side;
+            }
+            float resXor = resX;
+            float resZor = resZ;
+            float res = TMath::Sqrt(resX * resX + resZ * resZ);
+
+            if (resX < -1.25) { // distance from closest border
+              resX += 1.25;
+            } else if (resX > 1.25) {
+              resX -= 1.25;
+            } else {
+              resX = 1E-3 / (pt + 1E-3); // high-pt should be favoured
+            }
+
+            if (resZ < -1.75) { // distance from closest border
+              resZ += 1.75;
+            } else if (resZ > 1.75) {
+              resZ -= 1.75;
+            } else {
+              resZ = 1E-3 / (pt + 1E-3); // high-pt should be favoured
+            }
+
+            if (indices[0] != detId[ibc][iPropagation][0]) {
+              continue;
+            }
+            if (indices[1] != detId[ibc][iPropagation][1]) {
+              continue;
+            }
+            if (indices[2] != detId[ibc][iPropagation][2]) {
+              continue;
+            }
+
+            LOG(debug) << "resX = " << resX << ", resZ = " << resZ << ", res = " << res;
+            float chi2 = mIsCosmics ? resX : 0.5 * (resX * resX * errXinv2 + resZ * resZ * errZinv2); // TODO: take into account also the time!
+
+            if (res < mSpaceTolerance && chi2 < mMatchParams->maxChi2) { // matching ok!
+              LOG(debug) << "MATCHING FOUND: We have a match! between track " << mTracksSectIndexCache[trkType::UNCONS][sec][itrk] << " and TOF cluster " << mTOFClusSectIndexCache[indices[0]][itof];
+              foundCluster = true;
+              // set event indexes (to be checked)
+
+              int eventIndexTOFCluster = mTOFClusSectIndexCache[indices[0]][itof];
+              matches.emplace_back(cacheTrk[itrk], eventIndexTOFCluster, mTOFClusWork[cacheTOF[itof]].getTime(), chi2, trkLTInt[ibc][iPropagation], mTrackGid[sec][trkType::UNCONS][cacheTrk[itrk]], trkType::UNCONS, trefTOF.getTime() * 1E-6 - tpctime, trefTOF.getZ(), resXor, resZor); // TODO: check if this is correct!
+              matches.back().setPt(pt);
+              matches.back().setResX(sqrt(1. / errXinv2));
+              matches.back().setResZ(sqrt(1. / errZinv2));
+              matches.back().setResT(resT);
+              matches.back().setVz(mVZtpcOnly[sec][itrk] + Zshift[ibc][iPropagation]);
+              matches.back().setChannel(mainChannel);
+            }
+          }
+        }
+      }
+    }
+  }
+  for (auto& matches : chunkMatches) {
+    mMatchedTracksPairsSec[sec].insert(mMatchedTracksPairsSec[sec].end(), matches.begin(), matches.end());
+  }
   return;
 }
 //______________________________________________
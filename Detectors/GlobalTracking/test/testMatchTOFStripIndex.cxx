@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testMatchTOFStripIndex.cxx
+/// \brief check that the per-strip index of the TOF clusters gives the same matching candidates as the linear scan of the sector
+
+#define BOOST_TEST_MODULE Test MatchTOF strip index
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "GlobalTracking/MatchTOF.h"
+#include "TOFBase/Geo.h"
+#include "DataFormatsTOF/Cluster.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace o2::globaltracking;
+using o2::tof::Cluster;
+using o2::tof::Geo;
+
+namespace
+{
+
+constexpr int Sector = 5;
+
+/// clusters of the TF in the sector and in the next one, with times on a coarse grid such that some are equal
+void generateClusters(std::mt19937& gen, std::vector<Cluster>& clusters, std::vector<int>& sectorCache)
+{
+  std::uniform_int_distribution<int> pad(0, Geo::NPADSXSECTOR - 1);
+  std::uniform_int_distribution<int> time(0, 20000);
+  for (int i = 0; i < 4000; i++) {
+    auto& cl = clusters.emplace_back();
+    cl.setMainContributingChannel((Sector + i % 2) * Geo::NPADSXSECTOR + pad(gen));
+    cl.setTime(50. * time(gen));
+    if (cl.getSector() == Sector) {
+      sectorCache.push_back(clusters.size() - 1);
+    }
+  }
+  std::sort(sectorCache.begin(), sectorCache.end(), [&clusters](int a, int b) { return clusters[a].getTime() < clusters[b].getTime(); });
+}
+
+/// candidates of the linear scan of the time ordered clusters of the sector that MatchTOF did before the strip index:
+/// clusters within the time window of the track and with the sector, plate and strip of one of the crossed strips
+std::vector<int> linearScan(const std::vector<Cluster>& clusters, const std::vector<int>& sectorCache, const std::vector<std::array<int, 3>>& crossed, double tMin, double tMax)
+{
+  std::vector<int> candidates;
+  for (int itof = 0; itof < int(sectorCache.size()); itof++) {
+    const auto& cl = clusters[sectorCache[itof]];
+    if (cl.getTime() < tMin) {
+      continue;
+    }
+    if (cl.getTime() > tMax) {
+      break;
+    }
+    int indices[5];
+    Geo::getVolumeIndices(cl.getMainContributingChannel(), indices);
+    for (const auto& detId : crossed) {
+      if (indices[0] == detId[0] && indices[1] == detId[1] && indices[2] == detId[2]) {
+        candidates.push_back(itof);
+        break;
+      }
+    }
+  }
+  return candidates;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(MatchTOF_StripOfChannel)
+{
+  // the strip index groups the clusters by padInSector / NPADS, the matching compares the volume indices of the main channel
+  for (int ch = 0; ch < Geo::NCHANNELS; ch++) {
+    int indices[5];
+    Geo::getVolumeIndices(ch, indices);
+    BOOST_REQUIRE_EQUAL(indices[0], ch / Geo::NPADSXSECTOR);
+    BOOST_REQUIRE_EQUAL(Geo::getStripNumberPerSM(indices[1], indices[2]), (ch % Geo::NPADSXSECTOR) / Geo::NPADS);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MatchTOF_StripCandidates)
+{
+  std::mt19937 gen(4321);
+  std::vector<Cluster> clusters;
+  std::vector<int> sectorCache, stripIndex;
+  std::array<int, Geo::NSTRIPXSECTOR + 1> stripOffset;
+  generateClusters(gen, clusters, sectorCache);
+  MatchTOF::buildStripIndex(clusters, sectorCache, stripIndex, stripOffset);
+  BOOST_REQUIRE_EQUAL(stripOffset[Geo::NSTRIPXSECTOR], int(sectorCache.size()));
+
+  std::uniform_int_distribution<int> strip(0, Geo::NSTRIPXSECTOR - 1), time(0, 20000), nCrossed(1, 2);
+  std::uniform_real_distribution<double> width(0., 1.e5);
+  std::bernoulli_distribution otherSector(0.1);
+  int nCandidates = 0;
+  for (int itrk = 0; itrk < 2000; itrk++) {
+    std::vector<std::array<int, 3>> crossed; // sector, plate and strip in plate of the (different) strips crossed by the track
+    for (int n = nCrossed(gen); int(crossed.size()) < n;) {
+      int plate, stripInPlate;
+      Geo::getStripAndModule(strip(gen), plate, stripInPlate);
+      std::array<int, 3> detId{otherSector(gen) ? Sector + 1 : Sector, plate, stripInPlate};
+      if (std::find(crossed.begin(), crossed.end(), detId) == crossed.end()) {
+        crossed.push_back(detId);
+      }
+    }
+    double tMin = 50. * time(gen), tMax = tMin + width(gen);
+    if (itrk % 2) { // window boundaries equal to cluster times
+      tMax = 50. * int(tMax / 50.);
+    }
+    std::vector<int> candidates;
+    for (const auto& detId : crossed) {
+      int stripInSector = Geo::getStripNumberPerSM(detId[1], detId[2]);
+      if (detId[0] != Sector || stripInSector < 0) { // as in MatchTOF: the clusters of another sector are never matched
+        continue;
+      }
+      MatchTOF::addStripCandidates(stripInSector, tMin, tMax, clusters, sectorCache, stripIndex, stripOffset, candidates);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    auto expected = linearScan(clusters, sectorCache, crossed, tMin, tMax);
+    BOOST_CHECK_EQUAL_COLLECTIONS(candidates.begin(), candidates.end(), expected.begin(), expected.end());
+    nCandidates += candidates.size();
+  }
+  BOOST_CHECK_GT(nCandidates, 100);
+}
@@ -102,6 +102,7 @@ struct TrackingParameters {
   bool DoUPCIteration = false;
   bool FataliseUponFailure = true;
   bool DropTFUponFailure = false;
+  bool UseTaskScheduling = false;
   /// Cluster attachment
   bool UseTrackFollower = false;
   bool UseTrackFollowerTop = false;
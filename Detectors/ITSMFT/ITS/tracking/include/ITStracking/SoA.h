@@ -0,0 +1,154 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file SoA.h
+/// \brief Structure-of-arrays copies of the hot fields of the clusters and tracklets used by the CPU tracker
+///
+
+#ifndef TRACKINGITSU_INCLUDE_SOA_H_
+#define TRACKINGITSU_INCLUDE_SOA_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "CommonConstants/MathConstants.h"
+#include "ITStracking/Cluster.h"
+#include "ITStracking/Tracklet.h"
+
+namespace o2
+{
+namespace its
+{
+
+/// Allocator returning storage aligned to a cache line, which is also enough for any SIMD register width
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+  using value_type = T;
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+  {
+  }
+
+  T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment})); }
+  void deallocate(T* p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{Alignment}); }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+  {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept
+  {
+    return false;
+  }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/// Number of entries every column is padded to, covering the widest float vector (AVX-512)
+constexpr int SoAPadding{16};
+
+constexpr int getPaddedSize(int size)
+{
+  return (size + SoAPadding - 1) / SoAPadding * SoAPadding;
+}
+
+/// A column holds an extra padding block, so that a range starting anywhere in it can be rounded up to full blocks
+constexpr int getColumnSize(int size)
+{
+  return getPaddedSize(size) + SoAPadding;
+}
+
+/// Sorted clusters of a layer, restricted to the fields read in the phi/z window searches.
+/// The index of an entry is the sorted index of the cluster, i.e. the one of TimeFrame::getClusters().
+/// The padding entries can never be compatible with any cluster, so loops over a bin range can be run
+/// up to the next multiple of SoAPadding without a scalar remainder: the extra entries are either padding
+/// or clusters of the following bins, whose results are discarded.
+struct ClustersSoA {
+  void fill(gsl::span<const Cluster> clusters)
+  {
+    const int paddedSize{getColumnSize(static_cast<int>(clusters.size()))};
+    phi.assign(paddedSize, constants::math::VeryBig);
+    zCoordinate.assign(paddedSize, constants::math::VeryBig);
+    radius.assign(paddedSize, 0.f);
+    clusterId.assign(paddedSize, -1);
+    for (size_t iCluster{0}; iCluster < clusters.size(); ++iCluster) {
+      phi[iCluster] = clusters[iCluster].phi;
+      zCoordinate[iCluster] = clusters[iCluster].zCoordinate;
+      radius[iCluster] = clusters[iCluster].radius;
+      clusterId[iCluster] = clusters[iCluster].clusterId;
+    }
+    nClusters = clusters.size();
+  }
+
+  void clear()
+  {
+    AlignedVector<float>().swap(phi);
+    AlignedVector<float>().swap(zCoordinate);
+    AlignedVector<float>().swap(radius);
+    AlignedVector<int>().swap(clusterId);
+    nClusters = 0;
+  }
+
+  size_t size() const { return nClusters; }
+  unsigned long getMemory() const { return phi.capacity() * (3 * sizeof(float) + sizeof(int)); }
+
+  AlignedVector<float> phi;
+  AlignedVector<float> zCoordinate;
+  AlignedVector<float> radius;
+  AlignedVector<int> clusterId;
+  size_t nClusters{0};
+};
+
+/// Sorted tracklets of a layer, restricted to the fields read in the cell compatibility checks
+struct TrackletsSoA {
+  void fill(gsl::span<const Tracklet> tracklets)
+  {
+    const int paddedSize{getColumnSize(static_cast<int>(tracklets.size()))};
+    firstClusterIndex.assign(paddedSize, -1);
+    tanLambda.assign(paddedSize, constants::math::VeryBig);
+    for (size_t iTracklet{0}; iTracklet < tracklets.size(); ++iTracklet) {
+      firstClusterIndex[iTracklet] = tracklets[iTracklet].firstClusterIndex;
+      tanLambda[iTracklet] = tracklets[iTracklet].tanLambda;
+    }
+    nTracklets = tracklets.size();
+  }
+
+  void clear()
+  {
+    AlignedVector<int>().swap(firstClusterIndex);
+    AlignedVector<float>().swap(tanLambda);
+    nTracklets = 0;
+  }
+
+  size_t size() const { return nTracklets; }
+  unsigned long getMemory() const { return firstClusterIndex.capacity() * (sizeof(int) + sizeof(float)); }
+
+  AlignedVector<int> firstClusterIndex;
+  AlignedVector<float> tanLambda;
+  size_t nTracklets{0};
+};
+
+} // namespace its
+} // namespace o2
+
+#endif /* TRACKINGITSU_INCLUDE_SOA_H_ */
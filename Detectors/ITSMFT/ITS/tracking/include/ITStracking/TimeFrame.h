@@ -32,6 +32,7 @@
 #include "ITStracking/ClusterLines.h"
 #include "ITStracking/Definitions.h"
 #include "ITStracking/Road.h"
+#include "ITStracking/SoA.h"
 #include "ITStracking/Tracklet.h"
 #include "ITStracking/IndexTableUtils.h"
 #include "ITStracking/ExternalAllocator.h"
@@ -159,6 +160,9 @@ class TimeFrame
 
   std::vector<std::vector<Cluster>>& getClusters();
   std::vector<std::vector<Cluster>>& getUnsortedClusters();
+  const ClustersSoA& getClustersSoA(int layer) const { return mClustersSoA[layer]; }
+  const TrackletsSoA& getTrackletsSoA(int layer) const { return mTrackletsSoA[layer]; }
+  void fillTrackletsSoA(int layer) { mTrackletsSoA[layer].fill(mTracklets[layer]); }
   int getClusterROF(int iLayer, int iCluster);
   std::vector<std::vector<CellSeed>>& getCells();
 
@@ -286,7 +290,9 @@ class TimeFrame
   bool mExtAllocator = false;
   ExternalAllocator* mAllocator = nullptr;
   std::vector<std::vector<Cluster>> mUnsortedClusters;
+  std::vector<ClustersSoA> mClustersSoA;
   std::vector<std::vector<Tracklet>> mTracklets;
+  std::vector<TrackletsSoA> mTrackletsSoA;
   std::vector<std::vector<CellSeed>> mCells;
   std::vector<std::vector<o2::track::TrackParCovF>> mCellSeeds;
   std::vector<std::vector<float>> mCellSeedsChi2;
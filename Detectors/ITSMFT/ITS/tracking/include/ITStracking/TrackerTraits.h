@@ -26,6 +26,8 @@
 #include <utility>
 #include <functional>
 
+#include <tbb/task_arena.h>
+
 #include "DetectorsBase/Propagator.h"
 #include "DetectorsBase/MatLayerCylSet.h"
 #include "ITStracking/Configuration.h"
@@ -46,6 +48,20 @@ namespace its
 {
 class TrackITSExt;
 
+enum class TrackingStage : int {
+  Tracklets = 0,
+  Cells,
+  Neighbours,
+  Roads,
+  NStages
+};
+
+/// Wall time of a tracking stage and the time the workers spent waiting for work during it, in ms
+struct StageTiming {
+  double wall{0.};
+  double idle{0.};
+};
+
 class TrackerTraits
 {
  public:
@@ -67,7 +83,7 @@ class TrackerTraits
   virtual void findShortPrimaries();
   virtual void setBz(float bz);
   virtual bool trackFollowing(TrackITSExt* track, int rof, bool outward, const int iteration);
-  virtual void processNeighbours(int iLayer, int iLevel, const std::vector<CellSeed>& currentCellSeed, const std::vector<int>& currentCellId, std::vector<CellSeed>& updatedCellSeed, std::vector<int>& updatedCellId);
+  virtual void processNeighbours(const int iteration, int iLayer, int iLevel, const std::vector<CellSeed>& currentCellSeed, const std::vector<int>& currentCellId, std::vector<CellSeed>& updatedCellSeed, std::vector<int>& updatedCellId);
 
   void UpdateTrackingParameters(const std::vector<TrackingParameters>& trkPars);
   TimeFrame* getTimeFrame() { return mTimeFrame; }
@@ -87,6 +103,8 @@ class TrackerTraits
   bool getSmoothing() const { return mApplySmoothing; }
   void setNThreads(int n);
   int getNThreads() const { return mNThreads; }
+  const std::array<StageTiming, static_cast<int>(TrackingStage::NStages)>& getStageTimings() const { return mStageTimings; }
+  void resetStageTimings() { mStageTimings.fill({}); }
 
   o2::gpu::GPUChainITS* getChain() const { return mChain; }
 
@@ -101,8 +119,16 @@ class TrackerTraits
   track::TrackParCov buildTrackSeed(const Cluster& cluster1, const Cluster& cluster2, const TrackingFrameInfo& tf3);
   bool fitTrack(TrackITSExt& track, int start, int end, int step, float chi2clcut = o2::constants::math::VeryBig, float chi2ndfcut = o2::constants::math::VeryBig, float maxQoverPt = o2::constants::math::VeryBig, int nCl = 0);
 
+  template <typename F>
+  void executeTasks(TrackingStage stage, F&& createTasks);
+  tbb::task_arena& getTaskArena();
+  int getTaskChunkSize(int nItems) const { return o2::gpu::GPUCommonMath::Max(1, nItems / (mNThreads * TasksPerThread)); }
+
+  static constexpr int TasksPerThread{8}; // granularity of the task-based scheduling, to let the workers steal the work of the slow ones
   int mNThreads = 1;
+  std::shared_ptr<tbb::task_arena> mTaskArena; // arena of mNThreads workers of the task-based scheduling, reused by all the stages and TFs
   bool mApplySmoothing = false;
+  std::array<StageTiming, static_cast<int>(TrackingStage::NStages)> mStageTimings;
 
  protected:
   o2::base::PropagatorImpl<float>::MatCorrType mCorrType = o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrNONE;
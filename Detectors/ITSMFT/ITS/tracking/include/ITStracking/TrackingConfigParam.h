@@ -87,6 +87,7 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
   bool doUPCIteration = false;             // Perform an additional iteration for UPC events on tagged vertices. You want to combine this config with VertexerParamConfig.nIterations=2
   bool fataliseUponFailure = true;         // granular management of the fatalisation in async mode
   bool dropTFUponFailure = false;
+  bool useTaskScheduling = false; // run the CPU tracking stages as ROF x layer tasks on a work-stealing executor instead of per-layer OpenMP loops
 
   O2ParamDef(TrackerParamConfig, "ITSCATrackerParam");
 };
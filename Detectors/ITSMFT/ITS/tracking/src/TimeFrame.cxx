@@ -340,6 +340,11 @@ void TimeFrame::prepareClusters(const TrackingParameters& trkParam, const int ma
       }
     }
   }
+
+  mClustersSoA.resize(mClusters.size());
+  for (int iLayer{0}; iLayer < std::min(trkParam.NLayers, maxLayers); ++iLayer) {
+    mClustersSoA[iLayer].fill(mClusters[iLayer]);
+  }
 }
 
 void TimeFrame::initialise(const int iteration, const TrackingParameters& trkParam, const int maxLayers, bool resetVertices)
@@ -364,6 +369,7 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
     mCellsNeighboursLUT.resize(trkParam.CellsPerRoad() - 1);
     mCellLabels.resize(trkParam.CellsPerRoad());
     mTracklets.resize(std::min(trkParam.TrackletsPerRoad(), maxLayers - 1));
+    mTrackletsSoA.resize(mTracklets.size());
     mTrackletLabels.resize(trkParam.TrackletsPerRoad());
     mTrackletsLookupTable.resize(trkParam.CellsPerRoad());
     mIndexTableUtils.setTrackingParameters(trkParam);
@@ -435,6 +441,7 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
 
   for (int iLayer{0}; iLayer < std::min((int)mTracklets.size(), maxLayers); ++iLayer) {
     deepVectorClear(mTracklets[iLayer]);
+    mTrackletsSoA[iLayer].clear();
     deepVectorClear(mTrackletLabels[iLayer]);
     if (iLayer < (int)mCells.size()) {
       deepVectorClear(mCells[iLayer]);
@@ -457,6 +464,12 @@ unsigned long TimeFrame::getArtefactsMemory()
   for (auto& trkl : mTracklets) {
     size += sizeof(Tracklet) * trkl.size();
   }
+  for (auto& clsSoA : mClustersSoA) {
+    size += clsSoA.getMemory();
+  }
+  for (auto& trklSoA : mTrackletsSoA) {
+    size += trklSoA.getMemory();
+  }
   for (auto& cells : mCells) {
     size += sizeof(CellSeed) * cells.size();
   }
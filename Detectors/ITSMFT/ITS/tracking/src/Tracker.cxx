@@ -65,6 +65,7 @@ void Tracker::clustersToTracks(std::function<void(std::string s)> logger, std::f
     logger(fmt::format("ITS Tracking iteration {} summary:", iteration));
     double timeTracklets{0.}, timeCells{0.}, timeNeighbours{0.}, timeRoads{0.};
     int nTracklets{0}, nCells{0}, nNeighbours{0}, nTracks{-static_cast<int>(mTimeFrame->getNumberOfTracks())};
+    mTraits->resetStageTimings();
 
     total += evaluateTask(&Tracker::initialiseTimeFrame, "Timeframe initialisation", logger, iteration);
     int nROFsIterations = mTrkParams[iteration].nROFsPerIterations > 0 ? mTimeFrame->getNrof() / mTrkParams[iteration].nROFsPerIterations + bool(mTimeFrame->getNrof() % mTrkParams[iteration].nROFsPerIterations) : 1;
@@ -122,6 +123,14 @@ void Tracker::clustersToTracks(std::function<void(std::string s)> logger, std::f
     logger(fmt::format(" - Cell finding: {} cells found in {:.2f} ms", nCells, timeCells));
     logger(fmt::format(" - Neighbours finding: {} neighbours found in {:.2f} ms", nNeighbours, timeNeighbours));
     logger(fmt::format(" - Track finding: {} tracks found in {:.2f} ms", nTracks + mTimeFrame->getNumberOfTracks(), timeRoads));
+    if (mTrkParams[iteration].UseTaskScheduling) {
+      const auto& timings{mTraits->getStageTimings()};
+      constexpr std::array<const char*, static_cast<int>(TrackingStage::NStages)> stageNames{"tracklets", "cells", "neighbours", "roads"};
+      for (int iStage{0}; iStage < static_cast<int>(TrackingStage::NStages); ++iStage) {
+        logger(fmt::format(" - Task scheduling, {} stage: {:.2f} ms wall, {:.2f} ms idle over {} threads ({:.1f}% occupancy)", stageNames[iStage], timings[iStage].wall, timings[iStage].idle, mTraits->getNThreads(),
+                           timings[iStage].wall > 0. ? 100. * (1. - timings[iStage].idle / (timings[iStage].wall * mTraits->getNThreads())) : 0.));
+      }
+    }
     total += timeTracklets + timeCells + timeNeighbours + timeRoads;
     if (mTrkParams[iteration].UseTrackFollower) {
       int nExtendedTracks{-mTimeFrame->mNExtendedTracks}, nExtendedClusters{-mTimeFrame->mNExtendedUsedClusters};
@@ -516,6 +525,7 @@ void Tracker::getGlobalConfiguration()
     params.SaveTimeBenchmarks = tc.saveTimeBenchmarks;
     params.FataliseUponFailure = tc.fataliseUponFailure;
     params.DropTFUponFailure = tc.dropTFUponFailure;
+    params.UseTaskScheduling = tc.useTaskScheduling;
     for (int iD{0}; iD < 3; ++iD) {
       params.Diamond[iD] = tc.diamondPos[iD];
     }
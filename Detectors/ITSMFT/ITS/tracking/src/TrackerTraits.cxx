@@ -16,9 +16,12 @@
 #include "ITStracking/TrackerTraits.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
 
+#include <tbb/task_group.h>
+
 #include <fmt/format.h>
 
 #include "CommonConstants/MathConstants.h"
@@ -51,6 +54,47 @@ namespace its
 
 constexpr int debugLevel{0};
 
+namespace
+{
+/// Spawns tasks on a task group, accumulating the time the workers actually spend running them
+class TimedTaskSpawner
+{
+ public:
+  TimedTaskSpawner(tbb::task_group& group, std::atomic<long>& busyTime) : mGroup{group}, mBusyTime{busyTime} {}
+
+  template <typename F>
+  void operator()(F&& task)
+  {
+    mGroup.run([this, task = std::forward<F>(task)]() {
+      const auto start{std::chrono::steady_clock::now()};
+      task();
+      mBusyTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    });
+  }
+
+ private:
+  tbb::task_group& mGroup;
+  std::atomic<long>& mBusyTime;
+};
+} // namespace
+
+template <typename F>
+void TrackerTraits::executeTasks(TrackingStage stage, F&& createTasks)
+{
+  std::atomic<long> busyTime{0};
+  const auto start{std::chrono::steady_clock::now()};
+  getTaskArena().execute([&]() {
+    tbb::task_group group;
+    TimedTaskSpawner spawn{group, busyTime};
+    createTasks(spawn);
+    group.wait();
+  });
+  const double wall{std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()};
+  auto& timing{mStageTimings[static_cast<int>(stage)]};
+  timing.wall += wall;
+  timing.idle += std::max(0., wall * mNThreads - busyTime * 1.e-6);
+}
+
 void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, int iVertex)
 {
   TimeFrame* tf = mTimeFrame;
@@ -72,148 +116,163 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
   gsl::span<const Vertex> diamondSpan(&diamondVert, 1);
   int startROF{mTrkParams[iteration].nROFsPerIterations > 0 ? iROFslice * mTrkParams[iteration].nROFsPerIterations : 0};
   int endROF{gpu::GPUCommonMath::Min(mTrkParams[iteration].nROFsPerIterations > 0 ? (iROFslice + 1) * mTrkParams[iteration].nROFsPerIterations + mTrkParams[iteration].DeltaROF : tf->getNrof(), tf->getNrof())};
-  for (int rof0{startROF}; rof0 < endROF; ++rof0) {
+
+  /// Finds the tracklets starting from the clusters of layer iLayer in rof0, appending them to trackletsOut
+  auto computeTracklets = [&](int rof0, int iLayer, std::vector<Tracklet>& trackletsOut) {
+    gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
+    if (layer0.empty()) {
+      return;
+    }
     gsl::span<const Vertex> primaryVertices = mTrkParams[iteration].UseDiamond ? diamondSpan : tf->getPrimaryVertices(rof0);
     const int startVtx{iVertex >= 0 ? iVertex : 0};
     const int endVtx{iVertex >= 0 ? o2::gpu::CAMath::Min(iVertex + 1, static_cast<int>(primaryVertices.size())) : static_cast<int>(primaryVertices.size())};
     int minRof = o2::gpu::CAMath::Max(startROF, rof0 - mTrkParams[iteration].DeltaROF);
     int maxRof = o2::gpu::CAMath::Min(endROF - 1, rof0 + mTrkParams[iteration].DeltaROF);
-#pragma omp parallel for num_threads(mNThreads)
-    for (int iLayer = 0; iLayer < mTrkParams[iteration].TrackletsPerRoad(); ++iLayer) {
-      gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
-      if (layer0.empty()) {
+    float meanDeltaR{mTrkParams[iteration].LayerRadii[iLayer + 1] - mTrkParams[iteration].LayerRadii[iLayer]};
+    const float nSigmaCut{mTrkParams[iteration].NSigmaCut};
+    const float phiCut{tf->getPhiCut(iLayer)};
+    const ClustersSoA& nextLayerSoA{tf->getClustersSoA(iLayer + 1)};
+    std::vector<unsigned char> compatible;
+
+    const int currentLayerClustersNum{static_cast<int>(layer0.size())};
+    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
+      const Cluster& currentCluster{layer0[iCluster]};
+      const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
+
+      if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
         continue;
       }
-      float meanDeltaR{mTrkParams[iteration].LayerRadii[iLayer + 1] - mTrkParams[iteration].LayerRadii[iLayer]};
+      const float inverseR0{1.f / currentCluster.radius};
 
-      const int currentLayerClustersNum{static_cast<int>(layer0.size())};
-      for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
-        const Cluster& currentCluster{layer0[iCluster]};
-        const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
-
-        if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
+      for (int iV{startVtx}; iV < endVtx; ++iV) {
+        auto& primaryVertex{primaryVertices[iV]};
+        if (primaryVertex.isFlagSet(2) && iteration != 3) {
           continue;
         }
-        const float inverseR0{1.f / currentCluster.radius};
+        const float resolution = o2::gpu::CAMath::Sqrt(Sq(mTrkParams[iteration].PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
 
-        for (int iV{startVtx}; iV < endVtx; ++iV) {
-          auto& primaryVertex{primaryVertices[iV]};
-          if (primaryVertex.isFlagSet(2) && iteration != 3) {
-            continue;
-          }
-          const float resolution = o2::gpu::CAMath::Sqrt(Sq(mTrkParams[iteration].PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
+        const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
 
-          const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
+        const float zAtRmin{tanLambda * (tf->getMinR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
+        const float zAtRmax{tanLambda * (tf->getMaxR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
 
-          const float zAtRmin{tanLambda * (tf->getMinR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
-          const float zAtRmax{tanLambda * (tf->getMaxR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
+        const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
+        const float sigmaZ{o2::gpu::CAMath::Sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
 
-          const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
-          const float sigmaZ{o2::gpu::CAMath::Sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
+        const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer + 1, zAtRmin, zAtRmax,
+                                                sigmaZ * mTrkParams[iteration].NSigmaCut, tf->getPhiCut(iLayer))};
+        if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+          continue;
+        }
 
-          const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer + 1, zAtRmin, zAtRmax,
-                                                  sigmaZ * mTrkParams[iteration].NSigmaCut, tf->getPhiCut(iLayer))};
-          if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
-            continue;
-          }
+        int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
 
-          int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
+        if (phiBinsNum < 0) {
+          phiBinsNum += mTrkParams[iteration].PhiBins;
+        }
 
-          if (phiBinsNum < 0) {
-            phiBinsNum += mTrkParams[iteration].PhiBins;
+        for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
+          gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
+          if (layer1.empty()) {
+            continue;
           }
-
-          for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
-            gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
-            if (layer1.empty()) {
+          for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
+            int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
+            const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
+            const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
+            if constexpr (debugLevel) {
+              if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTable(rof1, iLayer + 1).size() ||
+                  maxBinIndex < 0 || maxBinIndex > tf->getIndexTable(rof1, iLayer + 1).size()) {
+                std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams[iteration].NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
+                std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
+                std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
+                std::cout << "Illegal access to IndexTable " << firstBinIndex << "\t" << maxBinIndex << "\t" << selectedBinsRect.z << "\t" << selectedBinsRect.x << std::endl;
+                exit(1);
+              }
+            }
+            const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
+            const int maxRowClusterIndex = o2::gpu::CAMath::Min(tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex], static_cast<int>(layer1.size()));
+            if (firstRowClusterIndex >= maxRowClusterIndex) {
               continue;
             }
-            for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
-              int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
-              const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
-              const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-              if constexpr (debugLevel) {
-                if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTable(rof1, iLayer + 1).size() ||
-                    maxBinIndex < 0 || maxBinIndex > tf->getIndexTable(rof1, iLayer + 1).size()) {
-                  std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams[iteration].NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
-                  std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
-                  std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
-                  std::cout << "Illegal access to IndexTable " << firstBinIndex << "\t" << maxBinIndex << "\t" << selectedBinsRect.z << "\t" << selectedBinsRect.x << std::endl;
-                  exit(1);
-                }
-              }
-              const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
-              const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
-              for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
-                if (iNextCluster >= (int)layer1.size()) {
-                  break;
-                }
 
-                const Cluster& nextCluster{layer1[iNextCluster]};
-                if (tf->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
-                  continue;
-                }
+            /// Window check on the SoA columns of the whole bin row, padded to full SIMD blocks so that it vectorises
+            const int soaOffset{tf->getSortedStartIndex(rof1, iLayer + 1) + firstRowClusterIndex};
+            const int nCandidates{getPaddedSize(maxRowClusterIndex - firstRowClusterIndex)};
+            const float* nextPhi{nextLayerSoA.phi.data() + soaOffset};
+            const float* nextZ{nextLayerSoA.zCoordinate.data() + soaOffset};
+            const float* nextRadius{nextLayerSoA.radius.data() + soaOffset};
+            if ((int)compatible.size() < nCandidates) {
+              compatible.resize(nCandidates);
+            }
+            for (int iCandidate{0}; iCandidate < nCandidates; ++iCandidate) {
+              const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextPhi[iCandidate])};
+              const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextRadius[iCandidate] - currentCluster.radius) +
+                                                         currentCluster.zCoordinate - nextZ[iCandidate])};
+              compatible[iCandidate] = (deltaZ / sigmaZ < nSigmaCut) & ((deltaPhi < phiCut) | (gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < phiCut));
+            }
 
-                const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextCluster.phi)};
-                const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.radius - currentCluster.radius) +
-                                                           currentCluster.zCoordinate - nextCluster.zCoordinate)};
+            for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+#ifndef OPTIMISATION_OUTPUT
+              if (!compatible[iNextCluster - firstRowClusterIndex]) {
+                continue;
+              }
+#endif
+              if (tf->isClusterUsed(iLayer + 1, nextLayerSoA.clusterId[soaOffset + iNextCluster - firstRowClusterIndex])) {
+                continue;
+              }
+              const Cluster& nextCluster{layer1[iNextCluster]};
 
 #ifdef OPTIMISATION_OUTPUT
-                MCCompLabel label;
-                int currentId{currentCluster.clusterId};
-                int nextId{nextCluster.clusterId};
-                for (auto& lab1 : tf->getClusterLabels(iLayer, currentId)) {
-                  for (auto& lab2 : tf->getClusterLabels(iLayer + 1, nextId)) {
-                    if (lab1 == lab2 && lab1.isValid()) {
-                      label = lab1;
-                      break;
-                    }
-                  }
-                  if (label.isValid()) {
+              MCCompLabel label;
+              int currentId{currentCluster.clusterId};
+              int nextId{nextCluster.clusterId};
+              for (auto& lab1 : tf->getClusterLabels(iLayer, currentId)) {
+                for (auto& lab2 : tf->getClusterLabels(iLayer + 1, nextId)) {
+                  if (lab1 == lab2 && lab1.isValid()) {
+                    label = lab1;
                     break;
                   }
                 }
-                off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
+                if (label.isValid()) {
+                  break;
+                }
+              }
+              off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
 #endif
 
-                if (deltaZ / sigmaZ < mTrkParams[iteration].NSigmaCut &&
-                    (deltaPhi < tf->getPhiCut(iLayer) ||
-                     gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
-                  if (iLayer > 0) {
-                    tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
-                  }
-                  const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
-                                                                currentCluster.xCoordinate - nextCluster.xCoordinate)};
-                  const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
-                                   (currentCluster.radius - nextCluster.radius)};
-                  tf->getTracklets()[iLayer].emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
+              if (compatible[iNextCluster - firstRowClusterIndex]) {
+                if (iLayer > 0) {
+                  tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++; /// sorted indices are unique per ROF, concurrent ROF tasks never share an entry
                 }
+                const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
+                                                              currentCluster.xCoordinate - nextCluster.xCoordinate)};
+                const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
+                                 (currentCluster.radius - nextCluster.radius)};
+                trackletsOut.emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
               }
             }
           }
         }
       }
     }
-  }
-  if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
-    return;
-  }
+  };
 
-#pragma omp parallel for num_threads(mNThreads)
-  for (int iLayer = 0; iLayer < mTrkParams[iteration].CellsPerRoad(); ++iLayer) {
-    /// Sort tracklets
-    auto& trkl{tf->getTracklets()[iLayer + 1]};
+  /// Sorts the tracklets of a layer, removes the duplicates and builds the lookup table pointing to them
+  auto sortTracklets = [&](int iLayer) {
+    auto& trkl{tf->getTracklets()[iLayer]};
     std::sort(trkl.begin(), trkl.end(), [](const Tracklet& a, const Tracklet& b) {
       return a.firstClusterIndex < b.firstClusterIndex || (a.firstClusterIndex == b.firstClusterIndex && a.secondClusterIndex < b.secondClusterIndex);
     });
     /// Remove duplicates
-    auto& lut{tf->getTrackletsLookupTable()[iLayer]};
     int id0{-1}, id1{-1};
     std::vector<Tracklet> newTrk;
     newTrk.reserve(trkl.size());
     for (auto& trk : trkl) {
       if (trk.firstClusterIndex == id0 && trk.secondClusterIndex == id1) {
-        lut[id0]--;
+        if (iLayer > 0) {
+          tf->getTrackletsLookupTable()[iLayer - 1][id0]--;
+        }
       } else {
         id0 = trk.firstClusterIndex;
         id1 = trk.secondClusterIndex;
@@ -221,26 +280,74 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
       }
     }
     trkl.swap(newTrk);
+    tf->fillTrackletsSoA(iLayer);
 
-    /// Compute LUT
-    std::exclusive_scan(lut.begin(), lut.end(), lut.begin(), 0);
-    lut.push_back(trkl.size());
+    /// Compute LUT, layer 0 does not have one
+    if (iLayer > 0) {
+      auto& lut{tf->getTrackletsLookupTable()[iLayer - 1]};
+      std::exclusive_scan(lut.begin(), lut.end(), lut.begin(), 0);
+      lut.push_back(trkl.size());
+    }
+  };
+
+  const int nLayers{mTrkParams[iteration].TrackletsPerRoad()};
+  if (mTrkParams[iteration].UseTaskScheduling) {
+    /// One task per ROF and layer. The last task to complete on a layer merges the tracklets of the ROFs,
+    /// so that no worker waits for the slowest ROF of the other layers.
+    const int nROFs{o2::gpu::CAMath::Max(endROF - startROF, 0)};
+    std::vector<std::vector<std::vector<Tracklet>>> trackletsPerROF(nLayers, std::vector<std::vector<Tracklet>>(nROFs));
+    std::unique_ptr<std::atomic<int>[]> pendingROFs{new std::atomic<int>[nLayers]};
+    executeTasks(TrackingStage::Tracklets, [&](auto& spawn) {
+      for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+        pendingROFs[iLayer] = nROFs;
+      }
+      for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+        for (int rof0{startROF}; rof0 < endROF; ++rof0) {
+          spawn([&, iLayer, rof0]() {
+            computeTracklets(rof0, iLayer, trackletsPerROF[iLayer][rof0 - startROF]);
+            if (--pendingROFs[iLayer] == 0) {
+              auto& trkl{tf->getTracklets()[iLayer]};
+              size_t nTracklets{0};
+              for (auto& rofTracklets : trackletsPerROF[iLayer]) {
+                nTracklets += rofTracklets.size();
+              }
+              trkl.reserve(nTracklets);
+              for (auto& rofTracklets : trackletsPerROF[iLayer]) {
+                trkl.insert(trkl.end(), rofTracklets.begin(), rofTracklets.end());
+                std::vector<Tracklet>().swap(rofTracklets);
+              }
+            }
+          });
+        }
+      }
+    });
+  } else {
+    for (int rof0{startROF}; rof0 < endROF; ++rof0) {
+#pragma omp parallel for num_threads(mNThreads)
+      for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+        computeTracklets(rof0, iLayer, tf->getTracklets()[iLayer]);
+      }
+    }
   }
-  /// Layer 0 is done outside the loop
-  std::sort(tf->getTracklets()[0].begin(), tf->getTracklets()[0].end(), [](const Tracklet& a, const Tracklet& b) {
-    return a.firstClusterIndex < b.firstClusterIndex || (a.firstClusterIndex == b.firstClusterIndex && a.secondClusterIndex < b.secondClusterIndex);
-  });
-  int id0{-1}, id1{-1};
-  std::vector<Tracklet> newTrk;
-  newTrk.reserve(tf->getTracklets()[0].size());
-  for (auto& trk : tf->getTracklets()[0]) {
-    if (trk.firstClusterIndex != id0 || trk.secondClusterIndex != id1) {
-      id0 = trk.firstClusterIndex;
-      id1 = trk.secondClusterIndex;
-      newTrk.push_back(trk);
+  if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
+    return;
+  }
+
+  if (mTrkParams[iteration].UseTaskScheduling) {
+    executeTasks(TrackingStage::Tracklets, [&](auto& spawn) {
+      for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+        spawn([&, iLayer]() { sortTracklets(iLayer); });
+      }
+    });
+  } else {
+#pragma omp parallel for num_threads(mNThreads)
+    for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+      sortTracklets(iLayer);
     }
   }
-  tf->getTracklets()[0].swap(newTrk);
+  if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
+    return;
+  }
 
   /// Create tracklets labels
   if (tf->hasMCinformation()) {
@@ -282,99 +389,172 @@ void TrackerTraits::computeLayerCells(const int iteration)
   }
 
   TimeFrame* tf = mTimeFrame;
-#pragma omp parallel for num_threads(mNThreads)
-  for (int iLayer = 0; iLayer < mTrkParams[iteration].CellsPerRoad(); ++iLayer) {
-
-    if (tf->getTracklets()[iLayer + 1].empty() ||
-        tf->getTracklets()[iLayer].empty()) {
-      continue;
-    }
 
+  /// Builds the cells seeded by tracklet iTracklet of layer iLayer, appending them to cellsOut
+  auto computeCells = [&](int iLayer, int iTracklet, std::vector<CellSeed>& cellsOut) {
 #ifdef OPTIMISATION_OUTPUT
     float resolution{o2::gpu::CAMath::Sqrt(0.5f * (mTrkParams[iteration].SystErrorZ2[iLayer] + mTrkParams[iteration].SystErrorZ2[iLayer + 1] + mTrkParams[iteration].SystErrorZ2[iLayer + 2] + mTrkParams[iteration].SystErrorY2[iLayer] + mTrkParams[iteration].SystErrorY2[iLayer + 1] + mTrkParams[iteration].SystErrorY2[iLayer + 2])) / mTrkParams[iteration].LayerResolution[iLayer]};
     resolution = resolution > 1.e-12 ? resolution : 1.f;
 #endif
-    const int currentLayerTrackletsNum{static_cast<int>(tf->getTracklets()[iLayer].size())};
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
-
-      const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
-      const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
-      const int nextLayerFirstTrackletIndex{
-        tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
-      const int nextLayerLastTrackletIndex{
-        tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex + 1]};
+    const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
+    const TrackletsSoA& nextLayerSoA{tf->getTrackletsSoA(iLayer + 1)};
+    const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
+    const int nextLayerFirstTrackletIndex{
+      tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+    const int nextLayerLastTrackletIndex{
+      tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex + 1]};
+
+    if (nextLayerFirstTrackletIndex == nextLayerLastTrackletIndex) {
+      return;
+    }
 
-      if (nextLayerFirstTrackletIndex == nextLayerLastTrackletIndex) {
-        continue;
+    for (int iNextTracklet{nextLayerFirstTrackletIndex}; iNextTracklet < nextLayerLastTrackletIndex; ++iNextTracklet) {
+      if (nextLayerSoA.firstClusterIndex[iNextTracklet] != nextLayerClusterIndex) {
+        break;
       }
-
-      for (int iNextTracklet{nextLayerFirstTrackletIndex}; iNextTracklet < nextLayerLastTrackletIndex; ++iNextTracklet) {
-        if (tf->getTracklets()[iLayer + 1][iNextTracklet].firstClusterIndex != nextLayerClusterIndex) {
-          break;
-        }
-        const Tracklet& nextTracklet{tf->getTracklets()[iLayer + 1][iNextTracklet]};
-        const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
+      const Tracklet& nextTracklet{tf->getTracklets()[iLayer + 1][iNextTracklet]};
+      const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextLayerSoA.tanLambda[iNextTracklet])};
 
 #ifdef OPTIMISATION_OUTPUT
-        bool good{tf->getTrackletsLabel(iLayer)[iTracklet] == tf->getTrackletsLabel(iLayer + 1)[iNextTracklet]};
-        float signedDelta{currentTracklet.tanLambda - nextTracklet.tanLambda};
-        off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, good, signedDelta, signedDelta / (mTrkParams[iteration].CellDeltaTanLambdaSigma), tanLambda, resolution) << std::endl;
+      bool good{tf->getTrackletsLabel(iLayer)[iTracklet] == tf->getTrackletsLabel(iLayer + 1)[iNextTracklet]};
+      float signedDelta{currentTracklet.tanLambda - nextTracklet.tanLambda};
+      off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, good, signedDelta, signedDelta / (mTrkParams[iteration].CellDeltaTanLambdaSigma), tanLambda, resolution) << std::endl;
 #endif
 
-        if (deltaTanLambda / mTrkParams[iteration].CellDeltaTanLambdaSigma < mTrkParams[iteration].NSigmaCut) {
+      if (deltaTanLambda / mTrkParams[iteration].CellDeltaTanLambdaSigma < mTrkParams[iteration].NSigmaCut) {
 
-          /// Track seed preparation. Clusters are numbered progressively from the innermost going outward.
-          const int clusId[3]{
-            mTimeFrame->getClusters()[iLayer][currentTracklet.firstClusterIndex].clusterId,
-            mTimeFrame->getClusters()[iLayer + 1][nextTracklet.firstClusterIndex].clusterId,
-            mTimeFrame->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex].clusterId};
-          const auto& cluster1_glo = mTimeFrame->getUnsortedClusters()[iLayer].at(clusId[0]);
-          const auto& cluster2_glo = mTimeFrame->getUnsortedClusters()[iLayer + 1].at(clusId[1]);
-          const auto& cluster3_tf = mTimeFrame->getTrackingFrameInfoOnLayer(iLayer + 2).at(clusId[2]);
-          auto track{buildTrackSeed(cluster1_glo, cluster2_glo, cluster3_tf)};
+        /// Track seed preparation. Clusters are numbered progressively from the innermost going outward.
+        const int clusId[3]{
+          mTimeFrame->getClusters()[iLayer][currentTracklet.firstClusterIndex].clusterId,
+          mTimeFrame->getClusters()[iLayer + 1][nextTracklet.firstClusterIndex].clusterId,
+          mTimeFrame->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex].clusterId};
+        const auto& cluster1_glo = mTimeFrame->getUnsortedClusters()[iLayer].at(clusId[0]);
+        const auto& cluster2_glo = mTimeFrame->getUnsortedClusters()[iLayer + 1].at(clusId[1]);
+        const auto& cluster3_tf = mTimeFrame->getTrackingFrameInfoOnLayer(iLayer + 2).at(clusId[2]);
+        auto track{buildTrackSeed(cluster1_glo, cluster2_glo, cluster3_tf)};
 
-          float chi2{0.f};
-          bool good{false};
-          for (int iC{2}; iC--;) {
-            const TrackingFrameInfo& trackingHit = mTimeFrame->getTrackingFrameInfoOnLayer(iLayer + iC).at(clusId[iC]);
+        float chi2{0.f};
+        bool good{false};
+        for (int iC{2}; iC--;) {
+          const TrackingFrameInfo& trackingHit = mTimeFrame->getTrackingFrameInfoOnLayer(iLayer + iC).at(clusId[iC]);
 
-            if (!track.rotate(trackingHit.alphaTrackingFrame)) {
-              break;
-            }
-
-            if (!track.propagateTo(trackingHit.xTrackingFrame, getBz())) {
-              break;
-            }
+          if (!track.rotate(trackingHit.alphaTrackingFrame)) {
+            break;
+          }
 
-            constexpr float radl = 9.36f; // Radiation length of Si [cm]
-            constexpr float rho = 2.33f;  // Density of Si [g/cm^3]
-            if (!track.correctForMaterial(mTrkParams[0].LayerxX0[iLayer + iC], mTrkParams[0].LayerxX0[iLayer] * radl * rho, true)) {
-              break;
-            }
+          if (!track.propagateTo(trackingHit.xTrackingFrame, getBz())) {
+            break;
+          }
 
-            auto predChi2{track.getPredictedChi2Quiet(trackingHit.positionTrackingFrame, trackingHit.covarianceTrackingFrame)};
-            if (!track.o2::track::TrackParCov::update(trackingHit.positionTrackingFrame, trackingHit.covarianceTrackingFrame)) {
-              break;
-            }
-            if (!iC && predChi2 > mTrkParams[iteration].MaxChi2ClusterAttachment) {
-              break;
-            }
-            good = !iC;
-            chi2 += predChi2;
+          constexpr float radl = 9.36f; // Radiation length of Si [cm]
+          constexpr float rho = 2.33f;  // Density of Si [g/cm^3]
+          if (!track.correctForMaterial(mTrkParams[0].LayerxX0[iLayer + iC], mTrkParams[0].LayerxX0[iLayer] * radl * rho, true)) {
+            break;
           }
-          if (!good) {
-            continue;
+
+          auto predChi2{track.getPredictedChi2Quiet(trackingHit.positionTrackingFrame, trackingHit.covarianceTrackingFrame)};
+          if (!track.o2::track::TrackParCov::update(trackingHit.positionTrackingFrame, trackingHit.covarianceTrackingFrame)) {
+            break;
           }
-          if (iLayer > 0 && (int)tf->getCellsLookupTable()[iLayer - 1].size() <= iTracklet) {
-            tf->getCellsLookupTable()[iLayer - 1].resize(iTracklet + 1, tf->getCells()[iLayer].size());
+          if (!iC && predChi2 > mTrkParams[iteration].MaxChi2ClusterAttachment) {
+            break;
           }
-          tf->getCells()[iLayer].emplace_back(iLayer, clusId[0], clusId[1], clusId[2],
-                                              iTracklet, iNextTracklet, track, chi2);
+          good = !iC;
+          chi2 += predChi2;
         }
+        if (!good) {
+          continue;
+        }
+        cellsOut.emplace_back(iLayer, clusId[0], clusId[1], clusId[2],
+                              iTracklet, iNextTracklet, track, chi2);
       }
     }
-    if (iLayer > 0) {
-      tf->getCellsLookupTable()[iLayer - 1].resize(currentLayerTrackletsNum + 1, tf->getCells()[iLayer].size());
+  };
+
+  if (mTrkParams[iteration].UseTaskScheduling) {
+    /// Each layer is split in chunks of tracklets processed independently, the chunks of a layer are
+    /// stitched back in order by the last of them to complete, so the result is the same as the sequential one.
+    struct CellsChunk {
+      int firstTracklet{0};
+      std::vector<CellSeed> cells;
+      std::vector<int> lut;
+    };
+    const int nLayers{mTrkParams[iteration].CellsPerRoad()};
+    std::vector<std::vector<CellsChunk>> chunks(nLayers);
+    std::unique_ptr<std::atomic<int>[]> pendingChunks{new std::atomic<int>[nLayers]};
+    for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+      const int nTracklets{static_cast<int>(tf->getTracklets()[iLayer].size())};
+      const int chunkSize{getTaskChunkSize(nTracklets)};
+      if (!tf->getTracklets()[iLayer + 1].empty()) {
+        for (int first{0}; first < nTracklets; first += chunkSize) {
+          chunks[iLayer].emplace_back().firstTracklet = first;
+        }
+      }
+      pendingChunks[iLayer] = chunks[iLayer].size();
+    }
+    executeTasks(TrackingStage::Cells, [&](auto& spawn) {
+      for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+        const int nTracklets{static_cast<int>(tf->getTracklets()[iLayer].size())};
+        for (size_t iChunk{0}; iChunk < chunks[iLayer].size(); ++iChunk) {
+          spawn([&, iLayer, iChunk, nTracklets]() {
+            auto& chunk{chunks[iLayer][iChunk]};
+            const int lastTracklet{iChunk + 1 < chunks[iLayer].size() ? chunks[iLayer][iChunk + 1].firstTracklet : nTracklets};
+            chunk.lut.reserve(lastTracklet - chunk.firstTracklet);
+            for (int iTracklet{chunk.firstTracklet}; iTracklet < lastTracklet; ++iTracklet) {
+              chunk.lut.push_back(chunk.cells.size());
+              computeCells(iLayer, iTracklet, chunk.cells);
+            }
+            if (--pendingChunks[iLayer] == 0) {
+              spawn([&, iLayer, nTracklets]() {
+                auto& cells{tf->getCells()[iLayer]};
+                size_t nCells{0};
+                for (auto& otherChunk : chunks[iLayer]) {
+                  nCells += otherChunk.cells.size();
+                }
+                cells.reserve(nCells);
+                if (iLayer > 0) {
+                  tf->getCellsLookupTable()[iLayer - 1].reserve(nTracklets + 1);
+                }
+                for (auto& otherChunk : chunks[iLayer]) {
+                  if (iLayer > 0) {
+                    for (auto& entry : otherChunk.lut) {
+                      tf->getCellsLookupTable()[iLayer - 1].push_back(entry + cells.size());
+                    }
+                  }
+                  cells.insert(cells.end(), otherChunk.cells.begin(), otherChunk.cells.end());
+                  std::vector<CellSeed>().swap(otherChunk.cells);
+                }
+                if (iLayer > 0) {
+                  tf->getCellsLookupTable()[iLayer - 1].push_back(cells.size());
+                }
+              });
+            }
+          });
+        }
+      }
+    });
+  } else {
+#pragma omp parallel for num_threads(mNThreads)
+    for (int iLayer = 0; iLayer < mTrkParams[iteration].CellsPerRoad(); ++iLayer) {
+
+      if (tf->getTracklets()[iLayer + 1].empty() ||
+          tf->getTracklets()[iLayer].empty()) {
+        continue;
+      }
+
+      const int currentLayerTrackletsNum{static_cast<int>(tf->getTracklets()[iLayer].size())};
+      if (iLayer > 0) {
+        tf->getCellsLookupTable()[iLayer - 1].reserve(currentLayerTrackletsNum + 1);
+      }
+      for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+        if (iLayer > 0) {
+          tf->getCellsLookupTable()[iLayer - 1].push_back(tf->getCells()[iLayer].size());
+        }
+        computeCells(iLayer, iTracklet, tf->getCells()[iLayer]);
+      }
+      if (iLayer > 0) {
+        tf->getCellsLookupTable()[iLayer - 1].push_back(tf->getCells()[iLayer].size());
+      }
     }
   }
   if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
@@ -404,21 +584,11 @@ void TrackerTraits::findCellsNeighbours(const int iteration)
 #ifdef OPTIMISATION_OUTPUT
   std::ofstream off(fmt::format("cellneighs{}.txt", iteration));
 #endif
-  for (int iLayer{0}; iLayer < mTrkParams[iteration].CellsPerRoad() - 1; ++iLayer) {
-    const int nextLayerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer + 1].size())};
-    mTimeFrame->getCellsNeighboursLUT()[iLayer].clear();
-    mTimeFrame->getCellsNeighboursLUT()[iLayer].resize(nextLayerCellsNum, 0);
-    if (mTimeFrame->getCells()[iLayer + 1].empty() ||
-        mTimeFrame->getCellsLookupTable()[iLayer].empty()) {
-      mTimeFrame->getCellsNeighbours()[iLayer].clear();
-      continue;
-    }
 
-    int layerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer].size())};
-    std::vector<std::pair<int, int>> cellsNeighbours;
-    cellsNeighbours.reserve(nextLayerCellsNum);
-
-    for (int iCell{0}; iCell < layerCellsNum; ++iCell) {
+  /// Collects the compatible (cell, next layer cell) pairs seeded by cells [firstCell, lastCell) of layer iLayer.
+  /// The cell levels are not touched here, as they have to be propagated layer by layer.
+  auto findNeighbours = [&](int iLayer, int firstCell, int lastCell, std::vector<std::pair<int, int>>& cellsNeighbours) {
+    for (int iCell{firstCell}; iCell < lastCell; ++iCell) {
 
       const auto& currentCellSeed{mTimeFrame->getCells()[iLayer][iCell]};
       const int nextLayerTrackletIndex{currentCellSeed.getSecondTrackletIndex()};
@@ -445,14 +615,18 @@ void TrackerTraits::findCellsNeighbours(const int iteration)
         if (chi2 > mTrkParams[0].MaxChi2ClusterAttachment) {
           continue;
         }
-
-        mTimeFrame->getCellsNeighboursLUT()[iLayer][iNextCell]++;
         cellsNeighbours.push_back(std::make_pair(iCell, iNextCell));
-        const int currentCellLevel{currentCellSeed.getLevel()};
-
-        if (currentCellLevel >= nextCellSeed.getLevel()) {
-          mTimeFrame->getCells()[iLayer + 1][iNextCell].setLevel(currentCellLevel + 1);
-        }
+      }
+    }
+  };
+
+  /// Fills the neighbours LUT of layer iLayer from the pairs found on it and propagates the cell levels outwards
+  auto storeNeighbours = [&](int iLayer, std::vector<std::pair<int, int>>& cellsNeighbours) {
+    for (auto& [iCell, iNextCell] : cellsNeighbours) {
+      mTimeFrame->getCellsNeighboursLUT()[iLayer][iNextCell]++;
+      const int currentCellLevel{mTimeFrame->getCells()[iLayer][iCell].getLevel()};
+      if (currentCellLevel >= mTimeFrame->getCells()[iLayer + 1][iNextCell].getLevel()) {
+        mTimeFrame->getCells()[iLayer + 1][iNextCell].setLevel(currentCellLevel + 1);
       }
     }
     std::sort(cellsNeighbours.begin(), cellsNeighbours.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
@@ -464,10 +638,67 @@ void TrackerTraits::findCellsNeighbours(const int iteration)
       mTimeFrame->getCellsNeighbours()[iLayer].push_back(cellNeighboursIndex.first);
     }
     std::inclusive_scan(mTimeFrame->getCellsNeighboursLUT()[iLayer].begin(), mTimeFrame->getCellsNeighboursLUT()[iLayer].end(), mTimeFrame->getCellsNeighboursLUT()[iLayer].begin());
+  };
+
+  const int nLayers{mTrkParams[iteration].CellsPerRoad() - 1};
+  std::vector<bool> hasNeighbours(nLayers, false);
+  for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+    const int nextLayerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer + 1].size())};
+    mTimeFrame->getCellsNeighboursLUT()[iLayer].clear();
+    mTimeFrame->getCellsNeighboursLUT()[iLayer].resize(nextLayerCellsNum, 0);
+    if (mTimeFrame->getCells()[iLayer + 1].empty() ||
+        mTimeFrame->getCellsLookupTable()[iLayer].empty()) {
+      mTimeFrame->getCellsNeighbours()[iLayer].clear();
+      continue;
+    }
+    hasNeighbours[iLayer] = true;
+  }
+
+  if (mTrkParams[iteration].UseTaskScheduling) {
+    /// The expensive compatibility checks of all layers run concurrently on chunks of cells, the levels
+    /// are then propagated sequentially in chunk order, which reproduces the sequential result.
+    std::vector<std::vector<std::vector<std::pair<int, int>>>> chunks(nLayers);
+    executeTasks(TrackingStage::Neighbours, [&](auto& spawn) {
+      for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+        if (!hasNeighbours[iLayer]) {
+          continue;
+        }
+        const int layerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer].size())};
+        const int chunkSize{getTaskChunkSize(layerCellsNum)};
+        chunks[iLayer].resize((layerCellsNum + chunkSize - 1) / chunkSize);
+        for (size_t iChunk{0}; iChunk < chunks[iLayer].size(); ++iChunk) {
+          spawn([&, iLayer, iChunk, chunkSize, layerCellsNum]() {
+            const int firstCell{static_cast<int>(iChunk) * chunkSize};
+            findNeighbours(iLayer, firstCell, std::min(firstCell + chunkSize, layerCellsNum), chunks[iLayer][iChunk]);
+          });
+        }
+      }
+    });
+    for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+      if (!hasNeighbours[iLayer]) {
+        continue;
+      }
+      std::vector<std::pair<int, int>> cellsNeighbours;
+      for (auto& chunk : chunks[iLayer]) {
+        cellsNeighbours.insert(cellsNeighbours.end(), chunk.begin(), chunk.end());
+        std::vector<std::pair<int, int>>().swap(chunk);
+      }
+      storeNeighbours(iLayer, cellsNeighbours);
+    }
+  } else {
+    for (int iLayer{0}; iLayer < nLayers; ++iLayer) {
+      if (!hasNeighbours[iLayer]) {
+        continue;
+      }
+      std::vector<std::pair<int, int>> cellsNeighbours;
+      cellsNeighbours.reserve(mTimeFrame->getCells()[iLayer + 1].size());
+      findNeighbours(iLayer, 0, mTimeFrame->getCells()[iLayer].size(), cellsNeighbours);
+      storeNeighbours(iLayer, cellsNeighbours);
+    }
   }
 }
 
-void TrackerTraits::processNeighbours(int iLayer, int iLevel, const std::vector<CellSeed>& currentCellSeed, const std::vector<int>& currentCellId, std::vector<CellSeed>& updatedCellSeeds, std::vector<int>& updatedCellsIds)
+void TrackerTraits::processNeighbours(const int iteration, int iLayer, int iLevel, const std::vector<CellSeed>& currentCellSeed, const std::vector<int>& currentCellId, std::vector<CellSeed>& updatedCellSeeds, std::vector<int>& updatedCellsIds)
 {
   if (iLevel < 2 || iLayer < 1) {
     std::cout << "Error: layer " << iLayer << " or level " << iLevel << " cannot be processed by processNeighbours" << std::endl;
@@ -481,16 +712,16 @@ void TrackerTraits::processNeighbours(int iLayer, int iLevel, const std::vector<
   int failed[5]{0, 0, 0, 0, 0}, attempts{0}, failedByMismatch{0};
 #endif
 
-#pragma omp parallel for num_threads(mNThreads)
-  for (unsigned int iCell = 0; iCell < currentCellSeed.size(); ++iCell) {
+  /// Extends the cell seed iCell to its neighbours on the inner layer, handing each updated seed to store
+  auto processCell = [&](unsigned int iCell, auto&& store) {
     const CellSeed& currentCell{currentCellSeed[iCell]};
     if (currentCell.getLevel() != iLevel) {
-      continue;
+      return;
     }
     if (currentCellId.empty() && (mTimeFrame->isClusterUsed(iLayer, currentCell.getFirstClusterIndex()) ||
                                   mTimeFrame->isClusterUsed(iLayer + 1, currentCell.getSecondClusterIndex()) ||
                                   mTimeFrame->isClusterUsed(iLayer + 2, currentCell.getThirdClusterIndex()))) {
-      continue; /// this we do only on the first iteration, hence the check on currentCellId
+      return; /// this we do only on the first iteration, hence the check on currentCellId
     }
     const int cellId = currentCellId.empty() ? iCell : currentCellId[iCell];
     const int startNeighbourId{cellId ? mTimeFrame->getCellsNeighboursLUT()[iLayer - 1][cellId - 1] : 0};
@@ -547,11 +778,43 @@ void TrackerTraits::processNeighbours(int iLayer, int iLevel, const std::vector<
       seed.setLevel(neighbourCell.getLevel());
       seed.setFirstTrackletIndex(neighbourCell.getFirstTrackletIndex());
       seed.setSecondTrackletIndex(neighbourCell.getSecondTrackletIndex());
-#pragma omp critical
-      {
-        updatedCellsIds.push_back(neighbourCellId);
-        updatedCellSeeds.push_back(seed);
+      store(neighbourCellId, seed);
+    }
+  };
+
+  if (mTrkParams[iteration].UseTaskScheduling) {
+    /// Chunks keep their own outputs, concatenated in order at the end: no locking and a reproducible ordering
+    const int nCells{static_cast<int>(currentCellSeed.size())};
+    const int chunkSize{getTaskChunkSize(nCells)};
+    std::vector<std::pair<std::vector<int>, std::vector<CellSeed>>> chunks((nCells + chunkSize - 1) / chunkSize);
+    executeTasks(TrackingStage::Roads, [&](auto& spawn) {
+      for (size_t iChunk{0}; iChunk < chunks.size(); ++iChunk) {
+        spawn([&, iChunk]() {
+          auto& [chunkIds, chunkSeeds] = chunks[iChunk];
+          const int lastCell{std::min(static_cast<int>(iChunk + 1) * chunkSize, nCells)};
+          for (int iCell{static_cast<int>(iChunk) * chunkSize}; iCell < lastCell; ++iCell) {
+            processCell(iCell, [&](int neighbourCellId, const CellSeed& seed) {
+              chunkIds.push_back(neighbourCellId);
+              chunkSeeds.push_back(seed);
+            });
+          }
+        });
       }
+    });
+    for (auto& [chunkIds, chunkSeeds] : chunks) {
+      updatedCellsIds.insert(updatedCellsIds.end(), chunkIds.begin(), chunkIds.end());
+      updatedCellSeeds.insert(updatedCellSeeds.end(), chunkSeeds.begin(), chunkSeeds.end());
+    }
+  } else {
+#pragma omp parallel for num_threads(mNThreads)
+    for (unsigned int iCell = 0; iCell < currentCellSeed.size(); ++iCell) {
+      processCell(iCell, [&](int neighbourCellId, const CellSeed& seed) {
+#pragma omp critical
+        {
+          updatedCellsIds.push_back(neighbourCellId);
+          updatedCellSeeds.push_back(seed);
+        }
+      });
     }
   }
 #ifdef CA_DEBUG
@@ -580,7 +843,7 @@ void TrackerTraits::findRoads(const int iteration)
       std::vector<int> lastCellId, updatedCellId;
       std::vector<CellSeed> lastCellSeed, updatedCellSeed;
 
-      processNeighbours(startLayer, startLevel, mTimeFrame->getCells()[startLayer], lastCellId, updatedCellSeed, updatedCellId);
+      processNeighbours(iteration, startLayer, startLevel, mTimeFrame->getCells()[startLayer], lastCellId, updatedCellSeed, updatedCellId);
 
       int level = startLevel;
       for (int iLayer{startLayer - 1}; iLayer > 0 && level > 2; --iLayer) {
@@ -588,7 +851,7 @@ void TrackerTraits::findRoads(const int iteration)
         lastCellId.swap(updatedCellId);
         std::vector<CellSeed>().swap(updatedCellSeed); /// tame the memory peaks
         updatedCellId.clear();
-        processNeighbours(iLayer, --level, lastCellSeed, lastCellId, updatedCellSeed, updatedCellId);
+        processNeighbours(iteration, iLayer, --level, lastCellSeed, lastCellId, updatedCellSeed, updatedCellId);
       }
       for (auto& seed : updatedCellSeed) {
         if (seed.getQ2Pt() > 1.e3 || seed.getChi2() > mTrkParams[0].MaxChi2NDF * ((startLevel + 2) * 2 - 5)) {
@@ -598,12 +861,10 @@ void TrackerTraits::findRoads(const int iteration)
       }
     }
 
-    std::vector<TrackITSExt> tracks(trackSeeds.size());
-    std::atomic<size_t> trackIndex{0};
-#pragma omp parallel for num_threads(mNThreads)
-    for (size_t seedId = 0; seedId < trackSeeds.size(); ++seedId) {
+    /// Fits the track seeded by seedId, returns false if the fit fails or the track is rejected
+    auto fitSeed = [&](size_t seedId, TrackITSExt& temporaryTrack) {
       const CellSeed& seed{trackSeeds[seedId]};
-      TrackITSExt temporaryTrack{seed};
+      temporaryTrack = TrackITSExt{seed};
       temporaryTrack.resetCovariance();
       temporaryTrack.setChi2(0);
       for (int iL{0}; iL < 7; ++iL) {
@@ -612,16 +873,43 @@ void TrackerTraits::findRoads(const int iteration)
 
       bool fitSuccess = fitTrack(temporaryTrack, 0, mTrkParams[0].NLayers, 1, mTrkParams[0].MaxChi2ClusterAttachment, mTrkParams[0].MaxChi2NDF);
       if (!fitSuccess) {
-        continue;
+        return false;
       }
       temporaryTrack.getParamOut() = temporaryTrack.getParamIn();
       temporaryTrack.resetCovariance();
       temporaryTrack.setChi2(0);
       fitSuccess = fitTrack(temporaryTrack, mTrkParams[0].NLayers - 1, -1, -1, mTrkParams[0].MaxChi2ClusterAttachment, mTrkParams[0].MaxChi2NDF, 50.f);
-      if (!fitSuccess || temporaryTrack.getPt() < mTrkParams[iteration].MinPt[mTrkParams[iteration].NLayers - temporaryTrack.getNClusters()]) {
-        continue;
+      return fitSuccess && temporaryTrack.getPt() >= mTrkParams[iteration].MinPt[mTrkParams[iteration].NLayers - temporaryTrack.getNClusters()];
+    };
+
+    std::vector<TrackITSExt> tracks(trackSeeds.size());
+    std::atomic<size_t> trackIndex{0};
+    if (mTrkParams[iteration].UseTaskScheduling) {
+      /// Keep the seed ordering so that the sorting by chi2 below is reproducible
+      std::vector<unsigned char> accepted(trackSeeds.size(), false);
+      const int chunkSize{getTaskChunkSize(trackSeeds.size())};
+      executeTasks(TrackingStage::Roads, [&](auto& spawn) {
+        for (size_t firstSeed{0}; firstSeed < trackSeeds.size(); firstSeed += chunkSize) {
+          spawn([&, firstSeed]() {
+            for (size_t seedId{firstSeed}; seedId < std::min(firstSeed + chunkSize, trackSeeds.size()); ++seedId) {
+              accepted[seedId] = fitSeed(seedId, tracks[seedId]);
+            }
+          });
+        }
+      });
+      for (size_t seedId{0}; seedId < trackSeeds.size(); ++seedId) {
+        if (accepted[seedId]) {
+          tracks[trackIndex++] = tracks[seedId];
+        }
+      }
+    } else {
+#pragma omp parallel for num_threads(mNThreads)
+      for (size_t seedId = 0; seedId < trackSeeds.size(); ++seedId) {
+        TrackITSExt temporaryTrack;
+        if (fitSeed(seedId, temporaryTrack)) {
+          tracks[trackIndex++] = temporaryTrack;
+        }
       }
-      tracks[trackIndex++] = temporaryTrack;
     }
 
     tracks.resize(trackIndex);
@@ -1012,6 +1300,17 @@ void TrackerTraits::setNThreads(int n)
 #else
   mNThreads = 1;
 #endif
+  if (mTaskArena && mTaskArena->max_concurrency() != mNThreads) {
+    mTaskArena.reset();
+  }
+}
+
+tbb::task_arena& TrackerTraits::getTaskArena()
+{
+  if (!mTaskArena) {
+    mTaskArena = std::make_shared<tbb::task_arena>(mNThreads);
+  }
+  return *mTaskArena;
 }
 
 int TrackerTraits::getTFNumberOfClusters() const
@@ -12,6 +12,7 @@
 #ifndef ALICEO2_ITSMFT_ALPIDE_CODER_H
 #define ALICEO2_ITSMFT_ALPIDE_CODER_H
 #include <Rtypes.h>
+#include <bit>
 #include <cstdio>
 #include <cstdint>
 #include <vector>
@@ -165,6 +166,129 @@ class AlpideCoder
       //
       LOGP(debug, "dataC: {:#x} expect {:#b}", int(dataC), int(expectInp));
 
+      // DATASHORT/DATALONG records make the bulk of the non-empty chip data. Their highest bit is 0, so they cannot be
+      // confused with the BUSY, chip or region markers: when expected, they are checked first
+      if ((expectInp & ExpectData) && isData(dataC)) {
+        // note that here we are checking on the byte rather than the short, need complete to ushort
+        dataS = dataC << 8;
+        if (!buffer.next(dataC)) {
+#ifdef ALPIDE_DECODING_STAT
+          chipData.setError(ChipStat::TruncatedRegion);
+#endif
+          return unexpectedEOF("CHIPDATA"); // abandon cable data
+        }
+        dataS |= dataC;
+        LOGP(debug, "dataC: {:#x} dataS: {:#x} expect {:#b} in ExpectData", int(dataC), int(dataS), int(expectInp));
+
+        // we are decoding the pixel addres, if this is a DATALONG, we will fetch the mask later
+        uint16_t dColID = (dataS & MaskEncoder) >> 10;
+        uint16_t pixID = dataS & MaskPixID;
+
+        // convert data to usual row/pixel format
+        uint16_t row = pixID >> 1;
+        // abs id of left column in double column
+        uint16_t colD = (region * NDColInReg + dColID) << 1; // TODO consider <<4 instead of *NDColInReg?
+        bool rightC = (row & 0x1) ? !(pixID & 0x1) : (pixID & 0x1); // true for right column / false for left
+
+        if (colD == colDPrev) {
+          bool skip = false;
+          if (row == rowPrev) { // this is a special test to exclude repeated data of the same pixel fired
+            skip = true;
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::RepeatingPixel);
+            chipData.addErrorInfo((uint64_t(colD + rightC) << 16) | uint64_t(row));
+#endif
+          } else if (rowPrev < 0xffff && row < rowPrev) {
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::DecreasingRow);
+            chipData.addErrorInfo((uint64_t(colD + rightC) << 16) | uint64_t(row));
+#endif
+            return unexpectedEOF("DECREASING_ROW"); // abandon cable data
+          }
+          if (skip) {
+            if ((dataS & (~MaskDColID)) == DATALONG) { // skip pattern w/o decoding
+              uint8_t hitsPattern = 0;
+              if (!buffer.next(hitsPattern)) {
+#ifdef ALPIDE_DECODING_STAT
+                chipData.setError(ChipStat::TruncatedLondData);
+#endif
+                return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
+              }
+              if (hitsPattern & (~MaskHitMap)) {
+#ifdef ALPIDE_DECODING_STAT
+                chipData.setError(ChipStat::WrongDataLongPattern);
+#endif
+                return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
+              }
+              LOGP(debug, "hitsPattern: {:#b} expect {:#b}", int(hitsPattern), int(expectInp));
+            }
+            expectInp = ExpectChipTrailer | ExpectData | ExpectRegion;
+            continue; // end of DATA(SHORT or LONG) processing
+          }
+        } else {
+          // if we start new double column, transfer the hits accumulated in the right column buffer of prev. double column
+          if (colD < colDPrev && colDPrev != 0xffff) {
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::WrongDColOrder); // abandon cable data
+#endif
+            return unexpectedEOF("Wrong column order"); // abandon cable data
+            needSorting = true;                         // effectively disabled
+          }
+          colDPrev++;
+          for (int ihr = 0; ihr < nRightCHits; ihr++) {
+            addHit(chipData, rightColHits[ihr], colDPrev);
+          }
+          nRightCHits = 0; // reset the buffer
+        }
+        rowPrev = row;
+        colDPrev = colD;
+
+        // we want to have hits sorted in column/row, so the hits in right column of given double column
+        // are first collected in the temporary buffer
+        // real columnt id is col = colD + 1;
+        if (rightC) {
+          rightColHits[nRightCHits++] = row;
+        } else {
+          addHit(chipData, row, colD); // col = colD, left column hits are added directly to the container
+        }
+
+        if ((dataS & (~MaskDColID)) == DATALONG) { // multiple hits ?
+          uint8_t hitsPattern = 0;
+          if (!buffer.next(hitsPattern)) {
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::TruncatedLondData);
+#endif
+            return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
+          }
+          LOGP(debug, "hitsPattern: {:#b} expect {:#b}", int(hitsPattern), int(expectInp));
+          if (hitsPattern & (~MaskHitMap)) {
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::WrongDataLongPattern);
+#endif
+            return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
+          }
+          for (uint32_t pattern = hitsPattern; pattern; pattern &= pattern - 1) { // loop only over the set bits, in increasing order
+            int ip = std::countr_zero(pattern);
+            uint16_t addr = pixID + ip + 1, rowE = addr >> 1;
+            if (addr & ~MaskPixID) {
+#ifdef ALPIDE_DECODING_STAT
+              chipData.setError(ChipStat::WrongRow);
+#endif
+              return unexpectedEOF(fmt::format("Non-existing encoder {} decoded, DataLong was {:x}", pixID, dataS)); // abandon cable data
+            }
+            rightC = ((rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1)); // true for right column / lalse for left
+            // the real columnt is int colE = colD + rightC;
+            if (rightC) { // same as above
+              rightColHits[nRightCHits++] = rowE;
+            } else {
+              addHit(chipData, rowE, colD); // left column hits are added directly to the container
+            }
+          }
+        }
+        expectInp = ExpectChipTrailer | ExpectData | ExpectRegion;
+        continue; // end of DATA(SHORT or LONG) processing
+      }
+
       // Busy ON / OFF can appear at any point of the data stream, checking it with priority
       if (dataC == BUSYON) {
 #ifdef ALPIDE_DECODING_STAT
@@ -251,127 +375,9 @@ class AlpideCoder
         break;
       }
 
-      // hit info ?
+      // hit info was expected but the word is not DATASHORT or DATALONG
       if ((expectInp & ExpectData)) {
-        if (isData(dataC)) { // region header was seen, expect data
-                             // note that here we are checking on the byte rather than the short, need complete to ushort
-          dataS = dataC << 8;
-          if (!buffer.next(dataC)) {
-#ifdef ALPIDE_DECODING_STAT
-            chipData.setError(ChipStat::TruncatedRegion);
-#endif
-            return unexpectedEOF("CHIPDATA"); // abandon cable data
-          }
-          dataS |= dataC;
-          LOGP(debug, "dataC: {:#x} dataS: {:#x} expect {:#b} in ExpectData", int(dataC), int(dataS), int(expectInp));
-
-          // we are decoding the pixel addres, if this is a DATALONG, we will fetch the mask later
-          uint16_t dColID = (dataS & MaskEncoder) >> 10;
-          uint16_t pixID = dataS & MaskPixID;
-
-          // convert data to usual row/pixel format
-          uint16_t row = pixID >> 1;
-          // abs id of left column in double column
-          uint16_t colD = (region * NDColInReg + dColID) << 1; // TODO consider <<4 instead of *NDColInReg?
-          bool rightC = (row & 0x1) ? !(pixID & 0x1) : (pixID & 0x1); // true for right column / false for left
-
-          if (colD == colDPrev) {
-            bool skip = false;
-            if (row == rowPrev) { // this is a special test to exclude repeated data of the same pixel fired
-              skip = true;
-#ifdef ALPIDE_DECODING_STAT
-              chipData.setError(ChipStat::RepeatingPixel);
-              chipData.addErrorInfo((uint64_t(colD + rightC) << 16) | uint64_t(row));
-#endif
-            } else if (rowPrev < 0xffff && row < rowPrev) {
-#ifdef ALPIDE_DECODING_STAT
-              chipData.setError(ChipStat::DecreasingRow);
-              chipData.addErrorInfo((uint64_t(colD + rightC) << 16) | uint64_t(row));
-#endif
-              return unexpectedEOF("DECREASING_ROW"); // abandon cable data
-            }
-            if (skip) {
-              if ((dataS & (~MaskDColID)) == DATALONG) { // skip pattern w/o decoding
-                uint8_t hitsPattern = 0;
-                if (!buffer.next(hitsPattern)) {
-#ifdef ALPIDE_DECODING_STAT
-                  chipData.setError(ChipStat::TruncatedLondData);
-#endif
-                  return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
-                }
-                if (hitsPattern & (~MaskHitMap)) {
-#ifdef ALPIDE_DECODING_STAT
-                  chipData.setError(ChipStat::WrongDataLongPattern);
-#endif
-                  return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
-                }
-                LOGP(debug, "hitsPattern: {:#b} expect {:#b}", int(hitsPattern), int(expectInp));
-              }
-              expectInp = ExpectChipTrailer | ExpectData | ExpectRegion;
-              continue; // end of DATA(SHORT or LONG) processing
-            }
-          } else {
-            // if we start new double column, transfer the hits accumulated in the right column buffer of prev. double column
-            if (colD < colDPrev && colDPrev != 0xffff) {
-#ifdef ALPIDE_DECODING_STAT
-              chipData.setError(ChipStat::WrongDColOrder); // abandon cable data
-#endif
-              return unexpectedEOF("Wrong column order"); // abandon cable data
-              needSorting = true;                         // effectively disabled
-            }
-            colDPrev++;
-            for (int ihr = 0; ihr < nRightCHits; ihr++) {
-              addHit(chipData, rightColHits[ihr], colDPrev);
-            }
-            nRightCHits = 0; // reset the buffer
-          }
-          rowPrev = row;
-          colDPrev = colD;
-
-          // we want to have hits sorted in column/row, so the hits in right column of given double column
-          // are first collected in the temporary buffer
-          // real columnt id is col = colD + 1;
-          if (rightC) {
-            rightColHits[nRightCHits++] = row;
-          } else {
-            addHit(chipData, row, colD); // col = colD, left column hits are added directly to the container
-          }
-
-          if ((dataS & (~MaskDColID)) == DATALONG) { // multiple hits ?
-            uint8_t hitsPattern = 0;
-            if (!buffer.next(hitsPattern)) {
-#ifdef ALPIDE_DECODING_STAT
-              chipData.setError(ChipStat::TruncatedLondData);
-#endif
-              return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
-            }
-            LOGP(debug, "hitsPattern: {:#b} expect {:#b}", int(hitsPattern), int(expectInp));
-            if (hitsPattern & (~MaskHitMap)) {
-#ifdef ALPIDE_DECODING_STAT
-              chipData.setError(ChipStat::WrongDataLongPattern);
-#endif
-              return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
-            }
-            for (int ip = 0; ip < HitMapSize; ip++) {
-              if (hitsPattern & (0x1 << ip)) {
-                uint16_t addr = pixID + ip + 1, rowE = addr >> 1;
-                if (addr & ~MaskPixID) {
-#ifdef ALPIDE_DECODING_STAT
-                  chipData.setError(ChipStat::WrongRow);
-#endif
-                  return unexpectedEOF(fmt::format("Non-existing encoder {} decoded, DataLong was {:x}", pixID, dataS)); // abandon cable data
-                }
-                rightC = ((rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1)); // true for right column / lalse for left
-                // the real columnt is int colE = colD + rightC;
-                if (rightC) { // same as above
-                  rightColHits[nRightCHits++] = rowE;
-                } else {
-                  addHit(chipData, rowE, colD); // left column hits are added directly to the container
-                }
-              }
-            }
-          }
-        } else if (ChipStat::getAPENonCritical(dataC) >= 0) { // check for recoverable APE, if on: continue with ExpectChipTrailer | ExpectData | ExpectRegion expectation
+        if (ChipStat::getAPENonCritical(dataC) >= 0) { // check for recoverable APE, if on: continue with ExpectChipTrailer | ExpectData | ExpectRegion expectation
 #ifdef ALPIDE_DECODING_STAT
           chipData.setError(ChipStat::DecErrors(ChipStat::getAPENonCritical(dataC)));
 #endif
@@ -387,6 +393,7 @@ class AlpideCoder
 
       if (!dataC) {
         if (expectInp == ExpectNextChip) {
+          buffer.skipZeros(); // the padding usually spans many bytes
           continue;
         }
         chipData.setError(ChipStat::TruncatedBuffer);
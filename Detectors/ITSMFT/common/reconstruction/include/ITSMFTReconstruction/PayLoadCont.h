@@ -12,6 +12,7 @@
 #ifndef ALICEO2_ITSMFT_PAYLOADCONT_H
 #define ALICEO2_ITSMFT_PAYLOADCONT_H
 
+#include <cstdint>
 #include <cstring>
 #include <vector>
 #include <functional>
@@ -188,6 +189,24 @@ class PayLoadCont
     return false;
   }
 
+  ///< skip the 0 bytes starting from the current position, testing 8 bytes at once, return number of bytes skipped
+  size_t skipZeros()
+  {
+    auto ptr0 = mPtr;
+    uint64_t word = 0;
+    while (mPtr + sizeof(word) <= mEnd) {
+      std::memcpy(&word, mPtr, sizeof(word));
+      if (word) {
+        break;
+      }
+      mPtr += sizeof(word);
+    }
+    while (mPtr < mEnd && !*mPtr) {
+      mPtr++;
+    }
+    return mPtr - ptr0;
+  }
+
   ///< move current pointer to the head
   void rewind() { mPtr = mBuffer.data(); }
 
@@ -0,0 +1,72 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PixelDataBuffer.h
+/// \brief Definition of the buffer of decoded chips data of several ROFs, served as a PixelReader
+
+#ifndef ALICEO2_ITSMFT_PIXELDATABUFFER_H
+#define ALICEO2_ITSMFT_PIXELDATABUFFER_H
+
+#include "ITSMFTReconstruction/PixelReader.h"
+#include "ITSMFTReconstruction/PixelData.h"
+#include "CommonDataFormat/InteractionRecord.h"
+#include <vector>
+
+namespace o2
+{
+namespace itsmft
+{
+
+/// Buffer taking over the fired chips of consecutive ROFs prepared by another reader (e.g. the raw data decoder),
+/// so that they can be clusterized while the reader is decoding the next ROFs.
+/// The chips data are swapped rather than copied, the buffer keeps the allocated chips for reuse after the clear().
+class PixelDataBuffer final : public PixelReader
+{
+ public:
+  struct ROFEntry {
+    o2::InteractionRecord ir{};
+    o2::InteractionRecord irHB{};
+    uint32_t trigger = 0;
+    int firstChip = 0;
+    int nChips = 0;
+  };
+
+  PixelDataBuffer() = default;
+  ~PixelDataBuffer() final = default;
+
+  void init() final {}
+  bool getNextChipData(ChipPixelData& chipData) final;
+  ChipPixelData* getNextChipData(std::vector<ChipPixelData>& chipDataVec) final;
+  int decodeNextTrigger() final;
+
+  /// move the fired chips of the ROF currently prepared by the reader to the buffer
+  int addROF(PixelReader& reader);
+
+  /// drop buffered ROFs and rewind
+  void clear();
+
+  void setNChips(int n) { mChipsScratch.resize(n); }
+  int getNROFs() const { return mROFs.size(); }
+  const auto& getROFs() const { return mROFs; }
+
+ private:
+  std::vector<ROFEntry> mROFs;              // buffered ROFs
+  std::vector<ChipPixelData> mChips;        // chips of all buffered ROFs, in the order they were added
+  std::vector<ChipPixelData> mChipsScratch; // chipID-indexed container for fetching the chips from the reader
+  int mNChips = 0;                          // number of chips in use in the mChips
+  int mCurROF = -1;                         // ROF currently served
+  int mCurChip = 0;                         // next chip to serve
+};
+
+} // namespace itsmft
+} // namespace o2
+
+#endif /* ALICEO2_ITSMFT_PIXELDATABUFFER_H */
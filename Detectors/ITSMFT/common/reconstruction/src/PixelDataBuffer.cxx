@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PixelDataBuffer.cxx
+/// \brief Implementation of the buffer of decoded chips data of several ROFs
+
+#include "ITSMFTReconstruction/PixelDataBuffer.h"
+
+using namespace o2::itsmft;
+
+//______________________________________________________________________________
+int PixelDataBuffer::addROF(PixelReader& reader)
+{
+  // take over the chips of the ROF prepared by the reader, which must not be in the auto-decoding mode
+  auto& rof = mROFs.emplace_back(ROFEntry{reader.getInteractionRecord(), reader.getInteractionRecordHB(), reader.getTrigger(), mNChips, 0});
+  ChipPixelData* chipData = nullptr;
+  while ((chipData = reader.getNextChipData(mChipsScratch))) {
+    if (mNChips == int(mChips.size())) {
+      mChips.emplace_back();
+    }
+    mChips[mNChips++].swap(*chipData);
+    rof.nChips++;
+  }
+  return rof.nChips;
+}
+
+//______________________________________________________________________________
+int PixelDataBuffer::decodeNextTrigger()
+{
+  // prepare the next buffered ROF, return the number of its fired chips or -1 if there are no ROFs left
+  if (++mCurROF >= int(mROFs.size())) {
+    mCurROF = mROFs.size();
+    mInteractionRecord.clear();
+    return -1;
+  }
+  const auto& rof = mROFs[mCurROF];
+  mInteractionRecord = rof.ir;
+  mInteractionRecordHB = rof.irHB;
+  mTrigger = rof.trigger;
+  mCurChip = rof.firstChip;
+  return rof.nChips;
+}
+
+//______________________________________________________________________________
+ChipPixelData* PixelDataBuffer::getNextChipData(std::vector<ChipPixelData>& chipDataVec)
+{
+  // provide the next chip of the current ROF in the slot of chipDataVec corresponding to its chipID
+  if (mCurROF >= 0 && mCurROF < int(mROFs.size()) && mCurChip < mROFs[mCurROF].firstChip + mROFs[mCurROF].nChips) {
+    auto& chipData = mChips[mCurChip++];
+    auto& dest = chipDataVec[chipData.getChipID()];
+    dest.swap(chipData);
+    return &dest;
+  }
+  if (!mDecodeNextAuto || decodeNextTrigger() < 0) { // no more data
+    return nullptr;
+  }
+  return getNextChipData(chipDataVec);
+}
+
+//______________________________________________________________________________
+bool PixelDataBuffer::getNextChipData(ChipPixelData& chipData)
+{
+  // provide the next chip of the current ROF in chipData
+  if (mCurROF >= 0 && mCurROF < int(mROFs.size()) && mCurChip < mROFs[mCurROF].firstChip + mROFs[mCurROF].nChips) {
+    chipData.swap(mChips[mCurChip++]);
+    return true;
+  }
+  if (!mDecodeNextAuto || decodeNextTrigger() < 0) { // no more data
+    return false;
+  }
+  return getNextChipData(chipData);
+}
+
+//______________________________________________________________________________
+void PixelDataBuffer::clear()
+{
+  mROFs.clear();
+  mNChips = 0;
+  mCurROF = -1;
+  mCurChip = 0;
+  mInteractionRecord.clear();
+}
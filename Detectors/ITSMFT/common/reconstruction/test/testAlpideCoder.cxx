@@ -0,0 +1,294 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testAlpideCoder.cxx
+/// \brief check the ALPIDE chip data decoding and the clusterization of the ROFs buffered in PixelDataBuffer
+
+#define BOOST_TEST_MODULE Test ITSMFT AlpideCoder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+#include "ITSMFTReconstruction/PixelData.h"
+#include "ITSMFTReconstruction/PixelDataBuffer.h"
+#include "ITSMFTReconstruction/DigitPixelReader.h"
+#include "ITSMFTReconstruction/Clusterer.h"
+#include "DataFormatsITSMFT/Digit.h"
+#include "DataFormatsITSMFT/ROFRecord.h"
+#include <algorithm>
+#include <array>
+#include <future>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace o2::itsmft;
+
+namespace
+{
+
+using Pixels = std::set<std::pair<int, int>>; // fired pixels as (column, row)
+
+/// fired pixels of a chip: isolated pixels, blocks of neighbouring pixels giving DATALONG records
+/// with various hit maps, the full double column at the left edge and the last rows at the right edge
+Pixels generatePixels(std::mt19937& gen, int nIsolated, int nBlocks)
+{
+  std::uniform_int_distribution<int> col(0, AlpideCoder::NCols - 1);
+  std::uniform_int_distribution<int> row(0, AlpideCoder::NRows - 1);
+  std::bernoulli_distribution fired(0.6);
+  Pixels pixels{};
+  for (int i = 0; i < nIsolated; ++i) {
+    pixels.emplace(col(gen), row(gen));
+  }
+  for (int i = 0; i < nBlocks; ++i) {
+    int c0 = col(gen), r0 = row(gen);
+    for (int c = c0; c < std::min(c0 + 3, AlpideCoder::NCols); ++c) {
+      for (int r = r0; r < std::min(r0 + 6, AlpideCoder::NRows); ++r) {
+        if (fired(gen)) {
+          pixels.emplace(c, r);
+        }
+      }
+    }
+  }
+  for (int r = 0; r < AlpideCoder::NRows; ++r) {
+    pixels.emplace(0, r);
+    pixels.emplace(1, r);
+  }
+  for (int r = AlpideCoder::NRows - 9; r < AlpideCoder::NRows; ++r) {
+    pixels.emplace(AlpideCoder::NCols - 1, r);
+  }
+  return pixels;
+}
+
+/// encode the chip with the pixels, which must be given to the encoder sorted in row/column
+void encodeChip(AlpideCoder& coder, PayLoadCont& buffer, const Pixels& pixels, int chipInModule, int bc)
+{
+  ChipPixelData chipData{};
+  chipData.setChipID(chipInModule);
+  for (const auto& [col, row] : pixels) {
+    chipData.getData().emplace_back(row, col);
+  }
+  std::sort(chipData.getData().begin(), chipData.getData().end(), [](const PixelData& a, const PixelData& b) {
+    return a.getRow() < b.getRow() || (a.getRow() == b.getRow() && a.getCol() < b.getCol());
+  });
+  buffer.ensureFreeCapacity(4 * pixels.size() + 1024);
+  coder.encodeChip(buffer, chipData, chipInModule, bc);
+}
+
+void addZeros(PayLoadCont& buffer, size_t n)
+{
+  buffer.ensureFreeCapacity(n);
+  buffer.fillFast(0, n);
+}
+
+Pixels getPixels(const ChipPixelData& chipData)
+{
+  Pixels pixels{};
+  for (const auto& pixel : chipData.getData()) {
+    pixels.emplace(pixel.getCol(), pixel.getRow());
+  }
+  return pixels;
+}
+
+/// the decoded hits must come sorted in column/row
+void checkDecodedOrder(const ChipPixelData& chipData)
+{
+  const auto& data = chipData.getData();
+  for (size_t i = 1; i < data.size(); ++i) {
+    BOOST_CHECK(data[i - 1].getCol() < data[i].getCol() || (data[i - 1].getCol() == data[i].getCol() && data[i - 1].getRow() < data[i].getRow()));
+  }
+}
+
+auto chipIDGetter = [](int chipInModule) { return uint16_t(chipInModule); };
+
+/// Digits of the ROFs of a few chips, sorted in chip/column/row in each ROF
+void generateDigits(std::vector<Digit>& digits, std::vector<ROFRecord>& rofs, int nROFs, int nChips)
+{
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> nFiredChips(0, nChips);
+  std::uniform_int_distribution<int> chip(0, nChips - 1);
+  for (int iROF = 0; iROF < nROFs; ++iROF) {
+    std::vector<Pixels> chipPixels(nChips);
+    for (int i = nFiredChips(gen); i--;) {
+      chipPixels[chip(gen)] = generatePixels(gen, 30, 20);
+    }
+    int first = digits.size();
+    for (int iChip = 0; iChip < nChips; ++iChip) {
+      for (const auto& [col, row] : chipPixels[iChip]) {
+        digits.emplace_back(iChip, row, col, 100);
+      }
+    }
+    o2::InteractionRecord ir(0, 256 + 2 * iROF);
+    rofs.emplace_back(ir, iROF, first, digits.size() - first);
+  }
+}
+
+struct ClusterizationOutput {
+  CompClusCont clusters;
+  PatternCont patterns;
+  ROFRecCont rofs;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(AlpideCoder_RoundTrip)
+{
+  // several chips with DATASHORT and DATALONG records, separated by empty chips and zero padding of various lengths,
+  // including at the beginning and the end of the buffer
+  std::mt19937 gen(1234);
+  AlpideCoder coder{};
+  PayLoadCont buffer(1024);
+  std::vector<Pixels> expected{};
+  std::vector<int> expectedIDs{};
+  addZeros(buffer, 3);
+  for (int iChip = 0; iChip < 9; ++iChip) {
+    if (iChip % 3 == 1) {
+      buffer.ensureFreeCapacity(2);
+      coder.addEmptyChip(buffer, iChip, 100);
+      continue;
+    }
+    expected.push_back(generatePixels(gen, 50 * iChip, 10 * iChip));
+    expectedIDs.push_back(iChip);
+    encodeChip(coder, buffer, expected.back(), iChip, 100);
+    addZeros(buffer, iChip * 5); // 0, 10, 15, ... bytes of padding
+  }
+  addZeros(buffer, 13);
+
+  ChipPixelData chipData{};
+  std::vector<uint16_t> seenChips{};
+  size_t nDecoded = 0;
+  int ret = 0;
+  while ((ret = AlpideCoder::decodeChip(chipData, buffer, seenChips, chipIDGetter)) > 0) {
+    BOOST_REQUIRE_LT(nDecoded, expected.size());
+    BOOST_CHECK(!chipData.isErrorSet());
+    BOOST_CHECK_EQUAL(chipData.getChipID(), expectedIDs[nDecoded]);
+    BOOST_CHECK_EQUAL(ret, int(expected[nDecoded].size()));
+    checkDecodedOrder(chipData);
+    BOOST_CHECK(getPixels(chipData) == expected[nDecoded]);
+    ++nDecoded;
+  }
+  BOOST_CHECK_EQUAL(ret, 0);
+  BOOST_CHECK_EQUAL(nDecoded, expected.size());
+  BOOST_CHECK_EQUAL(seenChips.size(), 9u);
+  BOOST_CHECK(buffer.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(AlpideCoder_RepeatedPixels)
+{
+  // hand-made chip record with a repeated DATASHORT and a repeated DATALONG, which must be decoded once
+  PayLoadCont buffer(64);
+  buffer.addFast(uint8_t(AlpideCoder::CHIPHEADER | 3));
+  buffer.addFast(uint8_t(0)); // timestamp
+  buffer.addFast(uint8_t(AlpideCoder::REGION | 5));
+  // double column 2, address 100: row 50, left column
+  buffer.addFast(uint16_t(AlpideCoder::DATASHORT | (2 << 10) | 100));
+  buffer.addFast(uint16_t(AlpideCoder::DATASHORT | (2 << 10) | 100));
+  // double column 3, address 10: row 5, right column, with the addresses 11 (row 5, left) and 13 (row 6, right)
+  buffer.addFast(uint16_t(AlpideCoder::DATALONG | (3 << 10) | 10));
+  buffer.addFast(uint8_t(0x05));
+  buffer.addFast(uint16_t(AlpideCoder::DATALONG | (3 << 10) | 10));
+  buffer.addFast(uint8_t(0x05));
+  buffer.addFast(uint8_t(AlpideCoder::CHIPTRAILER));
+  buffer.fillFast(0, 7);
+
+  ChipPixelData chipData{};
+  std::vector<uint16_t> seenChips{};
+  BOOST_CHECK_EQUAL(AlpideCoder::decodeChip(chipData, buffer, seenChips, chipIDGetter), 4);
+  BOOST_CHECK_EQUAL(chipData.getChipID(), 3);
+  int colD2 = (5 * AlpideCoder::NDColInReg + 2) * 2, colD3 = (5 * AlpideCoder::NDColInReg + 3) * 2;
+  Pixels expected{{colD2, 50}, {colD3, 5}, {colD3 + 1, 5}, {colD3 + 1, 6}};
+  BOOST_CHECK(getPixels(chipData) == expected);
+  checkDecodedOrder(chipData);
+#ifdef ALPIDE_DECODING_STAT
+  BOOST_CHECK(chipData.isErrorSet(ChipStat::RepeatingPixel));
+#endif
+  BOOST_CHECK_EQUAL(AlpideCoder::decodeChip(chipData, buffer, seenChips, chipIDGetter), 0);
+  BOOST_CHECK(buffer.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(PixelDataBuffer_SameClusters)
+{
+  // clusterize the ROFs one by one from the reader, and in batches moved to two PixelDataBuffer's clusterized
+  // in a separate thread while the next batch is filled, as in the pipelined mode of the STFDecoder
+  constexpr int nChips = 8, nROFs = 23, batchSize = 5;
+  std::vector<Digit> digits{};
+  std::vector<ROFRecord> digROFs{};
+  generateDigits(digits, digROFs, nROFs, nChips);
+
+  auto run = [&](bool pipeline) {
+    ClusterizationOutput out{};
+    DigitPixelReader reader{};
+    reader.setDigits(digits);
+    reader.setROFRecords(digROFs);
+    reader.init();
+    reader.setDecodeNextAuto(false);
+    Clusterer clusterer{};
+    clusterer.setNChips(nChips);
+    std::array<PixelDataBuffer, 2> buffers{};
+    buffers[0].setNChips(nChips);
+    buffers[1].setNChips(nChips);
+    int curBuffer = 0;
+    std::future<void> clusFuture;
+    auto clusterizeBuffer = [&clusterer, &out](PixelDataBuffer* buffer) {
+      while (buffer->decodeNextTrigger() >= 0) {
+        clusterer.process(1, *buffer, &out.clusters, &out.patterns, &out.rofs);
+      }
+    };
+    auto flushBuffer = [&](bool async) {
+      if (clusFuture.valid()) {
+        clusFuture.get();
+      }
+      if (async) {
+        clusFuture = std::async(std::launch::async, clusterizeBuffer, &buffers[curBuffer]);
+        curBuffer ^= 1;
+        buffers[curBuffer].clear();
+      } else {
+        clusterizeBuffer(&buffers[curBuffer]);
+      }
+    };
+    while (reader.decodeNextTrigger() > 0) {
+      if (pipeline) {
+        buffers[curBuffer].addROF(reader);
+        if (buffers[curBuffer].getNROFs() >= batchSize) {
+          flushBuffer(true);
+        }
+      } else {
+        clusterer.process(1, reader, &out.clusters, &out.patterns, &out.rofs);
+      }
+    }
+    if (pipeline) {
+      flushBuffer(false);
+    }
+    return out;
+  };
+
+  auto sequential = run(false);
+  auto pipelined = run(true);
+
+  BOOST_REQUIRE_GT(sequential.clusters.size(), 0);
+  BOOST_REQUIRE_EQUAL(pipelined.rofs.size(), sequential.rofs.size());
+  for (size_t i = 0; i < sequential.rofs.size(); ++i) {
+    BOOST_CHECK(pipelined.rofs[i].getBCData() == sequential.rofs[i].getBCData());
+    BOOST_CHECK_EQUAL(pipelined.rofs[i].getROFrame(), sequential.rofs[i].getROFrame());
+    BOOST_CHECK_EQUAL(pipelined.rofs[i].getFirstEntry(), sequential.rofs[i].getFirstEntry());
+    BOOST_CHECK_EQUAL(pipelined.rofs[i].getNEntries(), sequential.rofs[i].getNEntries());
+  }
+  BOOST_REQUIRE_EQUAL(pipelined.clusters.size(), sequential.clusters.size());
+  for (size_t i = 0; i < sequential.clusters.size(); ++i) {
+    BOOST_CHECK_EQUAL(pipelined.clusters[i].getChipID(), sequential.clusters[i].getChipID());
+    BOOST_CHECK_EQUAL(pipelined.clusters[i].getRow(), sequential.clusters[i].getRow());
+    BOOST_CHECK_EQUAL(pipelined.clusters[i].getCol(), sequential.clusters[i].getCol());
+    BOOST_CHECK_EQUAL(pipelined.clusters[i].getPatternID(), sequential.clusters[i].getPatternID());
+  }
+  BOOST_CHECK(pipelined.patterns == sequential.patterns);
+}
@@ -19,12 +19,14 @@
 #include <TStopwatch.h>
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
+#include <array>
 #include <memory>
 #include <string>
 #include <string_view>
 #include "ITSMFTReconstruction/ChipMappingITS.h"
 #include "ITSMFTReconstruction/ChipMappingMFT.h"
 #include "ITSMFTReconstruction/RawPixelDecoder.h"
+#include "ITSMFTReconstruction/PixelDataBuffer.h"
 
 using namespace o2::framework;
 
@@ -84,6 +86,7 @@ class STFDecoder : public Task
   bool mDumpFrom1stPipeline = false;
   int mDumpOnError = 0;
   int mNThreads = 1;
+  int mPipelineROFs = 0; // if > 0, clusterize the ROFs in batches of this size while decoding the next batch
   int mVerbosity = 0;
   long mROFErrRepIntervalMS = 0;
   size_t mTFCounter = 0;
@@ -98,6 +101,7 @@ class STFDecoder : public Task
   std::string mSelfName;
   std::unique_ptr<RawPixelDecoder<Mapping>> mDecoder;
   std::unique_ptr<Clusterer> mClusterer;
+  std::array<PixelDataBuffer, 2> mPixelBuffers; // double buffer of decoded ROFs for the pipelined clusterization
   std::shared_ptr<o2::base::GRPGeomRequest> mGGCCDBRequest;
 };
 
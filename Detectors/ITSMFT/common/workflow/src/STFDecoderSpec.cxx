@@ -14,6 +14,7 @@
 /// \author ruben.shahoyan@cern.ch
 
 #include <vector>
+#include <future>
 
 #include "Framework/WorkflowSpec.h"
 #include "Framework/ConfigParamRegistry.h"
@@ -85,6 +86,7 @@ void STFDecoder<Mapping>::init(InitContext& ic)
     mROFErrRepIntervalMS = fr <= 0. ? -1 : long(fr * 1e3);
     mNThreads = std::max(1, ic.options().get<int>("nthreads"));
     mDecoder->setNThreads(mNThreads);
+    mPipelineROFs = std::max(0, ic.options().get<int>("pipeline-rofs"));
     mUnmutExtraLanes = ic.options().get<bool>("unmute-extra-lanes");
     mVerbosity = ic.options().get<int>("decoder-verbosity");
     auto dmpSz = ic.options().get<int>("stop-raw-data-dumps-after-size");
@@ -121,6 +123,10 @@ void STFDecoder<Mapping>::init(InitContext& ic)
   if (mDoClusters) {
     mClusterer = std::make_unique<Clusterer>();
     mClusterer->setNChips(Mapping::getNChips());
+    for (auto& buffer : mPixelBuffers) {
+      buffer.setNChips(Mapping::getNChips());
+      buffer.setDecodeNextAuto(false);
+    }
   }
 }
 
@@ -170,6 +176,32 @@ void STFDecoder<Mapping>::run(ProcessingContext& pc)
     }
 
     mDecoder->setDecodeNextAuto(false);
+
+    // in the pipelined mode the decoded ROFs are accumulated in one buffer while those of the other one are being clusterized
+    bool pipelineClusters = mDoClusters && mPipelineROFs > 0 && !mClusterer->getMaxROFDepthToSquash();
+    int curBuffer = 0;
+    std::future<void> clusFuture;
+    auto clusterizeBuffer = [this, &clusCompVec, &clusPattVec, &clusROFVec](PixelDataBuffer* buffer) {
+      while (buffer->decodeNextTrigger() >= 0) {
+        mClusterer->process(mNThreads, *buffer, &clusCompVec, mDoPatterns ? &clusPattVec : nullptr, &clusROFVec);
+      }
+    };
+    auto flushBuffer = [&](bool async) {
+      if (clusFuture.valid()) {
+        clusFuture.get(); // the clusterization of the previous batch must be finished before starting the new one
+      }
+      if (async) {
+        clusFuture = std::async(std::launch::async, clusterizeBuffer, &mPixelBuffers[curBuffer]);
+        curBuffer ^= 1;
+        mPixelBuffers[curBuffer].clear();
+      } else {
+        clusterizeBuffer(&mPixelBuffers[curBuffer]);
+      }
+    };
+    if (pipelineClusters) {
+      mPixelBuffers[curBuffer].clear();
+    }
+
     o2::InteractionRecord lastIR{}, firstIR{0, pc.services().get<o2::framework::TimingInfo>().firstTForbit};
     int nTriggersProcessed = mDecoder->getNROFsProcessed();
     static long lastErrReportTS = 0;
@@ -191,10 +223,18 @@ void STFDecoder<Mapping>::run(ProcessingContext& pc)
           mDecoder->fillCalibData(calVec);
         }
       }
-      if (mDoClusters && !mClusterer->getMaxROFDepthToSquash()) { // !!! THREADS !!!
+      if (pipelineClusters) {
+        mPixelBuffers[curBuffer].addROF(*mDecoder.get());
+        if (mPixelBuffers[curBuffer].getNROFs() >= mPipelineROFs) {
+          flushBuffer(true);
+        }
+      } else if (mDoClusters && !mClusterer->getMaxROFDepthToSquash()) { // !!! THREADS !!!
         mClusterer->process(mNThreads, *mDecoder.get(), &clusCompVec, mDoPatterns ? &clusPattVec : nullptr, &clusROFVec);
       }
     }
+    if (pipelineClusters) {
+      flushBuffer(false); // wait for the last batch in flight and clusterize the remaining ROFs
+    }
     nTriggersProcessed = mDecoder->getNROFsProcessed() - nTriggersProcessed - 1;
 
     const auto& alpParams = o2::itsmft::DPLAlpideParam<Mapping::getDetID()>::Instance();
@@ -428,6 +468,7 @@ DataProcessorSpec getSTFDecoderSpec(const STFDecoderInp& inp)
     inp.origin == o2::header::gDataOriginITS ? AlgorithmSpec{adaptFromTask<STFDecoder<ChipMappingITS>>(inp, ggRequest)} : AlgorithmSpec{adaptFromTask<STFDecoder<ChipMappingMFT>>(inp, ggRequest)},
     Options{
       {"nthreads", VariantType::Int, 1, {"Number of decoding/clustering threads"}},
+      {"pipeline-rofs", VariantType::Int, 0, {"if > 0, clusterize batches of this number of ROFs in a separate thread while decoding the next batch"}},
       {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data, 3: raw data dump) of 1st lane"}},
       {"always-parse-trigger", VariantType::Bool, false, {"parse trigger word even if flags continuation of old trigger"}},
       {"raw-data-dumps", VariantType::Int, int(GBTLink::RawDataDumps::DUMP_NONE), {"Raw data dumps on error (0: none, 1: HBF for link, 2: whole TF for all links. If negative, dump only on from 1st pipeline."}},
@@ -45,6 +45,11 @@ struct TrackerParam : public o2::conf::ConfigurableParamHelper<TrackerParam> {
   std::size_t maxCandidates = 50000; ///< maximum number of track candidates above which the tracking abort
   double maxTrackingDuration = 300.; ///< maximum tracking duration in second above which the tracking abort
 
+  int nThreads = 1; ///< number of threads used to select the pairs of clusters seeding the track candidates
+
+  /// if > 0, extrapolate the tracks with a lookup grid of the field deviating at most by this value (kG) from its parameterization
+  float fieldGridMaxError = 0.;
+
   O2ParamDef(TrackerParam, "MCHTracking");
 };
 
@@ -28,6 +28,7 @@
 #include <TH2D.h>
 
 #include "DataFormatsMCH/Digit.h"
+#include "MCHBase/PreCluster.h"
 #include "MCHMappingInterface/Segmentation.h"
 #include "MCHPreClustering/PreClusterFinder.h"
 #include "ClusterFinderOriginal.h"
@@ -68,6 +69,12 @@ class ClusterFinderGEM
   void releasePreCluster();
   //
   void findClusters(gsl::span<const Digit> digits, uint16_t bunchCrossing, uint32_t orbit, uint32_t iPreCluster);
+  /// reconstruct the clusters of consecutive preclusters (numbered from iPreCluster), in parallel
+  /// if several threads are set. The output is the same as with findClusters on each of them in order.
+  void findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits, uint16_t bunchCrossing, uint32_t orbit, uint32_t iPreCluster);
+  /// set the number of threads processing the preclusters (1 without OpenMP)
+  void setNThreads(int nThreads);
+  int getNThreads() const { return mNThreads; }
   //
   /// return the list of reconstructed clusters
 
@@ -78,6 +85,9 @@ class ClusterFinderGEM
   void dumpClusterResults(ClusterDump* dumpFile, const std::vector<Cluster>& clusters, size_t startIdx, uint16_t bunchCrossing, uint32_t orbit, uint32_t iPreCluster);
 
  private:
+  /// constructor of the clusterizers of the threads, optionally without (re)initialising the Mathieson tables
+  explicit ClusterFinderGEM(bool initMathieson);
+
   // GG Original commented
   // Invalid static constexpr double SDistancePrecision = 1.e-3;                   ///< precision used to check overlaps and so on (cm)
   // static constexpr double SLowestPadCharge = 4.f * 0.22875f;            ///< minimum charge of a pad
@@ -165,6 +175,11 @@ class ClusterFinderGEM
   uint32_t currentBC;
   uint32_t currentOrbit;
   uint32_t currentPreClusterID;
+  // Parallel processing of the preclusters
+  int mNThreads = 1;                                        ///< number of threads
+  std::vector<std::unique_ptr<ClusterFinderGEM>> mWorkers;  ///< clusterizer of each thread
+  std::vector<std::vector<Cluster>> mPreClusterClusters;    ///< clusters of each precluster of the batch
+  std::vector<std::vector<Digit>> mPreClusterDigits;        ///< digits used by the clusters of each precluster of the batch
 
   // Dump Files
   // Invalid
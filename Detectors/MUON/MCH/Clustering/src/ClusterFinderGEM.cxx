@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <exception>
 #include <iterator>
 #include <limits>
 #include <numeric>
@@ -33,10 +34,15 @@
 #include <TMath.h>
 #include <TRandom.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 // GG
 #include "PadOriginal.h"
 #include "ClusterOriginal.h"
 #include "MCHClustering/ClusterizerParam.h"
+#include "Framework/Logger.h"
 // ??? <<<<<<< HEAD
 #include "MCHBase/MathiesonOriginal.h"
 // #include "mathiesonFit.h"
@@ -59,7 +65,10 @@ namespace mch
 extern ClusterConfig clusterConfig;
 
 //_________________________________________________________________________________________________
-ClusterFinderGEM::ClusterFinderGEM()
+ClusterFinderGEM::ClusterFinderGEM() : ClusterFinderGEM(true) {}
+
+//_________________________________________________________________________________________________
+ClusterFinderGEM::ClusterFinderGEM(bool initMathieson)
   : mMathiesons(std::make_unique<MathiesonOriginal[]>(2)), mPreCluster(std::make_unique<ClusterOriginal>())
 {
   /// default constructor
@@ -74,8 +83,10 @@ ClusterFinderGEM::ClusterFinderGEM()
   mMathiesons[1].setSqrtKx3AndDeriveKx2Kx4(0.7131);
   mMathiesons[1].setSqrtKy3AndDeriveKy2Ky4(0.7642);
   // GG
-  // init Mathieson
-  o2::mch::initMathieson(clusterConfig.useSpline, 0);
+  // init Mathieson (the clusterizers of the threads use the tables of their owner)
+  if (initMathieson) {
+    o2::mch::initMathieson(clusterConfig.useSpline, 0);
+  }
   nPads = 0;
   xyDxy = nullptr;
   cathode = nullptr;
@@ -510,5 +521,92 @@ void ClusterFinderGEM::findClusters(gsl::span<const Digit> digits,
   releasePreCluster();
 }
 
+//_________________________________________________________________________________________________
+void ClusterFinderGEM::setNThreads(int nThreads)
+{
+  /// set the number of threads processing the preclusters of a batch
+#ifdef WITH_OPENMP
+  mNThreads = std::max(1, nThreads);
+#else
+  if (nThreads > 1) {
+    LOG(warning) << "ClusterFinderGEM compiled without OpenMP, using 1 thread instead of " << nThreads;
+  }
+  mNThreads = 1;
+#endif
+  // the clusterizers of the threads share the clustering configuration and
+  // the Mathieson tables of this one, initialised once in its constructor
+  mWorkers.clear();
+  if (mNThreads > 1) {
+    for (int i = 0; i < mNThreads; i++) {
+      mWorkers.emplace_back(new ClusterFinderGEM(false));
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderGEM::findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits,
+                                    uint16_t bunchCrossing, uint32_t orbit, uint32_t iPreCluster)
+{
+  /// reconstruct the clusters of consecutive preclusters
+  /// reconstructed clusters and associated digits are added to the internal lists in the precluster order
+  if (mNThreads <= 1 || preClusters.size() < 2) {
+    for (const auto& preCluster : preClusters) {
+      findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits), bunchCrossing, orbit, iPreCluster++);
+    }
+    return;
+  }
+
+  // The preclusters are independent: process them on the thread pool,
+  // each thread with its own clusterizer and its own scratch memory
+  auto nPreClusters = preClusters.size();
+  mPreClusterClusters.resize(nPreClusters);
+  mPreClusterDigits.resize(nPreClusters);
+  std::exception_ptr error = nullptr;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (size_t i = 0; i < nPreClusters; ++i) {
+#ifdef WITH_OPENMP
+    auto& worker = *mWorkers[omp_get_thread_num()];
+#else
+    auto& worker = *mWorkers[0];
+#endif
+    worker.reset();
+    try {
+      const auto& preCluster = preClusters[i];
+      worker.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits), bunchCrossing, orbit, iPreCluster + i);
+    } catch (...) {
+      // an exception cannot leave the parallel region, rethrow it after
+#ifdef WITH_OPENMP
+#pragma omp critical
+#endif
+      if (!error) {
+        error = std::current_exception();
+      }
+      worker.reset();
+    }
+    mPreClusterClusters[i].swap(worker.mClusters);
+    mPreClusterDigits[i].swap(worker.mUsedDigits);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  // Merge in the precluster order, with the digit references and cluster indices
+  // the sequential processing would have given
+  for (size_t i = 0; i < nPreClusters; ++i) {
+    uint32_t clusterOffset = mClusters.size();
+    uint32_t digitOffset = mUsedDigits.size();
+    for (auto cluster : mPreClusterClusters[i]) {
+      cluster.firstDigit += digitOffset;
+      cluster.uid = Cluster::buildUniqueId(cluster.getChamberId(), cluster.getDEId(), cluster.getClusterIndex() + clusterOffset);
+      mClusters.push_back(cluster);
+    }
+    mUsedDigits.insert(mUsedDigits.end(), mPreClusterDigits[i].begin(), mPreClusterDigits[i].end());
+    mPreClusterClusters[i].clear();
+    mPreClusterDigits[i].clear();
+  }
+}
+
 } // namespace mch
 } // namespace o2
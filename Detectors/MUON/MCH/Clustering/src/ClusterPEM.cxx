@@ -2197,11 +2197,11 @@ Pads* ClusterPEM::findLocalMaxWithRefinement(double* thetaL, int nbrOfPadsInTheG
   pixels->setCharges(1.0);
   // The field saturate is use to tag pixels as already refined
   pixels->setSaturate(0);
-  // Init Cij
-  double* Cij = new double[nPads * maxNbrOfPixels];
+  // Init Cij (thread scratch memory, reused by the next preclusters)
+  double* Cij = getScratchDouble(CijScratch, nPads * maxNbrOfPixels);
   // ??? to be removed : MaskCij Not used
   // MaskCij: Used to disable Cij contribution (disable pixels)
-  Mask_t* maskCij = new Mask_t[nPads * maxNbrOfPixels];
+  Mask_t* maskCij = getScratchMask(MaskCijScratch, nPads * maxNbrOfPixels);
   // Compute pad charge (xyInfSup mode) induced with a set of charge (the pixels)
   // computeCij(*mergedPads, *pixels, Cij);
   computeFastCij(*mergedPads, *pixels, Cij);
@@ -2336,8 +2336,6 @@ Pads* ClusterPEM::findLocalMaxWithRefinement(double* thetaL, int nbrOfPadsInTheG
   }
 
   delete pixels;
-  delete[] Cij;
-  delete[] maskCij;
   delete mergedPads;
   return localMax;
 }
@@ -2403,11 +2401,11 @@ Pads* ClusterPEM::findLocalMaxWithoutRefinement(double* thetaL, int nbrOfPadsInT
   pixels->setCharges(1.0);
   // The field saturate is use to tag pixels as already refined
   pixels->setSaturate(0);
-  // Init Cij
-  double* Cij = new double[nPads * maxNbrOfPixels];
+  // Init Cij (thread scratch memory, reused by the next preclusters)
+  double* Cij = getScratchDouble(CijScratch, nPads * maxNbrOfPixels);
   // ??? to be removed : MaskCij Not used
   // MaskCij: Used to disable Cij contribution (disable pixels)
-  Mask_t* maskCij = new Mask_t[nPads * maxNbrOfPixels];
+  Mask_t* maskCij = getScratchMask(MaskCijScratch, nPads * maxNbrOfPixels);
   // Compute pad charge (xyInfSup mode) induced with a set of charge (the pixels)
   // computeCij(*mergedPads, *pixels, Cij);
   computeFastCij(*mergedPads, *pixels, Cij);
@@ -2556,8 +2554,6 @@ Pads* ClusterPEM::findLocalMaxWithoutRefinement(double* thetaL, int nbrOfPadsInT
   }
   delete pixels;
   delete mergedPads;
-  delete[] Cij;
-  delete[] maskCij;
   return localMax;
 }
 
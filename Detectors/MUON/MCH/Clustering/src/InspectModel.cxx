@@ -40,7 +40,8 @@ extern ClusterConfig clusterConfig;
 }
 } // namespace o2
 
-static InspectModel inspectModel;
+// One model per thread processing preclusters
+static thread_local InspectModel inspectModel;
 // Used when several sub-cluster occur in the precluster
 // Append the new hits/clusters in the thetaList of the pre-cluster
 void copyInGroupList(const double* values, int N, int item_size,
@@ -405,7 +406,7 @@ void collectThetaExtra(double* thetaExtra, int K)
 // PadProcess
 //
 
-static InspectPadProcessing_t
+static thread_local InspectPadProcessing_t
   inspectPadProcess; //={.xyDxyQPixels ={{0,nullptr}, {0,nullptr},
                      //{0,nullptr},  {0,nullptr}}};
 //.laplacian=0, .residualProj=0, .thetaInit=0, .kThetaInit=0,
@@ -42,9 +42,10 @@ using namespace o2::mch;
 
 // Total number of hits/seeds (number of mathieson)
 // found in the precluster;
-static int nbrOfHits = 0;
+// The preclusters can be processed in parallel, one per thread
+static thread_local int nbrOfHits = 0;
 // Storage of the seeds found
-static struct Results_t {
+static thread_local struct Results_t {
   std::vector<DataBlock_t> seedList;
   // mapping pads - groups
   Groups_t* padToGroups;
@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include <cstdio>
+#include <vector>
 
 #include "mathUtil.h"
 
@@ -17,6 +18,27 @@ namespace o2
 {
 namespace mch
 {
+static thread_local std::vector<double> scratchDouble[NbrOfScratches];
+static thread_local std::vector<Mask_t> scratchMask[NbrOfScratches];
+
+double* getScratchDouble(ScratchId id, size_t N)
+{
+  auto& buffer = scratchDouble[id];
+  if (buffer.size() < N) {
+    buffer.resize(N);
+  }
+  return buffer.data();
+}
+
+Mask_t* getScratchMask(ScratchId id, size_t N)
+{
+  auto& buffer = scratchMask[id];
+  if (buffer.size() < N) {
+    buffer.resize(N);
+  }
+  return buffer.data();
+}
+
 void vectorPrint(const char* str, const double* x, int K)
 {
   int nPackets = K / 10 + 1;
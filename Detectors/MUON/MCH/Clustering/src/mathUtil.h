@@ -545,6 +545,20 @@ inline void deleteShort(short* ptr)
   }
 }
 
+// Per-thread scratch buffers, kept from one precluster to the next one
+// to avoid allocating the large temporaries (Cij, ...) at each step.
+// A buffer is valid until the next request with the same id on the same
+// thread, so nested functions must use different ids.
+enum ScratchId { CijScratch,
+                 MaskCijScratch,
+                 PadIntegralXScratch,
+                 PadIntegralYScratch,
+                 EMRatioScratch,
+                 EMPixelsScratch,
+                 NbrOfScratches };
+double* getScratchDouble(ScratchId id, size_t N);
+Mask_t* getScratchMask(ScratchId id, size_t N);
+
 void vectorPrint(const char* str, const double* x, int N);
 void vectorPrintInt(const char* str, const int* x, int N);
 void vectorPrintShort(const char* str, const short* x, int N);
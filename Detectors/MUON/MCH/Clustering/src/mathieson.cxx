@@ -13,6 +13,7 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <map>
+#include <unordered_map>
 #include <limits>
 
 #include "MCHClustering/ClusterConfig.h"
@@ -34,7 +35,8 @@ const double sqrtK3x3_10 = 0.7131; // Pitch= 0.25 cm
 const double sqrtK3y3_10 = 0.7642; // Pitch= 0.25 cm
 const double pitch3_10 = 0.25;
 
-int mathiesonType; // 0 for Station 1 or 1 for station 2-5
+// Mathieson coefficients indexed by the Mathieson type:
+// 0 for Station 1 or 1 for station 2-5
 static double K1x[2], K1y[2];
 static double K2x[2], K2y[2];
 static const double sqrtK3x[2] = {sqrtK3x1_2, sqrtK3x3_10},
@@ -100,6 +102,14 @@ void initSplineMathiesonPrimitive()
   nSplineSampling = int(xyLimit / xyStep) + 1;
   int N = nSplineSampling;
 
+  // Release the tables of a previous initialisation
+  delete[] splineXY;
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) {
+      delete splineCoef[i][j];
+      splineCoef[i][j] = nullptr;
+    }
+  }
   splineXY = new double[N];
   for (int i = 0; i < N; i++) {
     splineXY[i] = xyStep * i;
@@ -245,7 +255,7 @@ void splineMathiesonPrimitive(const double* x, int N, int axe, int chamberId, do
 void mathiesonPrimitive(const double* xy, int N,
                         int axe, int chamberId, double mPrimitive[])
 {
-  mathiesonType = (chamberId <= 2) ? 0 : 1;
+  int mathiesonType = (chamberId <= 2) ? 0 : 1;
   //
   // Select Mathieson coef.
   double curK2xy = (axe == 0) ? K2x[mathiesonType] : K2y[mathiesonType];
@@ -253,10 +263,14 @@ void mathiesonPrimitive(const double* xy, int N,
   double curInvPitch = invPitch[mathiesonType];
   double cst2xy = curK2xy * curInvPitch;
   double curK4xy = (axe == 0) ? K4x[mathiesonType] : K4y[mathiesonType];
+  double cst4xy = 2.0 * curK4xy;
 
+  const double* __restrict__ in = xy;
+  double* __restrict__ out = mPrimitive;
+#pragma omp simd
   for (int i = 0; i < N; i++) {
-    double u = curSqrtK3xy * tanh(cst2xy * xy[i]);
-    mPrimitive[i] = 2 * curK4xy * atan(u);
+    double u = curSqrtK3xy * tanh(cst2xy * in[i]);
+    out[i] = cst4xy * atan(u);
   }
 }
 
@@ -265,7 +279,7 @@ void compute1DMathieson(const double* xy, int N,
 {
   // Returning array: Charge Integral on all the pads
   //
-  mathiesonType = (chamberId <= 2) ? 0 : 1;
+  int mathiesonType = (chamberId <= 2) ? 0 : 1;
 
   //
   // Select Mathieson coef.
@@ -284,22 +298,13 @@ void compute1DMathieson(const double* xy, int N,
   }
   return;
 }
-void compute1DPadIntegrals(const double* xyInf, const double* xySup, int N,
-                           double xy0, int axe, int chamberId, double* integrals)
-{
-  double zInf[N], zSup[N];
-  vectorAddScalar(xyInf, -xy0, N, zInf);
-  vectorAddScalar(xySup, -xy0, N, zSup);
-  compute1DPadIntegrals(zInf, zSup, N, axe, chamberId, integrals);
-}
-
-void compute1DPadIntegrals(const double* xyInf, const double* xySup, int N,
-                           int axe, int chamberId, double* Integrals)
+// Charge integral of the pads [xyInf - xy0, xySup - xy0] along one axis.
+// Branch-free loop on restrict pointers, with the chamber constants hoisted,
+// so that tanh/atan are evaluated on SIMD lanes (vector math library)
+static inline void mathiesonPadIntegrals1D(const double* __restrict__ xyInf, const double* __restrict__ xySup, int N,
+                                           double xy0, int axe, int chamberId, double* __restrict__ integrals)
 {
-  // Returning array: Charge Integral on all the pads
-  //
-  mathiesonType = (chamberId <= 2) ? 0 : 1;
-
+  int mathiesonType = (chamberId <= 2) ? 0 : 1;
   //
   // Select Mathieson coef.
   double curInvPitch = invPitch[mathiesonType];
@@ -309,19 +314,28 @@ void compute1DPadIntegrals(const double* xyInf, const double* xySup, int N,
   double cst2 = curK2 * curInvPitch;
   double cst4 = 2.0 * curK4;
 
-  double uInf, uSup;
+#pragma omp simd
   for (int i = 0; i < N; i++) {
     // x/u
-    uInf = curSqrtK3 * tanh(cst2 * xyInf[i]);
-    uSup = curSqrtK3 * tanh(cst2 * xySup[i]);
+    double uInf = curSqrtK3 * tanh(cst2 * (xyInf[i] - xy0));
+    double uSup = curSqrtK3 * tanh(cst2 * (xySup[i] - xy0));
     //
-    Integrals[i] = cst4 * (atan(uSup) - atan(uInf));
-    // printf(" xyInfSup %2d  [%10.6g, %10.6g] x [%10.6g, %10.6g]-> %10.6g\n",
-    // i, xInf[i], xSup[i], yInf[i], ySup[i], Integrals[i]);
+    integrals[i] = cst4 * (atan(uSup) - atan(uInf));
   }
-  // printf(" I[0..%3ld] = %f, %f, ... %f\n", N-1, Integrals[0], Integrals[1],
-  // Integrals[N-1]);
-  return;
+}
+
+void compute1DPadIntegrals(const double* xyInf, const double* xySup, int N,
+                           double xy0, int axe, int chamberId, double* integrals)
+{
+  mathiesonPadIntegrals1D(xyInf, xySup, N, xy0, axe, chamberId, integrals);
+}
+
+void compute1DPadIntegrals(const double* xyInf, const double* xySup, int N,
+                           int axe, int chamberId, double* Integrals)
+{
+  // Returning array: Charge Integral on all the pads
+  //
+  mathiesonPadIntegrals1D(xyInf, xySup, N, 0.0, axe, chamberId, Integrals);
 }
 
 int compressSameValues(const double* x1, const double* x2, int* map1, int* map2, int N, double* xCompress)
@@ -555,11 +569,7 @@ void compute2DPadIntegrals(const double* xInf, const double* xSup,
     } else {
       // Returning array: Charge Integral on all the pads
       //
-      if (chamberId <= 2) {
-        mathiesonType = 0;
-      } else {
-        mathiesonType = 1;
-      }
+      int mathiesonType = (chamberId <= 2) ? 0 : 1;
       //
       // Select Mathieson coef.
       double curK2x = K2x[mathiesonType];
@@ -705,48 +715,41 @@ void computeFastCij(const Pads& pads, const Pads& pixel, double Cij[])
   const double* muX = pixel.getX();
   const double* muY = pixel.getY();
 
-  double zInf[N];
-  double zSup[N];
   int axe;
 
   // Loop on Pixels
-  std::map<int, double*> xMap;
-  std::map<int, double*> yMap;
+  // The 1D integrals are stored in the thread scratch memory,
+  // the maps give their offset
+  double* xIntegrals = getScratchDouble(PadIntegralXScratch, size_t(N) * K);
+  double* yIntegrals = getScratchDouble(PadIntegralYScratch, size_t(N) * K);
+  std::unordered_map<int, size_t> xMap;
+  std::unordered_map<int, size_t> yMap;
+  xMap.reserve(K);
+  yMap.reserve(K);
   for (int k = 0; k < K; k++) {
     // Calculate the indexes in the 1D charge integral
     // Error on pad position > 10-3 cm
     int xCode = (int)(muX[k] * 1000 + 0.5);
     int yCode = (int)(muY[k] * 1000 + 0.5);
-    if (xMap.find(xCode) == xMap.end()) {
+    auto [xIt, xNew] = xMap.try_emplace(xCode, xMap.size() * N);
+    if (xNew) {
       // Not yet computed
-      vectorAddScalar(xInf0, -muX[k], N, zInf);
-      vectorAddScalar(xSup0, -muX[k], N, zSup);
       axe = 0;
-      double* xIntegrals = new double[N];
-      compute1DPadIntegrals(zInf, zSup, N, axe, chId, xIntegrals);
-      xMap[xCode] = xIntegrals;
+      compute1DPadIntegrals(xInf0, xSup0, N, muX[k], axe, chId, &xIntegrals[xIt->second]);
     }
-    if (yMap.find(yCode) == yMap.end()) {
+    auto [yIt, yNew] = yMap.try_emplace(yCode, yMap.size() * N);
+    if (yNew) {
       // Not yet computed
-      vectorAddScalar(yInf0, -muY[k], N, zInf);
-      vectorAddScalar(ySup0, -muY[k], N, zSup);
       axe = 1;
-      double* yIntegrals = new double[N];
-      compute1DPadIntegrals(zInf, zSup, N, axe, chId, yIntegrals);
-      yMap[yCode] = yIntegrals;
+      compute1DPadIntegrals(yInf0, ySup0, N, muY[k], axe, chId, &yIntegrals[yIt->second]);
     }
     // Compute IC(xy) = IC(x) * IC(y)
-    vectorMultVector(xMap[xCode], yMap[yCode], N, &Cij[N * k]);
+    vectorMultVector(&xIntegrals[xIt->second], &yIntegrals[yIt->second], N, &Cij[N * k]);
     //
     // Check
     if (clusterConfig.mathiesonCheck) {
       double xInf[N], xSup[N];
       double yInf[N], ySup[N];
-      double lBoundPrim[N], uBoundPrim[N];
-      double xIntegrals[N], yIntegrals[N], Integrals[N];
-      // printf("pad xyPad[0]= %f %f \n", (xSup0[0] - xInf0[0])*0.5, (ySup0[0] - yInf0[0])*0.5);
-      // printf("pad xyPad[0]= %f %f \n", xSup0[0], ySup0[0]);
-      // printf("pad xyPix[0]= %f %f \n", muX[k], muY[k]);
       vectorAddScalar(xInf0, -muX[k], N, xInf);
       vectorAddScalar(xSup0, -muX[k], N, xSup);
       vectorAddScalar(yInf0, -muY[k], N, yInf);
@@ -754,13 +757,6 @@ void computeFastCij(const Pads& pads, const Pads& pixel, double Cij[])
       checkIntegrals(xInf, xSup, yInf, ySup, &Cij[N * k], chId, N);
     }
   }
-  // Free map
-  for (auto it = xMap.begin(); it != xMap.end(); ++it) {
-    delete[] it->second;
-  }
-  for (auto it = yMap.begin(); it != yMap.end(); ++it) {
-    delete[] it->second;
-  }
 }
 
 void computeFastCijV0(const Pads& pads, const Pads& pixel, double Cij[])
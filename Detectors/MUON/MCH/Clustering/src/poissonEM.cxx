@@ -88,7 +88,7 @@ void fastIterateEMPoissonV0(const double* Cij, const double* Ci,
 {
 
   double residu = 0.0;
-  double* qRatio = new double[nPads];
+  double* qRatio = getScratchDouble(EMRatioScratch, nPads);
 
   // Compute charge prediction on pad j based on pixel charges
   //  qPadPrediction[j] = Sum_i{ Cij[i,j].qPixels[i] }
@@ -131,7 +131,6 @@ void fastIterateEMPoissonV0(const double* Cij, const double* Ci,
       newQPixels[i] = 0;
     }
   }
-  delete[] qRatio;
 }
 
 void fastIterateEMPoisson(const double* Cij, const double* Ci,
@@ -141,7 +140,7 @@ void fastIterateEMPoisson(const double* Cij, const double* Ci,
 {
 
   double residu = 0.0;
-  double* qRatio = new double[nPads];
+  double* qRatio = getScratchDouble(EMRatioScratch, nPads);
 
   // Compute charge prediction on pad j based on pixel charges
   //  qPadPrediction[j] = Sum_i{ Cij[i,j].qPixels[i] }
@@ -221,8 +220,6 @@ void fastIterateEMPoisson(const double* Cij, const double* Ci,
        */
     }
   }
-
-  delete[] qRatio;
 }
 
 double computeChiSquare(const Pads& pads, const double* qPredictedPads,
@@ -275,7 +272,7 @@ std::pair<double, double> PoissonEMLoop(const Pads& pads, Pads& pixels,
   const double* y = pixels.getY();
   const double* dx = pixels.getDX();
   const double* dy = pixels.getDY();
-  double* qPixels = new double[pixels.getNbrOfPads()];
+  double* qPixels = getScratchDouble(EMPixelsScratch, pixels.getNbrOfPads());
   vectorCopy(pixels.getCharges(), pixels.getNbrOfPads(), qPixels);
   //
   const double* qPads = pads.getCharges();
@@ -433,7 +430,6 @@ std::pair<double, double> PoissonEMLoop(const Pads& pads, Pads& pixels,
     printf("  Nbr of removed pixels  = %d/%d\n", oldValueNPads - k,
            oldValueNPads);
   }
-  delete[] qPixels;
   return std::make_pair(chi20, chi21);
 }
 
@@ -0,0 +1,97 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testClusterFinderGEM.cxx
+/// \brief check that the parallel processing of the preclusters gives the same clusters as the sequential one
+
+#define BOOST_TEST_MODULE Test MCH ClusterFinderGEM
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "MCHClustering/ClusterFinderGEM.h"
+#include "MCHMappingInterface/Segmentation.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace o2::mch;
+
+namespace
+{
+
+/// generate the digits of isolated hits, one or two per precluster, on a few detection elements
+void generatePreClusters(std::vector<Digit>& digits, std::vector<PreCluster>& preClusters)
+{
+  std::mt19937 gen(4321);
+  std::uniform_real_distribution<double> shift(-0.5, 0.5);
+  std::uniform_int_distribution<int> nHits(1, 2);
+  for (int deId : {100, 300, 500, 819, 1025}) {
+    const auto& seg = mapping::segmentation(deId);
+    for (int iPad = 0; iPad < seg.nofPads(); iPad += seg.nofPads() / 20) {
+      double x0 = seg.padPositionX(iPad), y0 = seg.padPositionY(iPad);
+      std::vector<std::pair<double, double>> hits;
+      for (int i = nHits(gen); i > 0; i--) {
+        hits.emplace_back(x0 + shift(gen), y0 + shift(gen));
+      }
+      auto firstDigit = digits.size();
+      seg.forEachPadInArea(x0 - 2., y0 - 2., x0 + 2., y0 + 2., [&](int padId) {
+        double charge = 0.;
+        for (const auto& [x, y] : hits) {
+          double dx = seg.padPositionX(padId) - x, dy = seg.padPositionY(padId) - y;
+          charge += 1000. * std::exp(-(dx * dx + dy * dy) / 0.3);
+        }
+        if (charge > 10.) {
+          digits.emplace_back(deId, padId, static_cast<uint32_t>(charge), 0);
+        }
+      });
+      if (digits.size() > firstDigit) {
+        preClusters.push_back({static_cast<uint32_t>(firstDigit), static_cast<uint32_t>(digits.size() - firstDigit)});
+      }
+    }
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ClusterFinderGEM_ParallelPreClusters)
+{
+  std::vector<Digit> digits;
+  std::vector<PreCluster> preClusters;
+  generatePreClusters(digits, preClusters);
+  BOOST_REQUIRE_GT(preClusters.size(), 50);
+
+  ClusterFinderGEM sequential;
+  sequential.init(0, false); // the mode is not used by the clustering
+  uint32_t iPreCluster = 0;
+  for (const auto& preCluster : preClusters) {
+    sequential.findClusters(gsl::span<const Digit>(digits).subspan(preCluster.firstDigit, preCluster.nDigits), 0, 0, iPreCluster++);
+  }
+  BOOST_REQUIRE_GT(sequential.getClusters().size(), 0);
+
+  ClusterFinderGEM parallel;
+  parallel.init(0, false);
+  parallel.setNThreads(4);
+  parallel.findClusters(preClusters, digits, 0, 0, 0);
+
+  const auto& refClusters = sequential.getClusters();
+  const auto& clusters = parallel.getClusters();
+  BOOST_REQUIRE_EQUAL(clusters.size(), refClusters.size());
+  for (size_t i = 0; i < clusters.size(); i++) {
+    BOOST_CHECK_EQUAL(clusters[i].x, refClusters[i].x);
+    BOOST_CHECK_EQUAL(clusters[i].y, refClusters[i].y);
+    BOOST_CHECK_EQUAL(clusters[i].ex, refClusters[i].ex);
+    BOOST_CHECK_EQUAL(clusters[i].ey, refClusters[i].ey);
+    BOOST_CHECK_EQUAL(clusters[i].uid, refClusters[i].uid);
+    BOOST_CHECK_EQUAL(clusters[i].firstDigit, refClusters[i].firstDigit);
+    BOOST_CHECK_EQUAL(clusters[i].nDigits, refClusters[i].nDigits);
+  }
+  BOOST_CHECK(parallel.getUsedDigits() == sequential.getUsedDigits());
+}
@@ -36,9 +36,9 @@ class Track
   ~Track() = default;
 
   Track(const Track& track);
-  Track& operator=(const Track& track) = delete;
-  Track(Track&&) = delete;
-  Track& operator=(Track&&) = delete;
+  Track& operator=(const Track& track);
+  Track(Track&&) noexcept = default;
+  Track& operator=(Track&&) noexcept = default;
 
   /// Return the number of attached clusters
   int getNClusters() const { return mParamAtClusters.size(); }
@@ -18,11 +18,16 @@
 #define O2_MCH_TRACKEXTRAP_H_
 
 #include <cstddef>
+#include <memory>
 
 #include <TMatrixD.h>
 
 namespace o2
 {
+namespace field
+{
+class MagFieldGrid;
+}
 namespace mch
 {
 
@@ -49,6 +54,8 @@ class TrackExtrap
   /// Switch to Runge-Kutta extrapolation v2
   static void useExtrapV2(bool extrapV2 = true) { sExtrapV2 = extrapV2; }
 
+  static void useFieldGrid(float maxError);
+
   static double getImpactParamFromBendingMomentum(double bendingMomentum);
   static double getBendingMomentumFromImpactParam(double impactParam);
 
@@ -117,6 +124,9 @@ class TrackExtrap
   static bool extrapToZRungekuttaV2(TrackParam& trackParam, double zEnd);
   static bool extrapOneStepRungekutta(double charge, double step, const double* vect, double* vout);
 
+  static void updateFieldGrid();
+  static void getField(const double* xyz, double* b);
+
   static constexpr double SMuMass = 0.105658;                         ///< Muon mass (GeV/c2)
   static constexpr double SAbsZBeg = -90.;                            ///< Position of the begining of the absorber (cm)
   static constexpr double SAbsZEnd = -505.;                           ///< Position of the end of the absorber (cm)
@@ -135,11 +145,18 @@ class TrackExtrap
   static constexpr double SMuonFilterX0 = 1.76; ///< Radiation length of the muon filter (cm)
   static constexpr double SMIDZ = -1603.5;      ///< Position of the first MID chamber (cm)
 
+  static constexpr float SFieldGridXYMax = 400.;  ///< Half size of the field grid in x and y (cm)
+  static constexpr float SFieldGridZMin = -1650.; ///< Lower z limit of the field grid (cm)
+  static constexpr float SFieldGridZMax = 0.;     ///< Upper z limit of the field grid (cm)
+
   static bool sExtrapV2; ///< switch to Runge-Kutta extrapolation v2
 
   static double sSimpleBValue; ///< Magnetic field value at the centre
   static bool sFieldON;        ///< true if the field is switched ON
 
+  static float sFieldGridMaxError;                            ///< max. deviation of the field grid, no grid if <= 0
+  static std::unique_ptr<o2::field::MagFieldGrid> sFieldGrid; ///< lookup grid of the field in the muon spectrometer
+
   static std::size_t sNCallExtrapToZCov; ///< number of times the method extrapToZCov(...) is called
   static std::size_t sNCallField;        ///< number of times the method Field(...) is called
 };
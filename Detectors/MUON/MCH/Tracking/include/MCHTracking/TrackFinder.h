@@ -20,7 +20,6 @@
 #include <chrono>
 #include <unordered_map>
 #include <unordered_set>
-#include <list>
 #include <array>
 #include <vector>
 #include <utility>
@@ -52,7 +51,7 @@ class TrackFinder
   void init();
   void initField(float l3Current, float dipoleCurrent);
 
-  const std::list<Track>& findTracks(gsl::span<const Cluster> clusters);
+  const std::vector<Track>& findTracks(gsl::span<const Cluster> clusters);
 
   /// return the counting of encountered errors
   ErrorMap& getErrorMap() { return mErrorMap; }
@@ -64,24 +63,49 @@ class TrackFinder
   void printTimers() const;
 
  private:
-  const std::list<Track>& findTracks(const std::unordered_map<int, std::list<const Cluster*>>& clusters);
+  /// range of clusters of one DE in the contiguous cluster storage
+  struct ClusterRange {
+    uint32_t offset = 0; ///< index of the first cluster of the DE
+    uint32_t size = 0;   ///< number of clusters of the DE
+    double zMin = 0.;    ///< minimum z position of the clusters of the DE
+    double zMax = 0.;    ///< maximum z position of the clusters of the DE
+    bool empty() const { return size == 0; }
+  };
+  /// range of cluster candidates in the candidate arena
+  using CandidateRange = std::pair<std::size_t, std::size_t>;
+
+  static constexpr int SNoTrack = -1; ///< index of no track candidate, ending the chain of candidates
+
+  /// links of a track candidate of the pool to its neighbours in the processing order
+  struct TrackLinks {
+    int previous = SNoTrack; ///< index of the previous candidate
+    int next = SNoTrack;     ///< index of the next candidate
+  };
+
+  void groupClusters(gsl::span<const Cluster> clusters);
+  /// return the clusters of the DE, in their original order
+  gsl::span<const Cluster* const> getClusters(const ClusterRange& de) const
+  {
+    return {mDEClusters.data() + de.offset, de.size};
+  }
+  CandidateRange selectClusterCandidates(const ClusterRange& de, const TrackParam& param);
+  /// release the last range of cluster candidates selected
+  void releaseClusterCandidates(const CandidateRange& candidates) { mCandidateArena.resize(candidates.first); }
 
   void findTrackCandidates();
   void findTrackCandidatesInSt5();
   void findTrackCandidatesInSt4();
   void findMoreTrackCandidates();
-  std::list<Track>::iterator findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, const std::list<Track>::iterator& itFirstTrack);
-
-  std::list<Track>::iterator followTrackInOverlapDE(const std::list<Track>::iterator& itTrack, int currentDE, int plane);
-  std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                  int chamber, int lastChamber, bool canSkip,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
-  std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                  int plane1, int plane2, int lastChamber,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
-  std::list<Track>::iterator addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
-                                                       const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
-                                                       std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+  int findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, int iFirstTrack);
+
+  int followTrackInOverlapDE(int iTrack, int currentDE, int plane);
+  int followTrackInChamber(int iTrack, int chamber, int lastChamber, bool canSkip,
+                           std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+  int followTrackInChamber(int iTrack, int plane1, int plane2, int lastChamber,
+                           std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+  int addClustersAndFollowTrack(int iTrack, const TrackParam& paramAtCluster1,
+                                const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
+                                std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
 
   void improveTracks();
 
@@ -92,12 +116,19 @@ class TrackFinder
   void finalize();
 
   void createTrack(const Cluster& cl1, const Cluster& cl2);
-  std::list<Track>::iterator addTrack(const std::list<Track>::iterator& pos, const Track& track);
+  int addTrack(int pos, int iTrack);
+  int insertTrack(int pos);
+  int eraseTrack(int iTrack);
+  void clearTracks();
+  /// return the index of the next candidate in the chain, or SNoTrack
+  int nextTrack(int iTrack) const { return mTrackLinks[iTrack].next; }
+  /// return the index of the previous candidate in the chain, or of the last one if iTrack = SNoTrack
+  int previousTrack(int iTrack) const { return (iTrack == SNoTrack) ? mLastTrack : mTrackLinks[iTrack].previous; }
 
   bool isAcceptable(const TrackParam& param) const;
 
-  void prepareForwardTracking(std::list<Track>::iterator& itTrack, bool runSmoother);
-  void prepareBackwardTracking(std::list<Track>::iterator& itTrack, bool refit);
+  void prepareForwardTracking(Track& track, bool runSmoother);
+  void prepareBackwardTracking(Track& track, bool refit);
   void setCurrentParam(Track& track, const TrackParam& param, int chamber, bool smoothed = false);
   bool propagateCurrentParam(Track& track, int chamber);
 
@@ -113,7 +144,7 @@ class TrackFinder
 
   uint8_t requestedStationMask() const;
 
-  int getTrackIndex(const std::list<Track>::iterator& itCurrentTrack) const;
+  int getTrackIndex(int iCurrentTrack) const;
   void printTracks() const;
   void printTrack(const Track& track) const;
   void printTrackParam(const TrackParam& trackParam) const;
@@ -138,10 +169,25 @@ class TrackFinder
 
   TrackFitter mTrackFitter{}; /// track fitter
 
-  /// array of pointers to the lists of clusters per DE
-  std::array<std::vector<std::pair<const int, const std::list<const Cluster*>*>>, 32> mClusters{};
-
-  std::list<Track> mTracks{}; ///< list of reconstructed tracks
+  static constexpr int SNDEIds = 2048; ///< upper limit of the DE IDs (11 bits in the cluster UID)
+
+  /// array of ranges of clusters per DE, grouping DEs in z-planes
+  std::array<std::vector<std::pair<const int, ClusterRange>>, 32> mClusters{};
+  std::vector<const Cluster*> mDEClusters{};      ///< clusters stored contiguously per DE, in their original order
+  std::vector<uint32_t> mDEClustersByY{};         ///< index of the clusters sorted per DE by increasing bending coordinate
+  std::vector<float> mSortedY{};                  ///< bending coordinate of the clusters in the same order
+  std::array<uint32_t, SNDEIds + 1> mDEOffsets{}; ///< index of the first cluster of each DE
+  std::vector<uint32_t> mCandidateArena{};        ///< stack of the cluster candidates selected in the nested searches
+  std::vector<std::vector<const Cluster*>> mSeedClusters{}; ///< clusters of plane2 paired with each cluster of plane1
+
+  std::vector<Track> mTrackPool{};       ///< track candidates, in slots recycled from one candidate to the next
+  std::vector<TrackLinks> mTrackLinks{}; ///< chaining of the candidates of the pool in their processing order
+  std::vector<int> mFreeTracks{};        ///< slots of the pool available for new candidates
+  int mFirstTrack = SNoTrack;            ///< index of the first candidate in the chain
+  int mLastTrack = SNoTrack;             ///< index of the last candidate in the chain
+  std::size_t mNTracks = 0;              ///< number of candidates in the chain
+
+  std::vector<Track> mTracks{}; ///< reconstructed tracks
 
   std::chrono::time_point<std::chrono::steady_clock> mStartTime{}; ///< time when the tracking start
 
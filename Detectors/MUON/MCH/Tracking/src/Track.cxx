@@ -38,6 +38,21 @@ Track::Track(const Track& track)
   /// Copy the track, except the current parameters and chamber, which are reset
 }
 
+//__________________________________________________________________________
+Track& Track::operator=(const Track& track)
+{
+  /// Copy the track, except the current parameters and chamber, which are reset
+  /// The elements of the list of track parameters at clusters are reused
+  if (this != &track) {
+    mParamAtClusters = track.mParamAtClusters;
+    mCurrentParam.reset();
+    mCurrentChamber = -1;
+    mConnected = track.mConnected;
+    mRemovable = track.mRemovable;
+  }
+  return *this;
+}
+
 //__________________________________________________________________________
 TrackParam& Track::createParamAtCluster(const Cluster& cluster)
 {
@@ -23,6 +23,8 @@
 #include <TGeoShape.h>
 #include <TMath.h>
 
+#include "Field/MagFieldGrid.h"
+#include "Field/MagneticField.h"
 #include "Framework/Logger.h"
 
 #include "MCHTracking/TrackParam.h"
@@ -35,6 +37,8 @@ namespace mch
 bool TrackExtrap::sExtrapV2 = false;
 double TrackExtrap::sSimpleBValue = 0.;
 bool TrackExtrap::sFieldON = false;
+float TrackExtrap::sFieldGridMaxError = 0.f;
+std::unique_ptr<o2::field::MagFieldGrid> TrackExtrap::sFieldGrid{};
 std::size_t TrackExtrap::sNCallExtrapToZCov = 0;
 std::size_t TrackExtrap::sNCallField = 0;
 
@@ -49,6 +53,51 @@ void TrackExtrap::setField()
   sSimpleBValue = b[0];
   sFieldON = (TMath::Abs(sSimpleBValue) > 1.e-10) ? true : false;
   LOG(info) << "Track extrapolation with magnetic field " << (sFieldON ? "ON" : "OFF");
+  updateFieldGrid();
+}
+
+//__________________________________________________________________________
+void TrackExtrap::useFieldGrid(float maxError)
+{
+  /// Use a lookup grid of the field in the muon spectrometer, built from the field parameterization with
+  /// the given max. deviation (kG), instead of the parameterization itself during the Runge-Kutta extrapolation.
+  /// The grid is (re)built every time the field is set. Use the parameterization if maxError <= 0
+  sFieldGridMaxError = maxError;
+  updateFieldGrid();
+}
+
+//__________________________________________________________________________
+void TrackExtrap::updateFieldGrid()
+{
+  /// Build the field grid from the current field if requested
+  sFieldGrid.reset();
+  if (!sFieldON || sFieldGridMaxError <= 0.f) {
+    return;
+  }
+  auto field = dynamic_cast<const o2::field::MagneticField*>(TGeoGlobalMagField::Instance()->GetField());
+  if (!field) {
+    LOG(warning) << "The field is not an o2::field::MagneticField, the field grid is not used";
+    return;
+  }
+  const float min[3] = {-SFieldGridXYMax, -SFieldGridXYMax, SFieldGridZMin};
+  const float max[3] = {SFieldGridXYMax, SFieldGridXYMax, SFieldGridZMax};
+  auto grid = std::make_unique<o2::field::MagFieldGrid>();
+  if (!grid->create(*field, min, max, sFieldGridMaxError)) {
+    LOG(warning) << "Cannot build the field grid, using the field parameterization";
+    return;
+  }
+  grid->print();
+  sFieldGrid = std::move(grid);
+}
+
+//__________________________________________________________________________
+void TrackExtrap::getField(const double* xyz, double* b)
+{
+  /// Get the field from the grid if any and inside its volume, or from the field parameterization otherwise
+  if (!sFieldGrid || !sFieldGrid->Field(xyz, b)) {
+    TGeoGlobalMagField::Instance()->Field(xyz, b);
+  }
+  ++sNCallField;
 }
 
 //__________________________________________________________________________
@@ -1066,8 +1115,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
       h = rest;
     }
     // cmodif: call gufld(vout,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(vout, f);
-    ++sNCallField;
+    getField(vout, f);
 
     // *
     // *             start of integration
@@ -1115,8 +1163,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
-    ++sNCallField;
+    getField(xyzt, f);
 
     at = a + secxs[0];
     bt = b + secys[0];
@@ -1155,8 +1202,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
-    ++sNCallField;
+    getField(xyzt, f);
 
     z = z + (c + (seczs[0] + seczs[1] + seczs[2]) * kthird) * h;
     y = y + (b + (secys[0] + secys[1] + secys[2]) * kthird) * h;
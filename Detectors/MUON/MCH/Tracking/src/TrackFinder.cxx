@@ -16,8 +16,11 @@
 
 #include "MCHTracking/TrackFinder.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <numeric>
 #include <iostream>
 #include <stdexcept>
 
@@ -55,6 +58,9 @@ void TrackFinder::init()
   // use the Runge-Kutta extrapolation v2
   TrackExtrap::useExtrapV2();
 
+  // use the field lookup grid if requested
+  TrackExtrap::useFieldGrid(trackerParam.fieldGridMaxError);
+
   // Pre-compute some parameters used during the tracking
   mChamberResolutionX2 = trackerParam.chamberResolutionX * trackerParam.chamberResolutionX;
   mChamberResolutionY2 = trackerParam.chamberResolutionY * trackerParam.chamberResolutionY;
@@ -74,67 +80,67 @@ void TrackFinder::init()
   // grouping DEs in z-planes (2 for chambers 1-4 and 4 for chambers 5-10)
   for (int iCh = 0; iCh < 4; ++iCh) {
     mClusters[2 * iCh].reserve(2);
-    mClusters[2 * iCh].emplace_back(100 * (iCh + 1) + 1, nullptr);
-    mClusters[2 * iCh].emplace_back(100 * (iCh + 1) + 3, nullptr);
+    mClusters[2 * iCh].emplace_back(100 * (iCh + 1) + 1, ClusterRange{});
+    mClusters[2 * iCh].emplace_back(100 * (iCh + 1) + 3, ClusterRange{});
     mClusters[2 * iCh + 1].reserve(2);
-    mClusters[2 * iCh + 1].emplace_back(100 * (iCh + 1), nullptr);
-    mClusters[2 * iCh + 1].emplace_back(100 * (iCh + 1) + 2, nullptr);
+    mClusters[2 * iCh + 1].emplace_back(100 * (iCh + 1), ClusterRange{});
+    mClusters[2 * iCh + 1].emplace_back(100 * (iCh + 1) + 2, ClusterRange{});
   }
   for (int iCh = 4; iCh < 6; ++iCh) {
     mClusters[8 + 4 * (iCh - 4)].reserve(5);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1), nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 2, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 4, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 14, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 16, nullptr);
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1), ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 2, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 4, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 14, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 16, ClusterRange{});
     mClusters[8 + 4 * (iCh - 4) + 1].reserve(4);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 1, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 3, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 15, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 17, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 1, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 3, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 15, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 17, ClusterRange{});
     mClusters[8 + 4 * (iCh - 4) + 2].reserve(4);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 6, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 8, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 10, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 12, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 6, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 8, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 10, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 12, ClusterRange{});
     mClusters[8 + 4 * (iCh - 4) + 3].reserve(5);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 5, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 7, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 9, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 11, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 13, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 5, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 7, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 9, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 11, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 13, ClusterRange{});
   }
   for (int iCh = 6; iCh < 10; ++iCh) {
     mClusters[8 + 4 * (iCh - 4)].reserve(7);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1), nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 2, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 4, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 6, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 20, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 22, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 24, nullptr);
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1), ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 2, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 4, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 6, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 20, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 22, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 24, ClusterRange{});
     mClusters[8 + 4 * (iCh - 4) + 1].reserve(6);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 1, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 3, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 5, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 21, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 23, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 25, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 1, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 3, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 5, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 21, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 23, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 25, ClusterRange{});
     mClusters[8 + 4 * (iCh - 4) + 2].reserve(6);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 8, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 10, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 12, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 14, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 16, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 18, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 8, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 10, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 12, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 14, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 16, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 18, ClusterRange{});
     mClusters[8 + 4 * (iCh - 4) + 3].reserve(7);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 7, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 9, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 11, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 13, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 15, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 17, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 19, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 7, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 9, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 11, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 13, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 15, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 17, ClusterRange{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 19, ClusterRange{});
   }
 }
 
@@ -146,35 +152,15 @@ void TrackFinder::initField(float l3Current, float dipoleCurrent)
 }
 
 //_________________________________________________________________________________________________
-const std::list<Track>& TrackFinder::findTracks(gsl::span<const Cluster> clusters)
+const std::vector<Track>& TrackFinder::findTracks(gsl::span<const Cluster> clusters)
 {
   /// Group the clusters per DE and run the track finder algorithm
-  std::unordered_map<int, std::list<const Cluster*>> clustersPerDE{};
-  for (const auto& cluster : clusters) {
-    clustersPerDE[cluster.getDEId()].emplace_back(&cluster);
-  }
-  return findTracks(clustersPerDE);
-}
-
-//_________________________________________________________________________________________________
-const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, std::list<const Cluster*>>& clusters)
-{
-  /// Run the track finder algorithm
 
-  mTracks.clear();
+  clearTracks();
   mStartTime = std::chrono::steady_clock::now();
 
-  // fill the internal array of pointers to the list of clusters per DE
-  for (auto& plane : mClusters) {
-    for (auto& de : plane) {
-      auto itDE = clusters.find(de.first);
-      if (itDE == clusters.end()) {
-        de.second = nullptr;
-      } else {
-        de.second = &(itDE->second);
-      }
-    }
-  }
+  // fill the internal array of ranges of clusters per DE
+  groupClusters(clusters);
 
   // use the chamber resolution when fitting the tracks during the tracking
   mTrackFitter.useChamberResolution();
@@ -192,17 +178,17 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
       tEnd = std::chrono::high_resolution_clock::now();
       mTimeFindMoreCandidates += tEnd - tStart;
     }
-    mNCandidates += mTracks.size();
+    mNCandidates += mNTracks;
     print("------ list of track candidates ------");
     printTracks();
 
     // track each candidate down to chamber 1 and remove it
     tStart = std::chrono::high_resolution_clock::now();
-    for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
+    for (int iTrack = mFirstTrack; iTrack != SNoTrack;) {
       std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
-      followTrackInChamber(itTrack, 5, 0, false, excludedClusters);
-      print("findTracks: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      followTrackInChamber(iTrack, 5, 0, false, excludedClusters);
+      print("findTracks: removing candidate at position #", getTrackIndex(iTrack));
+      iTrack = eraseTrack(iTrack);
     }
     tEnd = std::chrono::high_resolution_clock::now();
     mTimeFollowTracks += tEnd - tStart;
@@ -211,6 +197,7 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
 
   } catch (exception const& e) {
     LOG(warning) << e.what() << " --> abort";
+    clearTracks();
     mTracks.clear();
     return mTracks;
   }
@@ -238,9 +225,105 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
     finalize();
   }
 
+  // copy the reconstructed tracks out of the pool, reusing the storage of the previous ones
+  mTracks.resize(mNTracks);
+  auto itOutTrack = mTracks.begin();
+  for (int iTrack = mFirstTrack; iTrack != SNoTrack; iTrack = nextTrack(iTrack)) {
+    *itOutTrack++ = mTrackPool[iTrack];
+  }
+
   return mTracks;
 }
 
+//_________________________________________________________________________________________________
+void TrackFinder::groupClusters(gsl::span<const Cluster> clusters)
+{
+  /// Store the clusters contiguously per DE, keeping their original order within a DE,
+  /// and index them by increasing bending coordinate to quickly select the candidates around a track
+  /// The storage is reused from one call to the next to avoid reallocating it
+
+  // count the clusters per DE and compute the index of the first cluster of each DE
+  mDEOffsets.fill(0);
+  for (const auto& cluster : clusters) {
+    ++mDEOffsets[cluster.getDEId() + 1];
+  }
+  for (int iDE = 0; iDE < SNDEIds; ++iDE) {
+    mDEOffsets[iDE + 1] += mDEOffsets[iDE];
+  }
+
+  // fill the contiguous storage
+  mDEClusters.resize(clusters.size());
+  auto fillIndex = mDEOffsets;
+  for (const auto& cluster : clusters) {
+    mDEClusters[fillIndex[cluster.getDEId()]++] = &cluster;
+  }
+
+  // set the ranges of the DEs used for tracking and sort their clusters in the bending direction
+  mDEClustersByY.resize(clusters.size());
+  mSortedY.resize(clusters.size());
+  for (auto& plane : mClusters) {
+    for (auto& de : plane) {
+      auto& range = de.second;
+      range.offset = mDEOffsets[de.first];
+      range.size = mDEOffsets[de.first + 1] - range.offset;
+      if (range.empty()) {
+        continue;
+      }
+      auto first = mDEClustersByY.begin() + range.offset;
+      auto last = first + range.size;
+      std::iota(first, last, range.offset);
+      std::sort(first, last, [this](uint32_t i1, uint32_t i2) { return mDEClusters[i1]->getY() < mDEClusters[i2]->getY(); });
+      range.zMin = range.zMax = mDEClusters[range.offset]->getZ();
+      for (auto i = range.offset; i < range.offset + range.size; ++i) {
+        mSortedY[i] = mDEClusters[mDEClustersByY[i]]->getY();
+        range.zMin = std::min(range.zMin, double(mDEClusters[i]->getZ()));
+        range.zMax = std::max(range.zMax, double(mDEClusters[i]->getZ()));
+      }
+    }
+  }
+
+  mCandidateArena.clear();
+}
+
+//_________________________________________________________________________________________________
+TrackFinder::CandidateRange TrackFinder::selectClusterCandidates(const ClusterRange& de, const TrackParam& param)
+{
+  /// Push on the candidate arena the index of the clusters of the DE that can pass the fast compatibility
+  /// test of tryOneClusterFast in the bending direction, in their original order, and return their range
+  /// The range must be released with releaseClusterCandidates once used, before releasing the previous ones
+
+  auto begin = mCandidateArena.size();
+
+  // bending window at the z limits of the DE: the track position is linear in z and the tolerance
+  // is convex, so the window at any z in between is included in the union of the two
+  const TMatrixD& paramCov = param.getCovariances();
+  double yMin = std::numeric_limits<double>::max();
+  double yMax = -std::numeric_limits<double>::max();
+  for (auto z : {de.zMin, de.zMax}) {
+    double dZ = z - param.getZ();
+    double y = param.getBendingCoor() + param.getBendingSlope() * dZ;
+    double errY2 = paramCov(2, 2) + dZ * dZ * paramCov(3, 3) + 2. * dZ * paramCov(2, 3) + mChamberResolutionY2;
+    double dYmax = TrackerParam::Instance().sigmaCutForTracking * TMath::Sqrt(2. * errY2) + SMaxBendingDistanceToTrack;
+    yMin = std::min(yMin, y - dYmax);
+    yMax = std::max(yMax, y + dYmax);
+  }
+
+  auto first = mSortedY.begin() + de.offset;
+  auto last = first + de.size;
+  if (yMin <= yMax) { // take all the clusters if the window is not a number
+    yMin -= 1.e-3;    // margin against rounding errors, the exact test is done later
+    yMax += 1.e-3;
+    first = std::lower_bound(first, last, yMin);
+    last = std::upper_bound(first, last, yMax);
+  }
+  for (auto it = first; it < last; ++it) {
+    mCandidateArena.push_back(mDEClustersByY[it - mSortedY.begin()]);
+  }
+  std::sort(mCandidateArena.begin() + begin, mCandidateArena.end());
+
+  return {begin, mCandidateArena.size()};
+}
+
 //_________________________________________________________________________________________________
 void TrackFinder::findTrackCandidates()
 {
@@ -251,56 +334,55 @@ void TrackFinder::findTrackCandidates()
   // start by looking for candidates on station 5
   findTrackCandidatesInSt5();
 
-  for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
+  for (int iTrack = mFirstTrack; iTrack != SNoTrack;) {
 
     // prepare backward tracking if not already done
-    if (!itTrack->hasCurrentParam()) {
-      prepareBackwardTracking(itTrack, false);
+    if (!mTrackPool[iTrack].hasCurrentParam()) {
+      prepareBackwardTracking(mTrackPool[iTrack], false);
     }
 
     // look for compatible clusters on station 4
     std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
-    auto itNewTrack = followTrackInChamber(itTrack, 7, 6, false, excludedClusters);
+    auto iNewTrack = followTrackInChamber(iTrack, 7, 6, false, excludedClusters);
 
     // keep the current candidate only if no compatible cluster is found and the station is not requested
-    if (!TrackerParam::Instance().requestStation[3] && excludedClusters.empty() && itTrack->areCurrentParamValid()) {
-      ++itTrack;
+    if (!TrackerParam::Instance().requestStation[3] && excludedClusters.empty() && mTrackPool[iTrack].areCurrentParamValid()) {
+      iTrack = nextTrack(iTrack);
     } else {
-      print("findTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      print("findTrackCandidates: removing candidate at position #", getTrackIndex(iTrack));
+      iTrack = eraseTrack(iTrack);
       // prepare backward tracking for the new tracks
-      for (; itNewTrack != mTracks.end() && itNewTrack != itTrack; ++itNewTrack) {
-        prepareBackwardTracking(itNewTrack, false);
+      for (; iNewTrack != SNoTrack && iNewTrack != iTrack; iNewTrack = nextTrack(iNewTrack)) {
+        prepareBackwardTracking(mTrackPool[iNewTrack], false);
       }
     }
   }
 
   // list the cluster combinations already used in stations 4 and 5
-  std::vector<std::array<uint32_t, 8>> usedClusters(mTracks.size());
-  int iTrack(0);
-  for (const auto& track : mTracks) {
-    for (const auto& param : track) {
+  std::vector<std::array<uint32_t, 8>> usedClusters(mNTracks);
+  int iUsedTrack(0);
+  for (int iTrack = mFirstTrack; iTrack != SNoTrack; iTrack = nextTrack(iTrack), ++iUsedTrack) {
+    for (const auto& param : mTrackPool[iTrack]) {
       int iCl = 2 * (param.getClusterPtr()->getChamberId() - 6) + param.getClusterPtr()->getDEId() % 2;
-      usedClusters[iTrack][iCl] = param.getClusterPtr()->uid;
+      usedClusters[iUsedTrack][iCl] = param.getClusterPtr()->uid;
     }
-    ++iTrack;
   }
 
-  auto itLastCandidateFromSt5 = mTracks.empty() ? mTracks.end() : std::prev(mTracks.end());
+  auto iLastCandidateFromSt5 = mLastTrack;
 
   // then look for candidates on station 4
   findTrackCandidatesInSt4();
 
-  auto itFirstCandidateOnSt4 = (itLastCandidateFromSt5 == mTracks.end()) ? mTracks.begin() : std::next(itLastCandidateFromSt5);
-  for (auto itTrack = itFirstCandidateOnSt4; itTrack != mTracks.end();) {
+  auto iFirstCandidateOnSt4 = (iLastCandidateFromSt5 == SNoTrack) ? mFirstTrack : nextTrack(iLastCandidateFromSt5);
+  for (int iTrack = iFirstCandidateOnSt4; iTrack != SNoTrack;) {
 
     // prepare forward tracking if not already done
-    if (!itTrack->hasCurrentParam()) {
+    if (!mTrackPool[iTrack].hasCurrentParam()) {
       try {
-        prepareForwardTracking(itTrack, true);
+        prepareForwardTracking(mTrackPool[iTrack], true);
       } catch (exception const&) {
-        print("findTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-        itTrack = mTracks.erase(itTrack);
+        print("findTrackCandidates: removing candidate at position #", getTrackIndex(iTrack));
+        iTrack = eraseTrack(iTrack);
         continue;
       }
     }
@@ -311,35 +393,35 @@ void TrackFinder::findTrackCandidates()
     std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
     if (!usedClusters.empty()) {
       std::array<uint32_t, 4> currentClusters{};
-      for (const auto& param : *itTrack) {
+      for (const auto& param : mTrackPool[iTrack]) {
         int iCl = 2 * (param.getClusterPtr()->getChamberId() - 6) + param.getClusterPtr()->getDEId() % 2;
         currentClusters[iCl] = param.getClusterPtr()->uid;
       }
       excludeClustersFromIdenticalTracks(currentClusters, usedClusters, excludedClusters);
     }
-    auto itFirstNewTrack = followTrackInChamber(itTrack, 8, 8, false, excludedClusters);
-    auto itNewTrack = followTrackInChamber(itTrack, 9, 9, false, excludedClusters);
-    if (itFirstNewTrack == mTracks.end()) {
-      itFirstNewTrack = itNewTrack;
+    auto iFirstNewTrack = followTrackInChamber(iTrack, 8, 8, false, excludedClusters);
+    auto iNewTrack = followTrackInChamber(iTrack, 9, 9, false, excludedClusters);
+    if (iFirstNewTrack == SNoTrack) {
+      iFirstNewTrack = iNewTrack;
     }
 
     // keep the current candidate only if no compatible cluster is found and the station is not requested
     if (!TrackerParam::Instance().requestStation[4] && excludedClusters.empty()) {
-      itFirstNewTrack = itTrack;
-      ++itTrack;
+      iFirstNewTrack = iTrack;
+      iTrack = nextTrack(iTrack);
     } else {
-      print("findTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      print("findTrackCandidates: removing candidate at position #", getTrackIndex(iTrack));
+      iTrack = eraseTrack(iTrack);
     }
 
     // refit the track(s) and prepare to continue the tracking in the backward direction
-    while (itFirstNewTrack != mTracks.end() && itFirstNewTrack != itTrack) {
+    while (iFirstNewTrack != SNoTrack && iFirstNewTrack != iTrack) {
       try {
-        prepareBackwardTracking(itFirstNewTrack, true);
-        ++itFirstNewTrack;
+        prepareBackwardTracking(mTrackPool[iFirstNewTrack], true);
+        iFirstNewTrack = nextTrack(iFirstNewTrack);
       } catch (exception const&) {
-        print("findTrackCandidates: removing candidate at position #", getTrackIndex(itFirstNewTrack));
-        itFirstNewTrack = mTracks.erase(itFirstNewTrack);
+        print("findTrackCandidates: removing candidate at position #", getTrackIndex(iFirstNewTrack));
+        iFirstNewTrack = eraseTrack(iFirstNewTrack);
       }
     }
   }
@@ -361,86 +443,86 @@ void TrackFinder::findTrackCandidatesInSt5()
       bool skipUsedPairs = (iPlaneCh9 == 24 || iPlaneCh9 == 26 || iPlaneCh10 == 29 || iPlaneCh10 == 31);
 
       // find all valid candidates between these 2 planes
-      auto itTrack = findTrackCandidates(iPlaneCh9, iPlaneCh10, skipUsedPairs, mTracks.begin());
+      auto iTrack = findTrackCandidates(iPlaneCh9, iPlaneCh10, skipUsedPairs, mFirstTrack);
 
       // stop here if overlaps have already been checked on both chambers
       if ((iPlaneCh9 == 24 || iPlaneCh9 == 26) && (iPlaneCh10 == 29 || iPlaneCh10 == 31)) {
         continue;
       }
 
-      while (itTrack != mTracks.end()) {
+      while (iTrack != SNoTrack) {
 
-        auto itNextTrack = std::next(itTrack);
+        auto iNextTrack = nextTrack(iTrack);
 
         if (iPlaneCh10 == 28 || iPlaneCh10 == 30) {
 
           // if not already done, look for compatible clusters in the overlapping regions of chamber 10
           try {
-            prepareForwardTracking(itTrack, true);
+            prepareForwardTracking(mTrackPool[iTrack], true);
           } catch (exception const&) {
-            print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(iTrack));
+            iTrack = eraseTrack(iTrack);
             continue;
           }
-          auto itNewTrack = followTrackInOverlapDE(itTrack, itTrack->last().getClusterPtr()->getDEId(), iPlaneCh10 + 1);
+          auto iNewTrack = followTrackInOverlapDE(iTrack, mTrackPool[iTrack].last().getClusterPtr()->getDEId(), iPlaneCh10 + 1);
 
-          if (itNewTrack != mTracks.end()) {
+          if (iNewTrack != SNoTrack) {
 
             // remove the initial candidate if compatible cluster(s) are found
-            print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(iTrack));
+            iTrack = eraseTrack(iTrack);
 
             // refit the track(s) with new attached cluster(s) and prepare to continue the tracking in the backward direction
             bool stop(false);
             while (!stop) {
-              itTrack = std::prev(itTrack);
-              if (itTrack == itNewTrack) {
+              iTrack = previousTrack(iTrack);
+              if (iTrack == iNewTrack) {
                 stop = true;
               }
               try {
-                prepareBackwardTracking(itTrack, true);
+                prepareBackwardTracking(mTrackPool[iTrack], true);
               } catch (exception const&) {
-                print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(itTrack));
-                itTrack = mTracks.erase(itTrack);
+                print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(iTrack));
+                iTrack = eraseTrack(iTrack);
               }
             }
           } else {
             // prepare to continue the tracking in the backward direction with the initial candidate
-            prepareBackwardTracking(itTrack, false);
+            prepareBackwardTracking(mTrackPool[iTrack], false);
           }
         }
 
         if (iPlaneCh9 == 25 || iPlaneCh9 == 27) {
 
-          while (itTrack != itNextTrack) {
+          while (iTrack != iNextTrack) {
 
             // if not already done, look for compatible clusters in the overlapping regions of chamber 9
-            if (!itTrack->hasCurrentParam()) {
-              prepareBackwardTracking(itTrack, false);
+            if (!mTrackPool[iTrack].hasCurrentParam()) {
+              prepareBackwardTracking(mTrackPool[iTrack], false);
             }
-            auto itNewTrack = followTrackInOverlapDE(itTrack, itTrack->first().getClusterPtr()->getDEId(), iPlaneCh9 - 1);
+            auto iNewTrack = followTrackInOverlapDE(iTrack, mTrackPool[iTrack].first().getClusterPtr()->getDEId(), iPlaneCh9 - 1);
 
             // keep the initial candidate only if no compatible cluster is found
-            if (itNewTrack == mTracks.end()) {
-              ++itTrack;
+            if (iNewTrack == SNoTrack) {
+              iTrack = nextTrack(iTrack);
             } else {
-              print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(itTrack));
-              itTrack = mTracks.erase(itTrack);
+              print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(iTrack));
+              iTrack = eraseTrack(iTrack);
             }
           }
         }
 
-        itTrack = itNextTrack;
+        iTrack = iNextTrack;
       }
     }
   }
 
   // remove tracks out of limits now that overlaps have been checked
-  for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
-    if (itTrack->isRemovable()) {
-      itTrack = mTracks.erase(itTrack);
+  for (int iTrack = mFirstTrack; iTrack != SNoTrack;) {
+    if (mTrackPool[iTrack].isRemovable()) {
+      iTrack = eraseTrack(iTrack);
     } else {
-      ++itTrack;
+      iTrack = nextTrack(iTrack);
     }
   }
 }
@@ -453,7 +535,7 @@ void TrackFinder::findTrackCandidatesInSt4()
 
   print("--- find candidates in station 4 ---");
 
-  auto itLastCandidateFromSt5 = mTracks.empty() ? mTracks.end() : std::prev(mTracks.end());
+  auto iLastCandidateFromSt5 = mLastTrack;
 
   for (int iPlaneCh8 = 20; iPlaneCh8 < 24; ++iPlaneCh8) {
 
@@ -463,61 +545,61 @@ void TrackFinder::findTrackCandidatesInSt4()
       bool skipUsedPairs = (iPlaneCh7 == 18 || iPlaneCh7 == 16 || iPlaneCh8 == 21 || iPlaneCh8 == 23);
 
       // find all valid candidates between these 2 planes
-      auto itFirstCandidateOnSt4 = (itLastCandidateFromSt5 == mTracks.end()) ? mTracks.begin() : std::next(itLastCandidateFromSt5);
-      auto itTrack = findTrackCandidates(iPlaneCh7, iPlaneCh8, skipUsedPairs, itFirstCandidateOnSt4);
+      auto iFirstCandidateOnSt4 = (iLastCandidateFromSt5 == SNoTrack) ? mFirstTrack : nextTrack(iLastCandidateFromSt5);
+      auto iTrack = findTrackCandidates(iPlaneCh7, iPlaneCh8, skipUsedPairs, iFirstCandidateOnSt4);
 
       // stop here if overlaps have already been checked on both chambers
       if ((iPlaneCh7 == 18 || iPlaneCh7 == 16) && (iPlaneCh8 == 21 || iPlaneCh8 == 23)) {
         continue;
       }
 
-      while (itTrack != mTracks.end()) {
+      while (iTrack != SNoTrack) {
 
-        auto itNextTrack = std::next(itTrack);
+        auto iNextTrack = nextTrack(iTrack);
 
         if (iPlaneCh7 == 19 || iPlaneCh7 == 17) {
 
           // if not already done, look for compatible clusters in the overlapping regions of chamber 7
-          prepareBackwardTracking(itTrack, false);
-          auto itNewTrack = followTrackInOverlapDE(itTrack, itTrack->first().getClusterPtr()->getDEId(), iPlaneCh7 - 1);
+          prepareBackwardTracking(mTrackPool[iTrack], false);
+          auto iNewTrack = followTrackInOverlapDE(iTrack, mTrackPool[iTrack].first().getClusterPtr()->getDEId(), iPlaneCh7 - 1);
 
           // keep the initial candidate only if no compatible cluster is found
-          if (itNewTrack != mTracks.end()) {
-            print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(itTrack));
-            mTracks.erase(itTrack);
-            itTrack = itNewTrack;
+          if (iNewTrack != SNoTrack) {
+            print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(iTrack));
+            eraseTrack(iTrack);
+            iTrack = iNewTrack;
           }
         }
 
-        while (itTrack != itNextTrack) {
+        while (iTrack != iNextTrack) {
 
           // for every tracks, prepare to continue the tracking in the forward direction
           try {
-            prepareForwardTracking(itTrack, true);
+            prepareForwardTracking(mTrackPool[iTrack], true);
           } catch (exception const&) {
-            print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(iTrack));
+            iTrack = eraseTrack(iTrack);
             continue;
           }
 
           if (iPlaneCh8 == 20 || iPlaneCh8 == 22) {
 
             // if not already done, look for compatible clusters in the overlapping regions of chamber 8
-            auto itNewTrack = followTrackInOverlapDE(itTrack, itTrack->last().getClusterPtr()->getDEId(), iPlaneCh8 + 1);
+            auto iNewTrack = followTrackInOverlapDE(iTrack, mTrackPool[iTrack].last().getClusterPtr()->getDEId(), iPlaneCh8 + 1);
 
             // keep the initial candidate only if no compatible cluster is found
-            if (itNewTrack == mTracks.end()) {
-              ++itTrack;
+            if (iNewTrack == SNoTrack) {
+              iTrack = nextTrack(iTrack);
             } else {
               // prepare to continue the tracking of the new tracks from the last attached cluster
-              for (; itNewTrack != itTrack; ++itNewTrack) {
-                prepareForwardTracking(itNewTrack, false);
+              for (; iNewTrack != iTrack; iNewTrack = nextTrack(iNewTrack)) {
+                prepareForwardTracking(mTrackPool[iNewTrack], false);
               }
-              print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(itTrack));
-              itTrack = mTracks.erase(itTrack);
+              print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(iTrack));
+              iTrack = eraseTrack(iTrack);
             }
           } else {
-            ++itTrack;
+            iTrack = nextTrack(iTrack);
           }
         }
       }
@@ -525,12 +607,12 @@ void TrackFinder::findTrackCandidatesInSt4()
   }
 
   // remove tracks out of limits now that overlaps have been checked
-  auto itTrack = (itLastCandidateFromSt5 == mTracks.end()) ? mTracks.begin() : ++itLastCandidateFromSt5;
-  while (itTrack != mTracks.end()) {
-    if (itTrack->isRemovable()) {
-      itTrack = mTracks.erase(itTrack);
+  auto iTrack = (iLastCandidateFromSt5 == SNoTrack) ? mFirstTrack : nextTrack(iLastCandidateFromSt5);
+  while (iTrack != SNoTrack) {
+    if (mTrackPool[iTrack].isRemovable()) {
+      iTrack = eraseTrack(iTrack);
     } else {
-      ++itTrack;
+      iTrack = nextTrack(iTrack);
     }
   }
 }
@@ -545,109 +627,109 @@ void TrackFinder::findMoreTrackCandidates()
 
   print("--- find more candidates ---");
 
-  auto itLastCandidate = mTracks.empty() ? mTracks.end() : std::prev(mTracks.end());
+  auto iLastCandidate = mLastTrack;
 
   for (int iPlaneSt4 = 23; iPlaneSt4 > 15; --iPlaneSt4) {
 
     for (int iPlaneSt5 = 24; iPlaneSt5 < 32; ++iPlaneSt5) {
 
       // find all valid candidates between these 2 planes
-      auto itTrack = findTrackCandidates(iPlaneSt4, iPlaneSt5, true, mTracks.begin());
+      auto iTrack = findTrackCandidates(iPlaneSt4, iPlaneSt5, true, mFirstTrack);
 
       // stop here if overlaps have already been checked on both chambers
       if ((iPlaneSt4 % 2 == 0) && (iPlaneSt5 % 2 == 1)) {
         continue;
       }
 
-      while (itTrack != mTracks.end()) {
+      while (iTrack != SNoTrack) {
 
-        auto itNextTrack = std::next(itTrack);
+        auto iNextTrack = nextTrack(iTrack);
 
         if (iPlaneSt5 % 2 == 0) {
 
           // if not already done, look for compatible clusters in the overlapping regions of that chamber in station 5
           try {
-            prepareForwardTracking(itTrack, true);
+            prepareForwardTracking(mTrackPool[iTrack], true);
           } catch (exception const&) {
-            print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(iTrack));
+            iTrack = eraseTrack(iTrack);
             continue;
           }
-          auto itNewTrack = followTrackInOverlapDE(itTrack, itTrack->last().getClusterPtr()->getDEId(), iPlaneSt5 + 1);
+          auto iNewTrack = followTrackInOverlapDE(iTrack, mTrackPool[iTrack].last().getClusterPtr()->getDEId(), iPlaneSt5 + 1);
 
-          if (itNewTrack != mTracks.end()) {
+          if (iNewTrack != SNoTrack) {
 
             // remove the initial candidate if compatible cluster(s) are found
-            print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(iTrack));
+            iTrack = eraseTrack(iTrack);
 
             // refit the track(s) with new cluster(s) and prepare to continue the tracking in the backward direction
             bool stop(false);
             while (!stop) {
-              itTrack = std::prev(itTrack);
-              if (itTrack == itNewTrack) {
+              iTrack = previousTrack(iTrack);
+              if (iTrack == iNewTrack) {
                 stop = true;
               }
               try {
-                prepareBackwardTracking(itTrack, true);
+                prepareBackwardTracking(mTrackPool[iTrack], true);
               } catch (exception const&) {
-                print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-                itTrack = mTracks.erase(itTrack);
+                print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(iTrack));
+                iTrack = eraseTrack(iTrack);
               }
             }
           } else {
             // prepare to continue the tracking in the backward direction with the initial candidate
-            prepareBackwardTracking(itTrack, false);
+            prepareBackwardTracking(mTrackPool[iTrack], false);
           }
         }
 
         if (iPlaneSt4 % 2 == 1) {
 
-          while (itTrack != itNextTrack) {
+          while (iTrack != iNextTrack) {
 
             // if not already done, look for compatible clusters in the overlapping regions of that chamber in station 4
-            if (!itTrack->hasCurrentParam()) {
-              prepareBackwardTracking(itTrack, false);
+            if (!mTrackPool[iTrack].hasCurrentParam()) {
+              prepareBackwardTracking(mTrackPool[iTrack], false);
             }
-            auto itNewTrack = followTrackInOverlapDE(itTrack, itTrack->first().getClusterPtr()->getDEId(), iPlaneSt4 - 1);
+            auto iNewTrack = followTrackInOverlapDE(iTrack, mTrackPool[iTrack].first().getClusterPtr()->getDEId(), iPlaneSt4 - 1);
 
             // keep the initial candidate only if no compatible cluster is found
-            if (itNewTrack == mTracks.end()) {
-              ++itTrack;
+            if (iNewTrack == SNoTrack) {
+              iTrack = nextTrack(iTrack);
             } else {
-              print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-              itTrack = mTracks.erase(itTrack);
+              print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(iTrack));
+              iTrack = eraseTrack(iTrack);
             }
           }
         }
 
-        itTrack = itNextTrack;
+        iTrack = iNextTrack;
       }
     }
   }
 
   // remove tracks out of limits now that overlaps have been checked
   // and make sure every new tracks are prepared to continue the tracking in the backward direction
-  auto itTrack = (itLastCandidate == mTracks.end()) ? mTracks.begin() : ++itLastCandidate;
-  while (itTrack != mTracks.end()) {
-    if (itTrack->isRemovable()) {
-      itTrack = mTracks.erase(itTrack);
+  auto iTrack = (iLastCandidate == SNoTrack) ? mFirstTrack : nextTrack(iLastCandidate);
+  while (iTrack != SNoTrack) {
+    if (mTrackPool[iTrack].isRemovable()) {
+      iTrack = eraseTrack(iTrack);
     } else {
-      if (!itTrack->hasCurrentParam()) {
-        prepareBackwardTracking(itTrack, false);
+      if (!mTrackPool[iTrack].hasCurrentParam()) {
+        prepareBackwardTracking(mTrackPool[iTrack], false);
       }
-      ++itTrack;
+      iTrack = nextTrack(iTrack);
     }
   }
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, const std::list<Track>::iterator& itFirstTrack)
+int TrackFinder::findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, int iFirstTrack)
 {
   /// Find all combinations of clusters between the 2 planes that could belong to a valid track
-  /// If skipUsedPairs == true: skip combinations of clusters already part of a track starting from itFirstTrack
+  /// If skipUsedPairs == true: skip combinations of clusters already part of a track starting from iFirstTrack
   /// New candidates are added at the end of the track list
-  /// Return an iterator to the first candidate found
+  /// Return the index of the first candidate found, or SNoTrack if none is found
 
   const auto& trackerParam = TrackerParam::Instance();
 
@@ -658,17 +740,17 @@ std::list<Track>::iterator TrackFinder::findTrackCandidates(int plane1, int plan
     impactMCS2 += SDefaultChamberZ[iCh] * SDefaultChamberZ[iCh] * mMaxMCSAngle2[iCh];
   }
 
-  // create an iterator to the last track of the list before adding new ones
-  auto itTrack = mTracks.empty() ? mTracks.end() : std::prev(mTracks.end());
+  // keep the index of the last track of the list before adding new ones
+  auto iTrack = mLastTrack;
 
   // list the cluster combinations used on the chambers corresponding to plane1 and plane2
   int chamber2 = getChamberId(plane2);
   std::vector<std::array<uint32_t, 4>> usedClusters{};
   if (skipUsedPairs) {
-    usedClusters.reserve(mTracks.size());
-    for (auto itTrk = itFirstTrack; itTrk != mTracks.end(); ++itTrk) {
+    usedClusters.reserve(mNTracks);
+    for (auto iTrk = iFirstTrack; iTrk != SNoTrack; iTrk = nextTrack(iTrk)) {
       usedClusters.push_back({0, 0, 0, 0});
-      for (const auto& param : *itTrk) {
+      for (const auto& param : mTrackPool[iTrk]) {
         int ch = param.getClusterPtr()->getChamberId();
         if (ch == chamber1) {
           usedClusters.back()[param.getClusterPtr()->getDEId() % 2] = param.getClusterPtr()->uid;
@@ -679,98 +761,110 @@ std::list<Track>::iterator TrackFinder::findTrackCandidates(int plane1, int plan
     }
   }
 
-  for (auto& de1 : mClusters[plane1]) {
+  // select the pairs of clusters in parallel, per cluster of plane1, then create the track candidates
+  // sequentially in the original order of the clusters to get reproducible results
+  std::vector<const Cluster*> clusters1{};
+  for (const auto& de1 : mClusters[plane1]) {
+    auto clusters = getClusters(de1.second);
+    clusters1.insert(clusters1.end(), clusters.begin(), clusters.end());
+  }
+  if (mSeedClusters.size() < clusters1.size()) {
+    mSeedClusters.resize(clusters1.size());
+  }
 
-    // skip DE without cluster
-    if (de1.second == nullptr) {
-      continue;
-    }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(trackerParam.nThreads)
+#endif
+  for (int iCluster1 = 0; iCluster1 < static_cast<int>(clusters1.size()); ++iCluster1) {
 
-    for (const auto cluster1 : *de1.second) {
+    const auto cluster1 = clusters1[iCluster1];
+    auto& clusters2 = mSeedClusters[iCluster1];
+    clusters2.clear();
+    double z1 = cluster1->getZ();
 
-      double z1 = cluster1->getZ();
+    for (const auto& de2 : mClusters[plane2]) {
 
-      for (auto& de2 : mClusters[plane2]) {
+      for (const auto cluster2 : getClusters(de2.second)) {
 
-        // skip DE without cluster
-        if (de2.second == nullptr) {
+        // skip combinations of clusters already part of a track if requested
+        if (skipUsedPairs && areUsed(*cluster1, *cluster2, usedClusters)) {
           continue;
         }
 
-        for (const auto cluster2 : *de2.second) {
+        double z2 = cluster2->getZ();
+        double dZ = z1 - z2;
 
-          // skip combinations of clusters already part of a track if requested
-          if (skipUsedPairs && areUsed(*cluster1, *cluster2, usedClusters)) {
-            continue;
-          }
-
-          double z2 = cluster2->getZ();
-          double dZ = z1 - z2;
+        // check if non bending impact parameter is within tolerances
+        double nonBendingSlope = (cluster1->getX() - cluster2->getX()) / dZ;
+        double nonBendingImpactParam = TMath::Abs(cluster1->getX() - cluster1->getZ() * nonBendingSlope);
+        double nonBendingImpactParamErr = TMath::Sqrt((z1 * z1 * mChamberResolutionX2 + z2 * z2 * mChamberResolutionX2) / dZ / dZ + impactMCS2);
+        if ((nonBendingImpactParam - trackerParam.sigmaCutForTracking * nonBendingImpactParamErr) > (3. * trackerParam.nonBendingVertexDispersion)) {
+          continue;
+        }
 
-          // check if non bending impact parameter is within tolerances
-          double nonBendingSlope = (cluster1->getX() - cluster2->getX()) / dZ;
-          double nonBendingImpactParam = TMath::Abs(cluster1->getX() - cluster1->getZ() * nonBendingSlope);
-          double nonBendingImpactParamErr = TMath::Sqrt((z1 * z1 * mChamberResolutionX2 + z2 * z2 * mChamberResolutionX2) / dZ / dZ + impactMCS2);
-          if ((nonBendingImpactParam - trackerParam.sigmaCutForTracking * nonBendingImpactParamErr) > (3. * trackerParam.nonBendingVertexDispersion)) {
+        double bendingSlope = (cluster1->getY() - cluster2->getY()) / dZ;
+        if (TrackExtrap::isFieldON()) { // depending whether the field is ON or OFF
+          // check if bending momentum is within tolerances
+          double bendingImpactParam = cluster1->getY() - cluster1->getZ() * bendingSlope;
+          double bendingImpactParamErr2 = (z1 * z1 * mChamberResolutionY2 + z2 * z2 * mChamberResolutionY2) / dZ / dZ + impactMCS2;
+          double bendingMomentum = TMath::Abs(TrackExtrap::getBendingMomentumFromImpactParam(bendingImpactParam));
+          double bendingMomentumErr = TMath::Sqrt((mBendingVertexDispersion2 + bendingImpactParamErr2) / bendingImpactParam / bendingImpactParam + 0.01) * bendingMomentum;
+          if ((bendingMomentum + 3. * bendingMomentumErr) < SMinBendingMomentum) {
             continue;
           }
-
-          double bendingSlope = (cluster1->getY() - cluster2->getY()) / dZ;
-          if (TrackExtrap::isFieldON()) { // depending whether the field is ON or OFF
-            // check if bending momentum is within tolerances
-            double bendingImpactParam = cluster1->getY() - cluster1->getZ() * bendingSlope;
-            double bendingImpactParamErr2 = (z1 * z1 * mChamberResolutionY2 + z2 * z2 * mChamberResolutionY2) / dZ / dZ + impactMCS2;
-            double bendingMomentum = TMath::Abs(TrackExtrap::getBendingMomentumFromImpactParam(bendingImpactParam));
-            double bendingMomentumErr = TMath::Sqrt((mBendingVertexDispersion2 + bendingImpactParamErr2) / bendingImpactParam / bendingImpactParam + 0.01) * bendingMomentum;
-            if ((bendingMomentum + 3. * bendingMomentumErr) < SMinBendingMomentum) {
-              continue;
-            }
-          } else {
-            // or check if bending impact parameter is within tolerances
-            double bendingImpactParam = TMath::Abs(cluster1->getY() - cluster1->getZ() * bendingSlope);
-            double bendingImpactParamErr = TMath::Sqrt((z1 * z1 * mChamberResolutionY2 + z2 * z2 * mChamberResolutionY2) / dZ / dZ + impactMCS2);
-            if ((bendingImpactParam - trackerParam.sigmaCutForTracking * bendingImpactParamErr) > (3. * trackerParam.bendingVertexDispersion)) {
-              continue;
-            }
+        } else {
+          // or check if bending impact parameter is within tolerances
+          double bendingImpactParam = TMath::Abs(cluster1->getY() - cluster1->getZ() * bendingSlope);
+          double bendingImpactParamErr = TMath::Sqrt((z1 * z1 * mChamberResolutionY2 + z2 * z2 * mChamberResolutionY2) / dZ / dZ + impactMCS2);
+          if ((bendingImpactParam - trackerParam.sigmaCutForTracking * bendingImpactParamErr) > (3. * trackerParam.bendingVertexDispersion)) {
+            continue;
           }
-
-          // create a new track candidate
-          createTrack(*cluster1, *cluster2);
         }
+
+        clusters2.push_back(cluster2);
       }
     }
   }
 
-  return (itTrack == mTracks.end()) ? mTracks.begin() : ++itTrack;
+  for (std::size_t iCluster1 = 0; iCluster1 < clusters1.size(); ++iCluster1) {
+    for (const auto cluster2 : mSeedClusters[iCluster1]) {
+
+      // create a new track candidate
+      createTrack(*clusters1[iCluster1], *cluster2);
+    }
+  }
+
+  return (iTrack == SNoTrack) ? mFirstTrack : nextTrack(iTrack);
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<Track>::iterator& itTrack, int currentDE, int plane)
+int TrackFinder::followTrackInOverlapDE(int iTrack, int currentDE, int plane)
 {
-  /// Follow the track candidate "itTrack" in the DE of the "plane" overlapping "currentDE" and look for compatible clusters
+  /// Follow the track candidate "iTrack" in the DE of the "plane" overlapping "currentDE" and look for compatible clusters
   /// The tracking starts from the current parameters, which are supposed to be at a cluster on the same chamber
-  /// The track is duplicated to consider all possibilities and new candidates are added before "itTrack"
+  /// The track is duplicated to consider all possibilities and new candidates are added before "iTrack"
   /// Tracks going out of limits with the new cluster are added anyway and tagged as removable
-  /// The method returns an iterator to the first new candidate, or mTracks.end() if none is found
-  /// The initial candidate "itTrack" is not modified and the new tracks don't have their current parameters set
+  /// The method returns the index of the first new candidate, or SNoTrack if none is found
+  /// The initial candidate "iTrack" is not modified and the new tracks don't have their current parameters set
 
-  print("followTrackInOverlapDE: follow track #", getTrackIndex(itTrack), " currently at DE ", currentDE, " to plane ", plane);
-  printTrack(*itTrack);
+  print("followTrackInOverlapDE: follow track #", getTrackIndex(iTrack), " currently at DE ", currentDE, " to plane ", plane);
+  printTrack(mTrackPool[iTrack]);
 
   // the current track parameters must be set
-  assert(itTrack->hasCurrentParam());
+  assert(mTrackPool[iTrack].hasCurrentParam());
 
-  auto itNewTrack(itTrack);
+  auto iNewTrack(iTrack);
 
-  const TrackParam& currentParam = itTrack->getCurrentParam();
-  int currentChamber = itTrack->getCurrentChamber();
+  // the current parameters are not owned by the pool storage, so this reference survives the addition of new tracks
+  const TrackParam& currentParam = mTrackPool[iTrack].getCurrentParam();
+  int currentChamber = mTrackPool[iTrack].getCurrentChamber();
 
   // loop over all DEs of plane
   TrackParam paramAtCluster{};
   for (auto& de : mClusters[plane]) {
 
     // skip DE without cluster
-    if (de.second == nullptr) {
+    if (de.second.empty()) {
       continue;
     }
 
@@ -780,7 +874,7 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
     }
 
     // look for cluster candidate in this DE
-    for (const auto cluster : *de.second) {
+    for (const auto cluster : getClusters(de.second)) {
 
       // try to add the current cluster
       if (!isCompatible(currentParam, *cluster, paramAtCluster)) {
@@ -788,36 +882,35 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
       }
 
       // duplicate the track and add the new cluster
-      itNewTrack = addTrack(itNewTrack, *itTrack);
-      print("followTrackInOverlapDE: duplicating candidate at position #", getTrackIndex(itNewTrack), " to add cluster ", cluster->getIdAsString());
-      itNewTrack->addParamAtCluster(paramAtCluster);
+      iNewTrack = addTrack(iNewTrack, iTrack);
+      print("followTrackInOverlapDE: duplicating candidate at position #", getTrackIndex(iNewTrack), " to add cluster ", cluster->getIdAsString());
+      mTrackPool[iNewTrack].addParamAtCluster(paramAtCluster);
 
       // tag the track as removable (if it is not already the case) if it is out of limits
-      if (!itNewTrack->isRemovable() && !isAcceptable(paramAtCluster)) {
-        itNewTrack->removable();
+      if (!mTrackPool[iNewTrack].isRemovable() && !isAcceptable(paramAtCluster)) {
+        mTrackPool[iNewTrack].removable();
       }
     }
   }
 
-  return (itNewTrack == itTrack) ? mTracks.end() : itNewTrack;
+  return (iNewTrack == iTrack) ? SNoTrack : iNewTrack;
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                             int chamber, int lastChamber, bool canSkip,
-                                                             std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+int TrackFinder::followTrackInChamber(int iTrack, int chamber, int lastChamber, bool canSkip,
+                                      std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
 {
-  /// Follow the track candidate pointed to by "itTrack" to the given "chamber"
+  /// Follow the track candidate "iTrack" to the given "chamber"
   /// The tracking starts from the current parameters, which must have already been set
   /// The direction of propagation is supposed to be forward if "chamber" is on station 5 and backward otherwise
   /// Look for compatible cluster(s), excluding those in the "excludedClusters" list, which
   /// correspond to compatible clusters already associated to this candidate in a previous step
   /// For each (pair of) cluster(s) found, continue the tracking to the next chamber, up to "lastChamber"
   /// This is a recursive procedure. Once reaching the last requested chamber, every valid tracks found
-  /// are added before "itTrack" and the associated clusters from this chamber onward are attached to them
-  /// The method returns an iterator to the first new candidate, or mTracks.end() if none is found
+  /// are added before "iTrack" and the associated clusters from this chamber onward are attached to them
+  /// The method returns the index of the first new candidate, or SNoTrack if none is found
   /// Every compatible clusters found in the process are added to the "excludedClusters" list
-  /// The initial candidate "itTrack" is not modified, with the exception of its current parameters,
+  /// The initial candidate "iTrack" is not modified, with the exception of its current parameters,
   /// which are set to the parameters at "chamber" or invalidated in case of propagation issue
   /// Throw an exception if the tracking duration exceeds limit
 
@@ -825,11 +918,11 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
   // which is forward when going to station 5 and backward otherwise with the present algorithm
   static constexpr int plane[10][4] = {{1, 0, -1, -1}, {3, 2, -1, -1}, {5, 4, -1, -1}, {7, 6, -1, -1}, {11, 10, 9, 8}, {15, 14, 13, 12}, {19, 18, 17, 16}, {23, 22, 21, 20}, {24, 25, 26, 27}, {28, 29, 30, 31}};
 
-  print("followTrackInChamber: follow track #", getTrackIndex(itTrack), " to chamber ", chamber + 1, " up to chamber ", lastChamber + 1);
+  print("followTrackInChamber: follow track #", getTrackIndex(iTrack), " to chamber ", chamber + 1, " up to chamber ", lastChamber + 1);
 
   // the current track parameters must be set at a different chamber and valid
-  if (!itTrack->areCurrentParamValid() || chamber == itTrack->getCurrentChamber()) {
-    return mTracks.end();
+  if (!mTrackPool[iTrack].areCurrentParamValid() || chamber == mTrackPool[iTrack].getCurrentChamber()) {
+    return SNoTrack;
   }
 
   std::chrono::duration<double> currentTrackingDuration = std::chrono::steady_clock::now() - mStartTime;
@@ -839,53 +932,53 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
   }
 
   // determine whether the chamber is the first one reached on the station
-  int currentChamber = itTrack->getCurrentChamber();
+  int currentChamber = mTrackPool[iTrack].getCurrentChamber();
   bool isFirstOnStation = ((chamber < currentChamber && chamber % 2 == 1) || (chamber > currentChamber && chamber % 2 == 0));
 
   // follow the track in the 2 planes or 4 half-planes of the chamber
-  auto itFirstNewTrack = followTrackInChamber(itTrack, plane[chamber][0], plane[chamber][1], lastChamber, excludedClusters);
+  auto iFirstNewTrack = followTrackInChamber(iTrack, plane[chamber][0], plane[chamber][1], lastChamber, excludedClusters);
   if (chamber > 3) {
-    auto itNewTrack = followTrackInChamber(itTrack, plane[chamber][2], plane[chamber][3], lastChamber, excludedClusters);
-    if (itFirstNewTrack == mTracks.end()) {
-      itFirstNewTrack = itNewTrack;
+    auto iNewTrack = followTrackInChamber(iTrack, plane[chamber][2], plane[chamber][3], lastChamber, excludedClusters);
+    if (iFirstNewTrack == SNoTrack) {
+      iFirstNewTrack = iNewTrack;
     }
   }
 
   // add MCS effects in that chamber before going further with this track or stop here if the track could not reach that chamber
-  if (itTrack->areCurrentParamValid()) {
-    TrackExtrap::addMCSEffect(itTrack->getCurrentParam(), SChamberThicknessInX0[chamber], -1.);
+  if (mTrackPool[iTrack].areCurrentParamValid()) {
+    TrackExtrap::addMCSEffect(mTrackPool[iTrack].getCurrentParam(), SChamberThicknessInX0[chamber], -1.);
   } else {
-    return itFirstNewTrack;
+    return iFirstNewTrack;
   }
 
   if (chamber != lastChamber) {
 
     // save the current track parameters before going to the next chamber
-    TrackParam currentParam = itTrack->getCurrentParam();
+    TrackParam currentParam = mTrackPool[iTrack].getCurrentParam();
 
     // consider the possibility to skip the chamber if it is the first one of the station or if we know we can skip it,
     // i.e. if a compatible cluster has been found on the first chamber and none has been found on the second
     if (isFirstOnStation || (canSkip && excludedClusters.empty())) {
       int nextChamber = (chamber > lastChamber) ? chamber - 1 : chamber + 1;
-      auto itNewTrack = followTrackInChamber(itTrack, nextChamber, lastChamber, false, excludedClusters);
-      if (itFirstNewTrack == mTracks.end()) {
-        itFirstNewTrack = itNewTrack;
+      auto iNewTrack = followTrackInChamber(iTrack, nextChamber, lastChamber, false, excludedClusters);
+      if (iFirstNewTrack == SNoTrack) {
+        iFirstNewTrack = iNewTrack;
       }
     }
 
     // consider the possibility to skip the entire station if not requested and not the last one
     if (isFirstOnStation && !TrackerParam::Instance().requestStation[chamber / 2] && chamber / 2 != lastChamber / 2) {
       int nextChamber = (chamber > lastChamber) ? chamber - 2 : chamber + 2;
-      auto itNewTrack = followTrackInChamber(itTrack, nextChamber, lastChamber, false, excludedClusters);
-      if (itFirstNewTrack == mTracks.end()) {
-        itFirstNewTrack = itNewTrack;
+      auto iNewTrack = followTrackInChamber(iTrack, nextChamber, lastChamber, false, excludedClusters);
+      if (iFirstNewTrack == SNoTrack) {
+        iFirstNewTrack = iNewTrack;
       }
     }
 
     // reset the current track parameters to the ones at that chamber if needed
     // (not sure it is needed at all but that way it is clear what the current track parameters are at the end of this function)
-    if (itTrack->getCurrentChamber() != chamber) {
-      setCurrentParam(*itTrack, currentParam, chamber);
+    if (mTrackPool[iTrack].getCurrentChamber() != chamber) {
+      setCurrentParam(mTrackPool[iTrack], currentParam, chamber);
     }
   } else {
 
@@ -893,57 +986,56 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
     // or if one reaches station 1 and it is not requested, whether a cluster has been found on it or not
     if ((!isFirstOnStation && canSkip && excludedClusters.empty()) ||
         (chamber / 2 == 0 && !TrackerParam::Instance().requestStation[0] && (isFirstOnStation || !canSkip))) {
-      auto itNewTrack = addTrack(itTrack, *itTrack);
-      if (itFirstNewTrack == mTracks.end()) {
-        itFirstNewTrack = itNewTrack;
+      auto iNewTrack = addTrack(iTrack, iTrack);
+      if (iFirstNewTrack == SNoTrack) {
+        iFirstNewTrack = iNewTrack;
       }
-      print("followTrackInChamber: duplicating candidate at position #", getTrackIndex(itFirstNewTrack));
+      print("followTrackInChamber: duplicating candidate at position #", getTrackIndex(iFirstNewTrack));
     }
   }
 
-  return itFirstNewTrack;
+  return iFirstNewTrack;
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                             int plane1, int plane2, int lastChamber,
-                                                             std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+int TrackFinder::followTrackInChamber(int iTrack, int plane1, int plane2, int lastChamber,
+                                      std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
 {
-  /// Follow the track candidate pointed to by "itTrack" to the (half)chamber formed by "plane1" and "plane2"
+  /// Follow the track candidate "iTrack" to the (half)chamber formed by "plane1" and "plane2"
   /// The tracking starts from the current parameters, which must have already been set
   /// Look for compatible cluster(s), excluding those in the "excludedClusters" list, which
   /// correspond to compatible clusters already associated to this candidate in a previous step
   /// For each (pair of) cluster(s) found, continue the tracking to the next chamber, up to "lastChamber"
   /// This is a recursive procedure. Once reaching the last requested chamber, every valid tracks found
-  /// are added before "itTrack" and the associated clusters from this chamber onward are attached to them
+  /// are added before "iTrack" and the associated clusters from this chamber onward are attached to them
   /// Only the tracks with at least one compatible cluster found on plane1 or plane2 are considered
-  /// The method returns an iterator to the first new candidate, or mTracks.end() if none is found
+  /// The method returns the index of the first new candidate, or SNoTrack if none is found
   /// Every compatible clusters found in the process are added to the "excludedClusters" list
-  /// The initial candidate "itTrack" is not modified, with the exception of its current parameters,
+  /// The initial candidate "iTrack" is not modified, with the exception of its current parameters,
   /// which are set to the parameters at that chamber without adding MCS effects, or invalidated in case of issue
 
-  print("followTrackInChamber: follow track #", getTrackIndex(itTrack), " to planes ", plane1, " and ", plane2, " up to chamber ", lastChamber + 1);
-  printTrack(*itTrack);
+  print("followTrackInChamber: follow track #", getTrackIndex(iTrack), " to planes ", plane1, " and ", plane2, " up to chamber ", lastChamber + 1);
+  printTrack(mTrackPool[iTrack]);
 
   // the current track parameters must be set and valid
-  if (!itTrack->areCurrentParamValid()) {
-    return mTracks.end();
+  if (!mTrackPool[iTrack].areCurrentParamValid()) {
+    return SNoTrack;
   }
 
-  auto itFirstNewTrack(mTracks.end());
+  auto iFirstNewTrack(SNoTrack);
 
   // add MCS effects in the missing chambers if any. Update the current parameters in the process
   int chamber = getChamberId(plane1);
-  if ((chamber < itTrack->getCurrentChamber() - 1 || chamber > itTrack->getCurrentChamber() + 1) &&
-      !propagateCurrentParam(*itTrack, (chamber < itTrack->getCurrentChamber()) ? chamber + 1 : chamber - 1)) {
-    return mTracks.end();
+  if ((chamber < mTrackPool[iTrack].getCurrentChamber() - 1 || chamber > mTrackPool[iTrack].getCurrentChamber() + 1) &&
+      !propagateCurrentParam(mTrackPool[iTrack], (chamber < mTrackPool[iTrack].getCurrentChamber()) ? chamber + 1 : chamber - 1)) {
+    return SNoTrack;
   }
 
   // extrapolate the candidate to the chamber if not already there
-  TrackParam paramAtChamber = itTrack->getCurrentParam();
-  if (itTrack->getCurrentChamber() != chamber && !TrackExtrap::extrapToZCov(paramAtChamber, SDefaultChamberZ[chamber], true)) {
-    itTrack->invalidateCurrentParam();
-    return mTracks.end();
+  TrackParam paramAtChamber = mTrackPool[iTrack].getCurrentParam();
+  if (mTrackPool[iTrack].getCurrentChamber() != chamber && !TrackExtrap::extrapToZCov(paramAtChamber, SDefaultChamberZ[chamber], true)) {
+    mTrackPool[iTrack].invalidateCurrentParam();
+    return SNoTrack;
   }
 
   // determine the next chamber to go to, if lastChamber is not yet reached
@@ -962,7 +1054,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
   for (auto& de1 : mClusters[plane1]) {
 
     // skip DE without cluster
-    if (de1.second == nullptr) {
+    if (de1.second.empty()) {
       continue;
     }
 
@@ -970,8 +1062,12 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
     auto itExcludedClusters = excludedClusters.find(de1.first);
     bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
 
-    // look for cluster candidate in this DE
-    for (const auto cluster1 : *de1.second) {
+    // look for cluster candidate in this DE, among the ones close enough in the bending direction
+    // the candidates are accessed by index as the recursive calls below can reallocate the arena
+    auto candidates1 = selectClusterCandidates(de1.second, paramAtChamber);
+    for (auto iCandidate1 = candidates1.first; iCandidate1 < candidates1.second; ++iCandidate1) {
+
+      const auto cluster1 = mDEClusters[mCandidateArena[iCandidate1]];
 
       // skip excluded clusters
       if (hasExcludedClusters && itExcludedClusters->second.count(cluster1->uid) > 0) {
@@ -999,7 +1095,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       for (auto& de2 : mClusters[plane2]) {
 
         // skip DE without cluster
-        if (de2.second == nullptr) {
+        if (de2.second.empty()) {
           continue;
         }
 
@@ -1009,7 +1105,10 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
         }
 
         // look for cluster candidate in this DE
-        for (const auto cluster2 : *de2.second) {
+        auto candidates2 = selectClusterCandidates(de2.second, currentParamAtCluster1);
+        for (auto iCandidate2 = candidates2.first; iCandidate2 < candidates2.second; ++iCandidate2) {
+
+          const auto cluster2 = mDEClusters[mCandidateArena[iCandidate2]];
 
           // try to add the current cluster
           if (!isCompatible(currentParamAtCluster1, *cluster2, paramAtCluster2)) {
@@ -1027,35 +1126,37 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
           }
 
           // continue the tracking to the next chambers and attach the 2 clusters to the new tracks if any
-          auto itNewTrack = addClustersAndFollowTrack(itTrack, paramAtCluster1, &paramAtCluster2, nextChamber, lastChamber, newExcludedClusters);
-          if (itFirstNewTrack == mTracks.end()) {
-            itFirstNewTrack = itNewTrack;
+          auto iNewTrack = addClustersAndFollowTrack(iTrack, paramAtCluster1, &paramAtCluster2, nextChamber, lastChamber, newExcludedClusters);
+          if (iFirstNewTrack == SNoTrack) {
+            iFirstNewTrack = iNewTrack;
           }
 
           // transfert the list of new excluded clusters to the full list for the initial candidate
           moveClusters(newExcludedClusters, excludedClusters);
         }
+        releaseClusterCandidates(candidates2);
       }
 
       if (!cluster2Found && isAcceptableAtCluster1) {
 
         // continue the tracking with only cluster1 if no compatible cluster is found on plane2 and the track stays within limits
-        auto itNewTrack = addClustersAndFollowTrack(itTrack, paramAtCluster1, nullptr, nextChamber, lastChamber, newExcludedClusters);
-        if (itFirstNewTrack == mTracks.end()) {
-          itFirstNewTrack = itNewTrack;
+        auto iNewTrack = addClustersAndFollowTrack(iTrack, paramAtCluster1, nullptr, nextChamber, lastChamber, newExcludedClusters);
+        if (iFirstNewTrack == SNoTrack) {
+          iFirstNewTrack = iNewTrack;
         }
 
         // transfert the list of new excluded clusters to the full list for the initial candidate
         moveClusters(newExcludedClusters, excludedClusters);
       }
     }
+    releaseClusterCandidates(candidates1);
   }
 
   // loop over all DEs of plane2
   for (auto& de2 : mClusters[plane2]) {
 
     // skip DE without cluster
-    if (de2.second == nullptr) {
+    if (de2.second.empty()) {
       continue;
     }
 
@@ -1064,7 +1165,10 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
     bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
 
     // look for cluster candidate in this DE
-    for (const auto cluster2 : *de2.second) {
+    auto candidates2 = selectClusterCandidates(de2.second, paramAtChamber);
+    for (auto iCandidate2 = candidates2.first; iCandidate2 < candidates2.second; ++iCandidate2) {
+
+      const auto cluster2 = mDEClusters[mCandidateArena[iCandidate2]];
 
       // skip excluded clusters (in particular the ones already attached together with a cluster on plane1)
       if (hasExcludedClusters && itExcludedClusters->second.count(cluster2->uid) > 0) {
@@ -1085,90 +1189,91 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       }
 
       // continue the tracking to the next chambers and attach the cluster to the new tracks if any
-      auto itNewTrack = addClustersAndFollowTrack(itTrack, paramAtCluster2, nullptr, nextChamber, lastChamber, newExcludedClusters);
-      if (itFirstNewTrack == mTracks.end()) {
-        itFirstNewTrack = itNewTrack;
+      auto iNewTrack = addClustersAndFollowTrack(iTrack, paramAtCluster2, nullptr, nextChamber, lastChamber, newExcludedClusters);
+      if (iFirstNewTrack == SNoTrack) {
+        iFirstNewTrack = iNewTrack;
       }
 
       // transfert the list of new excluded clusters to the full list for the initial candidate
       moveClusters(newExcludedClusters, excludedClusters);
     }
+    releaseClusterCandidates(candidates2);
   }
 
   // reset the current parameters to the ones at that chamber if needed, not adding MCS effects yet
-  if (itTrack->getCurrentChamber() != chamber) {
-    setCurrentParam(*itTrack, paramAtChamber, chamber);
+  if (mTrackPool[iTrack].getCurrentChamber() != chamber) {
+    setCurrentParam(mTrackPool[iTrack], paramAtChamber, chamber);
   }
 
-  return itFirstNewTrack;
+  return iFirstNewTrack;
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
-                                                                  const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
-                                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+int TrackFinder::addClustersAndFollowTrack(int iTrack, const TrackParam& paramAtCluster1,
+                                           const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
+                                           std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
 {
-  /// If "nextChamber" >= 0: continue the tracking of "itTrack" up to "lastChamber", attach the two clusters
-  /// to every new tracks found and return an iterator to the first of them (or mTracks.end() if none is found)
+  /// If "nextChamber" >= 0: continue the tracking of "iTrack" up to "lastChamber", attach the two clusters
+  /// to every new tracks found and return the index of the first of them (or SNoTrack if none is found)
   /// Every compatible clusters found in the process is added to the "excludedClusters" list of this candidate
-  /// If nextChamber < 0: duplicate itTrack, attach the clusters and return an iterator to the new track
-  /// The initial candidate "itTrack" is not modified, with the exception of its current parameters
+  /// If nextChamber < 0: duplicate iTrack, attach the clusters and return the index of the new track
+  /// The initial candidate "iTrack" is not modified, with the exception of its current parameters
 
   // the list of excluded clusters must be empty here as new cluster(s) are being attached to the candidate
   assert(excludedClusters.empty());
 
-  auto itFirstNewTrack(mTracks.end());
+  auto iFirstNewTrack(SNoTrack);
 
   if (nextChamber >= 0) {
 
     // the tracking continues from paramAtCluster2, if any, or from paramAtCluster1
     if (paramAtCluster2) {
       print("addClustersAndFollowTrack: 2 clusters found (", paramAtCluster1.getClusterPtr()->getIdAsString(), " and ",
-            paramAtCluster2->getClusterPtr()->getIdAsString(), "). Continuing the tracking of candidate #", getTrackIndex(itTrack));
-      setCurrentParam(*itTrack, *paramAtCluster2, paramAtCluster2->getClusterPtr()->getChamberId());
+            paramAtCluster2->getClusterPtr()->getIdAsString(), "). Continuing the tracking of candidate #", getTrackIndex(iTrack));
+      setCurrentParam(mTrackPool[iTrack], *paramAtCluster2, paramAtCluster2->getClusterPtr()->getChamberId());
     } else {
       print("addClustersAndFollowTrack: 1 cluster found (", paramAtCluster1.getClusterPtr()->getIdAsString(),
-            "). Continuing the tracking of candidate #", getTrackIndex(itTrack));
-      setCurrentParam(*itTrack, paramAtCluster1, paramAtCluster1.getClusterPtr()->getChamberId());
+            "). Continuing the tracking of candidate #", getTrackIndex(iTrack));
+      setCurrentParam(mTrackPool[iTrack], paramAtCluster1, paramAtCluster1.getClusterPtr()->getChamberId());
     }
 
     // follow the track to the next chamber, which can be skipped if it is on the same station
     bool canSkip = (nextChamber / 2 == paramAtCluster1.getClusterPtr()->getChamberId() / 2);
-    auto itNewTrack = followTrackInChamber(itTrack, nextChamber, lastChamber, canSkip, excludedClusters);
-    itFirstNewTrack = itNewTrack;
+    auto iNewTrack = followTrackInChamber(iTrack, nextChamber, lastChamber, canSkip, excludedClusters);
+    iFirstNewTrack = iNewTrack;
 
     // attach the current cluster(s) to every new tracks found
-    if (itNewTrack != mTracks.end()) {
-      while (itNewTrack != itTrack) {
-        itNewTrack->addParamAtCluster(paramAtCluster1);
+    if (iNewTrack != SNoTrack) {
+      while (iNewTrack != iTrack) {
+        mTrackPool[iNewTrack].addParamAtCluster(paramAtCluster1);
         if (paramAtCluster2) {
-          itNewTrack->addParamAtCluster(*paramAtCluster2);
-          print("addClustersAndFollowTrack: add to the candidate at position #", getTrackIndex(itNewTrack),
+          mTrackPool[iNewTrack].addParamAtCluster(*paramAtCluster2);
+          print("addClustersAndFollowTrack: add to the candidate at position #", getTrackIndex(iNewTrack),
                 " clusters ", paramAtCluster1.getClusterPtr()->getIdAsString(), " and ", paramAtCluster2->getClusterPtr()->getIdAsString());
         } else {
-          print("addClustersAndFollowTrack: add to the candidate at position #", getTrackIndex(itNewTrack),
+          print("addClustersAndFollowTrack: add to the candidate at position #", getTrackIndex(iNewTrack),
                 " cluster ", paramAtCluster1.getClusterPtr()->getIdAsString());
         }
-        ++itNewTrack;
+        iNewTrack = nextTrack(iNewTrack);
       }
     }
 
   } else {
 
     // or duplicate the track and add the new cluster(s)
-    itFirstNewTrack = addTrack(itTrack, *itTrack);
-    itFirstNewTrack->addParamAtCluster(paramAtCluster1);
+    iFirstNewTrack = addTrack(iTrack, iTrack);
+    mTrackPool[iFirstNewTrack].addParamAtCluster(paramAtCluster1);
     if (paramAtCluster2) {
-      itFirstNewTrack->addParamAtCluster(*paramAtCluster2);
-      print("addClustersAndFollowTrack: duplicating candidate at position #", getTrackIndex(itFirstNewTrack), " to add 2 clusters (",
+      mTrackPool[iFirstNewTrack].addParamAtCluster(*paramAtCluster2);
+      print("addClustersAndFollowTrack: duplicating candidate at position #", getTrackIndex(iFirstNewTrack), " to add 2 clusters (",
             paramAtCluster1.getClusterPtr()->getIdAsString(), " and ", paramAtCluster2->getClusterPtr()->getIdAsString(), ")");
     } else {
-      print("addClustersAndFollowTrack: duplicating candidate at position #", getTrackIndex(itFirstNewTrack),
+      print("addClustersAndFollowTrack: duplicating candidate at position #", getTrackIndex(iFirstNewTrack),
             " to add 1 cluster (", paramAtCluster1.getClusterPtr()->getIdAsString(), ")");
     }
   }
 
-  return itFirstNewTrack;
+  return iFirstNewTrack;
 }
 
 //_________________________________________________________________________________________________
@@ -1179,30 +1284,31 @@ void TrackFinder::improveTracks()
   /// Recompute track parameters and covariances at the remaining clusters
   /// Remove the track if it cannot be improved or in case of failure
 
-  for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
+  for (int iTrack = mFirstTrack; iTrack != SNoTrack;) {
 
+    auto& track = mTrackPool[iTrack];
     bool removeTrack(false);
 
     // At the first step, only run the smoother
-    auto itStartingParam = std::prev(itTrack->rend());
+    auto itStartingParam = std::prev(track.rend());
 
     while (true) {
 
       // Refit the part of the track affected by the cluster removal, run the smoother, but do not finalize
       try {
-        mTrackFitter.fit(*itTrack, true, false, (itStartingParam == itTrack->rbegin()) ? nullptr : &itStartingParam);
+        mTrackFitter.fit(track, true, false, (itStartingParam == track.rbegin()) ? nullptr : &itStartingParam);
       } catch (exception const&) {
         removeTrack = true;
         break;
       }
 
       // Identify removable clusters
-      itTrack->tagRemovableClusters(requestedStationMask(), !TrackerParam::Instance().moreCandidates);
+      track.tagRemovableClusters(requestedStationMask(), !TrackerParam::Instance().moreCandidates);
 
       // Look for the cluster with the worst local chi2
       double worstLocalChi2(-1.);
-      auto itWorstParam(itTrack->end());
-      for (auto itParam = itTrack->begin(); itParam != itTrack->end(); ++itParam) {
+      auto itWorstParam(track.end());
+      for (auto itParam = track.begin(); itParam != track.end(); ++itParam) {
         if (itParam->getLocalChi2() > worstLocalChi2) {
           worstLocalChi2 = itParam->getLocalChi2();
           itWorstParam = itParam;
@@ -1221,13 +1327,13 @@ void TrackFinder::improveTracks()
       }
 
       // Remove the worst cluster
-      auto itNextParam = itTrack->removeParamAtCluster(itWorstParam);
+      auto itNextParam = track.removeParamAtCluster(itWorstParam);
 
       // Decide from where to refit the track: from the cluster next the one suppressed or
       // from scratch if the removed cluster was used to compute the tracking seed
-      itStartingParam = itTrack->rbegin();
-      auto itNextToNextParam = (itNextParam == itTrack->end()) ? itNextParam : std::next(itNextParam);
-      while (itNextToNextParam != itTrack->end()) {
+      itStartingParam = track.rbegin();
+      auto itNextToNextParam = (itNextParam == track.end()) ? itNextParam : std::next(itNextParam);
+      while (itNextToNextParam != track.end()) {
         if (itNextToNextParam->getClusterPtr()->getChamberId() != itNextParam->getClusterPtr()->getChamberId()) {
           itStartingParam = std::make_reverse_iterator(++itNextParam);
           break;
@@ -1238,10 +1344,10 @@ void TrackFinder::improveTracks()
 
     // Remove the track if it couldn't be improved
     if (removeTrack) {
-      print("improveTracks: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      print("improveTracks: removing candidate at position #", getTrackIndex(iTrack));
+      iTrack = eraseTrack(iTrack);
     } else {
-      ++itTrack;
+      iTrack = nextTrack(iTrack);
     }
   }
 }
@@ -1253,7 +1359,7 @@ void TrackFinder::removeConnectedTracks(int stMin, int stMax)
   /// For each couple of connected tracks, one removes the one with the smallest
   /// number of fired chambers or with the highest chi2/(ndf-1) value in case of equality
 
-  if (mTracks.size() < 2) {
+  if (mNTracks < 2) {
     return;
   }
 
@@ -1262,13 +1368,14 @@ void TrackFinder::removeConnectedTracks(int stMin, int stMax)
   int nPlane = 2 * (chMax - chMin + 1);
 
   // first loop to fill the arrays of cluster Ids, number of fired chambers and normalized chi2
-  std::vector<uint32_t> ClIds(nPlane * mTracks.size());
-  std::vector<uint8_t> nFiredCh(mTracks.size());
-  std::vector<double> nChi2(mTracks.size());
+  std::vector<uint32_t> ClIds(nPlane * mNTracks);
+  std::vector<uint8_t> nFiredCh(mNTracks);
+  std::vector<double> nChi2(mNTracks);
   int previousCh(-1);
   int iTrack(0);
-  for (auto itTrack = mTracks.begin(); itTrack != mTracks.end(); ++itTrack, ++iTrack) {
-    for (auto itParam = itTrack->rbegin(); itParam != itTrack->rend(); ++itParam) {
+  for (int iTrk = mFirstTrack; iTrk != SNoTrack; iTrk = nextTrack(iTrk), ++iTrack) {
+    auto& track = mTrackPool[iTrk];
+    for (auto itParam = track.rbegin(); itParam != track.rend(); ++itParam) {
       int ch = itParam->getClusterPtr()->getChamberId();
       if (ch != previousCh) {
         ++nFiredCh[iTrack];
@@ -1278,13 +1385,13 @@ void TrackFinder::removeConnectedTracks(int stMin, int stMax)
         ClIds[nPlane * iTrack + 2 * (ch - chMin) + itParam->getClusterPtr()->getDEId() % 2] = itParam->getClusterPtr()->uid;
       }
     }
-    nChi2[iTrack] = itTrack->first().getTrackChi2() / (itTrack->getNDF() - 1);
+    nChi2[iTrack] = track.first().getTrackChi2() / (track.getNDF() - 1);
   }
 
   // second loop to tag the tracks to remove
-  std::vector<bool> remove(mTracks.size(), false);
+  std::vector<bool> remove(mNTracks, false);
   int iindex = ClIds.size() - 1;
-  for (int iTrack1 = mTracks.size() - 1; iTrack1 > -1; --iTrack1, iindex -= nPlane) {
+  for (int iTrack1 = mNTracks - 1; iTrack1 > -1; --iTrack1, iindex -= nPlane) {
     int jindex = iindex - nPlane;
     for (int iTrack2 = iTrack1 - 1; iTrack2 > -1; --iTrack2) {
       for (int iPlane = nPlane; iPlane > 0; --iPlane) {
@@ -1308,12 +1415,12 @@ void TrackFinder::removeConnectedTracks(int stMin, int stMax)
 
   // third loop to remove them. That way all combinations are tested.
   iTrack = 0;
-  for (auto itTrack = mTracks.begin(); itTrack != mTracks.end(); ++iTrack) {
+  for (int iTrk = mFirstTrack; iTrk != SNoTrack; ++iTrack) {
     if (remove[iTrack]) {
-      print("removeConnectedTracks: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      print("removeConnectedTracks: removing candidate at position #", getTrackIndex(iTrk));
+      iTrk = eraseTrack(iTrk);
     } else {
-      ++itTrack;
+      iTrk = nextTrack(iTrk);
     }
   }
 }
@@ -1323,13 +1430,13 @@ void TrackFinder::refineTracks()
 {
   /// Refit, smooth and finalize the reconstructed tracks
 
-  for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
+  for (int iTrack = mFirstTrack; iTrack != SNoTrack;) {
     try {
-      mTrackFitter.fit(*itTrack);
-      ++itTrack;
+      mTrackFitter.fit(mTrackPool[iTrack]);
+      iTrack = nextTrack(iTrack);
     } catch (exception const&) {
-      print("refineTracks: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      print("refineTracks: removing candidate at position #", getTrackIndex(iTrack));
+      iTrack = eraseTrack(iTrack);
     }
   }
 }
@@ -1338,8 +1445,8 @@ void TrackFinder::refineTracks()
 void TrackFinder::finalize()
 {
   /// Copy the smoothed parameters and covariances into the regular ones
-  for (auto& track : mTracks) {
-    for (auto& param : track) {
+  for (int iTrack = mFirstTrack; iTrack != SNoTrack; iTrack = nextTrack(iTrack)) {
+    for (auto& param : mTrackPool[iTrack]) {
       param.setParameters(param.getSmoothParameters());
       param.setCovariances(param.getSmoothCovariances());
     }
@@ -1353,16 +1460,18 @@ void TrackFinder::createTrack(const Cluster& cl1, const Cluster& cl2)
   /// Compute the track parameters and covariance matrices at the 2 clusters
   /// Throw an exception if the maximum number of tracks is exceeded
 
-  if (mTracks.size() >= TrackerParam::Instance().maxCandidates) {
+  if (mNTracks >= TrackerParam::Instance().maxCandidates) {
     mErrorMap.add(ErrorType::Tracking_TooManyCandidates, 0, 0);
-    throw length_error(string("Too many track candidates (") + mTracks.size() + ")");
+    throw length_error(string("Too many track candidates (") + mNTracks + ")");
   }
 
-  // create the track and the trackParam at each cluster
-  Track& track = mTracks.emplace_back();
+  // create the track, in a recycled slot if any, and the trackParam at each cluster
+  auto iTrack = insertTrack(SNoTrack);
+  Track& track = mTrackPool[iTrack];
+  track = Track{};
   track.createParamAtCluster(cl2);
   track.createParamAtCluster(cl1);
-  print("createTrack: creating candidate at position #", getTrackIndex(std::prev(mTracks.end())),
+  print("createTrack: creating candidate at position #", getTrackIndex(iTrack),
         " with clusters ", cl1.getIdAsString(), " and ", cl2.getIdAsString());
 
   // fit the track using the Kalman filter
@@ -1370,20 +1479,92 @@ void TrackFinder::createTrack(const Cluster& cl1, const Cluster& cl2)
     mTrackFitter.fit(track, false);
   } catch (exception const&) {
     print("... fit failed --> removing it");
-    mTracks.erase(std::prev(mTracks.end()));
+    eraseTrack(iTrack);
   }
 }
 
 //_________________________________________________________________________________________________
-std::list<Track>::iterator TrackFinder::addTrack(const std::list<Track>::iterator& pos, const Track& track)
+int TrackFinder::addTrack(int pos, int iTrack)
 {
-  /// Add the given track at the requested position in the list of tracks
+  /// Add a copy of the track "iTrack" before the position "pos" in the list of tracks and return its index
   /// Throw an exception if the maximum number of tracks is exceeded
-  if (mTracks.size() >= TrackerParam::Instance().maxCandidates) {
+  if (mNTracks >= TrackerParam::Instance().maxCandidates) {
     mErrorMap.add(ErrorType::Tracking_TooManyCandidates, 0, 0);
-    throw length_error(string("Too many track candidates (") + mTracks.size() + ")");
+    throw length_error(string("Too many track candidates (") + mNTracks + ")");
+  }
+  auto iNewTrack = insertTrack(pos);
+  mTrackPool[iNewTrack] = mTrackPool[iTrack];
+  return iNewTrack;
+}
+
+//_________________________________________________________________________________________________
+int TrackFinder::insertTrack(int pos)
+{
+  /// Take a free slot in the pool, or a new one if none is left, and chain it before the position "pos"
+  /// (at the end of the list if pos = SNoTrack). Return its index
+  /// The content of the slot is left as it was, it must be overwritten by the caller
+  /// Any reference to a track of the pool is invalidated if a new slot is created
+
+  int iTrack(0);
+  if (mFreeTracks.empty()) {
+    iTrack = mTrackPool.size();
+    mTrackPool.emplace_back();
+    mTrackLinks.emplace_back();
+  } else {
+    iTrack = mFreeTracks.back();
+    mFreeTracks.pop_back();
+  }
+
+  auto iPrevious = previousTrack(pos);
+  mTrackLinks[iTrack] = {iPrevious, pos};
+  if (iPrevious == SNoTrack) {
+    mFirstTrack = iTrack;
+  } else {
+    mTrackLinks[iPrevious].next = iTrack;
   }
-  return mTracks.emplace(pos, track);
+  if (pos == SNoTrack) {
+    mLastTrack = iTrack;
+  } else {
+    mTrackLinks[pos].previous = iTrack;
+  }
+  ++mNTracks;
+
+  return iTrack;
+}
+
+//_________________________________________________________________________________________________
+int TrackFinder::eraseTrack(int iTrack)
+{
+  /// Unchain the track "iTrack" from the list of tracks and give its slot back to the pool
+  /// Return the index of the next track
+
+  const auto& links = mTrackLinks[iTrack];
+  if (links.previous == SNoTrack) {
+    mFirstTrack = links.next;
+  } else {
+    mTrackLinks[links.previous].next = links.next;
+  }
+  if (links.next == SNoTrack) {
+    mLastTrack = links.previous;
+  } else {
+    mTrackLinks[links.next].previous = links.previous;
+  }
+  mFreeTracks.push_back(iTrack);
+  --mNTracks;
+
+  return links.next;
+}
+
+//_________________________________________________________________________________________________
+void TrackFinder::clearTracks()
+{
+  /// Empty the list of tracks, keeping every slot of the pool for reuse
+  /// The slots are handed out again in increasing order of index
+  mFreeTracks.resize(mTrackPool.size());
+  std::iota(mFreeTracks.rbegin(), mFreeTracks.rend(), 0);
+  mFirstTrack = SNoTrack;
+  mLastTrack = SNoTrack;
+  mNTracks = 0;
 }
 
 //_________________________________________________________________________________________________
@@ -1439,32 +1620,32 @@ bool TrackFinder::isAcceptable(const TrackParam& param) const
 }
 
 //_________________________________________________________________________________________________
-void TrackFinder::prepareForwardTracking(std::list<Track>::iterator& itTrack, bool runSmoother)
+void TrackFinder::prepareForwardTracking(Track& track, bool runSmoother)
 {
   /// Prepare the current track parameters in view of continuing the tracking in the forward chambers
   /// Run the smoother to recompute the parameters at last cluster if requested
   /// Throw an exception in case of failure while running the smoother
 
   if (runSmoother) {
-    auto itStartingParam = std::prev(itTrack->rend());
-    mTrackFitter.fit(*itTrack, true, false, &itStartingParam, true);
+    auto itStartingParam = std::prev(track.rend());
+    mTrackFitter.fit(track, true, false, &itStartingParam, true);
   }
 
-  setCurrentParam(*itTrack, itTrack->last(), itTrack->last().getClusterPtr()->getChamberId(), runSmoother);
+  setCurrentParam(track, track.last(), track.last().getClusterPtr()->getChamberId(), runSmoother);
 }
 
 //_________________________________________________________________________________________________
-void TrackFinder::prepareBackwardTracking(std::list<Track>::iterator& itTrack, bool refit)
+void TrackFinder::prepareBackwardTracking(Track& track, bool refit)
 {
   /// Prepare the current track parameters in view of continuing the tracking in the backward chambers
   /// Refit the track to recompute the parameters at first cluster if requested
   /// Throw an exception in case of failure during the refit
 
   if (refit) {
-    mTrackFitter.fit(*itTrack, false);
+    mTrackFitter.fit(track, false);
   }
 
-  setCurrentParam(*itTrack, itTrack->first(), itTrack->first().getClusterPtr()->getChamberId());
+  setCurrentParam(track, track.first(), track.first().getClusterPtr()->getChamberId());
 }
 
 //_________________________________________________________________________________________________
@@ -1670,24 +1851,24 @@ uint8_t TrackFinder::requestedStationMask() const
 }
 
 //_________________________________________________________________________________________________
-int TrackFinder::getTrackIndex(const std::list<Track>::iterator& itCurrentTrack) const
+int TrackFinder::getTrackIndex(int iCurrentTrack) const
 {
-  /// return the index of the track pointed to by the given iterator in the list of tracks
-  /// return -1 if it points to mTracks.end()
-  /// return -2 if it points to nothing in the list
+  /// return the position of the given track in the list of tracks
+  /// return -1 if it is SNoTrack
+  /// return -2 if it is not in the list
   /// return -3 if the debug level is < 1 as this function is supposed to be used for debug only
 
   if (mDebugLevel < 1) {
     return -3;
   }
 
-  if (itCurrentTrack == mTracks.end()) {
+  if (iCurrentTrack == SNoTrack) {
     return -1;
   }
 
   int index(0);
-  for (auto itTrack = mTracks.begin(); itTrack != itCurrentTrack; ++itTrack) {
-    if (itTrack == mTracks.end()) {
+  for (auto iTrack = mFirstTrack; iTrack != iCurrentTrack; iTrack = nextTrack(iTrack)) {
+    if (iTrack == SNoTrack) {
       return -2;
     }
     ++index;
@@ -1701,8 +1882,8 @@ void TrackFinder::printTracks() const
 {
   /// print all the tracks currently in the list if the debug level is > 1
   if (mDebugLevel > 1) {
-    for (const auto& track : mTracks) {
-      track.print();
+    for (auto iTrack = mFirstTrack; iTrack != SNoTrack; iTrack = nextTrack(iTrack)) {
+      mTrackPool[iTrack].print();
     }
   }
 }
@@ -18,11 +18,11 @@
 
 #include <chrono>
 #include <filesystem>
-#include <list>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <gsl/span>
 
@@ -217,7 +217,7 @@ class TrackFinderTask
   }
 
   //_________________________________________________________________________________________________
-  void writeTracks(const std::list<Track>& tracks, const gsl::span<const Digit>& digitsIn,
+  void writeTracks(const std::vector<Track>& tracks, const gsl::span<const Digit>& digitsIn,
                    const ROFRecord& clusterROF, uint32_t firstTForbit,
                    std::vector<TrackMCH, o2::pmr::polymorphic_allocator<TrackMCH>>& mchTracks,
                    std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& usedClusters,
@@ -0,0 +1,267 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTrackFinder.cxx
+/// \brief check the tracks of the track finder against the generated ones, and that they do not depend on the number of threads
+
+#define BOOST_TEST_MODULE Test MCH TrackFinder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "CommonUtils/ConfigurableParam.h"
+#include "DataFormatsMCH/Cluster.h"
+#include "MCHTracking/TrackFinder.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace o2::mch;
+
+namespace
+{
+
+constexpr double SChamberZ[10] = {-526.16, -545.24, -676.4, -695.4, -967.5, -998.5, -1276.5, -1307.5, -1406.6, -1437.6};
+constexpr int SNDE[10] = {4, 4, 4, 4, 18, 18, 26, 26, 26, 26};
+
+/// return the DE of the chamber containing the point (x, y), following the numbering of the quadrants and slats
+int getDEId(int chamber, double x, double y)
+{
+  if (chamber < 4) {
+    int quadrant = (y > 0.) ? ((x > 0.) ? 0 : 1) : ((x > 0.) ? 3 : 2);
+    return 100 * (chamber + 1) + quadrant;
+  }
+  int nDE = SNDE[chamber];
+  int maxRow = nDE / 4;
+  int row = std::clamp(static_cast<int>(std::lround(y / 40.)), -maxRow, maxRow);
+  int index = (x > 0.) ? (row + nDE) % nDE : nDE / 2 - row;
+  return 100 * (chamber + 1) + index;
+}
+
+/// add a cluster at the given position of the chamber
+void addCluster(std::vector<Cluster>& clusters, std::array<int, 1100>& nClustersPerDE, int chamber, double x, double y, double z)
+{
+  int deId = getDEId(chamber, x, y);
+  Cluster cluster{};
+  cluster.x = x;
+  cluster.y = y;
+  cluster.z = z + ((deId % 2 == 0) ? -1. : 1.);
+  cluster.ex = 0.2;
+  cluster.ey = 0.2;
+  cluster.uid = Cluster::buildUniqueId(chamber, deId, nClustersPerDE[deId]++);
+  clusters.push_back(cluster);
+}
+
+/// generate the clusters of straight tracks coming from the vertex region, plus some noise, in one ROF
+std::vector<Cluster> generateClusters(int nTracks, int nNoiseClusters)
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> slope(-0.15, 0.15);
+  std::uniform_real_distribution<double> vertex(-1., 1.);
+  std::normal_distribution<double> smearing(0., 0.05);
+  std::uniform_real_distribution<double> position(-200., 200.);
+  std::uniform_int_distribution<int> chamber(0, 9);
+
+  std::vector<Cluster> clusters{};
+  std::array<int, 1100> nClustersPerDE{};
+  for (int iTrack = 0; iTrack < nTracks; ++iTrack) {
+    double x0 = vertex(gen), y0 = vertex(gen);
+    double slopeX = slope(gen), slopeY = slope(gen);
+    for (int iCh = 0; iCh < 10; ++iCh) {
+      double z = SChamberZ[iCh];
+      addCluster(clusters, nClustersPerDE, iCh, x0 + slopeX * z + smearing(gen), y0 + slopeY * z + smearing(gen), z);
+    }
+  }
+  for (int iCluster = 0; iCluster < nNoiseClusters; ++iCluster) {
+    int iCh = chamber(gen);
+    addCluster(clusters, nClustersPerDE, iCh, position(gen), position(gen), SChamberZ[iCh]);
+  }
+
+  return clusters;
+}
+
+/// straight track coming from the vertex region
+struct GeneratedTrack {
+  double x0, y0, slopeX, slopeY;
+};
+
+/// generate the clusters of well separated straight tracks, without noise, in one ROF
+std::vector<Cluster> generateCleanEvent(const std::vector<GeneratedTrack>& generatedTracks)
+{
+  std::mt19937 gen(5678);
+  std::normal_distribution<double> smearing(0., 0.05);
+  std::vector<Cluster> clusters{};
+  std::array<int, 1100> nClustersPerDE{};
+  for (const auto& track : generatedTracks) {
+    for (int iCh = 0; iCh < 10; ++iCh) {
+      double z = SChamberZ[iCh];
+      addCluster(clusters, nClustersPerDE, iCh, track.x0 + track.slopeX * z + smearing(gen), track.y0 + track.slopeY * z + smearing(gen), z);
+    }
+  }
+  return clusters;
+}
+
+/// check that the tracks of the clean event are exactly the generated ones: one track per generated track, made of
+/// its 10 clusters, with the parameters of a straight line (infinite momentum) at every cluster
+void checkGeneratedTracks(const std::vector<Track>& tracks, gsl::span<const Cluster> clusters, const std::vector<GeneratedTrack>& generatedTracks)
+{
+  constexpr double slopeTolerance = 2.e-3;
+  constexpr double coorTolerance = 0.3;         // cm
+  constexpr double invMomentumTolerance = 0.05; // 1/(GeV/c)
+  BOOST_REQUIRE_EQUAL(tracks.size(), generatedTracks.size());
+  std::set<size_t> foundTracks{};
+  for (const auto& track : tracks) {
+    BOOST_REQUIRE_EQUAL(track.getNClusters(), 10);
+    size_t iGenerated = (track.begin()->getClusterPtr() - clusters.data()) / 10;
+    BOOST_REQUIRE_LT(iGenerated, generatedTracks.size());
+    BOOST_CHECK(foundTracks.insert(iGenerated).second);
+    const auto& generated = generatedTracks[iGenerated];
+    int iCh = 0;
+    for (const auto& param : track) {
+      BOOST_CHECK_EQUAL(param.getClusterPtr() - clusters.data(), static_cast<std::ptrdiff_t>(10 * iGenerated + iCh++));
+      double z = SChamberZ[param.getClusterPtr()->getChamberId()];
+      BOOST_CHECK_SMALL(param.getNonBendingCoor() - (generated.x0 + generated.slopeX * z), coorTolerance);
+      BOOST_CHECK_SMALL(param.getBendingCoor() - (generated.y0 + generated.slopeY * z), coorTolerance);
+      BOOST_CHECK_SMALL(param.getNonBendingSlope() - generated.slopeX, slopeTolerance);
+      BOOST_CHECK_SMALL(param.getBendingSlope() - generated.slopeY, slopeTolerance);
+      BOOST_CHECK_SMALL(param.getInverseBendingMomentum(), invMomentumTolerance);
+    }
+  }
+}
+
+/// check that two lists of tracks are identical
+void checkSameTracks(const std::vector<Track>& tracks, const std::vector<Track>& expectedTracks)
+{
+  BOOST_REQUIRE_EQUAL(tracks.size(), expectedTracks.size());
+  auto itExpectedTrack = expectedTracks.begin();
+  for (const auto& track : tracks) {
+    BOOST_REQUIRE_EQUAL(track.getNClusters(), itExpectedTrack->getNClusters());
+    auto itExpectedParam = itExpectedTrack->begin();
+    for (const auto& param : track) {
+      BOOST_CHECK_EQUAL(param.getClusterPtr()->uid, itExpectedParam->getClusterPtr()->uid);
+      BOOST_CHECK_EQUAL(param.getZ(), itExpectedParam->getZ());
+      BOOST_CHECK_EQUAL(param.getNonBendingCoor(), itExpectedParam->getNonBendingCoor());
+      BOOST_CHECK_EQUAL(param.getNonBendingSlope(), itExpectedParam->getNonBendingSlope());
+      BOOST_CHECK_EQUAL(param.getBendingCoor(), itExpectedParam->getBendingCoor());
+      BOOST_CHECK_EQUAL(param.getBendingSlope(), itExpectedParam->getBendingSlope());
+      BOOST_CHECK_EQUAL(param.getInverseBendingMomentum(), itExpectedParam->getInverseBendingMomentum());
+      BOOST_CHECK_EQUAL(param.getTrackChi2(), itExpectedParam->getTrackChi2());
+      ++itExpectedParam;
+    }
+    ++itExpectedTrack;
+  }
+}
+
+/// check the properties any reconstructed track must have: clusters taken from the input, at most two
+/// per chamber, sorted in z, a finite chi2, a majority of clusters from the same generated track, no duplicate
+void checkTrackInvariants(const std::vector<Track>& tracks, gsl::span<const Cluster> clusters, int nGeneratedTracks)
+{
+  std::unordered_map<uint32_t, int> generatedTrackOfCluster{};
+  for (size_t iCluster = 0; iCluster < clusters.size(); ++iCluster) {
+    int iTrack = (iCluster < 10 * static_cast<size_t>(nGeneratedTracks)) ? static_cast<int>(iCluster / 10) : -1;
+    generatedTrackOfCluster.emplace(clusters[iCluster].uid, iTrack);
+  }
+
+  std::set<std::vector<uint32_t>> clusterLists{};
+  for (const auto& track : tracks) {
+    BOOST_CHECK_GT(track.getNClusters(), 0);
+    std::vector<uint32_t> uids{};
+    std::array<int, 10> nClustersPerChamber{};
+    std::map<int, int> nClustersPerGeneratedTrack{};
+    double previousZ = std::numeric_limits<double>::max();
+    for (const auto& param : track) {
+      const auto* cluster = param.getClusterPtr();
+      BOOST_REQUIRE(cluster >= clusters.data() && cluster < clusters.data() + clusters.size());
+      BOOST_CHECK_EQUAL(param.getZ(), cluster->getZ());
+      BOOST_CHECK_LE(param.getZ(), previousZ);
+      previousZ = param.getZ();
+      BOOST_CHECK(std::isfinite(param.getTrackChi2()) && param.getTrackChi2() >= 0.);
+      BOOST_CHECK_LE(++nClustersPerChamber[cluster->getChamberId()], 2);
+      ++nClustersPerGeneratedTrack[generatedTrackOfCluster.at(cluster->uid)];
+      uids.push_back(cluster->uid);
+    }
+    int nClustersFromBestTrack = 0;
+    for (const auto& [iTrack, n] : nClustersPerGeneratedTrack) {
+      if (iTrack >= 0) {
+        nClustersFromBestTrack = std::max(nClustersFromBestTrack, n);
+      }
+    }
+    BOOST_CHECK_GT(2 * nClustersFromBestTrack, track.getNClusters());
+    BOOST_CHECK(clusterLists.insert(uids).second);
+  }
+}
+
+/// run the track finder on the same clusters with one thread and with the given parameters, check
+/// that the tracks are valid and identical, also when the pool of candidates is recycled
+void checkTracks(const std::string& params)
+{
+  constexpr int nGeneratedTracks = 40;
+  auto clusters = generateClusters(nGeneratedTracks, 200);
+
+  o2::conf::ConfigurableParam::updateFromString(params);
+  o2::conf::ConfigurableParam::updateFromString("MCHTracking.nThreads=1");
+  TrackFinder sequentialFinder{};
+  sequentialFinder.init();
+  const auto& sequentialTracks = sequentialFinder.findTracks(clusters);
+  BOOST_REQUIRE_GT(sequentialTracks.size(), 0);
+  checkTrackInvariants(sequentialTracks, clusters, nGeneratedTracks);
+
+  o2::conf::ConfigurableParam::updateFromString(params);
+  TrackFinder finder{};
+  finder.init();
+  // run twice to also check the tracking with the recycled slots of the pool of candidates
+  checkSameTracks(finder.findTracks(clusters), sequentialTracks);
+  checkSameTracks(finder.findTracks(clusters), sequentialTracks);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TrackFinder_SequentialSeeding)
+{
+  checkTracks("MCHTracking.nThreads=1;MCHTracking.moreCandidates=false");
+}
+
+BOOST_AUTO_TEST_CASE(TrackFinder_ParallelSeeding)
+{
+  checkTracks("MCHTracking.nThreads=4;MCHTracking.moreCandidates=false");
+}
+
+BOOST_AUTO_TEST_CASE(TrackFinder_ParallelSeedingMoreCandidates)
+{
+  checkTracks("MCHTracking.nThreads=4;MCHTracking.moreCandidates=true");
+}
+
+BOOST_AUTO_TEST_CASE(TrackFinder_GeneratedTracks)
+{
+  // slopes on a grid, such that the tracks are several tens of cm apart in every chamber
+  std::vector<GeneratedTrack> generatedTracks{};
+  for (double slopeX : {-0.12, -0.04, 0.04, 0.12}) {
+    for (double slopeY : {-0.1, 0.1}) {
+      generatedTracks.push_back({0.3 * slopeX, -0.2 * slopeY, slopeX, slopeY});
+    }
+  }
+  auto clusters = generateCleanEvent(generatedTracks);
+  for (const auto* params : {"MCHTracking.nThreads=1;MCHTracking.moreCandidates=false",
+                             "MCHTracking.nThreads=4;MCHTracking.moreCandidates=false",
+                             "MCHTracking.nThreads=4;MCHTracking.moreCandidates=true"}) {
+    o2::conf::ConfigurableParam::updateFromString(params);
+    TrackFinder finder{};
+    finder.init();
+    checkGeneratedTracks(finder.findTracks(clusters), clusters, generatedTracks);
+  }
+}
@@ -153,6 +153,14 @@ class ClusterFinderGEMTask
       mClusterFinderOriginal.init(run2Config);
     } else if (isActive(DoGEM)) {
       mClusterFinderGEM.init(mode, run2Config);
+      // the preclusters are processed in parallel only without dumps and timing statistics per precluster
+      auto nThreads = ic.options().get<int>("nthreads");
+      if (!isActive(DumpOriginal | DumpGEM | TimingStats)) {
+        mClusterFinderGEM.setNThreads(nThreads);
+      } else if (nThreads > 1) {
+        LOG(warning) << "  GEM preclusters processed sequentially, " << nThreads << " threads requested but dumps or timing statistics are active";
+      }
+      LOG(info) << "  GEM threads: " << mClusterFinderGEM.getNThreads();
     }
     // Inv ??? LOG(info) << "GG = lowestPadCharge = " << ClusterizerParam::Instance().lowestPadCharge;
 
@@ -228,53 +236,59 @@ class ClusterFinderGEMTask
       size_t startOriginalIdx = mClusterFinderOriginal.getClusters().size();
       uint16_t nbrClusters(0);
       // std::cout << "Start index GEM=" <<  startGEMIdx << ", Original=" << startOriginalIdx << std::endl;
-      for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
-        auto tPreClusterStart = std::chrono::high_resolution_clock::now();
-        // Inv ??? for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), 1102)) {
-        startGEMIdx = mClusterFinderGEM.getClusters().size();
-        startOriginalIdx = mClusterFinderOriginal.getClusters().size();
-        // Dump preclusters
-        // std::cout << "bCrossing=" << bCrossing << ", orbit=" << orbit << ", iPrecluster" << iPreCluster
-        //        << ", PreCluster: digit start=" << preCluster.firstDigit <<" , digit size=" << preCluster.nDigits << std::endl;
-        if (isActive(DumpOriginal)) {
-          mClusterFinderGEM.dumpPreCluster(mOriginalDump, digits.subspan(preCluster.firstDigit, preCluster.nDigits), bCrossing, orbit, iPreCluster);
-        }
-        if (isActive(DumpGEM)) {
-          mClusterFinderGEM.dumpPreCluster(mGEMDump, digits.subspan(preCluster.firstDigit, preCluster.nDigits), bCrossing, orbit, iPreCluster);
-        }
-        // Clusterize
-        if (isActive(DoOriginal)) {
-          mClusterFinderOriginal.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
-          nbrClusters = mClusterFinderOriginal.getClusters().size() - startOriginalIdx;
-        }
-        if (isActive(DoGEM)) {
-          mClusterFinderGEM.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits), bCrossing, orbit, iPreCluster);
-          nbrClusters = mClusterFinderGEM.getClusters().size() - startGEMIdx;
-        }
-        // Dump clusters (results)
-        // std::cout << "[Original] total clusters.size=" << mClusterFinderOriginal.getClusters().size() << std::endl;
-        // std::cout << "[GEM     ] total clusters.size=" << mClusterFinderGEM.getClusters().size() << std::endl;
-        if (isActive(DumpOriginal)) {
-          mClusterFinderGEM.dumpClusterResults(mOriginalDump, mClusterFinderOriginal.getClusters(), startOriginalIdx, bCrossing, orbit, iPreCluster);
-        }
-        if (isActive(DumpGEM)) {
-          mClusterFinderGEM.dumpClusterResults(mGEMDump, mClusterFinderGEM.getClusters(), startGEMIdx, bCrossing, orbit, iPreCluster);
-        }
-        // Timing Statistics
-        if (isActive(TimingStats)) {
-          auto tPreClusterEnd = std::chrono::high_resolution_clock::now();
-          preClusterDuration = tPreClusterEnd - tPreClusterStart;
-          int16_t nPads = preCluster.nDigits;
-          int16_t DEId = digits[preCluster.firstDigit].getDetID();
-          // double dt = duration_cast<duration<double>>(tPreClusterEnd - tPreClusterStart).count;
-          // std::chrono::duration<double> time_span = std::chrono::duration_cast<duration<double>>(tPreClusterEnd - tPreClusterStart);
-          preClusterDuration = tPreClusterEnd - tPreClusterStart;
-          double dt = preClusterDuration.count();
-          // In second
-          dt = (dt < 1.0e-06) ? 0.0 : dt * 1000;
-          saveStatistics(orbit, bCrossing, iPreCluster, nPads, nbrClusters, DEId, dt);
+      if (isActive(DoGEM) && !isActive(DoOriginal) && mClusterFinderGEM.getNThreads() > 1) {
+        auto rofPreClusters = preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries());
+        mClusterFinderGEM.findClusters(rofPreClusters, digits, bCrossing, orbit, iPreCluster);
+        iPreCluster += rofPreClusters.size();
+      } else {
+        for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
+          auto tPreClusterStart = std::chrono::high_resolution_clock::now();
+          // Inv ??? for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), 1102)) {
+          startGEMIdx = mClusterFinderGEM.getClusters().size();
+          startOriginalIdx = mClusterFinderOriginal.getClusters().size();
+          // Dump preclusters
+          // std::cout << "bCrossing=" << bCrossing << ", orbit=" << orbit << ", iPrecluster" << iPreCluster
+          //        << ", PreCluster: digit start=" << preCluster.firstDigit <<" , digit size=" << preCluster.nDigits << std::endl;
+          if (isActive(DumpOriginal)) {
+            mClusterFinderGEM.dumpPreCluster(mOriginalDump, digits.subspan(preCluster.firstDigit, preCluster.nDigits), bCrossing, orbit, iPreCluster);
+          }
+          if (isActive(DumpGEM)) {
+            mClusterFinderGEM.dumpPreCluster(mGEMDump, digits.subspan(preCluster.firstDigit, preCluster.nDigits), bCrossing, orbit, iPreCluster);
+          }
+          // Clusterize
+          if (isActive(DoOriginal)) {
+            mClusterFinderOriginal.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+            nbrClusters = mClusterFinderOriginal.getClusters().size() - startOriginalIdx;
+          }
+          if (isActive(DoGEM)) {
+            mClusterFinderGEM.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits), bCrossing, orbit, iPreCluster);
+            nbrClusters = mClusterFinderGEM.getClusters().size() - startGEMIdx;
+          }
+          // Dump clusters (results)
+          // std::cout << "[Original] total clusters.size=" << mClusterFinderOriginal.getClusters().size() << std::endl;
+          // std::cout << "[GEM     ] total clusters.size=" << mClusterFinderGEM.getClusters().size() << std::endl;
+          if (isActive(DumpOriginal)) {
+            mClusterFinderGEM.dumpClusterResults(mOriginalDump, mClusterFinderOriginal.getClusters(), startOriginalIdx, bCrossing, orbit, iPreCluster);
+          }
+          if (isActive(DumpGEM)) {
+            mClusterFinderGEM.dumpClusterResults(mGEMDump, mClusterFinderGEM.getClusters(), startGEMIdx, bCrossing, orbit, iPreCluster);
+          }
+          // Timing Statistics
+          if (isActive(TimingStats)) {
+            auto tPreClusterEnd = std::chrono::high_resolution_clock::now();
+            preClusterDuration = tPreClusterEnd - tPreClusterStart;
+            int16_t nPads = preCluster.nDigits;
+            int16_t DEId = digits[preCluster.firstDigit].getDetID();
+            // double dt = duration_cast<duration<double>>(tPreClusterEnd - tPreClusterStart).count;
+            // std::chrono::duration<double> time_span = std::chrono::duration_cast<duration<double>>(tPreClusterEnd - tPreClusterStart);
+            preClusterDuration = tPreClusterEnd - tPreClusterStart;
+            double dt = preClusterDuration.count();
+            // In second
+            dt = (dt < 1.0e-06) ? 0.0 : dt * 1000;
+            saveStatistics(orbit, bCrossing, iPreCluster, nPads, nbrClusters, DEId, dt);
+          }
+          iPreCluster++;
         }
-        iPreCluster++;
       }
       // } // Inv ??? if ( orbit==22 ) {
       auto tEnd = std::chrono::high_resolution_clock::now();
@@ -352,6 +366,7 @@ o2::framework::DataProcessorSpec getClusterFinderGEMSpec(const char* specName)
       {"mch-config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
       {"run2-config", VariantType::Bool, false, {"Setup for run2 data"}},
       {"mode", VariantType::Int, ClusterFinderGEMTask::DoGEM | ClusterFinderGEMTask::GEMOutputStream, {"Running mode"}},
+      {"nthreads", VariantType::Int, 1, {"Number of threads processing the preclusters of an interaction in parallel (GEM mode)"}},
       // {"mode", VariantType::Int, ClusterFinderGEMTask::DoOriginal, {"Running mode"}},
       // {"mode", VariantType::Int, ClusterFinderGEMTask::DoGEM | ClusterFinderGEMTask::GEMOutputStream, {"Running mode"}},
       // {"mode", VariantType::Int, ClusterFinderGEMTask::DoGEM | ClusterFinderGEMTask::DumpGEM | ClusterFinderGEMTask::GEMOutputStream, {"Running mode"}},
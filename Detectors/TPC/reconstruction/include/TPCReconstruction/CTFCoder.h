@@ -229,9 +229,9 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   assignDictVersion(static_cast<o2::ctf::CTFDictHeader&>(ec->getHeader()));
   ec->setANSHeader(mANSVersion);
 
-  o2::ctf::CTFIOSize iosize;
-  auto encodeTPC = [&buff, &optField, &coders = mCoders, mfc = this->getMemMarginFactor(), &iosize](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
-    // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
+  // at every encoding the buffer might be autoexpanded, so the block encoder does not work with fixed pointer ec
+  auto blockEncoder = makeBlockEncoder<CTF>(buff);
+  auto encodeTPC = [&blockEncoder, &optField](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
     const auto slotVal = static_cast<int>(slot);
     if (reject && begin != end) {
       std::vector<std::decay_t<decltype(*begin)>> tmp;
@@ -241,9 +241,9 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
           tmp.emplace_back(*i);
         }
       }
-      iosize += CTF::get(buff.data())->encode(tmp.begin(), tmp.end(), slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+      blockEncoder.add(std::move(tmp), slotVal, probabilityBits, optField[slotVal]);
     } else {
-      iosize += CTF::get(buff.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+      blockEncoder.add(begin, end, slotVal, probabilityBits, optField[slotVal]);
     }
   };
 
@@ -313,6 +313,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   encodeTPC(trigComp.deltaOrbit.begin(), trigComp.deltaOrbit.end(), CTF::BLCTrigOrbitInc, 0);
   encodeTPC(trigComp.deltaBC.begin(), trigComp.deltaBC.end(), CTF::BLCTrigBCInc, 0);
   encodeTPC(trigComp.triggerType.begin(), trigComp.triggerType.end(), CTF::BLCTrigType, 0);
+  o2::ctf::CTFIOSize iosize = blockEncoder.run();
 
   CTF::get(buff.data())->print(getPrefix(), mVerbosity);
   finaliseCTFOutput<CTF>(buff);
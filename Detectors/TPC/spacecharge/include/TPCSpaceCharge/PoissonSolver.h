@@ -100,7 +100,7 @@ class PoissonSolver
   const ParamSpaceCharge mParamGrid{mGrid3D.getParamSC()};           ///< parameters of the grid on which the calculations are performed
   inline static DataT sConvergenceError{1e-6};                       ///< Error tolerated
   static constexpr DataT INVTWOPI = 1. / o2::constants::math::TwoPI; ///< inverse of 2*pi
-  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (increasing this number has no big impact)
+  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (relaxation, residue, restriction and interpolation)
 
   /// \returns inverse grid size in phi (either 1/2Pi or NSECTORSPERSIDE/2Pi)
   static DataT getGridSizePhiInv();
@@ -222,6 +222,7 @@ class PoissonSolver
 
   /// Relaxation operation for multiGrid
   ///   relaxation used 7 stencil in cylindrical coordinate
+  ///   the red-black Gauss-Seidel relaxation is done in parallel over the phi slices
   ///
   /// Using the following equations
   /// \f$ U_{i,j,k} = (1 + \frac{1}{r_{i}h_{r}}) U_{i+1,j,k}  + (1 - \frac{1}{r_{i}h_{r}}) U_{i+1,j,k}  \f$
@@ -383,6 +384,31 @@ class PoissonSolver
                 std::vector<Vector>& tvResidue, std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2, std::vector<DataT>& coefficient3,
                 std::vector<DataT>& coefficient4, std::vector<DataT>& inverseCoefficient4) const;
 
+  /// W-Cycle 3D, recursive multiGrid cycle visiting every coarser grid twice per visit of the finer one
+  /// fine-->coarsest-->fine, propagating the residue to correct initial guess of V
+  /// It is more robust than the V cycle for the anisotropic grids, at about twice the cost per cycle
+  ///
+  ///    NOTE: In order for this algorithm to work, the number of nRRow and nZColumn must be a power of 2 plus one.
+  ///
+  /// \param symmetry symmetry or not
+  /// \param gridFrom finest level of grid
+  /// \param gridTo coarsest level of grid
+  /// \param gamma number of cycles on each coarser grid: 1 for a V cycle, 2 for a W cycle
+  /// \param nPre number of smoothing before coarsening
+  /// \param nPost number of smoothing after coarsening
+  /// \param ratioZ ratio between square of grid r and grid z (OPTION,  recalculate)
+  /// \param tvArrayV vector of V potential in different grids
+  /// \param tvCharge vector of charge distribution in different grids
+  /// \param tvResidue vector of residue calculation in different grids
+  /// \param coefficient1 coefficient for relaxation (r direction)
+  /// \param coefficient2 coefficient for relaxation (r direction)
+  /// \param coefficient3 coefficient for relaxation (ratio r/z)
+  /// \param coefficient4 coefficient for relaxation (ratio for grid_r)
+  /// \param inverseCoefficient4 coefficient for relaxation (inverse coefficient4)
+  void wCycle3D(const int symmetry, const int gridFrom, const int gridTo, const int gamma, const int nPre, const int nPost, const DataT ratioZ, std::vector<Vector>& tvArrayV, std::vector<Vector>& tvCharge,
+                std::vector<Vector>& tvResidue, std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2, std::vector<DataT>& coefficient3,
+                std::vector<DataT>& coefficient4, std::vector<DataT>& inverseCoefficient4) const;
+
   /// V-Cycle 2D
   ///
   /// Implementation non-recursive V-cycle for 2D
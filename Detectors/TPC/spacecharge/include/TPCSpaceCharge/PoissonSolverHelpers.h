@@ -28,7 +28,7 @@ namespace tpc
 ///< Enumeration of Cycles Type
 enum class CycleType {
   VCycle = 0, ///< V Cycle
-  WCycle = 1, ///< W Cycle (TODO)
+  WCycle = 1, ///< W Cycle (full 3D and 2D solvers, the 3D2D solver only supports the Full Cycle)
   FCycle = 2  ///< Full Cycle
 };
 
@@ -42,7 +42,7 @@ enum class GridTransferType {
 enum class RelaxType {
   Jacobi = 0,         ///< Jacobi (5 Stencil 2D, 7 Stencil 3D_
   WeightedJacobi = 1, ///< (TODO)
-  GaussSeidel = 2     ///< Gauss Seidel 2D (2 Color, 5 Stencil), 3D (7 Stencil)
+  GaussSeidel = 2     ///< Gauss Seidel 2D (2 Color, 5 Stencil), 3D (2 Color, 7 Stencil, parallel over the phi slices)
 };
 
 struct MGParameters {                                             ///< Parameters choice for MultiGrid algorithm
@@ -54,7 +54,7 @@ struct MGParameters {                                             ///< Parameter
   inline static int nPost = 2;                                    ///< number of iteration for post smoothing
   inline static int nMGCycle = 200;                               ///< number of multi grid cycle (V type)
   inline static int maxLoop = 7;                                  ///< the number of tree-deep of multi grid
-  inline static int gamma = 1;                                    ///< number of iteration at coarsest level !TODO SET TO REASONABLE VALUE!
+  inline static int gamma = 1;                                    ///< number of cycles on the coarser grids in the W cycle (2 for a W cycle, 1 for a V cycle)
   inline static bool normalizeGridToOneSector = false;            ///< the grid in phi direction is squashed from 2 Pi to (2 Pi / SECTORSPERSIDE). This can used to get the potential for phi symmetric sc density or boundary potentials
 };
 
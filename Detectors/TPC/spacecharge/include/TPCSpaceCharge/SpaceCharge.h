@@ -1335,6 +1335,10 @@ class SpaceCharge
   template <typename Fields = AnalyticalFields<DataT>>
   void integrateEFieldsSimpsonIterative(const DataT p1r, const DataT p2r, const DataT p1phi, const DataT p2phi, const DataT p1z, const DataT p2z, DataT& localIntErOverEz, DataT& localIntEPhiOverEz, DataT& localIntDeltaEz, const Fields& formulaStruct, const DataT ezField, const Side side) const;
 
+  /// evaluate the three components of the field for several coordinates, using the batched evaluation of the fields if they provide one
+  template <typename Fields>
+  static void evalFields(const Fields& formulaStruct, const DataT* z, const DataT* r, const DataT* phi, const unsigned int nPoints, DataT* fieldR, DataT* fieldZ, DataT* fieldPhi);
+
   /// calculate distortions/corrections using analytical electric fields
   void processGlobalDistCorr(const DataT radius, const DataT phi, const DataT z0Tmp, const DataT z1Tmp, DataT& ddR, DataT& ddPhi, DataT& ddZ, const AnalyticalFields<DataT>& formulaStruct) const { calcDistCorr(radius, phi, z0Tmp, z1Tmp, ddR, ddPhi, ddZ, formulaStruct, false, formulaStruct.getSide()); }
 
@@ -1344,9 +1348,8 @@ class SpaceCharge
   /// calculate distortions/corrections by interpolation of local distortions/corrections
   void processGlobalDistCorr(const DataT radius, const DataT phi, const DataT z0Tmp, [[maybe_unused]] const DataT z1Tmp, DataT& ddR, DataT& ddPhi, DataT& ddZ, const DistCorrInterpolator<DataT>& localDistCorr) const
   {
-    ddR = localDistCorr.evaldR(z0Tmp, radius, phi);
-    ddZ = localDistCorr.evaldZ(z0Tmp, radius, phi);
-    ddPhi = localDistCorr.evaldRPhi(z0Tmp, radius, phi) / radius;
+    localDistCorr.evalDistCorr(z0Tmp, radius, phi, ddR, ddZ, ddPhi);
+    ddPhi /= radius;
   }
 
   /// dump the created electron tracks with calculateElectronDriftPath function to a tree
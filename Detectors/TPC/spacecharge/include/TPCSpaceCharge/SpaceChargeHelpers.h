@@ -274,6 +274,19 @@ class NumericalFields
   /// \return returns the function value for electric field Ephi for given coordinate
   DataT evalFieldPhi(DataT z, DataT r, DataT phi) const { return mInterpolatorEphi(z, r, phi); }
 
+  /// evaluate all components of the electric field for several coordinates. The interpolation weights are shared by the three components.
+  /// \param z z coordinates
+  /// \param r r coordinates
+  /// \param phi phi coordinates
+  /// \param nPoints number of coordinates
+  /// \param fieldR output: electric field Er for each coordinate
+  /// \param fieldZ output: electric field Ez for each coordinate
+  /// \param fieldPhi output: electric field Ephi for each coordinate
+  void evalFields(const DataT* z, const DataT* r, const DataT* phi, const unsigned int nPoints, DataT* fieldR, DataT* fieldZ, DataT* fieldPhi) const
+  {
+    mInterpolatorEr.template interpolate<3>({&mInterpolatorEr.getGridData(), &mInterpolatorEz.getGridData(), &mInterpolatorEphi.getGridData()}, z, r, phi, nPoints, {fieldR, fieldZ, fieldPhi});
+  }
+
   o2::tpc::Side getSide() const { return mSide; }
 
   static constexpr unsigned int getID() { return ID; }
@@ -408,6 +421,18 @@ class DistCorrInterpolator
   /// \return returns the function value for the local distortion or correction dRPhi for given coordinate
   DataT evaldRPhi(const DataT z, const DataT r, const DataT phi) const { return interpolatorDistCorrdRPhi(z, r, phi); }
 
+  /// evaluate the local distortions or corrections dR, dZ and dRPhi for given coordinate. The interpolation weights are shared by the three components.
+  /// \param z z coordinate
+  /// \param r r coordinate
+  /// \param phi phi coordinate
+  /// \param dR output: local distortion or correction dR
+  /// \param dZ output: local distortion or correction dZ
+  /// \param dRPhi output: local distortion or correction dRPhi
+  void evalDistCorr(const DataT z, const DataT r, const DataT phi, DataT& dR, DataT& dZ, DataT& dRPhi) const
+  {
+    interpolatorDistCorrdR.template interpolate<3>({&interpolatorDistCorrdR.getGridData(), &interpolatorDistCorrdZ.getGridData(), &interpolatorDistCorrdRPhi.getGridData()}, &z, &r, &phi, 1, {&dR, &dZ, &dRPhi});
+  }
+
   o2::tpc::Side getSide() const { return mSide; }
 
   static constexpr unsigned int getID() { return ID; }
@@ -18,6 +18,7 @@
 #define ALICEO2_TPC_TRICUBIC_H_
 
 #include "TPCSpaceCharge/RegularGrid3D.h"
+#include <array>
 
 // forward declare VC Memory
 template <typename DataT, size_t, size_t, bool>
@@ -78,6 +79,21 @@ class TriCubicInterpolator
   /// \return returns the interpolated value at given coordinate
   DataT operator()(const DataT z, const DataT r, const DataT phi) const { return interpolateSparse(z, r, phi); }
 
+  /// interpolate the values of several data containers, which are defined on the grid of this interpolator, at several coordinates.
+  /// The position in the grid and the interpolation weights of each point are calculated once for all containers and the values
+  /// around a grid cell are gathered only once for consecutive points lying in the same cell.
+  /// \param data data containers which will be interpolated
+  /// \param z z coordinates
+  /// \param r r coordinates
+  /// \param phi phi coordinates
+  /// \param nPoints number of points
+  /// \param values output: interpolated values values[iData][iPoint]
+  template <size_t NData>
+  void interpolate(const std::array<const DataContainer*, NData>& data, const DataT* z, const DataT* r, const DataT* phi, const unsigned int nPoints, const std::array<DataT*, NData>& values) const;
+
+  /// \return returns the data container of the grid
+  const DataContainer& getGridData() const { return *mGridData; }
+
   /// set which type of extrapolation is used at the grid boundaries (linear or parabol can be used with periodic phi axis and non periodic z and r axis).
   /// \param extrapolationType sets type of extrapolation. See enum ExtrapolationType for different types
   void setExtrapolationType(const ExtrapolationType extrapolationType) { mExtrapolationType = extrapolationType; }
@@ -96,6 +112,7 @@ class TriCubicInterpolator
   static constexpr unsigned int FZ = Grid3D::getFZ();                 ///< index for z coordinate
   static constexpr unsigned int FR = Grid3D::getFR();                 ///< index for r coordinate
   static constexpr unsigned int FPHI = Grid3D::getFPhi();             ///< index for phi coordinate
+  static constexpr int NVals = 4;                                     ///< number of vertices per dimension used for the interpolation
   const DataContainer* mGridData{};                                   ///< adress to the data container of the grid
   const Grid3D* mGridProperties{};                                    ///< adress to the properties of the grid
   ExtrapolationType mExtrapolationType = ExtrapolationType::Parabola; ///< sets which type of extrapolation for missing points at boundary is used
@@ -153,7 +170,13 @@ class TriCubicInterpolator
     SideZLeft = 25
   };
 
-  void setValues(const int iz, const int ir, const int iphi, std::array<Vector<DataT, 4>, 16>& cVals) const;
+  void setValues(const DataContainer& data, const int iz, const int ir, const int iphi, std::array<Vector<DataT, 4>, 16>& cVals) const;
+
+  /// calculate the index of the grid cell and the interpolation weights in each dimension for given coordinate
+  void setWeights(const DataT z, const DataT r, const DataT phi, int index[FDim], Vector<DataT, NVals>* weights) const;
+
+  /// \return returns the interpolated value from the values around the grid cell and the interpolation weights
+  DataT interpolateValues(const std::array<Vector<DataT, NVals>, 16>& cVals, const Vector<DataT, NVals>* weights) const;
 
   // interpolate value at given coordinate - this method doesnt compute and stores the coefficients and is faster when quering only a few values per cube
   /// \param z z coordinate
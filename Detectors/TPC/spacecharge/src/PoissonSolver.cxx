@@ -180,7 +180,6 @@ void PoissonSolver<DataT>::poissonMultiGrid2D(DataContainer& matricesV, const Da
       vCycle2D(gridFrom, gridTo, MGParameters::nPre, MGParameters::nPost, gridSpacingR, ratioZ, tvArrayV, tvCharge, tvResidue);
     }
   } else if (MGParameters::cycleType == CycleType::WCycle) {
-    // 3. W Cycle (TODO:)
     int gridFrom = 1;
     int gridTo = nLoop;
     // Do MGCycle
@@ -553,8 +552,8 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
       // keep old slice information
       otPhiSlice = tPhiSlice;
     }
-  } else if (MGParameters::cycleType == CycleType::VCycle) {
-    // V-cycle
+  } else if (MGParameters::cycleType == CycleType::VCycle || MGParameters::cycleType == CycleType::WCycle) {
+    // V-cycle or W-cycle
     int gridFrom = 1;
     int gridTo = nLoop;
 
@@ -562,8 +561,12 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
       // copy to store previous potential
       tvPrevArrayV[0] = tvArrayV[0];
 
-      // Do V Cycle from the coarsest to finest grid
-      vCycle3D(symmetry, gridFrom, gridTo, MGParameters::nPre, MGParameters::nPost, ratioZ, tvArrayV, tvCharge, tvResidue, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+      // Do V or W Cycle from the coarsest to finest grid
+      if (MGParameters::cycleType == CycleType::VCycle) {
+        vCycle3D(symmetry, gridFrom, gridTo, MGParameters::nPre, MGParameters::nPost, ratioZ, tvArrayV, tvCharge, tvResidue, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+      } else {
+        wCycle3D(symmetry, gridFrom, gridTo, MGParameters::gamma, MGParameters::nPre, MGParameters::nPost, ratioZ, tvArrayV, tvCharge, tvResidue, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+      }
 
       // convergence error
       const DataT convergenceError = getConvergenceError(tvArrayV[0], tvPrevArrayV[0]);
@@ -930,6 +933,77 @@ void PoissonSolver<DataT>::vCycle3D(const int symmetry, const int gridFrom, cons
   }
 }
 
+template <typename DataT>
+void PoissonSolver<DataT>::wCycle3D(const int symmetry, const int gridFrom, const int gridTo, const int gamma, const int nPre, const int nPost, const DataT ratioZ, std::vector<Vector>& tvArrayV,
+                                    std::vector<Vector>& tvCharge, std::vector<Vector>& tvResidue, std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2, std::vector<DataT>& coefficient3,
+                                    std::vector<DataT>& coefficient4, std::vector<DataT>& inverseCoefficient4) const
+{
+  const DataT gridSpacingR = getSpacingR();
+
+  int nnPhi = mParamGrid.NPhiVertices;
+  while (nnPhi % 2 == 0) {
+    nnPhi /= 2;
+  }
+
+  // grid of the current level, the coarsening is the same in all directions
+  const int index = gridFrom - 1;
+  const unsigned int iOne = 1 << index;
+  const int tnRRow = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
+  const int tnZColumn = iOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / iOne + 1;
+  const int tPhiSlice = std::max(static_cast<int>(mParamGrid.NPhiVertices / iOne), nnPhi);
+
+  const DataT h = gridSpacingR * iOne;
+  const DataT h2 = h * h;
+  const DataT ih2 = 1 / h2;
+  const DataT tempGridSizePhiInv = tPhiSlice * getGridSizePhiInv();
+  const DataT tempRatioPhi = h2 * tempGridSizePhiInv * tempGridSizePhiInv; // ratio_{phi} = gridSize_{r} / gridSize_{phi}
+  const DataT tempRatioZ = ratioZ;                                         // same coarsening in r and z
+
+  calcCoefficients(1, tnRRow - 1, h, tempRatioZ, tempRatioPhi, coefficient1, coefficient2, coefficient3, coefficient4);
+
+  // relax on the coarsest grid
+  if (gridFrom == gridTo) {
+    relax3D(tvArrayV[index], tvCharge[index], tnRRow, tnZColumn, tPhiSlice, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+    return;
+  }
+
+  for (int i = 1; i < tnRRow - 1; ++i) {
+    inverseCoefficient4[i] = 1 / coefficient4[i];
+  }
+
+  // 1) Pre-Smoothing: Gauss-Seidel Relaxation or Jacobi
+  for (int jPre = 1; jPre <= nPre; ++jPre) {
+    relax3D(tvArrayV[index], tvCharge[index], tnRRow, tnZColumn, tPhiSlice, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+  }
+
+  // 2) Residue calculation
+  residue3D(tvResidue[index], tvArrayV[index], tvCharge[index], tnRRow, tnZColumn, tPhiSlice, symmetry, ih2, tempRatioZ, coefficient1, coefficient2, coefficient3, inverseCoefficient4);
+
+  // 3) Restriction to the coarser grid
+  const unsigned int iOneCoarse = 2 * iOne;
+  const int tnRRowCoarse = mParamGrid.NRVertices / iOneCoarse + 1;
+  const int tnZColumnCoarse = mParamGrid.NZVertices / iOneCoarse + 1;
+  const int tPhiSliceCoarse = std::max(static_cast<int>(mParamGrid.NPhiVertices / iOneCoarse), nnPhi);
+  restrict3D(tvCharge[gridFrom], tvResidue[index], tnRRowCoarse, tnZColumnCoarse, tPhiSliceCoarse, tPhiSlice);
+
+  // 4) Zeroing coarser V and solving for the correction with gamma cycles on the coarser grids
+  std::fill(tvArrayV[gridFrom].begin(), tvArrayV[gridFrom].end(), 0);
+  for (int iGamma = 0; iGamma < gamma; ++iGamma) {
+    wCycle3D(symmetry, gridFrom + 1, gridTo, gamma, nPre, nPost, ratioZ, tvArrayV, tvCharge, tvResidue, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+  }
+
+  // 5) Interpolation/Prolongation
+  addInterp3D(tvArrayV[index], tvArrayV[gridFrom], tnRRow, tnZColumn, tPhiSlice, tPhiSliceCoarse);
+
+  // the coefficients were overwritten on the coarser grids
+  calcCoefficients(1, tnRRow - 1, h, tempRatioZ, tempRatioPhi, coefficient1, coefficient2, coefficient3, coefficient4);
+
+  // 6) Post-Smoothing: Gauss-Seidel Relaxation
+  for (int jPost = 1; jPost <= nPost; ++jPost) {
+    relax3D(tvArrayV[index], tvCharge[index], tnRRow, tnZColumn, tPhiSlice, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+  }
+}
+
 template <typename DataT>
 void PoissonSolver<DataT>::residue2D(Vector& residue, const Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const DataT ih2, const DataT inverseTempFourth,
                                      const DataT tempRatio, std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2)
@@ -1220,52 +1294,64 @@ template <typename DataT>
 void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int symmetry, const DataT h2,
                                    const DataT tempRatioZ, const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& coefficient4) const
 {
-  // Gauss-Seidel (Read Black}
+  // Gauss-Seidel (Red Black)
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
-    // for each slice
-    for (int iPass = 1; iPass <= 2; ++iPass) {
-      const int msw = (iPass % 2) ? 1 : 2;
-      for (int m = 0; m < iPhi; ++m) {
-        const int jsw = ((msw + m) % 2) ? 1 : 2;
-        int mp1 = m + 1;
-        int signPlus = 1;
-        int mm1 = m - 1;
-        int signMinus = 1;
-        // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
-        if (symmetry == 1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-          }
+    // relax the vertices of one colour of the slice m
+    const auto relaxSlice = [&](const int m, const int msw) {
+      const int jsw = ((msw + m) % 2) ? 1 : 2;
+      int mp1 = m + 1;
+      int signPlus = 1;
+      int mm1 = m - 1;
+      int signMinus = 1;
+      // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
+      if (symmetry == 1) {
+        if (mp1 > iPhi - 1) {
+          mp1 = iPhi - 2;
         }
-        // Anti-symmetry in phi
-        else if (symmetry == -1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-            signPlus = -1;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-            signMinus = -1;
-          }
-        } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
-          if (mp1 > iPhi - 1) {
-            mp1 = m + 1 - iPhi;
-          }
-          if (mm1 < 0) {
-            mm1 = m - 1 + iPhi;
-          }
+        if (mm1 < 0) {
+          mm1 = 1;
+        }
+      }
+      // Anti-symmetry in phi
+      else if (symmetry == -1) {
+        if (mp1 > iPhi - 1) {
+          mp1 = iPhi - 2;
+          signPlus = -1;
+        }
+        if (mm1 < 0) {
+          mm1 = 1;
+          signMinus = -1;
+        }
+      } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
+        if (mp1 > iPhi - 1) {
+          mp1 = m + 1 - iPhi;
+        }
+        if (mm1 < 0) {
+          mm1 = m - 1 + iPhi;
         }
-        int isw = jsw;
-        for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
-          for (int i = isw; i < tnRRow - 1; i += 2) {
-            (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
-          } // end cols
-        }   // end mParamGrid.NRVertices
-      }     // end phi
-    }       // end sweep
+      }
+      int isw = jsw;
+      for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
+        for (int i = isw; i < tnRRow - 1; i += 2) {
+          (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
+        } // end cols
+      }   // end mParamGrid.NRVertices
+    };
+
+    // the vertices of one colour only depend on the ones of the other colour, so the phi slices can be relaxed in parallel.
+    // Without phi symmetry and with an odd number of slices, the first and the last slice have the same colour:
+    // the last slice is relaxed after the others as in the sequential sweep, which keeps the result identical
+    const int nParallelSlices = (symmetry != 1 && symmetry != -1 && (iPhi % 2)) ? iPhi - 1 : iPhi;
+    for (int iPass = 1; iPass <= 2; ++iPass) {
+      const int msw = (iPass % 2) ? 1 : 2;
+#pragma omp parallel for num_threads(sNThreads)
+      for (int m = 0; m < nParallelSlices; ++m) {
+        relaxSlice(m, msw);
+      }
+      for (int m = nParallelSlices; m < iPhi; ++m) {
+        relaxSlice(m, msw);
+      }
+    } // end sweep
   } else if (MGParameters::relaxType == RelaxType::Jacobi) {
     // for each slice
     for (int m = 0; m < iPhi; ++m) {
@@ -1389,8 +1475,9 @@ template <typename DataT>
 void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vector& residue, const int tnRRow, const int tnZColumn, const int newPhiSlice, const int oldPhiSlice) const
 {
   if (2 * newPhiSlice == oldPhiSlice) {
-    int mm = 0;
-    for (int m = 0; m < newPhiSlice; m++, mm += 2) {
+#pragma omp parallel for num_threads(sNThreads)
+    for (int m = 0; m < newPhiSlice; m++) {
+      const int mm = 2 * m;
       // assuming no symmetry
       int mp1 = mm + 1;
       int mm1 = mm - 1;
@@ -1437,6 +1524,7 @@ void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vecto
     } // end phis
 
   } else {
+#pragma omp parallel for num_threads(sNThreads)
     for (int m = 0; m < newPhiSlice; ++m) {
       restrict2D(matricesCurrentCharge, residue, tnRRow, tnZColumn, m);
     }
@@ -1830,17 +1830,13 @@ std::vector<float> SpaceCharge<DataT>::getPotentialCyl(const std::vector<DataT>&
 template <typename DataT>
 void SpaceCharge<DataT>::getElectricFieldsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& eZ, DataT& eR, DataT& ePhi) const
 {
-  eZ = mInterpolatorEField[side].evalFieldZ(z, r, phi);
-  eR = mInterpolatorEField[side].evalFieldR(z, r, phi);
-  ePhi = mInterpolatorEField[side].evalFieldPhi(z, r, phi);
+  mInterpolatorEField[side].evalFields(&z, &r, &phi, 1, &eR, &eZ, &ePhi);
 }
 
 template <typename DataT>
 void SpaceCharge<DataT>::getLocalCorrectionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& lcorrZ, DataT& lcorrR, DataT& lcorrRPhi) const
 {
-  lcorrZ = mInterpolatorLocalCorr[side].evaldZ(z, r, phi);
-  lcorrR = mInterpolatorLocalCorr[side].evaldR(z, r, phi);
-  lcorrRPhi = mInterpolatorLocalCorr[side].evaldRPhi(z, r, phi);
+  mInterpolatorLocalCorr[side].evalDistCorr(z, r, phi, lcorrR, lcorrZ, lcorrRPhi);
 }
 
 template <typename DataT>
@@ -1859,9 +1855,7 @@ void SpaceCharge<DataT>::getLocalCorrectionsCyl(const std::vector<DataT>& z, con
 template <typename DataT>
 void SpaceCharge<DataT>::getCorrectionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& corrZ, DataT& corrR, DataT& corrRPhi) const
 {
-  corrZ = mInterpolatorGlobalCorr[side].evaldZ(z, r, phi);
-  corrR = mInterpolatorGlobalCorr[side].evaldR(z, r, phi);
-  corrRPhi = mInterpolatorGlobalCorr[side].evaldRPhi(z, r, phi);
+  mInterpolatorGlobalCorr[side].evalDistCorr(z, r, phi, corrR, corrZ, corrRPhi);
 }
 
 template <typename DataT>
@@ -1903,9 +1897,7 @@ void SpaceCharge<DataT>::getCorrections(const DataT x, const DataT y, const Data
 template <typename DataT>
 void SpaceCharge<DataT>::getLocalDistortionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& ldistZ, DataT& ldistR, DataT& ldistRPhi) const
 {
-  ldistZ = mInterpolatorLocalDist[side].evaldZ(z, r, phi);
-  ldistR = mInterpolatorLocalDist[side].evaldR(z, r, phi);
-  ldistRPhi = mInterpolatorLocalDist[side].evaldRPhi(z, r, phi);
+  mInterpolatorLocalDist[side].evalDistCorr(z, r, phi, ldistR, ldistZ, ldistRPhi);
 }
 
 template <typename DataT>
@@ -1924,9 +1916,7 @@ void SpaceCharge<DataT>::getLocalDistortionsCyl(const std::vector<DataT>& z, con
 template <typename DataT>
 void SpaceCharge<DataT>::getLocalDistortionVectorCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& lvecdistZ, DataT& lvecdistR, DataT& lvecdistRPhi) const
 {
-  lvecdistZ = mInterpolatorLocalVecDist[side].evaldZ(z, r, phi);
-  lvecdistR = mInterpolatorLocalVecDist[side].evaldR(z, r, phi);
-  lvecdistRPhi = mInterpolatorLocalVecDist[side].evaldRPhi(z, r, phi);
+  mInterpolatorLocalVecDist[side].evalDistCorr(z, r, phi, lvecdistR, lvecdistZ, lvecdistRPhi);
 }
 
 template <typename DataT>
@@ -1966,9 +1956,7 @@ void SpaceCharge<DataT>::getLocalCorrectionVectorCyl(const std::vector<DataT>& z
 template <typename DataT>
 void SpaceCharge<DataT>::getDistortionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& distZ, DataT& distR, DataT& distRPhi) const
 {
-  distZ = mInterpolatorGlobalDist[side].evaldZ(z, r, phi);
-  distR = mInterpolatorGlobalDist[side].evaldR(z, r, phi);
-  distRPhi = mInterpolatorGlobalDist[side].evaldRPhi(z, r, phi);
+  mInterpolatorGlobalDist[side].evalDistCorr(z, r, phi, distR, distZ, distRPhi);
 }
 
 template <typename DataT>
@@ -2105,26 +2093,41 @@ void SpaceCharge<DataT>::integrateEFieldsRoot(const DataT p1r, const DataT p1phi
   localIntDeltaEz = getSign(side) * static_cast<DataT>(fEz.Integral(p1z, p2z));
 }
 
+template <typename DataT>
+template <typename Fields>
+void SpaceCharge<DataT>::evalFields(const Fields& formulaStruct, const DataT* z, const DataT* r, const DataT* phi, const unsigned int nPoints, DataT* fieldR, DataT* fieldZ, DataT* fieldPhi)
+{
+  if constexpr (requires { formulaStruct.evalFields(z, r, phi, nPoints, fieldR, fieldZ, fieldPhi); }) {
+    formulaStruct.evalFields(z, r, phi, nPoints, fieldR, fieldZ, fieldPhi);
+  } else {
+    for (unsigned int i = 0; i < nPoints; ++i) {
+      fieldR[i] = formulaStruct.evalFieldR(z[i], r[i], phi[i]);
+      fieldZ[i] = formulaStruct.evalFieldZ(z[i], r[i], phi[i]);
+      fieldPhi[i] = formulaStruct.evalFieldPhi(z[i], r[i], phi[i]);
+    }
+  }
+}
+
 template <typename DataT>
 template <typename Fields>
 void SpaceCharge<DataT>::integrateEFieldsTrapezoidal(const DataT p1r, const DataT p1phi, const DataT p1z, const DataT p2z, DataT& localIntErOverEz, DataT& localIntEPhiOverEz, DataT& localIntDeltaEz, const Fields& formulaStruct, const DataT ezField, const Side side) const
 {
   //========trapezoidal rule see: https://en.wikipedia.org/wiki/Trapezoidal_rule ==============
-  const DataT fielder0 = formulaStruct.evalFieldR(p1z, p1r, p1phi);
-  const DataT fieldez0 = formulaStruct.evalFieldZ(p1z, p1r, p1phi);
-  const DataT fieldephi0 = formulaStruct.evalFieldPhi(p1z, p1r, p1phi);
-
-  const DataT fielder1 = formulaStruct.evalFieldR(p2z, p1r, p1phi);
-  const DataT fieldez1 = formulaStruct.evalFieldZ(p2z, p1r, p1phi);
-  const DataT fieldephi1 = formulaStruct.evalFieldPhi(p2z, p1r, p1phi);
+  const DataT posZ[2]{p1z, p2z};
+  const DataT posR[2]{p1r, p1r};
+  const DataT posPhi[2]{p1phi, p1phi};
+  DataT fieldR[2];
+  DataT fieldZ[2];
+  DataT fieldPhi[2];
+  evalFields(formulaStruct, posZ, posR, posPhi, 2, fieldR, fieldZ, fieldPhi);
 
-  const DataT eZ0 = isCloseToZero(ezField, fieldez0) ? 0 : 1. / (ezField + fieldez0);
-  const DataT eZ1 = isCloseToZero(ezField, fieldez1) ? 0 : 1. / (ezField + fieldez1);
+  const DataT eZ0 = isCloseToZero(ezField, fieldZ[0]) ? 0 : 1. / (ezField + fieldZ[0]);
+  const DataT eZ1 = isCloseToZero(ezField, fieldZ[1]) ? 0 : 1. / (ezField + fieldZ[1]);
 
   const DataT deltaX = 0.5 * (p2z - p1z);
-  localIntErOverEz = deltaX * (fielder0 * eZ0 + fielder1 * eZ1);
-  localIntEPhiOverEz = deltaX * (fieldephi0 * eZ0 + fieldephi1 * eZ1);
-  localIntDeltaEz = getSign(side) * deltaX * (fieldez0 + fieldez1);
+  localIntErOverEz = deltaX * (fieldR[0] * eZ0 + fieldR[1] * eZ1);
+  localIntEPhiOverEz = deltaX * (fieldPhi[0] * eZ0 + fieldPhi[1] * eZ1);
+  localIntDeltaEz = getSign(side) * deltaX * (fieldZ[0] + fieldZ[1]);
 }
 
 template <typename DataT>
@@ -2132,28 +2135,30 @@ template <typename Fields>
 void SpaceCharge<DataT>::integrateEFieldsSimpson(const DataT p1r, const DataT p1phi, const DataT p1z, const DataT p2z, DataT& localIntErOverEz, DataT& localIntEPhiOverEz, DataT& localIntDeltaEz, const Fields& formulaStruct, const DataT ezField, const Side side) const
 {
   //==========simpsons rule see: https://en.wikipedia.org/wiki/Simpson%27s_rule =============================
-  const DataT fielder0 = formulaStruct.evalFieldR(p1z, p1r, p1phi);
-  const DataT fieldez0 = formulaStruct.evalFieldZ(p1z, p1r, p1phi);
-  const DataT fieldephi0 = formulaStruct.evalFieldPhi(p1z, p1r, p1phi);
-
-  const DataT fielder1 = formulaStruct.evalFieldR(p2z, p1r, p1phi);
-  const DataT fieldez1 = formulaStruct.evalFieldZ(p2z, p1r, p1phi);
-  const DataT fieldephi1 = formulaStruct.evalFieldPhi(p2z, p1r, p1phi);
-
   const DataT deltaX = p2z - p1z;
   const DataT xk2N = (p2z - static_cast<DataT>(0.5) * deltaX);
-  const DataT ezField2 = formulaStruct.evalFieldZ(xk2N, p1r, p1phi);
+
+  // start point, mid point and end point ordered in z: consecutive points mostly lie in the same grid cell
+  const DataT posZ[3]{p1z, xk2N, p2z};
+  const DataT posR[3]{p1r, p1r, p1r};
+  const DataT posPhi[3]{p1phi, p1phi, p1phi};
+  DataT fieldR[3];
+  DataT fieldZ[3];
+  DataT fieldPhi[3];
+  evalFields(formulaStruct, posZ, posR, posPhi, 3, fieldR, fieldZ, fieldPhi);
+
+  const DataT ezField2 = fieldZ[1];
   const DataT ezField2Denominator = isCloseToZero(ezField, ezField2) ? 0 : 1. / (ezField + ezField2);
-  const DataT fieldSum2ErOverEz = formulaStruct.evalFieldR(xk2N, p1r, p1phi) * ezField2Denominator;
-  const DataT fieldSum2EphiOverEz = formulaStruct.evalFieldPhi(xk2N, p1r, p1phi) * ezField2Denominator;
+  const DataT fieldSum2ErOverEz = fieldR[1] * ezField2Denominator;
+  const DataT fieldSum2EphiOverEz = fieldPhi[1] * ezField2Denominator;
 
-  const DataT eZ0 = isCloseToZero(ezField, fieldez0) ? 0 : 1. / (ezField + fieldez0);
-  const DataT eZ1 = isCloseToZero(ezField, fieldez1) ? 0 : 1. / (ezField + fieldez1);
+  const DataT eZ0 = isCloseToZero(ezField, fieldZ[0]) ? 0 : 1. / (ezField + fieldZ[0]);
+  const DataT eZ1 = isCloseToZero(ezField, fieldZ[2]) ? 0 : 1. / (ezField + fieldZ[2]);
 
   const DataT deltaXSimpsonSixth = deltaX / 6.;
-  localIntErOverEz = deltaXSimpsonSixth * (4. * fieldSum2ErOverEz + fielder0 * eZ0 + fielder1 * eZ1);
-  localIntEPhiOverEz = deltaXSimpsonSixth * (4. * fieldSum2EphiOverEz + fieldephi0 * eZ0 + fieldephi1 * eZ1);
-  localIntDeltaEz = getSign(side) * deltaXSimpsonSixth * (4. * ezField2 + fieldez0 + fieldez1);
+  localIntErOverEz = deltaXSimpsonSixth * (4. * fieldSum2ErOverEz + fieldR[0] * eZ0 + fieldR[2] * eZ1);
+  localIntEPhiOverEz = deltaXSimpsonSixth * (4. * fieldSum2EphiOverEz + fieldPhi[0] * eZ0 + fieldPhi[2] * eZ1);
+  localIntDeltaEz = getSign(side) * deltaXSimpsonSixth * (4. * ezField2 + fieldZ[0] + fieldZ[2]);
 }
 
 template <typename DataT>
@@ -2165,25 +2170,34 @@ void SpaceCharge<DataT>::integrateEFieldsSimpsonIterative(const DataT p1r, const
   // const DataT ezField = getEzField(side);
   const DataT p2phiSave = regulatePhi(p2phi, side);
 
-  const DataT fielder0 = formulaStruct.evalFieldR(p1z, p1r, p1phi);
-  const DataT fieldez0 = formulaStruct.evalFieldZ(p1z, p1r, p1phi);
-  const DataT fieldephi0 = formulaStruct.evalFieldPhi(p1z, p1r, p1phi);
+  const DataT pHalfZ = 0.5 * (p1z + p2z);                              // dont needs to be regulated since p1z and p2z are already regulated
+  const DataT pHalfPhiSave = regulatePhi(0.5 * (p1phi + p2phi), side); // needs to be regulated since p2phi is not regulated
+  const DataT pHalfR = 0.5 * (p1r + p2r);
+
+  // start point, mid point and end point ordered in z: consecutive points mostly lie in the same grid cell
+  const DataT posZ[3]{p1z, pHalfZ, p2z};
+  const DataT posR[3]{p1r, pHalfR, p2r};
+  const DataT posPhi[3]{p1phi, pHalfPhiSave, p2phiSave};
+  DataT fieldR[3];
+  DataT fieldZ[3];
+  DataT fieldPhi[3];
+  evalFields(formulaStruct, posZ, posR, posPhi, 3, fieldR, fieldZ, fieldPhi);
 
-  const DataT fielder1 = formulaStruct.evalFieldR(p2z, p2r, p2phiSave);
-  const DataT fieldez1 = formulaStruct.evalFieldZ(p2z, p2r, p2phiSave);
-  const DataT fieldephi1 = formulaStruct.evalFieldPhi(p2z, p2r, p2phiSave);
+  const DataT fielder0 = fieldR[0];
+  const DataT fieldez0 = fieldZ[0];
+  const DataT fieldephi0 = fieldPhi[0];
+
+  const DataT fielder1 = fieldR[2];
+  const DataT fieldez1 = fieldZ[2];
+  const DataT fieldephi1 = fieldPhi[2];
 
   const DataT eZ0Inv = isCloseToZero(ezField, fieldez0) ? 0 : 1. / (ezField + fieldez0);
   const DataT eZ1Inv = isCloseToZero(ezField, fieldez1) ? 0 : 1. / (ezField + fieldez1);
 
-  const DataT pHalfZ = 0.5 * (p1z + p2z);                              // dont needs to be regulated since p1z and p2z are already regulated
-  const DataT pHalfPhiSave = regulatePhi(0.5 * (p1phi + p2phi), side); // needs to be regulated since p2phi is not regulated
-  const DataT pHalfR = 0.5 * (p1r + p2r);
-
-  const DataT ezField2 = formulaStruct.evalFieldZ(pHalfZ, pHalfR, pHalfPhiSave);
+  const DataT ezField2 = fieldZ[1];
   const DataT eZHalfInv = (isCloseToZero(ezField, ezField2) | isCloseToZero(ezField, fieldez0) | isCloseToZero(ezField, fieldez1)) ? 0 : 1. / (ezField + ezField2);
-  const DataT fieldSum2ErOverEz = formulaStruct.evalFieldR(pHalfZ, pHalfR, pHalfPhiSave);
-  const DataT fieldSum2EphiOverEz = formulaStruct.evalFieldPhi(pHalfZ, pHalfR, pHalfPhiSave);
+  const DataT fieldSum2ErOverEz = fieldR[1];
+  const DataT fieldSum2EphiOverEz = fieldPhi[1];
 
   const DataT deltaXSimpsonSixth = (p2z - p1z) / 6;
   localIntErOverEz = deltaXSimpsonSixth * (4 * fieldSum2ErOverEz * eZHalfInv + fielder0 * eZ0Inv + fielder1 * eZ1Inv);
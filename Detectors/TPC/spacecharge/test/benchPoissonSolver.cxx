@@ -0,0 +1,112 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  benchPoissonSolver.cxx
+/// \brief benchmark of the 3D multigrid poisson solver: throughput and accuracy per grid size, cycle type and number of threads
+
+#include "benchmark/benchmark.h"
+#include "TPCSpaceCharge/PoissonSolver.h"
+#include "TPCSpaceCharge/PoissonSolverHelpers.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include "TPCSpaceCharge/DataContainer3D.h"
+#include "TPCSpaceCharge/RegularGrid3D.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+using namespace o2::tpc;
+using DataT = double;
+
+// set the charge density everywhere and the potential on the boundaries of the grid from the analytical formulas
+// the analytical potential is returned for the comparison with the numerical solution
+static void setAnalyticalProblem(const RegularGrid3D<DataT>& grid, DataContainer3D<DataT>& potentialBoundary, DataContainer3D<DataT>& charge, DataContainer3D<DataT>& potentialAnalytical)
+{
+  const AnalyticalFields<DataT> formulas;
+  for (size_t iPhi = 0; iPhi < charge.getNPhi(); ++iPhi) {
+    const DataT phi = grid.getPhiVertex(iPhi);
+    for (size_t iR = 0; iR < charge.getNR(); ++iR) {
+      const DataT radius = grid.getRVertex(iR);
+      for (size_t iZ = 0; iZ < charge.getNZ(); ++iZ) {
+        const DataT z = grid.getZVertex(iZ);
+        charge(iZ, iR, iPhi) = formulas.evalDensity(z, radius, phi);
+        potentialAnalytical(iZ, iR, iPhi) = formulas.evalPotential(z, radius, phi);
+        const bool isBoundary = (iR == 0) || (iR == charge.getNR() - 1) || (iZ == 0) || (iZ == charge.getNZ() - 1);
+        potentialBoundary(iZ, iR, iPhi) = isBoundary ? potentialAnalytical(iZ, iR, iPhi) : 0;
+      }
+    }
+  }
+}
+
+static void benchPoissonSolver3D(benchmark::State& state)
+{
+  const unsigned short nR = state.range(0);
+  const unsigned short nZ = state.range(1);
+  const unsigned short nPhi = state.range(2);
+  const auto cycleType = static_cast<CycleType>(state.range(3));
+  const int nThreads = state.range(4);
+
+  using GridProp = GridProperties<DataT>;
+  const ParamSpaceCharge params{nR, nZ, nPhi};
+  const RegularGrid3D<DataT> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::getGridSpacingZ(nZ), GridProp::getGridSpacingR(nR), GridProp::getGridSpacingPhi(nPhi), params};
+
+  DataContainer3D<DataT> potentialBoundary(nZ, nR, nPhi);
+  DataContainer3D<DataT> potential(nZ, nR, nPhi);
+  DataContainer3D<DataT> potentialAnalytical(nZ, nR, nPhi);
+  DataContainer3D<DataT> charge(nZ, nR, nPhi);
+  setAnalyticalProblem(grid3D, potentialBoundary, charge, potentialAnalytical);
+
+  const auto cycleTypeDefault = MGParameters::cycleType;
+  const auto gammaDefault = MGParameters::gamma;
+  const auto nThreadsDefault = PoissonSolver<DataT>::getNThreads();
+  MGParameters::isFull3D = true;
+  MGParameters::cycleType = cycleType;
+  MGParameters::gamma = (cycleType == CycleType::WCycle) ? 2 : gammaDefault;
+  PoissonSolver<DataT>::setNThreads(nThreads);
+  PoissonSolver<DataT> poissonSolver(grid3D);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    potential = potentialBoundary;
+    state.ResumeTiming();
+    poissonSolver.poissonSolver3D(potential, charge, 0);
+  }
+
+  // largest relative deviation from the analytical solution, away from the zeros of the potential
+  DataT maxRelDiff = 0;
+  for (size_t i = 0; i < potential.getNDataPoints(); ++i) {
+    if (std::abs(potentialAnalytical[i]) > 0.01) {
+      maxRelDiff = std::max(maxRelDiff, std::abs(potential[i] - potentialAnalytical[i]) / std::abs(potentialAnalytical[i]));
+    }
+  }
+  state.counters["maxRelDiff"] = maxRelDiff;
+  state.counters["vertices"] = benchmark::Counter(potential.getNDataPoints(), benchmark::Counter::kIsIterationInvariantRate);
+
+  MGParameters::cycleType = cycleTypeDefault;
+  MGParameters::gamma = gammaDefault;
+  PoissonSolver<DataT>::setNThreads(nThreadsDefault);
+}
+
+static void CustomArguments(benchmark::internal::Benchmark* bench)
+{
+  const std::vector<std::array<int, 3>> grids{{129, 129, 180}, {257, 257, 180}, {257, 257, 360}};
+  for (const auto& grid : grids) {
+    for (const auto cycleType : {CycleType::FCycle, CycleType::VCycle, CycleType::WCycle}) {
+      for (const int nThreads : {1, 4, 8, 16}) {
+        bench->Args({grid[0], grid[1], grid[2], static_cast<int>(cycleType), nThreads});
+      }
+    }
+  }
+}
+
+BENCHMARK(benchPoissonSolver3D)->Apply(CustomArguments)->ArgNames({"nR", "nZ", "nPhi", "cycle", "threads"})->Unit(benchmark::kSecond)->UseRealTime()->Iterations(1);
+
+BENCHMARK_MAIN();
@@ -232,6 +232,16 @@ BOOST_AUTO_TEST_CASE(PoissonSolver3D_test)
   poissonSolver3D<DataT>();
 }
 
+BOOST_AUTO_TEST_CASE(PoissonSolver3DWCycle_test)
+{
+  o2::tpc::MGParameters::isFull3D = true; // 3D
+  o2::tpc::MGParameters::cycleType = o2::tpc::CycleType::WCycle;
+  o2::tpc::MGParameters::gamma = 2;
+  poissonSolver3D<DataT>();
+  o2::tpc::MGParameters::cycleType = o2::tpc::CycleType::FCycle;
+  o2::tpc::MGParameters::gamma = 1;
+}
+
 BOOST_AUTO_TEST_CASE(PoissonSolver3D2D_test)
 {
   o2::tpc::MGParameters::isFull3D = false; // 3D2D
@@ -22,6 +22,8 @@
 #include "TPCSpaceCharge/DataContainer3D.h"
 #include "TPCSpaceCharge/PoissonSolverHelpers.h"
 #include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include <array>
+#include <vector>
 
 namespace o2
 {
@@ -99,5 +101,65 @@ BOOST_AUTO_TEST_CASE(PoissonSolver3D_test)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TriCubicBatched_test)
+{
+  const ParamSpaceCharge params{NR, NZ, NPHI};
+  const DataT zmin = o2::tpc::GridProperties<DataT>::ZMIN;
+  const DataT rmin = o2::tpc::GridProperties<DataT>::RMIN;
+  const DataT phimin = o2::tpc::GridProperties<DataT>::PHIMIN;
+  const DataT rSpacing = o2::tpc::GridProperties<DataT>::getGridSpacingR(NR);
+  const DataT zSpacing = o2::tpc::GridProperties<DataT>::getGridSpacingZ(NZ);
+  const DataT phiSpacing = o2::tpc::GridProperties<DataT>::getGridSpacingPhi(NPHI);
+  o2::tpc::RegularGrid3D<DataT> grid3D(zmin, rmin, phimin, zSpacing, rSpacing, phiSpacing, params);
+
+  // fill three containers with different functions
+  o2::tpc::AnalyticalFields<DataT> field;
+  std::array<o2::tpc::DataContainer3D<DataT>, 3> data3D{o2::tpc::DataContainer3D<DataT>(NZ, NR, NPHI), o2::tpc::DataContainer3D<DataT>(NZ, NR, NPHI), o2::tpc::DataContainer3D<DataT>(NZ, NR, NPHI)};
+  for (int iz = 0; iz < NZ; ++iz) {
+    for (int ir = 0; ir < NR; ++ir) {
+      for (int iphi = 0; iphi < NPHI; ++iphi) {
+        const DataT z = zSpacing * iz + zmin;
+        const DataT r = rSpacing * ir + rmin;
+        const DataT phi = phiSpacing * iphi + phimin;
+        data3D[0](iz, ir, iphi) = field.evalPotential(z, r, phi);
+        data3D[1](iz, ir, iphi) = field.evalDensity(z, r, phi);
+        data3D[2](iz, ir, iphi) = field.evalFieldR(z, r, phi);
+      }
+    }
+  }
+
+  for (const bool extrapolate : {true, false}) {
+    std::array<o2::tpc::TriCubicInterpolator<DataT>, 3> interpolators{o2::tpc::TriCubicInterpolator<DataT>(data3D[0], grid3D), o2::tpc::TriCubicInterpolator<DataT>(data3D[1], grid3D), o2::tpc::TriCubicInterpolator<DataT>(data3D[2], grid3D)};
+    for (auto& interpolator : interpolators) {
+      interpolator.setExtrapolateValues(extrapolate);
+    }
+
+    // points along straight drift lines, partly outside of the grid, several consecutive points lie in the same cell
+    std::vector<DataT> z;
+    std::vector<DataT> r;
+    std::vector<DataT> phi;
+    for (int iR = -2; iR < NR + 2; iR += 3) {
+      for (int iPhi = -2; iPhi < NPHI + 2; iPhi += 5) {
+        for (int iZ = -2; iZ < 3 * NZ + 2; ++iZ) {
+          z.emplace_back(zmin + iZ * zSpacing / 3);
+          r.emplace_back(rmin + (iR + 0.3) * rSpacing);
+          phi.emplace_back(phimin + (iPhi + 0.6) * phiSpacing);
+        }
+      }
+    }
+
+    const unsigned int nPoints = z.size();
+    std::array<std::vector<DataT>, 3> values{std::vector<DataT>(nPoints), std::vector<DataT>(nPoints), std::vector<DataT>(nPoints)};
+    interpolators[0].interpolate<3>({&data3D[0], &data3D[1], &data3D[2]}, z.data(), r.data(), phi.data(), nPoints, {values[0].data(), values[1].data(), values[2].data()});
+
+    // the batched interpolation has to give exactly the same values as the interpolation of single points
+    for (unsigned int i = 0; i < nPoints; ++i) {
+      for (int iData = 0; iData < 3; ++iData) {
+        BOOST_CHECK_EQUAL(values[iData][i], interpolators[iData](z[i], r[i], phi[i]));
+      }
+    }
+  }
+}
+
 } // namespace tpc
 } // namespace o2
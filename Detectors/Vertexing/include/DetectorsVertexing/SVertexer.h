@@ -97,6 +97,18 @@ class SVertexer
   };
 
   static constexpr int POS = 0, NEG = 1;
+  /// range of negative seeds to combine with a positive one, the unit of work of the multithreaded seeds combination
+  struct SeedsChunk {
+    int iP = 0;
+    int firstN = 0;
+    int lastN = 0; // exclusive
+  };
+  /// entry of the output of a thread, used to merge the outputs of all threads ordered in vertex ID
+  struct ThreadEntry {
+    int thrID;
+    int entry;
+    int vtxID;
+  };
   struct TrackCand : o2::track::TrackParCov {
     GIndex gid{};
     VBracket vBracket{};
@@ -157,6 +169,9 @@ class SVertexer
   int checkCascades(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   int check3bodyDecays(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   void setupThreads();
+  void buildSeedsChunks();
+  template <typename IDX>
+  void sortThreadEntries(const std::vector<std::vector<IDX>>& idxTmp, std::vector<ThreadEntry>& sorted) const;
   void buildT2V(const o2::globaltracking::RecoContainer& recoTracks);
   void updateTimeDependentParams();
   bool acceptTrack(const GIndex gid, const o2::track::TrackParCov& trc) const;
@@ -187,6 +202,7 @@ class SVertexer
   std::vector<std::vector<Decay3BodyIndex>> m3bodyIdxTmp;
   std::array<std::vector<TrackCand>, 2> mTracksPool{}; // pools of positive and negative seeds sorted in min VtxID
   std::array<std::vector<int>, 2> mVtxFirstTrack{};    // 1st pos. and neg. track of the pools for each vertex
+  std::vector<SeedsChunk> mSeedsChunks;                // chunks of seeds combinations for the dynamic scheduling
 
   o2::dataformats::VertexBase mMeanVertex{{0., 0., 0.}, {0.1 * 0.1, 0., 0.1 * 0.1, 0., 0., 6. * 6.}};
   const SVertexerParams* mSVParams = nullptr;
@@ -30,6 +30,7 @@
 #endif
 
 #include "ReconstructionDataFormats/GlobalTrackID.h"
+#include <limits>
 
 using namespace o2::vertexing;
 namespace o2f = o2::framework;
@@ -46,37 +47,29 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
   updateTimeDependentParams(); // TODO RS: strictly speaking, one should do this only in case of the CCDB objects update
   mPVertices = recoData.getPrimaryVertices();
   buildT2V(recoData); // build track->vertex refs from vertex->track (if other workflow will need this, consider producing a message in the VertexTrackMatcher)
-  int ntrP = mTracksPool[POS].size(), ntrN = mTracksPool[NEG].size();
   if (mStrTracker) {
     mStrTracker->loadData(recoData);
     mStrTracker->prepareITStracks();
   }
+  buildSeedsChunks();
+  const int nChunks = mSeedsChunks.size();
 #ifdef WITH_OPENMP
-  int dynGrp = std::min(4, std::max(1, mNThreads / 2));
-#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
 #endif
-  for (int itp = 0; itp < ntrP; itp++) {
-    auto& seedP = mTracksPool[POS][itp];
-    const int firstN = mVtxFirstTrack[NEG][seedP.vBracket.getMin()];
-    if (firstN < 0) {
-      LOG(debug) << "No partner is found for pos.track " << itp << " out of " << ntrP;
-      continue;
-    }
-    for (int itn = firstN; itn < ntrN; itn++) { // start from the 1st negative track of lowest-ID vertex of positive
+  for (int ich = 0; ich < nChunks; ich++) {
+    const auto& chunk = mSeedsChunks[ich];
+    auto& seedP = mTracksPool[POS][chunk.iP];
+#ifdef WITH_OPENMP
+    int iThread = omp_get_thread_num();
+#else
+    int iThread = 0;
+#endif
+    for (int itn = chunk.firstN; itn < chunk.lastN; itn++) {
       auto& seedN = mTracksPool[NEG][itn];
-      if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
-        LOG(debug) << "Brackets do not match";
-        break;
-      }
       if (mSVParams->maxPVContributors < 2 && seedP.gid.isPVContributor() + seedN.gid.isPVContributor() > mSVParams->maxPVContributors) {
         continue;
       }
-#ifdef WITH_OPENMP
-      int iThread = omp_get_thread_num();
-#else
-      int iThread = 0;
-#endif
-      checkV0(seedP, seedN, itp, itn, iThread);
+      checkV0(seedP, seedN, chunk.iP, itn, iThread);
     }
   }
 
@@ -87,34 +80,15 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
 void SVertexer::produceOutput(o2::framework::ProcessingContext& pc)
 {
   // sort V0s and Cascades in vertex id
-  struct vid {
-    int thrID;
-    int entry;
-    int vtxID;
-  };
   for (int ith = 0; ith < mNThreads; ith++) {
     mNV0s += mV0sIdxTmp[ith].size();
     mNCascades += mCascadesIdxTmp[ith].size();
     mN3Bodies += m3bodyIdxTmp[ith].size();
   }
-  std::vector<vid> v0SortID, cascSortID, nbodySortID;
-  v0SortID.reserve(mNV0s);
-  cascSortID.reserve(mNCascades);
-  nbodySortID.reserve(mN3Bodies);
-  for (int ith = 0; ith < mNThreads; ith++) {
-    for (int j = 0; j < (int)mV0sIdxTmp[ith].size(); j++) {
-      v0SortID.emplace_back(vid{ith, j, mV0sIdxTmp[ith][j].getVertexID()});
-    }
-    for (int j = 0; j < (int)mCascadesIdxTmp[ith].size(); j++) {
-      cascSortID.emplace_back(vid{ith, j, mCascadesIdxTmp[ith][j].getVertexID()});
-    }
-    for (int j = 0; j < (int)m3bodyIdxTmp[ith].size(); j++) {
-      nbodySortID.emplace_back(vid{ith, j, m3bodyIdxTmp[ith][j].getVertexID()});
-    }
-  }
-  std::sort(v0SortID.begin(), v0SortID.end(), [](const vid& a, const vid& b) { return a.vtxID < b.vtxID; });
-  std::sort(cascSortID.begin(), cascSortID.end(), [](const vid& a, const vid& b) { return a.vtxID < b.vtxID; });
-  std::sort(nbodySortID.begin(), nbodySortID.end(), [](const vid& a, const vid& b) { return a.vtxID < b.vtxID; });
+  std::vector<ThreadEntry> v0SortID, cascSortID, nbodySortID;
+  sortThreadEntries(mV0sIdxTmp, v0SortID);
+  sortThreadEntries(mCascadesIdxTmp, cascSortID);
+  sortThreadEntries(m3bodyIdxTmp, nbodySortID);
 
   // dpl output
   auto& v0sIdx = pc.outputs().make<std::vector<V0Index>>(o2f::Output{"GLO", "V0S_IDX", 0});
@@ -256,6 +230,78 @@ void SVertexer::produceOutput(o2::framework::ProcessingContext& pc)
   extractPVReferences(v0sIdx, v0Refs, cascsIdx, cascRefs, body3Idx, vtx3bodyRefs);
 }
 
+//__________________________________________________________________
+void SVertexer::buildSeedsChunks()
+{
+  // Split the combinations of every positive seed with the negative seeds of compatible vertex brackets into chunks
+  // of limited size, so that the seeds with wide brackets (e.g. TPC-only tracks) are shared between the threads.
+  // The chunks follow the order of the pools, i.e. they are bucketed in the lowest vertex ID of the positive seed.
+  mSeedsChunks.clear();
+  const auto& poolP = mTracksPool[POS];
+  const auto& poolN = mTracksPool[NEG];
+  const int ntrP = poolP.size(), maxPairs = std::max(1, mSVParams->maxPairsPerChunk);
+  for (int itp = 0; itp < ntrP; itp++) {
+    const auto& seedP = poolP[itp];
+    const int firstN = mVtxFirstTrack[NEG][seedP.vBracket.getMin()];
+    if (firstN < 0) {
+      LOG(debug) << "No partner is found for pos.track " << itp << " out of " << ntrP;
+      continue;
+    }
+    // start from the 1st negative track of lowest-ID vertex of positive, stop at the 1st one whose vertices are all in future wrt that of seedP
+    const int lastN = std::partition_point(poolN.begin() + firstN, poolN.end(), [&seedP](const TrackCand& seedN) { return !(seedN.vBracket > seedP.vBracket); }) - poolN.begin();
+    for (int itn = firstN; itn < lastN; itn += maxPairs) {
+      mSeedsChunks.push_back(SeedsChunk{itp, itn, std::min(itn + maxPairs, lastN)});
+    }
+  }
+}
+
+//__________________________________________________________________
+template <typename IDX>
+void SVertexer::sortThreadEntries(const std::vector<std::vector<IDX>>& idxTmp, std::vector<ThreadEntry>& sorted) const
+{
+  // Counting sort of the outputs of all threads in vertex ID: the exclusive prefix sum of the per-thread counts of every
+  // vertex gives each thread its own slots in the output, which are then filled concurrently without locks.
+  // The entries of the same vertex keep the order of threads and of entries within a thread.
+  int minVtx = std::numeric_limits<int>::max(), maxVtx = std::numeric_limits<int>::min();
+  for (const auto& thrIdx : idxTmp) {
+    for (const auto& idx : thrIdx) {
+      minVtx = std::min(minVtx, idx.getVertexID());
+      maxVtx = std::max(maxVtx, idx.getVertexID());
+    }
+  }
+  sorted.clear();
+  if (maxVtx < minVtx) {
+    return;
+  }
+  const int nThreads = idxTmp.size(), nVtx = maxVtx - minVtx + 1;
+  std::vector<int> offsets(size_t(nVtx) * nThreads, 0); // [vertex][thread]
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(mNThreads)
+#endif
+  for (int ith = 0; ith < nThreads; ith++) {
+    for (const auto& idx : idxTmp[ith]) {
+      offsets[size_t(idx.getVertexID() - minVtx) * nThreads + ith]++;
+    }
+  }
+  int nTot = 0;
+  for (auto& offs : offsets) {
+    int n = offs;
+    offs = nTot;
+    nTot += n;
+  }
+  sorted.resize(nTot);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(mNThreads)
+#endif
+  for (int ith = 0; ith < nThreads; ith++) {
+    const auto& thrIdx = idxTmp[ith];
+    for (int j = 0; j < (int)thrIdx.size(); j++) {
+      const int vtxID = thrIdx[j].getVertexID();
+      sorted[offsets[size_t(vtxID - minVtx) * nThreads + ith]++] = ThreadEntry{ith, j, vtxID};
+    }
+  }
+}
+
 //__________________________________________________________________
 void SVertexer::init()
 {
@@ -11,6 +11,8 @@
 
 #include <map>
 #include <deque>
+#include <utility>
+#include <vector>
 #include <gsl/span>
 #include <TFile.h>
 #include <TTree.h>
@@ -60,6 +62,28 @@ struct DigiRecoTDC {
   o2::InteractionRecord ir;
 };
 
+/// Working variables for the reconstruction of a range of bunch crossings
+/// Each thread of the reconstruction has its own instance
+struct DigiRecoWorkspace {
+  float offset[NChannels];                                 /// Offset in current orbit
+  uint32_t offsetOrbit = 0xffffffff;                       /// Current orbit
+  uint8_t source[NChannels];                               /// Source of pedestal
+  bool inError = false;                                    /// Reconstruction of the range ends in error
+  int assignedTDC[NTDCChannels] = {0};                     /// Number of assigned TDCs in sequence (debugging)
+  int nLonely = 0;                                         /// Number of lonely bunches
+  int lonely[o2::constants::lhc::LHCMaxBunches] = {0};     /// Lonely bunches per bunch crossing number
+  int lonelyTrig[o2::constants::lhc::LHCMaxBunches] = {0}; /// Triggered lonely bunches per bunch crossing number
+  uint32_t missingPed[NChannels] = {0};                    /// Number of orbits with missing pedestal
+  // Configuration of interpolation for current TDC
+  int nbun;  // Number of adjacent bunches
+  int nsam;  // Number of acquired samples
+  int ntot;  // Total number of points in the interpolated arrays
+  int ilast; // Index of last acquired sample
+  int nint;  // Total points in the interpolation region (-1)
+  O2_ZDC_DIGIRECO_FLT firstSample;
+  O2_ZDC_DIGIRECO_FLT lastSample;
+};
+
 class DigiReco
 {
  public:
@@ -133,6 +157,9 @@ class DigiReco
     LOG(warn) << __func__ << " Configuration of TDC pile-up correction: " << (mCorrBackground ? "enabled" : "disabled");
   };
   bool getCorrBackground() { return mCorrBackground; };
+  // Number of threads for the reconstruction of independent bunch ranges
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
   bool inError()
   {
     return mInError;
@@ -143,37 +170,39 @@ class DigiReco
   const std::vector<o2::zdc::RecEventAux>& getReco() { return mReco; }
 
  private:
-  const ModuleConfig* mModuleConfig = nullptr;              /// Trigger/readout configuration object
-  void updateOffsets(int ibun);                             /// Update offsets to process current bunch
-  void lowPassFilter();                                     /// low-pass filtering of digitized data
-  int reconstructTDC(int seq_beg, int seq_end);             /// Reconstruction of uncorrected TDCs
-  int reconstruct(int seq_beg, int seq_end);                /// Main method for data reconstruction
-  int processTrigger(int itdc, int ibeg, int iend);         /// Replay of trigger algorithm on acquired data
-  int processTriggerExtended(int itdc, int ibeg, int iend); /// Replay of trigger algorithm on acquired data
-  int interpolate(int itdc, int ibeg, int iend);            /// Interpolation of samples to evaluate signal amplitude and arrival time
-  int fullInterpolation(int itdc, int ibeg, int iend);      /// Interpolation of samples
-  void correctTDCPile();                                    /// Correction of pile-up in TDC
-  bool mLowPassFilter = true;                               /// Enable low pass filtering
-  bool mLowPassFilterSet = false;                           /// Low pass filtering set via function call
-  bool mFullInterpolation = false;                          /// Full waveform interpolation
-  bool mFullInterpolationSet = false;                       /// Full waveform interpolation set via function call
-  int mFullInterpolationMinLength = 2;                      /// Minimum length to perform full interpolation
-  int mInterpolationStep = 25;                              /// Coarse interpolation step
-  bool mCorrSignal = true;                                  /// Enable TDC signal correction
-  bool mCorrSignalSet = false;                              /// TDC signal correction set via function call
-  bool mCorrBackground = true;                              /// Enable TDC pile-up correction
-  bool mCorrBackgroundSet = false;                          /// TDC pile-up correction set via function call
-  bool mInError = false;                                    /// ZDC reconstruction ends in error
-  int mAssignedTDC[NTDCChannels] = {0};                     /// Number of assigned TDCs in sequence (debugging)
+  const ModuleConfig* mModuleConfig = nullptr;                                     /// Trigger/readout configuration object
+  int findSequences();                                                             /// Find ranges of consecutive bunch crossings
+  int processChunk(DigiRecoWorkspace& ws, int ichunk);                             /// Reconstruction of an independent range of sequences
+  void updateOffsets(DigiRecoWorkspace& ws, int ibun);                             /// Update offsets to process current bunch
+  void lowPassFilter(int ibeg, int iend);                                          /// low-pass filtering of digitized data
+  int reconstructTDC(DigiRecoWorkspace& ws, int seq_beg, int seq_end);             /// Reconstruction of uncorrected TDCs
+  int reconstruct(DigiRecoWorkspace& ws, int seq_beg, int seq_end);                /// Main method for data reconstruction
+  int processTrigger(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend);         /// Replay of trigger algorithm on acquired data
+  int processTriggerExtended(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend); /// Replay of trigger algorithm on acquired data
+  int interpolate(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend);            /// Interpolation of samples to evaluate signal amplitude and arrival time
+  int fullInterpolation(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend);      /// Interpolation of samples
+  void correctTDCPile(int ibeg, int iend);                                         /// Correction of pile-up in TDC
+  bool mLowPassFilter = true;                                                      /// Enable low pass filtering
+  bool mLowPassFilterSet = false;                                                  /// Low pass filtering set via function call
+  bool mFullInterpolation = false;                                                 /// Full waveform interpolation
+  bool mFullInterpolationSet = false;                                              /// Full waveform interpolation set via function call
+  int mFullInterpolationMinLength = 2;                                             /// Minimum length to perform full interpolation
+  int mInterpolationStep = 25;                                                     /// Coarse interpolation step
+  bool mCorrSignal = true;                                                         /// Enable TDC signal correction
+  bool mCorrSignalSet = false;                                                     /// TDC signal correction set via function call
+  bool mCorrBackground = true;                                                     /// Enable TDC pile-up correction
+  bool mCorrBackgroundSet = false;                                                 /// TDC pile-up correction set via function call
+  bool mInError = false;                                                           /// ZDC reconstruction ends in error
+  int mNThreads = 1;                                                               /// Number of threads
 
   int correctTDCSignal(int itdc, int16_t TDCVal, float TDCAmp, float& fTDCVal, float& fTDCAmp, bool isbeg, bool isend); /// Correct TDC single signal
   int correctTDCBackground(int ibc, int itdc, std::deque<DigiRecoTDC>& tdc);                                            /// TDC amplitude and time corrections due to pile-up from previous bunches
 
-  O2_ZDC_DIGIRECO_FLT getPoint(int itdc, int ibeg, int iend, int i); /// Interpolation for current TDC
-  void setPoint(int itdc, int ibeg, int iend, int i);                /// Interpolation for current TDC
+  O2_ZDC_DIGIRECO_FLT getPoint(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend, int i); /// Interpolation for current TDC
+  void setPoint(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend, int i);                /// Interpolation for current TDC
 
-  void assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float amp); /// Set reconstructed TDC values
-  void findSignals(int ibeg, int iend);                                       /// Find signals around main-main that satisfy condition on TDC
+  void assignTDC(DigiRecoWorkspace& ws, int ibun, int ibeg, int iend, int itdc, int tdc, float amp); /// Set reconstructed TDC values
+  void findSignals(DigiRecoWorkspace& ws, int ibeg, int iend);                                       /// Find signals around main-main that satisfy condition on TDC
   const RecoParamZDC* mRopt = nullptr;
   bool mIsContinuous = true;                     /// continuous (self-triggered) or externally-triggered readout
   uint8_t mTriggerCondition = 0x3;               /// Trigger condition: 0x1 single, 0x3 double and 0x7 triple
@@ -197,29 +226,17 @@ class DigiReco
   gsl::span<const o2::zdc::ChannelData> mChData;    /// Payload
   std::vector<o2::zdc::RecEventAux> mReco;          /// Reconstructed data
   std::map<uint32_t, int> mOrbit;                   /// Information about orbit
-  float mOffset[NChannels];                         /// Offset in current orbit
-  uint32_t mOffsetOrbit = 0xffffffff;               /// Current orbit
-  uint8_t mSource[NChannels];                       /// Source of pedestal
   static constexpr int mNSB = TSN * NTimeBinsPerBC; /// Total number of interpolated points per bunch crossing
   RecEventAux mRec;                                 /// Debug reconstruction event
+  std::vector<std::pair<int, int>> mSequences;      /// First and last bunch of the sequences of consecutive bunch crossings
+  std::vector<int> mChunks;                         /// First sequence of the independent ranges of sequences (+ number of sequences)
+  std::vector<DigiRecoWorkspace> mWorkspaces;       /// Working variables of each thread
   int mNBC = 0;
-  int mNLonely = 0;
-  int mLonely[o2::constants::lhc::LHCMaxBunches] = {0};
-  int mLonelyTrig[o2::constants::lhc::LHCMaxBunches] = {0};
-  uint32_t mMissingPed[NChannels] = {0};
   int16_t tdc_shift[NTDCChannels] = {0};                           /// TDC correction (units of 1/96 ns)
   float tdc_calib[NTDCChannels] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};  /// TDC correction factor
   float tdc_offset[NTDCChannels] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}; /// TDC offset
   constexpr static uint16_t mMask[NTimeBinsPerBC] = {0x0001, 0x002, 0x004, 0x008, 0x0010, 0x0020, 0x0040, 0x0080, 0x0100, 0x0200, 0x0400, 0x0800};
   O2_ZDC_DIGIRECO_FLT mAlpha = 3; // Parameter of interpolation function
-  // Configuration of interpolation for current TDC
-  int mNbun;  // Number of adjacent bunches
-  int mNsam;  // Number of acquired samples
-  int mNtot;  // Total number of points in the interpolated arrays
-  int mIlast; // Index of last acquired sample
-  int mNint;  // Total points in the interpolation region (-1)
-  O2_ZDC_DIGIRECO_FLT mFirstSample;
-  O2_ZDC_DIGIRECO_FLT mLastSample;
 };
 } // namespace zdc
 } // namespace o2
@@ -11,6 +11,9 @@
 
 #include <TMath.h>
 #include "Framework/Logger.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 #include "ZDCReconstruction/DigiReco.h"
 #include "ZDCReconstruction/RecoParamZDC.h"
 
@@ -439,21 +442,48 @@ void DigiReco::eor()
 
   ZDCTDCDataErr::print();
 
-  if (mNLonely > 0) {
-    LOG(warn) << "Detected " << mNLonely << " lonely bunches";
+  // Sum the counters of all threads
+  int nLonely = 0;
+  uint32_t missingPed[NChannels] = {0};
+  std::vector<int> lonely(o2::constants::lhc::LHCMaxBunches, 0), lonelyTrig(o2::constants::lhc::LHCMaxBunches, 0);
+  for (const auto& ws : mWorkspaces) {
+    nLonely += ws.nLonely;
     for (int ib = 0; ib < o2::constants::lhc::LHCMaxBunches; ib++) {
-      if (mLonely[ib]) {
-        LOGF(warn, "lonely bunch %4d #times=%u #trig=%u", ib, mLonely[ib], mLonelyTrig[ib]);
+      lonely[ib] += ws.lonely[ib];
+      lonelyTrig[ib] += ws.lonelyTrig[ib];
+    }
+    for (int ich = 0; ich < NChannels; ich++) {
+      missingPed[ich] += ws.missingPed[ich];
+    }
+  }
+  if (nLonely > 0) {
+    LOG(warn) << "Detected " << nLonely << " lonely bunches";
+    for (int ib = 0; ib < o2::constants::lhc::LHCMaxBunches; ib++) {
+      if (lonely[ib]) {
+        LOGF(warn, "lonely bunch %4d #times=%u #trig=%u", ib, lonely[ib], lonelyTrig[ib]);
       }
     }
   }
   for (int ich = 0; ich < NChannels; ich++) {
-    if (mMissingPed[ich] > 0) {
-      LOGF(error, "Missing pedestal for ch %2d %s: %u", ich, ChannelNames[ich], mMissingPed[ich]);
+    if (missingPed[ich] > 0) {
+      LOGF(error, "Missing pedestal for ch %2d %s: %u", ich, ChannelNames[ich], missingPed[ich]);
     }
   }
 }
 
+void DigiReco::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  if (n > 1) {
+    LOG(warn) << "ZDC DigiReco: multithreading requested but OpenMP is not available, using 1 thread";
+  }
+  mNThreads = 1;
+#endif
+  LOG(info) << "ZDC DigiReco: reconstruction with " << mNThreads << " thread(s)";
+}
+
 void DigiReco::prepareInterpolation()
 {
   // Prepare tapered sinc function
@@ -495,6 +525,12 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
   mBCData = bcdata;
   mChData = chdata;
   mInError = false;
+  if (int(mWorkspaces.size()) < mNThreads) {
+    mWorkspaces.resize(mNThreads);
+  }
+  for (auto& ws : mWorkspaces) {
+    ws.inError = false;
+  }
 
   // Initialization of lookup structure for pedestals
   mOrbit.clear();
@@ -578,12 +614,8 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
     }
   }
 
-  // Low pass filtering
-  if (mLowPassFilter) {
-    // N.B. At the moment low pass filtering is performed only on TDC
-    // signals and not on the rest of the signals
-    lowPassFilter();
-  } else {
+  // Low pass filtering is performed on the ranges of bunches in processChunk
+  if (!mLowPassFilter) {
     // Copy samples
     for (int itdc = 0; itdc < NTDCChannels; itdc++) {
       auto isig = TDCSignal[itdc];
@@ -622,18 +654,64 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
   // With this definition of "consecutive" bunch crossings gaps in the sample data
   // may be present, therefore in the reconstruction method we take into account for signals
   // that do not span the entire range
-  int seq_beg = 0;
-  int seq_end = 0;
+  int rval = findSequences();
+  if (rval) {
+    return rval;
+  }
   if (mVerbosity > DbgMinimal) {
-    LOG(info) << "Processing ZDC reconstruction for " << mNBC << " bunch crossings";
+    LOG(info) << "Processing ZDC reconstruction for " << mNBC << " bunch crossings in " << mSequences.size() << " sequences and " << mChunks.size() - 1 << " independent ranges";
   }
 
-  // TDC reconstruction
+  // The independent ranges of sequences are reconstructed in parallel, the result of
+  // each bunch crossing does not depend on the number of threads
+  int nChunks = mChunks.size() - 1;
+  std::vector<int> chunkRval(nChunks, 0);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ichunk = 0; ichunk < nChunks; ichunk++) {
+#ifdef WITH_OPENMP
+    auto& ws = mWorkspaces[omp_get_thread_num()];
+#else
+    auto& ws = mWorkspaces[0];
+#endif
+    chunkRval[ichunk] = processChunk(ws, ichunk);
+  }
+  for (auto& ws : mWorkspaces) {
+    mInError |= ws.inError;
+  }
+  for (int ichunk = 0; ichunk < nChunks; ichunk++) {
+    if (chunkRval[ichunk]) {
+      return chunkRval[ichunk];
+    }
+  }
+
+  if (mTreeDbg) {
+    for (const auto& [ibeg, iend] : mSequences) {
+      // Lonely bunches are not reconstructed
+      if (ibeg == iend) {
+        continue;
+      }
+      for (int ibun = ibeg; ibun <= iend; ibun++) {
+        mRec = mReco[ibun];
+        mTDbg->Fill();
+      }
+    }
+  }
+  return 0;
+} // process
+
+int DigiReco::findSequences()
+{
+  // Sequences of consecutive bunch crossings
+  mSequences.clear();
+  int seq_beg = 0;
+  int seq_end = 0;
   for (int ibc = 0; ibc < mNBC; ibc++) {
     auto& ir = mBCData[seq_end].ir;
     auto bcd = mBCData[ibc].ir.differenceInBC(ir);
     if (bcd < 0) {
-      LOG(error) << "Bunch order error in TDC reconstruction";
+      LOG(error) << "Bunch order error in ZDC reconstruction";
       for (int ibcdump = 0; ibcdump < mNBC; ibcdump++) {
         LOG(error) << "mBCData[" << ibcdump << "] @ " << mBCData[ibcdump].ir.orbit << "." << mBCData[ibcdump].ir.bc;
       }
@@ -641,21 +719,13 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
       return __LINE__;
     } else if (bcd > 1) {
       // Detected a gap
-      int rval = reconstructTDC(seq_beg, seq_end);
-      if (rval) {
-        return rval;
-      }
-
+      mSequences.emplace_back(seq_beg, seq_end);
       seq_beg = ibc;
       seq_end = ibc;
     } else if (ibc == (mNBC - 1)) {
       // Last bunch
       seq_end = ibc;
-      int rval = reconstructTDC(seq_beg, seq_end);
-      if (rval) {
-        return rval;
-      }
-
+      mSequences.emplace_back(seq_beg, seq_end);
       seq_beg = mNBC;
       seq_end = mNBC;
     } else {
@@ -668,48 +738,65 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
 #endif
   }
 
+  // Ranges of sequences that can be reconstructed independently: the pile-up correction
+  // and the search for signals in previous bunches look back at most NBCAn bunch crossings
+  // therefore a range can start after a gap larger than NBCAn bunch crossings. Adjacent ranges
+  // are merged to give a few ranges per thread
+  const int minBunches = mNThreads > 1 ? mNBC / (4 * mNThreads) : mNBC;
+  int nseq = mSequences.size();
+  mChunks.clear();
+  if (nseq > 0) {
+    mChunks.push_back(0);
+  }
+  for (int iseq = 1; iseq < nseq; iseq++) {
+    auto bcd = mBCData[mSequences[iseq].first].ir.differenceInBC(mBCData[mSequences[iseq - 1].second].ir);
+    if (bcd > NBCAn && (mSequences[iseq].first - mSequences[mChunks.back()].first) >= minBunches) {
+      mChunks.push_back(iseq);
+    }
+  }
+  mChunks.push_back(nseq);
+  return 0;
+} // findSequences
+
+int DigiReco::processChunk(DigiRecoWorkspace& ws, int ichunk)
+{
+  int seq_first = mChunks[ichunk];
+  int seq_last = mChunks[ichunk + 1] - 1;
+  // Range of bunches in the chunk, including the bunches that do not belong to any sequence
+  int ibeg = mSequences[seq_first].first;
+  int iend = (ichunk + 2) < int(mChunks.size()) ? mSequences[seq_last + 1].first - 1 : mNBC - 1;
+  // The pedestal lookup starts from scratch in every chunk
+  ws.offsetOrbit = 0xffffffff;
+
+  // Low pass filtering
+  if (mLowPassFilter) {
+    // N.B. At the moment low pass filtering is performed only on TDC
+    // signals and not on the rest of the signals
+    lowPassFilter(ibeg, iend);
+  }
+
+  // TDC reconstruction
+  for (int iseq = seq_first; iseq <= seq_last; iseq++) {
+    int rval = reconstructTDC(ws, mSequences[iseq].first, mSequences[iseq].second);
+    if (rval) {
+      return rval;
+    }
+  }
+
   // Apply pile-up correction for TDCs to get corrected TDC amplitudes and values
-  correctTDCPile();
+  correctTDCPile(ibeg, iend);
 
   // ADC reconstruction
-  seq_beg = 0;
-  seq_end = 0;
-  for (int ibc = 0; ibc < mNBC; ibc++) {
-    auto& ir = mBCData[seq_end].ir;
-    auto bcd = mBCData[ibc].ir.differenceInBC(ir);
-    if (bcd < 0) {
-      LOG(error) << "Bunch order error in ADC reconstruction";
-      for (int ibcdump = 0; ibcdump < mNBC; ibcdump++) {
-        LOG(error) << "mBCData[" << ibcdump << "] @ " << mBCData[ibcdump].ir.orbit << "." << mBCData[ibcdump].ir.bc;
-      }
-      LOG(error) << "Orbit number is not increasing " << mBCData[seq_end].ir.orbit << "." << mBCData[seq_end].ir.bc << " followed by " << mBCData[ibc].ir.orbit << "." << mBCData[ibc].ir.bc;
-      return __LINE__;
-    } else if (bcd > 1) {
-      // Detected a gap
-      int rval = reconstruct(seq_beg, seq_end);
-      if (rval != 0) {
-        return rval;
-      }
-      seq_beg = ibc;
-      seq_end = ibc;
-    } else if (ibc == (mNBC - 1)) {
-      // Last bunch
-      seq_end = ibc;
-      int rval = reconstruct(seq_beg, seq_end);
-      if (rval != 0) {
-        return rval;
-      }
-      seq_beg = mNBC;
-      seq_end = mNBC;
-    } else {
-      // Look for another bunch
-      seq_end = ibc;
+  for (int iseq = seq_first; iseq <= seq_last; iseq++) {
+    int rval = reconstruct(ws, mSequences[iseq].first, mSequences[iseq].second);
+    if (rval) {
+      return rval;
     }
   }
   return 0;
-} // process
+} // processChunk
 
-void DigiReco::lowPassFilter()
+void DigiReco::lowPassFilter(int ibeg, int iend)
 {
   // First attempt to low pass filtering uses the average of three consecutive samples
   // ringing noise has T~6 ns w.r.t. a sampling period of ~ 2 ns
@@ -721,7 +808,7 @@ void DigiReco::lowPassFilter()
   constexpr int MaxTimeBin = NTimeBinsPerBC - 1;
   for (int itdc = 0; itdc < NTDCChannels; itdc++) {
     auto isig = TDCSignal[itdc];
-    for (int ibc = 0; ibc < mNBC; ibc++) {
+    for (int ibc = ibeg; ibc <= iend; ibc++) {
       // Indexes of current, previous and next recorded bunch crossings
       auto ref_c = mReco[ibc].ref[isig];
       uint32_t ref_p = ZDCRefInitVal;
@@ -783,13 +870,13 @@ void DigiReco::lowPassFilter()
   }
 }
 
-int DigiReco::reconstructTDC(int ibeg, int iend)
+int DigiReco::reconstructTDC(DigiRecoWorkspace& ws, int ibeg, int iend)
 {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
   LOG(info) << "________________________________________________________________________________";
   LOG(info) << __func__ << "(" << ibeg << ", " << iend << ") length=" << iend - ibeg + 1;
   for (int itdc = 0; itdc < NTDCChannels; itdc++) {
-    mAssignedTDC[itdc] = 0;
+    ws.assignedTDC[itdc] = 0;
   }
 #endif
   // Apply differential discrimination
@@ -811,9 +898,9 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
           // Need data for at least two consecutive bunch crossings
           int rval = 0;
           if (mRopt->doExtendedSearch) {
-            rval = processTriggerExtended(itdc, istart, istop);
+            rval = processTriggerExtended(ws, itdc, istart, istop);
           } else {
-            rval = processTrigger(itdc, istart, istop);
+            rval = processTrigger(ws, itdc, istart, istop);
           }
           if (rval) {
             return rval;
@@ -827,9 +914,9 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
     if (istart >= 0 && (istop - istart) > 0) {
       int rval = 0;
       if (mRopt->doExtendedSearch) {
-        rval = processTriggerExtended(itdc, istart, istop);
+        rval = processTriggerExtended(ws, itdc, istart, istop);
       } else {
-        rval = processTrigger(itdc, istart, istop);
+        rval = processTrigger(ws, itdc, istart, istop);
       }
       if (rval) {
         return rval;
@@ -864,7 +951,7 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
           // A gap is detected
           if (istart >= 0 && (istop - istart + 1) >= mFullInterpolationMinLength) {
             // Need data for at least mFullInterpolationMinLength (two) consecutive bunch crossings
-            int rval = fullInterpolation(isig, istart, istop);
+            int rval = fullInterpolation(ws, isig, istart, istop);
             if (rval) {
               return rval;
             }
@@ -875,7 +962,7 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
       }
       // Check if there are mFullInterpolationMinLength consecutive bunch crossings at the end of group
       if (istart >= 0 && (istop - istart + 1) >= mFullInterpolationMinLength) {
-        int rval = fullInterpolation(isig, istart, istop);
+        int rval = fullInterpolation(ws, isig, istart, istop);
         if (rval) {
           return rval;
         }
@@ -886,9 +973,9 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
   printf("Assiged TDCs:");
   bool hasMult = false;
   for (int itdc = 0; itdc < NTDCChannels; itdc++) {
-    if (mAssignedTDC[itdc] > 0) {
-      printf(" %s:%d", ChannelNames[TDCSignal[itdc]].data(), mAssignedTDC[itdc]);
-      if (mAssignedTDC[itdc] > 1) {
+    if (ws.assignedTDC[itdc] > 0) {
+      printf(" %s:%d", ChannelNames[TDCSignal[itdc]].data(), ws.assignedTDC[itdc]);
+      if (ws.assignedTDC[itdc] > 1) {
         hasMult = true;
       }
     }
@@ -902,7 +989,7 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
   return 0;
 } // reconstructTDC
 
-int DigiReco::reconstruct(int ibeg, int iend)
+int DigiReco::reconstruct(DigiRecoWorkspace& ws, int ibeg, int iend)
 {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
   LOG(info) << "________________________________________________________________________________";
@@ -910,10 +997,10 @@ int DigiReco::reconstruct(int ibeg, int iend)
 #endif
   // Process consecutive BCs
   if (ibeg == iend) {
-    mNLonely++;
-    mLonely[mReco[ibeg].ir.bc]++;
+    ws.nLonely++;
+    ws.lonely[mReco[ibeg].ir.bc]++;
     if (mBCData[ibeg].triggers != 0x0) {
-      mLonelyTrig[mReco[ibeg].ir.bc]++;
+      ws.lonelyTrig[mReco[ibeg].ir.bc]++;
     }
     // Cannot reconstruct lonely bunch
     // LOG(info) << "Lonely bunch " << mReco[ibeg].ir.orbit << "." << mReco[ibeg].ir.bc;
@@ -934,7 +1021,7 @@ int DigiReco::reconstruct(int ibeg, int iend)
 #endif
 
   // After pile-up correction, find signals around main-main that satisfy condition on TDC
-  findSignals(ibeg, iend);
+  findSignals(ws, ibeg, iend);
 
   // For each calorimeter that has detects a collision at the time of main-main
   // collisions we reconstruct integrated charges and fill output tree
@@ -991,7 +1078,7 @@ int DigiReco::reconstruct(int ibeg, int iend)
     }
     // Analyze all bunches
     for (int ibun = ibeg; ibun <= iend; ibun++) {
-      updateOffsets(ibun); // Get Orbit pedestals
+      updateOffsets(ws, ibun); // Get Orbit pedestals
       auto& rec = mReco[ibun];
       // Check if the corresponding TDC is fired
       ref[0] = mReco[ibun].ref[ich];
@@ -1030,8 +1117,8 @@ int DigiReco::reconstruct(int ibeg, int iend)
           // (reference can be orbit or QC). If pile-up is detected we use orbit pedestal
           // instead of event pedestal
           // TODO: pedestal event could have a TM..
-          if (hasEvPed && (mSource[ich] == PedOr || mSource[ich] == PedQC)) {
-            auto pedref = mOffset[ich];
+          if (hasEvPed && (ws.source[ich] == PedOr || ws.source[ich] == PedQC)) {
+            auto pedref = ws.offset[ich];
             if (evPed > pedref && (evPed - pedref) > mRopt->ped_thr_hi[ich]) {
               // Anomalous offset (put a warning but use event pedestal)
               rec.offPed[ich] = true;
@@ -1045,11 +1132,11 @@ int DigiReco::reconstruct(int ibeg, int iend)
           if (hasEvPed && rec.pilePed[ich] == false) {
             myPed = evPed;
             rec.adcPedEv[ich] = true;
-          } else if (mSource[ich] == PedOr) {
-            myPed = mOffset[ich];
+          } else if (ws.source[ich] == PedOr) {
+            myPed = ws.offset[ich];
             rec.adcPedOr[ich] = true;
-          } else if (mSource[ich] == PedQC) {
-            myPed = mOffset[ich];
+          } else if (ws.source[ich] == PedQC) {
+            myPed = ws.offset[ich];
             rec.adcPedQC[ich] = true;
           } else {
             rec.adcPedMissing[ich] = true;
@@ -1095,28 +1182,21 @@ int DigiReco::reconstruct(int ibeg, int iend)
       }
     } // Loop on bunches
   }   // Loop on channels
-  if (mTreeDbg) {
-    for (int ibun = ibeg; ibun <= iend; ibun++) {
-      auto& rec = mReco[ibun];
-      mRec = rec;
-      mTDbg->Fill();
-    }
-  }
   return 0;
 } // reconstruct
 
-void DigiReco::updateOffsets(int ibun)
+void DigiReco::updateOffsets(DigiRecoWorkspace& ws, int ibun)
 {
   auto orbit = mBCData[ibun].ir.orbit;
-  if (orbit == mOffsetOrbit) {
+  if (orbit == ws.offsetOrbit) {
     return;
   }
-  mOffsetOrbit = orbit;
+  ws.offsetOrbit = orbit;
 
   // Reset information about pedestal origin
   for (int ich = 0; ich < NChannels; ich++) {
-    mSource[ich] = PedND;
-    mOffset[ich] = std::numeric_limits<float>::infinity();
+    ws.source[ich] = PedND;
+    ws.offset[ich] = std::numeric_limits<float>::infinity();
   }
 
   // Default TDC pedestal is from orbit
@@ -1128,8 +1208,8 @@ void DigiReco::updateOffsets(int ibun)
       auto myped = float(orbitdata.data[ich]) * mModuleConfig->baselineFactor;
       if (myped >= ADCMin && myped <= ADCMax) {
         // Pedestal information is present for this channel
-        mOffset[ich] = myped;
-        mSource[ich] = PedOr;
+        ws.offset[ich] = myped;
+        ws.source[ich] = PedOr;
       }
     }
   }
@@ -1137,30 +1217,30 @@ void DigiReco::updateOffsets(int ibun)
   // Use average "QC" pedestal if orbit pedestals are missing
   if (mPedParam != nullptr) {
     for (int ich = 0; ich < NChannels; ich++) {
-      if (mSource[ich] == PedND) {
+      if (ws.source[ich] == PedND) {
         auto myped = mPedParam->getCalib(ich);
         if (myped >= ADCMin && myped <= ADCMax) {
-          mOffset[ich] = myped;
-          mSource[ich] = PedQC;
+          ws.offset[ich] = myped;
+          ws.source[ich] = PedQC;
         }
       }
     }
   }
 
   for (int ich = 0; ich < NChannels; ich++) {
-    if (mSource[ich] == PedND) {
-      mMissingPed[ich]++;
+    if (ws.source[ich] == PedND) {
+      ws.missingPed[ich]++;
       if (mVerbosity > DbgMinimal) {
-        LOGF(error, "Missing pedestal for ch %2d %s orbit %u ", ich, ChannelNames[ich], mOffsetOrbit);
+        LOGF(error, "Missing pedestal for ch %2d %s orbit %u ", ich, ChannelNames[ich], ws.offsetOrbit);
       }
     }
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
-    LOGF(info, "Pedestal for ch %2d %s orbit %u %s: %f", ich, ChannelNames[ich], mOffsetOrbit, mSource[ich] == PedOr ? "OR" : (mSource[ich] == PedQC ? "QC" : "??"), mOffset[ich]);
+    LOGF(info, "Pedestal for ch %2d %s orbit %u %s: %f", ich, ChannelNames[ich], ws.offsetOrbit, ws.source[ich] == PedOr ? "OR" : (ws.source[ich] == PedQC ? "QC" : "??"), ws.offset[ich]);
 #endif
   }
 } // updateOffsets
 
-int DigiReco::processTrigger(int itdc, int ibeg, int iend)
+int DigiReco::processTrigger(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend)
 {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
   LOG(info) << __func__ << "(itdc=" << itdc << "[" << ChannelNames[TDCSignal[itdc]] << "], " << ibeg << ", " << iend << "): " << mReco[ibeg].ir.orbit << "." << mReco[ibeg].ir.bc << " - " << mReco[iend].ir.orbit << "." << mReco[iend].ir.bc;
@@ -1252,10 +1332,10 @@ int DigiReco::processTrigger(int itdc, int ibeg, int iend)
       break;
     }
   }
-  return interpolate(itdc, ibeg, iend);
+  return interpolate(ws, itdc, ibeg, iend);
 } // processTrigger
 
-int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
+int DigiReco::processTriggerExtended(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend)
 {
   auto isig = TDCSignal[itdc];
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
@@ -1263,13 +1343,13 @@ int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
 #endif
   // Extends search zone at the beginning of sequence. Need pedestal information.
   // For simplicity we use information for current bunch/orbit
-  updateOffsets(ibeg);
-  if (mSource[isig] == PedND) {
+  updateOffsets(ws, ibeg);
+  if (ws.source[isig] == PedND) {
     // Fall back to normal trigger
     // Message will be produced when computing amplitude (if a hit is found in this bunch)
     // In this framework we have a potential undetected inefficiency, however pedestal
     // problem is a serious problem and will be noticed anyway
-    return processTrigger(itdc, ibeg, iend);
+    return processTrigger(ws, itdc, ibeg, iend);
   }
 
   int nbun = iend - ibeg + 1;
@@ -1305,9 +1385,9 @@ int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
         LOG(error) << __func__ << " @ " << __LINE__ << " Missing information for bunch crossing " << mReco[b2].ir.orbit << "." << mReco[b2].ir.bc << " sig = " << isig;
         return __LINE__;
       }
-      diff = mOffset[isig] - mChData[ref_s].data[s2];
+      diff = ws.offset[isig] - mChData[ref_s].data[s2];
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
-      m[0] = mOffset[isig];
+      m[0] = ws.offset[isig];
       s[0] = mChData[ref_s].data[s2];
 #endif
     } else {
@@ -1365,29 +1445,29 @@ int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
       break;
     }
   }
-  return interpolate(itdc, ibeg, iend);
+  return interpolate(ws, itdc, ibeg, iend);
 } // processTriggerExtended
 
 // Interpolation for single point
-O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(int isig, int ibeg, int iend, int i)
+O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(DigiRecoWorkspace& ws, int isig, int ibeg, int iend, int i)
 {
   constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
-  if (i >= mNtot || i < 0) {
-    LOG(error) << "Error addressing isig=" << isig << " i=" << i << " mNtot=" << mNtot;
-    mInError = true;
+  if (i >= ws.ntot || i < 0) {
+    LOG(error) << "Error addressing isig=" << isig << " i=" << i << " ws.ntot=" << ws.ntot;
+    ws.inError = true;
     return std::numeric_limits<float>::infinity();
   }
   // Constant extrapolation at the beginning and at the end of the array
   if (i < TSNH) {
     // Return value of first sample
-    return mFirstSample;
-  } else if (i >= mIlast) {
+    return ws.firstSample;
+  } else if (i >= ws.ilast) {
     // Return value of last sample
-    return mLastSample;
+    return ws.lastSample;
   } else {
     // Identification of the point to be assigned
     int ibun = ibeg + i / nsbun;
-    // Interpolation between acquired points (N.B. from 0 to mNint)
+    // Interpolation between acquired points (N.B. from 0 to ws.nint)
     i = i - TSNH;
     int im = i % TSN;
     if (im == 0) {
@@ -1396,7 +1476,7 @@ O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(int isig, int ibeg, int iend, int i)
       int ib = ibeg + (i / TSN) / NTimeBinsPerBC;
       if (ib != ibun) {
         LOG(error) << "ib=" << ib << " ibun=" << ibun;
-        mInError = true;
+        ws.inError = true;
         return std::numeric_limits<float>::infinity();
       }
       return mReco[ibun].data[isig][ip]; // Filtered point
@@ -1408,16 +1488,16 @@ O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(int isig, int ibeg, int iend, int i)
       O2_ZDC_DIGIRECO_FLT sum = 0;
       for (int is = TSN - im, ii = ip - TSL + 1; is < NTS; is += TSN, ii++) {
         // Default is first point in the array
-        O2_ZDC_DIGIRECO_FLT yy = mFirstSample;
+        O2_ZDC_DIGIRECO_FLT yy = ws.firstSample;
         if (ii > 0) {
-          if (ii < mNsam) {
+          if (ii < ws.nsam) {
             int ip = ii % NTimeBinsPerBC;
             int ib = ibeg + ii / NTimeBinsPerBC;
             yy = mReco[ib].data[isig][ip];
             // yy = mChData[mReco[ib].ref[isig]].data[ip];
           } else {
             // Last acquired point
-            yy = mLastSample;
+            yy = ws.lastSample;
           }
         }
         sum += mTS[is];
@@ -1429,7 +1509,7 @@ O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(int isig, int ibeg, int iend, int i)
   }
 }
 
-void DigiReco::setPoint(int isig, int ibeg, int iend, int i)
+void DigiReco::setPoint(DigiRecoWorkspace& ws, int isig, int ibeg, int iend, int i)
 {
   // This function needs to be used only if mFullInterpolation is true otherwise the
   // vectors are not allocated
@@ -1438,28 +1518,28 @@ void DigiReco::setPoint(int isig, int ibeg, int iend, int i)
     return;
   }
   constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
-  if (i >= mNtot || i < 0) {
-    LOG(error) << "Error addressing signal isig=" << isig << " i=" << i << " mNtot=" << mNtot;
-    mInError = true;
+  if (i >= ws.ntot || i < 0) {
+    LOG(error) << "Error addressing signal isig=" << isig << " i=" << i << " ws.ntot=" << ws.ntot;
+    ws.inError = true;
     return;
   }
   // Constant extrapolation at the beginning and at the end of the array
   if (i < TSNH) {
     // Assign value of first sample
-    mReco[ibeg].inter[isig][i] = mFirstSample;
-  } else if (i >= mIlast) {
+    mReco[ibeg].inter[isig][i] = ws.firstSample;
+  } else if (i >= ws.ilast) {
     // Assign value of last sample
     int isam = i % nsbun;
-    mReco[iend].inter[isig][isam] = mLastSample;
+    mReco[iend].inter[isig][isam] = ws.lastSample;
   } else {
     // Identification of the point to be assigned
     int ibun = ibeg + i / nsbun;
     int isam = i % nsbun;
-    mReco[ibun].inter[isig][isam] = getPoint(isig, ibeg, iend, i);
+    mReco[ibun].inter[isig][isam] = getPoint(ws, isig, ibeg, iend, i);
   }
 } // setPoint
 
-int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
+int DigiReco::fullInterpolation(DigiRecoWorkspace& ws, int isig, int ibeg, int iend)
 {
   // Interpolation of signal isig, in consecutive bunches from ibeg to iend
   // This function works for all signals and does not evaluate trigger
@@ -1474,11 +1554,11 @@ int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
   constexpr int MaxTimeBin = NTimeBinsPerBC - 1; //< number of samples per BC
 
   // Set data members for interpolation of the current channel
-  mNbun = iend - ibeg + 1;                    // Number of adjacent bunches
-  mNsam = mNbun * NTimeBinsPerBC;             // Number of acquired samples
-  mNtot = mNsam * TSN;                        // Total number of points in the interpolated arrays
-  mNint = (mNbun * NTimeBinsPerBC - 1) * TSN; // Total points in the interpolation region (-1)
-  mIlast = mNtot - TSNH;                      // Index of last acquired sample
+  ws.nbun = iend - ibeg + 1;                      // Number of adjacent bunches
+  ws.nsam = ws.nbun * NTimeBinsPerBC;             // Number of acquired samples
+  ws.ntot = ws.nsam * TSN;                        // Total number of points in the interpolated arrays
+  ws.nint = (ws.nbun * NTimeBinsPerBC - 1) * TSN; // Total points in the interpolation region (-1)
+  ws.ilast = ws.ntot - TSNH;                      // Index of last acquired sample
 
   // At this level there should be no need to check if the channel is connected
   // since a fatal should have been raised already
@@ -1490,23 +1570,23 @@ int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
     }
   }
 
-  mFirstSample = mReco[ibeg].data[isig][0];
-  mLastSample = mReco[iend].data[isig][MaxTimeBin];
+  ws.firstSample = mReco[ibeg].data[isig][0];
+  ws.lastSample = mReco[iend].data[isig][MaxTimeBin];
 
   // Allocate and fill array of interpolated points
   for (int ibun = ibeg; ibun <= iend; ibun++) {
     mReco[ibun].allocate(isig);
   }
-  for (int i = 0; i < mNtot; i++) {
-    setPoint(isig, ibeg, iend, i);
+  for (int i = 0; i < ws.ntot; i++) {
+    setPoint(ws, isig, ibeg, iend, i);
   }
-  if (mInError) {
+  if (ws.inError) {
     return __LINE__;
   }
   return 0;
 }
 
-int DigiReco::interpolate(int itdc, int ibeg, int iend)
+int DigiReco::interpolate(DigiRecoWorkspace& ws, int itdc, int ibeg, int iend)
 {
   // Interpolation of TDC channel itdc, in consecutive bunches from ibeg to iend
   int isig = TDCSignal[itdc];
@@ -1522,11 +1602,11 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
   constexpr int nsbun = TSN * NTimeBinsPerBC;    // Total number of interpolated points per bunch crossing
 
   // Set data members for interpolation of the current TDC
-  mNbun = iend - ibeg + 1;                    // Number of adjacent bunches
-  mNsam = mNbun * NTimeBinsPerBC;             // Number of acquired samples
-  mNtot = mNsam * TSN;                        // Total number of points in the interpolated arrays
-  mNint = (mNbun * NTimeBinsPerBC - 1) * TSN; // Total points in the interpolation region (-1)
-  mIlast = mNtot - TSNH;                      // Index of last acquired sample
+  ws.nbun = iend - ibeg + 1;                      // Number of adjacent bunches
+  ws.nsam = ws.nbun * NTimeBinsPerBC;             // Number of acquired samples
+  ws.ntot = ws.nsam * TSN;                        // Total number of points in the interpolated arrays
+  ws.nint = (ws.nbun * NTimeBinsPerBC - 1) * TSN; // Total points in the interpolation region (-1)
+  ws.ilast = ws.ntot - TSNH;                      // Index of last acquired sample
 
   constexpr int nsp = 5; // Number of points to be searched
 
@@ -1542,11 +1622,11 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
 
   // auto ref_beg = mReco[ibeg].ref[isig];
   // auto ref_end = mReco[iend].ref[isig];
-  // mFirstSample = mChData[ref_beg].data[0]; // Original points
-  // mLastSample = mChData[ref_end].data[MaxTimeBin]; // Original points
+  // ws.firstSample = mChData[ref_beg].data[0]; // Original points
+  // ws.lastSample = mChData[ref_end].data[MaxTimeBin]; // Original points
 
-  mFirstSample = mReco[ibeg].data[isig][0];
-  mLastSample = mReco[iend].data[isig][MaxTimeBin];
+  ws.firstSample = mReco[ibeg].data[isig][0];
+  ws.lastSample = mReco[iend].data[isig][MaxTimeBin];
 
   // mFullInterpolation turns on full interpolation for debugging
   // otherwise the interpolation is performed only around actual signal
@@ -1554,11 +1634,11 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
     for (int ibun = ibeg; ibun <= iend; ibun++) {
       mReco[ibun].allocate(isig);
     }
-    for (int i = 0; i < mNtot; i++) {
-      setPoint(isig, ibeg, iend, i);
+    for (int i = 0; i < ws.ntot; i++) {
+      setPoint(ws, isig, ibeg, iend, i);
     }
   }
-  if (mInError) {
+  if (ws.inError) {
     return __LINE__;
   }
   // Looking for a local maximum in a search zone
@@ -1571,7 +1651,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
   int ip[nsp] = {-1, -1, -1, -1, -1};
   // N.B. Points at the extremes are constant therefore no local maximum
   // can occur in these two regions
-  for (int i = 0; i < mNint; i += mInterpolationStep) {
+  for (int i = 0; i < ws.nint; i += mInterpolationStep) {
     int isam = i + TSNH;
     // Check if trigger is fired for this point
     // For the moment we don't take into account possible extensions of the search zone
@@ -1686,8 +1766,8 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
             sbeg = 0;
             send = sbeg + TSN;
           }
-          if (send > (mNint + TSNH)) {
-            send = mNint + TSNH;
+          if (send > (ws.nint + TSNH)) {
+            send = ws.nint + TSNH;
             sbeg = send - TSN;
           }
           if (sbeg < 0) {
@@ -1695,7 +1775,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
           }
           for (int spos = sbeg; spos < send; spos++) {
             // Perform interpolation for the searched point
-            O2_ZDC_DIGIRECO_FLT myval = getPoint(isig, ibeg, iend, spos);
+            O2_ZDC_DIGIRECO_FLT myval = getPoint(ws, isig, ibeg, iend, spos);
             // Get local minimum of waveform
             if (myval < amp) {
               amp = myval;
@@ -1705,19 +1785,19 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
         }
         // Store identified peak
         int ibun = ibeg + isam_amp / nsbun;
-        updateOffsets(ibun);
+        updateOffsets(ws, ibun);
         // At this level offsets are from Orbit or QC therefore
         // the TDC amplitude and time are affected by pile-up from
         // previous collisions. Pile up correction needs to be
         // performed after all signals have been identified
-        if (mSource[isig] != PedND) {
-          amp = mOffset[isig] - amp;
+        if (ws.source[isig] != PedND) {
+          amp = ws.offset[isig] - amp;
         } else {
           LOGF(error, "%u.%-4d Missing pedestal for TDC %d %s ", mBCData[ibun].ir.orbit, mBCData[ibun].ir.bc, itdc, ChannelNames[TDCSignal[itdc]]);
           amp = std::numeric_limits<float>::infinity();
         }
         int tdc = isam_amp % nsbun;
-        assignTDC(ibun, ibeg, iend, itdc, tdc, amp);
+        assignTDC(ws, ibun, ibeg, iend, itdc, tdc, amp);
       }
       amp = std::numeric_limits<float>::infinity();
       isam_amp = 0;
@@ -1731,7 +1811,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
         myval = mReco[ib_cur].inter[isig][mysam];
       } else {
         // Perform interpolation for the searched point
-        myval = getPoint(isig, ibeg, iend, isam);
+        myval = getPoint(ws, isig, ibeg, iend, isam);
       }
       // Get local minimum of waveform
       if (myval < amp) {
@@ -1740,7 +1820,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
       }
     }
   } // Loop on interpolated points
-  if (mInError) {
+  if (ws.inError) {
     return __LINE__;
   }
 
@@ -1756,8 +1836,8 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
           sbeg = 0;
           send = sbeg + TSN;
         }
-        if (send > (mNint + TSNH)) {
-          send = mNint + TSNH;
+        if (send > (ws.nint + TSNH)) {
+          send = ws.nint + TSNH;
           sbeg = send - TSN;
         }
         if (sbeg < 0) {
@@ -1765,7 +1845,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
         }
         for (int spos = sbeg; spos < send; spos++) {
           // Perform interpolation for the searched point
-          O2_ZDC_DIGIRECO_FLT myval = getPoint(isig, ibeg, iend, spos);
+          O2_ZDC_DIGIRECO_FLT myval = getPoint(ws, isig, ibeg, iend, spos);
           // Get local minimum of waveform
           if (myval < amp) {
             amp = myval;
@@ -1775,25 +1855,25 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
       }
       // Store identified peak
       int ibun = ibeg + isam_amp / nsbun;
-      updateOffsets(ibun);
-      if (mSource[isig] != PedND) {
-        amp = mOffset[isig] - amp;
+      updateOffsets(ws, ibun);
+      if (ws.source[isig] != PedND) {
+        amp = ws.offset[isig] - amp;
       } else {
         LOGF(error, "%u.%-4d Missing pedestal for TDC %d %s ", mBCData[ibun].ir.orbit, mBCData[ibun].ir.bc, itdc, ChannelNames[TDCSignal[itdc]]);
         amp = std::numeric_limits<float>::infinity();
       }
       int tdc = isam_amp % nsbun;
-      assignTDC(ibun, ibeg, iend, itdc, tdc, amp);
+      assignTDC(ws, ibun, ibeg, iend, itdc, tdc, amp);
     }
   }
-  if (mInError) {
+  if (ws.inError) {
     return __LINE__;
   }
   // TODO: add logic to assign TDC in presence of overflow
   return 0;
 } // interpolate
 
-void DigiReco::assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float amp)
+void DigiReco::assignTDC(DigiRecoWorkspace& ws, int ibun, int ibeg, int iend, int itdc, int tdc, float amp)
 {
   constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
   constexpr int tdc_max = nsbun / 2;
@@ -1848,11 +1928,11 @@ void DigiReco::assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float
   }
 #endif
   // Assign info about pedestal subtration
-  if (mSource[isig] == PedOr) {
+  if (ws.source[isig] == PedOr) {
     rec.tdcPedOr[isig] = true;
-  } else if (mSource[isig] == PedQC) {
+  } else if (ws.source[isig] == PedQC) {
     rec.tdcPedQC[isig] = true;
-  } else if (mSource[isig] == PedEv) {
+  } else if (ws.source[isig] == PedEv) {
     // In present implementation this never happens
     rec.tdcPedEv[isig] = true;
   } else {
@@ -1861,15 +1941,15 @@ void DigiReco::assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
   LOG(info) << __func__ << " itdc=" << itdc << " " << ChannelNames[isig] << " @ ibun=" << ibun << " " << mReco[ibun].ir.orbit << "." << mReco[ibun].ir.bc << " "
             << " tdc=" << tdc << " -> " << TDCValCorr << " shift=" << tdc_shift[itdc] << " -> TDCVal=" << TDCVal << "=" << TDCVal * o2::zdc::FTDCVal
-            << " mSource[" << isig << "] = " << unsigned(mSource[isig]) << " = " << mOffset[isig]
+            << " ws.source[" << isig << "] = " << unsigned(ws.source[isig]) << " = " << ws.offset[isig]
             << " amp=" << amp << " -> " << TDCAmpCorr << " calib=" << tdc_calib[itdc] << " offset=" << tdc_offset[itdc] << " -> TDCAmp=" << TDCAmp
             << (ibun == ibeg ? " B" : "") << (ibun == iend ? " E" : "");
-  mAssignedTDC[itdc]++;
+  ws.assignedTDC[itdc]++;
 #endif
   ihit++;
 } // assignTDC
 
-void DigiReco::findSignals(int ibeg, int iend)
+void DigiReco::findSignals(DigiRecoWorkspace& ws, int ibeg, int iend)
 {
   // N.B. findSignals is called after pile-up correction on TDCs
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
@@ -1877,7 +1957,7 @@ void DigiReco::findSignals(int ibeg, int iend)
 #endif
   // Identify TDC signals
   for (int ibun = ibeg; ibun <= iend; ibun++) {
-    updateOffsets(ibun); // Get orbit pedestals or run pedestals as a fallback
+    updateOffsets(ws, ibun); // Get orbit pedestals or run pedestals as a fallback
     auto& rec = mReco[ibun];
     for (int itdc = 0; itdc < NTDCChannels; itdc++) {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
@@ -1973,7 +2053,7 @@ void DigiReco::findSignals(int ibeg, int iend)
   } // loop on bunches
 } // findSignals
 
-void DigiReco::correctTDCPile()
+void DigiReco::correctTDCPile(int ibeg, int iend)
 {
   // Pile-up correction for TDCs
   // FEE acquires data in two modes: triggered and continuous
@@ -1994,7 +2074,8 @@ void DigiReco::correctTDCPile()
   // PT-PT
   // therefore we have to look for an interaction outside the range of consecutive bunch
   // crossings that is used in reconstruction. Therefore the correction is done outside
-  // reconstruction loop
+  // reconstruction loop. The ranges ibeg-iend are separated by more than NBCAn
+  // bunch crossings therefore there is no pile-up across ranges
   // In case TDC correction parameters are missing (e.g. mTDCCorr==0) then
   // pile-up is flagged but not corrected for
 
@@ -2010,7 +2091,7 @@ void DigiReco::correctTDCPile()
     // Queue is empty at first event of the time frame
     // TODO: collect information from previous time frame
     std::deque<DigiRecoTDC> tdc;
-    for (int ibc = 0; ibc < mNBC; ibc++) {
+    for (int ibc = ibeg; ibc <= iend; ibc++) {
       // Bunch to be corrected
       auto rec = &mReco[ibc];
       // Count the number of hits in preceding bunch crossings
@@ -0,0 +1,218 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testDigiReco.cxx
+/// \brief check that the ZDC reconstruction of a TF does not depend on the number of threads
+
+#define BOOST_TEST_MODULE Test ZDC DigiReco
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "CommonConstants/LHCConstants.h"
+#include "CommonUtils/ConfigurableParam.h"
+#include "DataFormatsZDC/BCData.h"
+#include "DataFormatsZDC/ChannelData.h"
+#include "DataFormatsZDC/OrbitData.h"
+#include "DataFormatsZDC/RecEventAux.h"
+#include "ZDCBase/Constants.h"
+#include "ZDCBase/ModuleConfig.h"
+#include "ZDCReconstruction/DigiReco.h"
+#include "ZDCReconstruction/RecoConfigZDC.h"
+#include "ZDCReconstruction/ZDCTDCParam.h"
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace o2::zdc;
+
+namespace
+{
+
+/// module configuration of the ZDC readout, as in the CreateModuleConfig macro
+ModuleConfig makeModuleConfig()
+{
+  struct Slot {
+    int8_t id;
+    bool read;
+    bool trig;
+  };
+  const Slot slots[NModules][NChPerModule] = {
+    {{IdZNAC, true, true}, {IdZNASum, false, false}, {IdZNA1, true, false}, {IdZNA2, true, false}},
+    {{IdZNAC, false, true}, {IdZNASum, true, false}, {IdZNA3, true, false}, {IdZNA4, true, false}},
+    {{IdZNCC, true, true}, {IdZNCSum, false, false}, {IdZNC1, true, false}, {IdZNC2, true, false}},
+    {{IdZNCC, false, true}, {IdZNCSum, true, false}, {IdZNC3, true, false}, {IdZNC4, true, false}},
+    {{IdZPAC, true, true}, {IdZEM1, true, true}, {IdZPA1, true, false}, {IdZPA2, true, false}},
+    {{IdZPAC, false, true}, {IdZPASum, true, false}, {IdZPA3, true, false}, {IdZPA4, true, false}},
+    {{IdZPCC, true, true}, {IdZEM2, true, true}, {IdZPC3, true, false}, {IdZPC4, true, false}},
+    {{IdZPCC, false, true}, {IdZPCSum, true, false}, {IdZPC1, true, false}, {IdZPC2, true, false}}};
+  ModuleConfig conf;
+  conf.nBunchAverage = 2;
+  int bshift = std::ceil(std::log2(double(NTimeBinsPerBC) * double(conf.nBunchAverage) * double(ADCRange))) - 16;
+  conf.baselineFactor = float(0x1 << bshift) / float(conf.nBunchAverage) / float(NTimeBinsPerBC);
+  for (int im = 0; im < NModules; im++) {
+    auto& module = conf.modules[im];
+    module.id = im;
+    for (int ic = 0; ic < NChPerModule; ic++) {
+      const auto& slot = slots[im][ic];
+      module.setChannel(ic, slot.id, 2 * im + ic / 2, slot.read, slot.trig, -5, 6, 4, 12);
+    }
+  }
+  return conf;
+}
+
+/// reconstruction configuration, as in the CreateRecoConfigZDC macro
+RecoConfigZDC makeRecoConfig()
+{
+  RecoConfigZDC conf;
+  conf.setDoubleTrigger();
+  for (int itdc = 0; itdc < NTDCChannels; itdc++) {
+    conf.setSearch(itdc, 250);
+  }
+  for (int ich = 0; ich < NChannels; ich++) {
+    conf.setIntegration(ich, 6, 8, -12, -8);
+    conf.setPedThreshold(ich, ADCRange, ADCRange);
+  }
+  return conf;
+}
+
+ZDCTDCParam makeTDCParam()
+{
+  ZDCTDCParam conf;
+  for (int itdc = 0; itdc < NTDCChannels; itdc++) {
+    conf.setShift(itdc, 12.5);
+    conf.setFactor(itdc, 1.);
+  }
+  return conf;
+}
+
+/// A TF of a few orbits: sequences of 1 to 5 consecutive bunch crossings separated by gaps of various lengths,
+/// with the samples of all channels on a noisy baseline and pulses of random amplitude and time in some of them
+struct SyntheticTF {
+  std::vector<OrbitData> orbitData;
+  std::vector<BCData> bcData;
+  std::vector<ChannelData> chData;
+
+  SyntheticTF(const ModuleConfig& moduleConfig, int nOrbits)
+  {
+    std::mt19937 gen(2468);
+    std::uniform_int_distribution<int> seqLength(1, 5);
+    std::uniform_int_distribution<int> gap(2, 40);
+    std::normal_distribution<float> noise(0., 2.);
+    std::bernoulli_distribution hasPulse(0.3);
+    std::uniform_real_distribution<float> amplitude(20., 1500.);
+    std::uniform_real_distribution<float> peak(2., 9.);
+    constexpr float baseline = 1800.;
+
+    for (uint32_t orbit = 1; orbit <= uint32_t(nOrbits); orbit++) {
+      std::array<int16_t, NChannels> ped{};
+      std::array<uint16_t, NChannels> scaler{};
+      for (int ich = 0; ich < NChannels; ich++) {
+        ped[ich] = int16_t(baseline / moduleConfig.baselineFactor);
+        scaler[ich] = 10;
+      }
+      orbitData.emplace_back(o2::InteractionRecord(0, orbit), ped, scaler);
+      int bc = gap(gen);
+      while (bc < o2::constants::lhc::LHCMaxBunches) {
+        for (int n = seqLength(gen); n-- && bc < o2::constants::lhc::LHCMaxBunches; bc++) {
+          uint32_t channels = 0, triggers = 0;
+          int first = chData.size();
+          for (int ich = 0; ich < NChannels; ich++) {
+            std::array<float, NTimeBinsPerBC> samples{};
+            bool pulse = hasPulse(gen);
+            float amp = amplitude(gen), t0 = peak(gen);
+            for (int is = 0; is < NTimeBinsPerBC; is++) {
+              samples[is] = baseline + noise(gen) - (pulse ? amp * std::exp(-0.5 * (is - t0) * (is - t0) / 2.) : 0.);
+            }
+            chData.emplace_back(ich, samples);
+            channels |= 0x1 << ich;
+            if (pulse && amp > 100.) {
+              triggers |= 0x1 << ich;
+            }
+          }
+          bcData.emplace_back(first, NChannels, o2::InteractionRecord(bc, orbit), channels, triggers, 0);
+        }
+        bc += gap(gen);
+      }
+    }
+  }
+};
+
+void checkSameReco(const std::vector<RecEventAux>& reco, const std::vector<RecEventAux>& expected)
+{
+  BOOST_REQUIRE_EQUAL(reco.size(), expected.size());
+  for (size_t ibc = 0; ibc < reco.size(); ibc++) {
+    const auto& r = reco[ibc];
+    const auto& e = expected[ibc];
+    BOOST_CHECK(r.ir == e.ir);
+    BOOST_CHECK_EQUAL(r.flags, e.flags);
+    BOOST_CHECK_EQUAL(r.ezdcDecoded, e.ezdcDecoded);
+    BOOST_CHECK(r.ezdc == e.ezdc);
+    for (int itdc = 0; itdc < NTDCChannels; itdc++) {
+      BOOST_CHECK_EQUAL(r.ntdc[itdc], e.ntdc[itdc]);
+      BOOST_CHECK_EQUAL(r.fired[itdc], e.fired[itdc]);
+      BOOST_CHECK(r.TDCVal[itdc] == e.TDCVal[itdc]);
+      BOOST_CHECK(r.TDCAmp[itdc] == e.TDCAmp[itdc]);
+      BOOST_CHECK(r.TDCPile[itdc] == e.TDCPile[itdc]);
+    }
+    BOOST_CHECK(r.pattern == e.pattern);
+    BOOST_CHECK(r.err == e.err);
+    BOOST_CHECK(r.adcPedOr == e.adcPedOr);
+    BOOST_CHECK(r.adcPedMissing == e.adcPedMissing);
+    BOOST_CHECK(r.tdcPedMissing == e.tdcPedMissing);
+    BOOST_CHECK(r.pilePed == e.pilePed);
+    BOOST_CHECK(r.pileTM == e.pileTM);
+    for (int ich = 0; ich < NChannels; ich++) {
+      BOOST_CHECK_EQUAL(r.chfired[ich], e.chfired[ich]);
+      BOOST_CHECK(r.data[ich] == e.data[ich]);
+    }
+  }
+}
+
+/// reconstruct the same TF with 1 and 4 threads, after setting the given reconstruction parameters
+void checkThreads(const std::string& params)
+{
+  o2::conf::ConfigurableParam::updateFromString(params);
+  auto moduleConfig = makeModuleConfig();
+  auto recoConfig = makeRecoConfig();
+  auto tdcParam = makeTDCParam();
+  SyntheticTF tf(moduleConfig, 4);
+
+  auto reconstruct = [&](int nThreads, std::vector<RecEventAux>& reco) {
+    DigiReco dr;
+    dr.setModuleConfig(&moduleConfig);
+    dr.setRecoConfigZDC(&recoConfig);
+    dr.setTDCParam(&tdcParam);
+    dr.setVerbosity(DbgZero);
+    dr.setNThreads(nThreads);
+    dr.init();
+    BOOST_REQUIRE_EQUAL(dr.process(tf.orbitData, tf.bcData, tf.chData), 0);
+    reco = dr.getReco();
+  };
+
+  std::vector<RecEventAux> reco1, reco4;
+  reconstruct(1, reco1);
+  reconstruct(4, reco4);
+  BOOST_REQUIRE_EQUAL(reco1.size(), tf.bcData.size());
+  checkSameReco(reco4, reco1);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(DigiReco_Threads)
+{
+  checkThreads("RecoParamZDC.full_interpolation=0");
+}
+
+BOOST_AUTO_TEST_CASE(DigiReco_ThreadsFullInterpolation)
+{
+  checkThreads("RecoParamZDC.full_interpolation=1");
+}
@@ -27,7 +27,13 @@
 #include <TTree.h>
 #include <TMap.h>
 #include <TObjString.h>
+#include <TROOT.h>
 #include <arrow/table.h>
+#include <arrow/util/byte_size.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <chrono>
 
 namespace o2::framework::writers
 {
@@ -48,6 +54,12 @@ struct InputObject {
   int count = -1;
 };
 
+/// Throughput of the AOD writer for a given table
+struct TableWriteStats {
+  int64_t bytes = 0; // uncompressed size of the written columns
+  double seconds = 0;
+};
+
 const static std::unordered_map<OutputObjHandlingPolicy, std::string> ROOTfileNames = {{OutputObjHandlingPolicy::AnalysisObject, "AnalysisResults.root"},
                                                                                        {OutputObjHandlingPolicy::QAObject, "QAResults.root"}};
 
@@ -59,9 +71,27 @@ AlgorithmSpec AODWriterHelpers::getOutputTTreeWriter(ConfigContext const& ctx)
   if (ctx.options().hasOption("aod-writer-compression")) {
     compressionLevel = ctx.options().get<int>("aod-writer-compression");
   }
-  return AlgorithmSpec{[dod, outputInputs = ac.outputsInputsAOD, compressionLevel](InitContext& ic) -> std::function<void(ProcessingContext&)> {
+  int nThreads = 0;
+  if (ctx.options().hasOption("aod-writer-threads")) {
+    nThreads = ctx.options().get<int>("aod-writer-threads");
+  }
+  return AlgorithmSpec{[dod, outputInputs = ac.outputsInputsAOD, compressionLevel, nThreads](InitContext& ic) -> std::function<void(ProcessingContext&)> {
     LOGP(debug, "======== getGlobalAODSink::Init ==========");
 
+    // The columns of a table are converted to branches by the writer's own workers, one task per column.
+    // ROOT locks its global state for this, but implicit multithreading stays off for the rest of the process.
+    TableToTree::TaskRunner runTasks;
+    if (nThreads > 0) {
+      ROOT::EnableThreadSafety();
+      auto arena = std::make_shared<tbb::task_arena>(nThreads);
+      runTasks = [arena](std::vector<std::function<void()>> const& tasks) {
+        arena->execute([&tasks]() {
+          tbb::parallel_for(size_t{0}, tasks.size(), [&tasks](size_t i) { tasks[i](); });
+        });
+      };
+      LOGP(info, "AOD writer filling the branches with {} threads", nThreads);
+    }
+
     // find out if any table needs to be saved
     bool hasOutputsToWrite = false;
     for (auto& outobj : outputInputs) {
@@ -84,9 +114,15 @@ AlgorithmSpec AODWriterHelpers::getOutputTTreeWriter(ConfigContext const& ctx)
       };
     }
 
+    auto writeStats = std::make_shared<std::map<std::string, TableWriteStats>>();
+
     // end of data functor is called at the end of the data stream
-    auto endofdatacb = [dod](EndOfStreamContext& context) {
+    auto endofdatacb = [dod, writeStats](EndOfStreamContext& context) {
       dod->closeDataFiles();
+      for (auto& [tableName, stats] : *writeStats) {
+        LOGP(info, "AOD writer: table {} {:.1f} MB in {:.2f} s, {:.1f} MB/s", tableName, stats.bytes / 1.e6, stats.seconds,
+             stats.seconds > 0 ? stats.bytes / 1.e6 / stats.seconds : 0.);
+      }
       context.services().get<ControlService>().readyToQuit(QuitRequest::Me);
     };
 
@@ -101,7 +137,7 @@ AlgorithmSpec AODWriterHelpers::getOutputTTreeWriter(ConfigContext const& ctx)
     std::vector<TString> aodMetaDataVals;
 
     // this functor is called once per time frame
-    return [dod, tfNumbers, tfFilenames, aodMetaDataKeys, aodMetaDataVals, compressionLevel](ProcessingContext& pc) mutable -> void {
+    return [dod, tfNumbers, tfFilenames, aodMetaDataKeys, aodMetaDataVals, compressionLevel, writeStats, runTasks](ProcessingContext& pc) mutable -> void {
       LOGP(debug, "======== getGlobalAODSink::processing ==========");
       LOGP(debug, " processing data set with {} entries", pc.inputs().size());
 
@@ -194,7 +230,9 @@ AlgorithmSpec AODWriterHelpers::getOutputTTreeWriter(ConfigContext const& ctx)
         // loop over all DataOutputDescriptors
         // a table can be saved in multiple ways
         // e.g. different selections of columns to different files
+        auto& stats = (*writeStats)[tableName];
         for (auto d : ds) {
+          auto start = std::chrono::steady_clock::now();
           auto fileAndFolder = dod->getFileFolder(d, tfNumber, aodInputFile, compressionLevel);
           auto treename = fileAndFolder.folderName + "/" + d->treename;
           TableToTree ta2tr(table,
@@ -219,12 +257,15 @@ AlgorithmSpec AODWriterHelpers::getOutputTTreeWriter(ConfigContext const& ctx)
               auto field = table->schema()->field(idx);
               if (idx != -1) {
                 ta2tr.addBranch(col, field);
+                stats.bytes += arrow::util::TotalBufferSize(*col);
               }
             }
           } else {
             ta2tr.addAllBranches();
+            stats.bytes += arrow::util::TotalBufferSize(*table);
           }
-          ta2tr.process();
+          ta2tr.process(runTasks);
+          stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
         }
       }
     };
@@ -22,7 +22,9 @@
 #include "Framework/TimesliceSlot.h"
 #include "Framework/ServiceRegistryRef.h"
 
+#include <atomic>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <functional>
@@ -116,7 +118,7 @@ class DataRelayer
 
   /// Prune all the pending entries in the cache.
   void prunePending(OnDropCallback);
-  /// Prune the cache for a given slot
+  /// Prune the cache for a given slot, waiting for the relays still storing messages in it.
   void pruneCache(TimesliceSlot slot, OnDropCallback onDrop = nullptr);
 
   /// This is to relay a whole set of fair::mq::Messages, all which are part
@@ -213,6 +215,47 @@ class DataRelayer
   std::vector<PruneOp> mPruneOps;
   size_t mMaxLanes;
 
+  /// Remove the messages of a slot from the cache, the slot must be closed.
+  void pruneSlot(TimesliceSlot slot, OnDropCallback const& onDrop);
+
+  /// Messages are stored in the cache without holding mMutex. relay() picks the
+  /// slot and reads its sequence number under the lock, then reserves the slot
+  /// with a CAS on its state, which fails if the slot was closed or recycled in
+  /// the meantime, stores the parts and publishes the slot in the ready queue.
+  /// Whoever needs the cache entries of a slot closes it first: new writers are
+  /// refused and the ones already in are waited for with the lock released.
+  [[nodiscard]] uint32_t slotSequence(TimesliceSlot slot) const;
+  bool reserveSlot(TimesliceSlot slot, uint32_t sequence);
+  void publishSlot(TimesliceSlot slot);
+  /// Close the slot only if nobody is writing to it or owns it, never waits.
+  bool tryCloseSlot(TimesliceSlot slot);
+  void closeSlot(std::unique_lock<O2_LOCKABLE(std::recursive_mutex)>& lock, TimesliceSlot slot);
+  void closeAllSlots(std::unique_lock<O2_LOCKABLE(std::recursive_mutex)>& lock);
+  /// Let writers in again, @a recycled if the slot was emptied, so that the
+  /// writers which read the previous sequence number start over.
+  void reopenSlot(TimesliceSlot slot, bool recycled);
+  void reopenAllSlots(bool recycled);
+  /// Mark as dirty the slots which were written since the last call.
+  void drainReadyQueue();
+
+  /// The state of each slot: the sequence number in the high 32 bits,
+  /// SlotClosedBit while somebody owns the cache entries of the slot,
+  /// SlotQueuedBit if the slot is in the ready queue and the number of writers
+  /// in the low bits.
+  static constexpr int SlotSequenceShift = 32;
+  static constexpr uint64_t SlotClosedBit = 1ull << 31;
+  static constexpr uint64_t SlotQueuedBit = 1ull << 30;
+  static constexpr uint64_t SlotWritersMask = SlotQueuedBit - 1;
+  std::unique_ptr<std::atomic<uint64_t>[]> mSlotStates;
+  /// One flag per cache entry, so that writers of the same entry do not interleave their parts.
+  std::unique_ptr<std::atomic_flag[]> mEntryBusy;
+  /// Bounded multi producer, single consumer queue of slot index + 1 (0 means empty).
+  /// A slot is queued at most once, so the number of slots is enough as capacity.
+  std::unique_ptr<std::atomic<size_t>[]> mReadyQueue;
+  size_t mReadyQueueCapacity = 0;
+  std::atomic<size_t> mReadyQueueTail = 0;
+  size_t mReadyQueueHead = 0;
+
   O2_LOCKABLE_NAMED(std::recursive_mutex, mMutex, "data relayer mutex");
 };
 
@@ -27,7 +27,9 @@
 #include <TDataType.h>
 #include <TArrayL.h>
 
+#include <algorithm>
 #include <deque>
+#include <gsl/span>
 
 class TList;
 
@@ -43,6 +45,10 @@ namespace o2::framework
 template <typename T>
 concept FillValue = std::is_integral_v<T> || std::is_floating_point_v<T> || std::is_enum_v<T>;
 
+// table columns of which the values can be read directly from the arrow arrays for the bulk filling
+template <typename C>
+concept BulkFillColumn = o2::soa::is_persistent_column<C> && std::is_arithmetic_v<typename C::type> && !std::is_same_v<typename C::type, bool>;
+
 struct HistFiller {
   // fill any type of histogram (if weight was requested it must be the last argument)
   template <typename T, typename... Ts>
@@ -53,11 +59,26 @@ struct HistFiller {
   template <typename... Cs, typename R, typename T>
   static void fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill any type of histogram with columns of values at once, e.g. the values of arrow arrays (if weight was requested it must be the last column, for StepTHn the first column holds the steps)
+  template <typename T, typename... Ts>
+  static void fillHistAnyColumns(std::shared_ptr<T> hist, gsl::span<const Ts>... positionAndWeight)
+    requires(FillValue<Ts> && ...);
+
   // function that returns rough estimate for the size of a histogram in MB
   template <typename T>
   static double getSize(std::shared_ptr<T> hist, double fillFraction = 1.);
 
  private:
+  // number of entries of which the bins are computed at once in the bulk filling
+  static constexpr size_t BulkFillBlockSize = 1024;
+
+  // bulk filling of at most BulkFillBlockSize entries into TH1, TH2 or TH3 with regular axes, returns false if the histogram must be filled entry by entry
+  static bool fillRegularAxes(TH1* hist, int nDimensions, size_t nEntries, const double* const positions[], const double* weights);
+
+  // gathers the selected rows of an arrow column
+  template <typename V>
+  static std::vector<V> gatherColumn(const arrow::ChunkedArray* column, const o2::soa::SelectionVector& rows);
+
   // helper function to determine base element size of histograms (in bytes)
   template <typename T>
   static int getBaseElementSize(T* ptr);
@@ -141,6 +162,11 @@ class HistogramRegistry
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill hist with columns of values at once, e.g. the values of arrow arrays
+  template <typename... Ts>
+  void fillColumns(const HistName& histName, gsl::span<const Ts>... positionAndWeight)
+    requires(FillValue<Ts> && ...);
+
   // get rough estimate for size of histogram stored in registry
   double getSize(const HistName& histName, double fillFraction = 1.);
 
@@ -244,17 +270,102 @@ void HistFiller::fillHistAny(std::shared_ptr<T> hist, Ts... positionAndWeight)
 template <typename... Cs, typename R, typename T>
 void HistFiller::fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  if constexpr (std::is_base_of_v<StepTHn, T>) {
-    LOGF(fatal, "Table filling is not (yet?) supported for StepTHn.");
-    return;
-  }
   auto s = o2::framework::expressions::createSelection(table.asArrowTable(), filter);
-  auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, s};
-  for (auto& t : filtered) {
-    fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+  if constexpr ((BulkFillColumn<Cs> && ...)) {
+    // numeric columns are gathered from the arrow arrays and filled at once
+    auto rows = o2::soa::selectionToVector(s);
+    auto arrowTable = table.asArrowTable();
+    fillHistAnyColumns(hist, gsl::span<const typename Cs::type>(gatherColumn<typename Cs::type>(o2::soa::getIndexFromLabel(arrowTable.get(), Cs::columnLabel()), rows))...);
+  } else {
+    if constexpr (std::is_base_of_v<StepTHn, R>) {
+      LOGF(fatal, "Table filling of StepTHn is supported only for numeric persistent columns.");
+      return;
+    }
+    auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, s};
+    for (auto& t : filtered) {
+      fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+    }
   }
 }
 
+template <typename T, typename... Ts>
+void HistFiller::fillHistAnyColumns(std::shared_ptr<T> hist, gsl::span<const Ts>... positionAndWeight)
+  requires(FillValue<Ts> && ...)
+{
+  constexpr int nArgs = sizeof...(Ts);
+  const size_t nEntries = std::min({positionAndWeight.size()...});
+  if (((positionAndWeight.size() != nEntries) || ...)) {
+    LOGF(fatal, "The columns given to fill histogram %s have different lengths.", hist->GetName());
+  }
+
+  constexpr bool validTH3 = (std::is_same_v<TH3, T> && (nArgs == 3 || nArgs == 4));
+  constexpr bool validTH2 = (std::is_same_v<TH2, T> && (nArgs == 2 || nArgs == 3));
+  constexpr bool validTH1 = (std::is_same_v<TH1, T> && (nArgs == 1 || nArgs == 2));
+  constexpr bool validComplexFillStep = std::is_base_of_v<StepTHn, T>;
+
+  if constexpr (validTH1 || validTH2 || validTH3 || validComplexFillStep) {
+    // the columns are converted block by block to double, the bins of a block are then computed at once
+    std::vector<double> buffer(nArgs * BulkFillBlockSize);
+    std::array<const double*, nArgs> columns;
+    for (int i = 0; i < nArgs; i++) {
+      columns[i] = buffer.data() + i * BulkFillBlockSize;
+    }
+    for (size_t begin = 0; begin < nEntries; begin += BulkFillBlockSize) {
+      const size_t n = std::min(BulkFillBlockSize, nEntries - begin);
+      double* target = buffer.data();
+      ((std::transform(positionAndWeight.begin() + begin, positionAndWeight.begin() + begin + n, target, [](Ts value) { return static_cast<double>(value); }), target += BulkFillBlockSize), ...);
+
+      if constexpr (validComplexFillStep) {
+        // the first column holds the steps, consecutive entries of the same step are filled at once
+        std::array<const double*, nArgs - 1> values;
+        for (size_t first = 0, last = 1; first < n; first = last++) {
+          while (last < n && columns[0][last] == columns[0][first]) {
+            last++;
+          }
+          for (int i = 1; i < nArgs; i++) {
+            values[i - 1] = columns[i] + first;
+          }
+          hist->FillColumns(static_cast<int>(columns[0][first]), nArgs - 1, values.data(), last - first);
+        }
+      } else {
+        constexpr int nDimensions = validTH3 ? 3 : (validTH2 ? 2 : 1);
+        if (!fillRegularAxes(hist.get(), nDimensions, n, columns.data(), nArgs > nDimensions ? columns[nDimensions] : nullptr)) {
+          // irregular axes (or profiles) are filled entry by entry
+          for (size_t i = begin; i < nEntries; i++) {
+            fillHistAny(hist, positionAndWeight[i]...);
+          }
+          return;
+        }
+      }
+    }
+  } else {
+    for (size_t i = 0; i < nEntries; i++) {
+      fillHistAny(hist, positionAndWeight[i]...);
+    }
+  }
+}
+
+template <typename V>
+std::vector<V> HistFiller::gatherColumn(const arrow::ChunkedArray* column, const o2::soa::SelectionVector& rows)
+{
+  // the selected rows are in increasing order, so that the chunks are visited once
+  std::vector<V> values(rows.size());
+  const V* chunkValues = nullptr;
+  int64_t chunkBegin = 0;
+  int64_t chunkEnd = 0;
+  int chunk = 0;
+  for (size_t i = 0; i < rows.size(); i++) {
+    while (rows[i] >= chunkEnd) {
+      auto array = std::static_pointer_cast<o2::soa::arrow_array_for_t<V>>(column->chunk(chunk++));
+      chunkValues = array->raw_values();
+      chunkBegin = chunkEnd;
+      chunkEnd += array->length();
+    }
+    values[i] = chunkValues[rows[i] - chunkBegin];
+  }
+  return values;
+}
+
 template <typename T>
 double HistFiller::getSize(std::shared_ptr<T> hist, double fillFraction)
 {
@@ -443,5 +554,12 @@ void HistogramRegistry::fill(const HistName& histName, const T& table, const o2:
   std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
 }
 
+template <typename... Ts>
+void HistogramRegistry::fillColumns(const HistName& histName, gsl::span<const Ts>... positionAndWeight)
+  requires(FillValue<Ts> && ...)
+{
+  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAnyColumns(hist, positionAndWeight...); }, mRegistryValue[getHistIndex(histName)]);
+}
+
 } // namespace o2::framework
 #endif // FRAMEWORK_HISTOGRAMREGISTRY_H_
@@ -20,6 +20,7 @@
 #include "Framework/RuntimeError.h"
 #include "Framework/Logger.h"
 #include "Framework/ObjectCache.h"
+#include "Framework/SharedConditionCache.h"
 #include "Framework/CallbackService.h"
 
 #include "Headers/DataHeader.h"
@@ -412,7 +413,7 @@ class InputRecord
         auto cacheEntry = cache.matcherToId.find(path);
         if (cacheEntry == cache.matcherToId.end()) {
           cache.matcherToId.insert(std::make_pair(path, id));
-          std::unique_ptr<ValueT const, Deleter<ValueT const>> result(DataRefUtils::as<CCDBSerialized<ValueT>>(ref).release(), false);
+          std::unique_ptr<ValueT const, Deleter<ValueT const>> result(deserialiseCondition<ValueT>(ref), false);
           void* obj = (void*)result.get();
           callbacks.call<CallbackService::Id::CCDBDeserialised>((ConcreteDataMatcher&)matcher, (void*)obj);
           cache.idToObject[id] = obj;
@@ -428,8 +429,10 @@ class InputRecord
         }
         // The id in the cache is different. Let's destroy the old cached entry
         // and create a new one.
-        delete reinterpret_cast<ValueT*>(cache.idToObject[oldId]);
-        std::unique_ptr<ValueT const, Deleter<ValueT const>> result(DataRefUtils::as<CCDBSerialized<ValueT>>(ref).release(), false);
+        if (!SharedConditionCache::instance().release(cache.idToObject[oldId])) {
+          delete reinterpret_cast<ValueT*>(cache.idToObject[oldId]);
+        }
+        std::unique_ptr<ValueT const, Deleter<ValueT const>> result(deserialiseCondition<ValueT>(ref), false);
         void* obj = (void*)result.get();
         callbacks.call<CallbackService::Id::CCDBDeserialised>((ConcreteDataMatcher&)matcher, (void*)obj);
         cache.idToObject[id] = obj;
@@ -718,6 +721,20 @@ class InputRecord
   // Produce a string describing the available inputs.
   [[nodiscard]] std::string describeAvailableInputs() const;
 
+  // Deserialise a CCDB object, via the node-wide shared memory copy for the flat objects, if enabled.
+  template <typename T>
+  static T* deserialiseCondition(DataRef const& ref)
+  {
+    if constexpr (SharedCondition<T>) {
+      auto& shared = SharedConditionCache::instance();
+      if (shared.isEnabled()) {
+        auto headers = DataRefUtils::extractCCDBHeaders(ref);
+        return shared.get<T>(headers["ETag"], [&ref]() { return DataRefUtils::as<CCDBSerialized<T>>(ref); });
+      }
+    }
+    return DataRefUtils::as<CCDBSerialized<T>>(ref).release();
+  }
+
   ServiceRegistryRef mRegistry;
   std::vector<InputRoute> const& mInputsSchema;
   InputSpan& mSpan;
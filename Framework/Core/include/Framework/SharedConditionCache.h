@@ -0,0 +1,129 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_SHAREDCONDITIONCACHE_H_
+#define O2_FRAMEWORK_SHAREDCONDITIONCACHE_H_
+
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace o2::framework
+{
+
+/// Condition objects made of a class with no virtual methods and a single flat buffer
+/// which can be relocated, like the FlatObject derived MatLayerCylSet or TPCFastTransform.
+template <typename T>
+concept SharedCondition = !std::is_polymorphic_v<T> && requires(T& t, char* ptr) {
+  { t.getFlatBufferSize() } -> std::convertible_to<size_t>;
+  { t.getFlatBufferPtr() } -> std::convertible_to<const char*>;
+  t.setActualBufferAddress(ptr);
+  t.clearInternalBufferPtr();
+  t.adoptInternalBuffer(ptr);
+  { t.releaseInternalBuffer() } -> std::same_as<char*>;
+};
+
+/// Opt-in (DPL_SHARED_CONDITIONS=1) cache of deserialised flat condition objects, shared by all
+/// the processes of the node. The first process which needs a given object (identified by its CCDB ETag)
+/// deserialises it and copies it to a named shared memory segment. All the processes, including
+/// the creator, map the segment copy-on-write and relocate the pointers of the object to their own
+/// mapping: only the few pages holding those pointers become private, the bulk of the flat buffer
+/// is shared. The segment is removed when the last process using it releases it, or re-created
+/// by another process if its creator died before completing it.
+class SharedConditionCache
+{
+ public:
+  SharedConditionCache();
+  ~SharedConditionCache();
+  SharedConditionCache(const SharedConditionCache&) = delete;
+  SharedConditionCache& operator=(const SharedConditionCache&) = delete;
+
+  static SharedConditionCache& instance();
+
+  bool isEnabled() const { return mEnabled; }
+  void setEnabled(bool enabled) { mEnabled = enabled; }
+
+  /// Get the object with the given ETag from the shared memory, using deserialise() to create
+  /// it if no other process did it already. Falls back to the privately deserialised object
+  /// if the shared memory cannot be used. The result must be freed with release().
+  template <SharedCondition T, typename F>
+  T* get(std::string const& etag, F&& deserialise)
+  {
+    std::unique_ptr<T> local;
+    const size_t bufferOffset = getBufferOffset(sizeof(T));
+    auto prepare = [&]() -> size_t {
+      local = deserialise();
+      if (local) {
+        relocateStreamedBuffer(*local);
+      }
+      return local ? bufferOffset + local->getFlatBufferSize() : 0;
+    };
+    auto fill = [&](char* payload) {
+      auto* obj = reinterpret_cast<T*>(payload);
+      std::memcpy((void*)obj, (const void*)local.get(), sizeof(T));
+      obj->clearInternalBufferPtr(); // the buffer stays owned by the local object
+      std::memcpy(payload + bufferOffset, local->getFlatBufferPtr(), local->getFlatBufferSize());
+      obj->setActualBufferAddress(payload + bufferOffset);
+    };
+    char* payload = etag.empty() ? nullptr : acquire(getSegmentName(etag, typeid(T)), prepare, fill);
+    if (!payload) {
+      return local ? local.release() : deserialise().release();
+    }
+    // The object still points to the mapping of the creator. The container is set to the shared buffer
+    // (which the object never frees, as it is released via release()), so that the users which rectify
+    // the pointers as after the reading from a file, e.g. TPCFastTransform::rectifyAfterReadingFromFile(), keep working.
+    auto* obj = reinterpret_cast<T*>(payload);
+    obj->clearInternalBufferPtr();
+    obj->setActualBufferAddress(payload + bufferOffset);
+    obj->adoptInternalBuffer(payload + bufferOffset);
+    return obj;
+  }
+
+  /// After the ROOT streaming only the (persistent) buffer container of a flat object is set: point the
+  /// (transient) buffer pointer and the pointers inside the buffer to it, as FlatObject::readFromFile() does.
+  template <SharedCondition T>
+  static void relocateStreamedBuffer(T& obj)
+  {
+    if (obj.getFlatBufferPtr() == nullptr && obj.getFlatBufferSize() > 0) {
+      char* container = obj.releaseInternalBuffer();
+      obj.setActualBufferAddress(container);
+      obj.adoptInternalBuffer(container);
+    }
+  }
+
+  /// Release an object obtained via get(). Returns false if the object is not in the shared memory,
+  /// in which case it is up to the caller to delete it.
+  bool release(void const* object);
+
+  static std::string getSegmentName(std::string const& etag, std::type_info const& type);
+
+ private:
+  struct Segment;
+
+  static constexpr size_t getBufferOffset(size_t objectSize) { return (objectSize + 63) / 64 * 64; }
+
+  /// Map the payload of the segment copy-on-write. If the segment does not exist, or its creator died
+  /// before completing it, create it with the size returned by prepare() and fill it via fill().
+  /// Returns nullptr if the segment cannot be used.
+  char* acquire(std::string const& name, std::function<size_t()> const& prepare, std::function<void(char*)> const& fill);
+
+  bool mEnabled = false;
+  int mWaitTimeoutMS = 60000;
+  std::unordered_map<void const*, std::unique_ptr<Segment>> mSegments;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_SHAREDCONDITIONCACHE_H_
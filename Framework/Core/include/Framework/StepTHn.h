@@ -37,6 +37,8 @@ class StepTHn : public TNamed
   template <typename... Ts>
   void Fill(int iStep, const Ts&... valuesAndWeight);
   void Fill(int iStep, int nParams, double positionAndWeight[]);
+  // fills the entries given as columns of values (and of weights, if one more column than variables is given) at once
+  void FillColumns(int iStep, int nColumns, const double* const columns[], Long64_t nEntries);
 
   THnBase* getTHn(Int_t step, Bool_t sparse = kFALSE)
   {
@@ -65,6 +67,7 @@ class StepTHn : public TNamed
   virtual TArray* createArray(const TArray* src = nullptr) const = 0;
   void createTarget(Int_t step, Bool_t sparse);
   void deleteContainers();
+  void createAxisCache(const double* initialValues);
 
   Long64_t getGlobalBinIndex(const Int_t* binIdx);
 
@@ -18,6 +18,7 @@
 #include "TTreeReaderArray.h"
 #include "TableBuilder.h"
 #include <arrow/dataset/file_base.h>
+#include <functional>
 #include <memory>
 
 // =============================================================================
@@ -33,6 +34,8 @@ namespace o2::framework
 //  . t2t.addBranches();
 //    OR t2t.addBranch(column.get(), field.get()), ...;
 //  . t2t.process();
+//    OR t2t.process(runTasks), to fill the branches of the different columns
+//    concurrently with the tasks runner of the caller
 //
 // .............................................................................
 // -----------------------------------------------------------------------------
@@ -86,9 +89,14 @@ class ColumnToBranch
   ColumnToBranch(ColumnToBranch const& other) = delete;
   ColumnToBranch(ColumnToBranch&& other) = delete;
   void at(const int64_t* pos);
+  /// fill the branch (and its size branch) with the first rows entries of the column
+  void fill(int64_t rows);
   [[nodiscard]] int fieldSize() const { return mFieldSize; }
   [[nodiscard]] int columnEntries() const { return mColumn->length(); }
+  /// bytes taken by the whole column in a basket, including the entry offsets of variable size arrays
+  [[nodiscard]] int64_t columnBytes() const;
   [[nodiscard]] char const* branchName() const { return mBranchName.c_str(); }
+  [[nodiscard]] bool hasSizeBranch() const { return mSizeBranch != nullptr; }
 
  private:
   void accessChunk();
@@ -112,9 +120,15 @@ class ColumnToBranch
 class TableToTree
 {
  public:
+  /// runs all the given tasks, possibly concurrently, and returns when they are done
+  using TaskRunner = std::function<void(std::vector<std::function<void()>> const&)>;
+
   TableToTree(std::shared_ptr<arrow::Table> const& table, TFile* file, const char* treename);
 
-  std::shared_ptr<TTree> process();
+  /// fill the tree and write it to the file. When runTasks is given and the tree is new,
+  /// the branches of each column are filled by a separate task, with baskets holding the
+  /// whole column such that no task writes to the file
+  std::shared_ptr<TTree> process(TaskRunner const& runTasks = {});
   void addBranch(std::shared_ptr<arrow::ChunkedArray> const& column, std::shared_ptr<arrow::Field> const& field);
   void addAllBranches();
 
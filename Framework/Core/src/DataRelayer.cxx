@@ -47,7 +47,9 @@
 #include <fmt/ostream.h>
 #include <gsl/span>
 #include <numeric>
+#include <optional>
 #include <string>
+#include <thread>
 
 using namespace o2::framework::data_matcher;
 using DataHeader = o2::header::DataHeader;
@@ -156,6 +158,10 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
     if (mTimesliceIndex.isValid(slot) == false) {
       continue;
     }
+    // A slot some relay is storing messages in is looked at the next time.
+    if (!tryCloseSlot(slot)) {
+      continue;
+    }
     assert(mDistinctRoutesIndex.empty() == false);
     auto& variables = mTimesliceIndex.getVariablesForSlot(slot);
     auto timestamp = VariableContextHelpers::getTimeslice(variables);
@@ -226,6 +232,7 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
       assert(part.header(0) != nullptr);
       assert(part.payload(0) != nullptr);
     }
+    reopenSlot(slot, false);
   }
   LOGP(debug, "DataRelayer::processDanglingInputs headerPresent:{}, payloadPresent:{}, noCheckers:{}, badSlot:{}, checkerDenied:{}",
        headerPresent, payloadPresent, noCheckers, badSlot, checkerDenied);
@@ -283,6 +290,7 @@ void sendVariableContextMetrics(VariableContext& context, TimesliceSlot slot, Da
 
 void DataRelayer::setOldestPossibleInput(TimesliceId proposed, ChannelIndex channel)
 {
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
   auto newOldest = mTimesliceIndex.setOldestPossibleInput(proposed, channel);
   LOGP(debug, "DataRelayer::setOldestPossibleInput {} from channel {}", newOldest.timeslice.value, newOldest.channel.value);
   static bool dontDrop = getenv("DPL_DONT_DROP_OLD_TIMESLICE") && atoi(getenv("DPL_DONT_DROP_OLD_TIMESLICE"));
@@ -300,6 +308,10 @@ void DataRelayer::setOldestPossibleInput(TimesliceId proposed, ChannelIndex chan
       continue;
     }
     mPruneOps.push_back(PruneOp{si});
+    // The slot is pruned later on, we only report what is dropped if no relay is storing messages in it.
+    if (!tryCloseSlot({si})) {
+      continue;
+    }
     bool didDrop = false;
     for (size_t mi = 0; mi < mInputs.size(); ++mi) {
       auto& input = mInputs[mi];
@@ -340,6 +352,7 @@ void DataRelayer::setOldestPossibleInput(TimesliceId proposed, ChannelIndex chan
         }
       }
     }
+    reopenSlot({si}, false);
   }
 }
 
@@ -350,13 +363,29 @@ TimesliceIndex::OldestOutputInfo DataRelayer::getOldestPossibleOutput() const
 
 void DataRelayer::prunePending(OnDropCallback onDrop)
 {
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  // Slots which are being written or consumed are pruned the next time.
+  std::vector<PruneOp> busy;
   for (auto& op : mPruneOps) {
-    this->pruneCache(op.slot, onDrop);
+    if (!tryCloseSlot(op.slot)) {
+      busy.push_back(op);
+      continue;
+    }
+    pruneSlot(op.slot, onDrop);
+    reopenSlot(op.slot, true);
   }
-  mPruneOps.clear();
+  mPruneOps.swap(busy);
 }
 
 void DataRelayer::pruneCache(TimesliceSlot slot, OnDropCallback onDrop)
+{
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  closeSlot(lock, slot);
+  pruneSlot(slot, onDrop);
+  reopenSlot(slot, true);
+}
+
+void DataRelayer::pruneSlot(TimesliceSlot slot, OnDropCallback const& onDrop)
 {
   // We need to prune the cache from the old stuff, if any. Otherwise we
   // simply store the payload in the cache and we mark relevant bit in the
@@ -402,6 +431,117 @@ void DataRelayer::pruneCache(TimesliceSlot slot, OnDropCallback onDrop)
   pruneCache(slot);
 }
 
+uint32_t DataRelayer::slotSequence(TimesliceSlot slot) const
+{
+  return mSlotStates[slot.index].load(std::memory_order_acquire) >> SlotSequenceShift;
+}
+
+bool DataRelayer::reserveSlot(TimesliceSlot slot, uint32_t sequence)
+{
+  auto& state = mSlotStates[slot.index];
+  auto current = state.load(std::memory_order_acquire);
+  do {
+    if ((current >> SlotSequenceShift) != sequence || (current & SlotClosedBit) != 0) {
+      return false;
+    }
+  } while (!state.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel, std::memory_order_acquire));
+  return true;
+}
+
+void DataRelayer::publishSlot(TimesliceSlot slot)
+{
+  auto& state = mSlotStates[slot.index];
+  if ((state.fetch_or(SlotQueuedBit, std::memory_order_acq_rel) & SlotQueuedBit) == 0) {
+    auto pos = mReadyQueueTail.fetch_add(1, std::memory_order_relaxed);
+    mReadyQueue[pos % mReadyQueueCapacity].store(slot.index + 1, std::memory_order_release);
+  }
+  state.fetch_sub(1, std::memory_order_release);
+}
+
+bool DataRelayer::tryCloseSlot(TimesliceSlot slot)
+{
+  if (!mSlotStates) {
+    return true;
+  }
+  auto& state = mSlotStates[slot.index];
+  auto current = state.load(std::memory_order_acquire);
+  do {
+    if ((current & (SlotClosedBit | SlotWritersMask)) != 0) {
+      return false;
+    }
+  } while (!state.compare_exchange_weak(current, current | SlotClosedBit, std::memory_order_acq_rel, std::memory_order_acquire));
+  return true;
+}
+
+void DataRelayer::closeSlot(std::unique_lock<O2_LOCKABLE(std::recursive_mutex)>& lock, TimesliceSlot slot)
+{
+  if (!mSlotStates) {
+    return;
+  }
+  auto& state = mSlotStates[slot.index];
+  // Once the slot is ours no writer can get in, so we only wait for the ones
+  // already storing their messages. We never wait with the lock held.
+  while ((state.fetch_or(SlotClosedBit, std::memory_order_acq_rel) & SlotClosedBit) != 0) {
+    lock.unlock();
+    std::this_thread::yield();
+    lock.lock();
+  }
+  while ((state.load(std::memory_order_acquire) & SlotWritersMask) != 0) {
+    lock.unlock();
+    std::this_thread::yield();
+    lock.lock();
+  }
+}
+
+void DataRelayer::closeAllSlots(std::unique_lock<O2_LOCKABLE(std::recursive_mutex)>& lock)
+{
+  for (size_t si = 0; si < mReadyQueueCapacity; ++si) {
+    closeSlot(lock, {si});
+  }
+}
+
+void DataRelayer::reopenSlot(TimesliceSlot slot, bool recycled)
+{
+  if (!mSlotStates) {
+    return;
+  }
+  auto& state = mSlotStates[slot.index];
+  if (recycled) {
+    state.fetch_add(uint64_t{1} << SlotSequenceShift, std::memory_order_relaxed);
+  }
+  state.fetch_and(~SlotClosedBit, std::memory_order_release);
+}
+
+void DataRelayer::reopenAllSlots(bool recycled)
+{
+  for (size_t si = 0; si < mReadyQueueCapacity; ++si) {
+    reopenSlot({si}, recycled);
+  }
+}
+
+void DataRelayer::drainReadyQueue()
+{
+  if (!mReadyQueue) {
+    return;
+  }
+  // An entry is reserved before it is written, so we stop at the first one not
+  // yet written and pick up the rest next time.
+  while (true) {
+    auto& entry = mReadyQueue[mReadyQueueHead % mReadyQueueCapacity];
+    auto value = entry.load(std::memory_order_acquire);
+    if (value == 0) {
+      break;
+    }
+    entry.store(0, std::memory_order_relaxed);
+    mReadyQueueHead++;
+    TimesliceSlot slot{value - 1};
+    mSlotStates[slot.index].fetch_and(~SlotQueuedBit, std::memory_order_acq_rel);
+    if (slot.index < mTimesliceIndex.size()) {
+      mTimesliceIndex.markAsDirty(slot, true);
+    }
+  }
+}
+
 bool isCalibrationData(std::unique_ptr<fair::mq::Message>& first)
 {
   auto* dh = o2::header::get<DataHeader*>(first->GetData());
@@ -416,7 +556,7 @@ DataRelayer::RelayChoice
                      size_t nPayloads,
                      std::function<void(TimesliceSlot, std::vector<MessageSet>&, TimesliceIndex::OldestOutputInfo)> onDrop)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
   DataProcessingHeader const* dph = o2::header::get<DataProcessingHeader*>(rawHeader);
   // IMPLEMENTATION DETAILS
   //
@@ -455,11 +595,27 @@ DataRelayer::RelayChoice
     };
   };
 
+  // We are in calibration mode and the data does not have the calibration bit set.
+  // We do not store it.
+  auto isSkipped = [&messages, &services = mContext](size_t mi) {
+    return services.get<DeviceState>().allowedProcessing == DeviceState::ProcessingType::CalibrationOnly && !isCalibrationData(messages[mi]);
+  };
+
+  // How many payloads saveInSlot will store
+  auto countSavable = [&isSkipped, &nMessages, &nPayloads]() -> size_t {
+    size_t savable = 0;
+    for (size_t mi = 0; mi < nMessages; mi += nPayloads + 1) {
+      savable += isSkipped(mi) ? 0 : nPayloads;
+    }
+    return savable;
+  };
+
   // Actually save the header / payload in the slot
-  auto saveInSlot = [&cachedStateMetrics = mCachedStateMetrics,
+  auto saveInSlot = [&entryBusy = mEntryBusy,
                      &messages,
                      &nMessages,
                      &nPayloads,
+                     &isSkipped,
                      &cache = mCache,
                      &services = mContext,
                      numInputTypes = mDistinctRoutesIndex.size()](TimesliceId timeslice, int input, TimesliceSlot slot, InputInfo const& info) -> size_t {
@@ -470,16 +626,16 @@ DataRelayer::RelayChoice
                            info.index.value == ChannelIndex::INVALID ? "invalid" : services.get<FairMQDeviceProxy>().getInputChannel(info.index)->GetName().c_str());
     auto cacheIdx = numInputTypes * slot.index + input;
     MessageSet& target = cache[cacheIdx];
-    cachedStateMetrics[cacheIdx] = CacheEntryStatus::PENDING;
     // TODO: make sure that multiple parts can only be added within the same call of
     // DataRelayer::relay
     assert(nPayloads > 0);
+    while (entryBusy[cacheIdx].test_and_set(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
     size_t saved = 0;
     for (size_t mi = 0; mi < nMessages; ++mi) {
       assert(mi + nPayloads < nMessages);
-      // We are in calibration mode and the data does not have the calibration bit set.
-      // We do not store it.
-      if (services.get<DeviceState>().allowedProcessing == DeviceState::ProcessingType::CalibrationOnly && !isCalibrationData(messages[mi])) {
+      if (isSkipped(mi)) {
         mi += nPayloads;
         continue;
       }
@@ -487,6 +643,7 @@ DataRelayer::RelayChoice
       mi += nPayloads;
       saved += nPayloads;
     }
+    entryBusy[cacheIdx].clear(std::memory_order_release);
     return saved;
   };
 
@@ -523,149 +680,194 @@ DataRelayer::RelayChoice
   auto slot = TimesliceSlot{TimesliceSlot::INVALID};
   auto& index = mTimesliceIndex;
 
-  bool needsCleaning = false;
-  // First look for matching slots which already have some
-  // partial match.
-  for (size_t ci = 0; ci < index.size(); ++ci) {
-    slot = TimesliceSlot{ci};
-    if (!isSlotInLane(slot)) {
-      continue;
-    }
-    if (index.isValid(slot) == false) {
-      continue;
+  // The slot is chosen while holding the lock, the messages are then stored
+  // without it, after reserving the slot with the sequence number we read
+  // under the lock. If the slot was closed or recycled in the meantime, the
+  // reservation fails and we start over. The slot is marked as dirty by the
+  // next getReadyToProcess.
+  auto storeInSlot = [&](TimesliceId timeslice, int input, TimesliceSlot slot) -> std::optional<size_t> {
+    mCachedStateMetrics[mDistinctRoutesIndex.size() * slot.index + input] = CacheEntryStatus::PENDING;
+    size_t savable = countSavable();
+    if (savable == 0) {
+      return 0;
     }
-    std::tie(input, timeslice) = getInputTimeslice(index.getVariablesForSlot(slot));
-    if (input != INVALID_INPUT) {
-      break;
+    index.publishSlot(slot);
+    auto sequence = slotSequence(slot);
+    lock.unlock();
+    if (!reserveSlot(slot, sequence)) {
+      std::this_thread::yield();
+      return std::nullopt;
     }
-  }
+    saveInSlot(timeslice, input, slot, info);
+    publishSlot(slot);
+    return savable;
+  };
 
-  // If we did not find anything, look for slots which
-  // are invalid.
-  if (input == INVALID_INPUT) {
+  while (true) {
+    if (!lock.owns_lock()) {
+      lock.lock();
+    }
+    input = INVALID_INPUT;
+    timeslice = TimesliceId{TimesliceId::INVALID};
+    slot = TimesliceSlot{TimesliceSlot::INVALID};
+    bool needsCleaning = false;
+    // First look for matching slots which already have some
+    // partial match.
     for (size_t ci = 0; ci < index.size(); ++ci) {
       slot = TimesliceSlot{ci};
-      if (index.isValid(slot) == true) {
+      if (!isSlotInLane(slot)) {
         continue;
       }
-      if (!isSlotInLane(slot)) {
+      if (index.isValid(slot) == false) {
         continue;
       }
       std::tie(input, timeslice) = getInputTimeslice(index.getVariablesForSlot(slot));
       if (input != INVALID_INPUT) {
-        needsCleaning = true;
         break;
       }
     }
-  }
 
-  auto& stats = mContext.get<DataProcessingStats>();
-  /// If we get a valid result, we can store the message in cache.
-  if (input != INVALID_INPUT && TimesliceId::isValid(timeslice) && TimesliceSlot::isValid(slot)) {
-    if (needsCleaning) {
-      this->pruneCache(slot, onDrop);
-      mPruneOps.erase(std::remove_if(mPruneOps.begin(), mPruneOps.end(), [slot](const auto& x) { return x.slot == slot; }), mPruneOps.end());
-    }
-    size_t saved = saveInSlot(timeslice, input, slot, info);
-    if (saved == 0) {
-      return RelayChoice{.type = RelayChoice::Type::Dropped, .timeslice = timeslice};
+    // If we did not find anything, look for slots which
+    // are invalid.
+    if (input == INVALID_INPUT) {
+      for (size_t ci = 0; ci < index.size(); ++ci) {
+        slot = TimesliceSlot{ci};
+        if (index.isValid(slot) == true) {
+          continue;
+        }
+        if (!isSlotInLane(slot)) {
+          continue;
+        }
+        std::tie(input, timeslice) = getInputTimeslice(index.getVariablesForSlot(slot));
+        if (input != INVALID_INPUT) {
+          needsCleaning = true;
+          break;
+        }
+      }
     }
-    index.publishSlot(slot);
-    index.markAsDirty(slot, true);
-    stats.updateStats({static_cast<short>(ProcessingStatsId::RELAYED_MESSAGES), DataProcessingStats::Op::Add, (int)1});
-    return RelayChoice{.type = RelayChoice::Type::WillRelay, .timeslice = timeslice};
-  }
 
-  /// If not, we find which timeslice we really were looking at
-  /// and see if we can prune something from the cache.
-  VariableContext pristineContext;
-  std::tie(input, timeslice) = getInputTimeslice(pristineContext);
-
-  auto DataHeaderInfo = [&rawHeader]() {
-    std::string error;
-    // extract header from message model
-    const auto* dh = o2::header::get<o2::header::DataHeader*>(rawHeader);
-    if (dh) {
-      error += fmt::format("{}/{}/{}", dh->dataOrigin, dh->dataDescription, dh->subSpecification);
-    } else {
-      error += "invalid header";
+    auto& stats = mContext.get<DataProcessingStats>();
+    /// If we get a valid result, we can store the message in cache.
+    if (input != INVALID_INPUT && TimesliceId::isValid(timeslice) && TimesliceSlot::isValid(slot)) {
+      if (needsCleaning) {
+        // Nothing changed yet, so if the slot is busy we look again once it is not.
+        if (!tryCloseSlot(slot)) {
+          lock.unlock();
+          std::this_thread::yield();
+          continue;
+        }
+        pruneSlot(slot, onDrop);
+        reopenSlot(slot, true);
+        mPruneOps.erase(std::remove_if(mPruneOps.begin(), mPruneOps.end(), [slot](const auto& x) { return x.slot == slot; }), mPruneOps.end());
+      }
+      auto saved = storeInSlot(timeslice, input, slot);
+      if (!saved) {
+        continue;
+      }
+      if (*saved == 0) {
+        return RelayChoice{.type = RelayChoice::Type::Dropped, .timeslice = timeslice};
+      }
+      stats.updateStats({static_cast<short>(ProcessingStatsId::RELAYED_MESSAGES), DataProcessingStats::Op::Add, (int)1});
+      return RelayChoice{.type = RelayChoice::Type::WillRelay, .timeslice = timeslice};
     }
-    return error;
-  };
 
-  if (input == INVALID_INPUT) {
-    LOG(error) << "Could not match incoming data to any input route: " << DataHeaderInfo();
-    stats.updateStats({static_cast<short>(ProcessingStatsId::MALFORMED_INPUTS), DataProcessingStats::Op::Add, (int)1});
-    stats.updateStats({static_cast<short>(ProcessingStatsId::DROPPED_INCOMING_MESSAGES), DataProcessingStats::Op::Add, (int)1});
-    for (size_t pi = 0; pi < nMessages; ++pi) {
-      messages[pi].reset(nullptr);
-    }
-    return RelayChoice{.type = RelayChoice::Type::Invalid, .timeslice = timeslice};
-  }
+    /// If not, we find which timeslice we really were looking at
+    /// and see if we can prune something from the cache.
+    VariableContext pristineContext;
+    std::tie(input, timeslice) = getInputTimeslice(pristineContext);
+
+    auto DataHeaderInfo = [&rawHeader]() {
+      std::string error;
+      // extract header from message model
+      const auto* dh = o2::header::get<o2::header::DataHeader*>(rawHeader);
+      if (dh) {
+        error += fmt::format("{}/{}/{}", dh->dataOrigin, dh->dataDescription, dh->subSpecification);
+      } else {
+        error += "invalid header";
+      }
+      return error;
+    };
 
-  if (TimesliceId::isValid(timeslice) == false) {
-    LOG(error) << "Could not determine the timeslice for input: " << DataHeaderInfo();
-    stats.updateStats({static_cast<short>(ProcessingStatsId::MALFORMED_INPUTS), DataProcessingStats::Op::Add, (int)1});
-    stats.updateStats({static_cast<short>(ProcessingStatsId::DROPPED_INCOMING_MESSAGES), DataProcessingStats::Op::Add, (int)1});
-    for (size_t pi = 0; pi < nMessages; ++pi) {
-      messages[pi].reset(nullptr);
+    if (input == INVALID_INPUT) {
+      LOG(error) << "Could not match incoming data to any input route: " << DataHeaderInfo();
+      stats.updateStats({static_cast<short>(ProcessingStatsId::MALFORMED_INPUTS), DataProcessingStats::Op::Add, (int)1});
+      stats.updateStats({static_cast<short>(ProcessingStatsId::DROPPED_INCOMING_MESSAGES), DataProcessingStats::Op::Add, (int)1});
+      for (size_t pi = 0; pi < nMessages; ++pi) {
+        messages[pi].reset(nullptr);
+      }
+      return RelayChoice{.type = RelayChoice::Type::Invalid, .timeslice = timeslice};
     }
-    return RelayChoice{.type = RelayChoice::Type::Invalid, .timeslice = timeslice};
-  }
 
-  O2_SIGNPOST_ID_GENERATE(aid, data_relayer);
-  TimesliceIndex::ActionTaken action;
-  std::tie(action, slot) = index.replaceLRUWith(pristineContext, timeslice);
-  uint64_t const* debugTimestamp = std::get_if<uint64_t>(&pristineContext.get(0));
-  if (action != TimesliceIndex::ActionTaken::Wait) {
-    O2_SIGNPOST_EVENT_EMIT(data_relayer, aid, "saveInSlot",
-                           "Slot %zu updated with %zu using action %d, %" PRIu64, slot.index, timeslice.value, (int)action, *debugTimestamp);
-  }
-
-  updateStatistics(action);
-
-  switch (action) {
-    case TimesliceIndex::ActionTaken::Wait:
-      return RelayChoice{.type = RelayChoice::Type::Backpressured, .timeslice = timeslice};
-    case TimesliceIndex::ActionTaken::DropObsolete:
-      static std::atomic<size_t> obsoleteCount = 0;
-      static std::atomic<size_t> mult = 1;
-      if ((obsoleteCount++ % (1 * mult)) == 0) {
-        LOGP(warning, "Over {} incoming messages are already obsolete, not relaying.", obsoleteCount.load());
-        if (obsoleteCount > mult * 10) {
-          mult = mult * 10;
-        }
-      }
-      return RelayChoice{.type = RelayChoice::Type::Dropped, .timeslice = timeslice};
-    case TimesliceIndex::ActionTaken::DropInvalid:
-      LOG(warning) << "Incoming data is invalid, not relaying.";
+    if (TimesliceId::isValid(timeslice) == false) {
+      LOG(error) << "Could not determine the timeslice for input: " << DataHeaderInfo();
       stats.updateStats({static_cast<short>(ProcessingStatsId::MALFORMED_INPUTS), DataProcessingStats::Op::Add, (int)1});
       stats.updateStats({static_cast<short>(ProcessingStatsId::DROPPED_INCOMING_MESSAGES), DataProcessingStats::Op::Add, (int)1});
       for (size_t pi = 0; pi < nMessages; ++pi) {
         messages[pi].reset(nullptr);
       }
       return RelayChoice{.type = RelayChoice::Type::Invalid, .timeslice = timeslice};
-    case TimesliceIndex::ActionTaken::ReplaceUnused:
-    case TimesliceIndex::ActionTaken::ReplaceObsolete:
-      // At this point the variables match the new input but the
-      // cache still holds the old data, so we prune it.
-      this->pruneCache(slot, onDrop);
-      mPruneOps.erase(std::remove_if(mPruneOps.begin(), mPruneOps.end(), [slot](const auto& x) { return x.slot == slot; }), mPruneOps.end());
-      size_t saved = saveInSlot(timeslice, input, slot, info);
-      if (saved == 0) {
+    }
+
+    O2_SIGNPOST_ID_GENERATE(aid, data_relayer);
+    TimesliceIndex::ActionTaken action;
+    std::tie(action, slot) = index.replaceLRUWith(pristineContext, timeslice);
+    uint64_t const* debugTimestamp = std::get_if<uint64_t>(&pristineContext.get(0));
+    if (action != TimesliceIndex::ActionTaken::Wait) {
+      O2_SIGNPOST_EVENT_EMIT(data_relayer, aid, "saveInSlot",
+                             "Slot %zu updated with %zu using action %d, %" PRIu64, slot.index, timeslice.value, (int)action, *debugTimestamp);
+    }
+
+    updateStatistics(action);
+
+    switch (action) {
+      case TimesliceIndex::ActionTaken::Wait:
+        return RelayChoice{.type = RelayChoice::Type::Backpressured, .timeslice = timeslice};
+      case TimesliceIndex::ActionTaken::DropObsolete:
+        static std::atomic<size_t> obsoleteCount = 0;
+        static std::atomic<size_t> mult = 1;
+        if ((obsoleteCount++ % (1 * mult)) == 0) {
+          LOGP(warning, "Over {} incoming messages are already obsolete, not relaying.", obsoleteCount.load());
+          if (obsoleteCount > mult * 10) {
+            mult = mult * 10;
+          }
+        }
         return RelayChoice{.type = RelayChoice::Type::Dropped, .timeslice = timeslice};
-      }
-      index.publishSlot(slot);
-      index.markAsDirty(slot, true);
-      return RelayChoice{.type = RelayChoice::Type::WillRelay};
+      case TimesliceIndex::ActionTaken::DropInvalid:
+        LOG(warning) << "Incoming data is invalid, not relaying.";
+        stats.updateStats({static_cast<short>(ProcessingStatsId::MALFORMED_INPUTS), DataProcessingStats::Op::Add, (int)1});
+        stats.updateStats({static_cast<short>(ProcessingStatsId::DROPPED_INCOMING_MESSAGES), DataProcessingStats::Op::Add, (int)1});
+        for (size_t pi = 0; pi < nMessages; ++pi) {
+          messages[pi].reset(nullptr);
+        }
+        return RelayChoice{.type = RelayChoice::Type::Invalid, .timeslice = timeslice};
+      case TimesliceIndex::ActionTaken::ReplaceUnused:
+      case TimesliceIndex::ActionTaken::ReplaceObsolete:
+        // At this point the variables match the new input but the
+        // cache still holds the old data, so we prune it. The slot is
+        // closed while we wait for the relays still storing in it, so
+        // nobody else stores in it before it is pruned.
+        closeSlot(lock, slot);
+        pruneSlot(slot, onDrop);
+        reopenSlot(slot, true);
+        mPruneOps.erase(std::remove_if(mPruneOps.begin(), mPruneOps.end(), [slot](const auto& x) { return x.slot == slot; }), mPruneOps.end());
+        auto saved = storeInSlot(timeslice, input, slot);
+        if (!saved) {
+          continue;
+        }
+        if (*saved == 0) {
+          return RelayChoice{.type = RelayChoice::Type::Dropped, .timeslice = timeslice};
+        }
+        return RelayChoice{.type = RelayChoice::Type::WillRelay};
+    }
+    O2_BUILTIN_UNREACHABLE();
   }
-  O2_BUILTIN_UNREACHABLE();
 }
 
 void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& completed)
 {
   LOGP(debug, "DataRelayer::getReadyToProcess");
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  drainReadyQueue();
 
   // THE STATE
   const auto& cache = mCache;
@@ -730,6 +932,11 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
     if (!mCompletionPolicy.callbackFull) {
       throw runtime_error_f("Completion police %s has no callback set", mCompletionPolicy.name.c_str());
     }
+    // Do not look at the slot while some relay is still storing messages in it.
+    // It stays dirty and we look at it again the next time.
+    if (!tryCloseSlot(slot)) {
+      continue;
+    }
     auto partial = getPartialRecord(li);
     // TODO: get the data ref from message model
     auto getter = [&partial](size_t idx, size_t part) {
@@ -789,6 +996,7 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
         mTimesliceIndex.markAsDirty(slot, false);
         break;
     }
+    reopenSlot(slot, false);
   }
   mTimesliceIndex.updateOldestPossibleOutput(false);
   LOGP(debug, "DataRelayer::getReadyToProcess results notDirty:{}, consume:{}, consumeExisting:{}, process:{}, discard:{}, wait:{}",
@@ -816,7 +1024,8 @@ void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStat
 
 std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  closeSlot(lock, slot);
 
   const auto numInputTypes = mDistinctRoutesIndex.size();
   // State of the computation
@@ -864,13 +1073,15 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice
     moveHeaderPayloadToOutput(slot, ai);
   }
   invalidateCacheFor(slot);
+  reopenSlot(slot, true);
 
   return messages;
 }
 
 std::vector<o2::framework::MessageSet> DataRelayer::consumeExistingInputsForTimeslice(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  closeSlot(lock, slot);
 
   const auto numInputTypes = mDistinctRoutesIndex.size();
   // State of the computation
@@ -907,13 +1118,15 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeExistingInputsForTime
   for (size_t ai = 0, ae = numInputTypes; ai != ae; ++ai) {
     copyHeaderPayloadToOutput(slot, ai);
   }
+  reopenSlot(slot, false);
 
   return std::move(messages);
 }
 
 void DataRelayer::clear()
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  closeAllSlots(lock);
 
   for (auto& cache : mCache) {
     cache.clear();
@@ -921,6 +1134,7 @@ void DataRelayer::clear()
   for (size_t s = 0; s < mTimesliceIndex.size(); ++s) {
     mTimesliceIndex.markAsInvalid(TimesliceSlot{s});
   }
+  reopenAllSlots(true);
 }
 
 size_t
@@ -935,11 +1149,13 @@ size_t
 /// the time pipelining.
 void DataRelayer::setPipelineLength(size_t s)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  closeAllSlots(lock);
 
   mTimesliceIndex.resize(s);
   mVariableContextes.resize(s);
   publishMetrics();
+  reopenAllSlots(true);
 }
 
 void DataRelayer::publishMetrics()
@@ -950,7 +1166,17 @@ void DataRelayer::publishMetrics()
   // FIXME: many of the DataRelayer function rely on allocated cache, so its
   // maybe misleading to have the allocation in a function primarily for
   // metrics publishing, do better in setPipelineLength?
-  mCache.resize(numInputTypes * mTimesliceIndex.size());
+  // The slots are closed by setPipelineLength when the cache is resized.
+  if (mCache.size() != numInputTypes * mTimesliceIndex.size() || mReadyQueueCapacity != mTimesliceIndex.size()) {
+    drainReadyQueue();
+    mCache.resize(numInputTypes * mTimesliceIndex.size());
+    mSlotStates = std::make_unique<std::atomic<uint64_t>[]>(mTimesliceIndex.size());
+    mEntryBusy = std::make_unique<std::atomic_flag[]>(mCache.size());
+    mReadyQueueCapacity = mTimesliceIndex.size();
+    mReadyQueue = std::make_unique<std::atomic<size_t>[]>(mReadyQueueCapacity);
+    mReadyQueueHead = 0;
+    mReadyQueueTail = 0;
+  }
   auto& states = mContext.get<DataProcessingStates>();
 
   mCachedStateMetrics.resize(mCache.size());
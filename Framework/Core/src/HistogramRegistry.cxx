@@ -13,6 +13,8 @@
 #include <regex>
 #include <TList.h>
 #include <TClass.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
 
 namespace o2::framework
 {
@@ -409,4 +411,122 @@ void HistogramRegistry::registerName(const std::string& name)
   mRegisteredNames.push_back(name);
 }
 
+namespace
+{
+// bin index along a regular axis, as computed by TAxis::FindFixBin()
+inline Int_t findFixBin(double x, Int_t nBins, double xMin, double xMax)
+{
+  return x < xMin ? 0 : (!(x < xMax) ? nBins + 1 : 1 + Int_t(nBins * (x - xMin) / (xMax - xMin)));
+}
+
+// adds the entries to the bin contents (and sums of squares of weights) in the order in which TH1::Fill() would do it
+template <typename A>
+void addBinContents(A* contents, double* sumw2, const Int_t* bins, const double* weights, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; i++) {
+    const double weight = weights ? weights[i] : 1.;
+    if (sumw2) {
+      sumw2[bins[i]] += weight * weight;
+    }
+    contents[bins[i]] += static_cast<A>(weight);
+  }
+}
+
+void addBinContents(TH1* hist, const Int_t* bins, const double* weights, size_t begin, size_t end)
+{
+  double* sumw2 = hist->GetSumw2N() ? hist->GetSumw2()->GetArray() : nullptr;
+  if (auto contents = dynamic_cast<TArrayF*>(hist)) {
+    addBinContents(contents->GetArray(), sumw2, bins, weights, begin, end);
+  } else if (auto contents = dynamic_cast<TArrayD*>(hist)) {
+    addBinContents(contents->GetArray(), sumw2, bins, weights, begin, end);
+  } else {
+    // integer contents saturate in AddBinContent()
+    for (size_t i = begin; i < end; i++) {
+      const double weight = weights ? weights[i] : 1.;
+      if (sumw2) {
+        sumw2[bins[i]] += weight * weight;
+      }
+      hist->AddBinContent(bins[i], weight);
+    }
+  }
+}
+} // namespace
+
+bool HistFiller::fillRegularAxes(TH1* hist, int nDimensions, size_t nEntries, const double* const positions[], const double* weights)
+{
+  // the buffered filling, profiles, extendable or variable bin size axes and axis ranges (which change the statistics) are not supported
+  if (nEntries > BulkFillBlockSize || hist->GetDimension() != nDimensions || hist->GetBuffer() || hist->InheritsFrom(TProfile::Class()) || hist->InheritsFrom(TProfile2D::Class()) || hist->InheritsFrom(TProfile3D::Class())) {
+    return false;
+  }
+  TAxis* axes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+  for (int dim = 0; dim < nDimensions; dim++) {
+    if (axes[dim]->IsVariableBinSize() || axes[dim]->CanExtend() || axes[dim]->TestBit(TAxis::kAxisRange)) {
+      return false;
+    }
+  }
+
+  // global bin indices, computed axis by axis in loops without dependencies between the entries
+  std::array<Int_t, BulkFillBlockSize> bins{};
+  std::array<bool, BulkFillBlockSize> inRange;
+  std::fill_n(inRange.begin(), nEntries, true);
+  for (int dim = nDimensions - 1; dim >= 0; dim--) {
+    const Int_t nBins = axes[dim]->GetNbins();
+    const double xMin = axes[dim]->GetXmin();
+    const double xMax = axes[dim]->GetXmax();
+    const double* x = positions[dim];
+    for (size_t i = 0; i < nEntries; i++) {
+      const Int_t bin = findFixBin(x[i], nBins, xMin, xMax);
+      bins[i] = bins[i] * (nBins + 2) + bin;
+      inRange[i] = inRange[i] && bin > 0 && bin <= nBins;
+    }
+  }
+
+  // the statistics are retrieved before the entries change, TH1::GetStats() recomputes them from the contents if there are entries but no sum of weights
+  double stats[TH1::kNstat] = {0};
+  hist->GetStats(stats);
+
+  // as in TH1::Fill(), the sums of squares of weights are created (from the current contents) with the first weight != 1
+  const double entries = hist->GetEntries();
+  size_t nUnweighted = nEntries;
+  if (weights && hist->GetSumw2N() == 0 && !hist->TestBit(TH1::kIsNotW)) {
+    nUnweighted = std::find_if(weights, weights + nEntries, [](double weight) { return weight != 1.; }) - weights;
+  }
+  addBinContents(hist, bins.data(), weights, 0, nUnweighted);
+  if (nUnweighted < nEntries) {
+    hist->SetEntries(entries + nUnweighted + 1);
+    hist->Sumw2();
+    addBinContents(hist, bins.data(), weights, nUnweighted, nEntries);
+  }
+  hist->SetEntries(entries + nEntries);
+
+  // statistics, the under- and overflows are considered only if requested for this histogram (or globally)
+  const bool statOverflows = hist->GetStatOverflowsBehaviour();
+  for (size_t i = 0; i < nEntries; i++) {
+    if (!inRange[i] && !statOverflows) {
+      continue;
+    }
+    const double w = weights ? weights[i] : 1.;
+    const double x = positions[0][i];
+    stats[0] += w;
+    stats[1] += w * w;
+    stats[2] += w * x;
+    stats[3] += w * x * x;
+    if (nDimensions > 1) {
+      const double y = positions[1][i];
+      stats[4] += w * y;
+      stats[5] += w * y * y;
+      stats[6] += w * x * y;
+      if (nDimensions > 2) {
+        const double z = positions[2][i];
+        stats[7] += w * z;
+        stats[8] += w * z * z;
+        stats[9] += w * x * z;
+        stats[10] += w * y * z;
+      }
+    }
+  }
+  hist->PutStats(stats);
+  return true;
+}
+
 } // namespace o2::framework
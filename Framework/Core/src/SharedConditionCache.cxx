@@ -0,0 +1,253 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/SharedConditionCache.h"
+#include "Framework/Logger.h"
+#include "Framework/StringHelpers.h"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bip = boost::interprocess;
+
+namespace o2::framework
+{
+
+namespace
+{
+/// Lives in the first page of the segment, which is mapped shared by all the users
+struct SegmentHeader {
+  enum State : int32_t { Creating = 0,
+                         Ready = 1,
+                         Failed = 2 };
+  std::atomic<int32_t> state;
+  std::atomic<int32_t> users;      // -1 once the last user removes the segment, which cannot be joined anymore
+  std::atomic<int32_t> creatorPid; // to detect that the creator died while the segment is Creating
+  uint64_t payloadSize;
+};
+static_assert(std::atomic<int32_t>::is_always_lock_free, "the header is shared between processes");
+
+constexpr int MaxAttempts = 3;
+
+bool isAlive(pid_t pid)
+{
+  // the pid is 0 until the creator has written it
+  return pid == 0 || kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/// Whether the name still refers to the opened segment, and not to a newer one created with the same name
+bool isSameSegment(bip::shared_memory_object const& shm, std::string const& name)
+{
+#ifdef __linux__
+  struct stat opened, named;
+  return fstat(shm.get_mapping_handle().handle, &opened) == 0 && stat(("/dev/shm/" + name).c_str(), &named) == 0 &&
+         opened.st_dev == named.st_dev && opened.st_ino == named.st_ino;
+#else
+  return true;
+#endif
+}
+} // namespace
+
+struct SharedConditionCache::Segment {
+  std::string name;
+  std::unique_ptr<bip::shared_memory_object> shm;
+  bip::mapped_region header;
+  bip::mapped_region payload;
+
+  SegmentHeader* getHeader() { return reinterpret_cast<SegmentHeader*>(header.get_address()); }
+};
+
+SharedConditionCache::SharedConditionCache()
+{
+  if (auto* env = getenv("DPL_SHARED_CONDITIONS"); env && atoi(env) > 0) {
+    mEnabled = true;
+  }
+}
+
+SharedConditionCache::~SharedConditionCache()
+{
+  while (!mSegments.empty()) {
+    release(mSegments.begin()->first);
+  }
+}
+
+SharedConditionCache& SharedConditionCache::instance()
+{
+  static SharedConditionCache cache;
+  return cache;
+}
+
+std::string SharedConditionCache::getSegmentName(std::string const& etag, std::type_info const& type)
+{
+  std::string id;
+  for (auto c : etag) {
+    if (std::isalnum(static_cast<unsigned char>(c)) || c == '-') {
+      id += c;
+    }
+  }
+  // the type is identified by a fixed hash of its name, unlike std::hash it is the same for all the processes
+  // whatever library they were built with
+  return fmt::format("o2cond_{}_{}_{:08x}", getuid(), id, runtime_hash(type.name()));
+}
+
+char* SharedConditionCache::acquire(std::string const& name, std::function<size_t()> const& prepare, std::function<void(char*)> const& fill)
+{
+  const size_t pageSize = bip::mapped_region::get_page_size();
+  for (int attempt = 0; attempt < MaxAttempts; attempt++) {
+    auto segment = std::make_unique<Segment>();
+    segment->name = name;
+    try {
+      bool creator = true;
+      try {
+        segment->shm = std::make_unique<bip::shared_memory_object>(bip::create_only, name.c_str(), bip::read_write);
+      } catch (bip::interprocess_exception&) {
+        creator = false;
+        try {
+          segment->shm = std::make_unique<bip::shared_memory_object>(bip::open_only, name.c_str(), bip::read_write);
+        } catch (bip::interprocess_exception&) {
+          continue; // removed in the meantime
+        }
+      }
+      auto& shm = *segment->shm;
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(mWaitTimeoutMS);
+      auto waitFor = [&deadline](auto&& condition) {
+        while (!condition()) {
+          if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return true;
+      };
+
+      if (creator) {
+        // the header is written before preparing the object, so that the others can tell if the creator dies meanwhile
+        shm.truncate(pageSize);
+        segment->header = bip::mapped_region(shm, bip::read_write, 0, pageSize);
+        auto* header = new (segment->header.get_address()) SegmentHeader{};
+        header->creatorPid.store(getpid(), std::memory_order_release);
+        auto fail = [&]() {
+          header->state.store(SegmentHeader::Failed, std::memory_order_release);
+          bip::shared_memory_object::remove(name.c_str());
+        };
+        size_t payloadSize = 0;
+        try {
+          payloadSize = prepare();
+        } catch (...) {
+          fail();
+          throw;
+        }
+        if (!payloadSize) {
+          fail();
+          return nullptr;
+        }
+        try {
+          header->payloadSize = payloadSize;
+          shm.truncate(pageSize + payloadSize);
+          bip::mapped_region payload(shm, bip::read_write, pageSize, payloadSize);
+          fill(static_cast<char*>(payload.get_address()));
+        } catch (...) {
+          fail();
+          throw;
+        }
+        header->state.store(SegmentHeader::Ready, std::memory_order_release);
+        LOGP(info, "Created shared condition segment {} of {} bytes", name, payloadSize);
+      } else {
+        // the creator may not have sized the segment yet
+        bip::offset_t size = 0;
+        if (!waitFor([&]() { return shm.get_size(size) && size_t(size) >= pageSize; })) {
+          // the creator died right after creating the segment
+          if (isSameSegment(shm, name)) {
+            LOGP(warn, "Removing the shared condition segment {} left without header", name);
+            bip::shared_memory_object::remove(name.c_str());
+          }
+          continue;
+        }
+        segment->header = bip::mapped_region(shm, bip::read_write, 0, pageSize);
+        auto* header = segment->getHeader();
+        bool creatorDied = false;
+        auto isCompleted = [&]() {
+          if (header->state.load(std::memory_order_acquire) != SegmentHeader::Creating) {
+            return true;
+          }
+          creatorDied = !isAlive(header->creatorPid.load(std::memory_order_acquire));
+          return creatorDied;
+        };
+        if (!waitFor(isCompleted)) {
+          LOGP(warn, "Timeout waiting for the shared condition segment {}, deserialising privately", name);
+          return nullptr;
+        }
+        if (creatorDied) {
+          // only one of the processes which noticed it removes the segment, then all retry
+          int32_t expected = SegmentHeader::Creating;
+          if (header->state.compare_exchange_strong(expected, SegmentHeader::Failed) && isSameSegment(shm, name)) {
+            LOGP(warn, "The creator of the shared condition segment {} died, re-creating it", name);
+            bip::shared_memory_object::remove(name.c_str());
+          }
+          continue;
+        }
+        if (header->state.load(std::memory_order_acquire) != SegmentHeader::Ready) {
+          LOGP(warn, "Shared condition segment {} was not completed, deserialising privately", name);
+          return nullptr;
+        }
+      }
+      segment->payload = bip::mapped_region(shm, bip::copy_on_write, pageSize, segment->getHeader()->payloadSize);
+      // join the users, unless the last one is already removing the segment
+      auto& users = segment->getHeader()->users;
+      int32_t nUsers = users.load();
+      while (nUsers >= 0 && !users.compare_exchange_weak(nUsers, nUsers + 1)) {
+      }
+      if (nUsers < 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        continue;
+      }
+    } catch (bip::interprocess_exception& e) {
+      LOGP(warn, "Cannot use the shared condition segment {}: {}", name, e.what());
+      return nullptr;
+    }
+    auto* payload = static_cast<char*>(segment->payload.get_address());
+    mSegments.emplace(payload, std::move(segment));
+    return payload;
+  }
+  LOGP(warn, "Cannot use the shared condition segment {} after {} attempts, deserialising privately", name, MaxAttempts);
+  return nullptr;
+}
+
+bool SharedConditionCache::release(void const* object)
+{
+  auto it = mSegments.find(object);
+  if (it == mSegments.end()) {
+    return false;
+  }
+  auto& segment = it->second;
+  // the last user closes the segment for joining, so that the name cannot refer to a newer segment yet
+  auto& users = segment->getHeader()->users;
+  int32_t nUsers = users.load();
+  while (!users.compare_exchange_weak(nUsers, nUsers == 1 ? -1 : nUsers - 1)) {
+  }
+  if (nUsers == 1 && isSameSegment(*segment->shm, segment->name)) {
+    bip::shared_memory_object::remove(segment->name.c_str());
+    LOGP(debug, "Removed shared condition segment {}", segment->name);
+  }
+  mSegments.erase(it);
+  return true;
+}
+
+} // namespace o2::framework
@@ -26,6 +26,9 @@
 #include "THn.h"
 #include "TMath.h"
 
+#include <algorithm>
+#include <vector>
+
 ClassImp(StepTHn);
 templateClassImp(StepTHnT);
 
@@ -391,21 +394,7 @@ void StepTHn::Fill(int iStep, int nParams, double positionAndWeight[])
 
   // fill axis cache
   if (!mAxisCache) {
-    mAxisCache = new TAxis*[mNVars];
-    mNbinsCache = new Int_t[mNVars];
-    for (Int_t i = 0; i < mNVars; i++) {
-      mAxisCache[i] = mPrototype->GetAxis(i);
-      mNbinsCache[i] = mAxisCache[i]->GetNbins();
-    }
-
-    mLastVars = new Double_t[mNVars];
-    mLastBins = new Int_t[mNVars];
-
-    // initial values to prevent checking for 0 below
-    for (Int_t i = 0; i < mNVars; i++) {
-      mLastVars[i] = positionAndWeight[i];
-      mLastBins[i] = mAxisCache[i]->FindBin(mLastVars[i]);
-    }
+    createAxisCache(positionAndWeight);
   }
 
   // calculate global bin index
@@ -453,5 +442,138 @@ void StepTHn::Fill(int iStep, int nParams, double positionAndWeight[])
   }
 }
 
+void StepTHn::createAxisCache(const double* initialValues)
+{
+  mAxisCache = new TAxis*[mNVars];
+  mNbinsCache = new Int_t[mNVars];
+  for (Int_t i = 0; i < mNVars; i++) {
+    mAxisCache[i] = mPrototype->GetAxis(i);
+    mNbinsCache[i] = mAxisCache[i]->GetNbins();
+  }
+
+  mLastVars = new Double_t[mNVars];
+  mLastBins = new Int_t[mNVars];
+
+  // initial values to prevent checking for 0 in Fill
+  for (Int_t i = 0; i < mNVars; i++) {
+    mLastVars[i] = initialValues[i];
+    mLastBins[i] = mAxisCache[i]->FindBin(mLastVars[i]);
+  }
+}
+
+namespace
+{
+// adds the weights to the bins (skipping the bins < 0) in the order of the entries, as Fill does
+template <typename T>
+void addAt(T* array, const Long64_t* bins, const double* weights, Long64_t begin, Long64_t end)
+{
+  for (Long64_t i = begin; i < end; i++) {
+    if (bins[i] >= 0) {
+      array[bins[i]] += weights ? weights[i] : 1.;
+    }
+  }
+}
+
+void addAt(TArray* array, const Long64_t* bins, const double* weights, Long64_t begin, Long64_t end)
+{
+  if (auto arrayF = dynamic_cast<TArrayF*>(array)) {
+    addAt(arrayF->GetArray(), bins, weights, begin, end);
+  } else if (auto arrayD = dynamic_cast<TArrayD*>(array)) {
+    addAt(arrayD->GetArray(), bins, weights, begin, end);
+  } else {
+    for (Long64_t i = begin; i < end; i++) {
+      if (bins[i] >= 0) {
+        array->SetAt(array->GetAt(bins[i]) + (weights ? weights[i] : 1.), bins[i]);
+      }
+    }
+  }
+}
+} // namespace
+
+void StepTHn::FillColumns(int iStep, int nColumns, const double* const columns[], Long64_t nEntries)
+{
+  if (iStep >= mNSteps) {
+    LOGF(fatal, "Selected step for filling is not in range of StepTHn.");
+  }
+
+  const double* weights = nullptr;
+  if (nColumns == mNVars + 1) {
+    weights = columns[mNVars];
+  } else if (nColumns != mNVars) {
+    LOGF(fatal, "FillColumns called with invalid number of columns (%d vs %d)", mNVars, nColumns);
+  }
+  if (nEntries <= 0) {
+    return;
+  }
+
+  // fill axis cache
+  if (!mAxisCache) {
+    std::vector<double> initialValues(mNVars);
+    for (Int_t i = 0; i < mNVars; i++) {
+      initialValues[i] = columns[i][0];
+    }
+    createAxisCache(initialValues.data());
+  }
+
+  constexpr Long64_t blockSize = 1024;
+  std::vector<Long64_t> bins(blockSize);
+  for (Long64_t begin = 0; begin < nEntries; begin += blockSize) {
+    const Long64_t n = std::min(blockSize, nEntries - begin);
+    const double* blockWeights = weights ? weights + begin : nullptr;
+
+    // calculate global bin indices (-1 for under/overflow, which is not supported) axis by axis, for the regular axes without dependencies between the entries
+    std::fill_n(bins.begin(), n, 0);
+    for (Int_t i = 0; i < mNVars; i++) {
+      const double* values = columns[i] + begin;
+      TAxis* axis = mAxisCache[i];
+      const Int_t nBins = mNbinsCache[i];
+      if (axis->IsVariableBinSize() || axis->CanExtend()) {
+        for (Long64_t j = 0; j < n; j++) {
+          const Int_t tmpBin = axis->FindBin(values[j]);
+          bins[j] = (bins[j] < 0 || tmpBin < 1 || tmpBin > nBins) ? -1 : bins[j] * nBins + tmpBin - 1;
+        }
+      } else {
+        const double xMin = axis->GetXmin();
+        const double xMax = axis->GetXmax();
+        for (Long64_t j = 0; j < n; j++) {
+          // as TAxis::FindFixBin
+          const double x = values[j];
+          const Int_t tmpBin = x < xMin ? 0 : (!(x < xMax) ? nBins + 1 : 1 + Int_t(nBins * (x - xMin) / (xMax - xMin)));
+          bins[j] = (bins[j] < 0 || tmpBin < 1 || tmpBin > nBins) ? -1 : bins[j] * nBins + tmpBin - 1;
+        }
+      }
+    }
+
+    // the containers are created with the first entry in range and the sumw2 with the first weight != 1
+    auto firstInRange = std::find_if(bins.begin(), bins.begin() + n, [](Long64_t bin) { return bin >= 0; }) - bins.begin();
+    if (firstInRange == n) {
+      continue;
+    }
+    if (!mValues[iStep]) {
+      mValues[iStep] = createArray();
+      LOGF(info, "Created values container for step %d", iStep);
+    }
+    Long64_t firstWeighted = 0;
+    if (!mSumw2[iStep]) {
+      firstWeighted = n;
+      for (Long64_t j = firstInRange; blockWeights && j < n; j++) {
+        if (bins[j] >= 0 && blockWeights[j] != 1.) {
+          firstWeighted = j;
+          break;
+        }
+      }
+      if (firstWeighted < n) {
+        mSumw2[iStep] = createArray();
+        LOGF(info, "Created sumw2 container for step %d", iStep);
+      }
+    }
+
+    addAt(mValues[iStep], bins.data(), blockWeights, 0, n);
+    if (mSumw2[iStep]) {
+      addAt(mSumw2[iStep], bins.data(), blockWeights, firstWeighted, n);
+    }
+  }
+}
+
 template class StepTHnT<TArrayF>;
 template class StepTHnT<TArrayD>;
@@ -334,6 +334,31 @@ void ColumnToBranch::at(const int64_t* pos)
   }
 }
 
+void ColumnToBranch::fill(int64_t rows)
+{
+  for (int64_t row = 0; row < rows; ++row) {
+    at(&row);
+    if (mSizeBranch != nullptr) {
+      mSizeBranch->Fill();
+    }
+    mBranch->Fill();
+  }
+}
+
+int64_t ColumnToBranch::columnBytes() const
+{
+  if (mFieldType != arrow::Type::LIST) {
+    return mColumn->length() * mListSize * mElementType.size;
+  }
+  int64_t values = 0;
+  for (auto const& chunk : mColumn->chunks()) {
+    auto list = std::static_pointer_cast<arrow::ListArray>(chunk);
+    values += list->value_offset(list->length()) - list->value_offset(0);
+  }
+  // ROOT reserves two offsets per entry of a variable size array when deciding to flush a basket
+  return values * mElementType.size + 2 * sizeof(int) * mColumn->length();
+}
+
 void ColumnToBranch::accessChunk()
 {
   auto array = mColumn->chunk(mCurrentChunk);
@@ -400,7 +425,7 @@ void TableToTree::addBranch(std::shared_ptr<arrow::ChunkedArray> const& column,
   mColumnReaders.emplace_back(new ColumnToBranch{mTree.get(), column, field});
 }
 
-std::shared_ptr<TTree> TableToTree::process()
+std::shared_ptr<TTree> TableToTree::process(TaskRunner const& runTasks)
 {
   int64_t row = 0;
   if (mTree->GetNbranches() == 0 || mRows == 0) {
@@ -409,6 +434,28 @@ std::shared_ptr<TTree> TableToTree::process()
     return mTree;
   }
 
+  // The branches of a new tree are independent until the tree is written: each task fills the
+  // branches of one column into a single basket, large enough that a full basket is never
+  // flushed to the file from a task. Trees which already have entries are filled in sequence.
+  if (runTasks && mTree->GetEntries() == 0) {
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(mColumnReaders.size());
+    for (auto& reader : mColumnReaders) {
+      mTree->SetBasketSize(reader->branchName(), (int)std::max<int64_t>(32000, 1024 + reader->columnBytes()));
+      if (reader->hasSizeBranch()) {
+        std::string sizeBranch = reader->branchName();
+        sizeBranch += TableTreeHelpers::sizeBranchSuffix;
+        mTree->SetBasketSize(sizeBranch.c_str(), (int)std::max<int64_t>(32000, 1024 + sizeof(int) * mRows));
+      }
+      tasks.emplace_back([reader = reader.get(), rows = mRows]() { reader->fill(rows); });
+    }
+    runTasks(tasks);
+    mTree->SetEntries(mRows);
+    mTree->Write("", TObject::kOverwrite);
+    mTree->SetDirectory(nullptr);
+    return mTree;
+  }
+
   for (auto& reader : mColumnReaders) {
     int idealBasketSize = 1024 + reader->fieldSize() * reader->columnEntries(); // minimal additional size needed, otherwise we get 2 baskets
     int basketSize = std::max(32000, idealBasketSize);                          // keep a minimum value
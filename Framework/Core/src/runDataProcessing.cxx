@@ -2029,6 +2029,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             "--aod-writer-resmode",
             "--aod-writer-maxfilesize",
             "--aod-writer-keep",
+            "--aod-writer-threads",
             "--aod-max-io-rate",
             "--aod-parent-access-level",
             "--aod-parent-base-path-replacement",
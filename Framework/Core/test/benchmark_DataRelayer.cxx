@@ -15,9 +15,19 @@
 #include "Framework/CompletionPolicyHelpers.h"
 #include "Framework/DataRelayer.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/DataProcessingStats.h"
+#include "Framework/DataProcessingStates.h"
+#include "Framework/DeviceState.h"
+#include "Framework/DriverConfig.h"
+#include "Framework/TimingHelpers.h"
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
+#include <fmt/format.h>
+#include <uv.h>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <thread>
 #include <vector>
 
 using Monitoring = o2::monitoring::Monitoring;
@@ -354,4 +364,106 @@ static void BM_RelayMultiplePayloads(benchmark::State& state)
 
 BENCHMARK(BM_RelayMultiplePayloads)->Arg(10)->Arg(100)->Arg(1000);
 
+/// One thread per input channel relaying its part of each timeslice,
+/// while the completed timeslices are consumed as they become ready.
+static void BM_RelayConcurrentChannels(benchmark::State& state)
+{
+  ServiceRegistry registry;
+  ServiceRegistryRef ref{registry};
+  Monitoring monitoring;
+  const DriverConfig driverConfig{
+    .batch = false,
+  };
+  DataProcessingStates states(
+    TimingHelpers::defaultRealtimeBaseConfigurator(0, uv_default_loop()),
+    TimingHelpers::defaultCPUTimeConfigurator(uv_default_loop()));
+  DataProcessingStats stats(
+    TimingHelpers::defaultRealtimeBaseConfigurator(0, uv_default_loop()),
+    TimingHelpers::defaultCPUTimeConfigurator(uv_default_loop()), {});
+  using MetricSpec = DataProcessingStats::MetricSpec;
+  for (auto id : {ProcessingStatsId::MALFORMED_INPUTS, ProcessingStatsId::DROPPED_COMPUTATIONS,
+                  ProcessingStatsId::DROPPED_INCOMING_MESSAGES, ProcessingStatsId::RELAYED_MESSAGES}) {
+    stats.registerMetric(MetricSpec{.name = fmt::format("metric_{}", (int)id), .metricId = static_cast<short>(id), .minPublishInterval = 1000});
+  }
+  DeviceState deviceState;
+  ref.registerService(ServiceRegistryHelpers::handleForService<Monitoring>(&monitoring));
+  ref.registerService(ServiceRegistryHelpers::handleForService<DataProcessingStats>(&stats));
+  ref.registerService(ServiceRegistryHelpers::handleForService<DataProcessingStates>(&states));
+  ref.registerService(ServiceRegistryHelpers::handleForService<DriverConfig const>(&driverConfig));
+  ref.registerService(ServiceRegistryHelpers::handleForService<DeviceState>(&deviceState));
+
+  const size_t nChannels = state.range(0);
+  const size_t nTimeslices = 256;
+  std::vector<InputRoute> inputs;
+  for (size_t ci = 0; ci < nChannels; ++ci) {
+    inputs.emplace_back(InputRoute{InputSpec{fmt::format("clusters{}", ci), "TPC", "CLUSTERS", static_cast<o2::header::DataHeader::SubSpecificationType>(ci)}, ci, fmt::format("Fake{}", ci), 0});
+  }
+  std::vector<InputChannelInfo> infos{nChannels};
+  TimesliceIndex index{1, infos};
+  ref.registerService(ServiceRegistryHelpers::handleForService<TimesliceIndex>(&index));
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  DataRelayer relayer(policy, inputs, index, {registry});
+  relayer.setPipelineLength(16);
+
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  size_t firstTimeslice = 0;
+  // messages[channel][timeslice][header, payload]
+  std::vector<std::vector<std::array<fair::mq::MessagePtr, 2>>> messages(nChannels);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (size_t ci = 0; ci < nChannels; ++ci) {
+      messages[ci].resize(nTimeslices);
+      DataHeader dh;
+      dh.dataDescription = "CLUSTERS";
+      dh.dataOrigin = "TPC";
+      dh.subSpecification = ci;
+      for (size_t ti = 0; ti < nTimeslices; ++ti) {
+        Stack stack{dh, DataProcessingHeader{firstTimeslice + ti, 1}};
+        messages[ci][ti][0] = transport->CreateMessage(stack.size());
+        memcpy(messages[ci][ti][0]->GetData(), stack.data(), stack.size());
+        messages[ci][ti][1] = transport->CreateMessage(1000);
+      }
+    }
+    state.ResumeTiming();
+
+    std::atomic<size_t> consumed = 0;
+    auto consumeReady = [&relayer, &consumed]() {
+      std::vector<RecordAction> ready;
+      relayer.getReadyToProcess(ready);
+      for (auto& action : ready) {
+        if (action.op == CompletionPolicy::CompletionOp::Consume) {
+          relayer.consumeAllInputsForTimeslice(action.slot);
+          consumed++;
+        }
+      }
+    };
+    std::vector<std::thread> channels;
+    for (size_t ci = 0; ci < nChannels; ++ci) {
+      channels.emplace_back([&, ci]() {
+        for (size_t ti = 0; ti < nTimeslices; ++ti) {
+          auto& parts = messages[ci][ti];
+          DataRelayer::InputInfo fakeInfo{0, parts.size(), DataRelayer::InputType::Data, {ChannelIndex::INVALID}};
+          // all the slots are taken by timeslices the other channels did not complete yet
+          while (relayer.relay(parts[0]->GetData(), parts.data(), fakeInfo, parts.size()).type == DataRelayer::RelayChoice::Type::Backpressured) {
+            consumeReady();
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    while (consumed < nTimeslices) {
+      consumeReady();
+    }
+    for (auto& channel : channels) {
+      channel.join();
+    }
+    firstTimeslice += nTimeslices;
+  }
+  state.SetItemsProcessed(state.iterations() * nTimeslices * nChannels);
+}
+
+BENCHMARK(BM_RelayConcurrentChannels)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
+
 BENCHMARK_MAIN();
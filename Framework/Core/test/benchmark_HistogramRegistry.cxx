@@ -13,6 +13,7 @@
 #include "Framework/Logger.h"
 
 #include "TList.h"
+#include "TRandom.h"
 
 #include <benchmark/benchmark.h>
 #include <boost/format.hpp>
@@ -62,7 +63,45 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+/// Fill a 2D histogram entry by entry
+static void BM_EntryFill(benchmark::State& state)
+{
+  std::vector<float> x(state.range(0));
+  std::vector<float> y(state.range(0));
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = gRandom->Uniform(-0.1, 1.1);
+    y[i] = gRandom->Uniform(-0.1, 1.1);
+  }
+  HistogramRegistry registry{"registry", {{"histo", "histo", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}}}};
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < x.size(); ++i) {
+      registry.fill(HIST("histo"), x[i], y[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Fill a 2D histogram with columns of values at once
+static void BM_ColumnFill(benchmark::State& state)
+{
+  std::vector<float> x(state.range(0));
+  std::vector<float> y(state.range(0));
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = gRandom->Uniform(-0.1, 1.1);
+    y[i] = gRandom->Uniform(-0.1, 1.1);
+  }
+  HistogramRegistry registry{"registry", {{"histo", "histo", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}}}};
+
+  for (auto _ : state) {
+    registry.fillColumns(HIST("histo"), gsl::span<const float>(x), gsl::span<const float>(y));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
+BENCHMARK(BM_EntryFill)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_ColumnFill)->Arg(1000)->Arg(100000);
 
 BENCHMARK_MAIN();
@@ -25,7 +25,11 @@
 #include "Framework/WorkflowSpec.h"
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
+#include <algorithm>
 #include <array>
+#include <optional>
+#include <string>
+#include <thread>
 #include <vector>
 #include <uv.h>
 
@@ -807,4 +811,92 @@ TEST_CASE("DataRelayer")
       }
     }
   }
+
+  // Each input channel relays its parts from its own thread, while the
+  // completed timeslices are consumed: every message must be relayed
+  // exactly once, to the timeslice and the input it belongs to.
+  SECTION("TestConcurrentRelay")
+  {
+    const size_t nChannels = 4;
+    const size_t nTimeslices = 200;
+    std::vector<InputRoute> inputs;
+    for (size_t ci = 0; ci < nChannels; ++ci) {
+      inputs.emplace_back(InputRoute{InputSpec{"clusters" + std::to_string(ci), "TPC", "CLUSTERS", static_cast<o2::header::DataHeader::SubSpecificationType>(ci)}, ci, "Fake" + std::to_string(ci), 0});
+    }
+    std::vector<InputChannelInfo> infos{nChannels};
+    TimesliceIndex index{1, infos};
+    ref.registerService(ServiceRegistryHelpers::handleForService<TimesliceIndex>(&index));
+
+    auto policy = CompletionPolicyHelpers::consumeWhenAll();
+    DataRelayer relayer(policy, inputs, index, {registry});
+    relayer.setPipelineLength(8);
+
+    // messages[channel][timeslice][header, payload], the payload holds the channel and the timeslice
+    auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+    auto channelAlloc = o2::pmr::getTransportAllocator(transport.get());
+    std::vector<std::vector<std::array<fair::mq::MessagePtr, 2>>> messages(nChannels);
+    for (size_t ci = 0; ci < nChannels; ++ci) {
+      messages[ci].resize(nTimeslices);
+      DataHeader dh{"CLUSTERS", "TPC", static_cast<o2::header::DataHeader::SubSpecificationType>(ci)};
+      dh.splitPayloadIndex = 0;
+      dh.splitPayloadParts = 1;
+      for (size_t ti = 0; ti < nTimeslices; ++ti) {
+        messages[ci][ti][0] = o2::pmr::getMessage(Stack{channelAlloc, dh, DataProcessingHeader{ti, 1}});
+        messages[ci][ti][1] = transport->CreateMessage(sizeof(size_t));
+        *(reinterpret_cast<size_t*>(messages[ci][ti][1]->GetData())) = ci * nTimeslices + ti;
+      }
+    }
+
+    std::vector<std::thread> channels;
+    for (size_t ci = 0; ci < nChannels; ++ci) {
+      channels.emplace_back([&, ci]() {
+        for (size_t ti = 0; ti < nTimeslices; ++ti) {
+          auto& parts = messages[ci][ti];
+          DataRelayer::InputInfo fakeInfo{0, parts.size(), DataRelayer::InputType::Data, {ChannelIndex::INVALID}};
+          // retry while all the slots are taken by timeslices the other channels did not complete yet
+          while (relayer.relay(parts[0]->GetData(), parts.data(), fakeInfo, parts.size()).type == DataRelayer::RelayChoice::Type::Backpressured) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    std::vector<int> nRelayed(nChannels * nTimeslices, 0);
+    size_t nConsumed = 0;
+    bool consistent = true; // checked outside of the loop, REQUIRE is not thread safe
+    while (nConsumed < nTimeslices) {
+      std::vector<RecordAction> ready;
+      relayer.getReadyToProcess(ready);
+      for (auto& action : ready) {
+        if (action.op != CompletionPolicy::CompletionOp::Consume) {
+          continue;
+        }
+        auto result = relayer.consumeAllInputsForTimeslice(action.slot);
+        consistent &= result.size() == nChannels;
+        std::optional<size_t> timeslice;
+        for (size_t ci = 0; ci < std::min(result.size(), nChannels); ++ci) {
+          consistent &= result[ci].size() == 1 && result[ci].payload(0) != nullptr;
+          if (!consistent) {
+            break;
+          }
+          auto id = *(reinterpret_cast<size_t const*>(result[ci].payload(0)->GetData()));
+          consistent &= id < nChannels * nTimeslices && id / nTimeslices == ci && (!timeslice || *timeslice == id % nTimeslices);
+          timeslice = id % nTimeslices;
+          if (consistent) {
+            nRelayed[id]++;
+          }
+        }
+        nConsumed++;
+      }
+      if (!consistent) {
+        break;
+      }
+    }
+    for (auto& channel : channels) {
+      channel.join();
+    }
+    REQUIRE(consistent);
+    REQUIRE(nConsumed == nTimeslices);
+    REQUIRE(std::all_of(nRelayed.begin(), nRelayed.end(), [](int n) { return n == 1; }));
+  }
 }
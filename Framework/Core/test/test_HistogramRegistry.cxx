@@ -105,6 +105,68 @@ TEST_CASE("HistogramRegistryExpressionFill")
   REQUIRE(registry.get<TH2>(HIST("xy"))->GetEntries() == 2);
 }
 
+TEST_CASE("HistogramRegistryColumnFill")
+{
+  std::vector<float> x;
+  std::vector<int> y;
+  std::vector<double> w;
+  for (int i = 0; i < 5000; ++i) {
+    x.push_back(-1.5f + 0.001f * i);
+    y.push_back(i % 23 - 11);
+    w.push_back(i < 3000 ? 1. : 0.5 + 0.001 * (i % 7));
+  }
+  std::vector<double> edges{-1.0, 0.0, 0.5, 1.0, 2.0};
+
+  HistogramRegistry registry{
+    "registry", {
+                  {"entry/x", "x", {HistType::kTH1F, {{100, -1.0f, 2.0f}}}},                            //
+                  {"columns/x", "x", {HistType::kTH1F, {{100, -1.0f, 2.0f}}}},                          //
+                  {"entry/xyw", "xyw", {HistType::kTH2D, {{100, -1.0f, 2.0f}, {20, -10.0f, 10.0f}}}},   //
+                  {"columns/xyw", "xyw", {HistType::kTH2D, {{100, -1.0f, 2.0f}, {20, -10.0f, 10.0f}}}}, //
+                  {"entry/variable", "variable", {HistType::kTH1D, {{edges}}}},                         //
+                  {"columns/variable", "variable", {HistType::kTH1D, {{edges}}}},                       //
+                  {"entry/step", "step", {kStepTHnF, {{100, -1.0f, 2.0f}, {20, -10.0f, 10.0f}}, 2}},    //
+                  {"columns/step", "step", {kStepTHnF, {{100, -1.0f, 2.0f}, {20, -10.0f, 10.0f}}, 2}}   //
+                }                                                                                       //
+  };
+
+  std::vector<int> steps(x.size(), 1);
+  for (size_t i = 0; i < x.size(); ++i) {
+    registry.fill(HIST("entry/x"), x[i]);
+    registry.fill(HIST("entry/xyw"), x[i], y[i], w[i]);
+    registry.fill(HIST("entry/variable"), x[i], w[i]);
+    registry.fill(HIST("entry/step"), steps[i], x[i], y[i], w[i]);
+  }
+  registry.fillColumns(HIST("columns/x"), gsl::span<const float>(x));
+  registry.fillColumns(HIST("columns/xyw"), gsl::span<const float>(x), gsl::span<const int>(y), gsl::span<const double>(w));
+  registry.fillColumns(HIST("columns/variable"), gsl::span<const float>(x), gsl::span<const double>(w));
+  registry.fillColumns(HIST("columns/step"), gsl::span<const int>(steps), gsl::span<const float>(x), gsl::span<const int>(y), gsl::span<const double>(w));
+
+  /// The bulk filling gives the same contents and statistics as the filling entry by entry
+  auto compare = [](TH1* entry, TH1* columns) {
+    REQUIRE(entry->GetEntries() == columns->GetEntries());
+    REQUIRE(entry->GetMean() == columns->GetMean());
+    REQUIRE(entry->GetStdDev(2) == columns->GetStdDev(2));
+    REQUIRE(entry->GetSumw2N() == columns->GetSumw2N());
+    for (int bin = 0; bin < entry->GetNcells(); ++bin) {
+      REQUIRE(entry->GetBinContent(bin) == columns->GetBinContent(bin));
+      REQUIRE(entry->GetBinError(bin) == columns->GetBinError(bin));
+    }
+  };
+  compare(registry.get<TH1>(HIST("entry/x")).get(), registry.get<TH1>(HIST("columns/x")).get());
+  compare(registry.get<TH2>(HIST("entry/xyw")).get(), registry.get<TH2>(HIST("columns/xyw")).get());
+  compare(registry.get<TH1>(HIST("entry/variable")).get(), registry.get<TH1>(HIST("columns/variable")).get());
+
+  auto entryStep = registry.get<StepTHn>(HIST("entry/step"));
+  auto columnsStep = registry.get<StepTHn>(HIST("columns/step"));
+  REQUIRE(entryStep->getValues(0) == nullptr);
+  REQUIRE(columnsStep->getValues(0) == nullptr);
+  for (int bin = 0; bin < entryStep->getValues(1)->GetSize(); ++bin) {
+    REQUIRE(entryStep->getValues(1)->GetAt(bin) == columnsStep->getValues(1)->GetAt(bin));
+    REQUIRE(entryStep->getSumw2(1)->GetAt(bin) == columnsStep->getSumw2(1)->GetAt(bin));
+  }
+}
+
 TEST_CASE("HistogramRegistryStepTHn")
 {
   HistogramRegistry registry{"registry"};
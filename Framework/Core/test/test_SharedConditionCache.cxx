@@ -0,0 +1,171 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/SharedConditionCache.h"
+#include <catch_amalgamated.hpp>
+#include <TBufferFile.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace o2::framework;
+
+namespace
+{
+// Minimal flat object: the buffer starts with a pointer to the payload which follows it.
+// As for the FlatObject, only the size and the buffer container are persistent, the buffer pointer is transient.
+struct FlatTestObject {
+  static constexpr int NValues = 1000;
+  int mSize = 0;
+  char* mContainer = nullptr;
+  char* mBuffer = nullptr;
+
+  FlatTestObject() = default;
+  ~FlatTestObject() { delete[] mContainer; }
+
+  static std::unique_ptr<FlatTestObject> create()
+  {
+    auto obj = std::make_unique<FlatTestObject>();
+    obj->mSize = sizeof(int*) + NValues * sizeof(int);
+    obj->mContainer = new char[obj->mSize];
+    obj->setActualBufferAddress(obj->mContainer);
+    auto* values = reinterpret_cast<int*>(obj->mBuffer + sizeof(int*));
+    for (int i = 0; i < NValues; i++) {
+      values[i] = i * 3;
+    }
+    return obj;
+  }
+
+  // streaming of the persistent members, as done by ROOT for the FlatObject
+  void write(TBuffer& buffer) const
+  {
+    buffer << mSize;
+    buffer.WriteFastArray(mContainer, mSize);
+  }
+  static std::unique_ptr<FlatTestObject> read(TBuffer& buffer)
+  {
+    auto obj = std::make_unique<FlatTestObject>();
+    buffer >> obj->mSize;
+    obj->mContainer = new char[obj->mSize];
+    buffer.ReadFastArray(obj->mContainer, obj->mSize);
+    return obj;
+  }
+
+  size_t getFlatBufferSize() const { return mSize; }
+  const char* getFlatBufferPtr() const { return mBuffer; }
+  void clearInternalBufferPtr() { mContainer = nullptr; }
+  char* releaseInternalBuffer() { return std::exchange(mContainer, nullptr); }
+  void adoptInternalBuffer(char* ptr) { mContainer = ptr; }
+  void setActualBufferAddress(char* ptr)
+  {
+    mBuffer = ptr;
+    *reinterpret_cast<int**>(mBuffer) = reinterpret_cast<int*>(mBuffer + sizeof(int*));
+  }
+  const int* values() const { return *reinterpret_cast<int* const*>(mBuffer); }
+};
+
+// the object as received from the CCDB: streamed, with the buffer pointer not set
+std::unique_ptr<FlatTestObject> deserialiseStreamed()
+{
+  TBufferFile buffer(TBuffer::kWrite);
+  FlatTestObject::create()->write(buffer);
+  buffer.SetReadMode();
+  buffer.SetBufferOffset(0);
+  auto obj = FlatTestObject::read(buffer);
+  REQUIRE(obj->getFlatBufferPtr() == nullptr);
+  return obj;
+}
+} // namespace
+
+static_assert(SharedCondition<FlatTestObject>);
+static_assert(!SharedCondition<std::string>);
+
+TEST_CASE("SharedConditionCache")
+{
+  SharedConditionCache cacheA, cacheB; // stand-ins for two processes
+  cacheA.setEnabled(true);
+  cacheB.setEnabled(true);
+  int nDeserialised = 0;
+  auto deserialise = [&nDeserialised]() {
+    nDeserialised++;
+    return deserialiseStreamed();
+  };
+  const std::string etag = "\"test-" + std::to_string(getpid()) + "\"";
+
+  auto* objA = cacheA.get<FlatTestObject>(etag, deserialise);
+  auto* objB = cacheB.get<FlatTestObject>(etag, deserialise);
+  REQUIRE(nDeserialised == 1);
+  REQUIRE(objA != objB);
+  // every mapping has its pointers relocated to itself
+  REQUIRE((const char*)objA->values() == objA->getFlatBufferPtr() + sizeof(int*));
+  REQUIRE((const char*)objB->values() == objB->getFlatBufferPtr() + sizeof(int*));
+  for (int i = 0; i < FlatTestObject::NValues; i++) {
+    REQUIRE(objA->values()[i] == i * 3);
+    REQUIRE(objB->values()[i] == i * 3);
+  }
+
+  REQUIRE(cacheA.release(objA));
+  REQUIRE(cacheB.release(objB));
+  REQUIRE(!cacheA.release(objA));
+
+  // the segment was removed with its last user
+  auto* objC = cacheA.get<FlatTestObject>(etag, deserialise);
+  REQUIRE(nDeserialised == 2);
+  REQUIRE(cacheA.release(objC));
+
+  // objects without ETag are not shared
+  auto* objD = cacheA.get<FlatTestObject>("", deserialise);
+  REQUIRE(nDeserialised == 3);
+  REQUIRE(!cacheA.release(objD));
+  delete objD;
+}
+
+TEST_CASE("SharedConditionCacheCreatorDied")
+{
+  const std::string etag = "\"died-" + std::to_string(getpid()) + "\"";
+  // the creator dies while deserialising, leaving the segment incomplete
+  auto pid = fork();
+  REQUIRE(pid >= 0);
+  if (pid == 0) {
+    SharedConditionCache creator;
+    creator.setEnabled(true);
+    creator.get<FlatTestObject>(etag, []() -> std::unique_ptr<FlatTestObject> { _exit(0); });
+    _exit(1);
+  }
+  int status = 0;
+  REQUIRE(waitpid(pid, &status, 0) == pid);
+  REQUIRE(WEXITSTATUS(status) == 0);
+
+  // the segment is re-created rather than waited for
+  SharedConditionCache cache;
+  cache.setEnabled(true);
+  int nDeserialised = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto* obj = cache.get<FlatTestObject>(etag, [&nDeserialised]() {
+    nDeserialised++;
+    return deserialiseStreamed();
+  });
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+  REQUIRE(nDeserialised == 1);
+  REQUIRE(obj->values()[FlatTestObject::NValues - 1] == (FlatTestObject::NValues - 1) * 3);
+  REQUIRE(cache.release(obj));
+}
+
+TEST_CASE("SharedConditionCacheSegmentName")
+{
+  // the name only depends on the user, the ETag and the CRC32 of the mangled type name
+  const auto prefix = "o2cond_" + std::to_string(getuid()) + "_";
+  REQUIRE(SharedConditionCache::getSegmentName("\"test-1\"", typeid(int)) == prefix + "test-1_e66c3671");
+  REQUIRE(SharedConditionCache::getSegmentName("\"test-1\"", typeid(FlatTestObject)) != SharedConditionCache::getSegmentName("\"test-1\"", typeid(int)));
+}
@@ -18,8 +18,10 @@
 
 #include <TTree.h>
 #include <TRandom.h>
+#include <TROOT.h>
 #include <arrow/table.h>
 #include <array>
+#include <thread>
 
 using namespace o2::framework;
 
@@ -198,10 +200,29 @@ TEST_CASE("VariableLists")
   }
   auto table = b.finalize();
 
+  // fill the branches either row by row or with one thread per column
+  auto perColumn = GENERATE(false, true);
+  TableToTree::TaskRunner runTasks;
+  if (perColumn) {
+    ROOT::EnableThreadSafety();
+    runTasks = [](std::vector<std::function<void()>> const& tasks) {
+      std::vector<std::thread> threads;
+      for (auto& task : tasks) {
+        threads.emplace_back(task);
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    };
+  }
+
   auto* f = TFile::Open("variable_lists.root", "RECREATE");
   TableToTree ta2tr(table, f, "lists");
   ta2tr.addAllBranches();
-  auto tree = ta2tr.process();
+  auto tree = ta2tr.process(runTasks);
+  REQUIRE(tree->GetEntries() == table->num_rows());
+  REQUIRE(tree->GetBranch("fIvec")->GetEntries() == table->num_rows());
+  REQUIRE(tree->GetBranch("fIvec_size")->GetEntries() == table->num_rows());
   f->Close();
 
   auto* f2 = TFile::Open("variable_lists.root", "READ");
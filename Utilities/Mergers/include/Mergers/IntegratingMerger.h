@@ -24,6 +24,7 @@
 #include "Framework/Task.h"
 
 #include <memory>
+#include <vector>
 
 class TObject;
 
@@ -55,15 +56,18 @@ class IntegratingMerger : public framework::Task
   void endOfStream(framework::EndOfStreamContext& eosContext) override;
 
  private:
+  void mergePendingDeltas();
   void finishCycle(framework::DataAllocator& outputs);
   void publishIntegral(framework::DataAllocator& allocator);
   void publishMovingWindow(framework::DataAllocator& allocator);
-  static void merge(ObjectStore& mMergedDelta, ObjectStore&& other);
+  static void merge(ObjectStore& mMergedDelta, ObjectStore&& other, size_t nThreads = 1);
   void clear();
   bool shouldFinishCycle(const framework::InputRecord&) const;
 
  private:
   header::DataHeader::SubSpecificationType mSubSpec;
+  // deltas received but not yet merged, when merging with several threads
+  std::vector<ObjectStore> mPendingDeltas;
   // data points since the last cycle end. it allows us to create moving windows
   ObjectStore mMergedObjectLastCycle = std::monostate{};
   // data points since the last state reset
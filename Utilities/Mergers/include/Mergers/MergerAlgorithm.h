@@ -19,6 +19,8 @@
 
 #include "ObjectStore.h"
 
+#include <cstddef>
+
 class TObject;
 
 namespace o2::mergers::algorithm
@@ -32,6 +34,19 @@ void merge(TObject* const target, TObject* const other);
 /// If such item exists it is merged into the target object. If not than the item is pushed to the end
 /// of targets vector.
 void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others);
+/// \brief A function which merges two vectors of TObjects using several threads
+///
+/// Same as above, but the pairs of objects with the same name are sharded by the name hash and the shards
+/// are merged in parallel by up to nThreads threads. The objects missing in targets are cloned sequentially beforehand.
+/// ROOT::EnableThreadSafety() has to be called before using more than one thread.
+void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others, size_t nThreads);
+/// \brief A function which merges a set of ObjectStores into the first one by pairwise tree reduction
+///
+/// At each level of the tree, the object i + stride is merged into the object i (i = 0, 2 * stride, 4 * stride...),
+/// the pairs of the same level being merged in parallel by up to nThreads threads. The stores must all hold
+/// the same alternative (monostate is allowed as well). At the end, the objects vector contains only the result.
+/// ROOT::EnableThreadSafety() has to be called before using more than one thread.
+void mergeTree(std::vector<ObjectStore>& objects, size_t nThreads);
 
 void deleteTCollections(TObject* obj);
 
@@ -99,6 +99,10 @@ struct MergerConfig {
   std::string detectorName = "TST";
   ConfigEntry<ParallelismType> parallelismType = {ParallelismType::SplitInputs};
   std::vector<o2::framework::DataProcessorLabel> labels;
+  // Number of threads used by IntegratingMerger to merge the objects. With more than 1, the deltas are buffered until
+  // there are twice as many as threads or the cycle ends, then reduced pairwise in parallel, and the vectors of objects
+  // are merged in parallel, sharded by object names. Up to 2 * mergingThreads deltas are thus kept in memory.
+  size_t mergingThreads = 1;
 };
 
 } // namespace o2::mergers
@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_SPARSEHISTOGRAMDELTA_H
+#define O2_SPARSEHISTOGRAMDELTA_H
+
+/// \file SparseHistogramDelta.h
+/// \brief Sparse, delta-encoded transport format of histograms for Mergers
+
+#include <TObject.h>
+#include "Mergers/MergeInterface.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace o2::mergers
+{
+
+/// \brief Sparse, delta-encoded representation of a histogram, mergeable without materializing the histogram.
+///
+/// Only the bins with non-zero content, or with a content changed with respect to a reference state of the histogram
+/// (e.g. the one published in the previous cycle), are stored as pairs of global bin index and content.
+/// For the transport, the bin index increments and the zigzag-encoded contents are written as varints (the contents
+/// as raw doubles if any of them is not an integer), optionally compressed with rANS. The deltas are merged in their
+/// sparse form and can be added to a histogram with the binning of the original one with addTo().
+/// TH1 (including TH2 and TH3) and THnBase (THn, THnSparse) are supported, profiles are not. The sums of squares of
+/// weights are not transported, the statistics of a TH1 are recomputed from the bin contents in addTo().
+class SparseHistogramDelta : public TObject, public MergeInterface
+{
+ public:
+  enum class Compression : uint8_t {
+    None, // varints only
+    RANS  // varints compressed by rANS
+  };
+
+  SparseHistogramDelta() = default;
+  /// \brief Creates the delta of the histogram with respect to the reference, or its full content if there is none.
+  ///
+  /// The reference must have the same binning as the histogram.
+  SparseHistogramDelta(const TObject& histogram, const TObject* reference = nullptr, Compression compression = Compression::None);
+  ~SparseHistogramDelta() override = default;
+
+  void merge(MergeInterface* const other) override;
+
+  /// \brief Adds the stored bin contents and entries to the histogram, which must have the binning of the original one
+  void addTo(TObject& histogram) const;
+
+  const char* GetName() const override { return mName.c_str(); }
+
+  /// \brief Number of cells (bins including under- and overflows) of the original histogram
+  Long64_t getNCells() const { return mNCells; }
+  /// \brief Number of stored (non-zero) bins
+  size_t getNBins() const;
+  double getBinContent(Long64_t bin) const;
+  double getEntries() const { return mEntries; }
+
+  Compression getCompression() const { return static_cast<Compression>(mCompression); }
+  void setCompression(Compression compression);
+  /// \brief Size of the encoded bins, as sent by Mergers
+  size_t getEncodedSize() const;
+
+ private:
+  void encode() const;
+  void decode() const;
+
+  std::string mName;
+  Long64_t mNCells = 0;                  // number of cells of the original histogram
+  double mEntries = 0;                   // number of entries added to the original histogram
+  uint8_t mCompression = 0;              // Compression of the mPayload
+  mutable bool mIntegerContents = true;  // contents in the mPayload are varints, raw doubles otherwise
+  mutable std::vector<uint8_t> mPayload; // encoded bins
+
+  mutable std::vector<Long64_t> mBins;   //! decoded global bin indices, in increasing order
+  mutable std::vector<double> mContents; //! decoded bin contents
+  mutable bool mDecoded = true;          //! the mBins and mContents are up to date
+  mutable bool mEncoded = false;         //! the mPayload is up to date
+
+  ClassDefOverride(SparseHistogramDelta, 1);
+};
+
+} // namespace o2::mergers
+
+#endif // O2_SPARSEHISTOGRAMDELTA_H
@@ -23,6 +23,8 @@
 
 #include <Monitoring/MonitoringFactory.h>
 
+#include <TROOT.h>
+
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
 
@@ -43,6 +45,12 @@ void IntegratingMerger::init(framework::InitContext& ictx)
   mCollector = monitoring::MonitoringFactory::Get(mConfig.monitoringUrl);
   mCollector->addGlobalTag(monitoring::tags::Key::Subsystem, monitoring::tags::Value::Mergers);
 
+  if (mConfig.mergingThreads > 1) {
+    // the objects are merged and cloned in parallel
+    ROOT::EnableThreadSafety();
+    LOG(info) << "Merging the objects with " << mConfig.mergingThreads << " threads";
+  }
+
   // clear the state before starting the run, especially important for START->STOP->START sequence
   ictx.services().get<CallbackService>().set<CallbackService::Id::Start>([this]() { clear(); });
 
@@ -60,11 +68,25 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
   // we have to avoid mistaking the timer input with data inputs.
   auto* timerHeader = ctx.inputs().get("timer-publish").header;
 
-  for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
-    if (ref.header != timerHeader) {
-      auto other = object_store_helpers::extractObjectFrom(ref);
-      merge(mMergedObjectLastCycle, std::move(other));
-      mDeltasMerged++;
+  if (mConfig.mergingThreads > 1) {
+    // the deltas are buffered across the calls, as they usually arrive one by one with the completion policy
+    // of Mergers, and reduced among themselves in parallel once there are enough to keep all the threads busy
+    for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
+      if (ref.header != timerHeader) {
+        mPendingDeltas.push_back(object_store_helpers::extractObjectFrom(ref));
+        mDeltasMerged++;
+      }
+    }
+    if (mPendingDeltas.size() >= 2 * mConfig.mergingThreads) {
+      mergePendingDeltas();
+    }
+  } else {
+    for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
+      if (ref.header != timerHeader) {
+        auto other = object_store_helpers::extractObjectFrom(ref);
+        merge(mMergedObjectLastCycle, std::move(other));
+        mDeltasMerged++;
+      }
     }
   }
 
@@ -84,16 +106,27 @@ bool IntegratingMerger::shouldFinishCycle(const framework::InputRecord& inputs)
   }
 }
 
+void IntegratingMerger::mergePendingDeltas()
+{
+  algorithm::mergeTree(mPendingDeltas, mConfig.mergingThreads);
+  if (!mPendingDeltas.empty()) {
+    merge(mMergedObjectLastCycle, std::move(mPendingDeltas.front()), mConfig.mergingThreads);
+  }
+  mPendingDeltas.clear();
+}
+
 void IntegratingMerger::finishCycle(DataAllocator& outputs)
 {
   mCyclesSinceReset++;
 
+  mergePendingDeltas();
+
   if (mConfig.publishMovingWindow.value == PublishMovingWindow::Yes) {
     publishMovingWindow(outputs);
   }
 
   if (!std::holds_alternative<std::monostate>(mMergedObjectLastCycle)) {
-    merge(mMergedObjectIntegral, std::move(mMergedObjectLastCycle));
+    merge(mMergedObjectIntegral, std::move(mMergedObjectLastCycle), mConfig.mergingThreads);
   }
   mMergedObjectLastCycle = std::monostate{};
   mTotalDeltasMerged += mDeltasMerged;
@@ -111,7 +144,7 @@ void IntegratingMerger::finishCycle(DataAllocator& outputs)
   mDeltasMerged = 0;
 }
 
-void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
+void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other, size_t nThreads)
 {
   if (std::holds_alternative<std::monostate>(target)) {
     LOG(debug) << "Received the first input object in the run or after the last delta reset";
@@ -128,9 +161,9 @@ void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
     std::get<MergeInterfacePtr>(target)->merge(otherAsMergeInterface.get());
   } else if (std::holds_alternative<VectorOfTObjectPtrs>(target)) {
     // We expect that if the first object was Vector of TObjects, then all should.
-    auto targetAsVector = std::get<VectorOfTObjectPtrs>(target);
-    const auto otherAsVector = std::get<VectorOfTObjectPtrs>(other);
-    algorithm::merge(targetAsVector, otherAsVector);
+    auto& targetAsVector = std::get<VectorOfTObjectPtrs>(target);
+    const auto& otherAsVector = std::get<VectorOfTObjectPtrs>(other);
+    algorithm::merge(targetAsVector, otherAsVector, nThreads);
   } else {
     LOG(error) << "The target variant has an unrecognized value";
   }
@@ -144,6 +177,7 @@ void IntegratingMerger::endOfStream(framework::EndOfStreamContext& eosContext)
 // I am not calling it reset(), because it does not have to be performed during the FairMQs reset.
 void IntegratingMerger::clear()
 {
+  mPendingDeltas.clear();
   mMergedObjectLastCycle = std::monostate{};
   mMergedObjectIntegral = std::monostate{};
   mCyclesSinceReset = 0;
@@ -30,6 +30,13 @@
 #include <TObjArray.h>
 #include <TTree.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <string_view>
+#include <unordered_map>
+
 namespace o2::mergers::algorithm
 {
 
@@ -143,6 +150,95 @@ void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others)
   }
 }
 
+namespace
+{
+// calls task(i) for i in [0, n) with up to nThreads threads, including the calling one
+template <typename Task>
+void parallelFor(size_t n, size_t nThreads, Task&& task)
+{
+  nThreads = std::min(n, nThreads);
+  if (nThreads <= 1) {
+    for (size_t i = 0; i < n; i++) {
+      task(i);
+    }
+    return;
+  }
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t i = next++; i < n; i = next++) {
+      task(i);
+    }
+  };
+  std::vector<std::future<void>> workers;
+  for (size_t t = 1; t < nThreads; t++) {
+    workers.emplace_back(std::async(std::launch::async, worker));
+  }
+  worker();
+  for (auto& w : workers) {
+    w.get(); // rethrows the exception of the task, if any
+  }
+}
+
+void mergeStores(ObjectStore& target, ObjectStore& other, size_t nThreads)
+{
+  if (std::holds_alternative<std::monostate>(other)) {
+    return;
+  }
+  if (std::holds_alternative<std::monostate>(target)) {
+    target = std::move(other);
+  } else if (std::holds_alternative<TObjectPtr>(target)) {
+    merge(std::get<TObjectPtr>(target).get(), std::get<TObjectPtr>(other).get());
+  } else if (std::holds_alternative<MergeInterfacePtr>(target)) {
+    std::get<MergeInterfacePtr>(target)->merge(std::get<MergeInterfacePtr>(other).get());
+  } else if (std::holds_alternative<VectorOfTObjectPtrs>(target)) {
+    merge(std::get<VectorOfTObjectPtrs>(target), std::get<VectorOfTObjectPtrs>(other), nThreads);
+  }
+  other = std::monostate{};
+}
+} // namespace
+
+void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others, size_t nThreads)
+{
+  if (nThreads <= 1 || others.size() <= 1) {
+    merge(targets, others);
+    return;
+  }
+  // more shards than threads, so that a few large objects do not determine the time of a single thread
+  const size_t nShards = 4 * nThreads;
+  std::vector<std::vector<std::pair<TObject*, TObject*>>> shards(nShards);
+  std::unordered_map<std::string_view, TObject*> targetsByName;
+  for (const auto& target : targets) {
+    targetsByName.emplace(target->GetName(), target.get());
+  }
+  for (const auto& other : others) {
+    std::string_view name{other->GetName()};
+    if (auto targetSameName = targetsByName.find(name); targetSameName != targetsByName.end()) {
+      shards[std::hash<std::string_view>{}(name) % nShards].emplace_back(targetSameName->second, other.get());
+    } else {
+      targets.push_back(std::shared_ptr<TObject>(other->Clone(), deleteTCollections));
+      targetsByName.emplace(targets.back()->GetName(), targets.back().get());
+    }
+  }
+  parallelFor(nShards, nThreads, [&shards](size_t ishard) {
+    for (auto& [target, other] : shards[ishard]) {
+      merge(target, other);
+    }
+  });
+}
+
+void mergeTree(std::vector<ObjectStore>& objects, size_t nThreads)
+{
+  for (size_t stride = 1; stride < objects.size(); stride *= 2) {
+    size_t nPairs = (objects.size() - stride + 2 * stride - 1) / (2 * stride);
+    // the threads not needed for the pairs can be used to merge the vectors of objects
+    size_t nThreadsPerPair = std::max(nThreads / nPairs, size_t(1));
+    parallelFor(nPairs, nThreads, [&objects, stride, nThreadsPerPair](size_t ipair) {
+      mergeStores(objects[ipair * 2 * stride], objects[ipair * 2 * stride + stride], nThreadsPerPair);
+    });
+  }
+  objects.resize(std::min(objects.size(), size_t(1)));
+}
+
 void deleteRecursive(TCollection* Coll)
 {
   // I can iterate a collection
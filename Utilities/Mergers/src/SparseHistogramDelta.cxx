@@ -0,0 +1,439 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file SparseHistogramDelta.cxx
+/// \brief Implementation of the sparse, delta-encoded transport format of histograms for Mergers
+
+#include "Mergers/SparseHistogramDelta.h"
+
+#include "rANS/decode.h"
+#include "rANS/encode.h"
+#include "rANS/factory.h"
+#include "rANS/histogram.h"
+#include "rANS/metrics.h"
+#include "rANS/serialize.h"
+
+#include <TBuffer.h>
+#include <TH1.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+#include <THnBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+ClassImp(o2::mergers::SparseHistogramDelta);
+
+namespace o2::mergers
+{
+
+namespace
+{
+
+using BinContents = std::vector<std::pair<Long64_t, double>>;
+
+void writeVarint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+  while (value >= 0x80) {
+    buffer.push_back(uint8_t(value) | 0x80);
+    value >>= 7;
+  }
+  buffer.push_back(uint8_t(value));
+}
+
+uint64_t readVarint(const uint8_t*& ptr, const uint8_t* end)
+{
+  uint64_t value = 0;
+  for (int shift = 0; ptr < end && shift < 64; shift += 7) {
+    uint8_t byte = *ptr++;
+    value |= uint64_t(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+  throw std::runtime_error("SparseHistogramDelta: corrupted varint");
+}
+
+template <typename T>
+void writeRaw(std::vector<uint8_t>& buffer, T value)
+{
+  auto pos = buffer.size();
+  buffer.resize(pos + sizeof(T));
+  std::memcpy(buffer.data() + pos, &value, sizeof(T));
+}
+
+template <typename T>
+T readRaw(const uint8_t*& ptr, const uint8_t* end)
+{
+  if (ptr + sizeof(T) > end) {
+    throw std::runtime_error("SparseHistogramDelta: truncated payload");
+  }
+  T value;
+  std::memcpy(&value, ptr, sizeof(T));
+  ptr += sizeof(T);
+  return value;
+}
+
+uint64_t zigzag(int64_t value) { return (uint64_t(value) << 1) ^ uint64_t(value >> 63); }
+int64_t unzigzag(uint64_t value) { return int64_t(value >> 1) ^ -int64_t(value & 1); }
+
+// the largest integer up to which all integers are exactly representable as doubles
+constexpr double MaxExactInteger = 9007199254740992.;
+
+bool isInteger(double value)
+{
+  return std::abs(value) < MaxExactInteger && value == std::trunc(value);
+}
+
+// rANS compressed block: original size, symbol range, renorming precision, number of streams and the sizes of
+// the dictionary, of the encoded stream (in 32-bit words) and of the literals, followed by the latter three
+std::vector<uint8_t> compress(const std::vector<uint8_t>& source)
+{
+  std::vector<uint8_t> block;
+  writeRaw<uint64_t>(block, source.size());
+  if (source.empty()) {
+    return block;
+  }
+  auto histogram = rans::makeDenseHistogram::fromSamples(source.begin(), source.end());
+  rans::Metrics<uint8_t> metrics{histogram};
+  auto renormed = rans::renorm(std::move(histogram), metrics);
+  auto encoder = rans::makeDenseEncoder<>::fromRenormed(renormed);
+
+  std::vector<uint8_t> dictionary(metrics.getSizeEstimate().getCompressedDictionarySize());
+  dictionary.resize(std::distance(dictionary.data(), rans::compressRenormedDictionary(renormed, dictionary.data())));
+  std::vector<uint32_t> encoded(metrics.getSizeEstimate().getCompressedDatasetSize<uint32_t>() + 2 * encoder.getNStreams() + 8);
+  std::vector<uint8_t> literals;
+  uint32_t* encodedEnd = nullptr;
+  if (encoder.getSymbolTable().hasEscapeSymbol()) {
+    encodedEnd = encoder.process(source.data(), source.data() + source.size(), encoded.data(), std::back_inserter(literals)).first;
+  } else {
+    encodedEnd = encoder.process(source.data(), source.data() + source.size(), encoded.data());
+  }
+  rans::utils::checkBounds(encodedEnd, encoded.data() + encoded.size());
+  encoded.resize(std::distance(encoded.data(), encodedEnd));
+
+  writeRaw<uint8_t>(block, *metrics.getCoderProperties().min);
+  writeRaw<uint8_t>(block, *metrics.getCoderProperties().max);
+  writeRaw<uint8_t>(block, renormed.getRenormingBits());
+  writeRaw<uint8_t>(block, encoder.getNStreams());
+  writeRaw<uint32_t>(block, dictionary.size());
+  writeRaw<uint32_t>(block, encoded.size());
+  writeRaw<uint32_t>(block, literals.size());
+  block.insert(block.end(), dictionary.begin(), dictionary.end());
+  auto pos = block.size();
+  block.resize(pos + encoded.size() * sizeof(uint32_t));
+  std::memcpy(block.data() + pos, encoded.data(), encoded.size() * sizeof(uint32_t));
+  block.insert(block.end(), literals.begin(), literals.end());
+  return block;
+}
+
+std::vector<uint8_t> decompress(const std::vector<uint8_t>& block)
+{
+  const uint8_t* ptr = block.data();
+  const uint8_t* end = block.data() + block.size();
+  std::vector<uint8_t> target(readRaw<uint64_t>(ptr, end));
+  if (target.empty()) {
+    return target;
+  }
+  auto min = readRaw<uint8_t>(ptr, end);
+  auto max = readRaw<uint8_t>(ptr, end);
+  auto precision = readRaw<uint8_t>(ptr, end);
+  auto nStreams = readRaw<uint8_t>(ptr, end);
+  auto dictionarySize = readRaw<uint32_t>(ptr, end);
+  auto encodedSize = readRaw<uint32_t>(ptr, end);
+  auto literalsSize = readRaw<uint32_t>(ptr, end);
+  if (ptr + dictionarySize + encodedSize * sizeof(uint32_t) + literalsSize > end) {
+    throw std::runtime_error("SparseHistogramDelta: truncated rANS block");
+  }
+  auto renormed = rans::readRenormedDictionary(ptr, ptr + dictionarySize, min, max, precision);
+  ptr += dictionarySize;
+  std::vector<uint32_t> encoded(encodedSize); // aligned copy
+  std::memcpy(encoded.data(), ptr, encodedSize * sizeof(uint32_t));
+  ptr += encodedSize * sizeof(uint32_t);
+  std::vector<uint8_t> literals(ptr, ptr + literalsSize);
+
+  auto decoder = rans::makeDecoder<>::fromRenormed(renormed);
+  if (literals.empty()) {
+    decoder.process(encoded.data() + encoded.size(), target.begin(), target.size(), nStreams);
+  } else {
+    decoder.process(encoded.data() + encoded.size(), target.begin(), target.size(), nStreams, literals.end());
+  }
+  return target;
+}
+
+// global bin index of a THnBase bin, including under- and overflows of all axes,
+// it is lower than the number of cells, which getNCells checks to fit in a Long64_t
+Long64_t toGlobalBin(const THnBase& histogram, const Int_t* coordinates)
+{
+  Long64_t bin = 0;
+  for (Int_t dim = histogram.GetNdimensions() - 1; dim >= 0; dim--) {
+    bin = bin * (histogram.GetAxis(dim)->GetNbins() + 2) + coordinates[dim];
+  }
+  return bin;
+}
+
+void toCoordinates(const THnBase& histogram, Long64_t bin, Int_t* coordinates)
+{
+  for (Int_t dim = 0; dim < histogram.GetNdimensions(); dim++) {
+    auto nCells = histogram.GetAxis(dim)->GetNbins() + 2;
+    coordinates[dim] = bin % nCells;
+    bin /= nCells;
+  }
+}
+
+Long64_t getNCells(const TObject& histogram)
+{
+  // the bin contents of the profiles are means, they can be neither subtracted nor added without the bin entries
+  if (dynamic_cast<const TProfile*>(&histogram) || dynamic_cast<const TProfile2D*>(&histogram) || dynamic_cast<const TProfile3D*>(&histogram)) {
+    throw std::runtime_error(std::string("SparseHistogramDelta: the profile '") + histogram.GetName() + "' is not supported");
+  }
+  if (auto th1 = dynamic_cast<const TH1*>(&histogram)) {
+    return th1->GetNcells();
+  } else if (auto thn = dynamic_cast<const THnBase*>(&histogram)) {
+    Long64_t nCells = 1;
+    for (Int_t dim = 0; dim < thn->GetNdimensions(); dim++) {
+      Long64_t nCellsAxis = thn->GetAxis(dim)->GetNbins() + 2;
+      if (nCells > std::numeric_limits<Long64_t>::max() / nCellsAxis) {
+        throw std::runtime_error(std::string("SparseHistogramDelta: the number of cells of '") + histogram.GetName() + "' does not fit in a Long64_t");
+      }
+      nCells *= nCellsAxis;
+    }
+    return nCells;
+  }
+  throw std::runtime_error(std::string("SparseHistogramDelta: the object '") + histogram.GetName() + "' of type '" + histogram.ClassName() + "' is not a TH1 nor a THnBase");
+}
+
+double getEntries(const TObject& histogram)
+{
+  if (auto th1 = dynamic_cast<const TH1*>(&histogram)) {
+    return th1->GetEntries();
+  }
+  return dynamic_cast<const THnBase&>(histogram).GetEntries();
+}
+
+// non-zero bins of the histogram in increasing order of the global bin index
+BinContents getNonZeroBins(const TObject& histogram)
+{
+  BinContents bins;
+  if (auto th1 = dynamic_cast<const TH1*>(&histogram)) {
+    for (Int_t bin = 0; bin < th1->GetNcells(); bin++) {
+      if (auto content = th1->GetBinContent(bin); content != 0) {
+        bins.emplace_back(bin, content);
+      }
+    }
+  } else if (auto thn = dynamic_cast<const THnBase*>(&histogram)) {
+    // in THnSparse the bins are stored in the order of filling
+    std::vector<Int_t> coordinates(thn->GetNdimensions());
+    for (Long64_t i = 0; i < thn->GetNbins(); i++) {
+      if (auto content = thn->GetBinContent(i, coordinates.data()); content != 0) {
+        bins.emplace_back(toGlobalBin(*thn, coordinates.data()), content);
+      }
+    }
+    std::sort(bins.begin(), bins.end());
+  }
+  return bins;
+}
+
+// merges the sorted bins of b multiplied by the factor into the sorted bins of a, dropping the bins which become zero
+void mergeBins(std::vector<Long64_t>& binsA, std::vector<double>& contentsA, const std::vector<Long64_t>& binsB, const std::vector<double>& contentsB, double factor)
+{
+  std::vector<Long64_t> bins;
+  std::vector<double> contents;
+  bins.reserve(binsA.size() + binsB.size());
+  contents.reserve(binsA.size() + binsB.size());
+  size_t ia = 0, ib = 0;
+  while (ia < binsA.size() || ib < binsB.size()) {
+    Long64_t bin;
+    double content = 0;
+    if (ib == binsB.size() || (ia < binsA.size() && binsA[ia] < binsB[ib])) {
+      bin = binsA[ia];
+      content = contentsA[ia++];
+    } else if (ia == binsA.size() || binsB[ib] < binsA[ia]) {
+      bin = binsB[ib];
+      content = factor * contentsB[ib++];
+    } else {
+      bin = binsA[ia];
+      content = contentsA[ia++] + factor * contentsB[ib++];
+    }
+    if (content != 0) {
+      bins.push_back(bin);
+      contents.push_back(content);
+    }
+  }
+  binsA.swap(bins);
+  contentsA.swap(contents);
+}
+
+} // namespace
+
+SparseHistogramDelta::SparseHistogramDelta(const TObject& histogram, const TObject* reference, Compression compression)
+  : TObject(), MergeInterface(), mName(histogram.GetName()), mNCells(o2::mergers::getNCells(histogram)), mEntries(o2::mergers::getEntries(histogram)), mCompression(static_cast<uint8_t>(compression))
+{
+  for (const auto& [bin, content] : getNonZeroBins(histogram)) {
+    mBins.push_back(bin);
+    mContents.push_back(content);
+  }
+  if (reference) {
+    if (o2::mergers::getNCells(*reference) != mNCells) {
+      throw std::runtime_error("SparseHistogramDelta: the histogram '" + mName + "' and its reference have different binning");
+    }
+    std::vector<Long64_t> referenceBins;
+    std::vector<double> referenceContents;
+    for (const auto& [bin, content] : getNonZeroBins(*reference)) {
+      referenceBins.push_back(bin);
+      referenceContents.push_back(content);
+    }
+    mergeBins(mBins, mContents, referenceBins, referenceContents, -1.);
+    mEntries -= o2::mergers::getEntries(*reference);
+  }
+}
+
+void SparseHistogramDelta::merge(MergeInterface* const other)
+{
+  auto otherDelta = dynamic_cast<const SparseHistogramDelta*>(other);
+  if (otherDelta == nullptr) {
+    throw std::runtime_error("SparseHistogramDelta: the object to be merged into '" + mName + "' is not a SparseHistogramDelta");
+  }
+  if (otherDelta->mNCells != mNCells) {
+    throw std::runtime_error("SparseHistogramDelta: the deltas of '" + mName + "' have different binning");
+  }
+  decode();
+  otherDelta->decode();
+  mergeBins(mBins, mContents, otherDelta->mBins, otherDelta->mContents, 1.);
+  mEntries += otherDelta->mEntries;
+  mEncoded = false;
+}
+
+void SparseHistogramDelta::addTo(TObject& histogram) const
+{
+  if (o2::mergers::getNCells(histogram) != mNCells) {
+    throw std::runtime_error("SparseHistogramDelta: the histogram '" + std::string(histogram.GetName()) + "' has a binning different from the delta '" + mName + "'");
+  }
+  decode();
+  if (auto th1 = dynamic_cast<TH1*>(&histogram)) {
+    auto entries = th1->GetEntries();
+    for (size_t i = 0; i < mBins.size(); i++) {
+      th1->AddBinContent(mBins[i], mContents[i]);
+    }
+    // AddBinContent() does not update the statistics, recompute them from the bin contents
+    th1->ResetStats();
+    th1->SetEntries(entries + mEntries);
+  } else if (auto thn = dynamic_cast<THnBase*>(&histogram)) {
+    auto entries = thn->GetEntries();
+    std::vector<Int_t> coordinates(thn->GetNdimensions());
+    for (size_t i = 0; i < mBins.size(); i++) {
+      toCoordinates(*thn, mBins[i], coordinates.data());
+      thn->AddBinContent(coordinates.data(), mContents[i]);
+    }
+    thn->SetEntries(entries + mEntries);
+  }
+}
+
+size_t SparseHistogramDelta::getNBins() const
+{
+  decode();
+  return mBins.size();
+}
+
+double SparseHistogramDelta::getBinContent(Long64_t bin) const
+{
+  decode();
+  auto it = std::lower_bound(mBins.begin(), mBins.end(), bin);
+  return (it != mBins.end() && *it == bin) ? mContents[std::distance(mBins.begin(), it)] : 0.;
+}
+
+void SparseHistogramDelta::setCompression(Compression compression)
+{
+  if (static_cast<uint8_t>(compression) != mCompression) {
+    decode();
+    mCompression = static_cast<uint8_t>(compression);
+    mEncoded = false;
+  }
+}
+
+size_t SparseHistogramDelta::getEncodedSize() const
+{
+  encode();
+  return mPayload.size();
+}
+
+void SparseHistogramDelta::encode() const
+{
+  if (mEncoded) {
+    return;
+  }
+  mIntegerContents = std::all_of(mContents.begin(), mContents.end(), isInteger);
+  std::vector<uint8_t> buffer;
+  buffer.reserve(mBins.size() * (mIntegerContents ? 3 : 10));
+  writeVarint(buffer, mBins.size());
+  Long64_t nextBin = 0;
+  for (size_t i = 0; i < mBins.size(); i++) {
+    writeVarint(buffer, mBins[i] - nextBin);
+    nextBin = mBins[i] + 1;
+    if (mIntegerContents) {
+      writeVarint(buffer, zigzag(int64_t(mContents[i])));
+    } else {
+      writeRaw<double>(buffer, mContents[i]);
+    }
+  }
+  mPayload = getCompression() == Compression::RANS ? compress(buffer) : std::move(buffer);
+  mEncoded = true;
+}
+
+void SparseHistogramDelta::decode() const
+{
+  if (mDecoded) {
+    return;
+  }
+  std::vector<uint8_t> decompressed;
+  const std::vector<uint8_t>* buffer = &mPayload;
+  if (getCompression() == Compression::RANS) {
+    decompressed = decompress(mPayload);
+    buffer = &decompressed;
+  }
+  const uint8_t* ptr = buffer->data();
+  const uint8_t* end = buffer->data() + buffer->size();
+  mBins.clear();
+  mContents.clear();
+  if (ptr != end) {
+    auto nBins = readVarint(ptr, end);
+    mBins.reserve(nBins);
+    mContents.reserve(nBins);
+    Long64_t nextBin = 0;
+    for (uint64_t i = 0; i < nBins; i++) {
+      mBins.push_back(nextBin + Long64_t(readVarint(ptr, end)));
+      nextBin = mBins.back() + 1;
+      mContents.push_back(mIntegerContents ? double(unzigzag(readVarint(ptr, end))) : readRaw<double>(ptr, end));
+    }
+  }
+  mDecoded = true;
+}
+
+void SparseHistogramDelta::Streamer(TBuffer& buffer)
+{
+  // the bins are encoded only when the object is sent and decoded only when it is merged or read
+  if (buffer.IsReading()) {
+    buffer.ReadClassBuffer(SparseHistogramDelta::Class(), this);
+    mDecoded = false;
+    mEncoded = true;
+  } else {
+    encode();
+    buffer.WriteClassBuffer(SparseHistogramDelta::Class(), this);
+  }
+}
+
+} // namespace o2::mergers
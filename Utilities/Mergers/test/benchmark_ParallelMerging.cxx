@@ -0,0 +1,75 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+
+#include "Mergers/MergerAlgorithm.h"
+#include "Mergers/ObjectStore.h"
+
+#include <TH2.h>
+#include <TF2.h>
+#include <TROOT.h>
+
+#include <chrono>
+
+using namespace o2::mergers;
+
+// Merges a batch of deltas (1st argument), each one being a vector of histograms, into the merged object
+// with a number of threads (2nd argument), as the IntegratingMerger does with the deltas it buffered.
+// Reports the merged objects per second and the merging latency per set of deltas.
+static void BM_mergingDeltasInParallel(benchmark::State& state)
+{
+  const size_t inputs = state.range(0);
+  const size_t threads = state.range(1);
+  const size_t objectsPerInput = 64;
+  const size_t bins = 100; // 100 bins * 100 bins * 4B makes 40kB
+
+  ROOT::EnableThreadSafety();
+  TH1::AddDirectory(false);
+  TF2 uni("uni", "1", 0, 1000000, 0, 1000000);
+  VectorOfTObjectPtrs delta;
+  for (size_t i = 0; i < objectsPerInput; i++) {
+    auto h = std::make_shared<TH2F>(("test" + std::to_string(i)).c_str(), "test", bins, 0, 1000000, bins, 0, 1000000);
+    h->FillRandom("uni", 10000);
+    delta.push_back(h);
+  }
+  VectorOfTObjectPtrs merged;
+  algorithm::merge(merged, delta);
+
+  for (auto _ : state) {
+    std::vector<ObjectStore> deltas;
+    for (size_t i = 0; i < inputs; i++) {
+      VectorOfTObjectPtrs copy;
+      for (const auto& object : delta) {
+        copy.push_back(TObjectPtr(object->Clone(), algorithm::deleteTCollections));
+      }
+      deltas.emplace_back(std::move(copy));
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    if (threads > 1) {
+      algorithm::mergeTree(deltas, threads);
+      algorithm::merge(merged, std::get<VectorOfTObjectPtrs>(deltas.front()), threads);
+    } else {
+      for (const auto& other : deltas) {
+        algorithm::merge(merged, std::get<VectorOfTObjectPtrs>(other));
+      }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+  state.SetItemsProcessed(state.iterations() * inputs * objectsPerInput);
+}
+
+BENCHMARK(BM_mergingDeltasInParallel)->ArgsProduct({{1, 4, 16, 64, 256}, {1, 2, 4, 8, 16}})->ArgNames({"inputs", "threads"})->UseManualTime();
+
+BENCHMARK_MAIN();
@@ -39,6 +39,7 @@
 #include <TF1.h>
 #include <TGraph.h>
 #include <TProfile.h>
+#include <TROOT.h>
 
 // using namespace o2::framework;
 using namespace o2::mergers;
@@ -482,4 +483,65 @@ BOOST_AUTO_TEST_CASE(OtherLonger, *boost::unit_test::tolerance(0.001))
   BOOST_TEST(to_span(other1_2) == to_array({0., 0., 0., 0., 0., 0., 2., 0., 0., 0., 0., 0.}), boost::test_tools::per_element());
 }
 
+BOOST_AUTO_TEST_CASE(Parallel)
+{
+  ROOT::EnableThreadSafety();
+  constexpr size_t nHistos = 20;
+  constexpr size_t nThreads = 4;
+
+  VectorOfTObjectPtrs target;
+  for (size_t i = 0; i < nHistos; i++) {
+    auto histo = std::make_shared<TH1F>(("histo " + std::to_string(i)).c_str(), "histo", bins, min, max);
+    histo->Fill(5);
+    target.push_back(histo);
+  }
+  // other has all the histograms of the target in the reverse order and a new one
+  VectorOfTObjectPtrs other;
+  for (size_t i = 0; i <= nHistos; i++) {
+    auto histo = std::make_shared<TH1F>(("histo " + std::to_string(nHistos - i)).c_str(), "histo", bins, min, max);
+    histo->Fill(5);
+    histo->Fill(5);
+    other.push_back(histo);
+  }
+
+  BOOST_CHECK_NO_THROW(algorithm::merge(target, other, nThreads));
+
+  BOOST_REQUIRE(target.size() == nHistos + 1);
+  for (size_t i = 0; i < nHistos; i++) {
+    BOOST_TEST(std::string(target[i]->GetName()) == "histo " + std::to_string(i));
+    BOOST_TEST(dynamic_cast<TH1F*>(target[i].get())->GetBinContent(6) == 3);
+  }
+  BOOST_TEST(std::string(target[nHistos]->GetName()) == "histo " + std::to_string(nHistos));
+  BOOST_TEST(dynamic_cast<TH1F*>(target[nHistos].get())->GetBinContent(6) == 2);
+  BOOST_TEST(target[nHistos] != other[0]); // the new object is cloned
+}
+
+BOOST_AUTO_TEST_CASE(Tree)
+{
+  ROOT::EnableThreadSafety();
+  for (size_t nDeltas : {0, 1, 2, 7, 16}) {
+    std::vector<ObjectStore> deltas;
+    for (size_t i = 0; i < nDeltas; i++) {
+      auto histo1 = std::make_shared<TH1F>("histo 1", "histo 1", bins, min, max);
+      histo1->Fill(5);
+      auto histo2 = std::make_shared<TH1F>(("histo " + std::to_string(i + 2)).c_str(), "histo", bins, min, max);
+      histo2->Fill(5);
+      deltas.emplace_back(VectorOfTObjectPtrs{histo1, histo2});
+    }
+
+    BOOST_CHECK_NO_THROW(algorithm::mergeTree(deltas, 3));
+
+    BOOST_REQUIRE(deltas.size() == std::min(nDeltas, size_t(1)));
+    if (nDeltas == 0) {
+      continue;
+    }
+    const auto& merged = std::get<VectorOfTObjectPtrs>(deltas[0]);
+    BOOST_REQUIRE(merged.size() == nDeltas + 1);
+    BOOST_TEST(dynamic_cast<TH1F*>(merged[0].get())->GetBinContent(6) == nDeltas);
+    for (size_t i = 1; i < merged.size(); i++) {
+      BOOST_TEST(dynamic_cast<TH1F*>(merged[i].get())->GetBinContent(6) == 1);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
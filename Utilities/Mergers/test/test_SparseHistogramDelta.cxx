@@ -0,0 +1,166 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file test_SparseHistogramDelta.cxx
+/// \brief A unit test of the sparse histogram deltas for Mergers
+
+#define BOOST_TEST_MODULE Test Utilities MergerSparseHistogramDelta
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "Mergers/SparseHistogramDelta.h"
+#include "Mergers/MergerAlgorithm.h"
+
+#include <TBufferFile.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TProfile.h>
+#include <THnSparse.h>
+#include <TRandom.h>
+
+#include <memory>
+
+using namespace o2::mergers;
+
+using Compression = SparseHistogramDelta::Compression;
+
+// emulates the transport of the delta, which is encoded when written and decoded when merged
+std::unique_ptr<SparseHistogramDelta> transport(const SparseHistogramDelta& delta)
+{
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObjectAny(&delta, SparseHistogramDelta::Class());
+  buffer.SetReadMode();
+  buffer.SetBufferOffset(0);
+  return std::unique_ptr<SparseHistogramDelta>(static_cast<SparseHistogramDelta*>(buffer.ReadObjectAny(SparseHistogramDelta::Class())));
+}
+
+BOOST_AUTO_TEST_CASE(DeltaTH2)
+{
+  gRandom->SetSeed(1);
+  for (auto compression : {Compression::None, Compression::RANS}) {
+    TH2F previous("histo", "histo", 500, 0, 1, 500, 0, 1);
+    for (int i = 0; i < 10000; i++) {
+      previous.Fill(gRandom->Rndm(), gRandom->Rndm());
+    }
+    std::unique_ptr<TH2F> current(dynamic_cast<TH2F*>(previous.Clone()));
+    for (int i = 0; i < 1000; i++) {
+      current->Fill(gRandom->Rndm(), gRandom->Rndm());
+    }
+
+    SparseHistogramDelta delta(*current, &previous, compression);
+    BOOST_CHECK_LE(delta.getNBins(), 1000);
+    BOOST_CHECK_EQUAL(delta.getEntries(), 1000);
+    BOOST_CHECK_LT(delta.getEncodedSize(), 4 * 1000);
+
+    auto received = transport(delta);
+    BOOST_REQUIRE(received != nullptr);
+    BOOST_CHECK_EQUAL(std::string(received->GetName()), "histo");
+    BOOST_CHECK_EQUAL(received->getNBins(), delta.getNBins());
+
+    received->addTo(previous);
+    for (Int_t bin = 0; bin < current->GetNcells(); bin++) {
+      BOOST_REQUIRE_EQUAL(previous.GetBinContent(bin), current->GetBinContent(bin));
+    }
+    BOOST_CHECK_EQUAL(previous.GetEntries(), current->GetEntries());
+    // the statistics are recomputed from the bin contents, i.e. the bin centres
+    const double halfBinWidth = 0.5 / 500;
+    BOOST_CHECK_SMALL(previous.GetMean(1) - current->GetMean(1), halfBinWidth);
+    BOOST_CHECK_SMALL(previous.GetMean(2) - current->GetMean(2), halfBinWidth);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MergeDeltas)
+{
+  TH1D histo1("histo", "histo", 100, 0, 100);
+  histo1.Fill(10);
+  histo1.Fill(20, 0.5); // non-integer contents are sent as doubles
+  TH1D histo2("histo", "histo", 100, 0, 100);
+  histo2.Fill(10);
+  histo2.Fill(30);
+
+  auto target = transport(SparseHistogramDelta(histo1, nullptr, Compression::RANS));
+  auto other = transport(SparseHistogramDelta(histo2, nullptr, Compression::None));
+  BOOST_CHECK_NO_THROW(algorithm::merge(target.get(), other.get()));
+
+  BOOST_CHECK_EQUAL(target->getNBins(), 3);
+  BOOST_CHECK_EQUAL(target->getBinContent(histo1.FindBin(10)), 2);
+  BOOST_CHECK_EQUAL(target->getBinContent(histo1.FindBin(20)), 0.5);
+  BOOST_CHECK_EQUAL(target->getBinContent(histo1.FindBin(30)), 1);
+  BOOST_CHECK_EQUAL(target->getEntries(), 4);
+
+  // the merged delta is encoded again when sent
+  auto merged = transport(*target);
+  TH1D result("histo", "histo", 100, 0, 100);
+  merged->addTo(result);
+  BOOST_CHECK_EQUAL(result.GetBinContent(result.FindBin(10)), 2);
+  BOOST_CHECK_EQUAL(result.GetBinContent(result.FindBin(20)), 0.5);
+  BOOST_CHECK_EQUAL(result.GetBinContent(result.FindBin(30)), 1);
+
+  TH1D differentBinning("histo", "histo", 10, 0, 100);
+  SparseHistogramDelta wrong(differentBinning);
+  BOOST_CHECK_THROW(target->merge(&wrong), std::runtime_error);
+  BOOST_CHECK_THROW(wrong.addTo(histo1), std::runtime_error);
+
+  // the bin contents of profiles are means, which cannot be added
+  TProfile profile("profile", "profile", 100, 0, 100);
+  profile.Fill(10, 1);
+  BOOST_CHECK_THROW(SparseHistogramDelta{profile}, std::runtime_error);
+  BOOST_CHECK_THROW(merged->addTo(profile), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(DeltaTHnSparse)
+{
+  const Int_t bins[3] = {100, 100, 100};
+  const Double_t mins[3] = {0, 0, 0};
+  const Double_t maxs[3] = {1, 1, 1};
+  THnSparseF previous("sparse", "sparse", 3, bins, mins, maxs);
+  THnSparseF current("sparse", "sparse", 3, bins, mins, maxs);
+  Double_t x[3];
+  for (int i = 0; i < 500; i++) {
+    x[0] = gRandom->Rndm();
+    x[1] = gRandom->Rndm();
+    x[2] = gRandom->Rndm();
+    previous.Fill(x);
+    current.Fill(x);
+  }
+  for (int i = 0; i < 100; i++) {
+    x[0] = gRandom->Rndm();
+    x[1] = gRandom->Rndm();
+    x[2] = gRandom->Rndm();
+    current.Fill(x);
+  }
+
+  auto received = transport(SparseHistogramDelta(current, &previous, Compression::RANS));
+  BOOST_CHECK_LE(received->getNBins(), 100);
+  received->addTo(previous);
+
+  BOOST_CHECK_EQUAL(previous.GetNbins(), current.GetNbins());
+  Int_t coordinates[3];
+  for (Long64_t i = 0; i < current.GetNbins(); i++) {
+    auto content = current.GetBinContent(i, coordinates);
+    BOOST_REQUIRE_EQUAL(previous.GetBinContent(coordinates), content);
+  }
+  BOOST_CHECK_EQUAL(previous.GetEntries(), current.GetEntries());
+}
+
+BOOST_AUTO_TEST_CASE(DeltaTHnSparseTooManyCells)
+{
+  // 1002^7 cells, including the under- and overflows, do not fit in a Long64_t global bin index
+  const Int_t bins[7] = {1000, 1000, 1000, 1000, 1000, 1000, 1000};
+  const Double_t mins[7] = {0, 0, 0, 0, 0, 0, 0};
+  const Double_t maxs[7] = {1, 1, 1, 1, 1, 1, 1};
+  THnSparseF sparse("sparse", "sparse", 7, bins, mins, maxs);
+  const Double_t x[7] = {0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5};
+  sparse.Fill(x);
+  BOOST_CHECK_THROW(SparseHistogramDelta{sparse}, std::runtime_error);
+}